@@ -90,6 +90,24 @@ void EmbeddingLookUpPSKernel::UpdateEmbeddings(float *embedding_table, const siz
   }
 }
 
+void EmbeddingLookUpPSKernel::LookupEmbeddings(const float *embedding_table, const size_t *lookup_ids, size_t ids_size,
+                                               std::vector<float> *output) const {
+  MS_EXCEPTION_IF_NULL(output);
+  // The ids out of the shard of this server get rows of zeros, like in Execute.
+  output->assign(ids_size * outer_dim_size_, 0);
+  size_t copy_len = outer_dim_size_ * sizeof(float);
+  for (size_t i = 0; i < ids_size; ++i) {
+    int64_t index = SizeToLong(lookup_ids[i]) - offset_;
+    if (index >= 0 && index < SizeToLong(first_dim_size_)) {
+      auto ret = memcpy_s(output->data() + i * outer_dim_size_, (ids_size - i) * copy_len,
+                          embedding_table + LongToSize(index) * outer_dim_size_, copy_len);
+      if (ret != EOK) {
+        MS_LOG(EXCEPTION) << "LookupEmbeddings memcpy failed.";
+      }
+    }
+  }
+}
+
 const std::vector<size_t> &EmbeddingLookUpPSKernel::input_sizes() const { return input_shape_; }
 
 const std::vector<size_t> &EmbeddingLookUpPSKernel::output_sizes() const { return GetOutputSizeList(); }
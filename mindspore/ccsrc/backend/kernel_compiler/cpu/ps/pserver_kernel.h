@@ -40,6 +40,9 @@ class PServerKernel {
                        const std::vector<AddressPtr> &outputs) = 0;
   virtual void UpdateEmbeddings(float *embedding_table, const size_t *lookup_ids, const float *update_vals,
                                 size_t ids_size) {}
+  // Unlike Execute, it keeps no state in the kernel, so lookups of the same table can run at the same time.
+  virtual void LookupEmbeddings(const float *embedding_table, const size_t *lookup_ids, size_t ids_size,
+                                std::vector<float> *output) const {}
   virtual const std::vector<size_t> &input_sizes() const = 0;
   virtual const std::vector<size_t> &output_sizes() const = 0;
   virtual const std::vector<size_t> &workspace_sizes() const = 0;
@@ -15,33 +15,243 @@
  */
 
 #include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+#include <chrono>
 #include "utils/ms_utils.h"
 #include "utils/convert_utils.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace device {
+namespace {
+// The number of slabs carved from one chunk of best fit pool.
+constexpr size_t kSlabChunkNum = 16;
+// The number of memory moved between the thread cache and the central free list at one time.
+constexpr size_t kSlabBatchNum = 32;
+// The maximum number of memory cached by one thread for each size class.
+constexpr size_t kSlabCacheMaxNum = 128;
+// Only one of the memory operations is timed in every interval, to keep the overhead of statistics low.
+constexpr size_t kLatencySampleInterval = 16;
+
+std::atomic<size_t> pool_id_count{0};
+
+// The alive pools, which the exiting thread returns the cached memory to. They are never destroyed, because the pools
+// may be destroyed in the exit of process.
+std::mutex &LivePoolMutex() {
+  static auto *live_pool_mutex = new std::mutex();
+  return *live_pool_mutex;
+}
+std::unordered_map<size_t, DynamicMemPoolBestFit *> &LivePools() {
+  static auto *live_pools = new std::unordered_map<size_t, DynamicMemPoolBestFit *>();
+  return *live_pools;
+}
+
+struct SlabThreadCache {
+  size_t generation_{0};
+  std::vector<DeviceMemPtr> free_lists_[SLAB_CLASS_NUM];
+};
+
+// The thread local caches of small memory for all the pools.
+class SlabThreadCaches {
+ public:
+  SlabThreadCaches() = default;
+  ~SlabThreadCaches() {
+    std::lock_guard<std::mutex> locker(LivePoolMutex());
+    for (auto &iter : caches_) {
+      auto pool_iter = LivePools().find(iter.first);
+      if (pool_iter != LivePools().end()) {
+        pool_iter->second->ReturnThreadCache(iter.second.generation_, iter.second.free_lists_);
+      }
+    }
+  }
+
+  SlabThreadCache *Fetch(const DynamicMemPoolBestFit *pool) {
+    if ((last_cache_ == nullptr) || (last_pool_id_ != pool->pool_id())) {
+      last_pool_id_ = pool->pool_id();
+      last_cache_ = &caches_[last_pool_id_];
+    }
+    // The device memory of pool has been released, the cached memory is invalid.
+    auto generation = pool->slab_generation();
+    if (last_cache_->generation_ != generation) {
+      for (auto &free_list : last_cache_->free_lists_) {
+        free_list.clear();
+      }
+      last_cache_->generation_ = generation;
+    }
+    return last_cache_;
+  }
+
+  bool NeedSample() { return (++operation_count_ % kLatencySampleInterval) == 0; }
+
+ private:
+  std::unordered_map<size_t, SlabThreadCache> caches_;
+  size_t last_pool_id_{0};
+  SlabThreadCache *last_cache_{nullptr};
+  size_t operation_count_{0};
+};
+thread_local SlabThreadCaches slab_thread_caches;
+
+size_t SlabClassIndex(size_t align_size) {
+  size_t class_index = 0;
+  size_t class_size = SLAB_MIN_CLASS_SIZE;
+  while ((class_size < align_size) && (class_index < SLAB_CLASS_NUM)) {
+    class_size <<= 1;
+    ++class_index;
+  }
+  return class_index;
+}
+
+void RecordLatency(const std::chrono::steady_clock::time_point &start_time, std::atomic<size_t> *total_time,
+                   std::atomic<size_t> *samples) {
+  auto cost = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_time);
+  (void)total_time->fetch_add(LongToSize(cost.count()), std::memory_order_relaxed);
+  (void)samples->fetch_add(1, std::memory_order_relaxed);
+}
+
+double AverageLatency(const std::atomic<size_t> &total_time, const std::atomic<size_t> &samples) {
+  return samples == 0 ? 0 : static_cast<double>(total_time) / samples;
+}
+}  // namespace
+
+DynamicMemPoolBestFit::DynamicMemPoolBestFit() : pool_id_(++pool_id_count) {
+  std::lock_guard<std::mutex> locker(LivePoolMutex());
+  LivePools()[pool_id_] = this;
+}
+
 DynamicMemPoolBestFit::~DynamicMemPoolBestFit() {
+  {
+    std::lock_guard<std::mutex> locker(LivePoolMutex());
+    (void)LivePools().erase(pool_id_);
+  }
   global_mem_block_list_.clear();
   global_idle_mem_buf_map_.clear();
 }
 
 DeviceMemPtr DynamicMemPoolBestFit::AllocTensorMem(size_t size) {
   size_t align_size = AlignMemorySize(size);
+  size_t class_index = IsSlabEnabled() ? SlabClassIndex(align_size) : SLAB_CLASS_NUM;
+  bool need_sample = slab_thread_caches.NeedSample();
+  auto start_time = need_sample ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  if (class_index < SLAB_CLASS_NUM) {
+    auto device_addr = AllocSlabMem(class_index, size);
+    if (device_addr != nullptr) {
+      if (need_sample) {
+        RecordLatency(start_time, &slab_statistics_.slab_alloc_time_, &slab_statistics_.slab_alloc_samples_);
+      }
+      return device_addr;
+    }
+  }
+  auto device_addr = AllocBestFitMem(align_size);
+  if (need_sample) {
+    RecordLatency(start_time, &slab_statistics_.best_fit_alloc_time_, &slab_statistics_.best_fit_alloc_samples_);
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocBestFitMem(size_t size) {
   std::lock_guard<std::mutex> locker(mutex_);
   // Find the idle memory buf by tensor size, if not find, then add new memory block and memory buf.
-  DeviceMemPtr device_addr = FindIdleMemBuf(align_size);
+  DeviceMemPtr device_addr = FindIdleMemBuf(size);
   if (!device_addr) {
-    device_addr = AddMemBlockAndMemBuf(align_size);
+    device_addr = AddMemBlockAndMemBuf(size);
+  }
+  return device_addr;
+}
+
+DeviceMemPtr DynamicMemPoolBestFit::AllocSlabMem(size_t class_index, size_t size) {
+  auto thread_cache = slab_thread_caches.Fetch(this);
+  auto &free_list = thread_cache->free_lists_[class_index];
+  if (free_list.empty() && !FillThreadCache(&free_list, class_index)) {
+    return nullptr;
   }
+  auto device_addr = free_list.back();
+  free_list.pop_back();
+  // Memory statistics
+  (void)slab_statistics_.alloc_count_[class_index].fetch_add(1, std::memory_order_relaxed);
+  (void)slab_statistics_.request_size_.fetch_add(size, std::memory_order_relaxed);
+  (void)slab_statistics_.class_size_.fetch_add(SLAB_MIN_CLASS_SIZE << class_index, std::memory_order_relaxed);
   return device_addr;
 }
 
+bool DynamicMemPoolBestFit::FillThreadCache(std::vector<DeviceMemPtr> *free_list, size_t class_index) {
+  MS_EXCEPTION_IF_NULL(free_list);
+  std::lock_guard<std::mutex> locker(slab_mutex_);
+  auto &central_free_list = slab_free_lists_[class_index];
+  if (central_free_list.empty() && !AddSlab(class_index)) {
+    return false;
+  }
+  size_t fill_num = std::min(kSlabBatchNum, central_free_list.size());
+  (void)free_list->insert(free_list->end(), central_free_list.end() - fill_num, central_free_list.end());
+  central_free_list.resize(central_free_list.size() - fill_num);
+  return true;
+}
+
+void DynamicMemPoolBestFit::ReleaseThreadCache(std::vector<DeviceMemPtr> *free_list, size_t class_index) {
+  MS_EXCEPTION_IF_NULL(free_list);
+  // Keep the recently freed memory in the thread cache, which is more likely in the cpu cache.
+  size_t release_num = free_list->size() / 2;
+  std::lock_guard<std::mutex> locker(slab_mutex_);
+  auto &central_free_list = slab_free_lists_[class_index];
+  (void)central_free_list.insert(central_free_list.end(), free_list->begin(), free_list->begin() + release_num);
+  (void)free_list->erase(free_list->begin(), free_list->begin() + release_num);
+}
+
+void DynamicMemPoolBestFit::ReturnThreadCache(size_t generation, std::vector<DeviceMemPtr> *free_lists) {
+  MS_EXCEPTION_IF_NULL(free_lists);
+  std::lock_guard<std::mutex> locker(slab_mutex_);
+  if (generation != slab_generation_) {
+    return;
+  }
+  for (size_t i = 0; i < SLAB_CLASS_NUM; ++i) {
+    (void)slab_free_lists_[i].insert(slab_free_lists_[i].end(), free_lists[i].begin(), free_lists[i].end());
+    free_lists[i].clear();
+  }
+}
+
+bool DynamicMemPoolBestFit::AddSlab(size_t class_index) {
+  if (spare_slabs_.empty()) {
+    // The chunk contains one more slab to align the slabs by the slab size. The chunk is kept by the slabs until the
+    // device memory is released, because the slabs are reused by the size classes.
+    auto chunk_addr = AllocBestFitMem(AlignMemorySize((kSlabChunkNum + 1) * SLAB_SIZE));
+    if (chunk_addr == nullptr) {
+      return false;
+    }
+    auto slab_base = (reinterpret_cast<uintptr_t>(chunk_addr) + SLAB_SIZE - 1) / SLAB_SIZE * SLAB_SIZE;
+    for (size_t i = kSlabChunkNum; i > 0; --i) {
+      spare_slabs_.emplace_back(reinterpret_cast<DeviceMemPtr>(slab_base + (i - 1) * SLAB_SIZE));
+    }
+  }
+  auto slab_addr = spare_slabs_.back();
+  spare_slabs_.pop_back();
+  {
+    std::unique_lock<std::shared_mutex> locker(slab_class_mutex_);
+    slab_class_map_[reinterpret_cast<uintptr_t>(slab_addr) / SLAB_SIZE] = class_index;
+  }
+  // Divide the slab into the memory of size class.
+  size_t class_size = SLAB_MIN_CLASS_SIZE << class_index;
+  auto &central_free_list = slab_free_lists_[class_index];
+  for (size_t offset = SLAB_SIZE; offset >= class_size; offset -= class_size) {
+    central_free_list.emplace_back(AddressOffset(slab_addr, offset - class_size));
+  }
+  return true;
+}
+
+size_t DynamicMemPoolBestFit::FindSlabClass(const DeviceMemPtr &device_addr) {
+  if (!IsSlabEnabled()) {
+    return SLAB_CLASS_NUM;
+  }
+  std::shared_lock<std::shared_mutex> locker(slab_class_mutex_);
+  auto iter = slab_class_map_.find(reinterpret_cast<uintptr_t>(device_addr) / SLAB_SIZE);
+  if (iter == slab_class_map_.end()) {
+    return SLAB_CLASS_NUM;
+  }
+  return iter->second;
+}
+
 std::vector<DeviceMemPtr> DynamicMemPoolBestFit::AllocContinuousTensorMem(size_t total_size,
                                                                           std::vector<size_t> size_list) {
   std::vector<DeviceMemPtr> device_addr_list;
-  // Pre-alloc the one whole piece memory.
-  auto device_addr = AllocTensorMem(total_size);
+  // Pre-alloc the one whole piece memory, it's always allocated from the best fit pool to be split.
+  auto device_addr = AllocBestFitMem(AlignMemorySize(total_size));
   if (!device_addr) {
     return device_addr_list;
   }
@@ -191,6 +401,33 @@ DynamicMemBlockPtr DynamicMemPoolBestFit::FindMemBlock(const DeviceMemPtr &devic
 
 void DynamicMemPoolBestFit::FreeTensorMem(const DeviceMemPtr &device_addr) {
   MS_EXCEPTION_IF_NULL(device_addr);
+  bool need_sample = slab_thread_caches.NeedSample();
+  auto start_time = need_sample ? std::chrono::steady_clock::now() : std::chrono::steady_clock::time_point();
+  auto class_index = FindSlabClass(device_addr);
+  if (class_index < SLAB_CLASS_NUM) {
+    FreeSlabMem(device_addr, class_index);
+    if (need_sample) {
+      RecordLatency(start_time, &slab_statistics_.slab_free_time_, &slab_statistics_.slab_free_samples_);
+    }
+    return;
+  }
+  FreeBestFitMem(device_addr);
+  if (need_sample) {
+    RecordLatency(start_time, &slab_statistics_.best_fit_free_time_, &slab_statistics_.best_fit_free_samples_);
+  }
+}
+
+void DynamicMemPoolBestFit::FreeSlabMem(const DeviceMemPtr &device_addr, size_t class_index) {
+  auto thread_cache = slab_thread_caches.Fetch(this);
+  auto &free_list = thread_cache->free_lists_[class_index];
+  free_list.emplace_back(device_addr);
+  (void)slab_statistics_.free_count_[class_index].fetch_add(1, std::memory_order_relaxed);
+  if (free_list.size() > kSlabCacheMaxNum) {
+    ReleaseThreadCache(&free_list, class_index);
+  }
+}
+
+void DynamicMemPoolBestFit::FreeBestFitMem(const DeviceMemPtr &device_addr) {
   std::lock_guard<std::mutex> locker(mutex_);
   auto mem_block = FindMemBlock(device_addr);
   if (mem_block == nullptr) {
@@ -266,6 +503,19 @@ void DynamicMemPoolBestFit::EraseIdleMemBuf(size_t size, const DeviceMemPtr &dev
 }
 
 void DynamicMemPoolBestFit::ReleaseDeviceRes() {
+  // The slabs are released with the memory blocks, and the memory cached by the threads becomes invalid.
+  {
+    std::lock_guard<std::mutex> slab_locker(slab_mutex_);
+    for (auto &free_list : slab_free_lists_) {
+      free_list.clear();
+    }
+    spare_slabs_.clear();
+    slab_generation_++;
+  }
+  {
+    std::unique_lock<std::shared_mutex> slab_class_locker(slab_class_mutex_);
+    slab_class_map_.clear();
+  }
   std::lock_guard<std::mutex> locker(mutex_);
   MS_LOG(INFO) << "The dynamic memory pool total size is " << total_mem_statistics_ << ", total used size is "
                << total_used_mem_statistics_ << ", used peak size is " << used_mem_peak_statistics_ << ".";
@@ -280,6 +530,7 @@ void DynamicMemPoolBestFit::ReleaseDeviceRes() {
 }
 
 void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
+  DumpSlabInfo();
   std::lock_guard<std::mutex> locker(mutex_);
   MS_LOG(INFO) << "Start dump dynamic memory pool info.";
   DeviceAddrMapMemBuf mem_block_map;
@@ -288,6 +539,7 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
   size_t total_used_mem = 0;
   size_t total_idle_mem1 = 0;
   size_t total_idle_mem2 = 0;
+  size_t max_idle_mem = 0;
   // Dump the memory block info and memory buf info
   MS_LOG(INFO) << "Dump all mem_block info: counts[" << global_mem_block_list_.size() << "].";
   for (auto iter = global_mem_block_list_.begin(); iter != global_mem_block_list_.end(); ++iter) {
@@ -314,12 +566,17 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
     mem_buf = iter_idle->second;
     MS_EXCEPTION_IF_NULL(mem_buf);
     total_idle_mem2 += mem_buf->size_;
+    max_idle_mem = std::max(max_idle_mem, mem_buf->size_);
     MS_LOG(INFO) << "Idle mem_buf info: size[" << mem_buf->size_ << "] address[" << mem_buf->device_addr_ << "] status["
                  << mem_buf->status_ << "].";
   }
   // Dump the memory statistical info
   MS_LOG(INFO) << "Total allocated memory[" << total_mem << "], used memory[" << total_used_mem << "], idle memory["
                << total_idle_mem1 << "].";
+  // The external fragmentation is the part of idle memory which can't be allocated in one piece.
+  double fragmentation = total_idle_mem2 == 0 ? 0 : 1 - static_cast<double>(max_idle_mem) / total_idle_mem2;
+  MS_LOG(INFO) << "Best fit pool max idle mem_buf[" << max_idle_mem << "], external fragmentation[" << fragmentation
+               << "].";
   if (total_idle_mem1 != total_idle_mem2) {
     MS_LOG(ERROR) << "Check error: the idle memory in the mem_block is not equal the global idle memory.";
   }
@@ -328,5 +585,39 @@ void DynamicMemPoolBestFit::DumpDynamicMemPoolInfo() {
   }
   MS_LOG(INFO) << "Finish dump dynamic memory pool info.";
 }
+
+void DynamicMemPoolBestFit::DumpSlabInfo() {
+  size_t slab_num = 0;
+  {
+    std::shared_lock<std::shared_mutex> locker(slab_class_mutex_);
+    slab_num = slab_class_map_.size();
+  }
+  std::lock_guard<std::mutex> locker(slab_mutex_);
+  MS_LOG(INFO) << "Dump slab info: slab counts[" << slab_num << "] spare slab counts[" << spare_slabs_.size()
+               << "] slab size[" << SLAB_SIZE << "].";
+  for (size_t i = 0; i < SLAB_CLASS_NUM; ++i) {
+    size_t alloc_count = slab_statistics_.alloc_count_[i];
+    size_t free_count = slab_statistics_.free_count_[i];
+    size_t class_size = SLAB_MIN_CLASS_SIZE << i;
+    MS_LOG(INFO) << "Slab size class[" << class_size << "] alloc counts[" << alloc_count << "] free counts["
+                 << free_count << "] used memory[" << (alloc_count - free_count) * class_size
+                 << "] central idle counts[" << slab_free_lists_[i].size() << "].";
+  }
+  // The internal fragmentation is the part of size class memory which is not requested.
+  size_t request_size = slab_statistics_.request_size_;
+  size_t class_size = slab_statistics_.class_size_;
+  double fragmentation = class_size == 0 ? 0 : 1 - static_cast<double>(request_size) / class_size;
+  MS_LOG(INFO) << "Slab accumulated request size[" << request_size << "] class size[" << class_size
+               << "], internal fragmentation[" << fragmentation << "].";
+  MS_LOG(INFO) << "Sampled average latency(ns): slab alloc["
+               << AverageLatency(slab_statistics_.slab_alloc_time_, slab_statistics_.slab_alloc_samples_)
+               << "] slab free["
+               << AverageLatency(slab_statistics_.slab_free_time_, slab_statistics_.slab_free_samples_)
+               << "] best fit alloc["
+               << AverageLatency(slab_statistics_.best_fit_alloc_time_, slab_statistics_.best_fit_alloc_samples_)
+               << "] best fit free["
+               << AverageLatency(slab_statistics_.best_fit_free_time_, slab_statistics_.best_fit_free_samples_)
+               << "].";
+}
 }  // namespace device
 }  // namespace mindspore
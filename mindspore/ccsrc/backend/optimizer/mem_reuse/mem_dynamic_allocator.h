@@ -19,11 +19,14 @@
 
 #include <memory>
 #include <map>
+#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <utility>
 #include <thread>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 
 namespace mindspore {
 namespace device {
@@ -38,6 +41,13 @@ static const size_t DYNAMIC_MEM_ALIGN_SIZE = 512;
 // The minimum unit size (1G) of memory block used for dynamic extend.
 static const size_t DYNAMIC_MEM_ALLOC_UNIT_SIZE = 1024 << 20;
 
+// The small memory is allocated from the slabs by the size class,
+// the size class is the power of two from 512 bytes to 32K.
+static const size_t SLAB_MIN_CLASS_SIZE = 512;
+static const size_t SLAB_CLASS_NUM = 7;
+// The slabs are aligned by the slab size and carved from the memory buf of best fit pool.
+static const size_t SLAB_SIZE = 256 << 10;
+
 // The Comparator of device address from small to large.
 struct DeviceAddrCmp {
   bool operator()(const DeviceMemPtr &addr1, const DeviceMemPtr &addr2) const { return addr1 < addr2; }
@@ -74,10 +84,31 @@ class DynamicMemBlock {
 };
 using DynamicMemBlockPtr = std::shared_ptr<DynamicMemBlock>;
 
+// The statistics of the slab front end, they are updated without the lock.
+struct SlabStatistics {
+  // The counts of memory alloc and free for each size class.
+  std::atomic<size_t> alloc_count_[SLAB_CLASS_NUM]{};
+  std::atomic<size_t> free_count_[SLAB_CLASS_NUM]{};
+  // The accumulated size of alloc request and the size class, for the internal fragmentation.
+  std::atomic<size_t> request_size_{0};
+  std::atomic<size_t> class_size_{0};
+  // The sampled latency of memory alloc and free in nanoseconds.
+  std::atomic<size_t> slab_alloc_time_{0};
+  std::atomic<size_t> slab_alloc_samples_{0};
+  std::atomic<size_t> slab_free_time_{0};
+  std::atomic<size_t> slab_free_samples_{0};
+  std::atomic<size_t> best_fit_alloc_time_{0};
+  std::atomic<size_t> best_fit_alloc_samples_{0};
+  std::atomic<size_t> best_fit_free_time_{0};
+  std::atomic<size_t> best_fit_free_samples_{0};
+};
+
 // The main class of dynamic memory pool.
+// The small memory is served by the thread local cache of size class in front of the best fit pool, and the large
+// memory is served by the best fit pool directly.
 class DynamicMemPoolBestFit {
  public:
-  DynamicMemPoolBestFit() = default;
+  DynamicMemPoolBestFit();
   virtual ~DynamicMemPoolBestFit();
   // The main program entry of memory alloc.
   DeviceMemPtr AllocTensorMem(size_t size);
@@ -100,6 +131,12 @@ class DynamicMemPoolBestFit {
   size_t used_mem_statistics() const { return total_used_mem_statistics_; }
   size_t used_mem_peak_statistics() const { return used_mem_peak_statistics_; }
 
+  // The related interface of the thread local cache of small memory.
+  size_t pool_id() const { return pool_id_; }
+  size_t slab_generation() const { return slab_generation_; }
+  // Return the cached memory of the free lists of size class to the pool, when the thread exits.
+  void ReturnThreadCache(size_t generation, std::vector<DeviceMemPtr> *free_lists);
+
   // The related interface of device memory real operation, needs override by device type.
   virtual size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) = 0;
   virtual bool FreeDeviceMem(const DeviceMemPtr &addr) = 0;
@@ -111,8 +148,27 @@ class DynamicMemPoolBestFit {
   virtual size_t AlignMemorySize(size_t size) const;
   // Calculate memory block required alloc size when adding the memory block.
   virtual size_t CalMemBlockAllocSize(size_t size);
+  // Whether the small memory is allocated from the slabs of size class, the device pools which enable it override this.
+  virtual bool IsSlabEnabled() const { return false; }
 
  private:
+  // Alloc and free the memory from best fit pool.
+  DeviceMemPtr AllocBestFitMem(size_t size);
+  void FreeBestFitMem(const DeviceMemPtr &device_addr);
+  // Alloc and free the small memory from the slab of size class.
+  DeviceMemPtr AllocSlabMem(size_t class_index, size_t size);
+  void FreeSlabMem(const DeviceMemPtr &device_addr, size_t class_index);
+  // Fill the free list of thread cache from the central free list, add new slab if the central free list is empty.
+  bool FillThreadCache(std::vector<DeviceMemPtr> *free_list, size_t class_index);
+  // Return the half memory of free list in thread cache to the central free list.
+  void ReleaseThreadCache(std::vector<DeviceMemPtr> *free_list, size_t class_index);
+  // Add the slab for size class, the slabs are carved from the chunk allocated from the best fit pool.
+  bool AddSlab(size_t class_index);
+  // Find the size class of the device address in the slab, return SLAB_CLASS_NUM if not in slab.
+  size_t FindSlabClass(const DeviceMemPtr &device_addr);
+  // Dump the slab and latency statistics.
+  void DumpSlabInfo();
+
   // Get the minimum memory unit size using for dynamic extend.
   size_t mem_alloc_unit_size() const { return DYNAMIC_MEM_ALLOC_UNIT_SIZE; }
   // Find the idle memory buf by aligned size when memory alloc.
@@ -145,6 +201,20 @@ class DynamicMemPoolBestFit {
 
   // Support multi-thread.
   std::mutex mutex_;
+
+  // The unique id of pool, used by the thread local cache to distinguish the pools.
+  size_t pool_id_{0};
+  // Increased when the device memory is released, the thread local cache of old generation is invalid.
+  std::atomic<size_t> slab_generation_{0};
+  // The central free lists of size class, shared by all the threads.
+  std::vector<DeviceMemPtr> slab_free_lists_[SLAB_CLASS_NUM];
+  // The slabs which are carved but not assigned to the size class.
+  std::vector<DeviceMemPtr> spare_slabs_;
+  std::mutex slab_mutex_;
+  // The map of slab index (device address / SLAB_SIZE) to size class, for finding the size class when memory free.
+  std::unordered_map<size_t, size_t> slab_class_map_;
+  std::shared_mutex slab_class_mutex_;
+  SlabStatistics slab_statistics_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -315,6 +315,9 @@ class KernelGraph : public FuncGraph {
   bool is_all_nop_node() const { return is_all_nop_node_; }
   void set_is_all_nop_node(bool is_all_nop_node) { is_all_nop_node_ = is_all_nop_node; }
 
+  // The memory of the static memory plan, which is released to the device with the graph.
+  void set_static_memory(const std::shared_ptr<void> &static_memory) { static_memory_ = static_memory; }
+
  private:
   // remove value node form graph
   bool RemoveValueNodeFromGraph(const ValueNodePtr &value_node);
@@ -414,6 +417,8 @@ class KernelGraph : public FuncGraph {
 
   // If all the nodes of graph is the nop node.
   bool is_all_nop_node_{false};
+
+  std::shared_ptr<void> static_memory_{nullptr};
 };
 }  // namespace session
 using KernelGraphPtr = std::shared_ptr<session::KernelGraph>;
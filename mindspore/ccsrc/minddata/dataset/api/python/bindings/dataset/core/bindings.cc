@@ -57,6 +57,14 @@ PYBIND_REGISTER(ConfigManager, 0, ([](const py::module *m) {
                     .def("set_worker_connector_size", &ConfigManager::set_worker_connector_size)
                     .def("set_enable_shared_mem", &ConfigManager::set_enable_shared_mem)
                     .def("get_enable_shared_mem", &ConfigManager::enable_shared_mem)
+                    .def("set_enable_autotune", &ConfigManager::set_enable_autotune)
+                    .def("get_enable_autotune", &ConfigManager::enable_autotune)
+                    .def("set_autotune_interval", &ConfigManager::set_autotune_interval)
+                    .def("get_autotune_interval", &ConfigManager::autotune_interval)
+                    .def("set_enable_tensor_pool", &ConfigManager::set_enable_tensor_pool)
+                    .def("get_enable_tensor_pool", &ConfigManager::enable_tensor_pool)
+                    .def("set_file_split_size", &ConfigManager::set_file_split_size)
+                    .def("get_file_split_size", &ConfigManager::file_split_size)
                     .def("load", [](ConfigManager &c, std::string s) { THROW_IF_ERROR(c.LoadFile(s)); });
                 }));
 
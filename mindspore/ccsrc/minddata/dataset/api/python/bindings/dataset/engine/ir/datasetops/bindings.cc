@@ -224,8 +224,13 @@ PYBIND_REGISTER(RepeatNode, 2, ([](const py::module *m) {
 PYBIND_REGISTER(ShuffleNode, 2, ([](const py::module *m) {
                   (void)py::class_<ShuffleNode, DatasetNode, std::shared_ptr<ShuffleNode>>(*m, "ShuffleNode",
                                                                                            "to create a ShuffleNode")
-                    .def(py::init([](std::shared_ptr<DatasetNode> self, int32_t shuffle_size, bool reset_every_epoch) {
+                    .def(py::init([](std::shared_ptr<DatasetNode> self, int32_t shuffle_size, bool reset_every_epoch,
+                                     std::string exchange_group, int32_t num_ranks, int32_t rank,
+                                     int32_t exchange_size) {
                       auto shuffle = std::make_shared<ShuffleNode>(self, shuffle_size, reset_every_epoch);
+                      if (!exchange_group.empty()) {
+                        shuffle->SetShuffleExchange(exchange_group, num_ranks, rank, exchange_size);
+                      }
                       THROW_IF_ERROR(shuffle->ValidateParams());
                       return shuffle;
                     }));
@@ -91,6 +91,7 @@ PYBIND_REGISTER(ShuffleMode, 1, ([](const py::module *m) {
                     .value("FILES", ShuffleMode::kFiles)
                     .value("GLOBAL", ShuffleMode::kGlobal)
                     .value("INFILE", ShuffleMode::kInfile)
+                    .value("BLOCK", ShuffleMode::kBlock)
                     .export_values();
                 }));
 
@@ -51,7 +51,11 @@ ConfigManager::ConfigManager()
       num_cpu_threads_(std::thread::hardware_concurrency()),
       auto_num_workers_num_shards_(1),
       auto_worker_config_(0),
-      enable_shared_mem_(true) {
+      enable_shared_mem_(true),
+      enable_autotune_(kDftEnableAutotune),
+      autotune_interval_(kCfgAutotuneInterval),
+      enable_tensor_pool_(kDftEnableTensorPool),
+      file_split_size_(kDftFileSplitSize) {
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
   num_parallel_workers_ = num_parallel_workers_ < num_cpu_threads_ ? num_parallel_workers_ : num_cpu_threads_;
   std::string env_cache_host = common::GetEnv("MS_CACHE_HOST");
@@ -90,6 +94,10 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_prefetch_size(j.value("prefetchSize", prefetch_size_));
+  set_enable_autotune(j.value("enableAutotune", enable_autotune_));
+  set_autotune_interval(j.value("autotuneInterval", autotune_interval_));
+  set_enable_tensor_pool(j.value("enableTensorPool", enable_tensor_pool_));
+  set_file_split_size(j.value("fileSplitSize", file_split_size_));
   return Status::OK();
 }
 
@@ -222,6 +222,40 @@ class ConfigManager {
   // @return The experimental config used by AutoNumWorker, each 1 refers to a different setup configuration
   void set_auto_worker_config_(uint8_t cfg) { auto_worker_config_ = cfg; }
 
+  // setter function
+  // @param enable - Whether to tune the number of workers and connector sizes while the pipeline runs
+  void set_enable_autotune(bool enable) { enable_autotune_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the pipeline autotuner is enabled
+  bool enable_autotune() const { return enable_autotune_; }
+
+  // setter function
+  // @param interval - The interval in milliseconds between two decisions of the autotuner
+  void set_autotune_interval(uint32_t interval) { autotune_interval_ = interval; }
+
+  // getter function
+  // @return The interval in milliseconds between two decisions of the autotuner
+  uint32_t autotune_interval() const { return autotune_interval_; }
+
+  // setter function
+  // @param enable - Whether each pipeline recycles the storage of the tensors it releases and lets the ops whose
+  //     output has the shape and type of their input write it in place
+  void set_enable_tensor_pool(bool enable) { enable_tensor_pool_ = enable; }
+
+  // getter function
+  // @return - Flag to indicate whether the pipelines use a tensor pool
+  bool enable_tensor_pool() const { return enable_tensor_pool_; }
+
+  // setter function
+  // @param size - The number of bytes of a file the CSV and TFRecord readers give to one worker, so that several
+  //     workers read a large file at once. 0 to give each worker whole files.
+  void set_file_split_size(int64_t size) { file_split_size_ = size; }
+
+  // getter function
+  // @return The number of bytes of a file read by one worker of the CSV and TFRecord readers
+  int64_t file_split_size() const { return file_split_size_; }
+
   // setter function
   // @param enable - To enable multiprocessing to use shared memory
   void set_enable_shared_mem(bool enable) { enable_shared_mem_ = enable; }
@@ -253,6 +287,10 @@ class ConfigManager {
   int32_t auto_num_workers_num_shards_;
   uint8_t auto_worker_config_;
   bool enable_shared_mem_;
+  bool enable_autotune_;
+  uint32_t autotune_interval_;
+  bool enable_tensor_pool_;
+  int64_t file_split_size_;
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
   Status FromJson(const nlohmann::json &j);
@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <mutex>
+#include <utility>
 
 #include "minddata/dataset/core/config_manager.h"
 #ifndef ENABLE_ANDROID
@@ -33,6 +34,11 @@ namespace dataset {
 std::unique_ptr<GlobalContext> GlobalContext::global_context_ = nullptr;
 std::once_flag GlobalContext::init_instance_flag_;
 
+namespace {
+// The pool of the pipeline the thread works for
+thread_local std::shared_ptr<MemoryPool> thread_mem_pool_ = nullptr;
+}  // namespace
+
 constexpr int GlobalContext::kArenaSize;
 constexpr int GlobalContext::kMaxSize;
 constexpr bool GlobalContext::kInitArena;
@@ -66,6 +72,10 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::thread_mem_pool() { return thread_mem_pool_; }
+
+void GlobalContext::set_thread_mem_pool(std::shared_ptr<MemoryPool> pool) { thread_mem_pool_ = std::move(pool); }
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
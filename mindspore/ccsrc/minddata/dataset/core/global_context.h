@@ -76,6 +76,15 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Getter method
+  // @return the pool of the pipeline the calling thread works for, nullptr if it does not work for one
+  static std::shared_ptr<MemoryPool> thread_mem_pool();
+
+  // Setter method
+  // @note The tensors created by the calling thread take their storage from this pool instead of the global one
+  // @param pool - the pool of the pipeline the calling thread works for, nullptr when it stops working for it
+  static void set_thread_mem_pool(std::shared_ptr<MemoryPool> pool);
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
@@ -82,9 +82,12 @@ errno_t memcpy_ss(uchar *dest, size_t destMax, const uchar *src, size_t count) {
   return 0;
 }
 Tensor::Tensor(const TensorShape &shape, const DataType &type) : shape_(shape), type_(type), data_(nullptr) {
-  // grab the mem pool from global context and create the allocator for char data area
-  std::shared_ptr<MemoryPool> global_pool = GlobalContext::Instance()->mem_pool();
-  data_allocator_ = std::make_unique<Allocator<unsigned char>>(global_pool);
+  // grab the mem pool of the pipeline, or else the global one, and create the allocator for char data area
+  std::shared_ptr<MemoryPool> pool = GlobalContext::thread_mem_pool();
+  if (pool == nullptr) {
+    pool = GlobalContext::Instance()->mem_pool();
+  }
+  data_allocator_ = std::make_unique<Allocator<unsigned char>>(pool);
 }
 
 Tensor::Tensor(Tensor &&other) noexcept
@@ -160,6 +163,25 @@ Status Tensor::CreateFromMemory(const TensorShape &shape, const DataType &type,
   return Status::OK();
 }
 
+Status Tensor::CreateFromExternalMemory(const TensorShape &shape, const DataType &type, uchar *data,
+                                        const dsize_t &length, std::shared_ptr<MemoryPool> owner, TensorPtr *out) {
+  CHECK_FAIL_RETURN_UNEXPECTED(data != nullptr, "Pointer to source data is null.");
+  RETURN_UNEXPECTED_IF_NULL(owner);
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "Only a numeric tensor can be created on external memory.");
+  CHECK_FAIL_RETURN_UNEXPECTED(reinterpret_cast<uintptr_t>(data) % type.SizeInBytes() == 0,
+                               "External memory is not aligned to the data type.");
+  const TensorAlloc *alloc = GlobalContext::Instance()->tensor_allocator();
+  *out = std::allocate_shared<Tensor>(*alloc, shape, type);
+  CHECK_FAIL_RETURN_UNEXPECTED((*out)->SizeInBytes() == length, "Length of source data does not match the shape.");
+  // The data is released to its owner rather than to the memory pool of the pipeline
+  (*out)->data_allocator_ = std::make_unique<Allocator<unsigned char>>(std::move(owner));
+  if (length > 0) {
+    (*out)->data_ = data;
+    (*out)->data_end_ = data + length;
+  }
+  return Status::OK();
+}
+
 #ifdef ENABLE_PYTHON
 Status Tensor::CreateFromNpString(py::array arr, std::shared_ptr<Tensor> *out) {
   std::vector<dsize_t> shape;
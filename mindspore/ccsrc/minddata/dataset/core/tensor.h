@@ -109,6 +109,19 @@ class Tensor {
   static Status CreateFromMemory(const TensorShape &shape, const DataType &type, const uchar *src,
                                  const dsize_t &length, TensorPtr *out);
 
+  /// Create a numeric tensor on top of memory it does not own. No data is copied.
+  /// \note The owner is kept alive as long as the tensor, and its Deallocate is called with data when the tensor
+  ///     is destroyed. The owner decides what releasing the memory means.
+  /// \param[in] shape shape of the output tensor
+  /// \param[in] type type of the output tensor, which must be numeric
+  /// \param[in] data pointer to the data, aligned to the size of the type
+  /// \param[in] length length of the data
+  /// \param[in] owner the memory pool which owns the data
+  /// \param[out] out Generated tensor
+  /// \return Status code
+  static Status CreateFromExternalMemory(const TensorShape &shape, const DataType &type, uchar *data,
+                                         const dsize_t &length, std::shared_ptr<MemoryPool> owner, TensorPtr *out);
+
   /// Create a copy of the input tensor
   /// \param[in] in original tensor to be copied
   /// \param[out] out output tensor to be generated
@@ -41,6 +41,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
       shm_mem_sz_(kDefaultSharedMemorySize),
       log_level_(kDefaultLogLevel),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
+      persistent_(false),
       hostname_(kCfgDefaultCacheHost),
       spill_dir_(""),
       command_id_(CommandId::kCmdUnknown) {
@@ -90,6 +91,7 @@ CacheAdminArgHandler::CacheAdminArgHandler()
   arg_map_["--memory_cap_ratio"] = ArgValue::kArgMemoryCapRatio;
   arg_map_["--list_sessions"] = ArgValue::kArgListSessions;
   arg_map_["--server_info"] = ArgValue::kArgServerInfo;
+  arg_map_["--persistent"] = ArgValue::kArgPersistent;
   // Initialize argument tracker with false values
   for (int16_t i = 0; i < static_cast<int16_t>(ArgValue::kArgNumArgs); ++i) {
     ArgValue currAV = static_cast<ArgValue>(i);
@@ -343,6 +345,12 @@ Status CacheAdminArgHandler::ParseArgStream(std::stringstream *arg_stream) {
         RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream, CommandId::kCmdServerInfo));
         break;
       }
+      case ArgValue::kArgPersistent: {
+        // A flag without an argument field
+        RETURN_IF_NOT_OK(AssignArg(tok, static_cast<std::string *>(nullptr), arg_stream));
+        persistent_ = true;
+        break;
+      }
       default: {
         // Save space delimited trailing arguments
         trailing_args_ += (" " + tok);
@@ -385,6 +393,8 @@ Status CacheAdminArgHandler::Validate() {
     return Status(StatusCode::kMDSyntaxError, "Memory cap ratio should be positive and no greater than 1");
   if (port_ < kMinLegalPort || port_ > kMaxLegalPort)
     return Status(StatusCode::kMDSyntaxError, "Port must be in range (1025..65535).");
+  if (persistent_ && spill_dir_.empty())
+    return Status(StatusCode::kMDSyntaxError, "The --persistent option requires a spilling directory.");
 
   return Status::OK();
 }
@@ -628,8 +638,9 @@ Status CacheAdminArgHandler::StartServer(CommandId command_id) {
     std::string minloglevel_string = std::to_string(log_level_);
     std::string daemonize_string = "true";
     std::string memory_cap_ratio_string = std::to_string(memory_cap_ratio_);
+    std::string persistent_string = persistent_ ? "true" : "false";
 
-    char *argv[9];
+    char *argv[10];
     argv[0] = cache_server_binary.data();
     argv[1] = spill_dir_.data();
     argv[2] = workers_string.data();
@@ -638,7 +649,8 @@ Status CacheAdminArgHandler::StartServer(CommandId command_id) {
     argv[5] = minloglevel_string.data();
     argv[6] = daemonize_string.data();
     argv[7] = memory_cap_ratio_string.data();
-    argv[8] = nullptr;
+    argv[8] = persistent_string.data();
+    argv[9] = nullptr;
 
     // Now exec the binary
     execv(cache_server_binary.data(), argv);
@@ -657,6 +669,7 @@ void CacheAdminArgHandler::Help() {
   std::cerr << "                [[-p | --port] <port number>]             Default is " << kCfgDefaultCachePort << ".\n";
   std::cerr << "                [[-w | --workers] <number of workers>]    Default is " << kDefaultNumWorkers << ".\n";
   std::cerr << "                [[-s | --spilldir] <spilling directory>]  Default is no spilling.\n";
+  std::cerr << "                [--persistent]                            Keep spilled caches across restarts.\n";
   std::cerr << "                [[-l | --loglevel] <log level>]           Default is 1 (INFO level).\n";
   std::cerr << "            [--destroy_session  | -d] <session id>\n";
   std::cerr << "                [[-p | --port] <port number>]\n";
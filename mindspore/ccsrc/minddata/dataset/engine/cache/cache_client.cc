@@ -24,7 +24,14 @@
 namespace mindspore {
 namespace dataset {
 CacheClient::Builder::Builder()
-    : session_id_(0), cache_mem_sz_(0), spill_(false), hostname_(""), port_(0), num_connections_(0), prefetch_size_(0) {
+    : session_id_(0),
+      cache_mem_sz_(0),
+      spill_(false),
+      hostname_(""),
+      port_(0),
+      num_connections_(0),
+      prefetch_size_(0),
+      local_bypass_(true) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   hostname_ = cfg->cache_host();
   port_ = cfg->cache_port();
@@ -36,7 +43,7 @@ Status CacheClient::Builder::Build(std::shared_ptr<CacheClient> *out) {
   RETURN_UNEXPECTED_IF_NULL(out);
   RETURN_IF_NOT_OK(SanityCheck());
   *out = std::make_shared<CacheClient>(session_id_, cache_mem_sz_, spill_, hostname_, port_, num_connections_,
-                                       prefetch_size_);
+                                       prefetch_size_, local_bypass_);
   return Status::OK();
 }
 
@@ -55,11 +62,12 @@ Status CacheClient::Builder::SanityCheck() {
 
 // Constructor
 CacheClient::CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname,
-                         int32_t port, int32_t num_connections, int32_t prefetch_size)
+                         int32_t port, int32_t num_connections, int32_t prefetch_size, bool allow_local_bypass)
     : server_connection_id_(0),
       cache_mem_sz_(cache_mem_sz),
       spill_(spill),
       client_id_(-1),
+      allow_local_bypass_(allow_local_bypass),
       local_bypass_(false),
       num_connections_(num_connections),
       prefetch_size_(prefetch_size),
@@ -130,21 +138,36 @@ Status CacheClient::GetRows(const std::vector<row_id_type> &row_id, TensorTable
   auto rq = std::make_shared<BatchFetchRequest>(this, row_id);
   RETURN_IF_NOT_OK(PushRequest(rq));
   RETURN_IF_NOT_OK(rq->Wait());
-  int64_t mem_addr;
-  Status rc = rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), &mem_addr);
-  // Free the memory by sending a request back to the server.
+  // If the rows are in shared memory, the tensors are built on top of it and the memory is only freed
+  // when the pin goes away with the last of them.
+  std::shared_ptr<MemoryPool> pin;
+  int64_t mem_addr = rq->SharedMemoryAddr();
   if (mem_addr != -1) {
-    auto mfree_req = std::make_shared<FreeSharedBlockRequest>(server_connection_id_, client_id_, mem_addr);
-    Status rc2 = PushRequest(mfree_req);
-    // But we won't wait for the result for the sake of performance.
-    if (rc.IsOk() && rc2.IsError()) {
-      rc = rc2;
-    }
+    pin = std::make_shared<SharedBlockPin>(comm_, server_connection_id_, client_id_, mem_addr);
   }
-  return rc;
+  return rq->RestoreRows(out, comm_->SharedMemoryBaseAddr(), std::move(pin));
 }
 
-Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
+CacheClient::SharedBlockPin::SharedBlockPin(std::shared_ptr<CacheClientGreeter> comm, connection_id_type connection_id,
+                                            int32_t client_id, int64_t addr)
+    : comm_(std::move(comm)), connection_id_(connection_id), client_id_(client_id), addr_(addr) {}
+
+CacheClient::SharedBlockPin::~SharedBlockPin() {
+  // The tensors outlived the client. There is no connection left to give the block back on.
+  if (comm_->ServiceState() != Service::STATE::kRunning) {
+    MS_LOG(WARNING) << "Shared memory block at " << addr_ << " is released after the cache client is gone.";
+    return;
+  }
+  // Free the memory by sending a request back to the server.
+  // But we won't wait for the result for the sake of performance.
+  auto mfree_req = std::make_shared<FreeSharedBlockRequest>(connection_id_, client_id_, addr_);
+  Status rc = comm_->HandleRequest(mfree_req);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Failed to free shared memory block at " << addr_ << ". " << rc;
+  }
+}
+
+Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id, uint32_t source_id) {
   UniqueLock lck(&mux_);
   // To create a cache, we identify ourself at the client by:
   // - the shared session id
@@ -199,7 +222,7 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     // Start the comm layer to receive reply
     RETURN_IF_NOT_OK(comm_->ServiceStart());
     // Initiate connection
-    auto rq = std::make_shared<CreateCacheRequest>(this, cinfo_, cache_mem_sz_, createFlag);
+    auto rq = std::make_shared<CreateCacheRequest>(this, cinfo_, cache_mem_sz_, createFlag, source_id);
     RETURN_IF_NOT_OK(PushRequest(rq));
     Status rc = rq->Wait();
     bool success = (rc.IsOk() || rc.StatusCode() == StatusCode::kMDDuplicateKey);
@@ -210,7 +233,9 @@ Status CacheClient::CreateCache(uint32_t tree_crc, bool generate_id) {
     }
     if (success) {
       // Attach to shared memory for local client
-      RETURN_IF_NOT_OK(comm_->AttachToSharedMemory(&local_bypass_));
+      if (allow_local_bypass_) {
+        RETURN_IF_NOT_OK(comm_->AttachToSharedMemory(&local_bypass_));
+      }
       if (local_bypass_) {
         async_buffer_stream_ = std::make_shared<AsyncBufferStream>();
         RETURN_IF_NOT_OK(async_buffer_stream_->Init(this));
@@ -117,6 +117,14 @@ class CacheClient {
       return *this;
     }
 
+    /// Setter function to allow a client on the same host as the server to exchange rows through shared memory
+    /// \param local_bypass
+    /// \return Builder object itself
+    Builder &SetLocalBypass(bool local_bypass) {
+      local_bypass_ = local_bypass;
+      return *this;
+    }
+
     /// Getter functions
     session_id_type GetSessionId() const { return session_id_; }
     uint64_t GetCacheMemSz() const { return cache_mem_sz_; }
@@ -125,6 +133,7 @@ class CacheClient {
     int32_t GetPort() const { return port_; }
     int32_t GetNumConnections() const { return num_connections_; }
     int32_t GetPrefetchSize() const { return prefetch_size_; }
+    bool isLocalBypass() const { return local_bypass_; }
 
     Status SanityCheck();
 
@@ -138,14 +147,16 @@ class CacheClient {
     int32_t port_;
     int32_t num_connections_;
     int32_t prefetch_size_;
+    bool local_bypass_;
   };
 
   /// \brief Constructor
   /// \param session_id A user assigned session id for the current pipeline
   /// \param cache_mem_sz Size of the memory set aside for the row caching. 0 for unlimited
   /// \param spill Spill to disk if out of memory
+  /// \param allow_local_bypass Exchange rows through shared memory if the server is on the same host
   CacheClient(session_id_type session_id, uint64_t cache_mem_sz, bool spill, std::string hostname, int32_t port,
-              int32_t num_connections, int32_t prefetch_size);
+              int32_t num_connections, int32_t prefetch_size, bool allow_local_bypass = true);
 
   /// \brief Destructor
   ~CacheClient();
@@ -158,6 +169,8 @@ class CacheClient {
 
   /// \brief Fetch a list of rows from the cache server. An empty TensorRow will be returned if there is
   /// any cache miss
+  /// \note For a local client, the tensors fetched are built on top of the shared memory the server puts the rows
+  /// in. The memory is given back to the server once all the tensors are gone.
   /// \param row_id A vector of row id's
   /// \param out A TensorTable of TensorRows.
   /// \return return code
@@ -166,8 +179,9 @@ class CacheClient {
   /// \brief Create a cache.
   /// \param tree_crc  A crc that was generated during tree prepare phase
   /// \param generate_id Let the cache service generate row id
+  /// \param source_id Identity of the source files, a persisted cache is rebuilt when they change
   /// \return Status object
-  Status CreateCache(uint32_t tree_crc, bool generate_id);
+  Status CreateCache(uint32_t tree_crc, bool generate_id, uint32_t source_id = 0);
 
   /// \brief Destroy a cache. Like Purge but the cache is deleted and can't be reused.
   /// \return Status object
@@ -283,6 +297,7 @@ class CacheClient {
   int32_t client_id_;
   std::vector<int32_t> cpu_list_;
   // Comm layer
+  bool allow_local_bypass_;
   bool local_bypass_;
   int32_t num_connections_;
   int32_t prefetch_size_;
@@ -306,6 +321,34 @@ class CacheClient {
   };
   std::unique_ptr<CacheMissKeys> cache_miss_keys_;
 
+  /// A block of shared memory the server has sent rows back in. The tensors built on top of the block share the
+  /// ownership of it. The block is given back to the server when the last of them is gone.
+  class SharedBlockPin : public MemoryPool {
+   public:
+    SharedBlockPin(std::shared_ptr<CacheClientGreeter> comm, connection_id_type connection_id, int32_t client_id,
+                   int64_t addr);
+    ~SharedBlockPin() override;
+
+    /// Nothing can be carved out of the block
+    Status Allocate(size_t n, void **p) override { return Status(StatusCode::kMDNotImplementedYet); }
+    Status Reallocate(void **p, size_t old_sz, size_t new_sz) override {
+      return Status(StatusCode::kMDNotImplementedYet);
+    }
+
+    /// A tensor gives back its part of the block. The block is freed as a whole in the destructor.
+    void Deallocate(void *p) override {}
+
+    uint64_t get_max_size() const override { return 0; }
+    int PercentFree() const override { return 0; }
+
+   private:
+    // Keep the comm layer, and the shared memory it is attached to, alive as long as the block
+    std::shared_ptr<CacheClientGreeter> comm_;
+    connection_id_type connection_id_;
+    int32_t client_id_;
+    int64_t addr_;
+  };
+
   /// A data stream of back-to-back serialized tensor rows.
   class AsyncBufferStream {
    public:
@@ -102,7 +102,8 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
   }
 }
 
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out) {
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        std::shared_ptr<MemoryPool> owner) {
   RETURN_UNEXPECTED_IF_NULL(col_ts);
   auto shape_in = col_ts->dims();
   auto type_in = col_ts->type();
@@ -135,8 +136,16 @@ Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data,
 
   DataType type(dest);
   std::shared_ptr<Tensor> ts;
-  RETURN_IF_NOT_OK(
-    Tensor::CreateFromMemory(shape, type, static_cast<const unsigned char *>(data.GetPointer()), data.GetSize(), &ts));
+  auto *ptr = static_cast<const unsigned char *>(data.GetPointer());
+  // Tensors are laid out back to back in a row, so only those which happen to be aligned can be used in place.
+  bool in_place = owner != nullptr && type.IsNumeric() && data.GetSize() > 0 &&
+                  reinterpret_cast<uintptr_t>(ptr) % type.SizeInBytes() == 0;
+  if (in_place) {
+    RETURN_IF_NOT_OK(Tensor::CreateFromExternalMemory(shape, type, const_cast<unsigned char *>(ptr), data.GetSize(),
+                                                      std::move(owner), &ts));
+  } else {
+    RETURN_IF_NOT_OK(Tensor::CreateFromMemory(shape, type, ptr, data.GetSize(), &ts));
+  }
   // Next we restore the real data which can be embedded or stored separately.
   if (ts->SizeInBytes() != data.GetSize()) {
     MS_LOG(ERROR) << "Unexpected length. Read " << data.GetSize() << ". Expected " << ts->SizeInBytes() << ".\n"
@@ -24,6 +24,7 @@
 #include <vector>
 #include "minddata/dataset/engine/cache/de_tensor_generated.h"
 #include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/memory_pool.h"
 #include "minddata/dataset/util/slice.h"
 #include "minddata/dataset/util/status.h"
 
@@ -39,8 +40,11 @@ Status SerializeTensorRowHeader(const TensorRow &row, std::shared_ptr<flatbuffer
 /// \param col_ts A serialized version of Tensor meta data
 /// \param data Tensor data wrapped in a slice
 /// \param out Tensor
+/// \param owner Optional. The memory pool which owns the data. If given, a numeric tensor whose data is suitably
+///     aligned is created on top of the data instead of a copy of it
 /// \return Status object
-Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out);
+Status RestoreOneTensor(const TensorMetaMsg *col_ts, const ReadableSlice &data, std::shared_ptr<Tensor> *out,
+                        std::shared_ptr<MemoryPool> owner = nullptr);
 }  // namespace dataset
 }  // namespace mindspore
 #endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CACHE_FBB_H_
@@ -33,7 +33,7 @@ namespace ds = mindspore::dataset;
 ms::Status StartServer(int argc, char **argv) {
   ms::Status rc;
   ds::CacheServer::Builder builder;
-  const int32_t kTotalArgs = 8;
+  const int32_t kTotalArgs = 9;
   enum {
     kProcessNameIdx = 0,
     kRootDirArgIdx = 1,
@@ -42,7 +42,8 @@ ms::Status StartServer(int argc, char **argv) {
     kSharedMemorySizeArgIdx = 4,
     kLogLevelArgIdx = 5,
     kDemonizeArgIdx = 6,
-    kMemoryCapRatioArgIdx = 7
+    kMemoryCapRatioArgIdx = 7,
+    kPersistentArgIdx = 8
   };
   if (argc != kTotalArgs) {
     return ms::Status(ms::StatusCode::kMDSyntaxError);
@@ -54,7 +55,8 @@ ms::Status StartServer(int argc, char **argv) {
     .SetPort(port)
     .SetSharedMemorySizeInGB(static_cast<int32_t>(strtol(argv[kSharedMemorySizeArgIdx], nullptr, ds::kDecimal)))
     .SetLogLevel(static_cast<int8_t>((strtol(argv[kLogLevelArgIdx], nullptr, ds::kDecimal))))
-    .SetMemoryCapRatio(strtof(argv[kMemoryCapRatioArgIdx], nullptr));
+    .SetMemoryCapRatio(strtof(argv[kMemoryCapRatioArgIdx], nullptr))
+    .SetPersistent(strcmp(argv[kPersistentArgIdx], "true") == 0);
 
   auto daemonize_string = argv[kDemonizeArgIdx];
   bool daemonize = strcmp(daemonize_string, "true") == 0 || strcmp(daemonize_string, "TRUE") == 0 ||
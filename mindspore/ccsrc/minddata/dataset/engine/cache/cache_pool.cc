@@ -14,6 +14,8 @@
  * limitations under the License.
  */
 #include <algorithm>
+#include <cstdio>
+#include <fstream>
 #include "utils/ms_utils.h"
 #include "minddata/dataset/engine/cache/cache_pool.h"
 #include "minddata/dataset/engine/cache/cache_server.h"
@@ -21,8 +23,39 @@
 
 namespace mindspore {
 namespace dataset {
-CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root)
-    : mp_(std::move(mp)), root_(root), subfolder_(Services::GetUniqueID()), sm_(nullptr), tree_(nullptr) {
+namespace {
+// The index of a persisted pool is a header, followed by the meta data, followed by one record for each buffer.
+// It is written to a temporary file and renamed, so a pool with an index file is a complete one.
+const char kIndexFileName[] = "index";
+constexpr uint64_t kIndexMagic = 0x4D44434143484531;  // "MDCACHE1"
+constexpr uint64_t kIndexVersion = 2;
+struct IndexHeader {
+  uint64_t magic;
+  uint64_t version;
+  uint64_t source_id;  // the source files the rows come from, a pool is stale once they change
+  int64_t num_containers;
+  int64_t num_rows;
+  int64_t meta_sz;
+};
+struct IndexRecord {
+  int64_t key;
+  int64_t container;
+  int64_t offset;
+  int64_t sz;
+};
+}  // namespace
+
+CachePool::CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root, const std::string &persist_name,
+                     uint32_t source_id)
+    : mp_(std::move(mp)),
+      root_(root),
+      subfolder_(persist_name.empty() ? Services::GetUniqueID() : persist_name),
+      persistent_(!root.empty() && !persist_name.empty()),
+      source_id_(source_id),
+      read_only_(false),
+      persisted_(false),
+      sm_(nullptr),
+      tree_(nullptr) {
   // Initialize soft memory cap to the current available memory on the machine.
   soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
   temp_mem_usage_ = 0;
@@ -36,7 +69,26 @@ Status CachePool::DoServiceStart() {
     Path spill = GetSpillPath();
     RETURN_IF_NOT_OK(spill.CreateDirectories());
     auto &cs = CacheServer::GetInstance();
-    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers());
+    if (persistent_) {
+      Path index = spill / kIndexFileName;
+      if (index.Exists()) {
+        sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers(), true);
+        Status rc = LoadIndex(index);
+        if (rc.IsOk()) {
+          read_only_ = true;
+          persisted_ = true;
+          MS_LOG(INFO) << "CachePool reopens persisted disk folder: " << spill.toString();
+          return Status::OK();
+        }
+        MS_LOG(WARNING) << "Unable to reopen persisted disk folder " << spill.toString()
+                        << ". It will be rebuilt. " << rc.ToString();
+        sm_.reset();
+        tree_ = std::make_shared<data_index>();
+      }
+      // Whatever is left in the folder is from a pool which was never persisted. Start over.
+      RETURN_IF_NOT_OK(RemoveSpillFiles(false));
+    }
+    sm_ = std::make_shared<StorageManager>(spill, cs.GetNumWorkers(), persistent_);
     RETURN_IF_NOT_OK(sm_->ServiceStart());
     MS_LOG(INFO) << "CachePool will use disk folder: " << spill.toString();
   }
@@ -60,15 +112,28 @@ Status CachePool::DoServiceStop() {
   // release each buffer in the DataLocator one by one.
 
   tree_.reset();
-  if (!root_.toString().empty()) {
-    Path spill = GetSpillPath();
-    auto it = Path::DirIterator::OpenDirectory(&spill);
-    while (it->hasNext()) {
-      rc = it->next().Remove();
-      if (rc.IsError() && rc2.IsOk()) {
-        rc2 = rc;
-      }
+  // A persisted folder is kept for the next pool to reopen.
+  if (!root_.toString().empty() && !persisted_) {
+    rc = RemoveSpillFiles(true);
+    if (rc.IsError() && rc2.IsOk()) {
+      rc2 = rc;
+    }
+  }
+  return rc2;
+}
+
+Status CachePool::RemoveSpillFiles(bool remove_folder) {
+  Status rc;
+  Status rc2;
+  Path spill = GetSpillPath();
+  auto it = Path::DirIterator::OpenDirectory(&spill);
+  while (it->hasNext()) {
+    rc = it->next().Remove();
+    if (rc.IsError() && rc2.IsOk()) {
+      rc2 = rc;
     }
+  }
+  if (remove_folder) {
     rc = spill.Remove();
     if (rc.IsError() && rc2.IsOk()) {
       rc2 = rc;
@@ -79,6 +144,34 @@ Status CachePool::DoServiceStop() {
 
 CachePool::~CachePool() noexcept { (void)ServiceStop(); }
 
+Status CachePool::AllocateMemory(DataLocator *bl) {
+  Status rc;
+  auto sz = bl->sz;
+  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
+  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
+  // than the lower bound. (The default is 20% of physical RAM)
+  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
+    return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
+  }
+  rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl->ptr));
+  // Adjust the soft limit and usage counting when every 100M memory are used.
+  if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
+    soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
+    temp_mem_usage_ = 0;
+  }
+  RETURN_IF_NOT_OK(rc);
+  temp_mem_usage_ += sz;
+  // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
+  if (CacheServerHW::numa_enabled()) {
+    auto &cs = CacheServer::GetInstance();
+    auto node_id = cs.GetHWControl()->GetMyNode();
+    bl->node_id = mp_->FindNode(bl->ptr);
+    CHECK_FAIL_RETURN_UNEXPECTED(bl->node_id != -1, "Allocator is not from numa memory pool");
+    bl->node_hit = (bl->node_id == node_id);
+  }
+  return Status::OK();
+}
+
 Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlice> &buf) {
   DataLocator bl;
   Status rc;
@@ -88,31 +181,15 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
     sz += v.GetSize();
   }
   bl.sz = sz;
-  // If required memory size exceeds the available size, it gives OOM status. To avoid cache server process got killed
-  // or crashing the machine, set lower bound memory, which means stopping cache once the rest available memory is less
-  // than the lower bound. (The default is 20% of physical RAM)
-  if (soft_mem_limit_ - temp_mem_usage_ - static_cast<uint64_t>(sz) < min_avail_mem_) {
-    MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
-                    << ". The cache server will not cache any more data.";
-    rc = Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__);
-  } else {
-    rc = mp_->Allocate(sz, reinterpret_cast<void **>(&bl.ptr));
-    // Adjust the soft limit and usage counting when every 100M memory are used.
-    if (temp_mem_usage_ + sz >= kMemoryCapAdjustInterval) {
-      soft_mem_limit_ = CacheServerHW::GetAvailableMemory();
-      temp_mem_usage_ = 0;
-    }
+  if (read_only_) {
+    RETURN_STATUS_UNEXPECTED("Can't insert into a cache pool reopened for read only");
+  }
+  // A persistent pool writes everything through to the disk. Memory only keeps a copy if there is room.
+  if (persistent_) {
+    RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
   }
+  rc = AllocateMemory(&bl);
   if (rc.IsOk()) {
-    temp_mem_usage_ += sz;
-    // Write down which numa node where we allocate from. It only make sense if the policy is kOnNode.
-    if (CacheServerHW::numa_enabled()) {
-      auto &cs = CacheServer::GetInstance();
-      auto node_id = cs.GetHWControl()->GetMyNode();
-      bl.node_id = mp_->FindNode(bl.ptr);
-      CHECK_FAIL_RETURN_UNEXPECTED(bl.node_id != -1, "Allocator is not from numa memory pool");
-      bl.node_hit = (bl.node_id == node_id);
-    }
     // We will do a piecewise copy.
     WritableSlice dest(bl.ptr, bl.sz);
     size_t pos = 0;
@@ -130,11 +207,15 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
       return rc;
     }
   } else if (rc == StatusCode::kMDOutOfMemory) {
-    // If no memory, write to disk.
-    if (sm_ != nullptr) {
+    if (persistent_) {
+      // Already on disk.
+    } else if (sm_ != nullptr) {
+      // If no memory, write to disk.
       MS_LOG(DEBUG) << "Spill to disk directly ... " << bl.sz << " bytes.";
       RETURN_IF_NOT_OK(sm_->Write(&bl.storage_key, buf));
     } else {
+      MS_LOG(WARNING) << "Memory usage will exceed the upper bound limit of: " << min_avail_mem_
+                      << ". The cache server will not cache any more data.";
       // If asked to spill to disk instead but there is no storage set up, simply return no memory
       // instead.
       return Status(StatusCode::kMDOutOfMemory, __LINE__, __FILE__, "No enough storage for cache server to cache data");
@@ -157,25 +238,30 @@ Status CachePool::Insert(CachePool::key_type key, const std::vector<ReadableSlic
   return rc;
 }
 
-Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) const {
+Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *bytesRead) {
   RETURN_UNEXPECTED_IF_NULL(dest);
   auto r = tree_->Search(key);
   if (r.second) {
     auto &it = r.first;
-    if (it->ptr != nullptr) {
-      ReadableSlice src(it->ptr, it->sz);
+    DataLocator bl = LoadLocator(*it);
+    if (bl.ptr != nullptr) {
+      ReadableSlice src(bl.ptr, bl.sz);
       RETURN_IF_NOT_OK(WritableSlice::Copy(dest, src));
     } else if (sm_ != nullptr) {
       size_t expectedLength = 0;
-      RETURN_IF_NOT_OK(sm_->Read(it->storage_key, dest, &expectedLength));
-      if (expectedLength != it->sz) {
-        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << it->sz << "."
+      RETURN_IF_NOT_OK(sm_->Read(bl.storage_key, dest, &expectedLength));
+      if (expectedLength != bl.sz) {
+        MS_LOG(ERROR) << "Unexpected length. Read " << expectedLength << ". Expected " << bl.sz << "."
                       << " Internal key: " << key << "\n";
         RETURN_STATUS_UNEXPECTED("Length mismatch. See log file for details.");
       }
+      // The buffer is warm. Keep it in memory for the next read.
+      if (persistent_) {
+        Promote(&it.value(), ReadableSlice(dest->GetPointer(), bl.sz));
+      }
     }
     if (bytesRead != nullptr) {
-      *bytesRead = it->sz;
+      *bytesRead = bl.sz;
     }
   } else {
     RETURN_STATUS_UNEXPECTED("Key not found");
@@ -183,6 +269,111 @@ Status CachePool::Read(CachePool::key_type key, WritableSlice *dest, size_t *byt
   return Status::OK();
 }
 
+void CachePool::Promote(DataLocator *bl, const ReadableSlice &src) {
+  DataLocator mem;
+  mem.sz = bl->sz;
+  if (AllocateMemory(&mem).IsError()) {
+    // Memory is full. The buffer stays on disk.
+    return;
+  }
+  WritableSlice dest(mem.ptr, mem.sz);
+  if (WritableSlice::Copy(&dest, src).IsError()) {
+    mp_->Deallocate(mem.ptr);
+    return;
+  }
+  {
+    // The copy is made outside the lock. Only publishing it is serialized with the readers.
+    std::unique_lock<std::mutex> lck(promote_mux_);
+    // Someone may have brought it in already.
+    if (bl->ptr == nullptr) {
+      bl->node_id = mem.node_id;
+      bl->node_hit = mem.node_hit;
+      bl->ptr = mem.ptr;
+      return;
+    }
+  }
+  mp_->Deallocate(mem.ptr);
+}
+
+CachePool::DataLocator CachePool::LoadLocator(const DataLocator &bl) const {
+  // Only a persistent pool changes a DataLocator after it is inserted
+  if (!persistent_) {
+    return bl;
+  }
+  std::unique_lock<std::mutex> lck(promote_mux_);
+  return bl;
+}
+
+Status CachePool::Persist(const std::string &meta) {
+  CHECK_FAIL_RETURN_UNEXPECTED(persistent_, "Not a persistent cache pool");
+  if (persisted_) {
+    return Status::OK();
+  }
+  // The data has to be on the disk before the index which points to it.
+  RETURN_IF_NOT_OK(sm_->Sync());
+  std::vector<IndexRecord> records;
+  tree_->LockShared();  // Prevent any node split while we scan.
+  Status rc;
+  for (auto it = tree_->begin(); it != tree_->end(); ++it) {
+    it.LockShared();
+    StorageManager::value_type v;
+    rc = sm_->Locate(it.value().storage_key, &v);
+    if (rc.IsOk()) {
+      records.push_back({it.key(), v.first, v.second.first, static_cast<int64_t>(v.second.second)});
+    }
+    it.Unlock();
+    if (rc.IsError()) {
+      break;
+    }
+  }
+  tree_->Unlock();
+  RETURN_IF_NOT_OK(rc);
+  IndexHeader hdr{kIndexMagic, kIndexVersion, source_id_, sm_->NumContainers(), static_cast<int64_t>(records.size()),
+                  static_cast<int64_t>(meta.size())};
+  Path index = GetSpillPath() / kIndexFileName;
+  std::string tmp = index.toString() + ".tmp";
+  std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+  CHECK_FAIL_RETURN_UNEXPECTED(out.is_open(), "Unable to create index file " + tmp);
+  out.write(reinterpret_cast<const char *>(&hdr), sizeof(hdr));
+  out.write(meta.data(), meta.size());
+  out.write(reinterpret_cast<const char *>(records.data()), records.size() * sizeof(IndexRecord));
+  out.close();
+  CHECK_FAIL_RETURN_UNEXPECTED(!out.fail(), "Failed to write index file " + tmp);
+  if (std::rename(tmp.data(), index.toString().data()) != 0) {
+    RETURN_STATUS_UNEXPECTED("Failed to rename " + tmp + ". Errno = " + std::to_string(errno));
+  }
+  persisted_ = true;
+  MS_LOG(INFO) << "Cache pool persisted " << records.size() << " rows in " << GetSpillPath().toString();
+  return Status::OK();
+}
+
+Status CachePool::LoadIndex(const Path &index) {
+  std::ifstream in(index.toString(), std::ios::binary);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.is_open(), "Unable to open index file " + index.toString());
+  IndexHeader hdr{};
+  in.read(reinterpret_cast<char *>(&hdr), sizeof(hdr));
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good() && hdr.magic == kIndexMagic && hdr.version == kIndexVersion,
+                               "Invalid index file " + index.toString());
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr.source_id == source_id_,
+                               "The source files have changed since " + index.toString() + " was written");
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr.num_rows >= 0 && hdr.meta_sz >= 0, "Corrupted index file " + index.toString());
+  meta_.resize(hdr.meta_sz);
+  in.read(&meta_[0], hdr.meta_sz);
+  CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Corrupted index file " + index.toString());
+  RETURN_IF_NOT_OK(sm_->Reopen(static_cast<int32_t>(hdr.num_containers)));
+  for (int64_t i = 0; i < hdr.num_rows; ++i) {
+    IndexRecord rec{};
+    in.read(reinterpret_cast<char *>(&rec), sizeof(rec));
+    CHECK_FAIL_RETURN_UNEXPECTED(in.good(), "Corrupted index file " + index.toString());
+    DataLocator bl;
+    bl.sz = static_cast<size_t>(rec.sz);
+    auto v = std::make_pair(static_cast<int>(rec.container), std::make_pair(static_cast<off_t>(rec.offset), bl.sz));
+    RETURN_IF_NOT_OK(sm_->Restore(v, &bl.storage_key));
+    RETURN_IF_NOT_OK(tree_->DoInsert(rec.key, bl));
+  }
+  return Status::OK();
+}
+
 Path CachePool::GetSpillPath() const {
   auto spill = Path(root_) / subfolder_;
   return spill;
@@ -197,13 +388,14 @@ CachePool::CacheStat CachePool::GetStat(bool GetMissingKeys) const {
     cs.max_key = cs.min_key;  // will adjust later.
     for (auto it = tree_->begin(); it != tree_->end(); ++it) {
       it.LockShared();
-      total_sz += it.value().sz;
-      if (it.value().ptr != nullptr) {
+      DataLocator bl = LoadLocator(it.value());
+      total_sz += bl.sz;
+      if (bl.ptr != nullptr) {
         ++cs.num_mem_cached;
       } else {
         ++cs.num_disk_cached;
       }
-      if (it.value().node_hit) {
+      if (bl.node_hit) {
         ++cs.num_numa_hit;
       }
       auto cur_key = it.key();
@@ -232,12 +424,12 @@ Status CachePool::GetDataLocator(key_type key, const std::shared_ptr<flatbuffers
   RETURN_UNEXPECTED_IF_NULL(out);
   auto r = tree_->Search(key);
   if (r.second) {
-    auto &it = r.first;
+    DataLocator bl = LoadLocator(*r.first);
     DataLocatorMsgBuilder bld(*fbb);
     bld.add_key(key);
-    bld.add_size(it->sz);
-    bld.add_node_id(it->node_id);
-    bld.add_addr(reinterpret_cast<int64_t>(it->ptr));
+    bld.add_size(bl.sz);
+    bld.add_node_id(bl.node_id);
+    bld.add_addr(reinterpret_cast<int64_t>(bl.ptr));
     auto offset = bld.Finish();
     *out = offset;
   } else {
@@ -35,6 +35,9 @@ namespace dataset {
 /// \brief A CachePool provides service for backup/restore a buffer. A buffer can be represented in a form of vector of
 /// ReadableSlice where all memory blocks will be copied to one contiguous block which can be in memory or spilled to
 /// disk (if a disk directory is provided). User must provide a key to insert the buffer.
+/// A persistent CachePool writes every buffer through to the disk and memory only holds a copy of the hot ones.
+/// Once persisted, the disk folder outlives the pool and a CachePool created later on the same folder reopens it
+/// for read. Buffers read back from the disk are brought into memory while there is room.
 /// \see ReadableSlice
 class CachePool : public Service {
  public:
@@ -101,7 +104,10 @@ class CachePool : public Service {
   /// \brief Constructor
   /// \param alloc Allocator to allocate memory from
   /// \param root Optional disk folder to spill
-  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "");
+  /// \param persist_name Optional. If given with a disk folder, the pool is persistent and lives in this sub-folder
+  /// \param source_id Identity of the source files of the rows. A persisted pool is only reopened for the same one
+  explicit CachePool(std::shared_ptr<NumaMemoryPool> mp, const std::string &root = "",
+                     const std::string &persist_name = "", uint32_t source_id = 0);
 
   CachePool(const CachePool &) = delete;
   CachePool(CachePool &&) = delete;
@@ -127,7 +133,7 @@ class CachePool : public Service {
   /// \param[out] dest The cached buffer will be copied to this destination represented by a WritableSlice
   /// \param[out] bytesRead Optional. Number of bytes read.
   /// \return Error code
-  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr) const;
+  Status Read(key_type key, WritableSlice *dest, size_t *bytesRead = nullptr);
 
   /// \brief Serialize a DataLocator
   Status GetDataLocator(key_type, const std::shared_ptr<flatbuffers::FlatBufferBuilder> &,
@@ -139,6 +145,20 @@ class CachePool : public Service {
 
   std::string MyName() const { return subfolder_; }
 
+  /// \brief Write down the index of a persistent pool. The disk folder is kept from now on and can be reopened.
+  /// \param meta Opaque data saved along with the index
+  /// \return Status object
+  Status Persist(const std::string &meta);
+
+  /// \brief Check if the pool is persistent
+  bool IsPersistent() const { return persistent_; }
+
+  /// \brief Check if the pool is reopened from a persisted one. No buffer can be inserted into it.
+  bool IsReadOnly() const { return read_only_; }
+
+  /// \brief The meta data saved by Persist. Only available once the pool is reopened.
+  const std::string &GetPersistedMeta() const { return meta_; }
+
   /// \brief Toggle locking
   /// \note Once locking is off. It is user's responsibility to ensure concurrency
   void SetLocking(bool on_off) { tree_->SetLocking(on_off); }
@@ -147,6 +167,12 @@ class CachePool : public Service {
   std::shared_ptr<NumaMemoryPool> mp_;
   Path root_;
   const std::string subfolder_;
+  const bool persistent_;
+  const uint32_t source_id_;
+  bool read_only_;
+  bool persisted_;
+  std::string meta_;
+  mutable std::mutex promote_mux_;  // guards the memory copy a reader brings in, see Promote
   std::shared_ptr<StorageManager> sm_;
   std::shared_ptr<data_index> tree_;
   std::atomic<uint64_t> soft_mem_limit_;  // the available memory in the machine
@@ -154,6 +180,21 @@ class CachePool : public Service {
                                           // we will adjust soft_mem_limit_ every 100Mb based on this parameter)
   uint64_t min_avail_mem_;                // lower bound of the available memory
   const int kMemoryCapAdjustInterval = 104857600;
+
+  /// \brief Allocate memory for a buffer within the memory cap
+  Status AllocateMemory(DataLocator *bl);
+
+  /// \brief Bring a buffer only on disk into memory if there is room. Best effort.
+  void Promote(DataLocator *bl, const ReadableSlice &src);
+
+  /// \brief Take a copy of a DataLocator which a concurrent Promote may be filling in
+  DataLocator LoadLocator(const DataLocator &bl) const;
+
+  /// \brief Reopen the index of a persisted pool
+  Status LoadIndex(const Path &index);
+
+  /// \brief Remove all the files in the spill folder, and also the folder itself if asked to
+  Status RemoveSpillFiles(bool remove_folder);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -152,27 +152,30 @@ BatchFetchRequest::BatchFetchRequest(const CacheClient *cc, const std::vector<ro
   rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
 }
 
-Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr) {
-  RETURN_UNEXPECTED_IF_NULL(out);
-  auto num_elements = row_id_.size();
-  const char *ptr = nullptr;
-  int64_t sz = 0;
+int64_t BatchFetchRequest::SharedMemoryAddr() const {
   // Tap into the reply flag to see where we can find the data. Server may decide the amount is
   // so small that it doesn't use shared memory method.
   auto flag = reply_.flag();
   bool dataOnSharedMemory = support_local_bypass_ ? (BitTest(flag, kDataIsInSharedMemory)) : false;
-  if (dataOnSharedMemory) {
-    auto addr = strtoll(reply_.result().data(), nullptr, kDecimal);
+  return dataOnSharedMemory ? strtoll(reply_.result().data(), nullptr, kDecimal) : -1;
+}
+
+Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, std::shared_ptr<MemoryPool> pin) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto num_elements = row_id_.size();
+  const char *ptr = nullptr;
+  int64_t sz = 0;
+  auto addr = SharedMemoryAddr();
+  if (addr != -1) {
     ptr = reinterpret_cast<const char *>(reinterpret_cast<int64_t>(baseAddr) + addr);
-    RETURN_UNEXPECTED_IF_NULL(out);
-    *out_addr = addr;
   } else {
     ptr = reply_.result().data();
-    *out_addr = -1;
+    // The reply goes away with this request. The tensors can't be built on top of it.
+    pin = nullptr;
   }
   auto *offset_array = reinterpret_cast<const int64_t *>(ptr);
   sz = offset_array[num_elements];
-  CHECK_FAIL_RETURN_UNEXPECTED(support_local_bypass_ || sz == reply_.result().length(), "Length mismatch");
+  CHECK_FAIL_RETURN_UNEXPECTED(addr != -1 || sz == reply_.result().length(), "Length mismatch");
   TensorTable tbl;
   tbl.reserve(num_elements);
   ReadableSlice all(ptr, sz);
@@ -192,7 +195,7 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
         auto col_ts = msg->column()->Get(k);
         std::shared_ptr<Tensor> ts;
         ReadableSlice data(row_data, ts_offset, msg->data_sz()->Get(k));
-        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts));
+        RETURN_IF_NOT_OK(mindspore::dataset::RestoreOneTensor(col_ts, data, &ts, pin));
         row.push_back(ts);
         ts_offset += data.GetSize();
       }
@@ -206,8 +209,12 @@ Status BatchFetchRequest::RestoreRows(TensorTable *out, const void *baseAddr, in
 }
 
 CreateCacheRequest::CreateCacheRequest(CacheClient *cc, const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
-                                       CreateCacheRequest::CreateCacheFlag flag)
-    : BaseRequest(RequestType::kCreateCache), cache_mem_sz_(cache_mem_sz), flag_(flag), cc_(cc) {
+                                       CreateCacheRequest::CreateCacheFlag flag, uint32_t source_id)
+    : BaseRequest(RequestType::kCreateCache),
+      cache_mem_sz_(cache_mem_sz),
+      flag_(flag),
+      source_id_(source_id),
+      cc_(cc) {
   // Type has been set already in the base constructor. So we need to fill in the connection info.
   // On successful return, we will get the connection id
   rq_.mutable_connection_info()->operator=(cinfo);
@@ -219,6 +226,7 @@ Status CreateCacheRequest::Prepare() {
     CreateCacheRequestMsgBuilder bld(fbb);
     bld.add_cache_mem_sz(cache_mem_sz_);
     bld.add_flag(static_cast<uint32_t>(flag_));
+    bld.add_source_id(source_id_);
     auto off = bld.Finish();
     fbb.Finish(off);
     rq_.add_buf_data(fbb.GetBufferPointer(), fbb.GetSize());
@@ -233,7 +233,18 @@ class BatchFetchRequest : public BaseRequest {
   friend class CacheService;
   BatchFetchRequest(const CacheClient *cc, const std::vector<row_id_type> &row_id);
   ~BatchFetchRequest() override = default;
-  Status RestoreRows(TensorTable *out, const void *baseAddr, int64_t *out_addr);
+
+  /// \brief Where the server put the rows it sends back
+  /// \return The offset of the block of shared memory holding the rows, or -1 if they are in the reply
+  int64_t SharedMemoryAddr() const;
+
+  /// \brief Deserialize the rows sent back by the server
+  /// \param out The rows
+  /// \param baseAddr The base address of the shared memory
+  /// \param pin Optional. It holds the block of shared memory the rows are in. If given, the tensors are created on
+  ///     top of the block instead of copies of it, and they keep the pin alive until they are all gone
+  /// \return Status object
+  Status RestoreRows(TensorTable *out, const void *baseAddr, std::shared_ptr<MemoryPool> pin = nullptr);
 
  private:
   bool support_local_bypass_;
@@ -250,8 +261,9 @@ class CreateCacheRequest : public BaseRequest {
   /// \param connection_id
   /// \param cache_mem_sz Maximum memory assigned for this connection. 0 means unlimited
   /// \param flag Attributes of the cache.
+  /// \param source_id Identity of the source files of the pipeline, checked before a persisted cache is reopened
   explicit CreateCacheRequest(CacheClient *cc, const CacheClientInfo &cinfo, uint64_t cache_mem_sz,
-                              CreateCacheFlag flag = CreateCacheFlag::kNone);
+                              CreateCacheFlag flag = CreateCacheFlag::kNone, uint32_t source_id = 0);
   ~CreateCacheRequest() override = default;
 
   /// Overload the base class Prepare/PostReply
@@ -261,6 +273,7 @@ class CreateCacheRequest : public BaseRequest {
  private:
   uint64_t cache_mem_sz_;
   CreateCacheFlag flag_;
+  uint32_t source_id_;
   CacheClient *cc_;
 };
 
@@ -204,6 +204,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   auto p = flatbuffers::GetRoot<CreateCacheRequestMsg>(create_cache_buf.data());
   auto flag = static_cast<CreateCacheRequest::CreateCacheFlag>(p->flag());
   auto cache_mem_sz = p->cache_mem_sz();
+  auto source_id = p->source_id();
   // We can't do spilling unless this server is setup with a spill path in the first place
   bool spill =
     (flag & CreateCacheRequest::CreateCacheFlag::kSpillToDisk) == CreateCacheRequest::CreateCacheFlag::kSpillToDisk;
@@ -217,6 +218,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   // The first create will be successful and be given a special cookie.
   UniqueLock lck(&rwLock_);
   bool duplicate = false;
+  bool reopened = false;
   CacheService *curr_cs = GetService(connection_id);
   if (curr_cs != nullptr) {
     duplicate = true;
@@ -232,10 +234,18 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   if (!duplicate) {
     RETURN_IF_NOT_OK(GlobalMemoryCheck(cache_mem_sz));
     std::unique_ptr<CacheService> cs;
+    std::string persist_name = (spill && persistent_) ? GetPersistName(crc) : "";
     try {
-      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id);
+      cs = std::make_unique<CacheService>(cache_mem_sz, spill ? top_ : "", generate_id, persist_name, source_id);
       RETURN_IF_NOT_OK(cs->ServiceStart());
-      cookie = cs->cookie();
+      // A cache reopened from the disk is already built. The client is told the same as a duplicate request
+      // so it bypasses the build phase.
+      reopened = cs->IsReopened();
+      if (reopened) {
+        MS_LOG(INFO) << "Cache " << std::to_string(connection_id) << " is reopened from " << persist_name;
+      } else {
+        cookie = cs->cookie();
+      }
       client_id = cs->num_clients_.fetch_add(1);
       all_caches_.emplace(connection_id, std::move(cs));
     } catch (const std::bad_alloc &e) {
@@ -266,7 +276,7 @@ Status CacheServer::CreateService(CacheRequest *rq, CacheReply *reply) {
   reply->set_result(fbb.GetBufferPointer(), fbb.GetSize());
   // We can return OK but we will return a duplicate key so user can act accordingly to either ignore it
   // treat it as OK.
-  return duplicate ? Status(StatusCode::kMDDuplicateKey) : Status::OK();
+  return (duplicate || reopened) ? Status(StatusCode::kMDDuplicateKey) : Status::OK();
 }
 
 Status CacheServer::DestroyCache(CacheRequest *rq) {
@@ -523,12 +533,23 @@ Status CacheServer::BatchFetchRows(CacheRequest *rq, CacheReply *reply) {
     // For large amount data to be sent back, we will use shared memory provided it is a local
     // client that has local bypass support
     bool local_bypass = local_client ? (mem_sz >= kLocalByPassThreshold) : false;
+    void *q = nullptr;
+    if (local_bypass) {
+      // The client holds on to the blocks until it is done with the tensors built on them. If it holds
+      // on to too many, we send the rows in the reply instead.
+      Status rc = AllocateSharedMemory(client_id, mem_sz, &q);
+      if (rc == StatusCode::kMDOutOfMemory) {
+        MS_LOG(INFO) << "Shared memory is exhausted. Sending " << mem_sz << " bytes to client " << client_id
+                     << " in the reply.";
+        local_bypass = false;
+      } else {
+        RETURN_IF_NOT_OK(rc);
+      }
+    }
     reply->set_flag(local_bypass ? kDataIsInSharedMemory : 0);
     if (local_bypass) {
       // We will use shared memory
       auto *base = SharedMemoryBaseAddr();
-      void *q = nullptr;
-      RETURN_IF_NOT_OK(AllocateSharedMemory(client_id, mem_sz, &q));
       WritableSlice dest(q, mem_sz);
       Status rc = BatchFetch(fbb, &dest);
       if (rc.IsError()) {
@@ -988,12 +1009,25 @@ connection_id_type CacheServer::GetConnectionID(session_id_type session_id, uint
   return connection_id;
 }
 
+std::string CacheServer::GetPersistName(uint32_t crc) const {
+  std::string persist_name = "persist_" + std::to_string(crc);
+  // Many caches can read a persisted folder, but only one can write to it.
+  for (auto const &it : all_caches_) {
+    auto &cp = it.second->cp_;
+    if (cp != nullptr && cp->IsPersistent() && !cp->IsReadOnly() && cp->MyName() == persist_name) {
+      MS_LOG(INFO) << "Disk folder " << persist_name << " is in use. The new cache will not be persisted.";
+      return "";
+    }
+  }
+  return persist_name;
+}
+
 session_id_type CacheServer::GetSessionID(connection_id_type connection_id) const {
   return static_cast<session_id_type>(connection_id >> 32u);
 }
 
 CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port,
-                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level,
+                         int32_t shared_meory_sz_in_gb, float memory_cap_ratio, int8_t log_level, bool persistent,
                          std::shared_ptr<CacheServerHW> hw_info)
     : top_(spill_path),
       num_workers_(num_workers),
@@ -1002,6 +1036,7 @@ CacheServer::CacheServer(const std::string &spill_path, int32_t num_workers, int
       shared_memory_sz_in_gb_(shared_meory_sz_in_gb),
       global_shutdown_(false),
       memory_cap_ratio_(memory_cap_ratio),
+      persistent_(persistent),
       numa_affinity_(true),
       log_level_(log_level),
       hw_info_(std::move(hw_info)) {
@@ -1279,6 +1314,9 @@ Status CacheServer::Builder::SanityCheck() {
   if (memory_cap_ratio_ <= 0 || memory_cap_ratio_ > 1) {
     RETURN_STATUS_UNEXPECTED("Memory cap ratio should be positive and no greater than 1");
   }
+  if (persistent_ && top_.empty()) {
+    RETURN_STATUS_UNEXPECTED("Persistent cache requires a spilling directory");
+  }
 
   // Check if the shared memory.
   RETURN_IF_NOT_OK(IpcResourceCleanup());
@@ -1305,7 +1343,8 @@ CacheServer::Builder::Builder()
       port_(kCfgDefaultCachePort),
       shared_memory_sz_in_gb_(kDefaultSharedMemorySize),
       memory_cap_ratio_(kDefaultMemoryCapRatio),
-      log_level_(kDefaultLogLevel) {
+      log_level_(kDefaultLogLevel),
+      persistent_(false) {
   if (num_workers_ == 0) {
     num_workers_ = 1;
   }
@@ -73,6 +73,7 @@ class CacheServer : public Service {
     int32_t GetSharedMemorySzInGb() const { return shared_memory_sz_in_gb_; }
     float GetMemoryCapRatio() const { return memory_cap_ratio_; }
     int8_t GetLogLevel() const { return log_level_; }
+    bool IsPersistent() const { return persistent_; }
 
     Builder &SetRootDirectory(std::string root) {
       top_ = std::move(root);
@@ -98,6 +99,10 @@ class CacheServer : public Service {
       log_level_ = log_level;
       return *this;
     }
+    Builder &SetPersistent(bool persistent) {
+      persistent_ = persistent;
+      return *this;
+    }
 
     Status SanityCheck();
 
@@ -108,7 +113,8 @@ class CacheServer : public Service {
           << "Tcp/ip port: " << GetPort() << "\n"
           << "Shared memory size (in GB): " << GetSharedMemorySzInGb() << "\n"
           << "Memory cap ratio: " << GetMemoryCapRatio() << "\n"
-          << "Log level: " << std::to_string(GetLogLevel());
+          << "Log level: " << std::to_string(GetLogLevel()) << "\n"
+          << "Persistent cache: " << (IsPersistent() ? "true" : "false");
     }
 
     friend std::ostream &operator<<(std::ostream &out, const Builder &bld) {
@@ -143,7 +149,7 @@ class CacheServer : public Service {
       // We need to bring up the Task Manager by bringing up the Services singleton.
       RETURN_IF_NOT_OK(Services::CreateInstance());
       RETURN_IF_NOT_OK(CacheServer::CreateInstance(top_, num_workers_, port_, shared_memory_sz_in_gb_,
-                                                   memory_cap_ratio_, log_level_, std::move(hw_info_)));
+                                                   memory_cap_ratio_, log_level_, persistent_, std::move(hw_info_)));
       return Status(StatusCode::kSuccess, warning_string);
     }
 
@@ -154,6 +160,7 @@ class CacheServer : public Service {
     int32_t shared_memory_sz_in_gb_;
     float memory_cap_ratio_;
     int8_t log_level_;
+    bool persistent_;
     std::shared_ptr<CacheServerHW> hw_info_;
 
     /// \brief Sanity checks on the shared memory.
@@ -173,12 +180,12 @@ class CacheServer : public Service {
   ~CacheServer() override { (void)ServiceStop(); }
 
   static Status CreateInstance(const std::string &spill_path, int32_t num_workers, int32_t port,
-                               int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level,
+                               int32_t shared_memory_sz, float memory_cap_ratio, int8_t log_level, bool persistent,
                                std::shared_ptr<CacheServerHW> hw_info) {
     std::call_once(init_instance_flag_, [&]() -> Status {
       auto &SvcManager = Services::GetInstance();
       RETURN_IF_NOT_OK(SvcManager.AddHook(&instance_, spill_path, num_workers, port, shared_memory_sz, memory_cap_ratio,
-                                          log_level, hw_info));
+                                          log_level, persistent, hw_info));
       return Status::OK();
     });
     return Status::OK();
@@ -237,6 +244,9 @@ class CacheServer : public Service {
   /// \brief Return the memory cap ratio
   float GetMemoryCapRatio() const { return memory_cap_ratio_; }
 
+  /// \brief Check if the caches which spill are kept on disk across server restarts
+  bool IsPersistent() const { return persistent_; }
+
   /// \brief Function to handle a row request
   /// \param[in] cache_req A row request to handle
   /// \param[out] internal_request Indicator if the request is an internal request
@@ -293,6 +303,7 @@ class CacheServer : public Service {
   int8_t log_level_;  // log_level is saved here for informational purpose only. It's not a functional field.
   std::atomic<bool> global_shutdown_;
   float memory_cap_ratio_;
+  bool persistent_;
   std::shared_ptr<CacheServerHW> hw_info_;
   std::map<worker_id_t, Task *> numa_tasks_;
   bool numa_affinity_;
@@ -302,8 +313,10 @@ class CacheServer : public Service {
   /// \brief Constructor
   /// \param spill_path Top directory for spilling buffers to.
   /// \param num_workers Number of threads for handling requests.
+  /// \param persistent If true, the caches which spill are kept under the spill path across server restarts.
   explicit CacheServer(const std::string &spill_path, int32_t num_workers, int32_t port, int32_t share_memory_sz_in_gb,
-                       float memory_cap_ratio, int8_t log_level, std::shared_ptr<CacheServerHW> hw_info);
+                       float memory_cap_ratio, int8_t log_level, bool persistent,
+                       std::shared_ptr<CacheServerHW> hw_info);
 
   /// \brief Locate a cache service from connection id.
   /// \return Pointer to cache service. Null if not found
@@ -341,6 +354,12 @@ class CacheServer : public Service {
   /// \return connection id
   connection_id_type GetConnectionID(session_id_type session_id, uint32_t crc) const;
 
+  /// \brief Name the disk folder of a persistent cache after the crc of its pipeline, which stays the same
+  /// across sessions and server restarts.
+  /// \param crc
+  /// \return The folder name, or empty if another live cache is still writing to this folder
+  std::string GetPersistName(uint32_t crc) const;
+
   /// \brief Extract the session id from a connection id
   /// \param connection_id
   /// \return session id
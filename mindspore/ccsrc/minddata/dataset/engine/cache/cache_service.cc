@@ -22,8 +22,11 @@
 
 namespace mindspore {
 namespace dataset {
-CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id)
+CacheService::CacheService(uint64_t mem_sz, const std::string &root, bool generate_id,
+                           const std::string &persist_name, uint32_t source_id)
     : root_(root),
+      persist_name_(persist_name),
+      source_id_(source_id),
       cache_mem_sz_(mem_sz * 1048576L),  // mem_sz is in MB unit
       cp_(nullptr),
       next_id_(0),
@@ -53,15 +56,30 @@ Status CacheService::DoServiceStart() {
     RETURN_STATUS_UNEXPECTED("Unable to bring up numa memory pool");
   }
   // Put together a CachePool for backing up the Tensor.
-  cp_ = std::make_shared<CachePool>(numa_pool_, root_);
+  cp_ = std::make_shared<CachePool>(numa_pool_, root_, persist_name_, source_id_);
   RETURN_IF_NOT_OK(cp_->ServiceStart());
-  // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name.
-  cookie_ = cp_->MyName();
+  // Assign a name to this cache. Used for exclusive connection. But we can just use CachePool's name unless it is
+  // persistent, which is named after the pipeline and is not a secret.
+  cookie_ = cp_->IsPersistent() ? Services::GetUniqueID() : cp_->MyName();
+  if (cp_->IsReadOnly()) {
+    // A reopened cache is complete. It goes straight into the fetch phase and takes no more rows.
+    schema_ = cp_->GetPersistedMeta();
+    st_ = generate_id_ ? CacheServiceState::kFetchPhase : CacheServiceState::kNoLocking;
+    cp_->SetLocking(false);
+  }
   return Status::OK();
 }
 
 Status CacheService::DoServiceStop() {
   if (cp_ != nullptr) {
+    // A cache without a build phase is never told it is complete. Whatever it has is kept for the next time,
+    // and the rows it misses are simply not cached.
+    if (cp_->IsPersistent() && !cp_->IsReadOnly() && !HasBuildPhase() && !schema_.empty()) {
+      Status rc = cp_->Persist(schema_);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Unable to persist the cache. " << rc.ToString();
+      }
+    }
     RETURN_IF_NOT_OK(cp_->ServiceStop());
   }
   return Status::OK();
@@ -318,9 +336,18 @@ Status CacheService::BuildPhaseDone() {
   if (HasBuildPhase()) {
     // Exclusive lock to switch phase
     UniqueLock rw(&rw_lock_);
+    // A build phase cut short by a full disk has missing rows. One without any row has nothing to keep.
+    bool complete = (st_ == CacheServiceState::kBuildPhase) && !schema_.empty();
     st_ = CacheServiceState::kFetchPhase;
     cp_->SetLocking(false);
     MS_LOG(WARNING) << "Locking mode is switched off.";
+    if (cp_->IsPersistent() && complete) {
+      // All rows are in. The cache can now be reopened by later jobs. Failing to do so does not stop this one.
+      Status rc = cp_->Persist(schema_);
+      if (rc.IsError()) {
+        MS_LOG(WARNING) << "Unable to persist the cache. " << rc.ToString();
+      }
+    }
     return Status::OK();
   } else {
     RETURN_STATUS_UNEXPECTED("Not a cache that has a build phase");
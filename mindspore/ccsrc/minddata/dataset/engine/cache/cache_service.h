@@ -49,7 +49,11 @@ class CacheService : public Service {
   /// \param root Spill path. Empty string means no spilling
   /// \param generate_id If the cache service should generate row id for buffer that is cached.
   /// For non-mappable dataset, this should be set to true.
-  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id);
+  /// \param persist_name Optional. If given with a spill path, the cache is kept on disk under this name once it is
+  /// complete, and a cache service created later with the same name reopens it for read.
+  /// \param source_id Identity of the source files. A persisted cache is only reopened for the same one.
+  CacheService(uint64_t mem_sz, const std::string &root, bool generate_id, const std::string &persist_name = "",
+               uint32_t source_id = 0);
   ~CacheService() override;
 
   Status DoServiceStart() override;
@@ -123,10 +127,14 @@ class CacheService : public Service {
   Status BuildPhaseDone();
   /// \brief For kToggleWriteMode request
   Status ToggleWriteMode(bool on_off);
+  /// \brief Check if the cache is reopened from the disk. It is complete and read only.
+  bool IsReopened() const { return cp_->IsReadOnly(); }
 
  private:
   mutable RWLock rw_lock_;
   std::string root_;
+  std::string persist_name_;
+  uint32_t source_id_;
   uint64_t cache_mem_sz_;
   std::shared_ptr<CachePool> cp_;
   std::atomic<row_id_type> next_id_;
@@ -58,6 +58,8 @@ void CachePerfRun::PrintHelp() {
             << " (Mb)\n"
                "       --spill:          Set spill to disk to True. Default = "
             << std::boolalpha << kDftSpill << "\n"
+            << "       --remote:         Fetch rows through tcp/ip even if the cache server is local. Default = "
+            << std::boolalpha << kDftRemote << "\n"
             << "    -w,--workers:        Set the number of parallel workers. Default = " << cfg_.num_parallel_workers()
             << "\n"
                "       --connection:     Set number of TCP/IP connections per pipeline. Default = "
@@ -198,6 +200,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
 
   int shuffle = 0;
   int spill = 0;
+  int remote = 0;
 
   const char *const short_opts = ":n:e:p:a:s:r:w:";
   const option long_opts[] = {{"pipeline", required_argument, nullptr, 'n'},
@@ -211,6 +214,7 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
                               {"port", required_argument, nullptr, port_opt},
                               {"hostname", required_argument, nullptr, hostname_opt},
                               {"spill", no_argument, &spill, 1},
+                              {"remote", no_argument, &remote, 1},
                               {"connection", required_argument, nullptr, connect_opt},
                               {"help", no_argument, nullptr, 'h'},
                               {nullptr, no_argument, nullptr, 0}};
@@ -249,6 +253,8 @@ int32_t CachePerfRun::ProcessArgs(int argc, char **argv) {
           shuffle_ = true;
         } else if (long_opts[option_indxex].flag == &spill) {
           cache_builder_.SetSpill(true);
+        } else if (long_opts[option_indxex].flag == &remote) {
+          cache_builder_.SetLocalBypass(false);
         }
         continue;
       }
@@ -290,7 +296,7 @@ CachePerfRun::CachePerfRun()
       session_(0),
       crc_(0),
       epoch_sync_cnt_(0) {
-  cache_builder_.SetSpill(kDftSpill).SetCacheMemSz(kDftCacheSize);
+  cache_builder_.SetSpill(kDftSpill).SetCacheMemSz(kDftCacheSize).SetLocalBypass(!kDftRemote);
 }
 
 CachePerfRun::~CachePerfRun() {
@@ -450,7 +456,8 @@ Status CachePerfRun::StartPipelines() {
                                std::to_string(cache_builder_.GetPrefetchSize()) + "," +
                                std::to_string(cache_builder_.GetCacheMemSz()) + "," +
                                std::to_string(cache_builder_.GetNumConnections()) + "," +
-                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data());
+                               (cache_builder_.isSpill() ? std::string("true").data() : std::string("false").data()) +
+                               "," + (cache_builder_.isLocalBypass() ? "true" : "false");
       char *argv[4];
       argv[0] = const_cast<char *>(kCachePipelineBinary);
       argv[1] = pipeline_cfg.data();
@@ -569,7 +576,9 @@ Status CachePerfRun::Run() {
   // Simplest way is call this special internal function.
   cc_->ServerRunningOutOfResources();
 
-  // The rest of the epochs are just fetching.
+  // The rest of the epochs are just fetching. Every epoch reads all the rows once across all the pipelines.
+  std::string fetch_mode = cc_->SupportLocalClient() ? "local" : "remote";
+  std::cout << "Fetch mode: " << fetch_mode << std::endl;
   auto epoch_num = 2;
   while (epoch_num <= num_epoches_) {
     epoch_sync_cnt_ = 0;
@@ -587,6 +596,11 @@ Status CachePerfRun::Run() {
     end_tick = std::chrono::steady_clock::now();
     elapse_time = std::chrono::duration_cast<std::chrono::seconds>(end_tick - start_tick).count();
     std::cout << "Epoch " << epoch_num << " elapsed time " << elapse_time << " seconds" << std::endl;
+    auto elapse_ms = std::chrono::duration_cast<std::chrono::milliseconds>(end_tick - start_tick).count();
+    if (elapse_ms > 0) {
+      std::cout << "Epoch " << epoch_num << " " << fetch_mode << " fetch rate " << (num_rows_ * 1000 / elapse_ms)
+                << " rows/sec" << std::endl;
+    }
     std::cout << "Epoch " << epoch_num
               << " (read phase) per pipeline per worker summary. Buffer size = " << cc_->GetPrefetchSize() << std::endl;
     PrintEpochSummary();
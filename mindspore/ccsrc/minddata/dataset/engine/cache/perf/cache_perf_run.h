@@ -45,6 +45,7 @@ constexpr int32_t kDftNumberOfEpochs = 10;
 constexpr int32_t kDftCacheSize = 0;
 constexpr bool kDftShuffle = false;
 constexpr bool kDftSpill = false;
+constexpr bool kDftRemote = false;
 
 class CachePerfRun {
  public:
@@ -59,7 +60,8 @@ class CachePerfRun {
         << "Number of epochs: " << num_epoches_ << "\n"
         << "Sample size: " << num_rows_ << "\n"
         << "Average row size: " << row_size_ << "\n"
-        << "Shuffle: " << std::boolalpha << shuffle_;
+        << "Shuffle: " << std::boolalpha << shuffle_ << "\n"
+        << "Remote fetch: " << std::boolalpha << !cache_builder_.isLocalBypass();
   }
 
   friend std::ostream &operator<<(std::ostream &out, const CachePerfRun &cp) {
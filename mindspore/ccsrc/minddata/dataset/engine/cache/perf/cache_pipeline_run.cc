@@ -92,11 +92,13 @@ int32_t CachePipelineRun::ProcessClientArgs(char *argv) {
         cache_builder_.SetNumConnections(std::stoi(s));
       } else if (numArgs == 5) {
         cache_builder_.SetSpill(strcmp(s.data(), "true") == 0);
+      } else if (numArgs == 6) {
+        cache_builder_.SetLocalBypass(strcmp(s.data(), "true") == 0);
       }
       ++numArgs;
     }
-    if (numArgs != 6) {
-      std::cerr << "Incomplete arguments. Expect 6. But get " << numArgs << std::endl;
+    if (numArgs != 7) {
+      std::cerr << "Incomplete arguments. Expect 7. But get " << numArgs << std::endl;
       return -1;
     }
   } catch (const std::exception &e) {
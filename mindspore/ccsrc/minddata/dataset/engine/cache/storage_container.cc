@@ -111,6 +111,9 @@ Status StorageContainer::Write(const ReadableSlice &dest, off64_t offset) const
 }
 
 Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *offset) noexcept {
+  if (bs_ == nullptr) {
+    RETURN_STATUS_UNEXPECTED("Container " + cont_.toString() + " is opened for read only");
+  }
   size_t sz = 0;
   for (auto &v : buf) {
     sz += v.GetSize();
@@ -146,26 +149,42 @@ Status StorageContainer::Insert(const std::vector<ReadableSlice> &buf, off64_t *
 }
 
 Status StorageContainer::Truncate() const noexcept {
-  if (is_open_) {
+  // A persistent container outlives this object and its content must stay.
+  if (is_open_ && !persistent_) {
     RETURN_IF_NOT_OK(cont_.TruncateFile(fd_));
     MS_LOG(INFO) << "Container " << cont_ << " truncated";
   }
   return Status::OK();
 }
 
+Status StorageContainer::Sync() const noexcept {
+  if (is_open_) {
+#if !defined(_WIN32) && !defined(_WIN64)
+    if (fsync(fd_) == -1) {
+      RETURN_STATUS_UNEXPECTED(strerror(errno));
+    }
+#endif
+  }
+  return Status::OK();
+}
+
 StorageContainer::~StorageContainer() noexcept {
   (void)Truncate();
   (void)Close();
 }
 
 std::ostream &operator<<(std::ostream &os, const StorageContainer &s) {
-  os << "File path : " << s.cont_ << "\n" << *(s.bs_.get());
+  os << "File path : " << s.cont_ << "\n";
+  if (s.bs_ != nullptr) {
+    os << *(s.bs_.get());
+  }
   return os;
 }
 
-Status StorageContainer::CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path) {
+Status StorageContainer::CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path,
+                                                bool persistent) {
   Status rc;
-  auto sc = new (std::nothrow) StorageContainer(path);
+  auto sc = new (std::nothrow) StorageContainer(path, persistent);
   if (sc == nullptr) {
     return Status(StatusCode::kMDOutOfMemory);
   }
@@ -177,5 +196,21 @@ Status StorageContainer::CreateStorageContainer(std::shared_ptr<StorageContainer
   }
   return rc;
 }
+
+Status StorageContainer::OpenStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path) {
+  RETURN_UNEXPECTED_IF_NULL(out_sc);
+  auto sc = new (std::nothrow) StorageContainer(path, true);
+  if (sc == nullptr) {
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  // Without a BuddySpace there is no free space to allocate from. The container can only be read.
+  Status rc = sc->Open();
+  if (rc.IsOk()) {
+    (*out_sc).reset(sc);
+  } else {
+    delete sc;
+  }
+  return rc;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -56,20 +56,37 @@ class StorageContainer {
 
   Status Truncate() const noexcept;
 
+  /// \brief Flush the content of the container to the disk
+  Status Sync() const noexcept;
+
   bool IsOpen() const { return is_open_; }
 
-  static Status CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path);
+  /// \brief Create a new container
+  /// \param[out] out_sc The container created
+  /// \param path The file of the container
+  /// \param persistent If true, the content of the file is kept when the container is destroyed
+  /// \return Status object
+  static Status CreateStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path,
+                                       bool persistent = false);
+
+  /// \brief Open an existing persistent container for read. No new data can be inserted into it.
+  /// \param[out] out_sc The container opened
+  /// \param path The file of the container
+  /// \return Status object
+  static Status OpenStorageContainer(std::shared_ptr<StorageContainer> *out_sc, const std::string &path);
 
  private:
   mutable std::mutex mutex_;
   Path cont_;
   int fd_;
   bool is_open_;
+  bool persistent_;
   std::unique_ptr<BuddySpace> bs_;
 
   // Use the default value of BuddySpace
   // which can map upto 4G of space.
-  explicit StorageContainer(const std::string &path) : cont_(path), fd_(-1), is_open_(false), bs_(nullptr) {}
+  StorageContainer(const std::string &path, bool persistent)
+      : cont_(path), fd_(-1), is_open_(false), persistent_(persistent), bs_(nullptr) {}
 
   Status Create();
 };
@@ -27,6 +27,11 @@
 
 namespace mindspore {
 namespace dataset {
+namespace {
+const char kContainerPrefix[] = "IMG";
+const char kContainerSuffix[] = "LB";
+}  // namespace
+
 std::string StorageManager::GetBaseName(const std::string &prefix, int32_t file_id) {
   std::ostringstream oss;
   oss << prefix << std::setfill('0') << std::setw(5) << file_id;
@@ -39,11 +44,9 @@ std::string StorageManager::ConstructFileName(const std::string &prefix, int32_t
 }
 
 Status StorageManager::AddOneContainer(int replaced_container_pos) {
-  const std::string kPrefix = "IMG";
-  const std::string kSuffix = "LB";
-  Path container_name = root_ / ConstructFileName(kPrefix, file_id_, kSuffix);
+  Path container_name = root_ / ConstructFileName(kContainerPrefix, file_id_, kContainerSuffix);
   std::shared_ptr<StorageContainer> sc;
-  RETURN_IF_NOT_OK(StorageContainer::CreateStorageContainer(&sc, container_name.toString()));
+  RETURN_IF_NOT_OK(StorageContainer::CreateStorageContainer(&sc, container_name.toString(), persistent_));
   containers_.push_back(sc);
   file_id_++;
   if (replaced_container_pos >= 0) {
@@ -57,7 +60,16 @@ Status StorageManager::AddOneContainer(int replaced_container_pos) {
 Status StorageManager::DoServiceStart() {
   containers_.reserve(kMaxNumContainers);
   writable_containers_pool_.reserve(pool_size_);
-  if (root_.IsDirectory()) {
+  if (read_only_) {
+    // The container id is its position in containers_, which is also the number in its file name.
+    for (int32_t i = 0; i < num_containers_to_open_; i++) {
+      Path container_name = root_ / ConstructFileName(kContainerPrefix, i, kContainerSuffix);
+      std::shared_ptr<StorageContainer> sc;
+      RETURN_IF_NOT_OK(StorageContainer::OpenStorageContainer(&sc, container_name.toString()));
+      containers_.push_back(sc);
+      file_id_++;
+    }
+  } else if (root_.IsDirectory()) {
     // create multiple containers and store their index in a pool
     for (int i = 0; i < pool_size_; i++) {
       RETURN_IF_NOT_OK(AddOneContainer());
@@ -77,6 +89,9 @@ Status StorageManager::Write(key_type *key, const std::vector<ReadableSlice> &bu
   if (sz == 0) {
     RETURN_STATUS_UNEXPECTED("Unexpected 0 length");
   }
+  if (read_only_) {
+    RETURN_STATUS_UNEXPECTED("Storage " + root_.toString() + " is opened for read only");
+  }
   auto mt = GetRandomDevice();
   std::shared_ptr<StorageContainer> cont;
   key_type out_key;
@@ -155,6 +170,49 @@ Status StorageManager::Read(StorageManager::key_type key, WritableSlice *dest, s
   return Status::OK();
 }
 
+Status StorageManager::Reopen(int32_t num_containers) {
+  CHECK_FAIL_RETURN_UNEXPECTED(persistent_, "Only a persistent storage can be reopened");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_containers > 0 && num_containers <= kMaxNumContainers,
+                               "Invalid number of containers: " + std::to_string(num_containers));
+  read_only_ = true;
+  num_containers_to_open_ = num_containers;
+  return ServiceStart();
+}
+
+Status StorageManager::Restore(const value_type &value, key_type *out_key) {
+  RETURN_UNEXPECTED_IF_NULL(out_key);
+  int container_inx = value.first;
+  CHECK_FAIL_RETURN_UNEXPECTED(container_inx >= 0 && container_inx < static_cast<int>(containers_.size()),
+                               "Invalid container id: " + std::to_string(container_inx));
+  RETURN_IF_NOT_OK(index_.insert(value, out_key));
+  return Status::OK();
+}
+
+Status StorageManager::Locate(key_type key, value_type *out) const {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  auto r = index_.Search(key);
+  if (r.second) {
+    auto &it = r.first;
+    *out = *it;
+  } else {
+    RETURN_STATUS_UNEXPECTED("Key not found");
+  }
+  return Status::OK();
+}
+
+Status StorageManager::Sync() {
+  SharedLock lock_s(&rw_lock_);
+  for (auto const &p : containers_) {
+    RETURN_IF_NOT_OK(p->Sync());
+  }
+  return Status::OK();
+}
+
+int32_t StorageManager::NumContainers() {
+  SharedLock lock_s(&rw_lock_);
+  return static_cast<int32_t>(containers_.size());
+}
+
 Status StorageManager::DoServiceStop() noexcept {
   Status rc;
   Status rc1;
@@ -172,10 +230,23 @@ Status StorageManager::DoServiceStop() noexcept {
   return rc1;
 }
 
-StorageManager::StorageManager(const Path &root) : root_(root), pool_size_(1), file_id_(0), index_() {}
+StorageManager::StorageManager(const Path &root)
+    : root_(root),
+      pool_size_(1),
+      file_id_(0),
+      index_(),
+      persistent_(false),
+      read_only_(false),
+      num_containers_to_open_(0) {}
 
-StorageManager::StorageManager(const Path &root, int pool_size)
-    : root_(root), pool_size_(pool_size), file_id_(0), index_() {}
+StorageManager::StorageManager(const Path &root, int pool_size, bool persistent)
+    : root_(root),
+      pool_size_(pool_size),
+      file_id_(0),
+      index_(),
+      persistent_(persistent),
+      read_only_(false),
+      num_containers_to_open_(0) {}
 
 StorageManager::~StorageManager() { (void)StorageManager::DoServiceStop(); }
 
@@ -51,7 +51,11 @@ class StorageManager : public Service {
 
   explicit StorageManager(const Path &);
 
-  StorageManager(const Path &root, int pool_size);
+  /// \brief Constructor
+  /// \param root The folder of the containers
+  /// \param pool_size Number of containers which are written to concurrently
+  /// \param persistent If true, the containers are kept on disk when the StorageManager goes away
+  StorageManager(const Path &root, int pool_size, bool persistent = false);
 
   ~StorageManager() override;
 
@@ -63,6 +67,28 @@ class StorageManager : public Service {
 
   Status Read(key_type key, WritableSlice *dest, size_t *bytesRead) const;
 
+  /// \brief Bring up a persistent StorageManager on the containers a previous one left in the root folder.
+  /// It is used in place of ServiceStart. The containers are read only and the whereabouts of the buffers
+  /// have to be put back with Restore.
+  /// \param num_containers Number of containers in the folder
+  /// \return Status object
+  Status Reopen(int32_t num_containers);
+
+  /// \brief Put back the whereabouts of a buffer written by a previous StorageManager on the same folder
+  /// \param[in] value The container, offset and size of the buffer
+  /// \param[out] out_key The key to read the buffer with
+  /// \return Status object
+  Status Restore(const value_type &value, key_type *out_key);
+
+  /// \brief Find the container, offset and size of a buffer
+  Status Locate(key_type key, value_type *out) const;
+
+  /// \brief Flush all the containers to the disk
+  Status Sync();
+
+  /// \brief Number of containers created so far
+  int32_t NumContainers();
+
   Status DoServiceStart() override;
 
   Status DoServiceStop() noexcept override;
@@ -77,6 +103,9 @@ class StorageManager : public Service {
   storage_index index_;
   std::vector<int> writable_containers_pool_;
   int pool_size_;
+  bool persistent_;
+  bool read_only_;
+  int32_t num_containers_to_open_;
 
   std::string GetBaseName(const std::string &prefix, int32_t file_id);
 
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_CONNECTOR_H_
 
+#include <deque>
 #include <memory>
 #include <string>
 #include <utility>
@@ -42,6 +43,9 @@ namespace dataset {
 //      want to push to a Connector class, you must follow roundrobin element distribution,
 //      i.e., the thread-id0 must have the first element, thread-id1 has the second element,
 //      and so on; then each of this worker can push to the Connector class async in parallel.
+//   3. If the number of producers taking part in the roundrobin changes at runtime, the change must be
+//      made at the end of a full round (the next element goes to thread-id0) and announced with
+//      SetActiveProducers() before that element is pushed.
 //
 // Blocking conditions:
 //   1. Connector.push(int, T) can block when the internal queue it's trying to push is full.
@@ -72,7 +76,7 @@ class Connector {
   // @param n_consumers The number of thread consuming data from this DbConnector.
   // @param queue_capacity The number of element for each queue.
   Connector(int32_t n_producers, int32_t n_consumers, int32_t queue_capacity)
-      : num_producers_(n_producers), num_consumers_(n_consumers) {
+      : num_producers_(n_producers), num_consumers_(n_consumers), active_producers_(n_producers) {
     MS_LOG(DEBUG) << "A connector is created with " << n_producers << " producers and " << n_consumers << " consumers.";
     my_name_ = Services::GetUniqueID();
     // We require the consumers to have ids sequentially from 0 to the num_consumers_-1,
@@ -101,7 +105,7 @@ class Connector {
       std::unique_lock<std::mutex> lk(m_);
       RETURN_IF_NOT_OK(cv_.Wait(&lk, [this, worker_id]() { return expect_consumer_ == worker_id; }));
       RETURN_IF_NOT_OK(queues_[pop_from_]->PopFront(result));
-      pop_from_ = (pop_from_ + 1) % num_producers_;
+      AdvancePopFrom();
       out_buffers_count_++;
       expect_consumer_ = (expect_consumer_ + 1) % num_consumers_;
     }
@@ -143,6 +147,11 @@ class Connector {
     expect_consumer_ = 0;
     pop_from_ = 0;
     out_buffers_count_ = 0;
+    {
+      std::unique_lock<std::mutex> lk(switch_mux_);
+      producer_switches_.clear();
+      num_popped_ = 0;
+    }
     MS_LOG(DEBUG) << "Connector counters reset.";
   }
 
@@ -166,14 +175,43 @@ class Connector {
     return size;
   }
 
+  // Get current capacity of connector. Only the queues of the active producers are counted.
   int32_t capacity() const {
     int32_t capacity = 0;
-    for (int32_t i = 0; i < queues_.size(); ++i) {
+    for (int32_t i = 0; i < active_producers_; ++i) {
       capacity += queues_[i]->capacity();
     }
     return capacity;
   }
 
+  // Change the capacity of every internal queue while the connector is in use.
+  // @param queue_capacity The new number of elements for each queue.
+  // @return Status error code
+  Status SetQueueCapacity(int32_t queue_capacity) {
+    for (int32_t i = 0; i < queues_.size(); ++i) {
+      RETURN_IF_NOT_OK(queues_[i]->Resize(queue_capacity));
+    }
+    return Status::OK();
+  }
+
+  // Change the number of producers taking part in the roundrobin. The connector must have been created with
+  // at least num_producers producers. See requirement 3 at the top of this file.
+  // @param num_producers The number of producers pushing from the switch point on.
+  // @param switch_at The total number of elements pushed before the switch point.
+  // @return Status error code
+  Status SetActiveProducers(int32_t num_producers, int64_t switch_at) {
+    CHECK_FAIL_RETURN_UNEXPECTED(num_producers > 0 && num_producers <= num_producers_,
+                                 "Invalid number of active producers: " + std::to_string(num_producers));
+    std::unique_lock<std::mutex> lk(switch_mux_);
+    if (producer_switches_.empty() && num_popped_ == switch_at) {
+      // The consumer is already waiting on the first queue for the element at the switch point
+      active_producers_ = num_producers;
+    } else {
+      producer_switches_.emplace_back(switch_at, num_producers);
+    }
+    return Status::OK();
+  }
+
   // Register the internal resources with Task group for interruption service.
   // @param vg
   // @return
@@ -186,6 +224,23 @@ class Connector {
   }
 
  protected:
+  // Count the element just popped and apply the change of active_producers_ due at it, if any.
+  // Must be called with m_ held after each element popped.
+  // @return true if active_producers_ changed, the next element is then in the first queue
+  bool UpdateActiveProducers() {
+    std::unique_lock<std::mutex> lk(switch_mux_);
+    ++num_popped_;
+    if (!producer_switches_.empty() && producer_switches_.front().first == num_popped_) {
+      active_producers_ = producer_switches_.front().second;
+      producer_switches_.pop_front();
+      return true;
+    }
+    return false;
+  }
+
+  // Move pop_from_ to the queue holding the next element. Must be called with m_ held after each element popped.
+  void AdvancePopFrom() { pop_from_ = UpdateActiveProducers() ? 0 : (pop_from_ + 1) % active_producers_; }
+
   std::string my_name_;
 
   // A list of Queues that are thread safe.
@@ -200,6 +255,13 @@ class Connector {
   int32_t num_producers_;
   int32_t num_consumers_;
 
+  // The number of queues the roundrobin pop currently cycles through, the remaining queues stay idle.
+  std::atomic<int32_t> active_producers_;
+  // Pending changes of active_producers_ as (elements popped before the change, new count), guarded by switch_mux_.
+  std::mutex switch_mux_;
+  std::deque<std::pair<int64_t, int32_t>> producer_switches_;
+  int64_t num_popped_ = 0;
+
   // Used in the Pop(), when a thread call pop() but it is not the expect_consumer_.
   std::mutex m_;
   CondVar cv_;
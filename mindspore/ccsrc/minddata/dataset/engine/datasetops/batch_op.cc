@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/datasetops/batch_op.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "utils/ms_utils.h"
@@ -85,7 +86,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     queue_size = std::max(2, queue_size);
   }
 
-  worker_queues_.Init(num_workers, queue_size);
+  EnableDynamicWorkers();
+  worker_queues_.Init(std::max(num_workers_, max_num_workers_), queue_size);
 }
 // if PYTHON is disabled. per_batch_map can't be used
 #else
@@ -105,7 +107,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
     // ensure there is at least 2 queue slots for whole operation..  If only 1 worker, incrase it to 2
     queue_size = std::max(2, queue_size);
   }
-  worker_queues_.Init(num_workers, queue_size);
+  EnableDynamicWorkers();
+  worker_queues_.Init(std::max(num_workers_, max_num_workers_), queue_size);
 }
 #endif
 
@@ -115,6 +118,7 @@ Status BatchOp::operator()() {
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(rc);
   int64_t epoch_num = 0, batch_num = 0, cnt = 0;
+  int32_t worker_id = 0;
   TensorRow new_row;
   std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
@@ -126,7 +130,8 @@ Status BatchOp::operator()() {
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch, send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
-        RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
+        RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+        RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(
           std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
         cnt++;
         table = std::make_unique<TensorQTable>();
@@ -136,7 +141,8 @@ Status BatchOp::operator()() {
     }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
-      RETURN_IF_NOT_OK(worker_queues_[cnt % num_workers_]->EmplaceBack(
+      RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+      RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(
         std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
       cnt++;
     }
@@ -144,8 +150,9 @@ Status BatchOp::operator()() {
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
     epoch_num++;
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+    RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+    RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOE))));
+    cnt++;
     RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
 
@@ -158,12 +165,11 @@ Status BatchOp::operator()() {
     }
 #endif
   }  // end of eof_handled() == false
-  RETURN_IF_NOT_OK(
-    worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
+  RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+  RETURN_IF_NOT_OK(worker_queues_[worker_id]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kEOF))));
   // EOF received, send quit signal to all workers
-  for (int32_t ind = 0; ind < num_workers_; ind++) {
-    RETURN_IF_NOT_OK(
-      worker_queues_[cnt++ % num_workers_]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
+  for (int32_t ind = 0; ind < num_workers_launched_; ind++) {
+    RETURN_IF_NOT_OK(worker_queues_[ind]->EmplaceBack(std::make_pair(nullptr, CBatchInfo(batchCtrl::kQuit))));
   }
   return Status::OK();
 }
@@ -182,7 +188,8 @@ void BatchOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
-Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size) {
+Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
+                          const std::vector<std::shared_ptr<TensorOp>> &col_ops) {
   if ((*src)->size() != batch_size) {
     RETURN_STATUS_UNEXPECTED("[Internal Batch ERROR] Source table size does not match the batch_size");
   }
@@ -191,14 +198,30 @@ Status BatchOp::BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *d
     *dest = std::move((*src)->front());
     (*src)->pop_front();
 
-    for (const auto &tensor : (*dest)) {
-      RETURN_IF_NOT_OK(tensor->ExpandDim(0));
+    for (size_t i = 0; i < dest->size(); i++) {
+      if (i < col_ops.size() && col_ops[i] != nullptr) {
+        RETURN_IF_NOT_OK(col_ops[i]->ComputeBatch({(*dest)[i]}, &(*dest)[i]));
+      } else {
+        RETURN_IF_NOT_OK((*dest)[i]->ExpandDim(0));
+      }
     }
     return Status::OK();
   }
 
   auto num_columns = (*src)->front().size();
   for (size_t i = 0; i < num_columns; i++) {
+    if (i < col_ops.size() && col_ops[i] != nullptr) {
+      // the op writes the rows into the batch tensor itself
+      std::vector<std::shared_ptr<Tensor>> column;
+      column.reserve(batch_size);
+      for (auto &row : **src) {
+        column.push_back(std::move(row.at(i)));
+      }
+      std::shared_ptr<Tensor> new_tensor;
+      RETURN_IF_NOT_OK(col_ops[i]->ComputeBatch(column, &new_tensor));
+      dest->emplace_back(new_tensor);
+      continue;
+    }
     std::shared_ptr<Tensor> first_tensor = (*src)->at(0).at(i);  // first row, column i
     TensorShape first_shape = first_tensor->shape();
     DataType first_type = first_tensor->type();
@@ -262,7 +285,22 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
   if (!in_col_names_.empty()) RETURN_IF_NOT_OK(MapColumns(&table_pair));  // pass it through pyfunc
 #endif
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));  // do padding if needed
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size()));
+  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size(), post_batch_col_ops_));
+  return Status::OK();
+}
+
+Status BatchOp::InitPostBatchOps() {
+  if (post_batch_ops_.empty() || !post_batch_col_ops_.empty()) {
+    return Status::OK();
+  }
+  post_batch_col_ops_.resize(column_name_id_map_.size());
+  for (const auto &itr : post_batch_ops_) {
+    auto col_itr = column_name_id_map_.find(itr.first);
+    CHECK_FAIL_RETURN_UNEXPECTED(col_itr != column_name_id_map_.end(),
+                                 "Invalid column, post batch op " + itr.second->Name() + " runs on column: " +
+                                   itr.first + ", which does not exist.");
+    post_batch_col_ops_[col_itr->second] = itr.second;
+  }
   return Status::OK();
 }
 
@@ -270,6 +308,7 @@ Status BatchOp::LaunchThreadsAndInitOp() {
   if (tree_ == nullptr) {
     return Status(StatusCode::kMDUnexpectedError, __LINE__, __FILE__, "Pipeline init failed, Execution tree not set.");
   }
+  RETURN_IF_NOT_OK(InitPostBatchOps());
   RETURN_IF_NOT_OK(worker_queues_.Register(tree_->AllTasks()));
   RETURN_IF_NOT_OK(
     tree_->LaunchWorkers(num_workers_, std::bind(&BatchOp::WorkerEntry, this, std::placeholders::_1), Name(), id()));
@@ -567,6 +606,7 @@ int64_t BatchOp::GetTreeBatchSize() {
 }
 
 Status BatchOp::GetNextRowPullMode(TensorRow *const row) {
+  RETURN_IF_NOT_OK(InitPostBatchOps());
   std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   int32_t cur_batch_size = 0;
@@ -586,7 +626,7 @@ Status BatchOp::GetNextRowPullMode(TensorRow *const row) {
   RETURN_UNEXPECTED_IF_NULL(table);
   if (pad_) RETURN_IF_NOT_OK(PadColumns(&table, pad_info_, column_name_id_map_));  // do padding if needed
   if (!table->empty()) {
-    RETURN_IF_NOT_OK(BatchRows(&table, row, table->size()));
+    RETURN_IF_NOT_OK(BatchRows(&table, row, table->size(), post_batch_col_ops_));
     batch_cnt_++;
     batch_num_++;
   }
@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -196,13 +197,21 @@ class BatchOp : public ParallelOp {
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
+  // Set the ops to run on whole batches of a column
+  // @param std::map<std::string, std::shared_ptr<TensorOp>> post_batch_ops - column name to the op run on its batches
+  void SetPostBatchOps(std::map<std::string, std::shared_ptr<TensorOp>> post_batch_ops) {
+    post_batch_ops_ = std::move(post_batch_ops);
+  }
+
   // batch the rows in src table then put it to dest table
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
   // @param int32_t size - batch_size
-  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param const std::vector<std::shared_ptr<TensorOp>> &col_ops - op making the batch of each column, in place of
+  //     the copy of its rows. nullptr or no entry for a plain copy
   // @return Status The status code returned
-  static Status BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size);
+  static Status BatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
+                          const std::vector<std::shared_ptr<TensorOp>> &col_ops = {});
 
   // @param table
   // @param const PadInfo &pad_info pad info
@@ -252,6 +261,10 @@ class BatchOp : public ParallelOp {
   // @return Status The status code returned
   Status GetBatchSize(int32_t *batch_size, CBatchInfo info);
 
+  // Look up the columns of the post batch ops
+  // @return Status The status code returned
+  Status InitPostBatchOps();
+
   // Do the initialization of all queues then start all worker threads
   // @return Status The status code returned
   Status LaunchThreadsAndInitOp();
@@ -282,6 +295,8 @@ class BatchOp : public ParallelOp {
   QueueList<std::pair<std::unique_ptr<TensorQTable>, CBatchInfo>> worker_queues_;  // internal queue for syncing worker
   int64_t batch_num_;
   int64_t batch_cnt_;
+  std::map<std::string, std::shared_ptr<TensorOp>> post_batch_ops_;  // column name to the op run on its batches
+  std::vector<std::shared_ptr<TensorOp>> post_batch_col_ops_;         // the post batch op of each column id
 #ifdef ENABLE_PYTHON
   py::function batch_size_func_;  // Function pointer of batch size function
   py::function batch_map_func_;   // Function pointer of per batch map function
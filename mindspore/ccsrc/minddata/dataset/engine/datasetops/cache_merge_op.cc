@@ -195,10 +195,12 @@ Status CacheMergeOp::PrepareOperator() {  // Run any common code from super clas
   RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
   // Get the computed check sum from all ops in the cache miss class
   uint32_t cache_crc = DatasetOp::GenerateCRC(child_[kCacheMissChildIdx]);
+  // A persisted cache of the same pipeline is only reused if the source files are the same
+  uint32_t source_id = DatasetOp::GenerateSourceId(child_[kCacheMissChildIdx]);
   // This is a mappable cache op so the id's need to be generated.
   // Construct the cache
   const bool generate_ids = false;
-  Status rc = cache_client_->CreateCache(cache_crc, generate_ids);
+  Status rc = cache_client_->CreateCache(cache_crc, generate_ids, source_id);
   if (rc.StatusCode() == StatusCode::kMDDuplicateKey) {
     // We are told the cache has been created already.
     MS_LOG(INFO) << "Cache created already";
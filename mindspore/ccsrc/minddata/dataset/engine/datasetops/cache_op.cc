@@ -225,10 +225,12 @@ Status CacheOp::PrepareOperator() {
   RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
   // Get the computed check sum from all ops in our cache path below us and ask the cache op to create it's cache
   uint32_t cache_crc = DatasetOp::GenerateCRC(shared_from_this());
+  // A persisted cache of the same pipeline is only reused if the source files are the same
+  uint32_t source_id = DatasetOp::GenerateSourceId(shared_from_this());
   // This is a non-mappable cache op so the id's need to be generated.
   // Construct the cache
   const bool generate_ids = true;
-  Status rc = cache_client_->CreateCache(cache_crc, generate_ids);
+  Status rc = cache_client_->CreateCache(cache_crc, generate_ids, source_id);
   if (rc.StatusCode() == StatusCode::kMDDuplicateKey) {
     // We are told the cache has been created already. So we skip the build phase.
     phase_ = Phase::kFetchPhase;
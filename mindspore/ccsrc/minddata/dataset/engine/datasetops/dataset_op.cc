@@ -15,6 +15,7 @@
  */
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 
+#include <sys/stat.h>
 #include <iomanip>
 #include <iostream>
 #include <memory>
@@ -30,6 +31,7 @@
 #ifndef ENABLE_ANDROID
 #include "utils/system/crc32c.h"
 #include "utils/log_adapter.h"
+#include "minddata/dataset/util/path.h"
 #else
 #include "mindspore/lite/src/common/log_adapter.h"
 #endif
@@ -294,6 +296,15 @@ Status DatasetOp::GetClassIndexing(std::vector<std::pair<std::string, std::vecto
   }
 }
 
+Status DatasetOp::GetSourceFiles(std::vector<std::string> *files) {
+  RETURN_UNEXPECTED_IF_NULL(files);
+  // A leaf without an override reads no file, e.g. the generator or the random data
+  for (const auto &child : child_) {
+    RETURN_IF_NOT_OK(child->GetSourceFiles(files));
+  }
+  return Status::OK();
+}
+
 // Performs handling for when an eoe message is received.
 // The base class implementation simply flows the eoe message to output. Derived classes
 // may override if they need to perform special eoe handling.
@@ -421,6 +432,48 @@ uint32_t DatasetOp::GenerateCRC(const std::shared_ptr<DatasetOp> &op) {
   uint32_t cache_crc = system::Crc32c::GetMaskCrc32cValue(ss_str.c_str(), ss_str.length());
   return cache_crc;
 }
+
+namespace {
+// Print the size and modification time of the file, or of every file below the folder in name order
+void PrintFileStat(const std::string &name, std::stringstream *ss) {
+  struct stat st {};
+  if (stat(name.c_str(), &st) != 0) {
+    *ss << name << " not found\n";
+    return;
+  }
+  if (S_ISDIR(st.st_mode)) {
+    Path dir(name);
+    auto dir_it = Path::DirIterator::OpenDirectory(&dir);
+    std::vector<std::string> entries;
+    while (dir_it != nullptr && dir_it->hasNext()) {
+      entries.push_back(dir_it->next().toString());
+    }
+    std::sort(entries.begin(), entries.end());
+    for (const auto &entry : entries) {
+      PrintFileStat(entry, ss);
+    }
+    return;
+  }
+  *ss << name << " " << st.st_size << " " << st.st_mtime << "\n";
+}
+}  // namespace
+
+uint32_t DatasetOp::GenerateSourceId(const std::shared_ptr<DatasetOp> &op) {
+  std::vector<std::string> files;
+  Status rc = op->GetSourceFiles(&files);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "Unable to get the source files of " << op->NameWithID() << ". " << rc.ToString();
+  }
+  std::stringstream ss;
+  for (const auto &file : files) {
+    PrintFileStat(file, &ss);
+  }
+  std::string ss_str = ss.str();
+  MS_LOG(DEBUG) << "Printing the source files for generating source id:\n" << ss_str;
+
+  uint32_t source_id = system::Crc32c::GetMaskCrc32cValue(ss_str.c_str(), ss_str.length());
+  return source_id;
+}
 #endif
 
 void DatasetOp::UpdateRepeatAndEpochCounter() {
@@ -178,6 +178,11 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
   /// \return Status - The status code return
   virtual Status GetClassIndexing(std::vector<std::pair<std::string, std::vector<int32_t>>> *output_class_indexing);
 
+  /// \brief Gets the files and folders the data of the op is read from, the ops above a leaf ask their children
+  /// \param[in,out] files The files are appended to it
+  /// \return Status - The status code return
+  virtual Status GetSourceFiles(std::vector<std::string> *files);
+
   /// \brief Performs handling for when an eoe message is received.
   ///     The base class implementation simply flows the eoe message to output. Derived classes
   ///     may override if they need to perform special eoe handling.
@@ -278,6 +283,20 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
     return ChildOpConnectorCapacity();
   }
 
+  /// \brief Change the capacity of each internal queue of the output connector while the tree is running
+  /// \param[in] queue_size The new number of rows each queue can hold
+  /// \return Status The status code returned
+  Status SetConnectorQueueSize(int32_t queue_size) {
+    CHECK_FAIL_RETURN_UNEXPECTED(out_connector_ != nullptr, NameWithID() + " has no output connector to resize.");
+    RETURN_IF_NOT_OK(out_connector_->SetQueueCapacity(queue_size));
+    oc_queue_size_ = queue_size;
+    return Status::OK();
+  }
+
+  /// \brief Getter function
+  /// \return the number of rows each internal queue of the output connector can hold
+  int32_t ConnectorQueueSize() const { return oc_queue_size_; }
+
   /// \brief Getter function
   /// \return connector size of child op
   int32_t ChildOpConnectorSize(int32_t child_index = 0) const { return child_[child_index]->ConnectorSize(); }
@@ -314,6 +333,9 @@ class DatasetOp : public std::enable_shared_from_this<DatasetOp> {
 #ifndef ENABLE_ANDROID
   // Computes a CRC value for the operator
   static uint32_t GenerateCRC(const std::shared_ptr<DatasetOp> &op);
+
+  // Computes a CRC value of the size and modification time of the source files of the operator
+  static uint32_t GenerateSourceId(const std::shared_ptr<DatasetOp> &op);
 #endif
 
   /// \brief A helper templated function for casting "this" pointer to shared_ptr<derived>
@@ -37,7 +37,7 @@ CpuMapJob::~CpuMapJob() = default;
 Status CpuMapJob::Run(std::vector<TensorRow> in, std::vector<TensorRow> *out) {
   int32_t num_rows = in.size();
   for (int32_t row = 0; row < num_rows; row++) {
-    TensorRow input_row = in[row];
+    TensorRow input_row = std::move(in[row]);
     TensorRow result_row;
     for (size_t i = 0; i < ops_.size(); i++) {
       // Call compute function for cpu
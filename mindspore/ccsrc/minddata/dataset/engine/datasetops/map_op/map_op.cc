@@ -67,6 +67,7 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
   if (out_columns_.empty() || out_columns_[0].empty()) {
     out_columns_ = in_columns_;
   }
+  EnableDynamicWorkers();
 }
 
 // The number of threads consuming data from previous op's output Connector.
@@ -141,8 +142,8 @@ Status MapOp::GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job)
 
 // This class functor will provide the master loop that drives the logic for performing the work
 Status MapOp::operator()() {
-  // Create and register the local queues.
-  local_queues_.Init(num_workers_, oc_queue_size_);
+  // Create and register the local queues, one for every worker this op may have.
+  local_queues_.Init(std::max(num_workers_, max_num_workers_), oc_queue_size_);
   // init callback
   RETURN_IF_NOT_OK(callback_manager_.Init(this));
   Status rc = local_queues_.Register(tree_->AllTasks());
@@ -158,8 +159,9 @@ Status MapOp::operator()() {
   // Synchronize with TaskManager
   TaskManager::FindMe()->Post();
   RETURN_IF_NOT_OK(rc);
-  // num_rows received, including eoe, num_epoch, num_step of current epoch
-  int64_t num_rows = 0, ep_step = 0, total_step = 0;
+  // num_epoch, num_step of current epoch
+  int64_t ep_step = 0, total_step = 0;
+  int32_t worker_id = 0;
 
   RETURN_IF_NOT_OK(callback_manager_.Begin(CallbackParam(0, ep_step, total_step)));
 
@@ -184,7 +186,8 @@ Status MapOp::operator()() {
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
       // Push map worker job to the corresponding worker's queue
-      RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+      RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+      RETURN_IF_NOT_OK(local_queues_[worker_id]->Add(std::move(worker_job)));
 
       RETURN_IF_NOT_OK(callback_manager_.StepEnd(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
 
@@ -199,20 +202,22 @@ Status MapOp::operator()() {
     }
     // Propagate the eoe row to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-    RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+    RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+    RETURN_IF_NOT_OK(local_queues_[worker_id]->Add(std::move(worker_job)));
     UpdateRepeatAndEpochCounter();
     RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   }
   // End() is commented out because it might never be called due to the lack of EOF when EpochCtrl is -1
   // Handle eof logic, this code might never be reached if epoch_ctrl = -1.
   std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
-  RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(worker_job)));
+  RETURN_IF_NOT_OK(NextWorkerId(&worker_id));
+  RETURN_IF_NOT_OK(local_queues_[worker_id]->Add(std::move(worker_job)));
 
   // Quit all workers, this code might never be reached if EpochCtrl is -1.
-  for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
+  for (int32_t wkr_id = 0; wkr_id < num_workers_launched_; wkr_id++) {
     TensorRow quit_flag(TensorRow::kFlagQuit);
     auto quit = std::make_unique<MapWorkerJob>(quit_flag);
-    RETURN_IF_NOT_OK(local_queues_[num_rows++ % num_workers_]->Add(std::move(quit)));
+    RETURN_IF_NOT_OK(local_queues_[wkr_id]->Add(std::move(quit)));
   }
 
   return Status::OK();
@@ -240,7 +245,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       if (in_row.wait()) {
         // When worker receives the signal from master thread, it increments a atomic int
         // The last guy who increments the counter, wakes up master thread
-        if (++num_workers_paused_ == num_workers_) {
+        if (++num_workers_paused_ == num_workers_launched_) {
           wait_for_workers_post_.Set();
         }
         // This will block the worker until master thread gives it a new work
@@ -259,7 +264,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
     CHECK_FAIL_RETURN_UNEXPECTED(in_row.size() != 0, "MapOp got an empty TensorRow.");
     TensorRow out_row;
     // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
-    RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
+    RETURN_IF_NOT_OK(WorkerCompute(std::move(in_row), &out_row, job_list));
     // Push the row onto the connector for next operator to consume.
     RETURN_IF_NOT_OK(out_connector_->Add(std::move(out_row), static_cast<int>(worker_id)));
     // Fetch next data row and map job list
@@ -268,7 +273,7 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
   return Status::OK();
 }
 
-Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
+Status MapOp::WorkerCompute(TensorRow in_row, TensorRow *out_row,
                             const std::vector<std::shared_ptr<MapJob>> &job_list) {
   int32_t num_cols = in_row.size();
 
@@ -298,7 +303,7 @@ Status MapOp::WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
   for (size_t i = 0; i < job_list.size(); i++) {
     RETURN_IF_INTERRUPTED();
     // Execute MapWorkerJob.
-    RETURN_IF_NOT_OK(job_list[i]->Run(job_input_table, &result_table));
+    RETURN_IF_NOT_OK(job_list[i]->Run(std::move(job_input_table), &result_table));
     // Assign the processed data as an input for the next job processing, except for the last TensorOp in the list.
     if (i + 1 < job_list.size()) {
       job_input_table = std::move(result_table);
@@ -437,7 +442,7 @@ void MapOp::CreateFinalColMap(std::unordered_map<std::string, int32_t> *col_name
 Status MapOp::WaitForWorkers() {
   // reset num_paused workers to 0
   num_workers_paused_ = 0;
-  for (int32_t wkr_id = 0; wkr_id < num_workers_; wkr_id++) {
+  for (int32_t wkr_id = 0; wkr_id < num_workers_launched_; wkr_id++) {
     // a special row (id=-1, empty, none flag) is used to signal that worker needs to pause.
     TensorRow waitRow(TensorRow::kFlagWait);
     RETURN_IF_NOT_OK(local_queues_[wkr_id]->Add(std::make_unique<MapWorkerJob>(waitRow)));
@@ -232,9 +232,9 @@ class MapOp : public ParallelOp {
   Status WorkerEntry(int32_t worker_id) override;  //  In: workerId assigned by tree_
 
   // Private function for worker thread to perform TensorOp's compute function and get the result.
-  // @param in_row Input TensorRow
+  // @param in_row Input TensorRow, the ops own the tensors they process so they can reuse their buffers
   // @param[out] out_row Generated TensorRow
-  Status WorkerCompute(const TensorRow &in_row, TensorRow *out_row,
+  Status WorkerCompute(TensorRow in_row, TensorRow *out_row,
                        const std::vector<std::shared_ptr<MapJob>> &job_list);
 
   // Private function that create the final column name to index mapping and
@@ -16,7 +16,11 @@
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
+#include <memory>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/db_connector.h"
@@ -29,6 +33,11 @@ ParallelOp::ParallelOp(int32_t num_workers, int32_t op_connector_size, std::shar
     : DatasetOp(op_connector_size, sampler),
       num_workers_(num_workers),
       num_producers_(num_workers),
+      max_num_workers_(0),
+      num_workers_launched_(num_workers),
+      target_num_workers_(num_workers),
+      num_rows_dispatched_(0),
+      dispatch_base_(0),
       worker_connector_size_(1),
       worker_connector_(nullptr),
       num_workers_paused_(0),
@@ -75,6 +84,15 @@ Status ParallelOp::Reset() {
   return Status::OK();
 }
 
+// Override base class to narrow the roundrobin of the output connector down to the initial workers.
+Status ParallelOp::PrepareOperator() {
+  RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
+  if (dynamic_workers() && out_connector_) {
+    RETURN_IF_NOT_OK(out_connector_->SetActiveProducers(num_workers_, 0));
+  }
+  return Status::OK();
+}
+
 // Register the internal worker connectors
 Status ParallelOp::RegisterWorkerConnectors() {
   if (worker_connector_) {
@@ -83,6 +101,46 @@ Status ParallelOp::RegisterWorkerConnectors() {
   return Status::OK();
 }
 
+void ParallelOp::EnableDynamicWorkers() {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  if (!cfg->enable_autotune()) {
+    return;
+  }
+  max_num_workers_ = std::max(num_workers_, cfg->num_cpu_threads());
+  // Every potential worker gets its own queue in the output connector
+  num_producers_ = max_num_workers_;
+}
+
+Status ParallelOp::SetNumWorkers(int32_t num_workers) {
+  CHECK_FAIL_RETURN_UNEXPECTED(dynamic_workers(), NameWithID() + " does not support changing its number of workers.");
+  CHECK_FAIL_RETURN_UNEXPECTED(num_workers > 0 && num_workers <= max_num_workers_,
+                               "Invalid number of workers for " + NameWithID() + ": " + std::to_string(num_workers) +
+                                 ", expected in range [1, " + std::to_string(max_num_workers_) + "].");
+  target_num_workers_ = num_workers;
+  return Status::OK();
+}
+
+Status ParallelOp::NextWorkerId(int32_t *worker_id) {
+  RETURN_UNEXPECTED_IF_NULL(worker_id);
+  int32_t target = target_num_workers_;
+  // Only switch at the end of a full roundrobin so the consumer of the output connector can follow along
+  if (target != num_workers_ && (num_rows_dispatched_ - dispatch_base_) % num_workers_ == 0) {
+    if (target > num_workers_launched_) {
+      RETURN_IF_NOT_OK(tree_->LaunchWorkers(target - num_workers_launched_,
+                                            std::bind(&ParallelOp::WorkerEntry, this, std::placeholders::_1),
+                                            NameWithID(), id(), num_workers_launched_));
+      num_workers_launched_ = target;
+    }
+    RETURN_IF_NOT_OK(out_connector_->SetActiveProducers(target, num_rows_dispatched_));
+    MS_LOG(INFO) << NameWithID() << " changes its number of workers from " << num_workers_ << " to " << target
+                 << " after " << num_rows_dispatched_ << " rows.";
+    num_workers_ = target;
+    dispatch_base_ = num_rows_dispatched_;
+  }
+  *worker_id = static_cast<int32_t>((num_rows_dispatched_++ - dispatch_base_) % num_workers_);
+  return Status::OK();
+}
+
 Status ParallelOp::WaitForWorkers() {
   num_workers_paused_ = 0;
   for (int32_t i = 0; i < num_workers_; i++) {
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_PARALLEL_OP_H_
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -70,6 +71,11 @@ class ParallelOp : public DatasetOp {
   // @return Status The status code returned
   Status Reset() override;
 
+  // Override base class to let the output connector start with the queues of the initial workers only,
+  // when the connector is created with a queue for every potential worker.
+  // @return Status The status code returned
+  Status PrepareOperator() override;
+
   // Getter
   // @return the number of workers
   int32_t num_workers() const override { return num_workers_; }
@@ -90,7 +96,37 @@ class ParallelOp : public DatasetOp {
   // @return Status
   Status RegisterWorkerConnectors() override;
 
+  // Getter
+  // @return true if the number of workers of this op can be changed while the tree is running
+  bool dynamic_workers() const { return max_num_workers_ > 0; }
+
+  // Getter
+  // @return the upper bound of SetNumWorkers()
+  int32_t max_num_workers() const { return max_num_workers_; }
+
+  // Getter
+  // @return the number of workers last requested through SetNumWorkers(), it may not be in effect yet
+  int32_t target_num_workers() const { return target_num_workers_; }
+
+  // Request a new number of active workers. Only supported when dynamic_workers() is true. The master thread
+  // applies the change at the end of its current roundrobin, launching new worker threads if needed. Threads
+  // of workers that become inactive stay idle until they are needed again.
+  // @param num_workers - The new number of active workers
+  // @return Status The status code returned
+  Status SetNumWorkers(int32_t num_workers);
+
  protected:
+  // Allow the workers of this op to be resized at runtime if the autotuner is enabled. This needs to be called
+  // from the constructor of the derived op, before any queue that is indexed by worker id is created.
+  void EnableDynamicWorkers();
+
+  // Pick the worker that the master thread dispatches the next row to, in roundrobin order. Control rows
+  // (eoe and eof) that are forwarded to the output connector by a worker must be dispatched this way as well.
+  // This is where a pending SetNumWorkers() request is applied.
+  // @param worker_id - The id of the worker to dispatch to
+  // @return Status The status code returned
+  Status NextWorkerId(int32_t *worker_id);
+
   // Interface for derived classes to implement. All derived classes must provide the entry
   // function with the main execution loop for worker threads.
   // @return Status The status code returned
@@ -114,6 +150,11 @@ class ParallelOp : public DatasetOp {
 
   int32_t num_workers_;    // The number of worker threads
   int32_t num_producers_;  // The number of threads pushing to the out_connector_
+  int32_t max_num_workers_;                  // Upper bound of num_workers_, 0 if it can't change at runtime
+  int32_t num_workers_launched_;             // The number of worker threads launched so far
+  std::atomic<int32_t> target_num_workers_;  // The number of workers requested by SetNumWorkers()
+  int64_t num_rows_dispatched_;              // Rows dispatched through NextWorkerId()
+  int64_t dispatch_base_;                    // Value of num_rows_dispatched_ when num_workers_ last changed
   int32_t worker_connector_size_;
   std::unique_ptr<DbConnector> worker_connector_;        // The internal connector for worker threads
   QueueList<std::unique_ptr<IOBlock>> io_block_queues_;  // queues of IOBlocks
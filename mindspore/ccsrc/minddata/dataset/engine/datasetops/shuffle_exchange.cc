@@ -0,0 +1,646 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/shuffle_exchange.h"
+
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <thread>
+#include <utility>
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/log_adapter.h"
+
+namespace mindspore {
+namespace dataset {
+LocalShuffleExchange::LocalShuffleExchange(int32_t num_ranks, uint32_t seed, std::chrono::milliseconds timeout)
+    : ShuffleExchange(num_ranks),
+      rng_(seed),
+      timeout_(timeout),
+      epoch_(0),
+      active_(num_ranks, true),
+      num_active_(num_ranks),
+      round_(0) {}
+
+Status LocalShuffleExchange::GetOrCreate(const std::string &group, int32_t num_ranks, uint32_t seed,
+                                         std::shared_ptr<ShuffleExchange> *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  CHECK_FAIL_RETURN_UNEXPECTED(num_ranks > 0, "ShuffleExchange: number of ranks must be positive.");
+  // The exchange lives as long as one of the ranks of the group holds it
+  static std::mutex registry_mux;
+  static std::map<std::string, std::weak_ptr<ShuffleExchange>> registry;
+  std::unique_lock<std::mutex> lck(registry_mux);
+  auto exchange = registry[group].lock();
+  if (exchange == nullptr) {
+    exchange = std::make_shared<LocalShuffleExchange>(num_ranks, seed);
+    registry[group] = exchange;
+  } else if (exchange->NumRanks() != num_ranks) {
+    std::string err_msg = "ShuffleExchange: group " + group + " has " + std::to_string(exchange->NumRanks()) +
+                          " ranks, but " + std::to_string(num_ranks) + " are expected.";
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  *out = std::move(exchange);
+  return Status::OK();
+}
+
+Status LocalShuffleExchange::WaitUntil(std::unique_lock<std::mutex> *lck, const std::function<bool()> &pred,
+                                       const std::string &what) {
+  auto deadline = std::chrono::steady_clock::now() + timeout_;
+  RETURN_IF_NOT_OK(cv_.Wait(lck, [this, &pred, deadline]() {
+    return pred() || abort_rc_.IsError() || std::chrono::steady_clock::now() >= deadline;
+  }));
+  RETURN_IF_NOT_OK(abort_rc_);
+  if (!pred()) {
+    std::string err_msg = "ShuffleExchange: timed out after " + std::to_string(timeout_.count()) + " ms waiting for " +
+                          what + ". Another rank may have stopped.";
+    RETURN_STATUS_UNEXPECTED(err_msg);
+  }
+  return Status::OK();
+}
+
+Status LocalShuffleExchange::WaitForEpoch(std::unique_lock<std::mutex> *lck, int64_t epoch) {
+  RETURN_IF_NOT_OK(WaitUntil(
+    lck, [this, epoch]() { return epoch_ >= epoch; }, "epoch " + std::to_string(epoch) + " to start"));
+  CHECK_FAIL_RETURN_UNEXPECTED(epoch_ == epoch, "ShuffleExchange: epoch " + std::to_string(epoch) +
+                                                  " is over, the exchange is in epoch " + std::to_string(epoch_));
+  return Status::OK();
+}
+
+Status LocalShuffleExchange::Exchange(int32_t rank, int64_t epoch, TensorTable *rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  CHECK_FAIL_RETURN_UNEXPECTED(rank >= 0 && rank < num_ranks_, "ShuffleExchange: invalid rank " + std::to_string(rank));
+  std::unique_lock<std::mutex> lck(mux_);
+  RETURN_IF_NOT_OK(WaitForEpoch(&lck, epoch));
+  CHECK_FAIL_RETURN_UNEXPECTED(active_[rank], "ShuffleExchange: rank " + std::to_string(rank) + " has left the epoch.");
+  batches_[rank] = std::move(*rows);
+  auto my_round = round_;
+  // The last one to put in a batch deals the round
+  if (static_cast<int32_t>(batches_.size()) == num_active_) {
+    DealRound();
+    cv_.NotifyAll();
+  } else {
+    RETURN_IF_NOT_OK(WaitUntil(
+      &lck, [this, my_round]() { return round_ != my_round; }, "the other ranks to join the round"));
+  }
+  auto it = dealt_.find(rank);
+  CHECK_FAIL_RETURN_UNEXPECTED(it != dealt_.end(), "ShuffleExchange: no batch dealt to rank " + std::to_string(rank));
+  *rows = std::move(it->second);
+  dealt_.erase(it);
+  return Status::OK();
+}
+
+Status LocalShuffleExchange::Leave(int32_t rank, int64_t epoch) {
+  CHECK_FAIL_RETURN_UNEXPECTED(rank >= 0 && rank < num_ranks_, "ShuffleExchange: invalid rank " + std::to_string(rank));
+  std::unique_lock<std::mutex> lck(mux_);
+  RETURN_IF_NOT_OK(WaitForEpoch(&lck, epoch));
+  CHECK_FAIL_RETURN_UNEXPECTED(active_[rank], "ShuffleExchange: rank " + std::to_string(rank) + " has left the epoch.");
+  active_[rank] = false;
+  --num_active_;
+  if (num_active_ == 0) {
+    // Everyone is done with this epoch. Let the ranks waiting for the next one in.
+    std::fill(active_.begin(), active_.end(), true);
+    num_active_ = num_ranks_;
+    ++epoch_;
+    cv_.NotifyAll();
+  } else if (!batches_.empty() && static_cast<int32_t>(batches_.size()) == num_active_) {
+    // The ranks left are all waiting for the round
+    DealRound();
+    cv_.NotifyAll();
+  }
+  return Status::OK();
+}
+
+void LocalShuffleExchange::Abort(int32_t rank, const Status &rc) {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (abort_rc_.IsError()) {
+    return;
+  }
+  MS_LOG(WARNING) << "ShuffleExchange is aborted by rank " << rank << ": " << rc.ToString();
+  abort_rc_ = rc.IsError() ? rc : Status(StatusCode::kMDUnexpectedError, "ShuffleExchange is aborted");
+  cv_.NotifyAll();
+}
+
+void LocalShuffleExchange::DealRound() {
+  std::vector<int32_t> from;
+  from.reserve(batches_.size());
+  for (auto &it : batches_) {
+    from.push_back(it.first);
+  }
+  std::vector<int32_t> to(from);
+  std::shuffle(to.begin(), to.end(), rng_);
+  for (size_t i = 0; i < from.size(); ++i) {
+    dealt_[to[i]] = std::move(batches_[from[i]]);
+  }
+  batches_.clear();
+  ++round_;
+  MS_LOG(DEBUG) << "ShuffleExchange dealt round " << round_ << " of epoch " << epoch_ << " to " << from.size()
+                << " ranks.";
+}
+
+namespace {
+// The messages between rank 0 and the other ranks. Each one is a header followed by a payload of the given length.
+enum MsgType : int32_t { kMsgHello, kMsgExchange, kMsgLeave, kMsgAbort, kMsgClose, kMsgReply };
+
+struct MsgHeader {
+  int32_t type;
+  int32_t rank;   // The rank sending the call, or the one the reply is for
+  int64_t value;  // The epoch of a call, the number of ranks of a hello, the status code of an abort or a reply
+  int64_t len;    // The length of the payload: the rows of an exchange, or the error message
+};
+
+const char kTcpScheme[] = "tcp://";
+// How long a rank waits before it tries again to connect to rank 0
+constexpr std::chrono::milliseconds kConnectRetryInterval = std::chrono::milliseconds(100);
+
+template <typename T>
+void PutValue(const T &value, std::string *buf) {
+  buf->append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+Status GetValue(const std::string &buf, size_t *pos, T *value) {
+  CHECK_FAIL_RETURN_UNEXPECTED(*pos + sizeof(T) <= buf.size(), "ShuffleExchange: truncated message.");
+  memcpy(value, buf.data() + *pos, sizeof(T));
+  *pos += sizeof(T);
+  return Status::OK();
+}
+
+// Write the id and the tensors of every row. A tensor is its type, its shape and the bytes of its buffer.
+void SerializeRows(const TensorTable &rows, std::string *buf) {
+  PutValue<int64_t>(rows.size(), buf);
+  for (const auto &row : rows) {
+    PutValue<int64_t>(row.getId(), buf);
+    PutValue<int64_t>(row.size(), buf);
+    for (const auto &tensor : row) {
+      PutValue<uint8_t>(tensor->type().value(), buf);
+      auto dims = tensor->shape().AsVector();
+      PutValue<int64_t>(dims.size(), buf);
+      for (auto dim : dims) {
+        PutValue<int64_t>(dim, buf);
+      }
+      int64_t num_bytes = tensor->SizeInBytes();
+      PutValue(num_bytes, buf);
+      if (num_bytes > 0) {
+        buf->append(reinterpret_cast<const char *>(tensor->GetBuffer()), num_bytes);
+      }
+    }
+  }
+}
+
+Status DeserializeRows(const std::string &buf, TensorTable *rows) {
+  size_t pos = 0;
+  int64_t num_rows = 0;
+  RETURN_IF_NOT_OK(GetValue(buf, &pos, &num_rows));
+  rows->clear();
+  rows->reserve(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    int64_t id = 0;
+    int64_t num_tensors = 0;
+    RETURN_IF_NOT_OK(GetValue(buf, &pos, &id));
+    RETURN_IF_NOT_OK(GetValue(buf, &pos, &num_tensors));
+    TensorRow row;
+    row.setId(id);
+    for (int64_t j = 0; j < num_tensors; ++j) {
+      uint8_t type = 0;
+      int64_t rank = 0;
+      RETURN_IF_NOT_OK(GetValue(buf, &pos, &type));
+      RETURN_IF_NOT_OK(GetValue(buf, &pos, &rank));
+      std::vector<dsize_t> dims(rank);
+      for (auto &dim : dims) {
+        RETURN_IF_NOT_OK(GetValue(buf, &pos, &dim));
+      }
+      int64_t num_bytes = 0;
+      RETURN_IF_NOT_OK(GetValue(buf, &pos, &num_bytes));
+      CHECK_FAIL_RETURN_UNEXPECTED(num_bytes >= 0 && pos + num_bytes <= buf.size(),
+                                   "ShuffleExchange: truncated message.");
+      std::shared_ptr<Tensor> tensor;
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(TensorShape(dims), DataType(static_cast<DataType::Type>(type)),
+                                                reinterpret_cast<const uchar *>(buf.data() + pos), num_bytes, &tensor));
+      pos += num_bytes;
+      row.push_back(std::move(tensor));
+    }
+    rows->push_back(std::move(row));
+  }
+  return Status::OK();
+}
+
+#if !defined(_WIN32) && !defined(_WIN64)
+// A rank which is gone must not kill this one with a SIGPIPE
+#ifdef MSG_NOSIGNAL
+constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+constexpr int kSendFlags = 0;
+#endif
+
+std::string ErrnoString() { return std::string(strerror(errno)); }
+
+Status SendAll(int fd, const char *data, size_t len) {
+  while (len > 0) {
+    auto n = send(fd, data, len, kSendFlags);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(n > 0, "ShuffleExchange: failed to send to the other rank: " + ErrnoString());
+    data += n;
+    len -= n;
+  }
+  return Status::OK();
+}
+
+Status RecvAll(int fd, char *data, size_t len) {
+  while (len > 0) {
+    auto n = recv(fd, data, len, 0);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(n != 0, "ShuffleExchange: the other rank closed the connection.");
+    CHECK_FAIL_RETURN_UNEXPECTED(n > 0, "ShuffleExchange: failed to receive from the other rank: " + ErrnoString());
+    data += n;
+    len -= n;
+  }
+  return Status::OK();
+}
+
+// Wait at most the timeout for the next message on the socket, or forever if it is zero
+Status SetRecvTimeout(int fd, std::chrono::milliseconds timeout) {
+  struct timeval tv {};
+  tv.tv_sec = timeout.count() / 1000;
+  tv.tv_usec = (timeout.count() % 1000) * 1000;
+  CHECK_FAIL_RETURN_UNEXPECTED(setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)) == 0,
+                               "ShuffleExchange: failed to set the receive timeout: " + ErrnoString());
+  return Status::OK();
+}
+
+// Open a socket bound to the address, listening if passive and connected otherwise
+Status OpenSocket(const std::string &host, int32_t port, bool passive, int *out) {
+  struct addrinfo hints {};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = passive ? AI_PASSIVE : 0;
+  struct addrinfo *addrs = nullptr;
+  int rc = getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addrs);
+  CHECK_FAIL_RETURN_UNEXPECTED(rc == 0, "ShuffleExchange: invalid address " + host + ":" + std::to_string(port) +
+                                          ": " + gai_strerror(rc));
+  std::string err_msg;
+  int fd = -1;
+  for (auto addr = addrs; addr != nullptr && fd < 0; addr = addr->ai_next) {
+    fd = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if (fd < 0) {
+      err_msg = ErrnoString();
+      continue;
+    }
+    int on = 1;
+    bool ok = passive ? setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) == 0 &&
+                          bind(fd, addr->ai_addr, addr->ai_addrlen) == 0 && listen(fd, SOMAXCONN) == 0
+                      : connect(fd, addr->ai_addr, addr->ai_addrlen) == 0;
+    if (!ok) {
+      err_msg = ErrnoString();
+      close(fd);
+      fd = -1;
+    }
+  }
+  freeaddrinfo(addrs);
+  std::string action = passive ? "listen on " : "connect to ";
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    fd >= 0, "ShuffleExchange: failed to " + action + host + ":" + std::to_string(port) + ": " + err_msg);
+  if (!passive) {
+    // The rounds are small messages waiting for their replies
+    int on = 1;
+    (void)setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  }
+  *out = fd;
+  return Status::OK();
+}
+
+int AcceptSocket(int fd) {
+  int conn = -1;
+  do {
+    conn = accept(fd, nullptr, nullptr);
+  } while (conn < 0 && errno == EINTR);
+  if (conn >= 0) {
+    int on = 1;
+    (void)setsockopt(conn, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+  }
+  return conn;
+}
+
+// Wake up the threads blocked on the socket
+void ShutdownSocket(int fd) { (void)shutdown(fd, SHUT_RDWR); }
+
+void CloseSocket(int fd) { (void)close(fd); }
+#else
+Status SendAll(int fd, const char *data, size_t len) {
+  RETURN_STATUS_UNEXPECTED("ShuffleExchange: TCP is not supported on Windows.");
+}
+
+Status RecvAll(int fd, char *data, size_t len) {
+  RETURN_STATUS_UNEXPECTED("ShuffleExchange: TCP is not supported on Windows.");
+}
+
+Status SetRecvTimeout(int fd, std::chrono::milliseconds timeout) { return Status::OK(); }
+
+Status OpenSocket(const std::string &host, int32_t port, bool passive, int *out) {
+  RETURN_STATUS_UNEXPECTED("ShuffleExchange: ranks in separate processes are not supported on Windows.");
+}
+
+int AcceptSocket(int fd) { return -1; }
+
+void ShutdownSocket(int fd) {}
+
+void CloseSocket(int fd) {}
+#endif
+
+Status SendMsg(int fd, int32_t type, int32_t rank, int64_t value, const std::string &payload) {
+  MsgHeader hdr{type, rank, value, static_cast<int64_t>(payload.size())};
+  RETURN_IF_NOT_OK(SendAll(fd, reinterpret_cast<const char *>(&hdr), sizeof(hdr)));
+  return SendAll(fd, payload.data(), payload.size());
+}
+
+Status RecvMsg(int fd, MsgHeader *hdr, std::string *payload) {
+  RETURN_IF_NOT_OK(RecvAll(fd, reinterpret_cast<char *>(hdr), sizeof(*hdr)));
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr->len >= 0, "ShuffleExchange: invalid message.");
+  payload->resize(hdr->len);
+  return RecvAll(fd, &(*payload)[0], payload->size());
+}
+
+// Reply to a call with its status, followed by the rows dealt if it is an exchange which succeeded
+Status SendReply(int fd, int32_t rank, const Status &rc, const TensorTable *rows) {
+  std::string payload;
+  if (rc.IsError()) {
+    payload = rc.GetErrDescription();
+  } else if (rows != nullptr) {
+    SerializeRows(*rows, &payload);
+  }
+  return SendMsg(fd, kMsgReply, rank, static_cast<int64_t>(rc.StatusCode()), payload);
+}
+}  // namespace
+
+TcpShuffleExchange::TcpShuffleExchange(const std::string &host, int32_t port, int32_t num_ranks, int32_t rank,
+                                       uint32_t seed, std::chrono::milliseconds timeout)
+    : ShuffleExchange(num_ranks),
+      host_(host),
+      port_(port),
+      rank_(rank),
+      seed_(seed),
+      timeout_(timeout),
+      started_(false),
+      fd_(-1),
+      stopping_(false),
+      rank_fds_(num_ranks, -1),
+      num_open_(0) {}
+
+TcpShuffleExchange::~TcpShuffleExchange() {
+  std::unique_lock<std::mutex> lck(mux_);
+  if (rank_ != 0) {
+    if (fd_ >= 0) {
+      (void)SendMsg(fd_, kMsgClose, rank_, 0, "");
+      CloseSocket(fd_);
+    }
+    return;
+  }
+  stopping_ = true;
+  if (fd_ >= 0) {
+    // Stop accepting ranks
+    ShutdownSocket(fd_);
+  }
+  // The other ranks may still be in their last epoch
+  if (!closed_cv_.wait_for(lck, timeout_, [this]() { return num_open_ == 0; })) {
+    MS_LOG(WARNING) << "ShuffleExchange: " << num_open_ << " ranks did not close the exchange in time.";
+    for (auto fd : rank_fds_) {
+      if (fd >= 0) {
+        ShutdownSocket(fd);
+      }
+    }
+  }
+  lck.unlock();
+  Status rc = vg_.join_all(Task::WaitFlag::kBlocking);
+  if (rc.IsError()) {
+    MS_LOG(WARNING) << "ShuffleExchange: " << rc.ToString();
+  }
+  if (fd_ >= 0) {
+    CloseSocket(fd_);
+  }
+}
+
+bool TcpShuffleExchange::ParseGroup(const std::string &group, std::string *host, int32_t *port) {
+  const std::string scheme(kTcpScheme);
+  if (group.compare(0, scheme.size(), scheme) != 0) {
+    return false;
+  }
+  auto sep = group.rfind(':');
+  if (sep == std::string::npos || sep < scheme.size()) {
+    return false;
+  }
+  *host = group.substr(scheme.size(), sep - scheme.size());
+  try {
+    *port = std::stoi(group.substr(sep + 1));
+  } catch (const std::exception &) {
+    return false;
+  }
+  return !host->empty() && *port > 0 && *port < 65536;
+}
+
+Status TcpShuffleExchange::Start() {
+  std::unique_lock<std::mutex> lck(start_mux_);
+  if (!started_) {
+    started_ = true;
+    start_rc_ = rank_ == 0 ? Listen() : Connect();
+  }
+  return start_rc_;
+}
+
+Status TcpShuffleExchange::Listen() {
+  std::unique_lock<std::mutex> lck(mux_);
+  local_ = std::make_shared<LocalShuffleExchange>(num_ranks_, seed_, timeout_);
+  RETURN_IF_NOT_OK(OpenSocket(host_, port_, true, &fd_));
+  RETURN_IF_NOT_OK(vg_.CreateAsyncTask("ShuffleExchange accept", std::bind(&TcpShuffleExchange::AcceptRanks, this)));
+  MS_LOG(INFO) << "ShuffleExchange: rank 0 is listening on " << host_ << ":" << port_ << ".";
+  return Status::OK();
+}
+
+Status TcpShuffleExchange::Connect() {
+  std::unique_lock<std::mutex> lck(mux_);
+  // Rank 0 may not be listening yet
+  auto deadline = std::chrono::steady_clock::now() + timeout_;
+  Status rc;
+  do {
+    rc = OpenSocket(host_, port_, false, &fd_);
+    if (rc.IsOk()) {
+      break;
+    }
+    std::this_thread::sleep_for(kConnectRetryInterval);
+  } while (std::chrono::steady_clock::now() < deadline);
+  RETURN_IF_NOT_OK(rc);
+  // Rank 0 replies to a call once the round is dealt, or with an error once its own wait times out
+  RETURN_IF_NOT_OK(SetRecvTimeout(fd_, timeout_ * 2));
+  return Call(kMsgHello, num_ranks_, nullptr);
+}
+
+Status TcpShuffleExchange::AcceptRanks() {
+  TaskManager::FindMe()->Post();
+  for (int32_t num_accepted = 0; num_accepted < num_ranks_ - 1;) {
+    int fd = AcceptSocket(fd_);
+    if (fd < 0) {
+      std::unique_lock<std::mutex> lck(mux_);
+      if (!stopping_) {
+        local_->Abort(rank_, Status(StatusCode::kMDUnexpectedError, "ShuffleExchange: failed to accept a rank."));
+      }
+      return Status::OK();
+    }
+    MsgHeader hdr{};
+    std::string payload;
+    Status rc = SetRecvTimeout(fd, timeout_);
+    if (rc.IsOk()) {
+      rc = RecvMsg(fd, &hdr, &payload);
+    }
+    if (rc.IsOk()) {
+      rc = SetRecvTimeout(fd, std::chrono::milliseconds(0));
+    }
+    std::unique_lock<std::mutex> lck(mux_);
+    if (stopping_) {
+      CloseSocket(fd);
+      return Status::OK();
+    }
+    if (rc.IsOk() && (hdr.type != kMsgHello || hdr.value != num_ranks_ || hdr.rank <= 0 || hdr.rank >= num_ranks_ ||
+                      rank_fds_[hdr.rank] >= 0)) {
+      rc = Status(StatusCode::kMDUnexpectedError,
+                  "ShuffleExchange: rank " + std::to_string(hdr.rank) + " of " + std::to_string(hdr.value) +
+                    " ranks can not join the group of " + std::to_string(num_ranks_) + " ranks.");
+    }
+    (void)SendReply(fd, hdr.rank, rc, nullptr);
+    if (rc.IsError()) {
+      // The ranks are not started the same way, so the others would wait for nothing
+      CloseSocket(fd);
+      local_->Abort(rank_, rc);
+      return Status::OK();
+    }
+    rank_fds_[hdr.rank] = fd;
+    ++num_open_;
+    ++num_accepted;
+    RETURN_IF_NOT_OK(vg_.CreateAsyncTask("ShuffleExchange rank " + std::to_string(hdr.rank),
+                                         std::bind(&TcpShuffleExchange::ServeRank, this, hdr.rank, fd)));
+  }
+  return Status::OK();
+}
+
+Status TcpShuffleExchange::ServeRank(int32_t rank, int fd) {
+  TaskManager::FindMe()->Post();
+  Status rc;
+  bool left = false;  // Whether the last call of the rank was to leave an epoch
+  while (true) {
+    MsgHeader hdr{};
+    std::string payload;
+    rc = RecvMsg(fd, &hdr, &payload);
+    if (rc.IsError() || hdr.type == kMsgClose) {
+      break;
+    }
+    if (hdr.type == kMsgExchange) {
+      TensorTable rows;
+      rc = DeserializeRows(payload, &rows);
+      if (rc.IsOk()) {
+        rc = local_->Exchange(rank, hdr.value, &rows);
+      }
+      left = false;
+      rc = SendReply(fd, rank, rc, &rows);
+    } else if (hdr.type == kMsgLeave) {
+      left = true;
+      rc = SendReply(fd, rank, local_->Leave(rank, hdr.value), nullptr);
+    } else if (hdr.type == kMsgAbort) {
+      local_->Abort(rank, Status(static_cast<StatusCode>(hdr.value), payload));
+    }
+    if (rc.IsError()) {
+      break;
+    }
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  if (rc.IsError() && !stopping_ && !left) {
+    // The rank is gone in the middle of an epoch, so the others would wait for it. A rank gone between two epochs
+    // may just be done, a later epoch needing it times out.
+    local_->Abort(rank, Status(StatusCode::kMDUnexpectedError,
+                               "ShuffleExchange: lost rank " + std::to_string(rank) + ". " + rc.GetErrDescription()));
+  }
+  CloseSocket(fd);
+  rank_fds_[rank] = -1;
+  --num_open_;
+  closed_cv_.notify_all();
+  return Status::OK();
+}
+
+Status TcpShuffleExchange::Call(int32_t type, int64_t value, TensorTable *rows) {
+  std::string payload;
+  if (type == kMsgExchange) {
+    SerializeRows(*rows, &payload);
+  }
+  RETURN_IF_NOT_OK(SendMsg(fd_, type, rank_, value, payload));
+  MsgHeader hdr{};
+  RETURN_IF_NOT_OK(RecvMsg(fd_, &hdr, &payload));
+  CHECK_FAIL_RETURN_UNEXPECTED(hdr.type == kMsgReply, "ShuffleExchange: invalid reply from rank 0.");
+  auto code = static_cast<StatusCode>(hdr.value);
+  if (code != StatusCode::kSuccess) {
+    return Status(code, payload);
+  }
+  if (type == kMsgExchange) {
+    RETURN_IF_NOT_OK(DeserializeRows(payload, rows));
+  }
+  return Status::OK();
+}
+
+Status TcpShuffleExchange::Exchange(int32_t rank, int64_t epoch, TensorTable *rows) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  CHECK_FAIL_RETURN_UNEXPECTED(rank == rank_, "ShuffleExchange: invalid rank " + std::to_string(rank));
+  RETURN_IF_NOT_OK(Start());
+  if (rank_ == 0) {
+    return local_->Exchange(rank, epoch, rows);
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  return Call(kMsgExchange, epoch, rows);
+}
+
+Status TcpShuffleExchange::Leave(int32_t rank, int64_t epoch) {
+  CHECK_FAIL_RETURN_UNEXPECTED(rank == rank_, "ShuffleExchange: invalid rank " + std::to_string(rank));
+  RETURN_IF_NOT_OK(Start());
+  if (rank_ == 0) {
+    return local_->Leave(rank, epoch);
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  return Call(kMsgLeave, epoch, nullptr);
+}
+
+void TcpShuffleExchange::Abort(int32_t rank, const Status &rc) {
+  std::unique_lock<std::mutex> start_lck(start_mux_);
+  if (!started_ || start_rc_.IsError()) {
+    // The other ranks give up waiting for this one after the timeout
+    return;
+  }
+  start_lck.unlock();
+  if (rank_ == 0) {
+    local_->Abort(rank, rc);
+    return;
+  }
+  std::unique_lock<std::mutex> lck(mux_);
+  Status err = rc.IsError() ? rc : Status(StatusCode::kMDUnexpectedError, "ShuffleExchange is aborted");
+  (void)SendMsg(fd_, kMsgAbort, rank_, static_cast<int64_t>(err.StatusCode()), err.GetErrDescription());
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,199 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_EXCHANGE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_EXCHANGE_H_
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/cond_var.h"
+#include "minddata/dataset/util/status.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A meeting point where the shuffle ops of data parallel ranks swap rows.
+/// \details A shuffle op only mixes the rows which are in its buffer at the same time, and each rank only sees
+///     its own shard. By swapping part of their buffers with each other, the ranks get close to a global shuffle
+///     while every buffer keeps its size.
+///     Rows are swapped in rounds. A round is dealt once every rank still in the epoch has put in a batch. The
+///     batches are dealt by a random permutation of the ranks, so each rank gets back as many rows as it put in
+///     and the number of rows of a rank in an epoch is unchanged. A rank leaves the epoch when it runs out of
+///     input, and the next epoch starts once all the ranks have left.
+///     A rank which stops on an error aborts the exchange, so the other ranks do not wait for it forever.
+class ShuffleExchange {
+ public:
+  explicit ShuffleExchange(int32_t num_ranks) : num_ranks_(num_ranks) {}
+
+  virtual ~ShuffleExchange() = default;
+
+  /// \brief Swap a batch of rows with the other ranks. It blocks until the round is dealt.
+  /// \param rank The rank of the caller
+  /// \param epoch The epoch the caller is in, counted from 0. It waits for the other ranks to finish the epoch before.
+  /// \param[in,out] rows The batch put in, replaced with the batch dealt to the caller
+  /// \return Status object
+  virtual Status Exchange(int32_t rank, int64_t epoch, TensorTable *rows) = 0;
+
+  /// \brief Stop taking part in the rounds of an epoch
+  /// \param rank The rank of the caller
+  /// \param epoch The epoch the caller is in
+  /// \return Status object
+  virtual Status Leave(int32_t rank, int64_t epoch) = 0;
+
+  /// \brief Fail the exchange for all the ranks. The ranks waiting and all the later calls return the error.
+  /// \param rank The rank of the caller
+  /// \param rc The error which stopped the caller
+  virtual void Abort(int32_t rank, const Status &rc) = 0;
+
+  int32_t NumRanks() const { return num_ranks_; }
+
+ protected:
+  int32_t num_ranks_;
+};
+
+/// \brief An exchange between ranks whose pipelines run in the same process, meeting through its memory.
+class LocalShuffleExchange : public ShuffleExchange {
+ public:
+  /// \brief Constructor
+  /// \param num_ranks The number of ranks in the group
+  /// \param seed The seed of the permutations which deal the rounds
+  /// \param timeout How long a rank waits for the others before it gives up with an error
+  LocalShuffleExchange(int32_t num_ranks, uint32_t seed, std::chrono::milliseconds timeout = kDefaultTimeout);
+
+  ~LocalShuffleExchange() override = default;
+
+  Status Exchange(int32_t rank, int64_t epoch, TensorTable *rows) override;
+
+  Status Leave(int32_t rank, int64_t epoch) override;
+
+  void Abort(int32_t rank, const Status &rc) override;
+
+  /// \brief Get the exchange of a group of ranks, and create it for the first rank asking for it
+  /// \param group The name of the group
+  /// \param num_ranks The number of ranks in the group
+  /// \param seed The seed of the permutations which deal the rounds
+  /// \param[out] out The exchange
+  /// \return Status object
+  static Status GetOrCreate(const std::string &group, int32_t num_ranks, uint32_t seed,
+                            std::shared_ptr<ShuffleExchange> *out);
+
+  // A rank may have to wait for the slowest rank to fill a batch, so the default is generous
+  static constexpr std::chrono::milliseconds kDefaultTimeout = std::chrono::minutes(10);
+
+ private:
+  // Wait until the predicate holds. It fails if the exchange is aborted or the wait times out. The lock must be held.
+  Status WaitUntil(std::unique_lock<std::mutex> *lck, const std::function<bool()> &pred, const std::string &what);
+
+  // Wait until the given epoch has started
+  Status WaitForEpoch(std::unique_lock<std::mutex> *lck, int64_t epoch);
+
+  // Deal the batches put in to the ranks which put them in. The lock must be held.
+  void DealRound();
+
+  std::mutex mux_;
+  CondVar cv_;
+  std::mt19937_64 rng_;
+  std::chrono::milliseconds timeout_;
+  Status abort_rc_;  // The error which aborted the exchange, OK while it is running
+  int64_t epoch_;
+  std::vector<bool> active_;  // The ranks which have not left the current epoch
+  int32_t num_active_;
+  int64_t round_;                          // Number of rounds dealt
+  std::map<int32_t, TensorTable> batches_;  // The batches put in for the next round, keyed by rank
+  std::map<int32_t, TensorTable> dealt_;    // The batches dealt, keyed by the rank they are dealt to
+};
+
+/// \brief An exchange between ranks whose pipelines run in separate processes, possibly on separate hosts.
+/// \details Rank 0 hosts the rounds. It listens on the address of the group and deals the rounds through a
+///     LocalShuffleExchange on behalf of the other ranks, which connect to it over TCP and forward their calls.
+///     The rows are sent as the raw bytes of their tensors, so all the ranks must have the same byte order.
+///     The sockets are only opened by the first call, so a pipeline which is built but never run does not take
+///     the port. A rank whose connection drops before it closes the exchange aborts it.
+class TcpShuffleExchange : public ShuffleExchange {
+ public:
+  /// \brief Constructor
+  /// \param host The host of rank 0
+  /// \param port The port rank 0 listens on
+  /// \param num_ranks The number of ranks in the group
+  /// \param rank The rank of this process
+  /// \param seed The seed of the permutations which deal the rounds. Only the one of rank 0 is used.
+  /// \param timeout How long a rank waits for the others, including the time to connect to rank 0
+  TcpShuffleExchange(const std::string &host, int32_t port, int32_t num_ranks, int32_t rank, uint32_t seed,
+                     std::chrono::milliseconds timeout = LocalShuffleExchange::kDefaultTimeout);
+
+  /// \brief Destructor. Rank 0 keeps serving the other ranks until they close the exchange or the timeout passes.
+  ~TcpShuffleExchange() override;
+
+  Status Exchange(int32_t rank, int64_t epoch, TensorTable *rows) override;
+
+  Status Leave(int32_t rank, int64_t epoch) override;
+
+  void Abort(int32_t rank, const Status &rc) override;
+
+  /// \brief Parse the name of a group of ranks in separate processes
+  /// \param group The name of the group, in the form tcp://host:port
+  /// \param[out] host The host of rank 0
+  /// \param[out] port The port rank 0 listens on
+  /// \return True if the group is in that form, false for the name of a group in the same process
+  static bool ParseGroup(const std::string &group, std::string *host, int32_t *port);
+
+ private:
+  // Listen on the port on rank 0, or connect to rank 0 on the others. Only the first call does it.
+  Status Start();
+
+  // Bind the port and start accepting the other ranks
+  Status Listen();
+
+  // Connect to rank 0, retrying until it listens or the timeout passes
+  Status Connect();
+
+  // Task of rank 0 which accepts the connection of every other rank
+  Status AcceptRanks();
+
+  // Task of rank 0 which serves the calls of another rank until it closes the exchange
+  Status ServeRank(int32_t rank, int fd);
+
+  // Forward a call to rank 0 and wait for its reply. The connection lock must be held.
+  Status Call(int32_t type, int64_t value, TensorTable *rows);
+
+  std::string host_;
+  int32_t port_;
+  int32_t rank_;
+  uint32_t seed_;
+  std::chrono::milliseconds timeout_;
+  std::mutex start_mux_;
+  bool started_;
+  Status start_rc_;
+  std::mutex mux_;
+  int fd_;  // The listening socket on rank 0, the connection to rank 0 on the others
+  // Rank 0 only
+  std::shared_ptr<LocalShuffleExchange> local_;
+  bool stopping_;
+  TaskGroup vg_;
+  std::vector<int> rank_fds_;  // The connections of the other ranks, -1 once closed
+  int32_t num_open_;
+  std::condition_variable closed_cv_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SHUFFLE_EXCHANGE_H_
@@ -38,7 +38,12 @@ constexpr int32_t ShuffleOp::kShuffleStateActive;
 constexpr int32_t ShuffleOp::kShuffleStateDrain;
 
 // Builder constructor. Creates the builder object.
-ShuffleOp::Builder::Builder() : build_shuffle_size_(0), build_reshuffle_each_epoch_(true) {
+ShuffleOp::Builder::Builder()
+    : build_shuffle_size_(0),
+      build_reshuffle_each_epoch_(true),
+      build_exchange_(nullptr),
+      build_rank_(0),
+      build_exchange_size_(0) {
   std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
   build_op_connector_size_ = cfg->op_connector_size();
   build_shuffle_seed_ = GetSeed();
@@ -48,6 +53,15 @@ Status ShuffleOp::Builder::SanityCheck() const {
   if (build_shuffle_size_ < 2) {
     RETURN_STATUS_UNEXPECTED("Invalid parameter, shuffle buffer size must be greater than 1.");
   }
+  if (build_exchange_ != nullptr) {
+    if (build_rank_ < 0 || build_rank_ >= build_exchange_->NumRanks()) {
+      RETURN_STATUS_UNEXPECTED("Invalid parameter, rank must be in range [0, " +
+                               std::to_string(build_exchange_->NumRanks() - 1) + "].");
+    }
+    if (build_exchange_size_ < 1 || build_exchange_size_ > build_shuffle_size_) {
+      RETURN_STATUS_UNEXPECTED("Invalid parameter, exchange size must be in range [1, shuffle buffer size].");
+    }
+  }
   return Status::OK();
 }
 
@@ -55,12 +69,13 @@ Status ShuffleOp::Builder::SanityCheck() const {
 Status ShuffleOp::Builder::Build(std::shared_ptr<ShuffleOp> *ptr) {
   RETURN_IF_NOT_OK(SanityCheck());
   *ptr = std::make_shared<ShuffleOp>(build_shuffle_size_, build_shuffle_seed_, build_op_connector_size_,
-                                     build_reshuffle_each_epoch_);
+                                     build_reshuffle_each_epoch_, build_exchange_, build_rank_, build_exchange_size_);
   return Status::OK();
 }
 
 // Constructor of the ShuffleOp
-ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch)
+ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
+                     std::shared_ptr<ShuffleExchange> exchange, int32_t rank, int32_t exchange_size)
     : PipelineOp(op_connector_size),
       shuffle_size_(shuffle_size),
       shuffle_seed_(shuffle_seed),
@@ -68,7 +83,12 @@ ShuffleOp::ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_con
       rng_(shuffle_seed),
       shuffle_buffer_(std::make_unique<TensorTable>()),
       shuffle_last_row_idx_(0),
-      shuffle_buffer_state_(kShuffleStateInit) {}
+      shuffle_buffer_state_(kShuffleStateInit),
+      exchange_(std::move(exchange)),
+      rank_(rank),
+      exchange_size_(exchange_size),
+      exchange_epoch_(0),
+      rows_since_exchange_(0) {}
 
 // Private function to re-init the shuffle op for another epoch.  Shuffle op calls this by
 // itself rather than waiting for the reset driven from operators above it in the pipeline.
@@ -85,6 +105,8 @@ Status ShuffleOp::SelfReset() {
   shuffle_buffer_ = std::make_unique<TensorTable>();
   shuffle_last_row_idx_ = 0;
   shuffle_buffer_state_ = kShuffleStateInit;
+  exchange_epoch_++;
+  rows_since_exchange_ = 0;
   return Status::OK();
 }
 
@@ -94,7 +116,11 @@ void ShuffleOp::Print(std::ostream &out, bool show_all) const {
     // Call the super class for displaying any common 1-liner info
     PipelineOp::Print(out, show_all);
     // Then show any custom derived-internal 1-liner info for this op
-    out << " [shuffle size: " << shuffle_size_ << "]\n";
+    out << " [shuffle size: " << shuffle_size_ << "]";
+    if (exchange_ != nullptr) {
+      out << " [rank: " << rank_ << " of " << exchange_->NumRanks() << "]";
+    }
+    out << "\n";
   } else {
     // Call the super class for displaying any common detailed info
     PipelineOp::Print(out, show_all);
@@ -129,8 +155,6 @@ Status ShuffleOp::AddRowToShuffleBuffer(TensorRow new_shuffle_row) {
 // All dataset ops operate by launching a thread (see ExecutionTree). This class functor will
 // provide the master loop that drives the logic for performing the work
 Status ShuffleOp::operator()() {
-  std::unique_ptr<TensorQTable> new_buffer_table;  // A tensor table to be used for output.
-
   // Synchronize with TaskManager once the thread is launched.
   TaskManager::FindMe()->Post();
 
@@ -140,6 +164,18 @@ Status ShuffleOp::operator()() {
   int32_t child_idx = 0;
   child_iterator_ = std::make_unique<ChildIterator>(this, worker_id, child_idx);
 
+  Status rc = ShuffleRows();
+  // Whether it is an error or the pipeline being stopped, the other ranks must not wait for this one any more
+  if (rc.IsError() && exchange_ != nullptr) {
+    exchange_->Abort(rank_, rc);
+  }
+  return rc;
+}
+
+// Private function with the main loop of the op, which shuffles the rows of every epoch
+Status ShuffleOp::ShuffleRows() {
+  std::unique_ptr<TensorQTable> new_buffer_table;  // A tensor table to be used for output.
+
   // Main operator loop
   while (true) {
     // Do an initial populate of the shuffle buffer
@@ -189,8 +225,12 @@ Status ShuffleOp::operator()() {
 
         if (!new_row.empty()) {
           RETURN_IF_NOT_OK(AddRowToShuffleBuffer(std::move(new_row)));
+          // Once enough new rows have come in, swap some of the buffer with the other ranks
+          if (exchange_ != nullptr && ++rows_since_exchange_ >= exchange_size_) {
+            RETURN_IF_NOT_OK(ExchangeRows());
+          }
         } else {
-          shuffle_buffer_state_ = kShuffleStateDrain;
+          RETURN_IF_NOT_OK(StartDrain());
         }
       }
 
@@ -263,13 +303,45 @@ Status ShuffleOp::InitShuffleBuffer() {
   } else {
     // If init phase doesn't have more rows, then skip the active state and jump straight to the
     // shuffle buffer draining state
-    shuffle_buffer_state_ = kShuffleStateDrain;
+    RETURN_IF_NOT_OK(StartDrain());
   }
 
   MS_LOG(DEBUG) << "Shuffle operator finished initializing the shuffle buffer.";
   return Status::OK();
 }
 
+// Private function to swap rows picked at random from the full shuffle buffer with the other ranks
+Status ShuffleOp::ExchangeRows() {
+  rows_since_exchange_ = 0;
+  // Move the rows picked to the front of the buffer. The position of a row in the buffer does not matter since
+  // the rows are drained from random slots.
+  auto num_rows = static_cast<int64_t>(shuffle_last_row_idx_) + 1;
+  TensorTable batch;
+  batch.reserve(exchange_size_);
+  for (int64_t i = 0; i < exchange_size_; ++i) {
+    int64_t random_slot = i + static_cast<int64_t>(rng_() % (num_rows - i));
+    std::swap((*shuffle_buffer_)[i], (*shuffle_buffer_)[random_slot]);
+    batch.push_back(std::move((*shuffle_buffer_)[i]));
+  }
+  RETURN_IF_NOT_OK(exchange_->Exchange(rank_, exchange_epoch_, &batch));
+  CHECK_FAIL_RETURN_UNEXPECTED(batch.size() == static_cast<size_t>(exchange_size_),
+                               "Shuffle exchange returned " + std::to_string(batch.size()) + " rows, but " +
+                                 std::to_string(exchange_size_) + " were sent. Exchange size differs between ranks.");
+  for (int64_t i = 0; i < exchange_size_; ++i) {
+    (*shuffle_buffer_)[i] = std::move(batch[i]);
+  }
+  return Status::OK();
+}
+
+// Private function to move the shuffle buffer to the draining state, leaving the exchange for this epoch
+Status ShuffleOp::StartDrain() {
+  shuffle_buffer_state_ = kShuffleStateDrain;
+  if (exchange_ != nullptr) {
+    RETURN_IF_NOT_OK(exchange_->Leave(rank_, exchange_epoch_));
+  }
+  return Status::OK();
+}
+
 Status ShuffleOp::EoeReceived(int32_t worker_id) {
   state_ = OpState::kDeOpIdle;
   return Status::OK();
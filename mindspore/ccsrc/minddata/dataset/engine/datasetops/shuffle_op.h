@@ -22,12 +22,14 @@
 #include <random>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/core/tensor_shape.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
 #include "minddata/dataset/engine/datasetops/pipeline_op.h"
+#include "minddata/dataset/engine/datasetops/shuffle_exchange.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -98,6 +100,19 @@ class ShuffleOp : public PipelineOp {
       return *this;
     }
 
+    // Setter method.
+    // @param exchange - The exchange to swap rows with the other data parallel ranks through
+    // @param rank - The rank of this pipeline
+    // @param exchange_size - The number of rows swapped in a round. A round is done each time as many new rows
+    //     have entered the shuffle buffer
+    // @return Builder setter method returns reference to the builder.
+    Builder &SetShuffleExchange(std::shared_ptr<ShuffleExchange> exchange, int32_t rank, int32_t exchange_size) {
+      build_exchange_ = std::move(exchange);
+      build_rank_ = rank;
+      build_exchange_size_ = exchange_size;
+      return *this;
+    }
+
     // The builder "build" method creates the final object.
     // @return shared_ptr to the new ShuffleOp object
     Status Build(std::shared_ptr<ShuffleOp> *);
@@ -110,6 +125,9 @@ class ShuffleOp : public PipelineOp {
     int32_t build_rows_per_buffer_;
     bool build_reshuffle_each_epoch_;
     int32_t build_op_connector_size_;
+    std::shared_ptr<ShuffleExchange> build_exchange_;
+    int32_t build_rank_;
+    int32_t build_exchange_size_;
 
     Status SanityCheck() const;
   };
@@ -119,7 +137,11 @@ class ShuffleOp : public PipelineOp {
   // @param shuffle_size - The size for the shuffle buffer
   // @param shuffle_seed - The seed to use for random number generation
   // @param op_connector_size - The output connector queue size
-  ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch);
+  // @param exchange - Optional exchange to swap rows with the other data parallel ranks through
+  // @param rank - The rank of this pipeline in the exchange
+  // @param exchange_size - The number of rows swapped in a round
+  ShuffleOp(int32_t shuffle_size, uint32_t shuffle_seed, int32_t op_connector_size, bool reset_every_epoch,
+            std::shared_ptr<ShuffleExchange> exchange = nullptr, int32_t rank = 0, int32_t exchange_size = 0);
 
   // Destructor
   ~ShuffleOp() = default;
@@ -156,6 +178,10 @@ class ShuffleOp : public PipelineOp {
   std::string Name() const override { return kShuffleOp; }
 
  private:
+  // Private function with the main loop of the op, which shuffles the rows of every epoch
+  // @return Status The status code returned
+  Status ShuffleRows();
+
   // Private function to add a new row to the shuffle buffer.
   // @return Status The status code returned
   Status AddRowToShuffleBuffer(TensorRow new_shuffle_row);
@@ -170,6 +196,14 @@ class ShuffleOp : public PipelineOp {
   // @return Status The status code returned
   Status SelfReset();
 
+  // Private function to swap rows picked at random from the full shuffle buffer with the other ranks
+  // @return Status The status code returned
+  Status ExchangeRows();
+
+  // Private function to move the shuffle buffer to the draining state, leaving the exchange for this epoch
+  // @return Status The status code returned
+  Status StartDrain();
+
   int32_t shuffle_size_;  // User config for the size of the shuffle buffer (number of rows)
   uint32_t shuffle_seed_;
   bool reshuffle_each_epoch_;
@@ -185,6 +219,12 @@ class ShuffleOp : public PipelineOp {
   int32_t shuffle_buffer_state_;  // State tracking for the shuffle buffer phases of work
 
   std::unique_ptr<ChildIterator> child_iterator_;  // An iterator for fetching.
+
+  std::shared_ptr<ShuffleExchange> exchange_;  // Swaps rows with the other ranks, if any
+  int32_t rank_;
+  int32_t exchange_size_;
+  int64_t exchange_epoch_;      // Number of epochs done with the exchange
+  int32_t rows_since_exchange_;  // Rows which entered the shuffle buffer since the last round
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -176,6 +176,14 @@ class AlbumOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "AlbumOp"; }
 
+  // Source files getter
+  // @param files - The folder of the images is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
  private:
   /// \brief Load image to tensor row
   /// \param[in] image_file Image name of file
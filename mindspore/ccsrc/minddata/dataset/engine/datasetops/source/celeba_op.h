@@ -148,6 +148,14 @@ class CelebAOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "CelebAOp"; }
 
+  // Source files getter
+  // @param files - The folder of the dataset is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
  private:
   // Called first when function is called
   // @return
@@ -148,6 +148,14 @@ class CifarOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "CifarOp"; }
 
+  // Source files getter
+  // @param files - The folder of the dataset is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
  private:
   // Load a tensor row according to a pair
   // @param uint64_t index - index need to load
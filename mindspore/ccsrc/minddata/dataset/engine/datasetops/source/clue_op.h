@@ -168,6 +168,14 @@ class ClueOp : public NonMappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "ClueOp"; }
 
+  // Source files getter
+  // @param files - The input files are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->insert(files->end(), clue_files_list_.begin(), clue_files_list_.end());
+    return Status::OK();
+  }
+
  private:
   // Reads a clue file and loads the data into multiple TensorRows.
   // @param file - the file to read.
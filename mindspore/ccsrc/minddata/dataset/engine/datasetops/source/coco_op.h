@@ -188,6 +188,15 @@ class CocoOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "CocoOp"; }
 
+  // Source files getter
+  // @param files - The folder of the images and the annotation file are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(image_folder_path_);
+    files->push_back(annotation_path_);
+    return Status::OK();
+  }
+
   /// \brief Gets the class indexing
   /// \return Status The status code returned
   Status GetClassIndexing(std::vector<std::pair<std::string, std::vector<int32_t>>> *output_class_indexing) override;
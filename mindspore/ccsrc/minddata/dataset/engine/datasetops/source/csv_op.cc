@@ -50,9 +50,11 @@ Status CsvOp::Builder::ValidateInputs() const {
 Status CsvOp::Builder::Build(std::shared_ptr<CsvOp> *op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_csv_files_list_.size()) {
-    builder_num_workers_ = builder_csv_files_list_.size();
+  // Throttle the number of workers if we have more workers than files, or parts of files when they are split!
+  int64_t num_blocks =
+    CountFileBlocks(builder_csv_files_list_, GlobalContext::config_manager()->file_split_size());
+  if (builder_num_workers_ > num_blocks) {
+    builder_num_workers_ = num_blocks;
     MS_LOG(WARNING) << "CsvOp operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
 
@@ -81,7 +83,8 @@ CsvOp::CsvOp(const std::vector<std::string> &csv_files_list, char field_delim,
 Status CsvOp::Init() {
   RETURN_IF_NOT_OK(filename_index_->insert(csv_files_list_));
 
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(csv_files_list_.size() / num_workers_) + 1);
+  int64_t num_blocks = CountFileBlocks(csv_files_list_, file_split_size_);
+  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(num_blocks / num_workers_) + 1);
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   RETURN_IF_NOT_OK(ParallelOp::CreateWorkerConnector(worker_connector_size_));
@@ -497,25 +500,53 @@ Status CsvOp::LoadFile(const std::string &file, int64_t start_offset, int64_t en
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+  return ParseRows(&ifs, &csv_parser, file, std::numeric_limits<int64_t>::max());
+}
+
+Status CsvOp::LoadFileRange(const std::string &file, int64_t start_offset, int64_t end_offset, int64_t byte_begin,
+                            int64_t byte_end, int32_t worker_id) {
+  auto ranges = file_ranges_.find(file);
+  CHECK_FAIL_RETURN_UNEXPECTED(ranges != file_ranges_.end(), "Invalid file, file was not split: " + file);
+  auto range = std::find_if(ranges->second.begin(), ranges->second.end(),
+                            [byte_begin](const std::pair<int64_t, int64_t> &r) { return r.first == byte_begin; });
+  CHECK_FAIL_RETURN_UNEXPECTED(range != ranges->second.end(),
+                               "Invalid file, no row starts at byte " + std::to_string(byte_begin) + " of " + file);
+  CsvParser csv_parser(worker_id, jagged_rows_connector_.get(), field_delim_, column_default_list_, file);
+  RETURN_IF_NOT_OK(csv_parser.InitCsvParser());
+  csv_parser.SetStartOffset(start_offset);
+  csv_parser.SetEndOffset(end_offset);
+  // The range begins at the start of a row, the parser goes on from there as if it had read the rows before
+  csv_parser.SetTotalRows(range->second);
+  std::ifstream ifs;
+  ifs.open(file, std::ifstream::in);
+  if (!ifs.is_open()) {
+    RETURN_STATUS_UNEXPECTED("Error opening file: " + file);
+  }
+  (void)ifs.seekg(byte_begin, std::ios::beg);
+  csv_parser.Reset();
+  return ParseRows(&ifs, &csv_parser, file, end_offset);
+}
+
+Status CsvOp::ParseRows(std::ifstream *ifs, CsvParser *csv_parser, const std::string &file, int64_t end_row) {
   try {
-    while (ifs.good()) {
+    while (ifs->good() && csv_parser->GetTotalRows() < end_row) {
       // when ifstream reaches the end of file, the function get() return std::char_traits<char>::eof()
       // which is a 32-bit -1, it's not equal to the 8-bit -1 on Euler OS. So instead of char, we use
       // int to receive its return value.
-      int chr = ifs.get();
-      int err = csv_parser.ProcessMessage(chr);
+      int chr = ifs->get();
+      int err = csv_parser->ProcessMessage(chr);
       if (err != 0) {
         if (err == -2) return Status(kMDInterrupted);
         RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse file: " + file + ":" +
-                                 std::to_string(csv_parser.GetTotalRows() + 1) +
-                                 ". Error message: " + csv_parser.GetErrorMessage());
+                                 std::to_string(csv_parser->GetTotalRows() + 1) +
+                                 ". Error message: " + csv_parser->GetErrorMessage());
       }
     }
   } catch (std::invalid_argument &ia) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
+    std::string err_row = std::to_string(csv_parser->GetTotalRows() + 1);
     RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ":" + err_row + ", type does not match.");
   } catch (std::out_of_range &oor) {
-    std::string err_row = std::to_string(csv_parser.GetTotalRows() + 1);
+    std::string err_row = std::to_string(csv_parser->GetTotalRows() + 1);
     RETURN_STATUS_UNEXPECTED("Invalid data, " + file + ":" + err_row + ", out of range.");
   }
   return Status::OK();
@@ -570,10 +601,7 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
     }
     for (auto file_info : file_index) {
       if (NeedPushFileToBlockQueue(file_info.first, &start_offset, &end_offset, pre_count)) {
-        auto ioBlock =
-          std::make_unique<FilenameBlock>(file_info.second, start_offset, end_offset, IOBlock::kDeIoBlockNone);
-        RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-        queue_index = (queue_index + 1) % num_workers_;
+        RETURN_IF_NOT_OK(PushRangeBlocks(file_info.first, file_info.second, start_offset, end_offset, &queue_index));
       }
 
       pre_count += filename_numrows_[file_info.first];
@@ -590,9 +618,36 @@ Status CsvOp::FillIOBlockQueue(const std::vector<int64_t> &i_keys) {
   return Status::OK();
 }
 
+Status CsvOp::PushRangeBlocks(const std::string &file, int64_t key, int64_t start_offset, int64_t end_offset,
+                              int32_t *queue_index) {
+  RETURN_UNEXPECTED_IF_NULL(queue_index);
+  auto ranges = file_ranges_.find(file);
+  if (ranges == file_ranges_.end() || ranges->second.size() <= 1) {
+    auto io_block = std::make_unique<FilenameBlock>(key, start_offset, end_offset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+    return Status::OK();
+  }
+  const auto &r = ranges->second;
+  int64_t file_size = FileSize(file);
+  for (size_t i = 0; i < r.size(); ++i) {
+    bool last = i + 1 == r.size();
+    int64_t block_start = std::max(start_offset, r[i].second);
+    int64_t block_end = std::min(end_offset, last ? filename_numrows_[file] : r[i + 1].second);
+    if (block_start >= block_end) {
+      continue;
+    }
+    auto io_block = std::make_unique<FilenameBlock>(key, block_start, block_end, IOBlock::kDeIoBlockNone);
+    io_block->SetByteRange(r[i].first, last ? file_size : r[i + 1].first);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+  }
+  return Status::OK();
+}
+
 Status CsvOp::CalculateNumRowsPerShard() {
   for (auto it = filename_index_->begin(); it != filename_index_->end(); ++it) {
-    int64_t count = CountTotalRows(it.value());
+    int64_t count = CountTotalRows(it.value(), file_split_size_ > 0 ? &file_ranges_[it.value()] : nullptr);
     filename_numrows_[it.value()] = count;
     num_rows_ += count;
   }
@@ -606,7 +661,7 @@ Status CsvOp::CalculateNumRowsPerShard() {
   return Status::OK();
 }
 
-int64_t CsvOp::CountTotalRows(const std::string &file) {
+int64_t CsvOp::CountTotalRows(const std::string &file, std::vector<std::pair<int64_t, int64_t>> *ranges) {
   CsvParser csv_parser(0, jagged_rows_connector_.get(), field_delim_, column_default_list_, file);
   Status rc = csv_parser.InitCsvParser();
   if (rc.IsError()) {
@@ -623,11 +678,24 @@ int64_t CsvOp::CountTotalRows(const std::string &file) {
     getline(ifs, tmp);
   }
   csv_parser.Reset();
+  int64_t pos = static_cast<int64_t>(ifs.tellg());
+  if (ranges != nullptr) {
+    ranges->clear();
+    ranges->emplace_back(pos, 0);
+  }
   while (ifs.good()) {
     int chr = ifs.get();
+    int64_t rows = csv_parser.GetTotalRows();
     if (csv_parser.CountRows(chr) != 0) {
       break;
     }
+    ++pos;
+    // The parser counts a row at the line break which ends it, the next row starts after it. As the parser
+    // keeps track of quotes, line breaks inside quoted fields do not end a range.
+    if (ranges != nullptr && chr != std::char_traits<char>::eof() && csv_parser.GetTotalRows() > rows &&
+        pos - ranges->back().first >= file_split_size_) {
+      ranges->emplace_back(pos, csv_parser.GetTotalRows());
+    }
   }
 
   return csv_parser.GetTotalRows();
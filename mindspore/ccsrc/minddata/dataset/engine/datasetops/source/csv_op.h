@@ -16,6 +16,7 @@
 #ifndef DATASET_ENGINE_DATASETOPS_SOURCE_CSV_OP_H_
 #define DATASET_ENGINE_DATASETOPS_SOURCE_CSV_OP_H_
 
+#include <fstream>
 #include <string>
 #include <vector>
 #include <memory>
@@ -76,6 +77,8 @@ class CsvOp : public NonMappableLeafOp {
 
     void SetEndOffset(int64_t end_offset) { end_offset_ = end_offset; }
 
+    void SetTotalRows(int64_t total_rows) { total_rows_ = total_rows; }
+
     int ProcessMessage(int c);
 
     int CountRows(int c);
@@ -290,6 +293,14 @@ class CsvOp : public NonMappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "CsvOp"; }
 
+  // Source files getter
+  // @param files - The input files are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->insert(files->end(), csv_files_list_.begin(), csv_files_list_.end());
+    return Status::OK();
+  }
+
  private:
   // Parses a single row and puts the data into a tensor table.
   // @param line - the content of the row.
@@ -306,6 +317,35 @@ class CsvOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &file, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // Reads the rows of a csv file which start in one of the ranges found by CountTotalRows.
+  // @param file - the file to read.
+  // @param start_offset - the start offset of file.
+  // @param end_offset - the end offset of file, not beyond the last row of the range.
+  // @param byte_begin - the first byte of the range.
+  // @param byte_end - one past the last byte of the range.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  Status LoadFileRange(const std::string &file, int64_t start_offset, int64_t end_offset, int64_t byte_begin,
+                       int64_t byte_end, int32_t worker_id) override;
+
+  // Feeds the characters of a csv file to a parser until it has gone through a number of rows.
+  // @param ifs - the opened file.
+  // @param csv_parser - the parser.
+  // @param file - the file name.
+  // @param end_row - the row to stop at.
+  // @return Status - the error code returned.
+  Status ParseRows(std::ifstream *ifs, CsvParser *csv_parser, const std::string &file, int64_t end_row);
+
+  // Push the rows of a file to the block queue, as one block for each of its ranges which overlaps them.
+  // @param file - the file name.
+  // @param key - the key of the file.
+  // @param start_offset - the start offset of file.
+  // @param end_offset - the end offset of file.
+  // @param queue_index - the queue to push the next block to, updated for each block pushed.
+  // @return Status - the error code returned.
+  Status PushRangeBlocks(const std::string &file, int64_t key, int64_t start_offset, int64_t end_offset,
+                         int32_t *queue_index);
+
   // Fill the IOBlockQueue.
   // @para i_keys - keys of file to fill to the IOBlockQueue
   // @return Status - the error code returned.
@@ -317,8 +357,10 @@ class CsvOp : public NonMappableLeafOp {
 
   // Count number of rows in each file.
   // @param filename - csv file name.
+  // @param ranges - if not null, filled with the first byte and the first row of ranges of the file of at least
+  //     file_split_size_ bytes, which begin at the start of a row.
   // @return int64_t - the total number of rows in file.
-  int64_t CountTotalRows(const std::string &file);
+  int64_t CountTotalRows(const std::string &file, std::vector<std::pair<int64_t, int64_t>> *ranges = nullptr);
 
   // Private function for computing the assignment of the column name map.
   // @return - Status
@@ -343,6 +385,7 @@ class CsvOp : public NonMappableLeafOp {
   std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list_;
   std::vector<std::string> column_name_list_;
   bool check_flag_ = false;
+  std::map<std::string, std::vector<std::pair<int64_t, int64_t>>> file_ranges_;  // first byte and row of the ranges
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -192,6 +192,14 @@ class ImageFolderOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "ImageFolderOp"; }
 
+  // Source files getter
+  // @param files - The folder of the images is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
   /// \brief Base-class override for GetNumClasses
   /// \param[out] num_classes the number of classes
   /// \return Status of the function
@@ -55,11 +55,19 @@ Status IOBlock::GetKeys(std::vector<int64_t> *out_keys) const {
 
 // Constructor of the FilenameBlock (1)
 FilenameBlock::FilenameBlock(int64_t key, int64_t start_offset, int64_t end_offset, IOBlockFlags io_block_flags)
-    : IOBlock(key, io_block_flags), start_offset_(start_offset), end_offset_(end_offset) {}
+    : IOBlock(key, io_block_flags),
+      start_offset_(start_offset),
+      end_offset_(end_offset),
+      byte_begin_(kInvalidOffset),
+      byte_end_(kInvalidOffset) {}
 
 // Constructor of the FilenameBlock (2).  A special IOBlock that is used for control messaging.
 FilenameBlock::FilenameBlock(IOBlockFlags io_block_flags)
-    : IOBlock(io_block_flags), start_offset_(kInvalidOffset), end_offset_(kInvalidOffset) {}
+    : IOBlock(io_block_flags),
+      start_offset_(kInvalidOffset),
+      end_offset_(kInvalidOffset),
+      byte_begin_(kInvalidOffset),
+      byte_end_(kInvalidOffset) {}
 
 // Gets the filename from the block using the provided index container
 Status FilenameBlock::GetFilename(std::string *out_filename, const AutoIndexObj<std::string> &index) const {
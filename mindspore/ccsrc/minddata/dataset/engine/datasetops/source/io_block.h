@@ -121,9 +121,31 @@ class FilenameBlock : public IOBlock {
   // @return int64_t - Start offset
   int64_t GetEndOffset() const { return end_offset_; }
 
+  // Restrict the block to the records which start in a range of bytes of the file
+  // @param byte_begin - First byte of the range
+  // @param byte_end - One past the last byte of the range
+  void SetByteRange(int64_t byte_begin, int64_t byte_end) {
+    byte_begin_ = byte_begin;
+    byte_end_ = byte_end;
+  }
+
+  // Check whether the block covers only a range of bytes of the file
+  // @return bool - True if a byte range is set
+  bool HasByteRange() const { return byte_begin_ != kInvalidOffset; }
+
+  // Get the first byte of the range of the block
+  // @return int64_t - Byte offset
+  int64_t GetByteBegin() const { return byte_begin_; }
+
+  // Get one past the last byte of the range of the block
+  // @return int64_t - Byte offset
+  int64_t GetByteEnd() const { return byte_end_; }
+
  private:
   int64_t start_offset_;
   int64_t end_offset_;
+  int64_t byte_begin_;
+  int64_t byte_end_;
 };  // class TFBlock
 }  // namespace dataset
 }  // namespace mindspore
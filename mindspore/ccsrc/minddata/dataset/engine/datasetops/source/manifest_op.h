@@ -165,6 +165,14 @@ class ManifestOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "ManifestOp"; }
 
+  // Source files getter
+  // @param files - The manifest file is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(file_);
+    return Status::OK();
+  }
+
   /// \brief Base-class override for GetNumClasses
   /// \param[out] num_classes the number of classes
   /// \return Status of the function
@@ -257,25 +257,51 @@ Status MindRecordOp::WorkerEntry(int32_t worker_id) {
       return Status::OK();  // empty key is a quit signal for workers
     }
 
-    const uint64_t row_id = keys[0];
-    TensorRow fetched_row;
-
-    // Get the next row. Push it up to the output connector.
-    if (row_id % LOG_INTERVAL == 0) {
-      MS_LOG(DEBUG) << "MindRecord operator consumed row " << row_id << " by worker " << worker_id << ".";
+    // the rows of the data blocks already queued to this worker are read together, so that the reader coalesces
+    // their blobs, the block which is not a data block is handled in the next loop
+    std::vector<int64_t> row_ids = {keys[0]};
+    std::unique_ptr<IOBlock> next_block;
+    while (row_ids.size() < mindrecord::kNumRowsInRead && io_block_queues_[worker_id]->TryPopFront(&next_block)) {
+      keys.clear();
+      if (next_block->wait() || next_block->eoe() || next_block->eof() || next_block->GetKeys(&keys).IsError() ||
+          keys.empty()) {
+        break;
+      }
+      row_ids.push_back(keys[0]);
+      next_block.reset();
+    }
+    auto rows = shard_reader_->GetNextByIds(row_ids, worker_id);
+    if (rows.size() != row_ids.size()) {
+      // read the rows one by one, so that the row failed to read does not empty the others
+      rows.clear();
+      for (auto row_id : row_ids) {
+        rows.push_back(shard_reader_->GetNextById(row_id, worker_id));
+      }
+    }
+    for (size_t i = 0; i < row_ids.size(); ++i) {
+      // Get the next row. Push it up to the output connector.
+      if (row_ids[i] % LOG_INTERVAL == 0) {
+        MS_LOG(DEBUG) << "MindRecord operator consumed row " << row_ids[i] << " by worker " << worker_id << ".";
+      }
+      TensorRow fetched_row;
+      RETURN_IF_NOT_OK(GetRowFromReader(&fetched_row, row_ids[i], std::move(rows[i])));
+      RETURN_IF_NOT_OK(out_connector_->Add(std::move(fetched_row), worker_id));
+    }
+    if (next_block != nullptr) {
+      io_block = std::move(next_block);
+    } else {
+      RETURN_IF_NOT_OK(io_block_queues_[worker_id]->PopFront(&io_block));
     }
-    RETURN_IF_NOT_OK(GetRowFromReader(&fetched_row, row_id, worker_id));
-    RETURN_IF_NOT_OK(out_connector_->Add(std::move(fetched_row), worker_id));
-    RETURN_IF_NOT_OK(io_block_queues_[worker_id]->PopFront(&io_block));
   }
   RETURN_STATUS_UNEXPECTED("Unexpected nullptr received in worker.");
 }
 
-Status MindRecordOp::GetRowFromReader(TensorRow *fetched_row, int64_t row_id, int32_t worker_id) {
+Status MindRecordOp::GetRowFromReader(
+  TensorRow *fetched_row, int64_t row_id,
+  std::pair<mindrecord::TaskType, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>> &&rc) {
   *fetched_row = {};
-  auto rc = shard_reader_->GetNextById(row_id, worker_id);
   auto task_type = rc.first;
-  auto tupled_buffer = rc.second;
+  auto tupled_buffer = std::move(rc.second);
   if (task_type == mindrecord::TaskType::kPaddedTask) {
     RETURN_IF_NOT_OK(LoadTensorRow(fetched_row, {}, mindrecord::json(), task_type));
     std::vector<std::string> file_path(fetched_row->size(), dataset_file_[0]);
@@ -211,8 +211,19 @@ class MindRecordOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "MindRecordOp"; }
 
+  // Source files getter
+  // @param files - The input files are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->insert(files->end(), dataset_file_.begin(), dataset_file_.end());
+    return Status::OK();
+  }
+
  private:
-  Status GetRowFromReader(TensorRow *fetched_row, int64_t row_id, int32_t worker_id);
+  // Loads the row read by the shard reader
+  Status GetRowFromReader(
+    TensorRow *fetched_row, int64_t row_id,
+    std::pair<mindrecord::TaskType, std::vector<std::tuple<std::vector<uint8_t>, mindrecord::json>>> &&rc);
 
   // Parses a single cell and puts the data into a tensor
   // @param tensor_row - the tensor row to put the parsed data in
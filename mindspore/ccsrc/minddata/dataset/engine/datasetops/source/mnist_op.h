@@ -143,6 +143,14 @@ class MnistOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "MnistOp"; }
 
+  // Source files getter
+  // @param files - The folder of the dataset is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
  private:
   // Load a tensor row according to a pair
   // @param row_id_type row_id - id for this tensor row
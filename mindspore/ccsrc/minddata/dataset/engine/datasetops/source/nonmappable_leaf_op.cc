@@ -17,6 +17,7 @@
 
 #include <algorithm>
 
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -24,6 +25,7 @@
 #include <vector>
 
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/io_block.h"
 #include "minddata/dataset/engine/db_connector.h"
 #include "minddata/dataset/engine/execution_tree.h"
@@ -49,7 +51,8 @@ NonMappableLeafOp::NonMappableLeafOp(int32_t num_workers, int32_t worker_connect
       finished_reading_dataset_(false),
       shuffle_files_(shuffle_files),
       num_rows_per_shard_(0),
-      num_rows_(0) {
+      num_rows_(0),
+      file_split_size_(GlobalContext::config_manager()->file_split_size()) {
   worker_connector_size_ = worker_connector_size;
 }
 
@@ -151,8 +154,15 @@ Status NonMappableLeafOp::WorkerEntry(int32_t worker_id) {
         RETURN_IF_NOT_OK(io_block->GetFilename(&filename, *filename_index_));
         int64_t start_offset = io_block->GetStartOffset();
         int64_t end_offset = io_block->GetEndOffset();
-        RETURN_IF_NOT_OK(LoadFile(filename, start_offset, end_offset, worker_id));
-        MS_LOG(DEBUG) << Name() << " operator worker " << worker_id << " loaded file " << filename << ".";
+        if (io_block->HasByteRange()) {
+          RETURN_IF_NOT_OK(LoadFileRange(filename, start_offset, end_offset, io_block->GetByteBegin(),
+                                         io_block->GetByteEnd(), worker_id));
+          MS_LOG(DEBUG) << Name() << " operator worker " << worker_id << " loaded bytes " << io_block->GetByteBegin()
+                        << " to " << io_block->GetByteEnd() << " of file " << filename << ".";
+        } else {
+          RETURN_IF_NOT_OK(LoadFile(filename, start_offset, end_offset, worker_id));
+          MS_LOG(DEBUG) << Name() << " operator worker " << worker_id << " loaded file " << filename << ".";
+        }
       }
     } else {
       TensorRow eoe = TensorRow(TensorRow::kFlagEOE);
@@ -255,6 +265,49 @@ bool NonMappableLeafOp::NeedPushFileToBlockQueue(const std::string &file_name, i
   return push;
 }
 
+Status NonMappableLeafOp::LoadFileRange(const std::string &filename, int64_t start_offset, int64_t end_offset,
+                                        int64_t byte_begin, int64_t byte_end, int32_t worker_id) {
+  RETURN_STATUS_UNEXPECTED(Name() + " cannot read part of a file: " + filename);
+}
+
+int64_t NonMappableLeafOp::FileSize(const std::string &file_name) {
+  std::ifstream reader(file_name, std::ios::binary | std::ios::ate);
+  if (!reader) {
+    return 0;
+  }
+  return static_cast<int64_t>(reader.tellg());
+}
+
+int64_t NonMappableLeafOp::CountFileBlocks(const std::vector<std::string> &files, int64_t split_size) {
+  if (split_size <= 0) {
+    return static_cast<int64_t>(files.size());
+  }
+  int64_t num_blocks = 0;
+  for (const auto &file : files) {
+    num_blocks += std::max<int64_t>((FileSize(file) + split_size - 1) / split_size, 1);
+  }
+  return num_blocks;
+}
+
+Status NonMappableLeafOp::PushFileBlocks(int64_t key, int32_t *queue_index) {
+  RETURN_UNEXPECTED_IF_NULL(queue_index);
+  int64_t file_size = file_split_size_ > 0 ? FileSize((*filename_index_)[key]) : 0;
+  if (file_size <= file_split_size_) {
+    auto io_block = std::make_unique<FilenameBlock>(key, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+    return Status::OK();
+  }
+  // Consecutive ranges of the file go to different workers, so that they read it at once
+  for (int64_t byte_begin = 0; byte_begin < file_size; byte_begin += file_split_size_) {
+    auto io_block = std::make_unique<FilenameBlock>(key, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
+    io_block->SetByteRange(byte_begin, std::min(byte_begin + file_split_size_, file_size));
+    RETURN_IF_NOT_OK(PushIoBlockQueue(*queue_index, std::move(io_block)));
+    *queue_index = (*queue_index + 1) % num_workers_;
+  }
+  return Status::OK();
+}
+
 void NonMappableLeafOp::ShuffleKeys(std::vector<int64_t> *i_keys, uint32_t seed) {
   std::mt19937 rng(seed);
   std::shuffle(i_keys->begin(), i_keys->end(), rng);
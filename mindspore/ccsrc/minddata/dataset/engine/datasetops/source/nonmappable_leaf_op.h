@@ -123,6 +123,36 @@ class NonMappableLeafOp : public ParallelOp {
   // @return Status - the error code returned.
   virtual Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) = 0;
 
+  // Reads the records of a file which start in a range of bytes, and loads them into multiple TensorRows.
+  // Readers which split their files override it, the base one fails.
+  // @param filename - the file to read.
+  // @param start_offset - the start offset of file, as in LoadFile.
+  // @param end_offset - the end offset of file, as in LoadFile.
+  // @param byte_begin - the first byte of the range.
+  // @param byte_end - one past the last byte of the range.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  virtual Status LoadFileRange(const std::string &filename, int64_t start_offset, int64_t end_offset,
+                               int64_t byte_begin, int64_t byte_end, int32_t worker_id);
+
+  // Get the size of a file.
+  // @param file_name - File name.
+  // @return int64_t - the number of bytes of the file, 0 if it cannot be opened.
+  static int64_t FileSize(const std::string &file_name);
+
+  // Count the IOBlocks a list of files makes, at most, when they are split.
+  // @param files - File names.
+  // @param split_size - Number of bytes of a file read by one worker, 0 if files are not split.
+  // @return int64_t - the number of blocks.
+  static int64_t CountFileBlocks(const std::vector<std::string> &files, int64_t split_size);
+
+  // Push a whole file to the block queue, as one block for each range of file_split_size_ bytes when
+  // files are split.
+  // @param key - Key of the file.
+  // @param queue_index - Index of the queue to push the next block to, updated for each block pushed.
+  // @return Status - the error code returned.
+  Status PushFileBlocks(int64_t key, int32_t *queue_index);
+
   // Select file and push it to the block queue.
   // @param file_name - File name.
   // @param start_file - If file contains the first sample of data.
@@ -160,6 +190,7 @@ class NonMappableLeafOp : public ParallelOp {
   bool shuffle_files_;
   int64_t num_rows_per_shard_;
   int64_t num_rows_;
+  int64_t file_split_size_;  // Number of bytes of a file read by one worker, 0 to read whole files
 };
 }  // namespace dataset
 }  // namespace mindspore
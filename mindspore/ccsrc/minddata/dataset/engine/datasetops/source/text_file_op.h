@@ -162,6 +162,14 @@ class TextFileOp : public NonMappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "TextFileOp"; }
 
+  // Source files getter
+  // @param files - The input files are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->insert(files->end(), text_files_list_.begin(), text_files_list_.end());
+    return Status::OK();
+  }
+
   // File names getter
   // @return Vector of the input file names
   std::vector<std::string> FileNames() { return text_files_list_; }
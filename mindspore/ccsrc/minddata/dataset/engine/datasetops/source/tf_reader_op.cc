@@ -40,6 +40,8 @@
 namespace mindspore {
 namespace dataset {
 const int64_t kTFRecordFileLimit = 0x140000000;
+const int64_t kTFRecordHeaderSize = sizeof(int64_t) + sizeof(uint32_t);
+const int64_t kTFRecordFooterSize = sizeof(uint32_t);
 TFReaderOp::Builder::Builder()
     : builder_device_id_(0), builder_num_devices_(1), builder_total_rows_(0), builder_equal_rows_per_shard_(false) {
   std::shared_ptr<ConfigManager> config_manager = GlobalContext::config_manager();
@@ -93,6 +95,12 @@ Status TFReaderOp::Builder::ValidateInputs() const {
                std::to_string(builder_num_devices_) + ", shard_id: " + std::to_string(builder_device_id_) + ".\n";
   }
 
+  // The rows of a shard are counted from whole files, a range of a file has no row count
+  if (builder_equal_rows_per_shard_ && GlobalContext::config_manager()->file_split_size() > 0) {
+    err_msg += "Invalid parameter, shard_equal_rows can not be used when the file split size is set, got: " +
+               std::to_string(GlobalContext::config_manager()->file_split_size()) + ".\n";
+  }
+
   std::vector<std::string> invalid_files(builder_dataset_files_list_.size());
   auto it = std::copy_if(builder_dataset_files_list_.begin(), builder_dataset_files_list_.end(), invalid_files.begin(),
                          [](const std::string &filename) { return !ValidateFirstRowCrc(filename); });
@@ -113,9 +121,13 @@ Status TFReaderOp::Builder::ValidateInputs() const {
 Status TFReaderOp::Builder::Build(std::shared_ptr<TFReaderOp> *out_tf_reader_op) {
   RETURN_IF_NOT_OK(ValidateInputs());
 
-  // Throttle the number of workers if we have more workers than files!
-  if (static_cast<size_t>(builder_num_workers_) > builder_dataset_files_list_.size()) {
-    builder_num_workers_ = builder_dataset_files_list_.size();
+  // Throttle the number of workers if we have more workers than files, or parts of files when they are split!
+  int64_t num_blocks = builder_equal_rows_per_shard_
+                         ? static_cast<int64_t>(builder_dataset_files_list_.size())
+                         : CountFileBlocks(builder_dataset_files_list_,
+                                           GlobalContext::config_manager()->file_split_size());
+  if (builder_num_workers_ > num_blocks) {
+    builder_num_workers_ = num_blocks;
     MS_LOG(WARNING) << "TFReader operator parallelism reduced to " << builder_num_workers_ << " workers.";
   }
 
@@ -191,7 +203,9 @@ Status TFReaderOp::Init() {
   jagged_rows_connector_ = std::make_unique<JaggedConnector>(num_workers_, 1, worker_connector_size_);
 
   // temporary: make size large enough to hold all files + EOE to avoid hangs
-  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(dataset_files_list_.size() / num_workers_)) + 1;
+  int64_t num_blocks = equal_rows_per_shard_ ? static_cast<int64_t>(dataset_files_list_.size())
+                                             : CountFileBlocks(dataset_files_list_, file_split_size_);
+  int32_t safe_queue_size = static_cast<int32_t>(std::ceil(num_blocks / num_workers_)) + 1;
   io_block_queues_.Init(num_workers_, safe_queue_size);
 
   return Status::OK();
@@ -235,9 +249,7 @@ Status TFReaderOp::FillIOBlockShuffle(const std::vector<int64_t> &i_keys) {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock = std::make_unique<FilenameBlock>(*it, kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileBlocks(*it, &queue_index));
         }
       } else {
         // Do an index lookup using that key to get the filename.
@@ -283,10 +295,7 @@ Status TFReaderOp::FillIOBlockNoShuffle() {
       }
       if (!equal_rows_per_shard_) {
         if (key_index++ % num_devices_ == device_id_) {
-          auto ioBlock =
-            std::make_unique<FilenameBlock>(it.key(), kInvalidOffset, kInvalidOffset, IOBlock::kDeIoBlockNone);
-          RETURN_IF_NOT_OK(PushIoBlockQueue(queue_index, std::move(ioBlock)));
-          queue_index = (queue_index + 1) % num_workers_;
+          RETURN_IF_NOT_OK(PushFileBlocks(it.key(), &queue_index));
         }
       } else {
         std::string file_name = it.value();
@@ -366,6 +375,107 @@ Status TFReaderOp::LoadFile(const std::string &filename, int64_t start_offset, i
   return Status::OK();
 }
 
+// Reads the records of a tf_file file which start in a range of bytes.
+Status TFReaderOp::LoadFileRange(const std::string &filename, int64_t start_offset, int64_t end_offset,
+                                 int64_t byte_begin, int64_t byte_end, int32_t worker_id) {
+  std::ifstream reader;
+  reader.open(filename, std::ios::binary);
+  if (!reader) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to open file: " + filename);
+  }
+  int64_t file_len = reader.seekg(0, std::ios::end).tellg();
+
+  // The range may begin in the middle of a record. Its first record is the first one which starts in it.
+  int64_t pos = byte_begin;
+  if (pos > 0) {
+    RETURN_IF_NOT_OK(FindNextRecord(&reader, file_len, byte_end, &pos));
+  }
+  reader.clear();
+  (void)reader.seekg(pos, std::ios::beg);
+
+  int32_t num_columns = data_schema_->NumColumns();
+  std::string serialized_example;
+  while (pos < byte_end && pos < file_len) {
+    if (!load_jagged_connector_) {
+      break;
+    }
+    RETURN_IF_INTERRUPTED();
+
+    int64_t record_length = 0;
+    (void)reader.read(reinterpret_cast<char *>(&record_length), static_cast<std::streamsize>(sizeof(int64_t)));
+    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    serialized_example.resize(record_length);
+    (void)reader.read(&serialized_example[0], static_cast<std::streamsize>(record_length));
+    (void)reader.ignore(static_cast<std::streamsize>(sizeof(int32_t)));
+    if (!reader) {
+      RETURN_STATUS_UNEXPECTED("Invalid file, tfrecord file is truncated: " + filename);
+    }
+
+    dataengine::Example tf_file;
+    if (!tf_file.ParseFromString(serialized_example)) {
+      std::string errMsg = "Invalid file, failed to parse tfrecord file : " + filename;
+      MS_LOG(DEBUG) << errMsg + ", details of string: " << serialized_example;
+      RETURN_STATUS_UNEXPECTED(errMsg);
+    }
+    TensorRow newRow(num_columns, nullptr);
+    std::vector<std::string> file_path(num_columns, filename);
+    newRow.setPath(file_path);
+    RETURN_IF_NOT_OK(LoadExample(&tf_file, &newRow));
+    RETURN_IF_NOT_OK(jagged_rows_connector_->Add(worker_id, std::move(newRow)));
+
+    pos += kTFRecordHeaderSize + record_length + kTFRecordFooterSize;
+  }
+
+  return Status::OK();
+}
+
+// Finds the first record which starts at or after an offset of a tf_file file.
+Status TFReaderOp::FindNextRecord(std::ifstream *reader, int64_t file_len, int64_t limit, int64_t *pos) {
+  // A record is framed as: length (8 bytes), masked crc of the length (4 bytes), data, masked crc of the data
+  // (4 bytes). A header whose crc matches is taken as the start of a record once the crc of its data matches too.
+  const int64_t kScanWindow = 64 * 1024;
+  std::vector<char> window(kScanWindow + kTFRecordHeaderSize);
+  std::string data;
+  int64_t window_begin = *pos;
+  while (window_begin < limit && window_begin + kTFRecordHeaderSize <= file_len) {
+    int64_t window_len = std::min<int64_t>(kScanWindow + kTFRecordHeaderSize, file_len - window_begin);
+    reader->clear();
+    (void)reader->seekg(window_begin, std::ios::beg);
+    (void)reader->read(window.data(), static_cast<std::streamsize>(window_len));
+    CHECK_FAIL_RETURN_UNEXPECTED(reader->gcount() == window_len, "Invalid file, failed to read tfrecord file.");
+
+    for (int64_t i = 0; i + kTFRecordHeaderSize <= window_len && i < kScanWindow; ++i) {
+      if (window_begin + i >= limit) {
+        break;
+      }
+      int64_t record_length = 0;
+      uint32_t masked_crc = 0;
+      (void)memcpy_s(&record_length, sizeof(record_length), &window[i], sizeof(int64_t));
+      (void)memcpy_s(&masked_crc, sizeof(masked_crc), &window[i + sizeof(int64_t)], sizeof(uint32_t));
+      if (record_length < 0 || record_length > file_len ||
+          window_begin + i + kTFRecordHeaderSize + record_length + kTFRecordFooterSize > file_len ||
+          system::Crc32c::GetMaskCrc32cValue(&window[i], sizeof(int64_t)) != masked_crc) {
+        continue;
+      }
+      // Check the data to tell a record from bytes inside a record that look like a header
+      data.resize(record_length);
+      uint32_t data_crc = 0;
+      reader->clear();
+      (void)reader->seekg(window_begin + i + kTFRecordHeaderSize, std::ios::beg);
+      (void)reader->read(&data[0], static_cast<std::streamsize>(record_length));
+      (void)reader->read(reinterpret_cast<char *>(&data_crc), static_cast<std::streamsize>(sizeof(uint32_t)));
+      if (*reader && system::Crc32c::GetMaskCrc32cValue(data.data(), data.size()) == data_crc) {
+        *pos = window_begin + i;
+        return Status::OK();
+      }
+    }
+    window_begin += kScanWindow;
+  }
+  // No record starts in the range
+  *pos = limit;
+  return Status::OK();
+}
+
 // Parses a single row and puts the data into a tensor table.
 Status TFReaderOp::LoadExample(const dataengine::Example *tf_file, TensorRow *out_row) {
   int32_t num_columns = data_schema_->NumColumns();
@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <condition_variable>
+#include <fstream>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -212,6 +213,14 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "TFReaderOp"; }
 
+  // Source files getter
+  // @param files - The input files are appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->insert(files->end(), dataset_files_list_.begin(), dataset_files_list_.end());
+    return Status::OK();
+  }
+
   // File names getter
   // @return Vector of the input file names
   std::vector<std::string> FileNames() { return dataset_files_list_; }
@@ -227,6 +236,26 @@ class TFReaderOp : public NonMappableLeafOp {
   // @return Status - the error code returned.
   Status LoadFile(const std::string &filename, int64_t start_offset, int64_t end_offset, int32_t worker_id) override;
 
+  // Reads the records of a tf_file file which start in a range of bytes and loads them into multiple TensorRows.
+  // @param filename - the tf_file file to read.
+  // @param start_offset - unused, the rows of a range are not counted.
+  // @param end_offset - unused, the rows of a range are not counted.
+  // @param byte_begin - the first byte of the range.
+  // @param byte_end - one past the last byte of the range.
+  // @param worker_id - the id of the worker that is executing this function.
+  // @return Status - the error code returned.
+  Status LoadFileRange(const std::string &filename, int64_t start_offset, int64_t end_offset, int64_t byte_begin,
+                       int64_t byte_end, int32_t worker_id) override;
+
+  // Finds the first record which starts at or after an offset of a tf_file file, using the crc of the
+  // record headers to tell where records begin.
+  // @param reader - the opened file.
+  // @param file_len - the size of the file.
+  // @param limit - the offset to give up at.
+  // @param pos - in: the offset to look from, out: the offset of the record, or limit if none is found before it.
+  // @return Status - the error code returned.
+  static Status FindNextRecord(std::ifstream *reader, int64_t file_len, int64_t limit, int64_t *pos);
+
   // Parses a single row and puts the data into a tensor table.
   // @param tf_file - the row to be parsed.
   // @param tensor_table - the tensor table to put the parsed data in.
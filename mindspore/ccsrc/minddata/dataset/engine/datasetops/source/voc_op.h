@@ -196,6 +196,14 @@ class VOCOp : public MappableLeafOp {
   // @return Name of the current Op
   std::string Name() const override { return "VOCOp"; }
 
+  // Source files getter
+  // @param files - The folder of the dataset is appended to it
+  // @return Status The status code returned
+  Status GetSourceFiles(std::vector<std::string> *files) override {
+    files->push_back(folder_path_);
+    return Status::OK();
+  }
+
   // /// \brief Gets the class indexing
   // /// \return Status - The status code return
   Status GetClassIndexing(std::vector<std::pair<std::string, std::vector<int32_t>>> *output_class_indexing) override;
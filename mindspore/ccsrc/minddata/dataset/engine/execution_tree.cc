@@ -21,6 +21,7 @@
 #include "minddata/dataset/engine/datasetops/device_queue_op.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 #include "minddata/dataset/engine/perf/monitor.h"
+#include "minddata/dataset/util/buffer_pool.h"
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
 #include "minddata/dataset/util/numa_interface.h"
 #endif
@@ -185,6 +186,11 @@ Status ExecutionTree::Launch() {
     RETURN_IF_NOT_OK(profiling_manager_->LaunchMonitor());
   }
 
+  // The tensors of the tree recycle the storage of the tensors it released before
+  if (tensor_pool_ == nullptr && GlobalContext::config_manager()->enable_tensor_pool()) {
+    RETURN_IF_NOT_OK(BufferPool::CreateBufferPool(&tensor_pool_, kTensorPoolMaxCachedSize, kTensorPoolArenaSize));
+  }
+
   std::ostringstream ss;
   ss << *this;
   MS_LOG(DEBUG) << "Printing the tree before launch tasks:\n" << ss.str();
@@ -195,11 +201,17 @@ Status ExecutionTree::Launch() {
     // the launching tree/user thread.  Do not exec any thread for an inlined op.
     itr->state_ = DatasetOp::OpState::kDeOpRunning;
     if (!itr->inlined()) {
-      RETURN_IF_NOT_OK(tg_->CreateAsyncTask(itr->NameWithID(), std::ref(*itr), nullptr, itr->id()));
+      RETURN_IF_NOT_OK(tg_->CreateAsyncTask(itr->NameWithID(), BindTensorPool(std::ref(*itr)), nullptr, itr->id()));
       // Set the state of the Operator as running. This only matters in Leaf ops, CacheOp and TakeOp
     }
   }
 
+  // The autotuner watches the connectors of the running ops, so it starts after them
+  if (GlobalContext::config_manager()->enable_autotune()) {
+    auto_tune_ = std::make_unique<AutoTune>(this);
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask("AutoTune Thread launched", std::ref(*auto_tune_)));
+  }
+
   tree_state_ = kDeTStateExecuting;
 
   return Status::OK();
@@ -225,7 +237,7 @@ ExecutionTree::Iterator::Iterator(const std::shared_ptr<DatasetOp> &root) : ind_
 // Given the number of workers, launches the worker entry function for each. Essentially a
 // wrapper for the TaskGroup handling that is stored inside the execution tree.
 Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name,
-                                    int32_t operator_id) {
+                                    int32_t operator_id, int32_t first_worker_id) {
   int32_t num_cpu_threads = GlobalContext::Instance()->config_manager()->num_cpu_threads();
   // this performs check that num_workers is positive and not unreasonably large which could happen
   // for example, un-initialized variable. uint16 max is 65536 which is large enough to cover everything
@@ -236,12 +248,25 @@ Status ExecutionTree::LaunchWorkers(int32_t num_workers, std::function<Status(ui
     MS_LOG(WARNING) << name + " is launched with " << std::to_string(num_workers) << " worker threads which exceeds "
                     << std::to_string(num_cpu_threads) << ", the maximum number of threads on this CPU.";
   }
-  for (int32_t i = 0; i < num_workers; ++i) {
-    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, std::bind(func, i), nullptr, operator_id));
+  for (int32_t i = first_worker_id; i < first_worker_id + num_workers; ++i) {
+    RETURN_IF_NOT_OK(tg_->CreateAsyncTask(name, BindTensorPool(std::bind(func, i)), nullptr, operator_id));
   }
   return Status::OK();
 }
 
+std::function<Status()> ExecutionTree::BindTensorPool(std::function<Status()> func) const {
+  if (tensor_pool_ == nullptr) {
+    return func;
+  }
+  std::shared_ptr<MemoryPool> pool = tensor_pool_;
+  return [pool, func]() -> Status {
+    GlobalContext::set_thread_mem_pool(pool);
+    Status rc = func();
+    GlobalContext::set_thread_mem_pool(nullptr);
+    return rc;
+  };
+}
+
 // Walks the tree to perform modifications to the tree in post-order to get it ready for execution.
 Status ExecutionTree::Prepare() {
   if (root_ == nullptr) {
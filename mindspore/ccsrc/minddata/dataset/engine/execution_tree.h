@@ -30,9 +30,11 @@
 #include "minddata/dataset/engine/datasetops/dataset_op.h"
 #include "minddata/dataset/util/status.h"
 #include "mindspore/ccsrc/minddata/dataset/engine/perf/profiling.h"
+#include "minddata/dataset/engine/perf/auto_tune.h"
 namespace mindspore {
 namespace dataset {
 // Forward declares
+class BufferPool;
 class TaskGroup;
 class DatasetOp;
 class Pass;
@@ -149,9 +151,15 @@ class ExecutionTree {
   /// \param func - The function entry point that workers will execute
   /// \param name - The description of worker to launch
   /// \param op_id - The id of corresponding operator, if not inherit from dataset op then it is -1.
+  /// \param first_worker_id - The worker id given to the first worker launched, the others follow sequentially.
   /// \return Status The status code returned
   Status LaunchWorkers(int32_t num_workers, std::function<Status(uint32_t)> func, std::string name = "",
-                       int32_t operator_id = -1);
+                       int32_t operator_id = -1, int32_t first_worker_id = 0);
+
+  /// \brief Getter method
+  /// \return The pool the threads of the tree take the storage of their tensors from, nullptr if the tensor pool is
+  ///     not enabled
+  std::shared_ptr<BufferPool> tensor_pool() const { return tensor_pool_; }
 
   /// \brief Getter method
   /// \return shared_ptr to the root operator
@@ -201,12 +209,19 @@ class ExecutionTree {
   void PrintNode(std::ostream &out, const std::shared_ptr<DatasetOp> &dataset_op, std::string indent, bool last,
                  bool detailed) const;
 
+  /// \brief Make the tensors created by a task of the tree take their storage from the tensor pool of the tree
+  /// \param func - The function entry point of the task
+  /// \return The function to launch the task with
+  std::function<Status()> BindTensorPool(std::function<Status()> func) const;
+
   std::unique_ptr<TaskGroup> tg_;                        // Class for worker management
   std::shared_ptr<DatasetOp> root_;                      // The root node of the tree
   int32_t id_count_;                                     // Counter for generating operator id's
   uint32_t prepare_flags_;                               // Flags used during tree prepare
   TreeState tree_state_;                                 // Tracking the current tree state
   std::unique_ptr<ProfilingManager> profiling_manager_;  // Profiling manager
+  std::unique_ptr<AutoTune> auto_tune_;                  // Tunes the workers of the tree while it runs
+  std::shared_ptr<BufferPool> tensor_pool_;              // Recycles the storage of the tensors of the tree
 #if defined(ENABLE_GPUQUE) || defined(ENABLE_TDTQUE)
   // This rank_id is for numa and device_queue, one process work with only one rank_id,
   // for standalone scenario, this rank_id may come from env 'CUDA_VISIBLE_DEVICES',
@@ -16,6 +16,7 @@
 #include "minddata/dataset/engine/gnn/graph_loader.h"
 
 #include <future>
+#include <numeric>
 #include <tuple>
 #include <utility>
 
@@ -240,30 +241,36 @@ Status GraphLoader::LoadEdge(const std::vector<uint8_t> &col_blob, const mindrec
 Status GraphLoader::WorkerEntry(int32_t worker_id) {
   // Handshake
   TaskManager::FindMe()->Post();
-  auto ret = shard_reader_->GetNextById(row_id_++, worker_id);
-  ShardTuple rows = ret.second;
-  while (rows.empty() == false) {
+  // the rows are read in batches, so that the shard reader coalesces their blobs
+  std::vector<int64_t> row_ids(mindrecord::kNumRowsInRead);
+  while (true) {
     RETURN_IF_INTERRUPTED();
-    for (const auto &tupled_row : rows) {
-      std::vector<uint8_t> col_blob = std::get<0>(tupled_row);
-      mindrecord::json col_jsn = std::get<1>(tupled_row);
-      std::string attr = col_jsn["attribute"];
-      if (attr == "n") {
-        std::shared_ptr<Node> node_ptr;
-        RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node_ptr, &(n_feature_maps_[worker_id]),
-                                  &default_node_feature_maps_[worker_id]));
-        n_deques_[worker_id].emplace_back(node_ptr);
-      } else if (attr == "e") {
-        std::shared_ptr<Edge> edge_ptr;
-        RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge_ptr, &(e_feature_maps_[worker_id]),
-                                  &default_edge_feature_maps_[worker_id]));
-        e_deques_[worker_id].emplace_back(edge_ptr);
-      } else {
-        MS_LOG(WARNING) << "attribute:" << attr << " is neither edge nor node.";
+    int64_t row_id = row_id_.fetch_add(mindrecord::kNumRowsInRead);
+    std::iota(row_ids.begin(), row_ids.end(), row_id);
+    auto rows = shard_reader_->GetNextByIds(row_ids, worker_id);
+    if (rows.empty()) {
+      break;
+    }
+    for (const auto &row : rows) {
+      for (const auto &tupled_row : row.second) {
+        std::vector<uint8_t> col_blob = std::get<0>(tupled_row);
+        mindrecord::json col_jsn = std::get<1>(tupled_row);
+        std::string attr = col_jsn["attribute"];
+        if (attr == "n") {
+          std::shared_ptr<Node> node_ptr;
+          RETURN_IF_NOT_OK(LoadNode(col_blob, col_jsn, &node_ptr, &(n_feature_maps_[worker_id]),
+                                    &default_node_feature_maps_[worker_id]));
+          n_deques_[worker_id].emplace_back(node_ptr);
+        } else if (attr == "e") {
+          std::shared_ptr<Edge> edge_ptr;
+          RETURN_IF_NOT_OK(LoadEdge(col_blob, col_jsn, &edge_ptr, &(e_feature_maps_[worker_id]),
+                                    &default_edge_feature_maps_[worker_id]));
+          e_deques_[worker_id].emplace_back(edge_ptr);
+        } else {
+          MS_LOG(WARNING) << "attribute:" << attr << " is neither edge nor node.";
+        }
       }
     }
-    auto rc = shard_reader_->GetNextById(row_id_++, worker_id);
-    rows = rc.second;
   }
   return Status::OK();
 }
@@ -60,8 +60,10 @@ class GpuItemConnector : public Connector<std::vector<device::DataItemGpu>> {
         is_queue_finished_[pop_from_] = true;
       }
 
-      for (int offset = 1; offset <= num_producers_; offset++) {
-        int32_t nextQueueIndex = (pop_from_ + offset) % num_producers_;
+      // Only the queues of the active producers take part in the roundrobin
+      int32_t start = UpdateActiveProducers() ? active_producers_ - 1 : pop_from_;
+      for (int offset = 1; offset <= active_producers_; offset++) {
+        int32_t nextQueueIndex = (start + offset) % active_producers_;
         if (is_queue_finished_[nextQueueIndex] == false) {
           pop_from_ = nextQueueIndex;
           break;
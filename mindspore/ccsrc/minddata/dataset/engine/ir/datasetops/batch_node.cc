@@ -24,6 +24,7 @@
 
 #include "minddata/dataset/engine/datasetops/batch_op.h"
 #include "minddata/dataset/engine/opt/pass.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
 #include "minddata/dataset/util/status.h"
 namespace mindspore {
 namespace dataset {
@@ -61,6 +62,7 @@ std::shared_ptr<DatasetNode> BatchNode::Copy() {
 #else
   auto node = std::make_shared<BatchNode>(nullptr, batch_size_, drop_remainder_);
 #endif
+  node->SetPostBatchOps(post_batch_ops_);
   return node;
 }
 
@@ -94,6 +96,10 @@ Status BatchNode::ValidateParams() {
 }
 
 Status BatchNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
+  std::map<std::string, std::shared_ptr<TensorOp>> post_batch_ops;
+  for (const auto &itr : post_batch_ops_) {
+    post_batch_ops[itr.first] = itr.second->Build();
+  }
 #ifdef ENABLE_PYTHON
   // if col_order_ isn't empty, then a project node needs to be attached after batch node. (same as map)
   // this means project_node needs to be the parent of batch_node. this means *node_ops = [project_node, batch_node]
@@ -104,12 +110,15 @@ Status BatchNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops)
 
   auto op = std::make_shared<BatchOp>(batch_size_, drop_remainder_, pad_, connector_que_size_, num_workers_,
                                       in_col_names_, out_col_names_, batch_size_func_, batch_map_func_, pad_map_);
+  op->SetPostBatchOps(std::move(post_batch_ops));
   op->set_total_repeats(GetTotalRepeats());
   op->set_num_repeats_per_epoch(GetNumRepeatsPerEpoch());
   node_ops->push_back(op);
 #else
-  node_ops->push_back(std::make_shared<BatchOp>(batch_size_, drop_remainder_, pad_, connector_que_size_, num_workers_,
-                                                in_col_names_, pad_map_));
+  auto op = std::make_shared<BatchOp>(batch_size_, drop_remainder_, pad_, connector_que_size_, num_workers_,
+                                      in_col_names_, pad_map_);
+  op->SetPostBatchOps(std::move(post_batch_ops));
+  node_ops->push_back(op);
 #endif
 
   return Status::OK();
@@ -99,6 +99,13 @@ class BatchNode : public DatasetNode {
   const py::function &BatchMapFunc() const { return batch_map_func_; }
   const std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> &PadMap() const { return pad_map_; }
 #endif
+  const std::map<std::string, std::shared_ptr<TensorOperation>> &PostBatchOps() const { return post_batch_ops_; }
+
+  /// \brief Setter of the ops run on whole batches, in place of the copy of the rows of their column into the batch
+  /// \param[in] post_batch_ops Column name to the op run on its batches
+  void SetPostBatchOps(const std::map<std::string, std::shared_ptr<TensorOperation>> &post_batch_ops) {
+    post_batch_ops_ = post_batch_ops;
+  }
 
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
@@ -117,6 +124,7 @@ class BatchNode : public DatasetNode {
   py::function batch_map_func_;
 #endif
   std::map<std::string, std::pair<TensorShape, std::shared_ptr<Tensor>>> pad_map_;
+  std::map<std::string, std::shared_ptr<TensorOperation>> post_batch_ops_;
 };
 
 }  // namespace dataset
@@ -28,23 +28,45 @@ namespace dataset {
 
 // Constructor for ShuffleNode
 ShuffleNode::ShuffleNode(std::shared_ptr<DatasetNode> child, int32_t shuffle_size, bool reset_every_epoch)
-    : shuffle_size_(shuffle_size), shuffle_seed_(GetSeed()), reset_every_epoch_(reset_every_epoch) {
+    : shuffle_size_(shuffle_size),
+      shuffle_seed_(GetSeed()),
+      reset_every_epoch_(reset_every_epoch),
+      num_ranks_(1),
+      rank_(0),
+      exchange_size_(0) {
   this->AddChild(child);
 }
 
 std::shared_ptr<DatasetNode> ShuffleNode::Copy() {
   auto node = std::make_shared<ShuffleNode>(nullptr, shuffle_size_, reset_every_epoch_);
+  node->SetShuffleExchange(exchange_group_, num_ranks_, rank_, exchange_size_);
   return node;
 }
 
 void ShuffleNode::Print(std::ostream &out) const {
   out << Name() + "(shuffle_size:" + std::to_string(shuffle_size_) +
-           ",reset_every_epoch:" + (reset_every_epoch_ ? "true" : "false") + ")";
+           ",reset_every_epoch:" + (reset_every_epoch_ ? "true" : "false");
+  if (!exchange_group_.empty()) {
+    out << ",exchange_group:" + exchange_group_ + ",rank:" + std::to_string(rank_) + "/" + std::to_string(num_ranks_) +
+             ",exchange_size:" + std::to_string(exchange_size_);
+  }
+  out << ")";
 }
 
 // Function to build the ShuffleOp
 Status ShuffleNode::Build(std::vector<std::shared_ptr<DatasetOp>> *const node_ops) {
-  auto op = std::make_shared<ShuffleOp>(shuffle_size_, shuffle_seed_, connector_que_size_, reset_every_epoch_);
+  std::shared_ptr<ShuffleExchange> exchange;
+  std::string host;
+  int32_t port = 0;
+  if (TcpShuffleExchange::ParseGroup(exchange_group_, &host, &port)) {
+    // The ranks run in separate processes and meet at rank 0, whose seed deals the rounds
+    exchange = std::make_shared<TcpShuffleExchange>(host, port, num_ranks_, rank_, GetSeed());
+  } else if (!exchange_group_.empty()) {
+    // The ranks share the seed of the permutations dealing the rounds only through the first one to get there
+    RETURN_IF_NOT_OK(LocalShuffleExchange::GetOrCreate(exchange_group_, num_ranks_, GetSeed(), &exchange));
+  }
+  auto op = std::make_shared<ShuffleOp>(shuffle_size_, shuffle_seed_, connector_que_size_, reset_every_epoch_,
+                                        exchange, rank_, exchange_size_);
   op->set_total_repeats(GetTotalRepeats());
   op->set_num_repeats_per_epoch(GetNumRepeatsPerEpoch());
   node_ops->push_back(op);
@@ -59,6 +81,28 @@ Status ShuffleNode::ValidateParams() {
     MS_LOG(ERROR) << err_msg;
     RETURN_STATUS_SYNTAX_ERROR(err_msg);
   }
+  if (!exchange_group_.empty()) {
+    if (num_ranks_ <= 0 || rank_ < 0 || rank_ >= num_ranks_) {
+      std::string err_msg = "ShuffleNode: Invalid input, rank: " + std::to_string(rank_) +
+                            ", num_ranks: " + std::to_string(num_ranks_);
+      MS_LOG(ERROR) << err_msg;
+      RETURN_STATUS_SYNTAX_ERROR(err_msg);
+    }
+    std::string host;
+    int32_t port = 0;
+    if (exchange_group_.rfind("tcp://", 0) == 0 && !TcpShuffleExchange::ParseGroup(exchange_group_, &host, &port)) {
+      std::string err_msg = "ShuffleNode: Invalid input, exchange_group must be in the form tcp://host:port, got: " +
+                            exchange_group_;
+      MS_LOG(ERROR) << err_msg;
+      RETURN_STATUS_SYNTAX_ERROR(err_msg);
+    }
+    if (exchange_size_ < 1 || exchange_size_ > shuffle_size_) {
+      std::string err_msg = "ShuffleNode: Invalid input, exchange_size must be in range [1, shuffle_size], got: " +
+                            std::to_string(exchange_size_);
+      MS_LOG(ERROR) << err_msg;
+      RETURN_STATUS_SYNTAX_ERROR(err_msg);
+    }
+  }
 
   return Status::OK();
 }
@@ -67,6 +111,12 @@ Status ShuffleNode::to_json(nlohmann::json *out_json) {
   nlohmann::json args;
   args["buffer_size"] = shuffle_size_;
   args["reshuffle_each_epoch"] = reset_every_epoch_;
+  if (!exchange_group_.empty()) {
+    args["exchange_group"] = exchange_group_;
+    args["num_ranks"] = num_ranks_;
+    args["rank"] = rank_;
+    args["exchange_size"] = exchange_size_;
+  }
   *out_json = args;
   return Status::OK();
 }
@@ -53,10 +53,28 @@ class ShuffleNode : public DatasetNode {
 
   Status ValidateParams() override;
 
+  /// \brief Swap rows with the shuffle nodes of the other data parallel ranks, so that the shuffle spans all
+  ///     the shards instead of the rows of this one
+  /// \param group Name shared by the pipelines of all the ranks. A group of the form tcp://host:port is for ranks
+  ///     in separate processes, rank 0 listening on that address. Any other name is for ranks in this process.
+  /// \param num_ranks Number of data parallel ranks
+  /// \param rank Rank of this pipeline
+  /// \param exchange_size Number of rows swapped each time as many new rows entered the shuffle buffer
+  void SetShuffleExchange(const std::string &group, int32_t num_ranks, int32_t rank, int32_t exchange_size) {
+    exchange_group_ = group;
+    num_ranks_ = num_ranks;
+    rank_ = rank;
+    exchange_size_ = exchange_size;
+  }
+
   /// \brief Getter functions
   int32_t ShuffleSize() const { return shuffle_size_; }
   uint32_t ShuffleSeed() const { return shuffle_seed_; }
   bool ResetEveryEpoch() const { return reset_every_epoch_; }
+  const std::string &ExchangeGroup() const { return exchange_group_; }
+  int32_t NumRanks() const { return num_ranks_; }
+  int32_t Rank() const { return rank_; }
+  int32_t ExchangeSize() const { return exchange_size_; }
 
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
@@ -67,6 +85,10 @@ class ShuffleNode : public DatasetNode {
   int32_t shuffle_size_;
   uint32_t shuffle_seed_;
   bool reset_every_epoch_;
+  std::string exchange_group_;  // Empty unless rows are swapped with other ranks
+  int32_t num_ranks_;
+  int32_t rank_;
+  int32_t exchange_size_;
 };
 
 }  // namespace dataset
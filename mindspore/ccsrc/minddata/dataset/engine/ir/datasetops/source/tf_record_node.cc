@@ -22,6 +22,8 @@
 #include <utility>
 #include <vector>
 
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/datasetops/source/tf_reader_op.h"
 #include "minddata/dataset/engine/jagged_connector.h"
 #include "minddata/dataset/engine/opt/pass.h"
@@ -89,6 +91,16 @@ Status TFRecordNode::ValidateParams() {
     return Status(StatusCode::kMDSyntaxError, __LINE__, __FILE__, err_msg);
   }
 
+  // The rows of a shard are counted from whole files, a range of a file has no row count
+  int64_t file_split_size = GlobalContext::config_manager()->file_split_size();
+  if (shard_equal_rows_ && file_split_size > 0) {
+    std::string err_msg = "TFRecordNode: shard_equal_rows can not be used when the file split size is set, got: " +
+                          std::to_string(file_split_size);
+    MS_LOG(ERROR) << err_msg;
+
+    return Status(StatusCode::kMDSyntaxError, __LINE__, __FILE__, err_msg);
+  }
+
   std::vector<std::string> invalid_files(dataset_files_.size());
   auto it = std::copy_if(dataset_files_.begin(), dataset_files_.end(), invalid_files.begin(),
                          [](const std::string &filename) { return !TFReaderOp::ValidateFirstRowCrc(filename); });
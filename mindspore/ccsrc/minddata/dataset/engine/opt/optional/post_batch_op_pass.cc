@@ -0,0 +1,107 @@
+/**
+ * Copyright 2020-2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/engine/opt/optional/post_batch_op_pass.h"
+
+#include "minddata/dataset/engine/ir/datasetops/batch_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_elementwise_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// The map right under the batch, if its ops can be moved into the batch
+std::shared_ptr<MapNode> GetChildMap(const std::shared_ptr<BatchNode> &node) {
+  if (node->Children().size() != 1 || node->IsCached()) {
+    return nullptr;
+  }
+#ifdef ENABLE_PYTHON
+  // The ops must see the rows as they were batched
+  if (node->Pad() || node->BatchMapFunc()) {
+    return nullptr;
+  }
+#endif
+  auto map = std::dynamic_pointer_cast<MapNode>(node->Children()[0]);
+  if (map == nullptr || map->IsCached() || map->Children().size() != 1 || !map->Callbacks().empty() ||
+      !map->ProjectColumns().empty() || map->InputColumns().size() != 1) {
+    return nullptr;
+  }
+  // The column keeps its name, so that the batch finds it
+  if (!map->OutputColumns().empty() && map->OutputColumns() != map->InputColumns()) {
+    return nullptr;
+  }
+  return map;
+}
+}  // namespace
+
+Status PostBatchOpPass::PostBatchNodes::Visit(std::shared_ptr<BatchNode> node, bool *const modified) {
+  *modified = false;
+  auto map = GetChildMap(node);
+  if (map != nullptr && !map->TensorOperations().empty() && IsPostBatchOp(map->TensorOperations().back())) {
+    batch_nodes_.push_back(node);
+  }
+  return Status::OK();
+}
+
+bool PostBatchOpPass::IsPostBatchOp(const std::shared_ptr<TensorOperation> &op) {
+  const std::string name = op->Name();
+  return name == vision::kRescaleOperation || name == vision::kNormalizeOperation ||
+         name == vision::kHwcToChwOperation || name == kTypeCastOperation;
+}
+
+Status PostBatchOpPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  MS_LOG(INFO) << "Optimization pass: post batch op pass started.";
+  auto post_batch_nodes = std::make_unique<PostBatchOpPass::PostBatchNodes>();
+  RETURN_IF_NOT_OK(post_batch_nodes->Run(root_ir, modified));
+
+  for (const auto &batch : post_batch_nodes->batch_nodes()) {
+    auto map = GetChildMap(batch);
+    RETURN_UNEXPECTED_IF_NULL(map);
+    std::vector<std::shared_ptr<TensorOperation>> ops = map->operations();
+    auto itr = std::find_if_not(ops.rbegin(), ops.rend(), IsPostBatchOp).base();
+    std::vector<std::shared_ptr<TensorOperation>> moved(itr, ops.end());
+    ops.erase(itr, ops.end());
+
+    // The moved ops are run by one op, which writes the images into the batch tensor
+    auto fused_ir = std::make_shared<vision::FusedElementwiseOperation>(moved);
+    RETURN_IF_NOT_OK(fused_ir->ValidateParams());
+    const std::string &column = map->InputColumns()[0];
+    std::map<std::string, std::shared_ptr<TensorOperation>> post_batch_ops = batch->PostBatchOps();
+    post_batch_ops[column] = fused_ir;
+    batch->SetPostBatchOps(post_batch_ops);
+    MS_LOG(INFO) << "Moving " << moved.size() << " ops on column " << column << " from the map into the batch.";
+
+    if (ops.empty()) {
+      RETURN_IF_NOT_OK(map->Drop());
+    } else {
+      map->setOperations(ops);
+    }
+    *modified = true;
+  }
+  MS_LOG(INFO) << "Optimization pass: post batch op pass complete.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
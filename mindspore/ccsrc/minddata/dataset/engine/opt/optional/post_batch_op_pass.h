@@ -0,0 +1,70 @@
+/**
+ * Copyright 2020 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_POST_BATCH_OP_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_POST_BATCH_OP_PASS_H_
+
+#include <memory>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+
+/// \class PostBatchOpPass post_batch_op_pass.h
+/// \brief An optional optimization pass moving the trailing element-wise ops of a map into the batch right after
+///     it. BatchOp runs them once per batch, writing every image straight into the batch tensor in place of the
+///     copy of the rows into the batch. A map left without ops is removed.
+class PostBatchOpPass : public IRTreePass {
+  /// \class PostBatchOpPass::PostBatchNodes
+  /// \brief Collects the batches whose child is a map with ops to move
+  class PostBatchNodes : public IRNodePass {
+   public:
+    PostBatchNodes() = default;
+
+    ~PostBatchNodes() = default;
+
+    /// \brief Checks whether the ops of the map under the batch can be moved into it
+    /// \param[in] node The node being visited
+    /// \param[in, out] *modified indicates whether the node has been visited
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<BatchNode> node, bool *const modified) override;
+
+    std::vector<std::shared_ptr<BatchNode>> batch_nodes() { return batch_nodes_; }
+
+   private:
+    std::vector<std::shared_ptr<BatchNode>> batch_nodes_;
+  };
+
+ public:
+  PostBatchOpPass() = default;
+
+  ~PostBatchOpPass() = default;
+
+  /// \brief Walks the tree to collect the batches, then moves the ops of their maps into them
+  /// \param[in] root_ir The root of the tree
+  /// \param[in, out] *modified indicates whether the tree has been changed
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+
+  /// \brief Checks whether BatchOp can run an op on whole batches
+  /// \param[in] op The op of the map
+  /// \return true if the op works on each element of its column alone
+  static bool IsPostBatchOp(const std::shared_ptr<TensorOperation> &op);
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_OPTIONAL_POST_BATCH_OP_PASS_H_
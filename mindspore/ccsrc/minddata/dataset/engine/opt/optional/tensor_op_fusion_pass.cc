@@ -21,15 +21,31 @@
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 
 #include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_and_resize_op.h"
 #include "minddata/dataset/kernels/image/random_crop_decode_resize_op.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
 #include "minddata/dataset/kernels/ir/data/transforms_ir.h"
 #include "minddata/dataset/kernels/ir/vision/decode_ir.h"
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_elementwise_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_crop_decode_resize_ir.h"
 #include "minddata/dataset/kernels/ir/vision/random_resized_crop_ir.h"
+#include "minddata/dataset/kernels/ir/vision/resize_ir.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+// The fused crop is decoded at the smallest libjpeg DCT scale that is not smaller than the target size
+constexpr bool kDctScaling = true;
+
+// Whether the pre-built decode op decodes the image to RGB
+bool IsRgbDecode(const std::shared_ptr<TensorOp> &op) {
+  auto decode_op = std::dynamic_pointer_cast<DecodeOp>(op);
+  return decode_op != nullptr && decode_op->IsRgbFormat();
+}
+}  // namespace
 
 Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
   std::vector<std::shared_ptr<TensorOperation>> ops = node->operations();
@@ -42,7 +58,22 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
     MS_LOG(WARNING) << "Fusing pre-build Decode and RandomCropResize into one pre-build.";
     auto fused_op = dynamic_cast<RandomCropAndResizeOp *>((*(itr + 1))->Build().get());
     RETURN_UNEXPECTED_IF_NULL(fused_op);
-    (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<RandomCropDecodeResizeOp>(*fused_op));
+    (*itr) = std::make_shared<transforms::PreBuiltOperation>(
+      std::make_shared<RandomCropDecodeResizeOp>(*fused_op, kDctScaling));
+    ops.erase(itr + 1);
+    node->setOperations(ops);
+    *modified = true;
+    return Status::OK();
+  }
+  pattern = {kDecodeOp, kResizeOp};
+  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+                    [](auto op, const std::string &nm) { return op->Name() == nm; });
+  // DecodeResizeOp always decodes to RGB, so a Decode into BGR is left as it is
+  if (itr != ops.end() && IsRgbDecode((*itr)->Build())) {
+    MS_LOG(WARNING) << "Fusing pre-build Decode and Resize into one pre-build.";
+    auto fused_op = dynamic_cast<ResizeOp *>((*(itr + 1))->Build().get());
+    RETURN_UNEXPECTED_IF_NULL(fused_op);
+    (*itr) = std::make_shared<transforms::PreBuiltOperation>(std::make_shared<DecodeResizeOp>(*fused_op));
     ops.erase(itr + 1);
     node->setOperations(ops);
     *modified = true;
@@ -53,16 +84,53 @@ Status TensorOpFusionPass::Visit(std::shared_ptr<MapNode> node, bool *const modi
   pattern = {vision::kDecodeOperation, vision::kRandomResizedCropOperation};
   itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
                     [](auto op, const std::string &nm) { return op->Name() == nm; });
+  if (itr != ops.end()) {
+    auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops
+    (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir, kDctScaling);
+    ops.erase(itr + 1);
+    *modified = true;
+  }
+  pattern = {vision::kDecodeOperation, vision::kResizeOperation};
+  itr = std::search(ops.begin(), ops.end(), pattern.begin(), pattern.end(),
+                    [](auto op, const std::string &nm) { return op->Name() == nm; });
+  auto *decode_ir = itr != ops.end() ? dynamic_cast<vision::DecodeOperation *>(itr->get()) : nullptr;
+  if (decode_ir != nullptr && decode_ir->rgb()) {
+    auto *fused_ir = dynamic_cast<vision::ResizeOperation *>((itr + 1)->get());
+    RETURN_UNEXPECTED_IF_NULL(fused_ir);
+    // fuse the two ops, the jpeg image is decoded at the smallest DCT scale that is not smaller than the resize
+    (*itr) = std::make_shared<vision::DecodeResizeOperation>(*fused_ir);
+    ops.erase(itr + 1);
+    *modified = true;
+  }
 
-  // return here if no pattern is found
-  RETURN_OK_IF_TRUE(itr == ops.end());
-  auto *fused_ir = dynamic_cast<vision::RandomResizedCropOperation *>((itr + 1)->get());
-  RETURN_UNEXPECTED_IF_NULL(fused_ir);
-  // fuse the two ops
-  (*itr) = std::make_shared<vision::RandomCropDecodeResizeOperation>(*fused_ir);
-  ops.erase(itr + 1);
-  node->setOperations(ops);
-  *modified = true;
+  RETURN_IF_NOT_OK(FuseElementwiseOps(&ops, modified));
+  if (*modified) {
+    node->setOperations(ops);
+  }
+  return Status::OK();
+}
+
+Status TensorOpFusionPass::FuseElementwiseOps(std::vector<std::shared_ptr<TensorOperation>> *ops,
+                                              bool *const modified) {
+  auto itr = ops->begin();
+  while (itr != ops->end()) {
+    itr = std::find_if(itr, ops->end(), vision::FusedElementwiseOperation::IsFusible);
+    auto run_end = std::find_if_not(itr, ops->end(), vision::FusedElementwiseOperation::IsFusible);
+    // a single op gains nothing from the fusion
+    if (run_end - itr < 2) {
+      itr = run_end;
+      continue;
+    }
+    std::vector<std::shared_ptr<TensorOperation>> run(itr, run_end);
+    auto fused_ir = std::make_shared<vision::FusedElementwiseOperation>(run);
+    RETURN_IF_NOT_OK(fused_ir->ValidateParams());
+    MS_LOG(INFO) << "Fusing " << run.size() << " element-wise ops into one " << fused_ir->Name() << " op.";
+    (*itr) = fused_ir;
+    itr = ops->erase(itr + 1, run_end);
+    *modified = true;
+  }
   return Status::OK();
 }
 }  // namespace dataset
@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TENSOR_OP_FUSION_PASS_H_
 
 #include <memory>
+#include <vector>
 #include "minddata/dataset/engine/opt/pass.h"
 
 namespace mindspore {
@@ -31,6 +32,12 @@ class TensorOpFusionPass : public IRNodePass {
   /// \param[in, out] *modified indicates whether the node has been visited
   /// \return Status The status code returned
   Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+  /// \brief Replaces every run of two or more adjacent element-wise ops by a single FusedElementwise op
+  /// \param[in, out] ops The tensor ops of the MapOp
+  /// \param[in, out] *modified indicates whether the ops have been changed
+  /// \return Status The status code returned
+  Status FuseElementwiseOps(std::vector<std::shared_ptr<TensorOperation>> *ops, bool *const modified);
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,221 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/perf/auto_tune.h"
+
+#include <algorithm>
+#include <thread>
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/parallel_op.h"
+#include "minddata/dataset/engine/execution_tree.h"
+#include "minddata/dataset/util/task_manager.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+double FillRatio(int32_t size, int32_t capacity) {
+  return capacity > 0 ? static_cast<double>(size) / static_cast<double>(capacity) : 0.0;
+}
+}  // namespace
+
+AutoTune::AutoTune(ExecutionTree *tree)
+    : tree_(tree),
+      feed_op_(nullptr),
+      device_cpu_(std::make_unique<DeviceCpu>()),
+      num_samples_(0),
+      num_empty_(0),
+      num_full_(0),
+      last_out_rows_(0),
+      step_(0) {
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  sampling_interval_ = std::max<int64_t>(1, cfg->autotune_interval() / kAutoTuneSamplesPerStep);
+}
+
+void AutoTune::Init() {
+  std::shared_ptr<DatasetOp> op = tree_->root();
+  // DeviceQueueOp has no valid output connector, the data sent to the device comes from its child
+  if (op->Name() == kDeviceQueueOp && !op->Children().empty()) {
+    op = op->child(0);
+  }
+  while (op->inlined() && !op->Children().empty()) {
+    op = op->child(0);
+  }
+  feed_op_ = op.get();
+  last_out_rows_ = feed_op_->ConnectorOutRowsCount();
+
+  for (auto &node : *tree_) {
+    auto parallel_op = dynamic_cast<ParallelOp *>(&node);
+    if (parallel_op != nullptr && parallel_op->dynamic_workers() && !parallel_op->Children().empty()) {
+      tunable_ops_.push_back({parallel_op, parallel_op->target_num_workers(), false, 0.0, 0.0});
+      MS_LOG(INFO) << "[AutoTune] " << parallel_op->NameWithID() << " starts with "
+                   << parallel_op->target_num_workers() << " workers, at most " << parallel_op->max_num_workers()
+                   << ".";
+    }
+  }
+  (void)device_cpu_->Collect(tree_);
+}
+
+void AutoTune::Sample() {
+  int32_t size = feed_op_->ConnectorSize();
+  int32_t capacity = feed_op_->ConnectorCapacity();
+  num_empty_ += (size == 0) ? 1 : 0;
+  num_full_ += (capacity > 0 && size >= capacity) ? 1 : 0;
+  for (auto &tunable : tunable_ops_) {
+    tunable.out_fill_sum += FillRatio(tunable.op->ConnectorSize(), tunable.op->ConnectorCapacity());
+    tunable.in_fill_sum += FillRatio(tunable.op->ChildOpConnectorSize(), tunable.op->ChildOpConnectorCapacity());
+  }
+  num_samples_++;
+}
+
+void AutoTune::ResetStats() {
+  num_samples_ = 0;
+  num_empty_ = 0;
+  num_full_ = 0;
+  for (auto &tunable : tunable_ops_) {
+    tunable.in_fill_sum = 0.0;
+    tunable.out_fill_sum = 0.0;
+  }
+}
+
+Status AutoTune::Step(double elapsed) {
+  step_++;
+  int64_t out_rows = feed_op_->ConnectorOutRowsCount();
+  double throughput = elapsed > 0 ? static_cast<double>(out_rows - last_out_rows_) / elapsed : 0.0;
+  last_out_rows_ = out_rows;
+  RETURN_IF_NOT_OK(device_cpu_->Collect(tree_));
+  // Nothing flowed to the consumer, e.g. the pipeline is starting up or waiting at the end of an epoch
+  if (num_samples_ == 0 || throughput <= 0) {
+    return Status::OK();
+  }
+  double starvation = static_cast<double>(num_empty_) / num_samples_;
+  MS_LOG(DEBUG) << "[AutoTune] step " << step_ << ": throughput " << throughput << " rows/s, starvation "
+                << starvation << ", cpu utilization " << device_cpu_->GetLastUtilization() << "%.";
+
+  if (last_action_ != nullptr) {
+    TunableOp *target = last_action_->target;
+    double prev_throughput = last_action_->throughput;
+    last_action_.reset();
+    if (throughput < prev_throughput * (1 + kAutoTuneMinThroughputGain)) {
+      int32_t num_workers = target->op->target_num_workers() - 1;
+      RETURN_IF_NOT_OK(target->op->SetNumWorkers(num_workers));
+      target->frozen = true;
+      MS_LOG(INFO) << "[AutoTune] step " << step_ << ": throughput went from " << prev_throughput << " to "
+                   << throughput << " rows/s, reverting " << target->op->NameWithID() << " to " << num_workers
+                   << " workers and no longer growing it.";
+      return Status::OK();
+    }
+    MS_LOG(INFO) << "[AutoTune] step " << step_ << ": throughput went from " << prev_throughput << " to "
+                 << throughput << " rows/s, keeping " << target->op->target_num_workers() << " workers for "
+                 << target->op->NameWithID() << ".";
+  }
+
+  if (starvation > kAutoTuneStarvationTarget) {
+    return Grow(throughput);
+  }
+  return Shrink();
+}
+
+Status AutoTune::Grow(double throughput) {
+  double starvation = static_cast<double>(num_empty_) / num_samples_;
+  double full_ratio = static_cast<double>(num_full_) / num_samples_;
+  // The producer keeps up on average but the connector alternates between empty and full, give it more room
+  int32_t queue_size = feed_op_->ConnectorQueueSize();
+  if (full_ratio > kAutoTuneBurstyRatio && queue_size < kAutoTuneMaxQueueSize) {
+    int32_t new_size = std::min(queue_size * 2, kAutoTuneMaxQueueSize);
+    RETURN_IF_NOT_OK(feed_op_->SetConnectorQueueSize(new_size));
+    MS_LOG(INFO) << "[AutoTune] step " << step_ << ": output connector of " << feed_op_->NameWithID()
+                 << " is empty in " << starvation << " and full in " << full_ratio
+                 << " of the samples, growing its queue size from " << queue_size << " to " << new_size << ".";
+    return Status::OK();
+  }
+
+  // The bottleneck is the op that has the most rows waiting at its input compared to its output
+  TunableOp *bottleneck = nullptr;
+  double max_gap = 0.0;
+  for (auto &tunable : tunable_ops_) {
+    double in_fill = tunable.in_fill_sum / num_samples_;
+    double out_fill = tunable.out_fill_sum / num_samples_;
+    if (!tunable.frozen && in_fill >= kAutoTuneBusyInputFill && in_fill - out_fill > max_gap) {
+      max_gap = in_fill - out_fill;
+      bottleneck = &tunable;
+    }
+  }
+  if (bottleneck == nullptr) {
+    MS_LOG(DEBUG) << "[AutoTune] step " << step_ << ": consumer is starved in " << starvation
+                  << " of the samples but no tunable op is the bottleneck.";
+    return Status::OK();
+  }
+
+  ParallelOp *op = bottleneck->op;
+  int32_t num_workers = op->target_num_workers();
+  int32_t cpu_util = device_cpu_->GetLastUtilization();
+  if (cpu_util >= kAutoTuneMaxCpuUtil) {
+    MS_LOG(DEBUG) << "[AutoTune] step " << step_ << ": " << op->NameWithID() << " is the bottleneck but cpu "
+                  << "utilization is already " << cpu_util << "%.";
+    return Status::OK();
+  }
+  if (num_workers >= op->max_num_workers()) {
+    MS_LOG(DEBUG) << "[AutoTune] step " << step_ << ": " << op->NameWithID() << " is the bottleneck but already has "
+                  << num_workers << " workers.";
+    return Status::OK();
+  }
+  RETURN_IF_NOT_OK(op->SetNumWorkers(num_workers + 1));
+  last_action_ = std::make_unique<Action>(Action{bottleneck, throughput});
+  MS_LOG(INFO) << "[AutoTune] step " << step_ << ": consumer is starved in " << starvation << " of the samples at "
+               << throughput << " rows/s, " << op->NameWithID() << " is the bottleneck, growing it from "
+               << num_workers << " to " << num_workers + 1 << " workers.";
+  return Status::OK();
+}
+
+Status AutoTune::Shrink() {
+  for (auto &tunable : tunable_ops_) {
+    int32_t num_workers = tunable.op->target_num_workers();
+    double out_fill = tunable.out_fill_sum / num_samples_;
+    // Only take back the workers that the autotuner has added
+    if (num_workers > tunable.initial_workers && out_fill >= kAutoTuneIdleOutputFill) {
+      RETURN_IF_NOT_OK(tunable.op->SetNumWorkers(num_workers - 1));
+      MS_LOG(INFO) << "[AutoTune] step " << step_ << ": output connector of " << tunable.op->NameWithID()
+                   << " is " << out_fill << " full on average, shrinking it from " << num_workers << " to "
+                   << num_workers - 1 << " workers.";
+    }
+  }
+  return Status::OK();
+}
+
+Status AutoTune::operator()() {
+  // Register this thread with TaskManager to receive proper interrupt signal.
+  TaskManager::FindMe()->Post();
+  Init();
+  if (tunable_ops_.empty()) {
+    MS_LOG(INFO) << "[AutoTune] no op of the tree can change its number of workers, nothing to tune.";
+    return Status::OK();
+  }
+
+  auto step_begin = std::chrono::steady_clock::now();
+  while (!this_thread::is_interrupted() && !(tree_->isFinished())) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(sampling_interval_));
+    Sample();
+    if (num_samples_ == kAutoTuneSamplesPerStep) {
+      auto now = std::chrono::steady_clock::now();
+      RETURN_IF_NOT_OK(Step(std::chrono::duration<double>(now - step_begin).count()));
+      ResetStats();
+      step_begin = now;
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
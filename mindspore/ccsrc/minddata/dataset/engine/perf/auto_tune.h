@@ -0,0 +1,120 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
+
+#include <chrono>
+#include <memory>
+#include <vector>
+#include "minddata/dataset/engine/perf/cpu_sampling.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetOp;
+class ExecutionTree;
+class ParallelOp;
+
+// The feed connector is starving if it is found empty in more than this ratio of the samples
+constexpr double kAutoTuneStarvationTarget = 0.1;
+// The feed connector is bursty if, while starving, it is also found full in more than this ratio of the samples
+constexpr double kAutoTuneBurstyRatio = 0.2;
+// An op is a bottleneck candidate if its input connector is at least this full on average
+constexpr double kAutoTuneBusyInputFill = 0.5;
+// An op has more workers than needed if its output connector is at least this full on average
+constexpr double kAutoTuneIdleOutputFill = 0.9;
+// A new worker has to improve the feed throughput by at least this ratio to be kept
+constexpr double kAutoTuneMinThroughputGain = 0.05;
+// Workers are not added when the device CPU utilization (in percent) reaches this value
+constexpr int32_t kAutoTuneMaxCpuUtil = 90;
+// Upper bound of the per queue size the feed connector can be grown to
+constexpr int32_t kAutoTuneMaxQueueSize = 128;
+// Number of samples taken within one autotune step
+constexpr int32_t kAutoTuneSamplesPerStep = 10;
+
+// AutoTune is a closed loop tuner that runs next to the ExecutionTree. Every autotune interval it looks at
+// how often the connector feeding the device queue (or the iterator) ran empty. When the consumer is starved,
+// a worker is added to the MapOp/BatchOp that looks like the bottleneck, i.e. whose input connector is full
+// while its output connector is not, and the addition is reverted if the feed throughput does not improve.
+// A bursty feed connector is grown instead. When the consumer is not starved, workers added earlier are taken
+// back from ops whose output connector stays full. Every decision is logged.
+class AutoTune {
+ public:
+  // AutoTune object constructor
+  // @param tree - The ExecutionTree to tune, which must have been launched with dynamic workers enabled
+  explicit AutoTune(ExecutionTree *tree);
+
+  ~AutoTune() = default;
+
+  // Functor for the AutoTune main loop.
+  // This function will be the entry point of mindspore::Dataset::Task
+  Status operator()();
+
+ private:
+  // Statistics of a tunable op collected over one step
+  struct TunableOp {
+    ParallelOp *op;
+    int32_t initial_workers;
+    bool frozen;  // Set once adding a worker to this op did not pay off
+    double in_fill_sum;
+    double out_fill_sum;
+  };
+
+  // The last change of number of workers, evaluated at the next step
+  struct Action {
+    TunableOp *target;
+    double throughput;
+  };
+
+  // Find the tunable ops and the op whose output connector feeds the consumer of the tree
+  void Init();
+
+  // Take one sample of the connectors
+  void Sample();
+
+  // Evaluate the samples of the step which just finished and make a decision
+  // @param elapsed - The duration of the step in seconds
+  // @return Status The status code returned
+  Status Step(double elapsed);
+
+  // Reset the statistics before a new step
+  void ResetStats();
+
+  // Try to add a worker to the bottleneck op, or grow the feed connector if it is bursty
+  // @param throughput - The feed throughput of the step which just finished
+  // @return Status The status code returned
+  Status Grow(double throughput);
+
+  // Take back the workers that are no longer needed
+  // @return Status The status code returned
+  Status Shrink();
+
+  ExecutionTree *tree_;
+  DatasetOp *feed_op_;
+  std::vector<TunableOp> tunable_ops_;
+  std::unique_ptr<DeviceCpu> device_cpu_;
+  std::unique_ptr<Action> last_action_;
+  int64_t sampling_interval_;
+  int32_t num_samples_;
+  int32_t num_empty_;
+  int32_t num_full_;
+  int64_t last_out_rows_;
+  int64_t step_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_H_
@@ -177,6 +177,13 @@ Status DeviceCpu::Analyze(std::string *name, double *utilization, std::string *e
   return Status::OK();
 }
 
+int32_t DeviceCpu::GetLastUtilization() const {
+  if (cpu_util_.empty()) {
+    return 0;
+  }
+  return cpu_util_.back().user_utilization_ + cpu_util_.back().sys_utilization_;
+}
+
 Status DeviceCpu::SaveToFile(const std::string &file_path) {
   Path path = Path(file_path);
   json output;
@@ -95,6 +95,9 @@ class DeviceCpu : public BaseCpu {
   Status SaveToFile(const std::string &file_path) override;
   Status Analyze(std::string *name, double *utilization, std::string *extra_message) override;
 
+  // Get the user plus sys utilization (in percent) of the most recent collection, 0 if there is none yet
+  int32_t GetLastUtilization() const;
+
  private:
   // Get CPU information, include use/sys/idle/io utilization
   Status ParseCpuInfo(const std::string &str);
@@ -19,6 +19,7 @@
 #include "minddata/dataset/core/client.h"
 #include "minddata/dataset/engine/ir/datasetops/root_node.h"
 #ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/opt/optional/post_batch_op_pass.h"
 #include "minddata/dataset/engine/opt/optional/tensor_op_fusion_pass.h"
 #include "minddata/dataset/engine/opt/pre/cache_transform_pass.h"
 #include "minddata/dataset/engine/opt/post/repeat_pass.h"
@@ -74,9 +75,11 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
 
 Status TreeAdapter::Optimize(std::shared_ptr<DatasetNode> ir) {
   // Vector of optimizations
-  std::vector<std::unique_ptr<IRNodePass>> optimizations;
+  std::vector<std::unique_ptr<IRPass>> optimizations;
   MS_LOG(INFO) << "Running optimization pass loops";
 #ifndef ENABLE_ANDROID
+  // The ops moved into a batch are no longer fused with the rest of their map
+  optimizations.emplace_back(std::make_unique<PostBatchOpPass>());
   optimizations.emplace_back(std::make_unique<TensorOpFusionPass>());
 #endif
   // Apply optimization pass actions
@@ -36,7 +36,7 @@ enum class DatasetType { kUnknown, kArrow, kTf };
 enum class TensorImpl { kNone, kFlexible, kCv, kNP };
 
 /// \brief Possible values for shuffle
-enum class ShuffleMode { kFalse = 0, kFiles = 1, kGlobal = 2, kInfile = 3 };
+enum class ShuffleMode { kFalse = 0, kFiles = 1, kGlobal = 2, kInfile = 3, kBlock = 4 };
 
 /// \brief Possible values for Border types
 enum class BorderType { kConstant = 0, kEdge = 1, kReflect = 2, kSymmetric = 3 };
@@ -109,6 +109,12 @@ constexpr char kCfgDefaultCacheHost[] = "127.0.0.1";
 constexpr int32_t kDftPrefetchSize = 20;
 constexpr int32_t kDftNumConnections = 12;
 constexpr int32_t kDftAutoNumWorkers = false;
+constexpr bool kDftEnableAutotune = false;
+constexpr uint32_t kCfgAutotuneInterval = 100;  // interval between two autotune steps in milliseconds
+constexpr bool kDftEnableTensorPool = false;
+constexpr int32_t kTensorPoolMaxCachedSize = 1024;  // memory in MB kept for reuse by the tensor pool of a pipeline
+constexpr int32_t kTensorPoolArenaSize = 64;        // size in MB of the arenas of the tensor pool of a pipeline
+constexpr int64_t kDftFileSplitSize = 0;            // bytes of a file read by one worker, 0 to read whole files
 constexpr char kDftMetaColumnPrefix[] = "_meta-";
 constexpr int32_t kDecimal = 10;  // used in strtol() to convert a string value according to decimal numeral system
 constexpr int32_t kMinLegalPort = 1025;
@@ -1290,6 +1290,7 @@ class MindDataDataset : public Dataset {
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the current MindDataDataset.
 inline std::shared_ptr<MindDataDataset> MindData(
@@ -1315,6 +1316,7 @@ inline std::shared_ptr<MindDataDataset> MindData(
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> MindData(const std::string &dataset_file,
@@ -1339,6 +1341,7 @@ inline std::shared_ptr<MindDataDataset> MindData(const std::string &dataset_file
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> MindData(const std::string &dataset_file,
@@ -1365,6 +1368,7 @@ inline std::shared_ptr<MindDataDataset> MindData(const std::string &dataset_file
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
@@ -1390,6 +1394,7 @@ inline std::shared_ptr<MindDataDataset> MindData(
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> MindData(const std::vector<std::string> &dataset_files,
@@ -1414,6 +1419,7 @@ inline std::shared_ptr<MindDataDataset> MindData(const std::vector<std::string>
 ///    ShuffleMode::kFiles - Shuffle files only.
 ///    ShuffleMode::kGlobal - Shuffle both the files and samples.
 ///    ShuffleMode::kInfile - Shuffle samples in file.
+///    ShuffleMode::kBlock - Shuffle the blob pages, then the samples within a window of pages.
 /// \param[in] cache Tensor cache to use (default=nullptr which means no cache is used).
 /// \return Shared pointer to the MindDataDataset.
 inline std::shared_ptr<MindDataDataset> MindData(const std::vector<std::string> &dataset_files,
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+
+#include "minddata/dataset/kernels/image/decode_op.h"
+
+namespace mindspore {
+namespace dataset {
+Status DecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  if (!IsNonEmptyJPEG(input)) {
+    DecodeOp op(true);
+    std::shared_ptr<Tensor> decoded;
+    RETURN_IF_NOT_OK(op.Compute(input, &decoded));
+    return ResizeOp::Compute(decoded, output);
+  }
+  int h_in = 0;
+  int w_in = 0;
+  RETURN_IF_NOT_OK(GetJpegImageInfo(input, &w_in, &h_in));
+  // the output size is found from the full size image, so that it is the same as Decode followed by Resize
+  int32_t output_h = 0;
+  int32_t output_w = 0;
+  RETURN_IF_NOT_OK(GetOutputSize(h_in, w_in, &output_h, &output_w));
+  int scale_denom = GetJpegScaleDenom(w_in, h_in, output_w, output_h);
+
+  std::shared_ptr<Tensor> decoded;
+  RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, 0, 0, 0, 0, scale_denom));
+  return Resize(decoded, output, output_h, output_w, 0, 0, interpolation_);
+}
+
+Status DecodeResizeOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputShape(inputs, outputs));
+  outputs.clear();
+  int32_t output_h = -1;
+  int32_t output_w = -1;
+  // if size2_ == 0, the output shape depends on the size of the image
+  if (size2_ != 0) {
+    output_h = size1_;
+    output_w = size2_;
+  }
+  constexpr int32_t kOutNumComponents = 3;
+  if (inputs[0].Rank() == 1) outputs.emplace_back(TensorShape({output_h, output_w, kOutNumComponents}));
+  if (!outputs.empty()) return Status::OK();
+  return Status(StatusCode::kMDUnexpectedError, "DecodeResize: invalid input shape.");
+}
+
+Status DecodeResizeOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
+  outputs[0] = DataType(DataType::DE_UINT8);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
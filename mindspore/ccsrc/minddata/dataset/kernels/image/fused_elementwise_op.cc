@@ -0,0 +1,517 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/image/fused_elementwise_op.h"
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
+#include "minddata/dataset/util/random.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int64_t kNumByteValues = 256;
+
+// Where the elements of the input go in the output
+struct Layout {
+  int64_t height;
+  int64_t width;
+  int64_t channels;
+  bool flip_h;
+  bool flip_v;
+  bool to_chw;
+};
+
+bool IsSupportedType(const DataType &type) {
+  switch (type.value()) {
+    case DataType::DE_INT8:
+    case DataType::DE_UINT8:
+    case DataType::DE_INT16:
+    case DataType::DE_UINT16:
+    case DataType::DE_INT32:
+    case DataType::DE_UINT32:
+    case DataType::DE_FLOAT32:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// A TypeCast may also give float16, as the last value stage
+bool IsSupportedOutputType(const DataType &type) { return IsSupportedType(type) || type == DataType::DE_FLOAT16; }
+
+// The values of all the supported types are held exactly in a double. A cast is done from the type the value
+// had before it, a float or an integer, so that it gives the same result as TypeCast.
+template <typename T>
+double CastAs(double value, bool is_float) {
+  if (is_float) {
+    return static_cast<double>(static_cast<T>(static_cast<float>(value)));
+  }
+  return static_cast<double>(static_cast<T>(static_cast<int64_t>(value)));
+}
+
+double CastValue(double value, bool is_float, const DataType &type) {
+  switch (type.value()) {
+    case DataType::DE_INT8:
+      return CastAs<int8_t>(value, is_float);
+    case DataType::DE_UINT8:
+      return CastAs<uint8_t>(value, is_float);
+    case DataType::DE_INT16:
+      return CastAs<int16_t>(value, is_float);
+    case DataType::DE_UINT16:
+      return CastAs<uint16_t>(value, is_float);
+    case DataType::DE_INT32:
+      return CastAs<int32_t>(value, is_float);
+    case DataType::DE_UINT32:
+      return CastAs<uint32_t>(value, is_float);
+    case DataType::DE_FLOAT16: {
+      float16 result = is_float ? static_cast<float16>(static_cast<float>(value))
+                                : static_cast<float16>(static_cast<int64_t>(value));
+      return static_cast<double>(static_cast<float>(result));
+    }
+    default:
+      return CastAs<float>(value, is_float);
+  }
+}
+
+// Apply the value stages to one element, rounding to the output type of every stage like the original ops do
+double ApplyStages(double value, bool is_float, int64_t channel, const std::vector<ElementwiseStage> &stages) {
+  for (const auto &stage : stages) {
+    switch (stage.type) {
+      case ElementwiseStage::Type::kRescale: {
+        float result = static_cast<float>(value) * stage.rescale + stage.shift;
+        value = result;
+        is_float = true;
+        break;
+      }
+      case ElementwiseStage::Type::kNormalize: {
+        size_t i = stage.std.size() == 1 ? 0 : static_cast<size_t>(channel);
+        float result = static_cast<float>(value) / stage.std[i] - stage.mean[i];
+        value = result;
+        is_float = true;
+        break;
+      }
+      case ElementwiseStage::Type::kTypeCast:
+        value = CastValue(value, is_float, stage.data_type);
+        is_float = stage.data_type == DataType::DE_FLOAT32 || stage.data_type == DataType::DE_FLOAT16;
+        break;
+      default:
+        break;
+    }
+  }
+  return value;
+}
+
+// Walk the input row by row and write every element, transformed by func, where the flips and the layout put it
+template <typename In, typename Out, typename F>
+void Remap(const In *src, Out *dst, const Layout &layout, F func) {
+  const int64_t height = layout.height;
+  const int64_t width = layout.width;
+  const int64_t channels = layout.channels;
+  const int64_t x_stride = layout.to_chw ? 1 : channels;
+  const int64_t c_stride = layout.to_chw ? height * width : 1;
+  const int64_t row_stride = layout.to_chw ? width : width * channels;
+  const int64_t step = layout.flip_h ? -x_stride : x_stride;
+  for (int64_t y = 0; y < height; y++) {
+    const In *src_row = src + y * width * channels;
+    int64_t dst_y = layout.flip_v ? height - 1 - y : y;
+    Out *dst_row = dst + dst_y * row_stride + (layout.flip_h ? (width - 1) * x_stride : 0);
+    for (int64_t x = 0; x < width; x++) {
+      const In *src_pixel = src_row + x * channels;
+      Out *dst_pixel = dst_row + x * step;
+      for (int64_t c = 0; c < channels; c++) {
+        dst_pixel[c * c_stride] = func(src_pixel[c], c);
+      }
+    }
+  }
+}
+
+// One value stage of a float image on one channel: x = x * a + b, or x = x / a + b for a Normalize
+struct PlanarStep {
+  bool divide;
+  float a;
+  float b;
+};
+
+// Find the steps of every channel, or return false if a stage is not a Rescale, a Normalize or a cast to float
+bool GetPlanarSteps(const std::vector<ElementwiseStage> &stages, int64_t channels,
+                    std::vector<std::vector<PlanarStep>> *steps) {
+  steps->assign(channels, {});
+  for (const auto &stage : stages) {
+    for (int64_t c = 0; c < channels; c++) {
+      if (stage.type == ElementwiseStage::Type::kRescale) {
+        (*steps)[c].push_back({false, stage.rescale, stage.shift});
+      } else if (stage.type == ElementwiseStage::Type::kNormalize) {
+        size_t i = stage.std.size() == 1 ? 0 : static_cast<size_t>(c);
+        (*steps)[c].push_back({true, stage.std[i], -stage.mean[i]});
+      } else if (stage.type != ElementwiseStage::Type::kTypeCast || stage.data_type != DataType::DE_FLOAT32) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool SameSteps(const std::vector<PlanarStep> &lhs, const std::vector<PlanarStep> &rhs) {
+  return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), [](const PlanarStep &l, const PlanarStep &r) {
+    return l.divide == r.divide && l.a == r.a && l.b == r.b;
+  });
+}
+
+// Apply the steps to n contiguous floats in place, 8 or 4 at a time where AVX2 or NEON is available. The multiply,
+// divide and add are separate instructions, so that the result is rounded like the original ops.
+void ApplyPlanarSteps(float *data, int64_t n, const std::vector<PlanarStep> &steps) {
+  int64_t i = 0;
+#if defined(__AVX2__)
+  constexpr int64_t kLanes = 8;
+  for (; i + kLanes <= n; i += kLanes) {
+    __m256 v = _mm256_loadu_ps(data + i);
+    for (const auto &step : steps) {
+      __m256 a = _mm256_set1_ps(step.a);
+      v = step.divide ? _mm256_div_ps(v, a) : _mm256_mul_ps(v, a);
+      v = _mm256_add_ps(v, _mm256_set1_ps(step.b));
+    }
+    _mm256_storeu_ps(data + i, v);
+  }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  constexpr int64_t kLanes = 4;
+  for (; i + kLanes <= n; i += kLanes) {
+    float32x4_t v = vld1q_f32(data + i);
+    for (const auto &step : steps) {
+      float32x4_t a = vdupq_n_f32(step.a);
+      v = step.divide ? vdivq_f32(v, a) : vmulq_f32(v, a);
+      v = vaddq_f32(v, vdupq_n_f32(step.b));
+    }
+    vst1q_f32(data + i, v);
+  }
+#endif
+  for (; i < n; i++) {
+    float v = data[i];
+    for (const auto &step : steps) {
+      v = step.divide ? v / step.a : v * step.a;
+      v = v + step.b;
+    }
+    data[i] = v;
+  }
+}
+
+// Only a float image which is only rescaled and normalized is transformed plane by plane
+template <typename In, typename Out>
+bool FuseImagePlanar(const In *src, Out *dst, const Layout &layout, const std::vector<ElementwiseStage> &stages) {
+  return false;
+}
+
+// The elements are moved where the flips and the layout put them, then every channel plane is transformed at once.
+// In <H,W,C> a plane is the whole image, so the channels must all have the same steps.
+template <>
+bool FuseImagePlanar<float, float>(const float *src, float *dst, const Layout &layout,
+                                   const std::vector<ElementwiseStage> &stages) {
+  std::vector<std::vector<PlanarStep>> steps;
+  if (!GetPlanarSteps(stages, layout.channels, &steps)) {
+    return false;
+  }
+  const int64_t plane_size = layout.height * layout.width;
+  if (!layout.to_chw && std::any_of(steps.begin(), steps.end(), [&steps](const std::vector<PlanarStep> &s) {
+        return !SameSteps(s, steps[0]);
+      })) {
+    return false;
+  }
+  Remap(src, dst, layout, [](float v, int64_t) { return v; });
+  if (layout.to_chw) {
+    for (int64_t c = 0; c < layout.channels; c++) {
+      ApplyPlanarSteps(dst + c * plane_size, plane_size, steps[c]);
+    }
+  } else {
+    ApplyPlanarSteps(dst, plane_size * layout.channels, steps[0]);
+  }
+  return true;
+}
+
+// Write every image one after the other into dst, each one where its own flips put its elements
+template <typename In, typename Out>
+void FuseImages(const std::vector<std::shared_ptr<Tensor>> &inputs, Out *dst, const std::vector<Layout> &layouts,
+                const std::vector<ElementwiseStage> &stages) {
+  const int64_t image_size = inputs[0]->shape().NumOfElements();
+  const bool is_float = std::is_floating_point<In>::value;
+  std::vector<Out> table;
+  if (sizeof(In) == 1) {
+    // An 8 bit input has few enough values to evaluate the stages once per value and channel, for the whole batch
+    const int64_t channels = layouts[0].channels;
+    table.resize(channels * kNumByteValues);
+    for (int64_t c = 0; c < channels; c++) {
+      for (int64_t v = 0; v < kNumByteValues; v++) {
+        table[c * kNumByteValues + v] =
+          static_cast<Out>(ApplyStages(static_cast<double>(static_cast<In>(v)), is_float, c, stages));
+      }
+    }
+  }
+  for (size_t i = 0; i < inputs.size(); i++) {
+    const In *src = reinterpret_cast<const In *>(inputs[i]->GetBuffer());
+    Out *image_dst = dst + static_cast<int64_t>(i) * image_size;
+    if (sizeof(In) == 1) {
+      Remap(src, image_dst, layouts[i],
+            [&table](In v, int64_t c) { return table[c * kNumByteValues + static_cast<uint8_t>(v)]; });
+    } else if (!FuseImagePlanar(src, image_dst, layouts[i], stages)) {
+      Remap(src, image_dst, layouts[i], [is_float, &stages](In v, int64_t c) {
+        return static_cast<Out>(ApplyStages(static_cast<double>(v), is_float, c, stages));
+      });
+    }
+  }
+}
+
+template <typename In>
+Status FuseImagesFrom(const std::vector<std::shared_ptr<Tensor>> &inputs, const std::shared_ptr<Tensor> &output,
+                      const std::vector<Layout> &layouts, const std::vector<ElementwiseStage> &stages) {
+  switch (output->type().value()) {
+    case DataType::DE_INT8:
+      FuseImages<In, int8_t>(inputs, &(*output->begin<int8_t>()), layouts, stages);
+      break;
+    case DataType::DE_UINT8:
+      FuseImages<In, uint8_t>(inputs, &(*output->begin<uint8_t>()), layouts, stages);
+      break;
+    case DataType::DE_INT16:
+      FuseImages<In, int16_t>(inputs, &(*output->begin<int16_t>()), layouts, stages);
+      break;
+    case DataType::DE_UINT16:
+      FuseImages<In, uint16_t>(inputs, &(*output->begin<uint16_t>()), layouts, stages);
+      break;
+    case DataType::DE_INT32:
+      FuseImages<In, int32_t>(inputs, &(*output->begin<int32_t>()), layouts, stages);
+      break;
+    case DataType::DE_UINT32:
+      FuseImages<In, uint32_t>(inputs, &(*output->begin<uint32_t>()), layouts, stages);
+      break;
+    case DataType::DE_FLOAT16:
+      FuseImages<In, float16>(inputs, &(*output->begin<float16>()), layouts, stages);
+      break;
+    case DataType::DE_FLOAT32:
+      FuseImages<In, float>(inputs, &(*output->begin<float>()), layouts, stages);
+      break;
+    default:
+      RETURN_STATUS_UNEXPECTED("FusedElementwise: unsupported output type " + output->type().ToString() + ".");
+  }
+  return Status::OK();
+}
+}  // namespace
+
+FusedElementwiseOp::FusedElementwiseOp(std::vector<ElementwiseStage> stages,
+                                       std::vector<std::shared_ptr<TensorOp>> ops)
+    : stages_(std::move(stages)), ops_(std::move(ops)) {
+  for (const auto &stage : stages_) {
+    switch (stage.type) {
+      case ElementwiseStage::Type::kRandomHorizontalFlip:
+      case ElementwiseStage::Type::kRandomVerticalFlip:
+        flip_distributions_.emplace_back(stage.probability);
+        is_deterministic_ = false;
+        break;
+      case ElementwiseStage::Type::kHwcToChw:
+        break;
+      case ElementwiseStage::Type::kNormalize: {
+        // pre-calculate normalized mean like NormalizeOp does
+        ElementwiseStage normalize = stage;
+        for (size_t i = 0; i < normalize.mean.size(); i++) {
+          normalize.mean[i] = normalize.mean[i] / normalize.std[i];
+        }
+        value_stages_.push_back(std::move(normalize));
+        break;
+      }
+      default:
+        value_stages_.push_back(stage);
+        break;
+    }
+  }
+  rnd_.seed(GetSeed());
+}
+
+void FusedElementwiseOp::Print(std::ostream &out) const {
+  out << "FusedElementwiseOp: {";
+  for (const auto &op : ops_) {
+    out << op->Name() << ", ";
+  }
+  out << "}" << std::endl;
+}
+
+bool FusedElementwiseOp::CanFuse(const std::shared_ptr<Tensor> &input, DataType *out_type) const {
+  if (input->Rank() != 3 || input->Size() == 0 || !IsSupportedType(input->type())) {
+    return false;
+  }
+  const dsize_t channels = input->shape()[2];
+  DataType type = input->type();
+  bool is_chw = false;
+  for (const auto &stage : stages_) {
+    // A float16 image is only written out
+    bool is_value_stage = stage.type == ElementwiseStage::Type::kRescale ||
+                          stage.type == ElementwiseStage::Type::kNormalize ||
+                          stage.type == ElementwiseStage::Type::kTypeCast;
+    if (is_value_stage && type == DataType::DE_FLOAT16) {
+      return false;
+    }
+    switch (stage.type) {
+      case ElementwiseStage::Type::kRescale:
+        type = DataType(DataType::DE_FLOAT32);
+        break;
+      case ElementwiseStage::Type::kNormalize:
+        // After HWC2CHW the last dimension is no longer the channel
+        if (is_chw || (stage.mean.size() != 1 && stage.mean.size() != static_cast<size_t>(channels)) ||
+            stage.mean.size() != stage.std.size()) {
+          return false;
+        }
+        type = DataType(DataType::DE_FLOAT32);
+        break;
+      case ElementwiseStage::Type::kTypeCast:
+        if (!IsSupportedOutputType(stage.data_type)) {
+          return false;
+        }
+        type = stage.data_type;
+        break;
+      case ElementwiseStage::Type::kRandomHorizontalFlip:
+      case ElementwiseStage::Type::kRandomVerticalFlip:
+        if (is_chw) {
+          return false;
+        }
+        break;
+      case ElementwiseStage::Type::kHwcToChw:
+        if (is_chw || (channels != 1 && channels != 3)) {
+          return false;
+        }
+        is_chw = true;
+        break;
+    }
+  }
+  *out_type = type;
+  return true;
+}
+
+Status FusedElementwiseOp::ComputeSequential(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  std::shared_ptr<Tensor> current = input;
+  for (const auto &op : ops_) {
+    std::shared_ptr<Tensor> next;
+    RETURN_IF_NOT_OK(op->Compute(current, &next));
+    current = std::move(next);
+  }
+  *output = std::move(current);
+  return Status::OK();
+}
+
+Status FusedElementwiseOp::Fuse(const std::vector<std::shared_ptr<Tensor>> &inputs, const DataType &out_type,
+                                bool batched, std::shared_ptr<Tensor> *output) {
+  std::vector<Layout> layouts;
+  layouts.reserve(inputs.size());
+  for (const auto &input : inputs) {
+    Layout layout = {input->shape()[0], input->shape()[1], input->shape()[2], false, false, false};
+    size_t flip_index = 0;
+    for (const auto &stage : stages_) {
+      if (stage.type == ElementwiseStage::Type::kRandomHorizontalFlip) {
+        layout.flip_h ^= flip_distributions_[flip_index++](rnd_);
+      } else if (stage.type == ElementwiseStage::Type::kRandomVerticalFlip) {
+        layout.flip_v ^= flip_distributions_[flip_index++](rnd_);
+      } else if (stage.type == ElementwiseStage::Type::kHwcToChw) {
+        layout.to_chw = true;
+      }
+    }
+    layouts.push_back(layout);
+  }
+  const Layout &first = layouts[0];
+  TensorShape out_shape =
+    first.to_chw ? TensorShape({first.channels, first.height, first.width}) : inputs[0]->shape();
+  if (batched) {
+    out_shape = out_shape.PrependDim(static_cast<int64_t>(inputs.size()));
+  }
+  std::shared_ptr<Tensor> out;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(out_shape, out_type, &out));
+
+  switch (inputs[0]->type().value()) {
+    case DataType::DE_INT8:
+      RETURN_IF_NOT_OK(FuseImagesFrom<int8_t>(inputs, out, layouts, value_stages_));
+      break;
+    case DataType::DE_UINT8:
+      RETURN_IF_NOT_OK(FuseImagesFrom<uint8_t>(inputs, out, layouts, value_stages_));
+      break;
+    case DataType::DE_INT16:
+      RETURN_IF_NOT_OK(FuseImagesFrom<int16_t>(inputs, out, layouts, value_stages_));
+      break;
+    case DataType::DE_UINT16:
+      RETURN_IF_NOT_OK(FuseImagesFrom<uint16_t>(inputs, out, layouts, value_stages_));
+      break;
+    case DataType::DE_INT32:
+      RETURN_IF_NOT_OK(FuseImagesFrom<int32_t>(inputs, out, layouts, value_stages_));
+      break;
+    case DataType::DE_UINT32:
+      RETURN_IF_NOT_OK(FuseImagesFrom<uint32_t>(inputs, out, layouts, value_stages_));
+      break;
+    default:
+      RETURN_IF_NOT_OK(FuseImagesFrom<float>(inputs, out, layouts, value_stages_));
+      break;
+  }
+  *output = std::move(out);
+  return Status::OK();
+}
+
+Status FusedElementwiseOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+  IO_CHECK(input, output);
+  DataType out_type;
+  if (!CanFuse(input, &out_type)) {
+    return ComputeSequential(input, output);
+  }
+  return Fuse({input}, out_type, false, output);
+}
+
+Status FusedElementwiseOp::ComputeBatch(const std::vector<std::shared_ptr<Tensor>> &inputs,
+                                        std::shared_ptr<Tensor> *output) {
+  IO_CHECK_VECTOR(inputs, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty(), "ComputeBatch: the batch is empty.");
+  // The images are written straight into the batch tensor when the single pass handles them all alike
+  DataType out_type;
+  const std::shared_ptr<Tensor> &first = inputs[0];
+  bool same_images = std::all_of(inputs.begin(), inputs.end(), [&first](const std::shared_ptr<Tensor> &input) {
+    return input->shape() == first->shape() && input->type() == first->type();
+  });
+  if (!same_images || !CanFuse(first, &out_type)) {
+    return TensorOp::ComputeBatch(inputs, output);
+  }
+  return Fuse(inputs, out_type, true, output);
+}
+
+Status FusedElementwiseOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
+  std::vector<TensorShape> current = inputs;
+  for (const auto &op : ops_) {
+    std::vector<TensorShape> next;
+    RETURN_IF_NOT_OK(op->OutputShape(current, next));
+    current = std::move(next);
+  }
+  outputs = std::move(current);
+  return Status::OK();
+}
+
+Status FusedElementwiseOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
+  std::vector<DataType> current = inputs;
+  for (const auto &op : ops_) {
+    std::vector<DataType> next;
+    RETURN_IF_NOT_OK(op->OutputType(current, next));
+    current = std::move(next);
+  }
+  outputs = std::move(current);
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
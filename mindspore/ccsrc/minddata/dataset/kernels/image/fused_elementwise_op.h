@@ -0,0 +1,100 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_ELEMENTWISE_OP_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_ELEMENTWISE_OP_H_
+
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// One of the per-pixel ops folded into a FusedElementwiseOp
+struct ElementwiseStage {
+  enum class Type { kRescale, kNormalize, kTypeCast, kRandomHorizontalFlip, kRandomVerticalFlip, kHwcToChw };
+
+  Type type;
+  float rescale = 1.0;      // Rescale
+  float shift = 0.0;        // Rescale
+  std::vector<float> mean;  // Normalize
+  std::vector<float> std;   // Normalize
+  DataType data_type;       // TypeCast
+  float probability = 0.0;  // Random flips
+};
+
+// FusedElementwiseOp runs a chain of adjacent per-pixel ops (Rescale, Normalize, TypeCast, RandomHorizontalFlip,
+// RandomVerticalFlip and HWC2CHW) in a single pass over the image with a single output allocation. The value
+// transforms are applied to each element one after the other, with the same rounding as the original ops, and
+// are tabulated per channel when the input is 8 bit. The flips and the layout change are folded into the index
+// the element is written to. Inputs the single pass does not handle, e.g. not <H,W,C> images, are given to the
+// original ops one after the other.
+// After a BatchOp the op runs on all the images of a batch at once and writes them straight into the batch tensor,
+// which saves the copy of the images into the batch.
+class FusedElementwiseOp : public TensorOp {
+ public:
+  // Constructor
+  // @param stages - The fused ops, in the order they appear in the map
+  // @param ops - The same ops built as TensorOps, used for the inputs the single pass does not handle
+  FusedElementwiseOp(std::vector<ElementwiseStage> stages, std::vector<std::shared_ptr<TensorOp>> ops);
+
+  ~FusedElementwiseOp() override = default;
+
+  void Print(std::ostream &out) const override;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
+
+  Status ComputeBatch(const std::vector<std::shared_ptr<Tensor>> &inputs, std::shared_ptr<Tensor> *output) override;
+
+  Status OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) override;
+
+  Status OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) override;
+
+  std::string Name() const override { return kFusedElementwiseOp; }
+
+ private:
+  // Check whether the single pass handles the input, and find the type of its output
+  // @param input - The input tensor
+  // @param out_type - The type of the output tensor
+  // @return bool - true if the single pass handles the input
+  bool CanFuse(const std::shared_ptr<Tensor> &input, DataType *out_type) const;
+
+  // Run the single pass on the inputs
+  // @param inputs - The input images, all handled by the single pass with the same output type
+  // @param out_type - The type of the output tensor
+  // @param batched - Write the images into one batch tensor, otherwise there is one input and its output
+  // @param output - The output tensor
+  // @return Status code
+  Status Fuse(const std::vector<std::shared_ptr<Tensor>> &inputs, const DataType &out_type, bool batched,
+              std::shared_ptr<Tensor> *output);
+
+  // Run the original ops one after the other
+  Status ComputeSequential(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output);
+
+  std::vector<ElementwiseStage> stages_;
+  std::vector<ElementwiseStage> value_stages_;  // The stages which change the values, with the mean pre-divided
+  std::vector<std::shared_ptr<TensorOp>> ops_;
+  std::vector<std::bernoulli_distribution> flip_distributions_;
+  std::mt19937 rnd_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IMAGE_FUSED_ELEMENTWISE_OP_H_
@@ -69,15 +69,17 @@ bool CheckTensorShape(const std::shared_ptr<Tensor> &tensor, const int &channel)
   return rc;
 }
 
-Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code) {
+Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code, bool in_place) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(std::move(input));
 
   if (input_cv->Rank() == 1 || input_cv->mat().dims > 2) {
     RETURN_STATUS_UNEXPECTED("Flip: input tensor is not in shape of <H,W,C> or <H,W>.");
   }
 
-  std::shared_ptr<CVTensor> output_cv;
-  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), input_cv->type(), &output_cv));
+  std::shared_ptr<CVTensor> output_cv = input_cv;
+  if (!in_place) {
+    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), input_cv->type(), &output_cv));
+  }
 
   if (input_cv->mat().data) {
     try {
@@ -92,12 +94,12 @@ Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int
   }
 }
 
-Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
-  return Flip(std::move(input), output, 1);
+Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, bool in_place) {
+  return Flip(std::move(input), output, 1, in_place);
 }
 
-Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output) {
-  return Flip(std::move(input), output, 0);
+Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, bool in_place) {
+  return Flip(std::move(input), output, 0, in_place);
 }
 
 Status Resize(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int32_t output_height,
@@ -318,8 +320,20 @@ void JpegErrorExitCustom(j_common_ptr cinfo) {
   throw std::runtime_error(jpeg_last_error_msg);
 }
 
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h) {
+  // libjpeg scales by 1/denom inside the IDCT, which is far cheaper than decoding at full size and resizing
+  constexpr int kMaxScaleDenom = 8;
+  int scale_denom = kMaxScaleDenom;
+  while (scale_denom > 1 && (crop_w / scale_denom < target_w || crop_h / scale_denom < target_h)) {
+    scale_denom /= 2;
+  }
+  return scale_denom;
+}
+
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int crop_x, int crop_y,
-                         int crop_w, int crop_h) {
+                         int crop_w, int crop_h, int scale_denom) {
+  CHECK_FAIL_RETURN_UNEXPECTED(scale_denom == 1 || scale_denom == 2 || scale_denom == 4 || scale_denom == 8,
+                               "Decode: invalid jpeg scale denominator " + std::to_string(scale_denom) + ".");
   struct jpeg_decompress_struct cinfo;
   auto DestroyDecompressAndReturnError = [&cinfo](const std::string &err) {
     jpeg_destroy_decompress(&cinfo);
@@ -333,6 +347,8 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
     JpegSetSource(&cinfo, input->GetBuffer(), input->SizeInBytes());
     (void)jpeg_read_header(&cinfo, TRUE);
     RETURN_IF_NOT_OK(JpegSetColorSpace(&cinfo));
+    cinfo.scale_num = 1;
+    cinfo.scale_denom = scale_denom;
     jpeg_calc_output_dimensions(&cinfo);
   } catch (std::runtime_error &e) {
     return DestroyDecompressAndReturnError(e.what());
@@ -340,9 +356,17 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   if (crop_x == 0 && crop_y == 0 && crop_w == 0 && crop_h == 0) {
     crop_w = cinfo.output_width;
     crop_h = cinfo.output_height;
-  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.output_width || crop_h == 0 ||
-             static_cast<unsigned int>(crop_h + crop_y) > cinfo.output_height) {
+  } else if (crop_w == 0 || static_cast<unsigned int>(crop_w + crop_x) > cinfo.image_width || crop_h == 0 ||
+             static_cast<unsigned int>(crop_h + crop_y) > cinfo.image_height) {
     return DestroyDecompressAndReturnError("Crop: invalid crop size.");
+  } else if (scale_denom > 1) {
+    // map the region to the scaled image, rounding outwards so that it covers at least the same area
+    int crop_x_end = std::min<int>((crop_x + crop_w + scale_denom - 1) / scale_denom, cinfo.output_width);
+    int crop_y_end = std::min<int>((crop_y + crop_h + scale_denom - 1) / scale_denom, cinfo.output_height);
+    crop_x /= scale_denom;
+    crop_y /= scale_denom;
+    crop_w = crop_x_end - crop_x;
+    crop_h = crop_y_end - crop_y;
   }
   const int mcu_size = cinfo.min_DCT_scaled_size;
   unsigned int crop_x_aligned = (crop_x / mcu_size) * mcu_size;
@@ -374,14 +398,17 @@ Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<T
   return Status::OK();
 }
 
-Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift) {
+Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift,
+               bool in_place) {
   std::shared_ptr<CVTensor> input_cv = CVTensor::AsCVTensor(input);
   if (!input_cv->mat().data) {
     RETURN_STATUS_UNEXPECTED("Rescale: load image failed.");
   }
   cv::Mat input_image = input_cv->mat();
-  std::shared_ptr<CVTensor> output_cv;
-  RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), DataType(DataType::DE_FLOAT32), &output_cv));
+  std::shared_ptr<CVTensor> output_cv = input_cv;
+  if (!in_place || input_cv->type() != DataType::DE_FLOAT32) {
+    RETURN_IF_NOT_OK(CVTensor::CreateEmpty(input_cv->shape(), DataType(DataType::DE_FLOAT32), &output_cv));
+  }
   try {
     input_image.convertTo(output_cv->mat(), CV_32F, rescale, shift);
     *output = std::static_pointer_cast<Tensor>(output_cv);
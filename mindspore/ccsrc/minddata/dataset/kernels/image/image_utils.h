@@ -65,18 +65,18 @@ bool CheckTensorShape(const std::shared_ptr<Tensor> &tensor, const int &channel)
 /// \brief Returns flipped image
 /// \param[in] input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \param flip_code: 1 for Horizontal (around y-axis), 0 for Vertical (around x-axis), -1 for both
-///     The flipping happens in place.
-Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code);
+/// \param in_place: the flipping happens in the buffer of the input, which becomes the output
+Status Flip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, int flip_code, bool in_place = false);
 
 /// \brief Returns Horizontally flipped image
 /// \param input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
-/// The flipping happens in place.
-Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
+/// \param in_place: the flipping happens in the buffer of the input, which becomes the output
+Status HorizontalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, bool in_place = false);
 
 /// \brief Returns Vertically flipped image
 /// \param input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
-/// \note The flipping happens in place.
-Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output);
+/// \param in_place: the flipping happens in the buffer of the input, which becomes the output
+Status VerticalFlip(std::shared_ptr<Tensor> input, std::shared_ptr<Tensor> *output, bool in_place = false);
 
 /// \brief  Returns Resized image.
 /// \param input/output: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -107,15 +107,28 @@ bool IsNonEmptyPNG(const std::shared_ptr<Tensor> &input);
 
 void JpegSetSource(j_decompress_ptr c_info, const void *data, int64_t data_size);
 
+/// \brief Decode a region of a jpeg image, optionally at a reduced scale using libjpeg DCT scaling
+/// \param input: Tensor containing the not decoded image 1D bytes
+/// \param output: Decoded image Tensor of shape <H,W,C>
+/// \param x, y, w, h: the region to decode, in the coordinates of the full size image; all 0 decodes the whole image
+/// \param scale_denom: 1, 2, 4 or 8, the region is decoded at 1/scale_denom of its size
 Status JpegCropAndDecode(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, int x = 0, int y = 0,
-                         int w = 0, int h = 0);
+                         int w = 0, int h = 0, int scale_denom = 1);
+
+/// \brief Get the largest libjpeg DCT scaling denominator that decodes a region to at least the target size
+/// \param crop_w, crop_h: the size of the region in the full size image
+/// \param target_w, target_h: the size the decoded region will be resized to
+/// \return int: 1, 2, 4 or 8
+int GetJpegScaleDenom(int crop_w, int crop_h, int target_w, int target_h);
 
 /// \brief Returns Rescaled image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
 /// \param rescale: rescale parameter
 /// \param shift: shift parameter
 /// \param output: Rescaled image Tensor of same input shape and type DE_FLOAT32
-Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift);
+/// \param in_place: a DE_FLOAT32 input is rescaled in its own buffer, which becomes the output
+Status Rescale(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output, float rescale, float shift,
+               bool in_place = false);
 
 /// \brief Returns cropped ROI of an image
 /// \param input: Tensor of shape <H,W,C> or <H,W> and any OpenCv compatible type, see CVTensor.
@@ -23,9 +23,11 @@ namespace mindspore {
 namespace dataset {
 RandomCropDecodeResizeOp::RandomCropDecodeResizeOp(int32_t target_height, int32_t target_width, float scale_lb,
                                                    float scale_ub, float aspect_lb, float aspect_ub,
-                                                   InterpolationMode interpolation, int32_t max_attempts)
+                                                   InterpolationMode interpolation, int32_t max_attempts,
+                                                   bool dct_scaling)
     : RandomCropAndResizeOp(target_height, target_width, scale_lb, scale_ub, aspect_lb, aspect_ub, interpolation,
-                            max_attempts) {}
+                            max_attempts),
+      dct_scaling_(dct_scaling) {}
 
 Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   if (input == nullptr) {
@@ -47,8 +49,9 @@ Status RandomCropDecodeResizeOp::Compute(const std::shared_ptr<Tensor> &input, s
     int crop_width = 0;
     (void)GetCropBox(h_in, w_in, &x, &y, &crop_height, &crop_width);
 
+    int scale_denom = dct_scaling_ ? GetJpegScaleDenom(crop_width, crop_height, target_width_, target_height_) : 1;
     std::shared_ptr<Tensor> decoded;
-    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height));
+    RETURN_IF_NOT_OK(JpegCropAndDecode(input, &decoded, x, y, crop_width, crop_height, scale_denom));
     return Resize(decoded, output, target_height_, target_width_, 0.0, 0.0, interpolation_);
   }
 }
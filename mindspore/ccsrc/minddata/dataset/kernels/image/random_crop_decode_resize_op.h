@@ -31,11 +31,15 @@ namespace mindspore {
 namespace dataset {
 class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
  public:
+  // @param dct_scaling: decode a jpeg crop at the smallest libjpeg DCT scale that is still at least the target
+  //     size, instead of at full size. The output is close to, but not the same as, Decode and RandomResizedCrop.
   RandomCropDecodeResizeOp(int32_t target_height, int32_t target_width, float scale_lb = kDefScaleLb,
                            float scale_ub = kDefScaleUb, float aspect_lb = kDefAspectLb, float aspect_ub = kDefAspectUb,
-                           InterpolationMode interpolation = kDefInterpolation, int32_t max_attempts = kDefMaxIter);
+                           InterpolationMode interpolation = kDefInterpolation, int32_t max_attempts = kDefMaxIter,
+                           bool dct_scaling = false);
 
-  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs) : RandomCropAndResizeOp(rhs) {}
+  explicit RandomCropDecodeResizeOp(const RandomCropAndResizeOp &rhs, bool dct_scaling = false)
+      : RandomCropAndResizeOp(rhs), dct_scaling_(dct_scaling) {}
 
   ~RandomCropDecodeResizeOp() override = default;
 
@@ -46,6 +50,9 @@ class RandomCropDecodeResizeOp : public RandomCropAndResizeOp {
   Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override;
 
   std::string Name() const override { return kRandomCropDecodeResizeOp; }
+
+ private:
+  bool dct_scaling_;
 };
 }  // namespace dataset
 }  // namespace mindspore
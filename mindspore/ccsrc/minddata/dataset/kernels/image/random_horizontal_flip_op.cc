@@ -25,7 +25,7 @@ const float RandomHorizontalFlipOp::kDefProbability = 0.5;
 Status RandomHorizontalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
   if (distribution_(rnd_)) {
-    return HorizontalFlip(input, output);
+    return HorizontalFlip(input, output, CanComputeInPlace(input));
   }
   *output = input;
   return Status::OK();
@@ -26,7 +26,7 @@ const float RandomVerticalFlipOp::kDefProbability = 0.5;
 Status RandomVerticalFlipOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
   if (distribution_(rnd_)) {
-    return VerticalFlip(input, output);
+    return VerticalFlip(input, output, CanComputeInPlace(input));
   }
   *output = input;
   return Status::OK();
@@ -22,7 +22,7 @@ namespace mindspore {
 namespace dataset {
 Status RescaleOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
-  return Rescale(input, output, rescale_, shift_);
+  return Rescale(input, output, rescale_, shift_, CanComputeInPlace(input));
 }
 Status RescaleOp::OutputType(const std::vector<DataType> &inputs, std::vector<DataType> &outputs) {
   RETURN_IF_NOT_OK(TensorOp::OutputType(inputs, outputs));
@@ -62,6 +62,11 @@ class ResizeOp : public TensorOp {
   std::string Name() const override { return kResizeOp; }
 
  protected:
+  // Get the size of the resized image
+  // @param input_h, input_w: the size of the input image
+  // @param output_h, output_w: the size of the output image
+  Status GetOutputSize(int32_t input_h, int32_t input_w, int32_t *output_h, int32_t *output_w) const;
+
   int32_t size1_;
   int32_t size2_;
   InterpolationMode interpolation_;
@@ -49,6 +49,8 @@ class DecodeOperation : public TensorOperation {
 
   Status to_json(nlohmann::json *out_json) override;
 
+  bool rgb() const { return rgb_; }
+
  private:
   bool rgb_;
 };
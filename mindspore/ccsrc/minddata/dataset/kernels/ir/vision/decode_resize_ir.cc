@@ -0,0 +1,53 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/kernels/ir/vision/decode_resize_ir.h"
+
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+#endif
+
+namespace mindspore {
+namespace dataset {
+
+namespace vision {
+#ifndef ENABLE_ANDROID
+
+// DecodeResizeOperation
+DecodeResizeOperation::DecodeResizeOperation(const ResizeOperation &base) : ResizeOperation(base) {}
+
+DecodeResizeOperation::~DecodeResizeOperation() = default;
+
+std::string DecodeResizeOperation::Name() const { return kDecodeResizeOperation; }
+
+std::shared_ptr<TensorOp> DecodeResizeOperation::Build() {
+  // If size is a single value, the smaller edge of the image will be
+  // resized to this value with the same image aspect ratio.
+  int32_t height = size_[0];
+  int32_t width = 0;
+
+  // User specified the width value.
+  if (size_.size() == 2) {
+    width = size_[1];
+  }
+
+  return std::make_shared<DecodeResizeOp>(height, width, interpolation_);
+}
+
+#endif
+
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,118 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <iterator>
+
+#include "minddata/dataset/kernels/ir/vision/fused_elementwise_ir.h"
+
+#include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_vertical_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+
+namespace mindspore {
+namespace dataset {
+
+namespace vision {
+
+#ifndef ENABLE_ANDROID
+
+// FusedElementwiseOperation
+FusedElementwiseOperation::FusedElementwiseOperation(std::vector<std::shared_ptr<TensorOperation>> transforms)
+    : transforms_(std::move(transforms)) {
+  random_op_ = std::any_of(transforms_.begin(), transforms_.end(),
+                           [](const std::shared_ptr<TensorOperation> &op) { return op->IsRandomOp(); });
+}
+
+FusedElementwiseOperation::~FusedElementwiseOperation() = default;
+
+std::string FusedElementwiseOperation::Name() const { return kFusedElementwiseOperation; }
+
+bool FusedElementwiseOperation::IsFusible(const std::shared_ptr<TensorOperation> &op) {
+  const std::string name = op->Name();
+  return name == kRescaleOperation || name == kNormalizeOperation || name == kHwcToChwOperation ||
+         name == kRandomHorizontalFlipOperation || name == kRandomVerticalFlipOperation ||
+         name == kTypeCastOperation;
+}
+
+Status FusedElementwiseOperation::ValidateParams() {
+  stages_.clear();
+  for (const auto &op : transforms_) {
+    if (!IsFusible(op)) {
+      std::string err_msg = "FusedElementwise: " + op->Name() + " is not an element-wise op.";
+      MS_LOG(ERROR) << err_msg;
+      RETURN_STATUS_SYNTAX_ERROR(err_msg);
+    }
+    // The parameters of the ops are read from their json form
+    nlohmann::json args;
+    RETURN_IF_NOT_OK(op->to_json(&args));
+    ElementwiseStage stage;
+    const std::string name = op->Name();
+    if (name == kRescaleOperation) {
+      stage.type = ElementwiseStage::Type::kRescale;
+      stage.rescale = args["rescale"].get<float>();
+      stage.shift = args["shift"].get<float>();
+    } else if (name == kNormalizeOperation) {
+      stage.type = ElementwiseStage::Type::kNormalize;
+      stage.mean = args["mean"].get<std::vector<float>>();
+      stage.std = args["std"].get<std::vector<float>>();
+    } else if (name == kTypeCastOperation) {
+      stage.type = ElementwiseStage::Type::kTypeCast;
+      stage.data_type = DataType(args["data_type"].get<std::string>());
+    } else if (name == kRandomHorizontalFlipOperation) {
+      stage.type = ElementwiseStage::Type::kRandomHorizontalFlip;
+      stage.probability = args["prob"].get<float>();
+    } else if (name == kRandomVerticalFlipOperation) {
+      stage.type = ElementwiseStage::Type::kRandomVerticalFlip;
+      stage.probability = args["prob"].get<float>();
+    } else {
+      stage.type = ElementwiseStage::Type::kHwcToChw;
+    }
+    stages_.push_back(std::move(stage));
+  }
+  return Status::OK();
+}
+
+std::shared_ptr<TensorOp> FusedElementwiseOperation::Build() {
+  std::vector<std::shared_ptr<TensorOp>> tensor_ops;
+  (void)std::transform(transforms_.begin(), transforms_.end(), std::back_inserter(tensor_ops),
+                       [](const std::shared_ptr<TensorOperation> &op) { return op->Build(); });
+  return std::make_shared<FusedElementwiseOp>(stages_, std::move(tensor_ops));
+}
+
+Status FusedElementwiseOperation::to_json(nlohmann::json *out_json) {
+  std::vector<nlohmann::json> transforms;
+  for (const auto &op : transforms_) {
+    nlohmann::json op_args;
+    RETURN_IF_NOT_OK(op->to_json(&op_args));
+    nlohmann::json op_item;
+    op_item["tensor_op_name"] = op->Name();
+    op_item["tensor_op_params"] = op_args;
+    transforms.push_back(op_item);
+  }
+  nlohmann::json args;
+  args["transforms"] = transforms;
+  *out_json = args;
+  return Status::OK();
+}
+
+#endif
+
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_FUSED_ELEMENTWISE_IR_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_FUSED_ELEMENTWISE_IR_H_
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "include/api/status.h"
+#include "minddata/dataset/include/dataset/constants.h"
+#include "minddata/dataset/include/dataset/transforms.h"
+#include "minddata/dataset/kernels/image/fused_elementwise_op.h"
+#include "minddata/dataset/kernels/ir/tensor_operation.h"
+
+namespace mindspore {
+namespace dataset {
+
+namespace vision {
+
+constexpr char kFusedElementwiseOperation[] = "FusedElementwise";
+
+// Created by TensorOpFusionPass in place of a chain of adjacent per-pixel ops
+class FusedElementwiseOperation : public TensorOperation {
+ public:
+  explicit FusedElementwiseOperation(std::vector<std::shared_ptr<TensorOperation>> transforms);
+
+  ~FusedElementwiseOperation();
+
+  std::shared_ptr<TensorOp> Build() override;
+
+  Status ValidateParams() override;
+
+  std::string Name() const override;
+
+  Status to_json(nlohmann::json *out_json) override;
+
+  /// \brief Whether the op can be part of a FusedElementwiseOperation
+  /// \param[in] op The op to check
+  /// \return bool true if the op can be fused
+  static bool IsFusible(const std::shared_ptr<TensorOperation> &op);
+
+ private:
+  std::vector<std::shared_ptr<TensorOperation>> transforms_;
+  std::vector<ElementwiseStage> stages_;
+};
+
+}  // namespace vision
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_KERNELS_IR_VISION_FUSED_ELEMENTWISE_IR_H_
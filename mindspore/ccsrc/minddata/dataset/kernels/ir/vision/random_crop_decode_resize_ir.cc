@@ -33,7 +33,7 @@ namespace vision {
 RandomCropDecodeResizeOperation::RandomCropDecodeResizeOperation(std::vector<int32_t> size, std::vector<float> scale,
                                                                  std::vector<float> ratio,
                                                                  InterpolationMode interpolation, int32_t max_attempts)
-    : RandomResizedCropOperation(size, scale, ratio, interpolation, max_attempts) {}
+    : RandomResizedCropOperation(size, scale, ratio, interpolation, max_attempts), dct_scaling_(false) {}
 
 RandomCropDecodeResizeOperation::~RandomCropDecodeResizeOperation() = default;
 
@@ -56,12 +56,14 @@ std::shared_ptr<TensorOp> RandomCropDecodeResizeOperation::Build() {
 
   auto tensor_op =
     std::make_shared<RandomCropDecodeResizeOp>(crop_height, crop_width, scale_lower_bound, scale_upper_bound,
-                                               aspect_lower_bound, aspect_upper_bound, interpolation_, max_attempts_);
+                                               aspect_lower_bound, aspect_upper_bound, interpolation_, max_attempts_,
+                                               dct_scaling_);
   return tensor_op;
 }
 
-RandomCropDecodeResizeOperation::RandomCropDecodeResizeOperation(const RandomResizedCropOperation &base)
-    : RandomResizedCropOperation(base) {}
+RandomCropDecodeResizeOperation::RandomCropDecodeResizeOperation(const RandomResizedCropOperation &base,
+                                                                 bool dct_scaling)
+    : RandomResizedCropOperation(base), dct_scaling_(dct_scaling) {}
 
 Status RandomCropDecodeResizeOperation::to_json(nlohmann::json *out_json) {
   nlohmann::json args;
@@ -41,7 +41,10 @@ class RandomCropDecodeResizeOperation : public RandomResizedCropOperation {
   RandomCropDecodeResizeOperation(std::vector<int32_t> size, std::vector<float> scale, std::vector<float> ratio,
                                   InterpolationMode interpolation, int32_t max_attempts);
 
-  explicit RandomCropDecodeResizeOperation(const RandomResizedCropOperation &base);
+  /// \brief Constructor used by the IR optimizer to fuse Decode and RandomResizedCrop
+  /// \param[in] base The RandomResizedCrop being fused
+  /// \param[in] dct_scaling Whether to decode the crop at a reduced libjpeg DCT scale when it is larger than needed
+  explicit RandomCropDecodeResizeOperation(const RandomResizedCropOperation &base, bool dct_scaling = false);
 
   ~RandomCropDecodeResizeOperation();
 
@@ -50,6 +53,9 @@ class RandomCropDecodeResizeOperation : public RandomResizedCropOperation {
   std::string Name() const override;
 
   Status to_json(nlohmann::json *out_json) override;
+
+ private:
+  bool dct_scaling_;
 };
 
 }  // namespace vision
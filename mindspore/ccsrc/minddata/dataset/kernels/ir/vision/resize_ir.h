@@ -49,7 +49,7 @@ class ResizeOperation : public TensorOperation {
 
   Status to_json(nlohmann::json *out_json) override;
 
- private:
+ protected:
   std::vector<int32_t> size_;
   InterpolationMode interpolation_;
 };
@@ -15,7 +15,9 @@
  */
 #include "minddata/dataset/kernels/tensor_op.h"
 #include <memory>
+#include <utility>
 #include <vector>
+#include "minddata/dataset/core/global_context.h"
 
 namespace mindspore {
 namespace dataset {
@@ -54,6 +56,32 @@ Status TensorOp::Compute(const std::shared_ptr<DeviceTensor> &input, std::shared
                 "different device. If so, please implement it in the derived class.");
 }
 
+Status TensorOp::ComputeBatch(const std::vector<std::shared_ptr<Tensor>> &inputs, std::shared_ptr<Tensor> *output) {
+  IO_CHECK_VECTOR(inputs, output);
+  CHECK_FAIL_RETURN_UNEXPECTED(!inputs.empty(), "ComputeBatch: the batch is empty.");
+  CHECK_FAIL_RETURN_UNEXPECTED(OneToOne(), "ComputeBatch: only a 1-1 TensorOp can run on a batch.");
+  std::vector<std::shared_ptr<Tensor>> results(inputs.size());
+  for (size_t i = 0; i < inputs.size(); i++) {
+    RETURN_IF_NOT_OK(Compute(inputs[i], &results[i]));
+  }
+  const TensorShape &shape = results[0]->shape();
+  const DataType &type = results[0]->type();
+  CHECK_FAIL_RETURN_UNEXPECTED(type.IsNumeric(), "ComputeBatch: " + Name() + " gives a string tensor.");
+  std::shared_ptr<Tensor> batch;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(shape.PrependDim(static_cast<int64_t>(results.size())), type, &batch));
+  for (size_t i = 0; i < results.size(); i++) {
+    if (results[i]->shape() != shape || results[i]->type() != type) {
+      RETURN_STATUS_UNEXPECTED("Invalid data, expect same shape and type for each data row after " + Name() +
+                               ", but got " + results[i]->shape().ToString() + " and " + shape.ToString() + ".");
+    }
+    if (shape.NumOfElements() != 0) {
+      RETURN_IF_NOT_OK(batch->InsertTensor({static_cast<dsize_t>(i)}, results[i]));
+    }
+  }
+  *output = std::move(batch);
+  return Status::OK();
+}
+
 Status TensorOp::OutputShape(const std::vector<TensorShape> &inputs, std::vector<TensorShape> &outputs) {
   if (inputs.size() != NumInput())
     return Status(StatusCode::kMDUnexpectedError,
@@ -75,5 +103,8 @@ Status TensorOp::SetAscendResource(const std::shared_ptr<DeviceResource> &resour
                 "This is a CPU operator which doesn't have Ascend Resource. Please verify your context");
 }
 
+bool TensorOp::CanComputeInPlace(const std::shared_ptr<Tensor> &input) {
+  return input != nullptr && input.use_count() == 1 && GlobalContext::thread_mem_pool() != nullptr;
+}
 }  // namespace dataset
 }  // namespace mindspore
@@ -57,6 +57,7 @@ constexpr char kAffineOp[] = "AffineOp";
 constexpr char kAutoContrastOp[] = "AutoContrastOp";
 constexpr char kBoundingBoxAugmentOp[] = "BoundingBoxAugmentOp";
 constexpr char kDecodeOp[] = "DecodeOp";
+constexpr char kDecodeResizeOp[] = "DecodeResizeOp";
 constexpr char kCenterCropOp[] = "CenterCropOp";
 constexpr char kCutMixBatchOp[] = "CutMixBatchOp";
 constexpr char kCutOutOp[] = "CutOutOp";
@@ -69,6 +70,7 @@ constexpr char kDvppDecodePngOp[] = "DvppDecodePngOp";
 constexpr char kDvppNormalizeOp[] = "DvppNormalizeOp";
 constexpr char kDvppResizeJpegOp[] = "DvppResizeJpegOp";
 constexpr char kEqualizeOp[] = "EqualizeOp";
+constexpr char kFusedElementwiseOp[] = "FusedElementwiseOp";
 constexpr char kGaussianBlurOp[] = "GaussianBlurOp";
 constexpr char kHwcToChwOp[] = "HWC2CHWOp";
 constexpr char kInvertOp[] = "InvertOp";
@@ -188,6 +190,14 @@ class TensorOp {
   // @return Status
   virtual Status Compute(const std::shared_ptr<DeviceTensor> &input, std::shared_ptr<DeviceTensor> *output);
 
+  // Perform the 1-1 operation on every tensor of a batch and stack the results into one batch tensor. This is for
+  // the ops BatchOp runs after batching. The default runs Compute() on every tensor, then copies its result into the
+  // batch tensor, a derived class may write its results straight into the batch tensor.
+  // @param inputs - the tensors of one column of the rows in the batch, all of the same shape and type.
+  // @param output - the address to a shared_ptr where the batch tensor will be placed.
+  // @return Status
+  virtual Status ComputeBatch(const std::vector<std::shared_ptr<Tensor>> &inputs, std::shared_ptr<Tensor> *output);
+
   // Returns true oif the TensorOp takes one input and returns one output.
   // @return true/false
   bool OneToOne() { return NumInput() == 1 && NumOutput() == 1; }
@@ -225,6 +235,12 @@ class TensorOp {
   virtual Status SetAscendResource(const std::shared_ptr<DeviceResource> &resource);
 
  protected:
+  // Returns true if Compute may write its output in the buffer of its input: the calling thread works for a pipeline
+  // with the tensor pool enabled, whose rows are not seen outside of it, and nothing else holds the input.
+  // @param input - The input tensor given to Compute
+  // @return true/false
+  static bool CanComputeInPlace(const std::shared_ptr<Tensor> &input);
+
   bool is_deterministic_{true};
 };
 }  // namespace dataset
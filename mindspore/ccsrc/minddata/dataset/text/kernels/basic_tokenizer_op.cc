@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <string>
@@ -21,11 +22,94 @@
 #include <utility>
 #include <vector>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
 #include "unicode/errorcode.h"
 #include "unicode/normalizer2.h"
 
 namespace mindspore {
 namespace dataset {
+namespace {
+constexpr uint8_t kAsciiLimit = 0x80;
+constexpr size_t kSimdWidth = 16;
+
+bool IsAscii(std::string_view text) {
+  size_t i = 0;
+  const auto *p = reinterpret_cast<const uint8_t *>(text.data());
+#if defined(__SSE2__)
+  for (; i + kSimdWidth <= text.size(); i += kSimdWidth) {
+    if (_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i))) != 0) {
+      return false;
+    }
+  }
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  for (; i + kSimdWidth <= text.size(); i += kSimdWidth) {
+    if (vmaxvq_u8(vld1q_u8(p + i)) >= kAsciiLimit) {
+      return false;
+    }
+  }
+#endif
+  for (; i < text.size(); ++i) {
+    if (p[i] >= kAsciiLimit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline bool IsAsciiAlnum(char c) {
+  return (c >= '0' && c <= '9') || (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+}
+
+// The end of the run of letters and digits starting at begin
+size_t SkipAlnum(const std::string &text, size_t begin) {
+  size_t i = begin;
+#if defined(__SSE2__)
+  auto in_range = [](__m128i v, char lo, char hi) {
+    return _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(lo - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8(hi + 1)));
+  };
+  for (; i + kSimdWidth <= text.size(); i += kSimdWidth) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(text.data() + i));
+    __m128i alnum = _mm_or_si128(_mm_or_si128(in_range(v, '0', '9'), in_range(v, 'A', 'Z')), in_range(v, 'a', 'z'));
+    auto other = static_cast<uint32_t>(~_mm_movemask_epi8(alnum)) & 0xFFFFu;
+    if (other != 0) {
+      return i + __builtin_ctz(other);
+    }
+  }
+#endif
+  while (i < text.size() && IsAsciiAlnum(text[i])) {
+    ++i;
+  }
+  return i;
+}
+
+// The length of the unused token, one of unused_words or such as [unused3], starting at begin, or 0 if there is none
+size_t MatchUnusedToken(const std::string &text, size_t begin, const std::unordered_set<std::string> &unused_words) {
+  // The words between the brackets are ASCII letters and digits only
+  size_t end = begin + 1;
+  while (end < text.size() && IsAsciiAlnum(text[end])) {
+    ++end;
+  }
+  if (end >= text.size() || text[end] != ']') {
+    return 0;
+  }
+  std::string word = text.substr(begin, end + 1 - begin);
+  if (unused_words.find(word) != unused_words.end()) {
+    return word.size();
+  }
+  const std::string kUnused = "[unused";
+  if (word.size() <= kUnused.size() + 1 || word.compare(0, kUnused.size(), kUnused) != 0) {
+    return 0;
+  }
+  return std::all_of(word.begin() + kUnused.size(), word.end() - 1, [](char c) { return c >= '0' && c <= '9'; })
+           ? word.size()
+           : 0;
+}
+}  // namespace
 
 const bool BasicTokenizerOp::kDefLowerCase = false;
 const bool BasicTokenizerOp::kDefKeepWhitespace = false;
@@ -138,12 +222,93 @@ Status BasicTokenizerOp::CaseFoldWithoutUnusedWords(const std::shared_ptr<Tensor
   return Tensor::CreateFromVector(strs, input->shape(), output);
 }
 
+bool BasicTokenizerOp::TokenizeAscii(std::string_view text, std::string *buffer, std::vector<std::string_view> *tokens,
+                                     std::vector<uint32_t> *offsets_start,
+                                     std::vector<uint32_t> *offsets_limit) const {
+  if (!IsAscii(text)) {
+    return false;
+  }
+  // Normalization and accent stripping leave ASCII alone, case folding lowers the letters, and the control
+  // characters become spaces
+  buffer->assign(text.data(), text.size());
+  std::vector<bool> keep_case;
+  if (lower_case_ && preserve_unused_token_) {
+    // The same words as CaseFoldWithoutUnusedWords keep their case, found the same way
+    keep_case.resize(text.size(), false);
+    int start = -1;
+    size_t len = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+      if (text[i] == '[') {
+        start = static_cast<int>(i);
+        ++len;
+      } else if (text[i] == ']' && start >= 0) {
+        ++len;
+        std::string_view word = text.substr(start, len);
+        if (kUnusedWords.find(std::string(word)) != kUnusedWords.end()) {
+          std::fill(keep_case.begin() + start, keep_case.begin() + start + word.size(), true);
+        }
+        start = -1;
+        len = 0;
+      } else if (start >= 0) {
+        ++len;
+      }
+    }
+  }
+  for (size_t i = 0; i < buffer->size(); ++i) {
+    char &c = (*buffer)[i];
+    if (lower_case_ && c >= 'A' && c <= 'Z' && (keep_case.empty() || !keep_case[i])) {
+      c = static_cast<char>(c - 'A' + 'a');
+    } else if (c < ' ' || c == '\x7F') {
+      c = ' ';
+    }
+  }
+
+  // Runs of letters and digits are the tokens between the delimiters, which are the unused tokens, runs of
+  // spaces and single punctuation characters
+  const std::string &buf = *buffer;
+  auto add_token = [&](size_t begin, size_t end) {
+    tokens->emplace_back(buf.data() + begin, end - begin);
+    offsets_start->push_back(static_cast<uint32_t>(begin));
+    offsets_limit->push_back(static_cast<uint32_t>(end));
+  };
+  size_t i = 0;
+  while (i < buf.size()) {
+    char c = buf[i];
+    size_t end = i + 1;
+    if (IsAsciiAlnum(c)) {
+      end = SkipAlnum(buf, i);
+      add_token(i, end);
+    } else if (c == ' ') {
+      end = buf.find_first_not_of(' ', i);
+      end = (end == std::string::npos) ? buf.size() : end;
+      if (keep_whitespace_) {
+        add_token(i, end);
+      }
+    } else {
+      size_t unused_len = (preserve_unused_token_ && c == '[') ? MatchUnusedToken(buf, i, kUnusedWords) : 0;
+      end = i + std::max<size_t>(unused_len, 1);
+      add_token(i, end);
+    }
+    i = end;
+  }
+  return true;
+}
+
 Status BasicTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
   CHECK_FAIL_RETURN_UNEXPECTED(input.size() == 1, "BasicTokenizer: input only support one column data.");
   if (input[0]->Rank() != 0 || input[0]->type() != DataType::DE_STRING) {
     RETURN_STATUS_UNEXPECTED("BasicTokenizer: the input should be scalar with string datatype");
   }
+  std::string_view text;
+  RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+  std::string buffer;
+  std::vector<std::string_view> tokens;
+  std::vector<uint32_t> offsets_start, offsets_limit;
+  if (TokenizeAscii(text, &buffer, &tokens, &offsets_start, &offsets_limit)) {
+    std::vector<std::string> splits(tokens.begin(), tokens.end());
+    return OutputTokens(&splits, &offsets_start, &offsets_limit, output);
+  }
   std::shared_ptr<Tensor> cur_input;
   std::shared_ptr<Tensor> processed_tensor;
   if (lower_case_) {
@@ -17,7 +17,9 @@
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_KERNELS_BASIC_TOKENIZER_OP_H_
 #include <memory>
 #include <string>
+#include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -47,6 +49,17 @@ class BasicTokenizerOp : public TokenizerOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  // Tokenize a text made only of ASCII characters, which normalization leaves as it is. It gives the same tokens
+  // as Compute without going through ICU.
+  // @param text - the text
+  // @param buffer - holds the text once lower cased and stripped of control characters
+  // @param tokens - the tokens, pointing into buffer
+  // @param offsets_start - the offsets of the tokens in the text
+  // @param offsets_limit - the offsets of the ends of the tokens in the text
+  // @return bool - false if the text is not all ASCII, the outputs are left alone then
+  bool TokenizeAscii(std::string_view text, std::string *buffer, std::vector<std::string_view> *tokens,
+                     std::vector<uint32_t> *offsets_start, std::vector<uint32_t> *offsets_limit) const;
+
  protected:
   Status CaseFoldWithoutUnusedWords(const std::string_view &text, const std::unordered_set<std::string> &unused_words,
                                     std::string *output);
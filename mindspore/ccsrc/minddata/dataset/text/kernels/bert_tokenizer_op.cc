@@ -14,10 +14,32 @@
  * limitations under the License.
  */
 #include "minddata/dataset/text/kernels/bert_tokenizer_op.h"
+
+#include <string_view>
+#include <vector>
+
 namespace mindspore {
 namespace dataset {
 Status BertTokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   IO_CHECK_VECTOR(input, output);
+  // ASCII text goes straight from the basic tokens to the subwords, without tensors in between
+  if (input.size() == 1 && input[0]->Rank() == 0 && input[0]->type() == DataType::DE_STRING) {
+    std::string_view text;
+    RETURN_IF_NOT_OK(input[0]->GetItemAt(&text, {}));
+    std::string buffer;
+    std::vector<std::string_view> words;
+    std::vector<uint32_t> words_start, words_limit;
+    if (basic_tokenizer_.TokenizeAscii(text, &buffer, &words, &words_start, &words_limit)) {
+      std::vector<std::string> tokens;
+      std::vector<uint32_t> offsets_start, offsets_limit;
+      for (size_t i = 0; i < words.size(); ++i) {
+        uint32_t basic_start = with_offsets_ ? words_start[i] : 0;
+        RETURN_IF_NOT_OK(
+          wordpiece_tokenizer_.GetTokens(words[i], basic_start, &tokens, &offsets_start, &offsets_limit));
+      }
+      return wordpiece_tokenizer_.OutputTokens(&tokens, &offsets_start, &offsets_limit, output);
+    }
+  }
   TensorRow basic_tensor;
   RETURN_IF_NOT_OK(basic_tokenizer_.Compute(input, &basic_tensor));
   RETURN_IF_NOT_OK(wordpiece_tokenizer_.Compute(basic_tensor, output));
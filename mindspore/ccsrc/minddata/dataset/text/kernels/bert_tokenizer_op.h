@@ -40,7 +40,8 @@ class BertTokenizerOp : public TensorOp {
                            const bool &preserve_unused_token = BasicTokenizerOp::kDefPreserveUnusedToken,
                            const bool &with_offsets = TokenizerOp::kDefWithOffsets)
       : wordpiece_tokenizer_(vocab, suffix_indicator, max_bytes_per_token, unknown_token, with_offsets),
-        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets) {}
+        basic_tokenizer_(lower_case, keep_whitespace, normalization_form, preserve_unused_token, with_offsets),
+        with_offsets_(with_offsets) {}
 
   ~BertTokenizerOp() override = default;
 
@@ -51,6 +52,7 @@ class BertTokenizerOp : public TensorOp {
  private:
   WordpieceTokenizerOp wordpiece_tokenizer_;
   BasicTokenizerOp basic_tokenizer_;
+  bool with_offsets_;
 };
 }  // namespace dataset
 }  // namespace mindspore
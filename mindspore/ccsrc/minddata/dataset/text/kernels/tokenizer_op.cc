@@ -31,21 +31,25 @@ Status TokenizerOp::Compute(const TensorRow &input, TensorRow *output) {
   }
   std::string_view str;
   RETURN_IF_NOT_OK(input[0]->GetItemAt(&str, {}));
-  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
   std::vector<uint32_t> offsets_start, offsets_limit;
   std::vector<std::string> splits;
   RETURN_IF_NOT_OK(Tokenize(str, &splits, &offsets_start, &offsets_limit));
+  return OutputTokens(&splits, &offsets_start, &offsets_limit, output);
+}
 
-  if (splits.empty()) {
-    splits.emplace_back("");
-    offsets_start.push_back(0);
-    offsets_limit.push_back(0);
+Status TokenizerOp::OutputTokens(std::vector<std::string> *splits, std::vector<uint32_t> *offsets_start,
+                                 std::vector<uint32_t> *offsets_limit, TensorRow *output) const {
+  if (splits->empty()) {
+    splits->emplace_back("");
+    offsets_start->push_back(0);
+    offsets_limit->push_back(0);
   }
-  RETURN_IF_NOT_OK(Tensor::CreateFromVector(splits, &token_tensor));
+  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateFromVector(*splits, &token_tensor));
   output->push_back(token_tensor);
   if (with_offsets_) {
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_limit, &offsets_limit_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(*offsets_start, &offsets_start_tensor));
+    RETURN_IF_NOT_OK(Tensor::CreateFromVector(*offsets_limit, &offsets_limit_tensor));
 
     output->push_back(offsets_start_tensor);
     output->push_back(offsets_limit_tensor);
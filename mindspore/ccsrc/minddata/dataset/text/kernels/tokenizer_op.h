@@ -41,6 +41,10 @@ class TokenizerOp : public TensorOp {
 
   Status Compute(const TensorRow &input, TensorRow *output) override;
 
+  // Put the tokens in the output, and their offsets if asked for. No token makes a single empty one.
+  Status OutputTokens(std::vector<std::string> *splits, std::vector<uint32_t> *offsets_start,
+                      std::vector<uint32_t> *offsets_limit, TensorRow *output) const;
+
  protected:
   bool with_offsets_;
 };
@@ -23,6 +23,22 @@ const char WordpieceTokenizerOp::kDefSuffixIndicator[] = "##";
 const int WordpieceTokenizerOp::kDefMaxBytesPerToken = 100;
 const char WordpieceTokenizerOp::kDefUnknownToken[] = "[UNK]";
 
+namespace {
+// Check that a string is made of whole UTF-8 characters, judging each character by its lead byte
+bool IsWholeUtf8(std::string_view str) {
+  size_t i = 0;
+  while (i < str.size()) {
+    auto lead = static_cast<uint8_t>(str[i]);
+    size_t len = (lead < 0x80) ? 1 : (lead <= 0xDF) ? 2 : (lead <= 0xEF) ? 3 : (lead <= 0xF7) ? 4 : 0;
+    if (len == 0 || i + len > str.size()) {
+      return false;
+    }
+    i += len;
+  }
+  return true;
+}
+}  // namespace
+
 WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab, const std::string &suffix_indicator,
                                            const int &max_bytes_per_token, const std::string &unknown_token,
                                            const bool &with_offsets)
@@ -30,31 +46,28 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
+      unknown_token_(unknown_token),
+      suffix_state_(VocabTrie::kNoState) {
+  if (vocab_ != nullptr) {
+    trie_ = std::make_shared<VocabTrie>(vocab_->vocab());
+    suffix_state_ = trie_->Walk(VocabTrie::kRoot, suffix_indicator_);
+  }
+}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(std::string_view input_token, const int start, bool *out_found,
+                                        int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
-  *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->Lookup(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
-    }
-  }
+  // A subword which does not start the word is looked up with the suffix indicator in front
+  WordIdType id = Vocab::kNoTokenExists;
+  size_t len = trie_->LongestMatch(start > 0 ? suffix_state_ : VocabTrie::kRoot, input_token.substr(start), &id);
+  *out_found = len > 0;
+  *out_end = start + static_cast<int>(len);
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::FoundNoToken(std::string_view input_token, const uint32_t &basic_start,
                                           std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                           std::vector<uint32_t> *offsets_limit) const {
-  out_tokens->clear();
   offsets_start->push_back(basic_start);
   if (unknown_token_.empty()) {
     out_tokens->emplace_back(input_token);
@@ -66,20 +79,23 @@ Status WordpieceTokenizerOp::FoundNoToken(const std::string &input_token, const
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::AddSubword(const std::string &input_token, const int &start, const int &end,
+Status WordpieceTokenizerOp::AddSubword(std::string_view input_token, const int &start, const int &end,
                                         std::vector<std::string> *out_tokens) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && end > start && end <= input_token.size(), "Out of range");
-  std::string subword = input_token.substr(start, end - start);
+  std::string subword;
   if (start > 0) {
-    subword = suffix_indicator_ + subword;
+    subword.reserve(suffix_indicator_.size() + end - start);
+    subword = suffix_indicator_;
   }
-  out_tokens->emplace_back(subword);
+  subword.append(input_token.substr(start, end - start));
+  out_tokens->emplace_back(std::move(subword));
   return Status::OK();
 }
 
-Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uint32_t &basic_start,
+Status WordpieceTokenizerOp::GetTokens(std::string_view input_token, const uint32_t &basic_start,
                                        std::vector<std::string> *out_tokens, std::vector<uint32_t> *offsets_start,
                                        std::vector<uint32_t> *offsets_limit) const {
+  CHECK_FAIL_RETURN_UNEXPECTED(trie_ != nullptr, "WordpieceTokenizer: vocab is null.");
   if (input_token.size() > max_bytes_per_token_) {
     offsets_start->push_back(basic_start);
     if (!unknown_token_.empty()) {
@@ -91,20 +107,25 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
     }
     return Status::OK();
   }
-  RuneStrArray runes;
-  if (!DecodeRunesInString(input_token.data(), input_token.size(), runes)) {
+  if (!IsWholeUtf8(input_token)) {
     RETURN_STATUS_UNEXPECTED("WordpieceTokenizer: Decode utf8 string failed.");
   }
+  // When a part of the word is not in the vocab, the whole word is unknown
+  size_t first_token = out_tokens->size();
+  size_t first_offset = offsets_start->size();
   int end = 0;
   for (int start = 0; start < input_token.size();) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
       offsets_limit->push_back(static_cast<uint32_t>(basic_start + end));
       start = end;
     } else {
+      out_tokens->resize(first_token);
+      offsets_start->resize(first_offset);
+      offsets_limit->resize(first_offset);
       return FoundNoToken(input_token, basic_start, out_tokens, offsets_start, offsets_limit);
     }
   }
@@ -120,32 +141,16 @@ Status WordpieceTokenizerOp::Compute(const TensorRow &input, TensorRow *output)
   dsize_t count = 0;
   std::vector<std::string> out_tokens;
   std::vector<uint32_t> offsets_start, offsets_limit;
-  std::shared_ptr<Tensor> token_tensor, offsets_start_tensor, offsets_limit_tensor;
+  out_tokens.reserve(input[0]->Size());
   for (auto iter = input[0]->begin<std::string_view>(); iter != input[0]->end<std::string_view>(); iter++) {
     uint32_t basic_start = 0;
-    std::vector<std::string> temp_tokens;
     if (with_offsets_ && input.size() == 3) {
       RETURN_IF_NOT_OK(input[1]->GetItemAt<uint32_t>(&basic_start, {count}));
     }
-    RETURN_IF_NOT_OK(GetTokens(std::string(*iter), basic_start, &temp_tokens, &offsets_start, &offsets_limit));
-    out_tokens.insert(out_tokens.end(), temp_tokens.begin(), temp_tokens.end());
+    RETURN_IF_NOT_OK(GetTokens(*iter, basic_start, &out_tokens, &offsets_start, &offsets_limit));
     count++;
   }
-  if (out_tokens.empty()) {
-    out_tokens.emplace_back("");
-    offsets_start.push_back(0);
-    offsets_limit.push_back(0);
-  }
-  RETURN_IF_NOT_OK(Tensor::CreateFromVector(out_tokens, &token_tensor));
-  output->push_back(token_tensor);
-  if (with_offsets_) {
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_start, &offsets_start_tensor));
-    RETURN_IF_NOT_OK(Tensor::CreateFromVector(offsets_limit, &offsets_limit_tensor));
-
-    output->push_back(offsets_start_tensor);
-    output->push_back(offsets_limit_tensor);
-  }
-  return Status::OK();
+  return OutputTokens(&out_tokens, &offsets_start, &offsets_limit, output);
 }
 
 }  // namespace dataset
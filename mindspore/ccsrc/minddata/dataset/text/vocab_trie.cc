@@ -0,0 +1,128 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/vocab_trie.h"
+
+#include <algorithm>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr size_t kNumLabels = 256;
+}  // namespace
+
+VocabTrie::VocabTrie(const std::unordered_map<WordType, WordIdType> &words) : first_free_(kRoot + 1) {
+  std::vector<std::pair<std::string_view, WordIdType>> sorted;
+  sorted.reserve(words.size());
+  for (const auto &word : words) {
+    sorted.emplace_back(word.first, word.second);
+  }
+  std::sort(sorted.begin(), sorted.end());
+  Grow(kNumLabels + 1);
+  check_[kRoot] = kRoot;
+  if (!sorted.empty()) {
+    Insert(kRoot, sorted, 0, sorted.size(), 0);
+  }
+}
+
+void VocabTrie::Grow(size_t size) {
+  if (size > check_.size()) {
+    size = std::max(size, check_.size() * 2);
+    base_.resize(size, 0);
+    check_.resize(size, kNoState);
+    value_.resize(size, Vocab::kNoTokenExists);
+  }
+}
+
+int32_t VocabTrie::FindBase(const std::vector<uint8_t> &labels) {
+  for (size_t pos = std::max<size_t>(first_free_, labels[0] + 1);; ++pos) {
+    Grow(pos + kNumLabels);
+    if (check_[pos] != kNoState) {
+      continue;
+    }
+    size_t base = pos - labels[0];
+    if (std::all_of(labels.begin(), labels.end(), [this, base](uint8_t c) { return check_[base + c] == kNoState; })) {
+      return static_cast<int32_t>(base);
+    }
+  }
+}
+
+void VocabTrie::Insert(int32_t state, const std::vector<std::pair<std::string_view, WordIdType>> &words, size_t begin,
+                       size_t end, size_t depth) {
+  // Sorted words sharing a prefix are next to each other, the one ending here comes first
+  if (words[begin].first.size() == depth) {
+    value_[state] = words[begin].second;
+    ++begin;
+  }
+  std::vector<uint8_t> labels;
+  std::vector<size_t> bounds;
+  for (size_t i = begin; i < end; ++i) {
+    auto c = static_cast<uint8_t>(words[i].first[depth]);
+    if (labels.empty() || labels.back() != c) {
+      labels.push_back(c);
+      bounds.push_back(i);
+    }
+  }
+  if (labels.empty()) {
+    return;
+  }
+  bounds.push_back(end);
+
+  int32_t base = FindBase(labels);
+  base_[state] = base;
+  for (auto c : labels) {
+    check_[base + c] = state;
+  }
+  while (first_free_ < check_.size() && check_[first_free_] != kNoState) {
+    ++first_free_;
+  }
+  for (size_t i = 0; i < labels.size(); ++i) {
+    Insert(base + labels[i], words, bounds[i], bounds[i + 1], depth + 1);
+  }
+}
+
+int32_t VocabTrie::Walk(int32_t state, std::string_view str) const {
+  for (char c : str) {
+    size_t next = static_cast<size_t>(base_[state]) + static_cast<uint8_t>(c);
+    if (next >= check_.size() || check_[next] != state) {
+      return kNoState;
+    }
+    state = static_cast<int32_t>(next);
+  }
+  return state;
+}
+
+size_t VocabTrie::LongestMatch(int32_t state, std::string_view str, WordIdType *id) const {
+  size_t match = 0;
+  if (state == kNoState) {
+    return match;
+  }
+  for (size_t i = 0; i < str.size(); ++i) {
+    size_t next = static_cast<size_t>(base_[state]) + static_cast<uint8_t>(str[i]);
+    if (next >= check_.size() || check_[next] != state) {
+      break;
+    }
+    state = static_cast<int32_t>(next);
+    // A UTF-8 continuation byte is 10xxxxxx, the match must not end in the middle of a character
+    bool at_char_boundary = i + 1 == str.size() || (static_cast<uint8_t>(str[i + 1]) & 0xC0) != 0x80;
+    if (value_[state] != Vocab::kNoTokenExists && at_char_boundary) {
+      match = i + 1;
+      *id = value_[state];
+    }
+  }
+  return match;
+}
+}  // namespace dataset
+}  // namespace mindspore
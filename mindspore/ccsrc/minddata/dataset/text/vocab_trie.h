@@ -0,0 +1,78 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "minddata/dataset/text/vocab.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief The words of a vocab compiled into a double-array trie.
+/// \details A state of the trie is a prefix of some words. The transition from state s on byte c goes to
+///     base[s] + c, and is valid when check[base[s] + c] is s. Finding the longest word a string starts with
+///     takes one array lookup per byte and builds no string.
+class VocabTrie {
+ public:
+  static constexpr int32_t kRoot = 0;
+  static constexpr int32_t kNoState = -1;
+
+  /// \brief Compile the words of a vocab
+  /// \param[in] words Word to id map of the vocab
+  explicit VocabTrie(const std::unordered_map<WordType, WordIdType> &words);
+
+  ~VocabTrie() = default;
+
+  /// \brief Follow the bytes of a string from a state
+  /// \param[in] state The state to start from
+  /// \param[in] str The bytes to follow
+  /// \return The state reached, or kNoState if no word continues with the string
+  int32_t Walk(int32_t state, std::string_view str) const;
+
+  /// \brief Find the longest prefix of a string which completes a word from a state. The prefix must end at the
+  ///     start of a UTF-8 character.
+  /// \param[in] state The state to start from, the word is the prefix of this state followed by the match
+  /// \param[in] str The string to match
+  /// \param[out] id The id of the word, unchanged if there is no match
+  /// \return The length of the match in bytes, 0 if there is no match
+  size_t LongestMatch(int32_t state, std::string_view str, WordIdType *id) const;
+
+  /// \brief Number of cells of the arrays, a measure of the memory used
+  size_t Size() const { return check_.size(); }
+
+ private:
+  // Place the children of a state, which covers the words in [begin, end) of the sorted words at a depth
+  void Insert(int32_t state, const std::vector<std::pair<std::string_view, WordIdType>> &words, size_t begin,
+              size_t end, size_t depth);
+
+  // Find a base for which the cells of all the labels are free
+  int32_t FindBase(const std::vector<uint8_t> &labels);
+
+  void Grow(size_t size);
+
+  std::vector<int32_t> base_;
+  std::vector<int32_t> check_;      // Parent of each state, kNoState for a free cell
+  std::vector<WordIdType> value_;   // Id of the word ending at each state, or Vocab::kNoTokenExists
+  size_t first_free_;               // No free cell below this one
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/buffer_pool.h"
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include "./securec.h"
+#include "minddata/dataset/util/circular_pool.h"
+
+namespace mindspore {
+namespace dataset {
+constexpr size_t BufferPool::kHeaderSize;
+
+BufferPool::BufferPool(uint64_t max_cached_bytes, std::shared_ptr<MemoryPool> arenas)
+    : arenas_(std::move(arenas)), max_cached_bytes_(max_cached_bytes) {}
+
+BufferPool::~BufferPool() {
+  for (auto &free_list : free_lists_) {
+    for (auto hdr : free_list.second) {
+      FreeBlock(hdr);
+    }
+  }
+  free_lists_.clear();
+}
+
+Status BufferPool::CreateBufferPool(std::shared_ptr<BufferPool> *out_pool, int max_cached_mb, int arena_size) {
+  if (out_pool == nullptr) {
+    RETURN_STATUS_UNEXPECTED("out_pool is null");
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(max_cached_mb >= 0, "BufferPool: max_cached_mb must not be negative.");
+  CHECK_FAIL_RETURN_UNEXPECTED(arena_size > 0, "BufferPool: arena_size must be positive.");
+  std::shared_ptr<MemoryPool> arenas;
+  // The arenas are added on demand, without limit. A block which does not fit in an arena comes from malloc.
+  RETURN_IF_NOT_OK(CircularPool::CreateCircularPool(&arenas, -1, arena_size, false));
+  auto pool = new (std::nothrow) BufferPool(static_cast<uint64_t>(max_cached_mb) * 1024 * 1024, std::move(arenas));
+  if (pool == nullptr) {
+    return Status(StatusCode::kMDOutOfMemory);
+  }
+  (*out_pool).reset(pool);
+  return Status::OK();
+}
+
+Status BufferPool::AllocateBlock(uint64_t size_class, BlockHeader **hdr) {
+  void *p = nullptr;
+  bool from_arena = true;
+  Status rc = arenas_->Allocate(size_class + kHeaderSize, &p);
+  if (rc == StatusCode::kMDOutOfMemory) {
+    from_arena = false;
+    rc = DeMalloc(size_class + kHeaderSize, &p, false);
+  }
+  RETURN_IF_NOT_OK(rc);
+  *hdr = static_cast<BlockHeader *>(p);
+  (*hdr)->size_class = size_class;
+  (*hdr)->from_arena = from_arena;
+  return Status::OK();
+}
+
+void BufferPool::FreeBlock(BlockHeader *hdr) {
+  if (hdr->from_arena) {
+    arenas_->Deallocate(hdr);
+  } else {
+    free(hdr);
+  }
+}
+
+Status BufferPool::Allocate(size_t n, void **p) {
+  if (p == nullptr) {
+    RETURN_STATUS_UNEXPECTED("p is null");
+  }
+  uint64_t size_class = SizeClass(n);
+  BlockHeader *hdr = nullptr;
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    stats_.num_allocations++;
+    auto it = free_lists_.find(size_class);
+    if (it != free_lists_.end() && !it->second.empty()) {
+      hdr = it->second.back();
+      it->second.pop_back();
+      stats_.num_reuses++;
+      stats_.cached_bytes -= size_class;
+    } else {
+      stats_.num_upstream_allocations++;
+    }
+  }
+  if (hdr == nullptr) {
+    RETURN_IF_NOT_OK(AllocateBlock(size_class, &hdr));
+  }
+  *p = reinterpret_cast<char *>(hdr) + kHeaderSize;
+  return Status::OK();
+}
+
+void BufferPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  auto hdr = reinterpret_cast<BlockHeader *>(static_cast<char *>(p) - kHeaderSize);
+  {
+    std::unique_lock<std::mutex> lck(mux_);
+    if (stats_.cached_bytes + hdr->size_class <= max_cached_bytes_) {
+      free_lists_[hdr->size_class].push_back(hdr);
+      stats_.cached_bytes += hdr->size_class;
+      return;
+    }
+  }
+  FreeBlock(hdr);
+}
+
+Status BufferPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  if (p == nullptr) {
+    RETURN_STATUS_UNEXPECTED("p is null");
+  }
+  // The block already has room for the new size
+  if (*p != nullptr && SizeClass(new_sz) <= SizeClass(old_sz)) {
+    return Status::OK();
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr) {
+    errno_t err = memcpy_s(q, new_sz, *p, std::min(old_sz, new_sz));
+    if (err) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED(std::to_string(err));
+    }
+    Deallocate(*p);
+  }
+  *p = q;
+  return Status::OK();
+}
+
+uint64_t BufferPool::get_max_size() const { return std::numeric_limits<uint64_t>::max(); }
+
+int BufferPool::PercentFree() const { return 100; }
+
+BufferPool::Stats BufferPool::GetStats() const {
+  std::unique_lock<std::mutex> lck(mux_);
+  return stats_;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,99 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_POOL_H_
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "minddata/dataset/util/arena.h"
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A memory pool which recycles the blocks released to it.
+/// \details A pipeline produces rows of the same shape again and again, so the storage of the tensors it
+///     releases is exactly what it asks for next. Released blocks are kept in free lists keyed by their size,
+///     rounded up to the arena block size, and handed out again to the next request of the same size. New
+///     blocks are carved from a CircularPool of arenas, or from malloc when they do not fit in an arena.
+///     Blocks released once the free lists hold the maximum cached size are given back where they came from.
+class BufferPool : public MemoryPool {
+ public:
+  /// \brief The counters of the pool
+  struct Stats {
+    uint64_t num_allocations = 0;           // Blocks handed out
+    uint64_t num_reuses = 0;                // Blocks handed out from the free lists
+    uint64_t num_upstream_allocations = 0;  // Blocks taken from the arenas or from malloc
+    uint64_t cached_bytes = 0;              // Bytes sitting in the free lists
+  };
+
+  BufferPool(const BufferPool &) = delete;
+
+  BufferPool &operator=(const BufferPool &) = delete;
+
+  ~BufferPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override;
+
+  int PercentFree() const override;
+
+  /// \brief Get a snapshot of the counters of the pool
+  /// \return The counters
+  Stats GetStats() const;
+
+  /// \brief Create a buffer pool
+  /// \param[out] out_pool The pool created
+  /// \param max_cached_mb The most memory in MB kept in the free lists, 0 to give every block back on release
+  /// \param arena_size The size in MB of the arenas new blocks are carved from
+  /// \return Status object
+  static Status CreateBufferPool(std::shared_ptr<BufferPool> *out_pool, int max_cached_mb, int arena_size);
+
+ private:
+  // Each block starts with a header, the user memory follows it at an offset which keeps the alignment of the arena
+  struct BlockHeader {
+    uint64_t size_class;
+    bool from_arena;
+  };
+  static constexpr size_t kHeaderSize = ARENA_BLK_SZ;
+
+  BufferPool(uint64_t max_cached_bytes, std::shared_ptr<MemoryPool> arenas);
+
+  static uint64_t SizeClass(size_t n) { return (static_cast<uint64_t>(n) + ARENA_BLK_SZ - 1) & ~(ARENA_BLK_SZ - 1); }
+
+  // Take a new block of the given size class from the arenas, or from malloc if the arenas cannot hold it
+  Status AllocateBlock(uint64_t size_class, BlockHeader **hdr);
+
+  // Give a block back to where it came from
+  void FreeBlock(BlockHeader *hdr);
+
+  std::shared_ptr<MemoryPool> arenas_;
+  uint64_t max_cached_bytes_;
+  mutable std::mutex mux_;
+  std::unordered_map<uint64_t, std::vector<BlockHeader *>> free_lists_;
+  Stats stats_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_BUFFER_POOL_H_
@@ -16,6 +16,7 @@
 #ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 #define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_QUEUE_H_
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -45,7 +46,12 @@ class Queue {
   using const_reference = const T &;
 
   explicit Queue(int sz)
-      : sz_(sz), arr_(Services::GetAllocator<T>()), head_(0), tail_(0), my_name_(Services::GetUniqueID()) {
+      : sz_(sz),
+        limit_(sz),
+        arr_(Services::GetAllocator<T>()),
+        head_(0),
+        tail_(0),
+        my_name_(Services::GetUniqueID()) {
     Status rc = arr_.allocate(sz);
     if (rc.IsError()) {
       MS_LOG(ERROR) << "Fail to create a queue.";
@@ -62,7 +68,7 @@ class Queue {
     return (v >= 0) ? v : 0;
   }
 
-  size_t capacity() const { return sz_; }
+  size_t capacity() const { return limit_; }
 
   bool empty() const { return head_ == tail_; }
 
@@ -72,7 +78,7 @@ class Queue {
   Status Add(const_reference ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       auto k = tail_++ % sz_;
       *(arr_[k]) = ele;
@@ -87,7 +93,7 @@ class Queue {
   Status Add(T &&ele) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       auto k = tail_++ % sz_;
       *(arr_[k]) = std::forward<T>(ele);
@@ -103,7 +109,7 @@ class Queue {
   Status EmplaceBack(Ts &&... args) noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // Block when full
-    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() != capacity()); });
+    Status rc = full_cv_.Wait(&_lock, [this]() -> bool { return (size() < capacity()); });
     if (rc.IsOk()) {
       auto k = tail_++ % sz_;
       new (arr_[k]) T(std::forward<Ts>(args)...);
@@ -131,6 +137,45 @@ class Queue {
     return rc;
   }
 
+  // Pop the front element without blocking.
+  // @return false if the queue is empty
+  bool TryPopFront(pointer p) {
+    std::unique_lock<std::mutex> _lock(mux_);
+    if (empty()) {
+      return false;
+    }
+    auto k = head_++ % sz_;
+    *p = std::move(*(arr_[k]));
+    full_cv_.NotifyAll();
+    return true;
+  }
+
+  // Change the capacity of the queue while it is in use. Elements already in the queue are kept, so if the
+  // new capacity is smaller than the current size, producers will block until enough elements are consumed.
+  // @param sz - The new capacity
+  // @return Status error code
+  Status Resize(int sz) noexcept {
+    CHECK_FAIL_RETURN_UNEXPECTED(sz > 0, "Invalid queue capacity: " + std::to_string(sz));
+    std::unique_lock<std::mutex> _lock(mux_);
+    const size_t n = size();
+    const size_t new_sz = std::max(static_cast<size_t>(sz), n);
+    if (new_sz != sz_) {
+      MemGuard<T, Allocator<T>> new_arr(Services::GetAllocator<T>());
+      RETURN_IF_NOT_OK(new_arr.allocate(new_sz));
+      for (size_t i = 0; i < n; ++i) {
+        *(new_arr[i]) = std::move(*(arr_[(head_ + i) % sz_]));
+      }
+      arr_ = std::move(new_arr);
+      sz_ = new_sz;
+      head_ = 0;
+      tail_ = n;
+    }
+    limit_ = static_cast<size_t>(sz);
+    MS_LOG(DEBUG) << "Resize Q with uuid " << my_name_ << " to size " << limit_ << ".";
+    full_cv_.NotifyAll();
+    return Status::OK();
+  }
+
   void ResetQue() noexcept {
     std::unique_lock<std::mutex> _lock(mux_);
     // If there are elements in the queue, drain them. We won't call PopFront directly
@@ -160,7 +205,8 @@ class Queue {
   }
 
  private:
-  size_t sz_;
+  size_t sz_;     // Number of slots allocated in arr_
+  size_t limit_;  // Number of elements allowed in the queue, never more than sz_
   MemGuard<T, Allocator<T>> arr_;
   size_t head_;
   size_t tail_;
@@ -79,7 +79,7 @@ enum TaskType {
 };
 enum SamplerType { kCustomTopNSampler, kCustomTopPercentSampler, kSubsetRandomSampler, kPKSampler, kSubsetSampler };
 
-enum ShuffleType { kShuffleCategory, kShuffleSample };
+enum ShuffleType { kShuffleCategory, kShuffleSample, kShuffleBlock };
 
 const double kEpsilon = 1e-7;
 
@@ -97,6 +97,10 @@ const int kMaxHeaderSize = 1 << 27;  // 128MB
 const int kMinPageSize = 1 << 15;  // 32KB
 const int kMaxPageSize = 1 << 28;  // 256MB
 
+// Block shuffle parameters
+const uint32_t kDefaultShuffleWindowPages = 8;  // number of pages whose samples are shuffled together
+const uint32_t kPageCacheWindows = 2;           // page cache holds the current and the prefetched window
+
 // used by value length / schema id length / statistic id length ...
 const uint64_t kInt64Len = 8;
 
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
+
+#include <atomic>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include "minddata/mindrecord/include/shard_error.h"
+
+namespace mindspore {
+namespace mindrecord {
+const uint32_t kIoRingEntries = 64;         // number of reads submitted to the kernel at once
+const uint32_t kMaxIovecPerRead = 64;       // maximum number of buffers filled by one coalesced read
+const uint64_t kMaxCoalesceGap = 4096;      // maximum hole between two blobs which are read together
+const uint64_t kMaxCoalesceSize = 4 << 20;  // maximum size of one coalesced read
+const uint32_t kMaxReadPoolThreads = 8;     // maximum number of threads of the pread fallback
+
+/// \brief read `size` bytes at `offset` of the shard file into `buffer`
+struct ShardReadRequest {
+  uint32_t shard_id;
+  uint64_t offset;
+  uint64_t size;
+  uint8_t *buffer;
+};
+
+class ShardIoRing;
+
+/// \brief the read engine of one consumer, the requests of one call are sorted by file position, the adjacent
+///        requests are coalesced to one vectored read, and all the reads are submitted together through io_uring,
+///        or through the shared pread thread pool when io_uring is not available.
+class ShardIOEngine {
+ public:
+  explicit ShardIOEngine(const std::vector<std::string> &file_paths);
+
+  ~ShardIOEngine();
+
+  /// \brief open the shard files and set up the io ring
+  MSRStatus Open();
+
+  /// \brief close the shard files and the io ring
+  void Close();
+
+  /// \brief read all the requests, return after all of them are done
+  MSRStatus Read(const std::vector<ShardReadRequest> &requests);
+
+  /// \brief whether the reads are submitted through io_uring
+  bool UseIoRing() const { return io_ring_ != nullptr; }
+
+  /// \brief number of bytes read from the shard files, including the holes between the coalesced blobs
+  uint64_t GetBytesRead() const { return bytes_read_; }
+
+ private:
+  /// \brief one read of the shard file which fills one or more buffers
+  struct ReadGroup {
+    uint32_t shard_id;
+    uint64_t offset;
+    uint64_t size;
+    std::vector<std::pair<uint8_t *, uint64_t>> buffers;
+  };
+
+  /// \brief sort the requests by file position and merge the adjacent ones, the holes between them are read into
+  ///        `gap_buffer` of the caller
+  std::vector<ReadGroup> Coalesce(const std::vector<ShardReadRequest> &requests, std::vector<uint8_t> *gap_buffer);
+
+  /// \brief submit the read groups through io_uring
+  MSRStatus ReadByIoRing(std::vector<ReadGroup> *groups);
+
+  /// \brief submit the read groups to the pread thread pool
+  MSRStatus ReadByPool(std::vector<ReadGroup> *groups);
+
+  /// \brief read until `size` bytes at `offset` of the shard file are filled
+  bool ReadAt(uint32_t shard_id, uint8_t *buffer, uint64_t size, uint64_t offset);
+
+  /// \brief finish the read group synchronously from the `done` bytes, also used to complete the short reads
+  MSRStatus ReadGroupSync(const ReadGroup &group, uint64_t done);
+
+  std::vector<std::string> file_paths_;
+#if defined(_WIN32) || defined(_WIN64)
+  std::vector<std::shared_ptr<std::fstream>> file_streams_;
+#else
+  std::vector<int> fds_;
+#endif
+  std::unique_ptr<ShardIoRing> io_ring_;
+  std::atomic<uint64_t> bytes_read_{0};
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_IO_ENGINE_H_
@@ -0,0 +1,87 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
+#define MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace mindspore {
+namespace mindrecord {
+/// \brief the bounded LRU cache of the whole blob pages shared by all the consumers of one reader. A page is loaded
+///        by the consumer which claims it first, the other consumers wait for it instead of reading it again.
+class ShardPageCache {
+ public:
+  using PageKey = std::pair<uint32_t, uint64_t>;  // shard id, page id
+  using PageData = std::shared_ptr<std::vector<uint8_t>>;
+
+  explicit ShardPageCache(uint64_t capacity) : capacity_(capacity) {}
+
+  ~ShardPageCache() = default;
+
+  /// \brief get the page if it is cached, otherwise claim it when nobody is loading it
+  /// \param[out] data the page, nullptr if it is not cached
+  /// \return true if the caller claims the page and has to Fill or Abandon it
+  bool TryGet(const PageKey &key, PageData *data);
+
+  /// \brief wait for the page loaded by another consumer
+  /// \return the page, nullptr if the loading failed
+  PageData Wait(const PageKey &key);
+
+  /// \brief put the page claimed by the caller, the least recently used pages are evicted
+  void Fill(const PageKey &key, PageData data);
+
+  /// \brief give up the page claimed by the caller
+  void Abandon(const PageKey &key);
+
+  /// \brief count the blobs copied from the cached pages and the blobs which caused a read
+  void AddLookups(uint64_t hit_count, uint64_t miss_count);
+
+  uint64_t GetHitCount() const;
+
+  uint64_t GetMissCount() const;
+
+  /// \brief ratio of the blobs served from the cache without a read of their own
+  double GetHitRate() const;
+
+ private:
+  struct Entry {
+    PageData data;                   // nullptr while the page is being loaded
+    std::list<PageKey>::iterator lru;
+  };
+
+  void Evict();
+
+  uint64_t capacity_;
+  uint64_t size_ = 0;
+  uint64_t hit_count_ = 0;
+  uint64_t miss_count_ = 0;
+  std::map<PageKey, Entry> entries_;
+  std::list<PageKey> lru_;  // the loaded pages, the most recently used at the front
+  mutable std::mutex mtx_;
+  std::condition_variable cv_;
+};
+}  // namespace mindrecord
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_MINDRECORD_INCLUDE_SHARD_PAGE_CACHE_H_
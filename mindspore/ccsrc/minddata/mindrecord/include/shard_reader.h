@@ -27,7 +27,9 @@
 #include <unistd.h>
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
+#include <deque>
 #include <fstream>
 #include <iostream>
 #include <map>
@@ -48,7 +50,9 @@
 #include "minddata/mindrecord/include/shard_distributed_sample.h"
 #include "minddata/mindrecord/include/shard_error.h"
 #include "minddata/mindrecord/include/shard_index_generator.h"
+#include "minddata/mindrecord/include/shard_io_engine.h"
 #include "minddata/mindrecord/include/shard_operator.h"
+#include "minddata/mindrecord/include/shard_page_cache.h"
 #include "minddata/mindrecord/include/shard_pk_sample.h"
 #include "minddata/mindrecord/include/shard_reader.h"
 #include "minddata/mindrecord/include/shard_sample.h"
@@ -66,6 +70,7 @@ using ROW_GROUP_BRIEF =
 using TASK_RETURN_CONTENT =
   std::pair<MSRStatus, std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>>;
 const int kNumBatchInMap = 1000;  // iterator buffer size in row-reader mode
+const int kNumRowsInRead = 32;    // number of rows read together by one consumer in row-reader mode
 
 class API_PUBLIC ShardReader {
  public:
@@ -144,6 +149,14 @@ class API_PUBLIC ShardReader {
   /// \return # of rows
   int GetNumRows() const;
 
+  /// \brief get the ratio of the blob page lookups served from the page cache, the cache is used by block shuffle
+  /// \return hit rate, 0 if the page cache is not used
+  double GetPageCacheHitRate() const;
+
+  /// \brief get the number of bytes read from the shard files by the consumers
+  /// \return # of bytes
+  uint64_t GetBytesRead() const;
+
   /// \brief Read the summary of row groups
   /// \return the tuple of 4 elements
   ///         1. Sharding ID
@@ -188,6 +201,11 @@ class API_PUBLIC ShardReader {
   std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> GetNextById(const int64_t &task_id,
                                                                                        const int32_t &consumer_id);
 
+  /// \brief return the rows of the ids, the blobs of all the rows are read together by the io engine of consumer
+  /// \return one row for each id before the first id out of range, empty if failed
+  std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> GetNextByIds(
+    const std::vector<int64_t> &task_ids, const int32_t &consumer_id);
+
   /// \brief return a batch, given that one is ready, python API
   /// \return a batch of images and image data
   std::vector<std::tuple<std::vector<std::vector<uint8_t>>, pybind11::object>> GetNextPy();
@@ -289,8 +307,32 @@ class API_PUBLIC ShardReader {
   /// \brief open multiple file handle
   void FileStreamsOperator();
 
-  /// \brief read one row by one task
-  TASK_RETURN_CONTENT ConsumerOneTask(int task_id, uint32_t consumer_id);
+  /// \brief read the rows of the tasks, the blobs of all the rows are read together by the io engine of consumer,
+  ///        the pages of the prefetch tasks are loaded in the background when the page cache is used
+  MSRStatus ConsumerTasks(const std::vector<int> &task_ids, uint32_t consumer_id,
+                          std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> *rows,
+                          const std::vector<int> &prefetch_task_ids = {});
+
+  /// \brief get the type of task, and the position of blob and the scalar variable fields of the common task
+  MSRStatus GetBlobOfTask(int task_id, TaskType *task_type, ShardReadRequest *request, json *var_fields,
+                          std::shared_ptr<Page> *blob_page = nullptr);
+
+  /// \brief get the page where the blob of the task is located, nullptr if it is unknown without reading the index
+  std::shared_ptr<Page> GetPageOfTask(int task_id);
+
+  /// \brief copy the blobs from the cached pages, the missing prefetch pages are handed to the prefetch thread
+  MSRStatus ReadBlobsByPage(const std::vector<ShardReadRequest> &requests,
+                            const std::vector<std::shared_ptr<Page>> &pages,
+                            const std::vector<std::shared_ptr<Page>> &prefetch_pages, uint32_t consumer_id);
+
+  /// \brief create the page cache when the tasks are shuffled by block
+  void InitPageCache();
+
+  /// \brief load the claimed prefetch pages into the page cache until the prefetch is stopped
+  void PrefetchPages();
+
+  /// \brief stop the prefetch thread, the pages not loaded yet are abandoned
+  void StopPrefetch();
 
   /// \brief get labels from binary file
   std::pair<MSRStatus, std::vector<json>> GetLabelsFromBinaryFile(
@@ -320,7 +362,9 @@ class API_PUBLIC ShardReader {
   std::vector<sqlite3 *> database_paths_;                                        // sqlite handle list
   std::vector<string> file_paths_;                                               // file paths
   std::vector<std::shared_ptr<std::fstream>> file_streams_;                      // single-file handle list
-  std::vector<std::vector<std::shared_ptr<std::fstream>>> file_streams_random_;  // multiple-file handle list
+  std::vector<std::shared_ptr<ShardIOEngine>> io_engines_;                       // read engine of each consumer
+  std::shared_ptr<ShardPageCache> page_cache_;                                   // blob pages of block shuffle
+  std::shared_ptr<ShardIOEngine> prefetch_engine_;                               // read engine of prefetch thread
 
  private:
   int n_consumer_;                                         // number of workers (threads)
@@ -350,6 +394,14 @@ class API_PUBLIC ShardReader {
   std::unordered_map<int, std::shared_ptr<std::vector<std::tuple<std::vector<uint8_t>, json>>>> delivery_map_;
   // Delivery/Iterator mode end
 
+  // pages claimed for prefetch, they are loaded by the prefetch thread without blocking the consumers
+  const std::string kPrefetchThreadName = "THRD_PREFETCH";
+  std::thread prefetch_thread_;
+  std::mutex mtx_prefetch_;
+  std::condition_variable cv_prefetch_;
+  std::deque<std::pair<ShardPageCache::PageKey, std::shared_ptr<Page>>> prefetch_queue_;
+  bool prefetch_stopped_ = false;
+
   // all metadata in the index is not loaded during initialization
   bool lazy_load_;
 
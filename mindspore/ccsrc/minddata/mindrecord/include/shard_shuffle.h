@@ -29,12 +29,20 @@ class __attribute__((visibility("default"))) ShardShuffle : public ShardOperator
   ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacement, bool reshuffle_each_epoch,
                ShuffleType shuffle_type = kShuffleSample);
 
+  /// \brief shuffle the blob pages, then shuffle the samples within each window of `window_pages` pages,
+  ///        so that the reader fetches whole pages sequentially instead of one small read per sample
+  ShardShuffle(uint32_t seed, ShuffleType shuffle_type, uint32_t window_pages, bool reshuffle_each_epoch = true);
+
   ~ShardShuffle() override{};
 
   MSRStatus Execute(ShardTaskList &tasks) override;
 
   int64_t GetNumSamples(int64_t dataset_size, int64_t num_classes) override;
 
+  ShuffleType GetShuffleType() const { return shuffle_type_; }
+
+  uint32_t GetWindowPages() const { return window_pages_; }
+
  private:
   // Private helper function
   MSRStatus CategoryShuffle(ShardTaskList &tasks);
@@ -45,11 +53,15 @@ class __attribute__((visibility("default"))) ShardShuffle : public ShardOperator
   // Shuffle the file sequence but keep the order of data within each file
   MSRStatus ShuffleFiles(ShardTaskList &tasks);
 
+  // Shuffle the pages, and shuffle the data within each window of pages
+  MSRStatus ShuffleBlock(ShardTaskList &tasks);
+
   uint32_t shuffle_seed_;
   int64_t no_of_samples_;
   bool replacement_;
   bool reshuffle_each_epoch_;
   ShuffleType shuffle_type_;
+  uint32_t window_pages_;
 };
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,524 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_io_engine.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <tuple>
+#if !defined(_WIN32) && !defined(_WIN64)
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#if defined(__NR_io_uring_setup) && defined(__NR_io_uring_enter)
+#define ENABLE_SHARD_IO_RING
+#endif
+#endif
+#endif
+#include "utils/log_adapter.h"
+#include "utils/ms_utils.h"
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+// The pread thread pool shared by all the engines, used when io_uring is not available.
+class ReadPool {
+ public:
+  static ReadPool &GetInstance() {
+    static ReadPool instance;
+    return instance;
+  }
+
+  void Submit(std::function<void()> &&job) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      jobs_.push(std::move(job));
+    }
+    cv_.notify_one();
+  }
+
+ private:
+  ReadPool() {
+    uint32_t thread_num = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_num = std::min(thread_num, kMaxReadPoolThreads);
+    for (uint32_t i = 0; i < thread_num; ++i) {
+      workers_.emplace_back([this] { Run(); });
+    }
+  }
+
+  ~ReadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Run() {
+    for (;;) {
+      std::function<void()> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+        if (jobs_.empty()) {
+          return;
+        }
+        job = std::move(jobs_.front());
+        jobs_.pop();
+      }
+      job();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::queue<std::function<void()>> jobs_;
+  std::vector<std::thread> workers_;
+  bool stop_ = false;
+};
+}  // namespace
+
+#ifdef ENABLE_SHARD_IO_RING
+// The minimal io_uring of one engine, the rings are mapped from the kernel and driven by the raw syscalls, so that
+// no liburing is required. Only one thread uses the ring at a time.
+class ShardIoRing {
+ public:
+  ShardIoRing() = default;
+
+  ~ShardIoRing() {
+    if (sqes_ != nullptr) {
+      (void)munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) {
+      (void)munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != nullptr) {
+      (void)munmap(sq_ptr_, sq_size_);
+    }
+    if (ring_fd_ >= 0) {
+      (void)close(ring_fd_);
+    }
+  }
+
+  bool Init(uint32_t entries) {
+    io_uring_params params;
+    (void)memset(&params, 0, sizeof(params));
+    ring_fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (ring_fd_ < 0) {
+      return false;
+    }
+    sq_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = false;
+#ifdef IORING_FEAT_SINGLE_MMAP
+    single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#endif
+    if (single_mmap) {
+      sq_size_ = std::max(sq_size_, cq_size_);
+      cq_size_ = sq_size_;
+    }
+    sq_ptr_ = MapRing(sq_size_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == nullptr) {
+      return false;
+    }
+    cq_ptr_ = single_mmap ? sq_ptr_ : MapRing(cq_size_, IORING_OFF_CQ_RING);
+    if (cq_ptr_ == nullptr) {
+      return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = reinterpret_cast<io_uring_sqe *>(MapRing(sqes_size_, IORING_OFF_SQES));
+    if (sqes_ == nullptr) {
+      return false;
+    }
+
+    auto sq_base = reinterpret_cast<uint8_t *>(sq_ptr_);
+    sq_tail_ = reinterpret_cast<uint32_t *>(sq_base + params.sq_off.tail);
+    sq_mask_ = *reinterpret_cast<uint32_t *>(sq_base + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<uint32_t *>(sq_base + params.sq_off.array);
+    auto cq_base = reinterpret_cast<uint8_t *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<uint32_t *>(cq_base + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<uint32_t *>(cq_base + params.cq_off.tail);
+    cq_mask_ = *reinterpret_cast<uint32_t *>(cq_base + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq_base + params.cq_off.cqes);
+    entries_ = params.sq_entries;
+    return true;
+  }
+
+  uint32_t entries() const { return entries_; }
+
+  // Queue one vectored read, the caller keeps the number of reads in flight under the entries.
+  void PrepareReadv(int fd, const iovec *iov, uint32_t iov_num, uint64_t offset, uint64_t user_data) {
+    uint32_t tail = *sq_tail_;
+    uint32_t index = tail & sq_mask_;
+    io_uring_sqe *sqe = &sqes_[index];
+    (void)memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(iov);
+    sqe->len = iov_num;
+    sqe->off = offset;
+    sqe->user_data = user_data;
+    sq_array_[index] = index;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++to_submit_;
+  }
+
+  // Submit the queued reads and wait for at least `wait_num` of them to complete.
+  bool Submit(uint32_t wait_num) {
+    for (;;) {
+      uint32_t flags = wait_num > 0 ? IORING_ENTER_GETEVENTS : 0;
+      auto ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit_, wait_num, flags, nullptr, 0);
+      if (ret < 0 && errno == EINTR) {
+        continue;
+      }
+      if (ret < 0) {
+        return false;
+      }
+      to_submit_ -= std::min(static_cast<uint32_t>(ret), to_submit_);
+      return true;
+    }
+  }
+
+  // Drop the reads which are queued but not submitted, return the number of them.
+  uint32_t DiscardUnsubmitted() {
+    uint32_t discarded = to_submit_;
+    __atomic_store_n(sq_tail_, *sq_tail_ - discarded, __ATOMIC_RELEASE);
+    to_submit_ = 0;
+    return discarded;
+  }
+
+  // Wait for `inflight` submitted reads to complete and drop their completions.
+  bool Drain(uint32_t inflight) {
+    uint64_t user_data = 0;
+    int32_t result = 0;
+    while (inflight > 0) {
+      if (PopCompletion(&user_data, &result)) {
+        --inflight;
+        continue;
+      }
+      auto ret = syscall(__NR_io_uring_enter, ring_fd_, 0, inflight, IORING_ENTER_GETEVENTS, nullptr, 0);
+      if (ret < 0 && errno != EINTR) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Pop one completed read, return false if there is none.
+  bool PopCompletion(uint64_t *user_data, int32_t *result) {
+    uint32_t head = *cq_head_;
+    if (head == __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE)) {
+      return false;
+    }
+    const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+    *user_data = cqe.user_data;
+    *result = cqe.res;
+    __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);
+    return true;
+  }
+
+ private:
+  void *MapRing(size_t size, off_t offset) {
+    void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, offset);
+    return ptr == MAP_FAILED ? nullptr : ptr;
+  }
+
+  int ring_fd_ = -1;
+  uint32_t entries_ = 0;
+  uint32_t to_submit_ = 0;
+  void *sq_ptr_ = nullptr;
+  void *cq_ptr_ = nullptr;
+  size_t sq_size_ = 0;
+  size_t cq_size_ = 0;
+  size_t sqes_size_ = 0;
+  io_uring_sqe *sqes_ = nullptr;
+  uint32_t *sq_tail_ = nullptr;
+  uint32_t sq_mask_ = 0;
+  uint32_t *sq_array_ = nullptr;
+  uint32_t *cq_head_ = nullptr;
+  uint32_t *cq_tail_ = nullptr;
+  uint32_t cq_mask_ = 0;
+  io_uring_cqe *cqes_ = nullptr;
+};
+#else
+class ShardIoRing {};
+#endif
+
+ShardIOEngine::ShardIOEngine(const std::vector<std::string> &file_paths) : file_paths_(file_paths) {}
+
+ShardIOEngine::~ShardIOEngine() { Close(); }
+
+MSRStatus ShardIOEngine::Open() {
+  for (const auto &file : file_paths_) {
+#if defined(_WIN32) || defined(_WIN64)
+    std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
+    fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
+    if (!fs->good()) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
+      Close();
+      return FAILED;
+    }
+    file_streams_.push_back(fs);
+#else
+    int fd = ::open(common::SafeCStr(file), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+      MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
+      Close();
+      return FAILED;
+    }
+    fds_.push_back(fd);
+#endif
+  }
+
+#ifdef ENABLE_SHARD_IO_RING
+  auto io_ring = std::make_unique<ShardIoRing>();
+  if (io_ring->Init(kIoRingEntries)) {
+    io_ring_ = std::move(io_ring);
+  } else {
+    MS_LOG(INFO) << "io_uring is not available, the shard files are read by the pread thread pool.";
+  }
+#endif
+  return SUCCESS;
+}
+
+void ShardIOEngine::Close() {
+  io_ring_.reset();
+#if defined(_WIN32) || defined(_WIN64)
+  for (auto &fs : file_streams_) {
+    fs->close();
+  }
+  file_streams_.clear();
+#else
+  for (auto fd : fds_) {
+    (void)::close(fd);
+  }
+  fds_.clear();
+#endif
+}
+
+MSRStatus ShardIOEngine::Read(const std::vector<ShardReadRequest> &requests) {
+  for (const auto &request : requests) {
+    if (request.shard_id >= file_paths_.size() || (request.buffer == nullptr && request.size > 0)) {
+      MS_LOG(ERROR) << "Invalid read request of shard: " << request.shard_id << ", size: " << request.size;
+      return FAILED;
+    }
+  }
+  // the holes between the coalesced blobs are read into the buffer of this call, so the concurrent calls never share
+  std::vector<uint8_t> gap_buffer;
+  auto groups = Coalesce(requests, &gap_buffer);
+  if (groups.empty()) {
+    return SUCCESS;
+  }
+  for (const auto &group : groups) {
+    bytes_read_ += group.size;
+  }
+  // a single read is cheaper to issue directly than to hand over to the ring or the pool
+  if (groups.size() == 1) {
+    return ReadGroupSync(groups[0], 0);
+  }
+  if (io_ring_ != nullptr) {
+    return ReadByIoRing(&groups);
+  }
+  return ReadByPool(&groups);
+}
+
+std::vector<ShardIOEngine::ReadGroup> ShardIOEngine::Coalesce(const std::vector<ShardReadRequest> &requests,
+                                                              std::vector<uint8_t> *gap_buffer) {
+  std::vector<const ShardReadRequest *> sorted;
+  for (const auto &request : requests) {
+    if (request.size > 0) {
+      sorted.push_back(&request);
+    }
+  }
+  std::sort(sorted.begin(), sorted.end(), [](const ShardReadRequest *lhs, const ShardReadRequest *rhs) {
+    return std::tie(lhs->shard_id, lhs->offset) < std::tie(rhs->shard_id, rhs->offset);
+  });
+
+  std::vector<ReadGroup> groups;
+  for (const auto request : sorted) {
+    if (!groups.empty()) {
+      auto &last = groups.back();
+      uint64_t last_end = last.offset + last.size;
+      // the overlapped requests, e.g. the same row sampled twice, are not merged
+      if (last.shard_id == request->shard_id && request->offset >= last_end &&
+          request->offset - last_end <= kMaxCoalesceGap &&
+          request->offset + request->size - last.offset <= kMaxCoalesceSize &&
+          last.buffers.size() + 2 <= kMaxIovecPerRead) {
+        if (request->offset > last_end) {
+          if (gap_buffer->empty()) {
+            gap_buffer->resize(kMaxCoalesceGap);
+          }
+          last.buffers.emplace_back(gap_buffer->data(), request->offset - last_end);
+        }
+        last.buffers.emplace_back(request->buffer, request->size);
+        last.size = request->offset + request->size - last.offset;
+        continue;
+      }
+    }
+    groups.push_back({request->shard_id, request->offset, request->size, {{request->buffer, request->size}}});
+  }
+  return groups;
+}
+
+MSRStatus ShardIOEngine::ReadByIoRing(std::vector<ReadGroup> *groups) {
+#ifdef ENABLE_SHARD_IO_RING
+  std::vector<std::vector<iovec>> iovecs(groups->size());
+  size_t next = 0;
+  uint32_t inflight = 0;
+  MSRStatus status = SUCCESS;
+  while (next < groups->size() || inflight > 0) {
+    while (next < groups->size() && inflight < io_ring_->entries()) {
+      const auto &group = (*groups)[next];
+      for (const auto &buffer : group.buffers) {
+        iovecs[next].push_back({buffer.first, buffer.second});
+      }
+      io_ring_->PrepareReadv(fds_[group.shard_id], iovecs[next].data(), iovecs[next].size(), group.offset, next);
+      ++next;
+      ++inflight;
+    }
+    if (!io_ring_->Submit(1)) {
+      MS_LOG(ERROR) << "Failed to submit the reads to io_uring, errno: " << errno;
+      // the submitted reads still fill the buffers and refer to the iovecs, wait for them before returning
+      inflight -= io_ring_->DiscardUnsubmitted();
+      if (!io_ring_->Drain(inflight)) {
+        MS_LOG(ERROR) << "Failed to wait for the reads in flight of io_uring, errno: " << errno
+                      << ", the shard files are read by the pread thread pool from now on.";
+        io_ring_.reset();
+      }
+      return FAILED;
+    }
+    uint64_t index = 0;
+    int32_t result = 0;
+    while (io_ring_->PopCompletion(&index, &result)) {
+      --inflight;
+      const auto &group = (*groups)[index];
+      if (result == -EINTR || result == -EAGAIN) {
+        result = 0;
+      }
+      if (result < 0) {
+        MS_LOG(ERROR) << "File read failed: " << file_paths_[group.shard_id] << ", errno: " << -result;
+        status = FAILED;
+        continue;
+      }
+      if (static_cast<uint64_t>(result) < group.size && ReadGroupSync(group, result) != SUCCESS) {
+        status = FAILED;
+      }
+    }
+  }
+  return status;
+#else
+  return ReadByPool(groups);
+#endif
+}
+
+MSRStatus ShardIOEngine::ReadByPool(std::vector<ReadGroup> *groups) {
+#if defined(_WIN32) || defined(_WIN64)
+  for (const auto &group : *groups) {
+    if (ReadGroupSync(group, 0) != SUCCESS) {
+      return FAILED;
+    }
+  }
+  return SUCCESS;
+#else
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t pending = groups->size();
+  bool failed = false;
+  for (const auto &group : *groups) {
+    ReadPool::GetInstance().Submit([this, &group, &mtx, &cv, &pending, &failed]() {
+      auto ret = ReadGroupSync(group, 0);
+      std::lock_guard<std::mutex> lock(mtx);
+      failed = failed || ret != SUCCESS;
+      if (--pending == 0) {
+        cv.notify_one();
+      }
+    });
+  }
+  std::unique_lock<std::mutex> lock(mtx);
+  cv.wait(lock, [&pending] { return pending == 0; });
+  return failed ? FAILED : SUCCESS;
+#endif
+}
+
+bool ShardIOEngine::ReadAt(uint32_t shard_id, uint8_t *buffer, uint64_t size, uint64_t offset) {
+#if defined(_WIN32) || defined(_WIN64)
+  auto &io_seekg = file_streams_[shard_id]->seekg(offset, std::ios::beg);
+  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
+    return false;
+  }
+  auto &io_read = file_streams_[shard_id]->read(reinterpret_cast<char *>(buffer), size);
+  return io_read.good() && !io_read.fail() && !io_read.bad();
+#else
+  while (size > 0) {
+    auto ret = pread(fds_[shard_id], buffer, size, static_cast<off_t>(offset));
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    if (ret <= 0) {
+      return false;
+    }
+    buffer += ret;
+    size -= static_cast<uint64_t>(ret);
+    offset += static_cast<uint64_t>(ret);
+  }
+  return true;
+#endif
+}
+
+MSRStatus ShardIOEngine::ReadGroupSync(const ReadGroup &group, uint64_t done) {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  if (done == 0 && group.buffers.size() > 1) {
+    std::vector<iovec> iov;
+    for (const auto &buffer : group.buffers) {
+      iov.push_back({buffer.first, buffer.second});
+    }
+    ssize_t ret = 0;
+    do {
+      ret = preadv(fds_[group.shard_id], iov.data(), static_cast<int>(iov.size()), static_cast<off_t>(group.offset));
+    } while (ret < 0 && errno == EINTR);
+    done = ret > 0 ? static_cast<uint64_t>(ret) : 0;
+  }
+#endif
+  uint64_t position = 0;
+  for (const auto &buffer : group.buffers) {
+    if (position + buffer.second > done) {
+      uint64_t skip = done > position ? done - position : 0;
+      if (!ReadAt(group.shard_id, buffer.first + skip, buffer.second - skip, group.offset + position + skip)) {
+        MS_LOG(ERROR) << "File read failed: " << file_paths_[group.shard_id] << ", offset: " << group.offset + position;
+        return FAILED;
+      }
+    }
+    position += buffer.second;
+  }
+  return SUCCESS;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
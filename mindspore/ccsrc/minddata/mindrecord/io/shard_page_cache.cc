@@ -0,0 +1,103 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/mindrecord/include/shard_page_cache.h"
+
+namespace mindspore {
+namespace mindrecord {
+bool ShardPageCache::TryGet(const PageKey &key, PageData *data) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto iter = entries_.find(key);
+  if (iter == entries_.end()) {
+    *data = nullptr;
+    (void)entries_.emplace(key, Entry{nullptr, lru_.end()});
+    return true;
+  }
+  *data = iter->second.data;
+  if (*data != nullptr) {
+    lru_.splice(lru_.begin(), lru_, iter->second.lru);
+  }
+  return false;
+}
+
+ShardPageCache::PageData ShardPageCache::Wait(const PageKey &key) {
+  std::unique_lock<std::mutex> lock(mtx_);
+  PageData data = nullptr;
+  cv_.wait(lock, [this, &key, &data] {
+    auto iter = entries_.find(key);
+    if (iter == entries_.end()) {
+      return true;
+    }
+    data = iter->second.data;
+    return data != nullptr;
+  });
+  return data;
+}
+
+void ShardPageCache::Fill(const PageKey &key, PageData data) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    auto &entry = entries_[key];
+    size_ += data->size();
+    entry.data = std::move(data);
+    lru_.push_front(key);
+    entry.lru = lru_.begin();
+    Evict();
+  }
+  cv_.notify_all();
+}
+
+void ShardPageCache::Abandon(const PageKey &key) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    (void)entries_.erase(key);
+  }
+  cv_.notify_all();
+}
+
+void ShardPageCache::Evict() {
+  // the newly filled page is kept even if it is larger than the capacity
+  while (size_ > capacity_ && lru_.size() > 1) {
+    auto iter = entries_.find(lru_.back());
+    size_ -= iter->second.data->size();
+    (void)entries_.erase(iter);
+    lru_.pop_back();
+  }
+}
+
+void ShardPageCache::AddLookups(uint64_t hit_count, uint64_t miss_count) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  hit_count_ += hit_count;
+  miss_count_ += miss_count;
+}
+
+uint64_t ShardPageCache::GetHitCount() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return hit_count_;
+}
+
+uint64_t ShardPageCache::GetMissCount() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return miss_count_;
+}
+
+double ShardPageCache::GetHitRate() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  auto total = hit_count_ + miss_count_;
+  return total == 0 ? 0 : static_cast<double>(hit_count_) / total;
+}
+}  // namespace mindrecord
+}  // namespace mindspore
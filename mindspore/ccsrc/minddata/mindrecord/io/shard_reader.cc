@@ -213,20 +213,15 @@ MSRStatus ShardReader::Open() {
 }
 
 MSRStatus ShardReader::Open(int n_consumer) {
-  file_streams_random_ =
-    std::vector<std::vector<std::shared_ptr<std::fstream>>>(n_consumer, std::vector<std::shared_ptr<std::fstream>>());
-  for (const auto &file : file_paths_) {
-    for (int j = 0; j < n_consumer; ++j) {
-      std::shared_ptr<std::fstream> fs = std::make_shared<std::fstream>();
-      fs->open(common::SafeCStr(file), std::ios::in | std::ios::binary);
-      if (!fs->good()) {
-        MS_LOG(ERROR) << "Invalid file, failed to open file: " << file;
-        return FAILED;
-      }
-      file_streams_random_[j].push_back(fs);
+  io_engines_.clear();
+  for (int j = 0; j < n_consumer; ++j) {
+    auto io_engine = std::make_shared<ShardIOEngine>(file_paths_);
+    if (io_engine->Open() != SUCCESS) {
+      return FAILED;
     }
-    MS_LOG(INFO) << "Open shard file successfully.";
+    io_engines_.push_back(io_engine);
   }
+  MS_LOG(INFO) << "Open shard file successfully.";
 
   return SUCCESS;
 }
@@ -237,11 +232,9 @@ void ShardReader::FileStreamsOperator() {
       file_streams_[i]->close();
     }
   }
-  for (int i = static_cast<int>(file_streams_random_.size()) - 1; i >= 0; --i) {
-    for (int j = static_cast<int>(file_streams_random_[i].size()) - 1; j >= 0; --j) {
-      if (file_streams_random_[i][j] != nullptr) {
-        file_streams_random_[i][j]->close();
-      }
+  for (int i = static_cast<int>(io_engines_.size()) - 1; i >= 0; --i) {
+    if (io_engines_[i] != nullptr) {
+      io_engines_[i]->Close();
     }
   }
   for (int i = static_cast<int>(database_paths_.size()) - 1; i >= 0; --i) {
@@ -270,6 +263,7 @@ void ShardReader::Close() {
       i_thread.join();
     }
   }
+  StopPrefetch();
 
   FileStreamsOperator();
 }
@@ -282,6 +276,19 @@ int ShardReader::GetShardCount() const { return shard_header_->GetShardCount();
 
 int ShardReader::GetNumRows() const { return num_rows_; }
 
+double ShardReader::GetPageCacheHitRate() const { return page_cache_ == nullptr ? 0 : page_cache_->GetHitRate(); }
+
+uint64_t ShardReader::GetBytesRead() const {
+  uint64_t bytes_read = 0;
+  for (const auto &io_engine : io_engines_) {
+    bytes_read += io_engine->GetBytesRead();
+  }
+  if (prefetch_engine_ != nullptr) {
+    bytes_read += prefetch_engine_->GetBytesRead();
+  }
+  return bytes_read;
+}
+
 std::vector<std::tuple<int, int, int, uint64_t>> ShardReader::ReadRowGroupSummary() {
   std::vector<std::tuple<int, int, int, uint64_t>> row_group_summary;
   int shard_count = shard_header_->GetShardCount();
@@ -1045,6 +1052,7 @@ MSRStatus ShardReader::Launch(bool isSimpleReader) {
     interrupt_ = true;
     return FAILED;
   }
+  InitPageCache();
   if (isSimpleReader) return SUCCESS;
   // Start provider consumer threads
   thread_set_ = std::vector<std::thread>(n_consumer_);
@@ -1280,27 +1288,127 @@ MSRStatus ShardReader::CreateTasks(const std::vector<std::tuple<int, int, int, u
   return SUCCESS;
 }
 
-TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_id) {
+void ShardReader::InitPageCache() {
+  StopPrefetch();
+  page_cache_ = nullptr;
+  prefetch_engine_ = nullptr;
+  // the page of the sample is only known by the task in fast load mode
+  if (lazy_load_) {
+    return;
+  }
+  for (const auto &op : operators_) {
+    // the block shuffle is either built directly, or selected through the shuffle mode of the dataset sampler
+    auto shuffle_op = std::dynamic_pointer_cast<ShardShuffle>(op);
+    uint32_t window_pages = 0;
+    if (shuffle_op != nullptr && shuffle_op->GetShuffleType() == kShuffleBlock) {
+      window_pages = shuffle_op->GetWindowPages();
+    } else if (op->GetShuffleMode() == dataset::ShuffleMode::kBlock) {
+      window_pages = shuffle_op != nullptr ? shuffle_op->GetWindowPages() : kDefaultShuffleWindowPages;
+    }
+    if (window_pages > 0) {
+      auto capacity = static_cast<uint64_t>(kPageCacheWindows) * window_pages * page_size_;
+      page_cache_ = std::make_shared<ShardPageCache>(capacity);
+      MS_LOG(INFO) << "Read the blob pages by the page cache, capacity: " << capacity;
+      // the prefetch pages are read by their own engine, so the consumers go on with their current rows
+      auto prefetch_engine = std::make_shared<ShardIOEngine>(file_paths_);
+      if (prefetch_engine->Open() != SUCCESS) {
+        MS_LOG(WARNING) << "Failed to open the prefetch engine, the pages are loaded when they are read.";
+        return;
+      }
+      prefetch_engine_ = prefetch_engine;
+      prefetch_stopped_ = false;
+      prefetch_thread_ = std::thread(&ShardReader::PrefetchPages, this);
+      return;
+    }
+  }
+}
+
+void ShardReader::PrefetchPages() {
+#if !defined(_WIN32) && !defined(_WIN64) && !defined(__APPLE__)
+  prctl(PR_SET_NAME, common::SafeCStr(kPrefetchThreadName), 0, 0, 0);
+#endif
+  for (;;) {
+    std::vector<std::pair<ShardPageCache::PageKey, std::shared_ptr<Page>>> claimed;
+    {
+      std::unique_lock<std::mutex> lck(mtx_prefetch_);
+      cv_prefetch_.wait(lck, [this] { return prefetch_stopped_ || !prefetch_queue_.empty(); });
+      // the pages left in the queue are abandoned by StopPrefetch
+      if (prefetch_stopped_) {
+        return;
+      }
+      claimed.assign(prefetch_queue_.begin(), prefetch_queue_.end());
+      prefetch_queue_.clear();
+    }
+
+    // the pages queued by all the consumers are read together, the adjacent pages are read sequentially
+    std::vector<ShardPageCache::PageData> loaded;
+    std::vector<ShardReadRequest> page_requests;
+    for (const auto &item : claimed) {
+      loaded.push_back(std::make_shared<std::vector<uint8_t>>(item.second->GetPageSize()));
+      page_requests.push_back({item.first.first, header_size_ + page_size_ * item.first.second, loaded.back()->size(),
+                               loaded.back()->data()});
+    }
+    auto ret = prefetch_engine_->Read(page_requests);
+    for (size_t i = 0; i < claimed.size(); ++i) {
+      if (ret == SUCCESS) {
+        page_cache_->Fill(claimed[i].first, loaded[i]);
+      } else {
+        page_cache_->Abandon(claimed[i].first);
+      }
+    }
+  }
+}
+
+void ShardReader::StopPrefetch() {
+  {
+    std::lock_guard<std::mutex> lck(mtx_prefetch_);
+    prefetch_stopped_ = true;
+  }
+  cv_prefetch_.notify_all();
+  if (prefetch_thread_.joinable()) {
+    prefetch_thread_.join();
+  }
+  // the consumers waiting for the pages never loaded read their blobs directly
+  for (const auto &item : prefetch_queue_) {
+    page_cache_->Abandon(item.first);
+  }
+  prefetch_queue_.clear();
+  if (prefetch_engine_ != nullptr) {
+    prefetch_engine_->Close();
+  }
+}
+
+std::shared_ptr<Page> ShardReader::GetPageOfTask(int task_id) {
+  if (lazy_load_ || task_id >= static_cast<int>(tasks_.Size())) {
+    return nullptr;
+  }
+  auto &task = tasks_.GetTaskByID(task_id);
+  if (std::get<0>(task) == TaskType::kPaddedTask) {
+    return nullptr;
+  }
+  const auto &ret = shard_header_->GetPageByGroupId(std::get<1>(std::get<1>(task)), std::get<0>(std::get<1>(task)));
+  return ret.first == SUCCESS ? ret.second : nullptr;
+}
+
+MSRStatus ShardReader::GetBlobOfTask(int task_id, TaskType *task_type, ShardReadRequest *request, json *var_fields,
+                                     std::shared_ptr<Page> *blob_page) {
   // All tasks are done
   if (task_id >= static_cast<int>(tasks_.Size())) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return FAILED;
   }
 
   uint32_t shard_id = 0;
   uint32_t group_id = 0;
   uint32_t blob_start = 0;
   uint32_t blob_end = 0;
-  json var_fields;
   // Pick up task from task list
   ShardTask task;
   task = tasks_.GetTaskByID(task_id);
 
   // check task type
-  auto task_type = std::get<0>(task);
-  if (task_type == TaskType::kPaddedTask) {
-    return std::make_pair(SUCCESS,
-                          std::make_pair(TaskType::kPaddedTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  *task_type = std::get<0>(task);
+  if (*task_type == TaskType::kPaddedTask) {
+    return SUCCESS;
   }
 
   shard_id = std::get<0>(std::get<1>(task));  // shard id
@@ -1309,7 +1417,7 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
     group_id = std::get<1>(std::get<1>(task));  // group id
     blob_start = std::get<2>(task)[0];          // blob start
     blob_end = std::get<2>(task)[1];            // blob end
-    var_fields = std::get<3>(task);             // scalar variable field
+    *var_fields = std::get<3>(task);            // scalar variable field
   } else {
     // get scalar variable fields by sample id
     uint32_t sample_id_in_shard = std::get<1>(std::get<1>(task));
@@ -1317,52 +1425,183 @@ TASK_RETURN_CONTENT ShardReader::ConsumerOneTask(int task_id, uint32_t consumer_
     // read the meta from index
     auto row_meta = ReadRowGroupByShardIDAndSampleID(selected_columns_, shard_id, sample_id_in_shard);
     if (std::get<0>(row_meta) != SUCCESS) {
-      return std::make_pair(
-        FAILED, std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+      return FAILED;
     }
     auto &offsets = std::get<1>(row_meta);
     auto &local_columns = std::get<2>(row_meta);
 
-    group_id = offsets[shard_id][0][1];       // group_id
-    blob_start = offsets[shard_id][0][2];     // blob start
-    blob_end = offsets[shard_id][0][3];       // blob end
-    var_fields = local_columns[shard_id][0];  // scalar variable field
+    group_id = offsets[shard_id][0][1];        // group_id
+    blob_start = offsets[shard_id][0][2];      // blob start
+    blob_end = offsets[shard_id][0][3];        // blob end
+    *var_fields = local_columns[shard_id][0];  // scalar variable field
   }
 
-  // read the blob from data file
+  // locate the blob in data file
   const auto &ret = shard_header_->GetPageByGroupId(group_id, shard_id);
   if (SUCCESS != ret.first) {
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+    return FAILED;
   }
   const std::shared_ptr<Page> &page = ret.second;
+  request->shard_id = shard_id;
+  request->offset = header_size_ + page_size_ * (page->GetPageID()) + blob_start;
+  request->size = blob_end - blob_start;
+  if (blob_page != nullptr) {
+    *blob_page = page;
+  }
+  return SUCCESS;
+}
+
+MSRStatus ShardReader::ReadBlobsByPage(const std::vector<ShardReadRequest> &requests,
+                                       const std::vector<std::shared_ptr<Page>> &pages,
+                                       const std::vector<std::shared_ptr<Page>> &prefetch_pages, uint32_t consumer_id) {
+  std::map<ShardPageCache::PageKey, ShardPageCache::PageData> cached;
+  std::map<ShardPageCache::PageKey, std::shared_ptr<Page>> claimed;
+  std::map<ShardPageCache::PageKey, std::shared_ptr<Page>> prefetch_claimed;
+  std::set<ShardPageCache::PageKey> loading;
+  auto lookup = [this, &cached, &claimed, &prefetch_claimed, &loading](const std::shared_ptr<Page> &page,
+                                                                       bool prefetch) {
+    ShardPageCache::PageKey key(page->GetShardID(), page->GetPageID());
+    if (cached.count(key) > 0 || claimed.count(key) > 0 || prefetch_claimed.count(key) > 0) {
+      return;
+    }
+    ShardPageCache::PageData data;
+    if (page_cache_->TryGet(key, &data)) {
+      (prefetch ? prefetch_claimed : claimed)[key] = page;
+    } else if (data != nullptr) {
+      cached[key] = data;
+    } else if (!prefetch) {
+      (void)loading.insert(key);
+    }
+  };
+  for (const auto &page : pages) {
+    lookup(page, false);
+  }
+  if (prefetch_engine_ != nullptr) {
+    for (const auto &page : prefetch_pages) {
+      lookup(page, true);
+    }
+  }
 
-  // Pack image list
-  std::vector<uint8_t> images(blob_end - blob_start);
-  auto file_offset = header_size_ + page_size_ * (page->GetPageID()) + blob_start;
+  // the prefetch pages are loaded by the prefetch thread while the current pages are read below
+  if (!prefetch_claimed.empty()) {
+    {
+      std::lock_guard<std::mutex> lck(mtx_prefetch_);
+      for (const auto &item : prefetch_claimed) {
+        if (prefetch_stopped_) {
+          page_cache_->Abandon(item.first);
+        } else {
+          prefetch_queue_.emplace_back(item);
+        }
+      }
+    }
+    cv_prefetch_.notify_one();
+  }
 
-  auto &io_seekg = file_streams_random_[consumer_id][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  // load the whole missing pages together, the adjacent pages are read sequentially by the io engine
+  if (!claimed.empty()) {
+    std::vector<ShardReadRequest> page_requests;
+    for (const auto &item : claimed) {
+      auto data = std::make_shared<std::vector<uint8_t>>(item.second->GetPageSize());
+      cached[item.first] = data;
+      page_requests.push_back({item.first.first, header_size_ + page_size_ * item.first.second, data->size(),
+                               data->data()});
+    }
+    auto ret = io_engines_[consumer_id]->Read(page_requests);
+    for (const auto &item : claimed) {
+      if (ret == SUCCESS) {
+        page_cache_->Fill(item.first, cached[item.first]);
+      } else {
+        page_cache_->Abandon(item.first);
+      }
+    }
+    if (ret != SUCCESS) {
+      return FAILED;
+    }
+  }
+  // wait for the pages loaded by the other consumers after all the claimed pages are filled
+  for (const auto &key : loading) {
+    auto data = page_cache_->Wait(key);
+    if (data != nullptr) {
+      cached[key] = data;
+    }
   }
 
-  auto &io_read =
-    file_streams_random_[consumer_id][shard_id]->read(reinterpret_cast<char *>(&images[0]), blob_end - blob_start);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
-    MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[consumer_id][shard_id]->close();
-    return std::make_pair(FAILED,
-                          std::pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>()));
+  // copy the blobs out of the pages, the blobs whose page is evicted or failed are read directly.
+  // the first blob of each page loaded for this batch is a miss, the other blobs are hits.
+  std::vector<ShardReadRequest> direct_requests;
+  std::set<ShardPageCache::PageKey> missed;
+  uint64_t hit_count = 0;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const auto &request = requests[i];
+    ShardPageCache::PageKey key(pages[i]->GetShardID(), pages[i]->GetPageID());
+    auto iter = cached.find(key);
+    uint64_t blob_offset = request.offset - header_size_ - page_size_ * pages[i]->GetPageID();
+    if (iter == cached.end() || blob_offset + request.size > iter->second->size()) {
+      direct_requests.push_back(request);
+      continue;
+    }
+    if (claimed.count(key) == 0 || !missed.insert(key).second) {
+      ++hit_count;
+    }
+    std::copy(iter->second->begin() + blob_offset, iter->second->begin() + blob_offset + request.size,
+              request.buffer);
   }
+  page_cache_->AddLookups(hit_count, missed.size() + direct_requests.size());
+  return io_engines_[consumer_id]->Read(direct_requests);
+}
 
-  // Deliver batch data to output map
-  std::vector<std::tuple<std::vector<uint8_t>, json>> batch;
-  batch.emplace_back(std::move(images), std::move(var_fields));
+MSRStatus ShardReader::ConsumerTasks(
+  const std::vector<int> &task_ids, uint32_t consumer_id,
+  std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> *rows,
+  const std::vector<int> &prefetch_task_ids) {
+  if (consumer_id >= io_engines_.size()) {
+    MS_LOG(ERROR) << "Invalid consumer id: " << consumer_id;
+    return FAILED;
+  }
+  rows->clear();
+  rows->reserve(task_ids.size());
+  std::vector<ShardReadRequest> requests;
+  std::vector<std::shared_ptr<Page>> pages;
+  for (auto task_id : task_ids) {
+    TaskType task_type = TaskType::kCommonTask;
+    ShardReadRequest request{0, 0, 0, nullptr};
+    json var_fields;
+    std::shared_ptr<Page> page;
+    if (GetBlobOfTask(task_id, &task_type, &request, &var_fields, &page) != SUCCESS) {
+      return FAILED;
+    }
+    rows->emplace_back(task_type, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+    if (task_type == TaskType::kPaddedTask) {
+      continue;
+    }
+    // Pack image list, the buffer is filled by the io engine below
+    rows->back().second.emplace_back(std::vector<uint8_t>(request.size), std::move(var_fields));
+    request.buffer = std::get<0>(rows->back().second.back()).data();
+    requests.push_back(request);
+    pages.push_back(page);
+  }
+
+  if (page_cache_ != nullptr) {
+    std::vector<std::shared_ptr<Page>> prefetch_pages;
+    for (auto task_id : prefetch_task_ids) {
+      auto page = GetPageOfTask(task_id);
+      if (page != nullptr) {
+        prefetch_pages.push_back(page);
+      }
+    }
+    if (ReadBlobsByPage(requests, pages, prefetch_pages, consumer_id) != SUCCESS) {
+      MS_LOG(ERROR) << "File read failed";
+      return FAILED;
+    }
+    return SUCCESS;
+  }
 
-  return std::make_pair(SUCCESS, std::make_pair(TaskType::kCommonTask, std::move(batch)));
+  // read the blobs of all the rows from data file
+  if (io_engines_[consumer_id]->Read(requests) != SUCCESS) {
+    MS_LOG(ERROR) << "File read failed";
+    return FAILED;
+  }
+  return SUCCESS;
 }
 
 MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
@@ -1374,33 +1613,40 @@ MSRStatus ShardReader::ConsumerByRow(int consumer_id) {
 
   // Loop forever
   for (;;) {
-    int sample_id_pos = 0;
-
-    // Get next task ID
-    sample_id_pos = sample_id_position_++;
+    // Get next task IDs, the rows are read together so that the adjacent blobs are coalesced
+    int sample_id_pos = sample_id_position_.fetch_add(kNumRowsInRead);
 
     // All tasks are done
-    if (sample_id_pos >= static_cast<int>(tasks_.sample_ids_.size())) {
+    int sample_count = static_cast<int>(tasks_.sample_ids_.size());
+    if (sample_id_pos >= sample_count) {
       return FAILED;
     }
-    const auto &ret = ConsumerOneTask(tasks_.sample_ids_[sample_id_pos], consumer_id);
-    if (SUCCESS != ret.first) {
+    int sample_id_end = std::min(sample_id_pos + kNumRowsInRead, sample_count);
+    std::vector<int> task_ids(tasks_.sample_ids_.begin() + sample_id_pos, tasks_.sample_ids_.begin() + sample_id_end);
+    // the pages of the rows to be read by all the consumers next are prefetched into the page cache
+    std::vector<int> prefetch_task_ids;
+    if (page_cache_ != nullptr) {
+      int prefetch_end = std::min(sample_id_end + kNumRowsInRead * n_consumer_, sample_count);
+      prefetch_task_ids.assign(tasks_.sample_ids_.begin() + sample_id_end, tasks_.sample_ids_.begin() + prefetch_end);
+    }
+    std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> rows;
+    if (ConsumerTasks(task_ids, consumer_id, &rows, prefetch_task_ids) != SUCCESS) {
       return FAILED;
     }
-    const auto &batch = (ret.second).second;
-    // Hanging if maximum map size exceeded
-    //   otherwise, set batch data in map
-    {
-      std::unique_lock<std::mutex> lck(mtx_delivery_);
-      cv_delivery_.wait(lck,
-                        [sample_id_pos, this] { return interrupt_ || sample_id_pos <= deliver_id_ + kNumBatchInMap; });
-      if (interrupt_) {
-        return SUCCESS;
+    for (int pos = sample_id_pos; pos < sample_id_end; ++pos) {
+      auto &batch = rows[pos - sample_id_pos].second;
+      // Hanging if maximum map size exceeded
+      //   otherwise, set batch data in map
+      {
+        std::unique_lock<std::mutex> lck(mtx_delivery_);
+        cv_delivery_.wait(lck, [pos, this] { return interrupt_ || pos <= deliver_id_ + kNumBatchInMap; });
+        if (interrupt_) {
+          return SUCCESS;
+        }
+        delivery_map_[pos] = std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
       }
-      delivery_map_[sample_id_pos] =
-        std::make_shared<std::vector<std::tuple<std::vector<uint8_t>, json>>>(std::move(batch));
+      cv_iterator_.notify_one();
     }
-    cv_iterator_.notify_one();
   }
 }
 
@@ -1430,14 +1676,39 @@ std::vector<std::tuple<std::vector<uint8_t>, json>> ShardReader::GetNext() {
 
 std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>> ShardReader::GetNextById(
   const int64_t &task_id, const int32_t &consumer_id) {
-  if (interrupt_) {
+  auto rows = GetNextByIds({task_id}, consumer_id);
+  if (rows.empty()) {
     return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
   }
-  const auto &ret = ConsumerOneTask(task_id, consumer_id);
-  if (SUCCESS != ret.first) {
-    return std::make_pair(TaskType::kCommonTask, std::vector<std::tuple<std::vector<uint8_t>, json>>());
+  return std::move(rows[0]);
+}
+
+std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> ShardReader::GetNextByIds(
+  const std::vector<int64_t> &task_ids, const int32_t &consumer_id) {
+  std::vector<std::pair<TaskType, std::vector<std::tuple<std::vector<uint8_t>, json>>>> rows;
+  if (interrupt_) {
+    return rows;
+  }
+  std::vector<int> ids;
+  ids.reserve(task_ids.size());
+  for (auto task_id : task_ids) {
+    if (task_id < 0 || task_id >= static_cast<int64_t>(tasks_.Size())) {
+      break;
+    }
+    ids.push_back(static_cast<int>(task_id));
+  }
+  // the pages of the rows which follow are prefetched for the next batches of all the consumers
+  std::vector<int> prefetch_task_ids;
+  if (page_cache_ != nullptr && !ids.empty()) {
+    int prefetch_end = std::min(ids.back() + 1 + kNumRowsInRead * n_consumer_, static_cast<int>(tasks_.Size()));
+    for (int task_id = ids.back() + 1; task_id < prefetch_end; ++task_id) {
+      prefetch_task_ids.push_back(task_id);
+    }
+  }
+  if (ConsumerTasks(ids, consumer_id, &rows, prefetch_task_ids) != SUCCESS) {
+    rows.clear();
   }
-  return std::move(ret.second);
+  return rows;
 }
 
 std::pair<MSRStatus, std::vector<std::vector<uint8_t>>> ShardReader::UnCompressBlob(
@@ -215,17 +215,9 @@ std::pair<MSRStatus, std::vector<uint8_t>> ShardSegment::PackImages(int group_id
   // Pack image list
   std::vector<uint8_t> images(offset[1] - offset[0]);
   auto file_offset = header_size_ + page_size_ * (blob_page->GetPageID()) + offset[0];
-  auto &io_seekg = file_streams_random_[0][shard_id]->seekg(file_offset, std::ios::beg);
-  if (!io_seekg.good() || io_seekg.fail() || io_seekg.bad()) {
-    MS_LOG(ERROR) << "File seekg failed";
-    file_streams_random_[0][shard_id]->close();
-    return {FAILED, {}};
-  }
-
-  auto &io_read = file_streams_random_[0][shard_id]->read(reinterpret_cast<char *>(&images[0]), offset[1] - offset[0]);
-  if (!io_read.good() || io_read.fail() || io_read.bad()) {
+  ShardReadRequest request{static_cast<uint32_t>(shard_id), file_offset, offset[1] - offset[0], images.data()};
+  if (io_engines_.empty() || io_engines_[0]->Read({request}) != SUCCESS) {
     MS_LOG(ERROR) << "File read failed";
-    file_streams_random_[0][shard_id]->close();
     return {FAILED, {}};
   }
 
@@ -17,6 +17,8 @@
 #include "minddata/mindrecord/include/shard_shuffle.h"
 
 #include <algorithm>
+#include <map>
+#include <tuple>
 
 namespace mindspore {
 namespace mindrecord {
@@ -25,7 +27,8 @@ ShardShuffle::ShardShuffle(uint32_t seed, ShuffleType shuffle_type)
       no_of_samples_(0),
       replacement_(false),
       reshuffle_each_epoch_(true),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      window_pages_(kDefaultShuffleWindowPages) {}
 
 ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacement, bool reshuffle_each_epoch,
                            ShuffleType shuffle_type)
@@ -33,7 +36,16 @@ ShardShuffle::ShardShuffle(uint32_t seed, int64_t no_of_samples, bool replacemen
       no_of_samples_(no_of_samples),
       replacement_(replacement),
       reshuffle_each_epoch_(reshuffle_each_epoch),
-      shuffle_type_(shuffle_type) {}
+      shuffle_type_(shuffle_type),
+      window_pages_(kDefaultShuffleWindowPages) {}
+
+ShardShuffle::ShardShuffle(uint32_t seed, ShuffleType shuffle_type, uint32_t window_pages, bool reshuffle_each_epoch)
+    : shuffle_seed_(seed),
+      no_of_samples_(0),
+      replacement_(false),
+      reshuffle_each_epoch_(reshuffle_each_epoch),
+      shuffle_type_(shuffle_type),
+      window_pages_(window_pages) {}
 
 int64_t ShardShuffle::GetNumSamples(int64_t dataset_size, int64_t num_classes) {
   if (replacement_) {
@@ -157,6 +169,55 @@ MSRStatus ShardShuffle::ShuffleInfile(ShardTaskList &tasks) {
   ShardTaskList::TaskListSwap(tasks, new_tasks);
 }
 
+MSRStatus ShardShuffle::ShuffleBlock(ShardTaskList &tasks) {
+  if (window_pages_ == 0) {
+    MS_LOG(ERROR) << "window_pages need to be positive.";
+    return FAILED;
+  }
+  // group the samples by the page where their blobs are located
+  // -- before --
+  // page1: [0, 1, 2], page2: [3, 4, 5], page3: [6, 7], page4: [8, 9]
+  // -- after, window_pages is 2 --
+  // pages: [page3, page1, page4, page2]
+  // permutation: [1, 7, 0, 6, 2, 9, 4, 3, 8, 5]
+  std::map<std::tuple<int, int, int>, size_t> page_index;
+  std::vector<std::vector<int>> pages;
+  for (size_t i = 0; i < tasks.sample_ids_.size(); ++i) {
+    auto &task = tasks.GetTaskByID(tasks.sample_ids_[i]);
+    // the padded samples and the lazy load samples whose page is unknown are grouped by themselves
+    auto key = std::make_tuple(static_cast<int>(std::get<0>(task)), std::get<0>(std::get<1>(task)),
+                               std::get<2>(task).empty() ? -static_cast<int>(i) - 1 : std::get<1>(std::get<1>(task)));
+    auto iter = page_index.find(key);
+    if (iter == page_index.end()) {
+      iter = page_index.emplace(key, pages.size()).first;
+      pages.emplace_back();
+    }
+    pages[iter->second].push_back(static_cast<int>(i));
+  }
+
+  std::default_random_engine engine(shuffle_seed_);
+  std::shuffle(pages.begin(), pages.end(), engine);
+  tasks.permutation_.clear();
+  for (size_t window_start = 0; window_start < pages.size(); window_start += window_pages_) {
+    auto window_end = std::min(pages.size(), window_start + window_pages_);
+    auto perm_start = tasks.permutation_.size();
+    for (size_t page = window_start; page < window_end; ++page) {
+      tasks.permutation_.insert(tasks.permutation_.end(), pages[page].begin(), pages[page].end());
+    }
+    std::shuffle(tasks.permutation_.begin() + perm_start, tasks.permutation_.end(), engine);
+  }
+
+  auto total_no = static_cast<int64_t>(tasks.Size());
+  ShardTaskList new_tasks;
+  size_t samples_to_assign =
+    (no_of_samples_ > 0 && no_of_samples_ < total_no) ? no_of_samples_ : tasks.sample_ids_.size();
+  for (size_t i = 0; i < samples_to_assign; ++i) {
+    new_tasks.AssignTask(tasks, tasks.permutation_[i]);
+  }
+  ShardTaskList::TaskListSwap(tasks, new_tasks);
+  return SUCCESS;
+}
+
 MSRStatus ShardShuffle::Execute(ShardTaskList &tasks) {
   if (reshuffle_each_epoch_) shuffle_seed_++;
   if (tasks.categories < 1) {
@@ -200,7 +261,11 @@ MSRStatus ShardShuffle::Execute(ShardTaskList &tasks) {
       if (ret != SUCCESS) {
         return ret;
       }
+    } else if (GetShuffleMode() == dataset::ShuffleMode::kBlock) {
+      return ShuffleBlock(tasks);
     }
+  } else if (shuffle_type_ == kShuffleBlock) {  // shuffle pages, then samples within a window of pages
+    return ShuffleBlock(tasks);
   } else {  // shuffle unit like: (a1, b1, c1),(a2, b2, c2),..., (an, bn, cn)
     return this->CategoryShuffle(tasks);
   }
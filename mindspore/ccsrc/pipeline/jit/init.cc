@@ -361,6 +361,16 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set federated learning client learning rate.")
     .def("set_scheduler_manage_port", &PSContext::set_scheduler_manage_port,
          "Set scheduler manage port used to scale out/in.")
+    .def("set_gradient_compression", &PSContext::set_gradient_compression,
+         "Set how workers compress the gradients pushed and the weights pulled.")
+    .def("gradient_compression", &PSContext::gradient_compression,
+         "Get how workers compress the gradients pushed and the weights pulled.")
+    .def("set_gradient_topk_ratio", &PSContext::set_gradient_topk_ratio,
+         "Set the ratio of the values sent by top-k gradient compression.")
+    .def("gradient_topk_ratio", &PSContext::gradient_topk_ratio,
+         "Get the ratio of the values sent by top-k gradient compression.")
+    .def("set_cache_prefetch_depth", &PSContext::set_cache_prefetch_depth,
+         "Set how many batches the embedding cache parses ahead of their swaps.")
     .def("set_enable_ssl", &PSContext::enable_ssl, "Set PS SSL mode enabled or disabled.");
 
   (void)py::class_<OpInfoLoaderPy, std::shared_ptr<OpInfoLoaderPy>>(m, "OpInfoLoaderPy")
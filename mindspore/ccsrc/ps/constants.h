@@ -87,6 +87,23 @@ constexpr int64_t kRetryIntervalInMs = 10;
 
 constexpr int64_t kThreadNum = 32;
 
+// The parameter server locks each key through one of kKeyLockStripes locks, and the rows of an embedding table by
+// ranges of kEmbeddingRowsPerLockRange rows spread over kEmbeddingLockStripes locks.
+constexpr size_t kKeyLockStripes = 256;
+constexpr size_t kEmbeddingLockStripes = 64;
+constexpr size_t kEmbeddingRowsPerLockRange = 256;
+
+// With gradient compression on, the dense gradients of at least kCompressMinSize floats are compressed. Top-k sends
+// kDefaultTopKRatio of the values unless the ratio is set.
+constexpr size_t kCompressMinSize = 1024;
+constexpr float kDefaultTopKRatio = 0.01f;
+
+// With the embedding cache on, the ids of up to kDefaultCachePrefetchDepth batches are parsed while their swaps are
+// pending, unless the depth is set. Depth 1 swaps each batch before the next one is parsed, and the depth is at most
+// kMaxCachePrefetchDepth since every pending batch holds its ids and the cache rows they use.
+constexpr size_t kDefaultCachePrefetchDepth = 2;
+constexpr size_t kMaxCachePrefetchDepth = 8;
+
 using DataPtr = std::shared_ptr<unsigned char[]>;
 using VectorPtr = std::shared_ptr<std::vector<unsigned char>>;
 using Key = uint64_t;
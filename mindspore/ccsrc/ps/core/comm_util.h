@@ -66,6 +66,8 @@ constexpr int kGroup5RandomLength = 12;
 
 // The size of the buffer for sending and receiving data is 4096 bytes.
 constexpr int kMessageChunkLength = 4096;
+// The most bytes a buffer event moves from or to its socket at once, libevent moves 16KB by default.
+constexpr int kMaxSingleIOLength = 1 << 20;
 // The timeout period for the http client to connect to the http server is 120 seconds.
 constexpr int kConnectionTimeout = 120;
 constexpr char kLibeventLogPrefix[] = "[libevent log]:";
@@ -0,0 +1,71 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/core/communicator/message_buffer.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+MessageBufferPool &MessageBufferPool::GetInstance() {
+  static MessageBufferPool *instance = new MessageBufferPool();
+  return *instance;
+}
+
+DataPtr MessageBufferPool::Allocate(size_t size) {
+  if (size > (static_cast<size_t>(1) << kMaxPooledBufferShift)) {
+    return DataPtr(new unsigned char[size]);
+  }
+  size_t shift = kMinPooledBufferShift;
+  while ((static_cast<size_t>(1) << shift) < size) {
+    shift++;
+  }
+  size_t size_class = shift - kMinPooledBufferShift;
+  unsigned char *buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto &free_buffers = free_buffers_[size_class];
+    if (!free_buffers.empty()) {
+      buffer = free_buffers.back();
+      free_buffers.pop_back();
+      pooled_bytes_ -= static_cast<size_t>(1) << shift;
+    }
+  }
+  if (buffer == nullptr) {
+    buffer = new unsigned char[static_cast<size_t>(1) << shift];
+  }
+  return DataPtr(buffer, [this, size_class](unsigned char *data) { Release(size_class, data); });
+}
+
+void MessageBufferPool::Release(size_t size_class, unsigned char *buffer) {
+  size_t size = static_cast<size_t>(1) << (size_class + kMinPooledBufferShift);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (pooled_bytes_ + size <= kMaxPooledBytes) {
+      free_buffers_[size_class].push_back(buffer);
+      pooled_bytes_ += size;
+      return;
+    }
+  }
+  delete[] buffer;
+}
+
+size_t MessageBufferPool::pooled_bytes() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return pooled_bytes_;
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_MESSAGE_BUFFER_H_
+#define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_MESSAGE_BUFFER_H_
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+// The smallest and the largest buffers kept by the pool are 4KB and 64MB, with a size class for each power of two.
+// At most kMaxPooledBytes are kept, the rest goes back to the heap.
+constexpr size_t kMinPooledBufferShift = 12;
+constexpr size_t kMaxPooledBufferShift = 26;
+constexpr size_t kMaxPooledBytes = static_cast<size_t>(256) << 20;
+
+// Buffers for the messages received, reused from one message to the next. A buffer returns to the pool when the last
+// DataPtr to it is released, so the receiver can hand it to the request handlers without a copy.
+class MessageBufferPool {
+ public:
+  // The pool is never destroyed, as buffers may still be released when the process exits.
+  static MessageBufferPool &GetInstance();
+
+  // Get a buffer of at least size bytes.
+  DataPtr Allocate(size_t size);
+
+  // Bytes kept by the pool for reuse.
+  size_t pooled_bytes();
+
+ private:
+  MessageBufferPool() : free_buffers_(kMaxPooledBufferShift - kMinPooledBufferShift + 1), pooled_bytes_(0) {}
+  ~MessageBufferPool() = default;
+  MessageBufferPool(const MessageBufferPool &) = delete;
+  MessageBufferPool &operator=(const MessageBufferPool &) = delete;
+
+  void Release(size_t size_class, unsigned char *buffer);
+
+  std::mutex mutex_;
+  std::vector<std::vector<unsigned char *>> free_buffers_;
+  size_t pooled_bytes_;
+};
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_MESSAGE_BUFFER_H_
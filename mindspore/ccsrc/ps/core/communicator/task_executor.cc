@@ -22,7 +22,6 @@ namespace core {
 TaskExecutor::TaskExecutor(size_t thread_num, size_t max_task_num, size_t submit_timeout)
     : running_(true),
       thread_num_(thread_num),
-      idle_thread_num_(0),
       submit_timeout_(submit_timeout),
       max_task_num_(max_task_num),
       task_num_(0) {
@@ -30,47 +29,44 @@ TaskExecutor::TaskExecutor(size_t thread_num, size_t max_task_num, size_t submit
     working_threads_.emplace_back([this]() {
       std::function<void()> task;
       while (true) {
-        std::unique_lock<std::mutex> lock(mtx_);
-        // Idle thread number increases when the mtx_ is locked.
-        idle_thread_num_++;
-
-        if (!running_) {
-          // To avoid thread from blocking after destructor.
-          return;
-        }
-
-        cv_.wait(lock);
-
-        if (!running_ || task_queue_.empty()) {
-          return;
-        }
-
-        task = task_queue_.front();
-        task_queue_.pop();
-        if (lock.owns_lock()) {
-          lock.unlock();
+        {
+          // A submitted task wakes up one idle thread, so tasks start as soon as there is a thread for them.
+          std::unique_lock<std::mutex> lock(mtx_);
+          cv_.wait(lock, [this] { return !running_ || !task_queue_.empty(); });
+          if (!running_) {
+            return;
+          }
+          task = std::move(task_queue_.front());
+          task_queue_.pop();
+          task_num_--;
         }
-
         task();
       }
     });
   }
-  notify_thread_ = std::thread([this]() {
-    // If there is no idle thread, wait until the working thread is available.
-    while (true) {
-      {
-        std::unique_lock<std::mutex> lock(mtx_);
-        if (idle_thread_num_ > 0 && task_num_ > 0) {
-          idle_thread_num_--;
-          task_num_--;
-          lock.unlock();
-          cv_.notify_one();
-        }
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(kSubmitTaskIntervalInMs));
+}
+
+bool TaskExecutor::Run(const std::vector<std::function<void()>> &tasks) {
+  std::mutex done_mtx;
+  std::condition_variable done_cv;
+  size_t done_num = 0;
+  size_t submitted_num = 0;
+  for (const auto &task : tasks) {
+    bool submitted = Submit([&task, &done_mtx, &done_cv, &done_num]() {
+      task();
+      // Notify with the lock held, the waiter returns and destroys the condition variable once it sees the count.
+      std::unique_lock<std::mutex> lock(done_mtx);
+      done_num++;
+      done_cv.notify_one();
+    });
+    if (!submitted) {
+      break;
     }
-  });
-  notify_thread_.detach();
+    submitted_num++;
+  }
+  std::unique_lock<std::mutex> lock(done_mtx);
+  done_cv.wait(lock, [&done_num, submitted_num] { return done_num == submitted_num; });
+  return submitted_num == tasks.size();
 }
 
 TaskExecutor::~TaskExecutor() {
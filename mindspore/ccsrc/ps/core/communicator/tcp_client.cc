@@ -135,6 +135,10 @@ void TcpClient::Init() {
   MS_EXCEPTION_IF_NULL(buffer_event_);
 
   bufferevent_setcb(buffer_event_, ReadCallback, nullptr, EventCallback, this);
+  if (bufferevent_set_max_single_read(buffer_event_, kMaxSingleIOLength) == -1 ||
+      bufferevent_set_max_single_write(buffer_event_, kMaxSingleIOLength) == -1) {
+    MS_LOG(WARNING) << "Buffer event set the max single read and write failed!";
+  }
   if (bufferevent_enable(buffer_event_, EV_READ | EV_WRITE) == -1) {
     MS_LOG(EXCEPTION) << "Buffer event enable read and write failed!";
   }
@@ -190,6 +194,10 @@ void TcpClient::ReadCallback(struct bufferevent *bev, void *ctx) {
   MS_EXCEPTION_IF_NULL(bev);
   MS_EXCEPTION_IF_NULL(ctx);
   auto tcp_client = reinterpret_cast<TcpClient *>(ctx);
+  if (!tcp_client->read_callback_) {
+    tcp_client->OnReadHandler(bufferevent_get_input(bev));
+    return;
+  }
 
   char read_buffer[kMessageChunkLength];
   int read = 0;
@@ -207,6 +215,11 @@ void TcpClient::OnReadHandler(const void *buf, size_t num) {
   message_handler_.ReceiveMessage(buf, num);
 }
 
+void TcpClient::OnReadHandler(struct evbuffer *buf) {
+  MS_EXCEPTION_IF_NULL(buf);
+  message_handler_.ReceiveMessage(buf);
+}
+
 void TcpClient::TimerCallback(evutil_socket_t, int16_t, void *arg) {
   MS_EXCEPTION_IF_NULL(arg);
   auto tcp_client = reinterpret_cast<TcpClient *>(arg);
@@ -301,29 +314,23 @@ bool TcpClient::SendMessage(const CommMessage &message) const {
 }
 
 bool TcpClient::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) {
-  MS_EXCEPTION_IF_NULL(buffer_event_);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
-  bufferevent_lock(buffer_event_);
-  bool res = true;
+  return WriteMessage(*meta, protos, data, size, nullptr);
+}
 
-  MessageHeader header;
-  header.message_proto_ = protos;
-  header.message_meta_length_ = SizeToUint(meta->ByteSizeLong());
-  header.message_length_ = size + header.message_meta_length_;
+bool TcpClient::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data,
+                            size_t size) {
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  return WriteMessage(*meta, protos, data.get(), size, data);
+}
 
-  if (bufferevent_write(buffer_event_, &header, sizeof(header)) == -1) {
-    MS_LOG(ERROR) << "Event buffer add header failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, meta->SerializeAsString().data(), meta->ByteSizeLong()) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, data, size) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
+bool TcpClient::WriteMessage(const MessageMeta &meta, const Protos &protos, const void *data, size_t size,
+                             const std::shared_ptr<const void> &owner) {
+  MS_EXCEPTION_IF_NULL(buffer_event_);
+  bufferevent_lock(buffer_event_);
+  bool res = TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), meta, protos, data, size, owner);
   int result = bufferevent_flush(buffer_event_, EV_READ | EV_WRITE, BEV_FLUSH);
   if (result < 0) {
     MS_LOG(ERROR) << "Bufferevent flush failed!";
@@ -67,6 +67,8 @@ class TcpClient {
   void SetMessageCallback(const OnMessage &cb);
   bool SendMessage(const CommMessage &message) const;
   bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size);
+  // The data is sent from where it is, it is held until it is written to the socket.
+  bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const DataPtr &data, size_t size);
   void StartTimer(const uint32_t &time);
   void set_timer_callback(const OnTimer &timer);
   const event_base &eventbase();
@@ -77,10 +79,14 @@ class TcpClient {
   static void ReadCallback(struct bufferevent *bev, void *ctx);
   static void EventCallback(struct bufferevent *bev, std::int16_t events, void *ptr);
   virtual void OnReadHandler(const void *buf, size_t num);
+  virtual void OnReadHandler(struct evbuffer *buf);
   static void TimerCallback(evutil_socket_t fd, int16_t event, void *arg);
   void NotifyConnected();
 
  private:
+  bool WriteMessage(const MessageMeta &meta, const Protos &protos, const void *data, size_t size,
+                    const std::shared_ptr<const void> &owner);
+
   OnMessage message_callback_;
   TcpMessageHandler message_handler_;
 
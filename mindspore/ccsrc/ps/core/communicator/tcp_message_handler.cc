@@ -20,11 +20,15 @@
 #include <iostream>
 #include <utility>
 
+#include "utils/convert_utils_base.h"
+
 namespace mindspore {
 namespace ps {
 namespace core {
 void TcpMessageHandler::SetCallback(const messageReceive &message_receive) { message_callback_ = message_receive; }
 
+void TcpMessageHandler::SetBufferCallback(const bufferReceive &buffer_receive) { buffer_callback_ = buffer_receive; }
+
 void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
   MS_EXCEPTION_IF_NULL(buffer);
   auto buffer_data = reinterpret_cast<const unsigned char *>(buffer);
@@ -35,13 +39,7 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
         header_[++header_index_] = *(buffer_data + i);
         --num;
         if (header_index_ == kHeaderLen - 1) {
-          message_header_.message_proto_ = *reinterpret_cast<const Protos *>(header_);
-          message_header_.message_meta_length_ =
-            *reinterpret_cast<const uint32_t *>(header_ + sizeof(message_header_.message_proto_));
-          message_header_.message_length_ = *reinterpret_cast<const size_t *>(
-            header_ + sizeof(message_header_.message_proto_) + sizeof(message_header_.message_meta_length_));
-          remaining_length_ = message_header_.message_length_;
-          message_buffer_.reset(new unsigned char[remaining_length_]);
+          ParseHeader();
           buffer_data += (i + 1);
           break;
         }
@@ -63,21 +61,124 @@ void TcpMessageHandler::ReceiveMessage(const void *buffer, size_t num) {
       }
 
       if (remaining_length_ == 0) {
-        if (message_callback_) {
-          std::shared_ptr<MessageMeta> pb_message = std::make_shared<MessageMeta>();
-          pb_message->ParseFromArray(message_buffer_.get(), message_header_.message_meta_length_);
-          message_callback_(pb_message, message_header_.message_proto_,
-                            message_buffer_.get() + message_header_.message_meta_length_,
-                            message_header_.message_length_ - message_header_.message_meta_length_);
-        }
-        message_buffer_.reset();
-        message_buffer_ = nullptr;
-        header_index_ = -1;
-        last_copy_len_ = 0;
+        FinishMessage();
       }
     }
   }
 }
+
+void TcpMessageHandler::ReceiveMessage(struct evbuffer *buffer) {
+  MS_EXCEPTION_IF_NULL(buffer);
+  while (true) {
+    if (remaining_length_ == 0) {
+      if (evbuffer_get_length(buffer) < kHeaderLen) {
+        return;
+      }
+      if (evbuffer_remove(buffer, header_, kHeaderLen) != kHeaderLen) {
+        MS_LOG(EXCEPTION) << "Can not drain the message header from the event buffer!";
+      }
+      ParseHeader();
+    }
+
+    size_t available = evbuffer_get_length(buffer);
+    if (available == 0) {
+      return;
+    }
+    size_t copy_len = remaining_length_ <= available ? remaining_length_ : available;
+    if (evbuffer_remove(buffer, message_buffer_.get() + last_copy_len_, copy_len) != SizeToInt(copy_len)) {
+      MS_LOG(EXCEPTION) << "Can not drain the message data from the event buffer!";
+    }
+    last_copy_len_ += copy_len;
+    remaining_length_ -= copy_len;
+    if (remaining_length_ == 0) {
+      FinishMessage();
+    }
+  }
+}
+
+void TcpMessageHandler::ParseHeader() {
+  message_header_.message_proto_ = *reinterpret_cast<const Protos *>(header_);
+  message_header_.message_meta_length_ =
+    *reinterpret_cast<const uint32_t *>(header_ + sizeof(message_header_.message_proto_));
+  message_header_.message_length_ = *reinterpret_cast<const size_t *>(
+    header_ + sizeof(message_header_.message_proto_) + sizeof(message_header_.message_meta_length_));
+  if (message_header_.message_length_ < message_header_.message_meta_length_ ||
+      message_header_.message_length_ == 0) {
+    MS_LOG(EXCEPTION) << "The message length " << message_header_.message_length_ << " is smaller than its meta length "
+                      << message_header_.message_meta_length_;
+  }
+  remaining_length_ = message_header_.message_length_;
+  message_buffer_ = MessageBufferPool::GetInstance().Allocate(remaining_length_);
+}
+
+void TcpMessageHandler::FinishMessage() {
+  // The state is reset first, so the callbacks may keep the buffer
+  DataPtr message = std::move(message_buffer_);
+  message_buffer_ = nullptr;
+  header_index_ = -1;
+  last_copy_len_ = 0;
+  if (!buffer_callback_ && !message_callback_) {
+    return;
+  }
+  std::shared_ptr<MessageMeta> pb_message = std::make_shared<MessageMeta>();
+  pb_message->ParseFromArray(message.get(), message_header_.message_meta_length_);
+  size_t size = message_header_.message_length_ - message_header_.message_meta_length_;
+  if (buffer_callback_) {
+    // The data shares the ownership of the whole message buffer
+    buffer_callback_(pb_message, message_header_.message_proto_,
+                     DataPtr(message, message.get() + message_header_.message_meta_length_), size);
+  } else {
+    message_callback_(pb_message, message_header_.message_proto_,
+                      message.get() + message_header_.message_meta_length_, size);
+  }
+}
+
+bool TcpMessageHandler::WriteMessage(struct evbuffer *output, const MessageMeta &meta, const Protos &protos,
+                                     const void *data, size_t size, const std::shared_ptr<const void> &owner) {
+  MS_EXCEPTION_IF_NULL(output);
+  MessageHeader header;
+  header.message_proto_ = protos;
+  header.message_meta_length_ = SizeToUint(meta.ByteSizeLong());
+  header.message_length_ = size + header.message_meta_length_;
+
+  // The header and the meta are serialized in place
+  size_t head_size = sizeof(header) + header.message_meta_length_;
+  struct evbuffer_iovec vec;
+  if (evbuffer_reserve_space(output, head_size, &vec, 1) != 1) {
+    MS_LOG(ERROR) << "Event buffer reserve space for the header failed!";
+    return false;
+  }
+  auto head = reinterpret_cast<unsigned char *>(vec.iov_base);
+  if (memcpy_s(head, vec.iov_len, &header, sizeof(header)) != EOK ||
+      !meta.SerializeToArray(head + sizeof(header), SizeToInt(header.message_meta_length_))) {
+    MS_LOG(ERROR) << "Serialize the message header failed!";
+    return false;
+  }
+  vec.iov_len = head_size;
+  if (evbuffer_commit_space(output, &vec, 1) == -1) {
+    MS_LOG(ERROR) << "Event buffer add header failed!";
+    return false;
+  }
+  if (size == 0) {
+    return true;
+  }
+
+  MS_EXCEPTION_IF_NULL(data);
+  if (owner != nullptr && size >= kMinReferencedDataSize) {
+    // The output buffer holds the owner until the data is written to the socket
+    auto holder = new std::shared_ptr<const void>(owner);
+    auto release = [](const void *, size_t, void *extra) { delete static_cast<std::shared_ptr<const void> *>(extra); };
+    if (evbuffer_add_reference(output, data, size, release, holder) == -1) {
+      delete holder;
+      MS_LOG(ERROR) << "Event buffer add data reference failed!";
+      return false;
+    }
+  } else if (evbuffer_add(output, data, size) == -1) {
+    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
+    return false;
+  }
+  return true;
+}
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_TCP_MESSAGE_HANDLER_H_
 #define MINDSPORE_CCSRC_PS_CORE_COMMUNICATOR_TCP_MESSAGE_HANDLER_H_
 
+#include <event2/buffer.h>
+
 #include <functional>
 #include <iostream>
 #include <string>
@@ -24,7 +26,9 @@
 #include <vector>
 
 #include "utils/log_adapter.h"
+#include "ps/constants.h"
 #include "ps/core/communicator/message.h"
+#include "ps/core/communicator/message_buffer.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 
@@ -32,7 +36,11 @@ namespace mindspore {
 namespace ps {
 namespace core {
 using messageReceive = std::function<void(std::shared_ptr<MessageMeta>, const Protos &, const void *, size_t size)>;
+// Takes the data of a message in the buffer it was received in, which stays valid as long as data is held.
+using bufferReceive = std::function<void(std::shared_ptr<MessageMeta>, const Protos &, DataPtr data, size_t size)>;
 constexpr int kHeaderLen = 16;
+// Data below this size is copied into the output buffer, referencing it costs more than the copy.
+constexpr size_t kMinReferencedDataSize = 4096;
 
 class TcpMessageHandler {
  public:
@@ -41,12 +49,25 @@ class TcpMessageHandler {
   virtual ~TcpMessageHandler() = default;
 
   void SetCallback(const messageReceive &cb);
+  // When set, it is called instead of the message callback.
+  void SetBufferCallback(const bufferReceive &cb);
   void ReceiveMessage(const void *buffer, size_t num);
+  // Move the messages of an input buffer straight into their message buffers.
+  void ReceiveMessage(struct evbuffer *buffer);
+
+  // Append a message to an output buffer. The header and the meta are serialized into the output buffer. The data is
+  // referenced by the output buffer until it is sent when it has an owner and is large enough, and copied otherwise.
+  static bool WriteMessage(struct evbuffer *output, const MessageMeta &meta, const Protos &protos, const void *data,
+                           size_t size, const std::shared_ptr<const void> &owner = nullptr);
 
  private:
+  void ParseHeader();
+  void FinishMessage();
+
   messageReceive message_callback_;
+  bufferReceive buffer_callback_;
   bool is_parsed_;
-  std::unique_ptr<unsigned char> message_buffer_;
+  DataPtr message_buffer_;
   size_t remaining_length_;
   char header_[16]{0};
   int header_index_;
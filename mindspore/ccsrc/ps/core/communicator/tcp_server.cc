@@ -34,8 +34,14 @@ namespace ps {
 namespace core {
 void TcpConnection::InitConnection(const messageReceive &callback) { tcp_message_handler_.SetCallback(callback); }
 
+void TcpConnection::InitBufferConnection(const bufferReceive &callback) {
+  tcp_message_handler_.SetBufferCallback(callback);
+}
+
 void TcpConnection::OnReadHandler(const void *buffer, size_t num) { tcp_message_handler_.ReceiveMessage(buffer, num); }
 
+void TcpConnection::OnReadHandler(struct evbuffer *buffer) { tcp_message_handler_.ReceiveMessage(buffer); }
+
 void TcpConnection::SendMessage(const void *buffer, size_t num) const {
   if (bufferevent_write(buffer_event_, buffer, num) == -1) {
     MS_LOG(ERROR) << "Write message to buffer event failed!";
@@ -68,34 +74,28 @@ bool TcpConnection::SendMessage(std::shared_ptr<CommMessage> message) const {
 
 bool TcpConnection::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data,
                                 size_t size) const {
-  MS_EXCEPTION_IF_NULL(buffer_event_);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
-  bufferevent_lock(buffer_event_);
-  bool res = true;
-  MessageHeader header;
-  header.message_proto_ = protos;
-  header.message_meta_length_ = SizeToUint(meta->ByteSizeLong());
-  header.message_length_ = size + header.message_meta_length_;
+  return WriteMessage(*meta, protos, data, size, nullptr);
+}
 
-  if (bufferevent_write(buffer_event_, &header, sizeof(header)) == -1) {
-    MS_LOG(ERROR) << "Event buffer add header failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, meta->SerializeAsString().data(), meta->ByteSizeLong()) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
-  if (bufferevent_write(buffer_event_, data, size) == -1) {
-    MS_LOG(ERROR) << "Event buffer add protobuf data failed!";
-    res = false;
-  }
+bool TcpConnection::SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const VectorPtr &data) const {
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  return WriteMessage(*meta, protos, data->data(), data->size(), data);
+}
+
+bool TcpConnection::WriteMessage(const MessageMeta &meta, const Protos &protos, const void *data, size_t size,
+                                 const std::shared_ptr<const void> &owner) const {
+  MS_EXCEPTION_IF_NULL(buffer_event_);
+  bufferevent_lock(buffer_event_);
+  bool res = TcpMessageHandler::WriteMessage(bufferevent_get_output(buffer_event_), meta, protos, data, size, owner);
   int result = bufferevent_flush(buffer_event_, EV_READ | EV_WRITE, BEV_FLUSH);
   if (result < 0) {
     MS_LOG(EXCEPTION) << "Bufferevent flush failed!";
   }
   bufferevent_unlock(buffer_event_);
-  MS_LOG(DEBUG) << "SendMessage the request id is:" << meta->request_id() << " the current time is:"
+  MS_LOG(DEBUG) << "SendMessage the request id is:" << meta.request_id() << " the current time is:"
                 << std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now())
                      .time_since_epoch()
                      .count();
@@ -319,14 +319,23 @@ void TcpServer::ListenerCallback(struct evconnlistener *, evutil_socket_t fd, st
   MS_EXCEPTION_IF_NULL(conn);
   SetTcpNoDelay(fd);
   server->AddConnection(fd, conn);
-  conn->InitConnection([=](std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) {
+  conn->InitBufferConnection([=](std::shared_ptr<MessageMeta> meta, const Protos &protos, DataPtr data, size_t size) {
+    OnServerReceiveBuffer on_server_receive_buffer = server->GetServerReceiveBuffer();
+    if (on_server_receive_buffer) {
+      on_server_receive_buffer(conn, meta, protos, data, size);
+      return;
+    }
     OnServerReceiveMessage on_server_receive = server->GetServerReceive();
     if (on_server_receive) {
-      on_server_receive(conn, meta, protos, data, size);
+      on_server_receive(conn, meta, protos, data.get(), size);
     }
   });
   bufferevent_setcb(bev, TcpServer::ReadCallback, nullptr, TcpServer::EventCallback,
                     reinterpret_cast<void *>(conn.get()));
+  if (bufferevent_set_max_single_read(bev, kMaxSingleIOLength) == -1 ||
+      bufferevent_set_max_single_write(bev, kMaxSingleIOLength) == -1) {
+    MS_LOG(WARNING) << "Buffer event set the max single read and write failed!";
+  }
   if (bufferevent_enable(bev, EV_READ | EV_WRITE) == -1) {
     MS_LOG(EXCEPTION) << "Buffer event enable read and write failed!";
   }
@@ -346,6 +355,8 @@ std::shared_ptr<TcpConnection> TcpServer::onCreateConnection(struct bufferevent
 
 OnServerReceiveMessage TcpServer::GetServerReceive() const { return message_callback_; }
 
+OnServerReceiveBuffer TcpServer::GetServerReceiveBuffer() const { return buffer_callback_; }
+
 void TcpServer::SignalCallback(evutil_socket_t, std::int16_t, void *data) {
   auto server = reinterpret_cast<class TcpServer *>(data);
   MS_EXCEPTION_IF_NULL(server);
@@ -362,20 +373,8 @@ void TcpServer::ReadCallback(struct bufferevent *bev, void *connection) {
   MS_EXCEPTION_IF_NULL(connection);
 
   auto conn = static_cast<class TcpConnection *>(connection);
-  struct evbuffer *buf = bufferevent_get_input(bev);
-  char read_buffer[kMessageChunkLength];
-  while (EVBUFFER_LENGTH(buf) > 0) {
-    int read = evbuffer_remove(buf, &read_buffer, sizeof(read_buffer));
-    if (read == -1) {
-      MS_LOG(EXCEPTION) << "Can not drain data from the event buffer!";
-    }
-    conn->OnReadHandler(read_buffer, IntToSize(read));
-    MS_LOG(DEBUG) << "the current time is:"
-                  << std::chrono::time_point_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now())
-                       .time_since_epoch()
-                       .count()
-                  << " the read size is:" << read;
-  }
+  // The messages are moved from the input buffer into their own buffers, without a bounce through the stack
+  conn->OnReadHandler(bufferevent_get_input(bev));
 }
 
 void TcpServer::EventCallback(struct bufferevent *bev, std::int16_t events, void *data) {
@@ -448,6 +447,14 @@ bool TcpServer::SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr
   return conn->SendMessage(meta, protos, data, size);
 }
 
+bool TcpServer::SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                            const Protos &protos, const VectorPtr &data) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  return conn->SendMessage(meta, protos, data);
+}
+
 void TcpServer::SendMessage(std::shared_ptr<CommMessage> message) {
   MS_EXCEPTION_IF_NULL(message);
   std::lock_guard<std::mutex> lock(connection_mutex_);
@@ -466,6 +473,8 @@ int TcpServer::ConnectionNum() const { return connections_.size(); }
 const std::map<evutil_socket_t, std::shared_ptr<TcpConnection>> &TcpServer::Connections() const { return connections_; }
 
 void TcpServer::SetMessageCallback(const OnServerReceiveMessage &cb) { message_callback_ = cb; }
+
+void TcpServer::SetBufferCallback(const OnServerReceiveBuffer &cb) { buffer_callback_ = cb; }
 }  // namespace core
 }  // namespace ps
 }  // namespace mindspore
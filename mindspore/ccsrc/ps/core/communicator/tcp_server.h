@@ -57,15 +57,22 @@ class TcpConnection {
   using Callback = std::function<void(const std::shared_ptr<CommMessage>)>;
 
   virtual void InitConnection(const messageReceive &callback);
+  virtual void InitBufferConnection(const bufferReceive &callback);
   virtual void SendMessage(const void *buffer, size_t num) const;
   bool SendMessage(std::shared_ptr<CommMessage> message) const;
   bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const void *data, size_t size) const;
+  // The data is sent from where it is, it is held until it is written to the socket.
+  bool SendMessage(std::shared_ptr<MessageMeta> meta, const Protos &protos, const VectorPtr &data) const;
   virtual void OnReadHandler(const void *buffer, size_t numBytes);
+  virtual void OnReadHandler(struct evbuffer *buffer);
   const TcpServer *GetServer() const;
   const evutil_socket_t &GetFd() const;
   void set_callback(const Callback &callback);
 
  protected:
+  bool WriteMessage(const MessageMeta &meta, const Protos &protos, const void *data, size_t size,
+                    const std::shared_ptr<const void> &owner) const;
+
   struct bufferevent *buffer_event_;
   evutil_socket_t fd_;
   TcpServer *server_;
@@ -76,6 +83,8 @@ class TcpConnection {
 using OnServerReceiveMessage =
   std::function<void(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
                      const void *data, size_t size)>;
+using OnServerReceiveBuffer = std::function<void(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                                                 const Protos &protos, DataPtr data, size_t size)>;
 
 class TcpServer {
  public:
@@ -105,9 +114,14 @@ class TcpServer {
   std::shared_ptr<TcpConnection> GetConnectionByFd(const evutil_socket_t &fd);
   OnServerReceiveMessage GetServerReceive() const;
   void SetMessageCallback(const OnServerReceiveMessage &cb);
+  OnServerReceiveBuffer GetServerReceiveBuffer() const;
+  // The messages are handed over in their receive buffers. When set, the message callback is not called.
+  void SetBufferCallback(const OnServerReceiveBuffer &cb);
   bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<CommMessage> message);
   bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
                    const void *data, size_t sizee);
+  bool SendMessage(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
+                   const VectorPtr &data);
   void SendMessage(std::shared_ptr<CommMessage> message);
   uint16_t BoundPort() const;
   std::string BoundIp() const;
@@ -138,6 +152,7 @@ class TcpServer {
   OnAccepted client_accept_;
   std::mutex connection_mutex_;
   OnServerReceiveMessage message_callback_;
+  OnServerReceiveBuffer buffer_callback_;
   OnTimerOnce on_timer_once_callback_;
   OnTimer on_timer_callback_;
 };
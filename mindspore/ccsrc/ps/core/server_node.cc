@@ -51,25 +51,37 @@ void ServerNode::Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<M
   server_->SendMessage(conn, meta, Protos::RAW, data, size);
 }
 
+void ServerNode::Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                          const VectorPtr &data) {
+  MS_EXCEPTION_IF_NULL(conn);
+  MS_EXCEPTION_IF_NULL(meta);
+  MS_EXCEPTION_IF_NULL(data);
+  meta->set_role(node_info_.node_role_);
+  meta->set_rank_id(node_info_.rank_id_);
+  MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
+                << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << meta->request_id();
+  server_->SendMessage(conn, meta, Protos::RAW, data);
+}
+
 void ServerNode::CreateTcpServer() {
   std::string interface;
   std::string server_ip;
   CommUtil::GetAvailableInterfaceAndIP(&interface, &server_ip);
   server_ = std::make_shared<TcpServer>(server_ip, 0);
-  server_->SetMessageCallback([&](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
-                                  const Protos &protos, const void *data, size_t size) {
+  server_->SetBufferCallback([&](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                                 const Protos &protos, DataPtr data, size_t size) {
     if (server_handler_.count(meta->cmd()) == 0) {
       MS_LOG(EXCEPTION) << "The cmd:" << meta->cmd() << " is not supported!";
     }
 
     if (meta->cmd() == NodeCommand::COLLECTIVE_SEND_DATA) {
-      ProcessCollectiveSendData(conn, meta, data, size);
-      RunReceiveCallback(meta, protos, data, size);
+      ProcessCollectiveSendData(conn, meta, data.get(), size);
+      RunReceiveCallback(meta, protos, data.get(), size);
     } else if (meta->cmd() == NodeCommand::SEND_DATA) {
       ProcessSendData(conn, meta, protos, data, size);
     } else {
       const auto &handler_ptr = server_handler_[meta->cmd()];
-      (this->*handler_ptr)(conn, meta, protos, data, size);
+      (this->*handler_ptr)(conn, meta, protos, data.get(), size);
     }
   });
   server_->Init();
@@ -93,24 +105,18 @@ void ServerNode::Initialize() {
 }
 
 void ServerNode::ProcessSendData(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
-                                 const Protos &protos, const void *data, size_t size) {
+                                 const Protos &protos, const DataPtr &data, size_t size) {
   MS_EXCEPTION_IF_NULL(conn);
   MS_EXCEPTION_IF_NULL(meta);
   MS_EXCEPTION_IF_NULL(data);
-  std::shared_ptr<unsigned char[]> res(new unsigned char[size]);
-  size_t dest_size = size;
-  size_t src_size = size;
-  auto ret = memcpy_s(res.get(), dest_size, data, src_size);
-  if (ret != EOK) {
-    MS_LOG(EXCEPTION) << "The memcpy_s error, errorno(" << ret << ")";
-  }
   MS_LOG(DEBUG) << "The node role is:" << CommUtil::NodeRoleToString(node_info_.node_role_)
                 << ", the node id is:" << node_info_.node_id_ << " send the request id is:" << meta->request_id()
                 << " the current time is:"
                 << std::chrono::time_point_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now())
                      .time_since_epoch()
                      .count();
-  request_handler_(conn, meta, res, size);
+  // The handler takes the receive buffer itself
+  request_handler_(conn, meta, data, size);
 }
 
 void ServerNode::ProcessCollectiveSendData(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
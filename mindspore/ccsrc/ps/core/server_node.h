@@ -56,6 +56,8 @@ class ServerNode : public AbstractNode {
 
   void set_handler(const RequestHandler &handler);
   void Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const void *data, size_t size);
+  // Send the response from where it is instead of copying it.
+  void Response(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const VectorPtr &data);
 
   std::shared_ptr<CommunicatorBase> GetOrCreateHttpComm(const std::string &ip, std::int16_t port,
                                                         const std::shared_ptr<TaskExecutor> &task_executor);
@@ -67,7 +69,7 @@ class ServerNode : public AbstractNode {
   void CreateTcpServer();
   void Initialize();
   void ProcessSendData(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta, const Protos &protos,
-                       const void *data, size_t size);
+                       const DataPtr &data, size_t size);
   void ProcessCollectiveSendData(std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
                                  const void *data, size_t size);
 
@@ -0,0 +1,315 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/gradient_compression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+
+#include "base/float16.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+constexpr float kFp16Max = 65504.0f;
+constexpr size_t kHalfSize = sizeof(uint16_t);
+constexpr uint16_t kFp16QuietNan = 0x7E00;
+constexpr uint16_t kFp16SignBit = 0x8000;
+
+uint16_t FloatToFp16(float value) {
+  if (std::isnan(value)) {
+    // Keep NaN a NaN rather than clamp it to the largest half
+    return static_cast<uint16_t>(kFp16QuietNan | (std::signbit(value) ? kFp16SignBit : 0));
+  }
+  float16 half = static_cast<float16>(std::max(-kFp16Max, std::min(kFp16Max, value)));
+  uint16_t bits;
+  (void)memcpy(&bits, &half, kHalfSize);
+  return bits;
+}
+
+float Fp16ToFloat(uint16_t bits) {
+  float16 half;
+  (void)memcpy(&half, &bits, kHalfSize);
+  return static_cast<float>(half);
+}
+
+// bf16 is the upper half of an fp32, rounded to nearest even
+uint16_t FloatToBf16(float value) {
+  uint32_t bits;
+  (void)memcpy(&bits, &value, sizeof(bits));
+  if ((bits & 0x7FFFFFFF) > 0x7F800000) {
+    // Keep NaN a quiet NaN rather than round it to infinity
+    return static_cast<uint16_t>((bits >> 16) | 0x40);
+  }
+  bits += 0x7FFF + ((bits >> 16) & 1);
+  return static_cast<uint16_t>(bits >> 16);
+}
+
+float Bf16ToFloat(uint16_t half) {
+  uint32_t bits = static_cast<uint32_t>(half) << 16;
+  float value;
+  (void)memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void PutVarint(uint64_t value, std::string *out) {
+  while (value >= 0x80) {
+    out->push_back(static_cast<char>((value & 0x7F) | 0x80));
+    value >>= 7;
+  }
+  out->push_back(static_cast<char>(value));
+}
+
+bool GetVarint(const std::string &data, size_t *pos, uint64_t *value) {
+  *value = 0;
+  for (int shift = 0; shift < 64 && *pos < data.size(); shift += 7) {
+    auto byte = static_cast<uint8_t>(data[(*pos)++]);
+    *value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void PutHalf(uint16_t half, std::string *out) { out->append(reinterpret_cast<const char *>(&half), kHalfSize); }
+
+void SetHalf(uint16_t half, char *data, size_t i) { (void)memcpy(data + i * kHalfSize, &half, kHalfSize); }
+
+uint16_t GetHalf(const char *data, size_t i) {
+  uint16_t half;
+  (void)memcpy(&half, data + i * kHalfSize, kHalfSize);
+  return half;
+}
+
+template <bool add>
+void Store(float value, float *dst) {
+  if (add) {
+    *dst += value;
+  } else {
+    *dst = value;
+  }
+}
+
+template <bool add>
+bool DecodeCast(CompressionType type, const std::string &data, float *dst, size_t size) {
+  if (type == CompressionType::kNone) {
+    if (data.size() != size * sizeof(float)) {
+      return false;
+    }
+    auto src = reinterpret_cast<const float *>(data.data());
+    for (size_t i = 0; i < size; i++) {
+      Store<add>(src[i], dst + i);
+    }
+    return true;
+  }
+  if (data.size() != size * kHalfSize) {
+    return false;
+  }
+  if (type == CompressionType::kFp16) {
+    for (size_t i = 0; i < size; i++) {
+      Store<add>(Fp16ToFloat(GetHalf(data.data(), i)), dst + i);
+    }
+  } else if (type == CompressionType::kBf16) {
+    for (size_t i = 0; i < size; i++) {
+      Store<add>(Bf16ToFloat(GetHalf(data.data(), i)), dst + i);
+    }
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <bool add>
+bool DecodeTopK(const std::string &data, float *dst, size_t size) {
+  size_t pos = 0;
+  uint64_t k = 0;
+  if (!GetVarint(data, &pos, &k) || k > size) {
+    return false;
+  }
+  if (!add) {
+    std::fill(dst, dst + size, 0.0f);
+  }
+  std::vector<uint64_t> indices(k);
+  uint64_t next = 0;
+  for (uint64_t i = 0; i < k; i++) {
+    uint64_t gap = 0;
+    if (!GetVarint(data, &pos, &gap) || gap >= size - next) {
+      return false;
+    }
+    indices[i] = next + gap;
+    next = indices[i] + 1;
+  }
+  if (data.size() - pos != k * kHalfSize) {
+    return false;
+  }
+  const char *values = data.data() + pos;
+  for (uint64_t i = 0; i < k; i++) {
+    Store<add>(Bf16ToFloat(GetHalf(values, i)), dst + indices[i]);
+  }
+  return true;
+}
+}  // namespace
+
+CompressionType StringToCompressionType(const std::string &name) {
+  static const std::unordered_map<std::string, CompressionType> kTypes = {{"none", CompressionType::kNone},
+                                                                          {"fp16", CompressionType::kFp16},
+                                                                          {"bf16", CompressionType::kBf16},
+                                                                          {"topk", CompressionType::kTopK}};
+  auto iter = kTypes.find(name);
+  if (iter == kTypes.end()) {
+    MS_LOG(EXCEPTION) << "Gradient compression " << name << " is not supported, it should be none, fp16, bf16 or topk.";
+  }
+  return iter->second;
+}
+
+void DecompressGrad(const CompressedGrad &grad, const Values &values, const Lengths &lengths, Values *dense_values,
+                    Lengths *dense_lengths) {
+  MS_EXCEPTION_IF_NULL(grad.data);
+  MS_EXCEPTION_IF_NULL(dense_values);
+  MS_EXCEPTION_IF_NULL(dense_lengths);
+  if (grad.index >= lengths.size() || lengths[grad.index] != 0) {
+    MS_LOG(EXCEPTION) << "The compressed gradient index " << grad.index << " does not match the lengths " << lengths;
+  }
+  size_t offset = 0;
+  for (size_t i = 0; i < grad.index; i++) {
+    offset += static_cast<size_t>(lengths[i]);
+  }
+  if (offset > values.size()) {
+    MS_LOG(EXCEPTION) << "The gradient offset " << offset << " is beyond the " << values.size() << " values.";
+  }
+  dense_values->assign(values.begin(), values.begin() + offset);
+  dense_values->resize(offset + grad.size);
+  if (!GradientCompressor::Decode(grad.type, *grad.data, dense_values->data() + offset, grad.size)) {
+    MS_LOG(EXCEPTION) << "The gradient of compression " << static_cast<int32_t>(grad.type) << " is malformed.";
+  }
+  dense_values->insert(dense_values->end(), values.begin() + offset, values.end());
+  *dense_lengths = lengths;
+  (*dense_lengths)[grad.index] = static_cast<int>(grad.size);
+}
+
+void GradientCompressor::Init(CompressionType type, float topk_ratio) {
+  if (type == CompressionType::kTopK && (topk_ratio <= 0 || topk_ratio > 1)) {
+    MS_LOG(EXCEPTION) << "The top-k ratio should be in (0, 1], but got " << topk_ratio;
+  }
+  std::lock_guard<std::mutex> lock(residuals_mutex_);
+  type_ = type;
+  topk_ratio_ = topk_ratio;
+  residuals_.clear();
+}
+
+void GradientCompressor::Compress(const Key &key, const float *grad, size_t size, std::string *out) {
+  MS_EXCEPTION_IF_NULL(grad);
+  MS_EXCEPTION_IF_NULL(out);
+  if (type_ != CompressionType::kTopK) {
+    Encode(type_, grad, size, out);
+    return;
+  }
+  // The pushes of one key do not overlap, the lock only guards the map
+  std::vector<float> *residual;
+  {
+    std::lock_guard<std::mutex> lock(residuals_mutex_);
+    residual = &residuals_[key];
+  }
+  if (residual->size() != size) {
+    residual->assign(size, 0);
+  }
+  float *accum = residual->data();
+  for (size_t i = 0; i < size; i++) {
+    accum[i] += grad[i];
+  }
+
+  // Find the k-th largest magnitude, then take the values above it and enough of the values equal to it in order
+  size_t k = std::min(size, std::max<size_t>(1, static_cast<size_t>(std::ceil(size * topk_ratio_))));
+  std::vector<float> magnitudes(size);
+  for (size_t i = 0; i < size; i++) {
+    magnitudes[i] = std::fabs(accum[i]);
+  }
+  (void)std::nth_element(magnitudes.begin(), magnitudes.begin() + k - 1, magnitudes.end(), std::greater<float>());
+  float threshold = magnitudes[k - 1];
+  size_t ties = k - static_cast<size_t>(std::count_if(magnitudes.begin(), magnitudes.end(),
+                                                      [threshold](float value) { return value > threshold; }));
+  std::vector<uint32_t> indices;
+  indices.reserve(k);
+  for (size_t i = 0; i < size && indices.size() < k; i++) {
+    float magnitude = std::fabs(accum[i]);
+    if (magnitude > threshold || (magnitude == threshold && ties > 0)) {
+      ties -= magnitude == threshold ? 1 : 0;
+      indices.push_back(static_cast<uint32_t>(i));
+    }
+  }
+
+  out->clear();
+  out->reserve(2 * sizeof(uint64_t) + k * (kHalfSize + 1));
+  PutVarint(k, out);
+  uint32_t next = 0;
+  for (uint32_t index : indices) {
+    PutVarint(index - next, out);
+    next = index + 1;
+  }
+  // What is sent, rounding included, leaves the residual
+  for (uint32_t index : indices) {
+    uint16_t half = FloatToBf16(accum[index]);
+    PutHalf(half, out);
+    accum[index] -= Bf16ToFloat(half);
+  }
+}
+
+void GradientCompressor::Encode(CompressionType type, const float *data, size_t size, std::string *out) {
+  MS_EXCEPTION_IF_NULL(data);
+  MS_EXCEPTION_IF_NULL(out);
+  out->clear();
+  switch (type) {
+    case CompressionType::kNone:
+      out->assign(reinterpret_cast<const char *>(data), size * sizeof(float));
+      break;
+    case CompressionType::kFp16:
+      out->resize(size * kHalfSize);
+      for (size_t i = 0; i < size; i++) {
+        SetHalf(FloatToFp16(data[i]), &out->front(), i);
+      }
+      break;
+    case CompressionType::kBf16:
+      out->resize(size * kHalfSize);
+      for (size_t i = 0; i < size; i++) {
+        SetHalf(FloatToBf16(data[i]), &out->front(), i);
+      }
+      break;
+    default:
+      MS_LOG(EXCEPTION) << "Compression " << static_cast<int32_t>(type) << " needs the state of a compressor.";
+  }
+}
+
+bool GradientCompressor::DecodeAdd(CompressionType type, const std::string &data, float *dst, size_t size) {
+  MS_EXCEPTION_IF_NULL(dst);
+  if (type == CompressionType::kTopK) {
+    return DecodeTopK<true>(data, dst, size);
+  }
+  return DecodeCast<true>(type, data, dst, size);
+}
+
+bool GradientCompressor::Decode(CompressionType type, const std::string &data, float *dst, size_t size) {
+  MS_EXCEPTION_IF_NULL(dst);
+  if (type == CompressionType::kTopK) {
+    return DecodeTopK<false>(data, dst, size);
+  }
+  return DecodeCast<false>(type, data, dst, size);
+}
+}  // namespace ps
+}  // namespace mindspore
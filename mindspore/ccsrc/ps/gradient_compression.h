@@ -0,0 +1,89 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
+#define MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// How the values of a push or pull are encoded on the wire. The value is sent in KVMessage.compression.
+enum class CompressionType : int32_t {
+  // Dense fp32 values.
+  kNone = 0,
+  // Every value cast to fp16, values beyond the fp16 range are saturated.
+  kFp16 = 1,
+  // Every value cast to bf16, which keeps the fp32 range with an 8 bit mantissa.
+  kBf16 = 2,
+  // The largest values by magnitude with their indices. The gaps between the indices are varint coded, which takes
+  // one byte for the gaps below 128, and the values are bf16.
+  kTopK = 3,
+};
+
+// Parse "none", "fp16", "bf16" or "topk".
+CompressionType StringToCompressionType(const std::string &name);
+
+// A gradient received compressed. It is decoded straight into the accumulated gradient of the optimizer.
+struct CompressedGrad {
+  CompressionType type;
+  // Index of the gradient among the inputs sent by the worker
+  size_t index;
+  // Number of floats of the gradient
+  size_t size;
+  const std::string *data;
+};
+
+// Rebuild the dense inputs of a push whose gradient is compressed.
+void DecompressGrad(const CompressedGrad &grad, const Values &values, const Lengths &lengths, Values *dense_values,
+                    Lengths *dense_lengths);
+
+class GradientCompressor {
+ public:
+  GradientCompressor() : type_(CompressionType::kNone), topk_ratio_(kDefaultTopKRatio) {}
+  ~GradientCompressor() = default;
+
+  void Init(CompressionType type, float topk_ratio);
+  CompressionType type() const { return type_; }
+
+  // Compress a gradient of a key. With top-k the values which are not sent are kept, and added to the next gradient
+  // of the key, so every value reaches the server sooner or later.
+  void Compress(const Key &key, const float *grad, size_t size, std::string *out);
+
+  // Cast values to fp16 or bf16 without keeping anything, as for the weights pulled by the workers.
+  static void Encode(CompressionType type, const float *data, size_t size, std::string *out);
+
+  // Add the encoded values to dst, which holds size floats. Return false if the data is malformed.
+  static bool DecodeAdd(CompressionType type, const std::string &data, float *dst, size_t size);
+
+  // Write the encoded values to dst, the values left out by top-k are zero.
+  static bool Decode(CompressionType type, const std::string &data, float *dst, size_t size);
+
+ private:
+  CompressionType type_;
+  float topk_ratio_;
+  // What top-k has not sent yet for each key
+  std::unordered_map<Key, std::vector<float>> residuals_;
+  std::mutex residuals_mutex_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_GRADIENT_COMPRESSION_H_
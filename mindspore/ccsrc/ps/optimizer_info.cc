@@ -39,6 +39,10 @@ size_t OptimizerInfo::grad_index() { return 0; }
 
 size_t OptimizerInfo::indices_index() { return 0; }
 
+void OptimizerInfo::AccumulateCompressed(const CompressedGrad &) {
+  MS_LOG(EXCEPTION) << "Only dense gradients can be pushed compressed.";
+}
+
 template <typename T>
 void OptimizerInfo::UpdateOptimInputValue(const std::string &optim_type, const std::string &input_name, void *data,
                                           const Lengths &lens) {
@@ -93,6 +97,20 @@ void DenseOptimInfo::Accumulate(const Values &values, const Lengths &lengths) {
   }
 }
 
+void DenseOptimInfo::AccumulateCompressed(const CompressedGrad &grad) {
+  MS_EXCEPTION_IF_NULL(gradient()->addr);
+  MS_EXCEPTION_IF_NULL(grad.data);
+  float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
+  size_t size = gradient()->size / sizeof(float);
+  if (grad.index != grad_index() || grad.size != size) {
+    MS_LOG(EXCEPTION) << "The compressed gradient of index " << grad.index << " and size " << grad.size
+                      << " does not match the gradient of index " << grad_index() << " and size " << size;
+  }
+  if (!GradientCompressor::DecodeAdd(grad.type, *grad.data, accum_grad_data, size)) {
+    MS_LOG(EXCEPTION) << "The gradient of compression " << static_cast<int32_t>(grad.type) << " is malformed.";
+  }
+}
+
 void DenseOptimInfo::ComputeMean(const std::vector<std::vector<size_t>> &, size_t n, size_t, size_t) {
   if (n > 1) {
     float *accum_grad_data = reinterpret_cast<float *>(gradient()->addr);
@@ -21,6 +21,7 @@
 #include <string>
 #include "backend/kernel_compiler/kernel.h"
 #include "ps/constants.h"
+#include "ps/gradient_compression.h"
 
 namespace mindspore {
 namespace ps {
@@ -32,6 +33,8 @@ class OptimizerInfo {
 
   virtual void Update(const Values &values, const Lengths &lengths) {}
   virtual void Accumulate(const Values &values, const Lengths &lengths) = 0;
+  // Decode a compressed gradient straight into the accumulated gradient
+  virtual void AccumulateCompressed(const CompressedGrad &grad);
   virtual void ComputeMean(const std::vector<std::vector<size_t>> &shapes, size_t n, size_t server_num,
                            size_t rank_id) {}
   virtual void Reset() {}
@@ -63,6 +66,7 @@ class DenseOptimInfo : public OptimizerInfo {
   ~DenseOptimInfo() override = default;
 
   void Accumulate(const Values &values, const Lengths &lens) override;
+  void AccumulateCompressed(const CompressedGrad &grad) override;
   void ComputeMean(const std::vector<std::vector<size_t>> &shapes, size_t n, size_t server_num,
                    size_t rank_id) override;
   void Reset() override;
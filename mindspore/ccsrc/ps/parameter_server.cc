@@ -55,6 +55,8 @@ bool ParameterServer::Init(const FuncGraphPtr &func_graph) {
       Finalize();
     }
   });
+  request_executor_ = std::make_shared<core::TaskExecutor>(kThreadNum);
+  optimizer_executor_ = std::make_shared<core::TaskExecutor>(std::max(std::thread::hardware_concurrency(), 1U));
   thread_.reset(new std::thread(&ParameterServer::UpdateWeights, this));
   GetEmbeddingTableParamPtr();
   return true;
@@ -133,6 +135,10 @@ void ParameterServer::InitOptimInputsShape(const Keys &keys, const Values &value
         optimizer->InitKernel(cnode, optim_inputs_shape_[key]);
         optimizers_[key] = optimizer;
       }
+      // The optimizer info is built by the first push. Its slot is made here, the pushes do not change the maps.
+      if (optimizers_.count(key) > 0) {
+        optim_infos_[key] = nullptr;
+      }
     }
   }
 }
@@ -188,6 +194,7 @@ void ParameterServer::InitEmbeddingTable(
       }
     }
     weights_[key] = embedding;
+    embedding_row_locks_[key] = std::make_shared<StripedLock>(kEmbeddingLockStripes, kEmbeddingRowsPerLockRange);
     MS_LOG(DEBUG) << "The key:" << key << " the embedding:" << *embedding;
     tokens_[key] = 0;
     is_embedding_[key] = true;
@@ -199,178 +206,221 @@ void ParameterServer::InitEmbeddingTable(
 bool ParameterServer::HasWeight(const Key &key) { return (weights_.count(key) > 0 && !is_embedding_.count(key)); }
 
 void ParameterServer::Finalize() {
-  running_ = false;
+  {
+    std::unique_lock<std::mutex> lock(apply_grads_mutex_);
+    running_ = false;
+  }
   apply_grads_cv_.notify_one();
 }
 
 void ParameterServer::UpdateWeights() {
   while (true) {
-    MS_LOG(INFO) << "The running is:" << running_ << " the ready is:" << this->ReadyForUpdateWeights();
-    std::unique_lock<std::mutex> lock(mutex_);
-    apply_grads_cv_.wait(lock, [this] { return this->ReadyForUpdateWeights() || !running_; });
+    MS_LOG(INFO) << "The running is:" << running_;
+    {
+      std::unique_lock<std::mutex> lock(apply_grads_mutex_);
+      apply_grads_cv_.wait(lock, [this] {
+        std::shared_lock<std::shared_mutex> map_lock(mutex_);
+        return this->ReadyForUpdateWeights() || !running_;
+      });
+    }
     if (!running_) {
       break;
     }
 
+    // Each key has its own optimizer and optimizer info, so the keys are updated in parallel. The workers push no
+    // gradient until the counts are reset, see ReadyForPush.
+    std::shared_lock<std::shared_mutex> map_lock(mutex_);
+    std::vector<std::function<void()>> tasks;
+    tasks.reserve(weights_.size());
     for (auto iter = weights_.begin(); iter != weights_.end(); iter++) {
       Key key = iter->first;
-      WeightPtr weight_ptr = iter->second;
-
-      std::shared_ptr<PServerKernel> optimizer = nullptr;
-      if (weight_key_to_optims_.count(key) > 0) {
-        optimizer = optimizers_[key];
-      }
-      MS_EXCEPTION_IF_NULL(optimizer);
-
-      std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-      if (optim_info != nullptr) {
-        const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
-        const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
-        const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
-
-        std::vector<std::vector<size_t>> shapes = {};
-        std::vector<size_t> indices_shape = {};
-        indices_shape.emplace_back(optim_info->indice_size());
-        shapes.push_back(indices_shape);
-
-        if (original_optim_inputs_shape_.count(key) != 0) {
-          std::transform(
-            (*(original_optim_inputs_shape_[key])).begin(), (*(original_optim_inputs_shape_[key])).end(),
-            std::back_inserter(shapes),
-            [](std::shared_ptr<std::vector<size_t>> input_shapes) -> std::vector<size_t> { return *input_shapes; });
-        }
-        optimizer->ReInit(shapes);
-        optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
-        optimizer->Execute(inputs, workspaces, outputs);
-        optim_info->Reset();
-      }
-      if (!is_embedding_[key]) {
-        tokens_[key] = worker_num_;
-      }
+      tasks.emplace_back([this, key]() { UpdateWeight(key); });
+    }
+    if (!optimizer_executor_->Run(tasks)) {
+      MS_LOG(EXCEPTION) << "Failed to run the optimizers of " << tasks.size() << " keys.";
     }
     ResetGradAccumCount();
   }
 }
 
-void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths) {
-  std::unique_lock<std::mutex> lock(mutex_);
+void ParameterServer::UpdateWeight(const Key &key) {
+  std::unique_lock<std::shared_mutex> key_lock(key_locks_.Get(key));
+  // The optimizer of an embedding table writes rows of the table, which the lookups read
+  std::unique_ptr<MultiStripeLock> rows_lock = nullptr;
+  auto row_locks = embedding_row_locks_.find(key);
+  if (row_locks != embedding_row_locks_.end()) {
+    rows_lock = std::make_unique<MultiStripeLock>(row_locks->second.get(), true);
+  }
+
+  std::shared_ptr<PServerKernel> optimizer = nullptr;
+  auto optimizer_iter = optimizers_.find(key);
+  if (weight_key_to_optims_.count(key) > 0 && optimizer_iter != optimizers_.end()) {
+    optimizer = optimizer_iter->second;
+  }
+  MS_EXCEPTION_IF_NULL(optimizer);
+
+  auto optim_info_iter = optim_infos_.find(key);
+  std::shared_ptr<OptimizerInfo> optim_info = optim_info_iter == optim_infos_.end() ? nullptr : optim_info_iter->second;
+  if (optim_info != nullptr) {
+    const std::vector<kernel::AddressPtr> &inputs = optim_info->inputs();
+    const std::vector<kernel::AddressPtr> &workspaces = optim_info->workspaces();
+    const std::vector<kernel::AddressPtr> &outputs = optim_info->outputs();
+
+    std::vector<std::vector<size_t>> shapes = {};
+    std::vector<size_t> indices_shape = {};
+    indices_shape.emplace_back(optim_info->indice_size());
+    shapes.push_back(indices_shape);
+
+    auto original_shape = original_optim_inputs_shape_.find(key);
+    if (original_shape != original_optim_inputs_shape_.end()) {
+      std::transform(
+        original_shape->second->begin(), original_shape->second->end(), std::back_inserter(shapes),
+        [](std::shared_ptr<std::vector<size_t>> input_shapes) -> std::vector<size_t> { return *input_shapes; });
+    }
+    optimizer->ReInit(shapes);
+    optim_info->ComputeMean(shapes, worker_num_, pserver_num_, server_node_->rank_id());
+    optimizer->Execute(inputs, workspaces, outputs);
+    optim_info->Reset();
+  }
+  auto is_embedding = is_embedding_.find(key);
+  auto tokens = tokens_.find(key);
+  if ((is_embedding == is_embedding_.end() || !is_embedding->second) && tokens != tokens_.end()) {
+    tokens->second = worker_num_;
+  }
+  auto counter = grads_accum_counter_.find(key);
+  if (counter != grads_accum_counter_.end()) {
+    counter->second = 0;
+  }
+}
+
+void ParameterServer::AccumGrad(const Keys &keys, const Values &values, const Lengths &lengths,
+                                const CompressedGrad *compressed_grad) {
   const Key &key = keys[0];
-  bool no_sparse_grad = values.size() == 1 && values[0] == -100;
-  if (!no_sparse_grad) {
-    std::shared_ptr<OptimizerInfo> optim_info = optim_infos_[key];
-
-    // Create or update the optimizer info
-    if (optim_info == nullptr) {
-      const std::shared_ptr<OptimizerInfoBuilder> &builder = optim_info_builders_[weight_key_to_optims_[key]];
-      std::shared_ptr<kernel::ps::PServerKernel> pserver_kernel = optimizers_[key];
-      if (pserver_kernel == nullptr) {
-        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name " << weight_key_to_optims_[key];
+  bool ready = false;
+  {
+    std::shared_lock<std::shared_mutex> map_lock(mutex_);
+    std::unique_lock<std::shared_mutex> key_lock(key_locks_.Get(key));
+    bool no_sparse_grad = values.size() == 1 && values[0] == -100;
+    if (!no_sparse_grad) {
+      auto optim_info_iter = optim_infos_.find(key);
+      auto optimizer_iter = optimizers_.find(key);
+      if (optim_info_iter == optim_infos_.end() || optimizer_iter == optimizers_.end() ||
+          optimizer_iter->second == nullptr) {
+        auto optim_name = weight_key_to_optims_.find(key);
+        MS_LOG(EXCEPTION) << "no optimizer found for key " << key << " optim name "
+                          << (optim_name == weight_key_to_optims_.end() ? "" : optim_name->second);
+      }
+      std::shared_ptr<OptimizerInfo> &optim_info = optim_info_iter->second;
+
+      // Create or update the optimizer info
+      if (optim_info == nullptr) {
+        const std::shared_ptr<OptimizerInfoBuilder> &builder =
+          optim_info_builders_.at(weight_key_to_optims_.at(key));
+        const std::shared_ptr<kernel::ps::PServerKernel> &pserver_kernel = optimizer_iter->second;
+        auto inputs_shape = optim_inputs_shape_.find(key);
+        auto is_embedding = is_embedding_.find(key);
+        // The builder takes dense inputs, which only the first push of a key is expanded to
+        Values dense_values;
+        Lengths dense_lengths;
+        if (compressed_grad != nullptr) {
+          DecompressGrad(*compressed_grad, values, lengths, &dense_values, &dense_lengths);
+        }
+        OptimizerInfo *optim = builder->Build(
+          pserver_kernel, weights_.at(key), keys, compressed_grad == nullptr ? values : dense_values,
+          compressed_grad == nullptr ? lengths : dense_lengths,
+          inputs_shape == optim_inputs_shape_.end() ? nullptr : inputs_shape->second, worker_num_,
+          is_embedding != is_embedding_.end() && is_embedding->second);
+        optim_info.reset(optim);
+      } else if (compressed_grad != nullptr) {
+        optim_info->Update(values, lengths);
+        optim_info->AccumulateCompressed(*compressed_grad);
+      } else {
+        optim_info->Update(values, lengths);
+        optim_info->Accumulate(values, lengths);
       }
-      MS_EXCEPTION_IF_NULL(pserver_kernel);
-      OptimizerInfo *optim = builder->Build(pserver_kernel, weights_[key], keys, values, lengths,
-                                            optim_inputs_shape_[key], worker_num_, is_embedding_[key]);
-      optim_info.reset(optim);
-      optim_infos_[key] = optim_info;
-    } else {
-      optim_info->Update(values, lengths);
-      optim_info->Accumulate(values, lengths);
     }
-  }
 
-  grads_accum_counter_[key] += 1;
-  if (grads_accum_counter_[key] == worker_num_) {
-    grad_accum_count_++;
+    auto counter = grads_accum_counter_.find(key);
+    if (counter == grads_accum_counter_.end()) {
+      MS_LOG(EXCEPTION) << "Invalid grad key " << key;
+    }
+    counter->second += 1;
+    if (counter->second == worker_num_) {
+      grad_accum_count_++;
+    }
+    ready = ReadyForUpdateWeights();
   }
-  if (ReadyForUpdateWeights()) {
+  // The map lock is released first, the update thread takes it while holding the lock of the condition variable
+  if (ready) {
+    { std::unique_lock<std::mutex> lock(apply_grads_mutex_); }
     apply_grads_cv_.notify_one();
   }
 }
 
 WeightPtr ParameterServer::weight(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> map_lock(mutex_);
+  auto iter = weights_.find(key);
+  if (iter == weights_.end()) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  WeightPtr weight_ptr = weights_[key];
+  WeightPtr weight_ptr = iter->second;
   MS_EXCEPTION_IF_NULL(weight_ptr);
-  WeightPtr copy_weight_ptr = std::make_shared<std::vector<float>>(weight_ptr->size(), 0);
-  MS_EXCEPTION_IF_NULL(copy_weight_ptr);
-  copy_weight_ptr = weight_ptr;
-  tokens_[key] -= 1;
-  return copy_weight_ptr;
+  // No copy is made, the weight is not updated again before every worker has pulled it and pushed its gradient
+  std::unique_lock<std::shared_mutex> key_lock(key_locks_.Get(key));
+  auto tokens = tokens_.find(key);
+  if (tokens != tokens_.end()) {
+    tokens->second -= 1;
+  }
+  return weight_ptr;
 }
 
 void ParameterServer::DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res) {
-  std::unique_lock<std::mutex> lock(mutex_);
   MS_EXCEPTION_IF_NULL(res);
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> map_lock(mutex_);
+  auto table = weights_.find(key);
+  if (table == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_op = embedding_lookup_ops_.find(key);
+  auto row_locks = embedding_row_locks_.find(key);
+  if (lookup_op == embedding_lookup_ops_.end() || row_locks == embedding_row_locks_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = table->second;
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = lookup_op->second;
   MS_EXCEPTION_IF_NULL(table_lookup_op);
 
-  // Update shapes of lookup operator
-  std::vector<std::vector<size_t>> shapes = {};
-  std::vector<size_t> indices_shape = {};
-  indices_shape.emplace_back(lookup_ids.size());
-  shapes.push_back(indices_shape);
-  table_lookup_op->ReInit(shapes);
-
-  const std::vector<size_t> output_shapes = table_lookup_op->output_sizes();
-  std::vector<kernel::AddressPtr> inputs;
-  AddressPtr embedding_table = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(embedding_table);
-  AddressPtr indices = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(indices);
-  inputs.push_back(embedding_table);
-  inputs.push_back(indices);
-  embedding_table->addr = table_ptr->data();
-  embedding_table->size = table_ptr->size() * sizeof(float);
-
-  std::unique_ptr<int[]> tmp_ids(new int[lookup_ids.size()]);
-  MS_EXCEPTION_IF_NULL(tmp_ids);
-  for (size_t i = 0; i < lookup_ids.size(); i++) {
-    tmp_ids[i] = static_cast<int>(lookup_ids[i]);
-  }
-  indices->addr = tmp_ids.get();
-  indices->size = lookup_ids.size() * sizeof(int);
-
-  std::vector<kernel::AddressPtr> workspaces;
-  std::vector<kernel::AddressPtr> outputs;
-  AddressPtr output = std::make_shared<kernel::Address>();
-  MS_EXCEPTION_IF_NULL(output);
-  std::shared_ptr<Values> addr = std::make_shared<Values>(output_shapes[0] / sizeof(float), 0);
-  MS_EXCEPTION_IF_NULL(addr);
-
-  output->addr = addr->data();
-  output->size = output_shapes[0];
-  outputs.push_back(output);
-
-  table_lookup_op->Execute(inputs, workspaces, outputs);
-  *res->mutable_values() = {addr->begin(), addr->end()};
+  // Only the rows looked up are locked, and only against writes
+  Values values;
+  {
+    MultiStripeLock rows_lock(row_locks->second.get(), lookup_ids.data(), lookup_ids.size(), false);
+    table_lookup_op->LookupEmbeddings(table_ptr->data(), lookup_ids.data(), lookup_ids.size(), &values);
+  }
+  *res->mutable_values() = {values.begin(), values.end()};
   res->add_len(res->values_size());
 }
 
 void ParameterServer::UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals) {
-  if (weights_.count(key) == 0) {
+  std::shared_lock<std::shared_mutex> map_lock(mutex_);
+  auto table = weights_.find(key);
+  if (table == weights_.end()) {
     MS_LOG(ERROR) << "Invalid embedding table key " << key;
     return;
   }
-  if (embedding_lookup_ops_.count(key) == 0) {
+  auto lookup_op = embedding_lookup_ops_.find(key);
+  auto row_locks = embedding_row_locks_.find(key);
+  if (lookup_op == embedding_lookup_ops_.end() || row_locks == embedding_row_locks_.end()) {
     MS_LOG(ERROR) << "Invalid embedding lookup op key " << key;
     return;
   }
-  WeightPtr table_ptr = weights_[key];
+  WeightPtr table_ptr = table->second;
   MS_EXCEPTION_IF_NULL(table_ptr);
-  std::shared_ptr<PServerKernel> table_lookup_op = embedding_lookup_ops_[key];
+  std::shared_ptr<PServerKernel> table_lookup_op = lookup_op->second;
   MS_EXCEPTION_IF_NULL(table_lookup_op);
+  MultiStripeLock rows_lock(row_locks->second.get(), lookup_ids.data(), lookup_ids.size(), true);
   table_lookup_op->UpdateEmbeddings(table_ptr->data(), lookup_ids.data(), vals.data(), lookup_ids.size());
 }
 
@@ -379,30 +429,34 @@ inline bool ParameterServer::ReadyForUpdateWeights() {
 }
 
 inline bool ParameterServer::ReadyForPush(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
+  std::shared_lock<std::shared_mutex> map_lock(mutex_);
   if (weights_.empty()) {
     MS_LOG(EXCEPTION) << "The weights in server is empty. Many reasons could cause this: 1.The Worker didn't send "
                          "kInitWeightsCmd command. 2.The Server failed to initialize weights.";
   }
+  std::shared_lock<std::shared_mutex> key_lock(key_locks_.Get(key));
+  auto tokens = tokens_.find(key);
+  bool no_token = tokens == tokens_.end() || tokens->second <= 0;
   MS_LOG(INFO) << "The grad_accum_count_:" << grad_accum_count_ << " the weights_:" << weights_.size()
-               << " the token:" << (tokens_[key] <= 0);
-  return grad_accum_count_ < weights_.size() && tokens_[key] <= 0;
+               << " the token:" << no_token;
+  return grad_accum_count_ < weights_.size() && no_token;
 }
 
 inline bool ParameterServer::ReadyForPull(const Key &key) {
-  std::unique_lock<std::mutex> lock(mutex_);
-  if (tokens_.count(key) == 0 || weights_[key] == 0) {
+  std::shared_lock<std::shared_mutex> map_lock(mutex_);
+  auto tokens = tokens_.find(key);
+  auto weight = weights_.find(key);
+  if (tokens == tokens_.end() || weight == weights_.end() || weight->second == nullptr) {
     MS_LOG(EXCEPTION) << "Invalid weight key " << key;
   }
-  MS_LOG(INFO) << "ReadyForPull: " << (tokens_[key] > 0);
-  return tokens_[key] > 0;
+  std::shared_lock<std::shared_mutex> key_lock(key_locks_.Get(key));
+  MS_LOG(INFO) << "ReadyForPull: " << (tokens->second > 0);
+  return tokens->second > 0;
 }
 
 inline void ParameterServer::ResetGradAccumCount() {
+  // The count of each key is reset by UpdateWeight, under the lock of the key
   grad_accum_count_ = 0;
-  for (auto iter = grads_accum_counter_.begin(); iter != grads_accum_counter_.end(); iter++) {
-    grads_accum_counter_[iter->first] = 0;
-  }
 }
 
 const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
@@ -417,7 +471,7 @@ const CNodePtr ParameterServer::GetCNode(const std::string &name) const {
   return nullptr;
 }
 
-inline std::mutex &ParameterServer::mutex() { return mutex_; }
+inline std::shared_mutex &ParameterServer::mutex() { return mutex_; }
 
 void ParameterServer::GetEmbeddingTableParamPtr() {
   MS_EXCEPTION_IF_NULL(func_graph_);
@@ -503,6 +557,16 @@ void ParameterServer::ServerHandler::Init() {
 
 void ParameterServer::ServerHandler::operator()(std::shared_ptr<core::TcpConnection> conn,
                                                 std::shared_ptr<core::MessageMeta> meta, DataPtr data, size_t size) {
+  // The tcp server receives on a single thread, the requests are handled by the threads of the executor
+  MS_EXCEPTION_IF_NULL(ps_->request_executor_);
+  if (!ps_->request_executor_->Submit([this, conn, meta, data, size]() { HandleRequest(conn, meta, data, size); })) {
+    MS_LOG(EXCEPTION) << "Failed to submit the request " << meta->request_id();
+  }
+}
+
+void ParameterServer::ServerHandler::HandleRequest(std::shared_ptr<core::TcpConnection> conn,
+                                                   std::shared_ptr<core::MessageMeta> meta, DataPtr data,
+                                                   size_t size) {
   auto output = std::make_shared<std::vector<unsigned char>>();
   if (commands_.count(meta->user_cmd()) == 0) {
     MS_LOG(EXCEPTION) << "The command:" << meta->user_cmd() << " is not supported!";
@@ -514,7 +578,7 @@ void ParameterServer::ServerHandler::operator()(std::shared_ptr<core::TcpConnect
   MS_LOG(DEBUG) << "The output size is:" << output->size();
 
   if (output->size() > 0) {
-    ps_->server_node_->Response(conn, meta, output->data(), output->size());
+    ps_->server_node_->Response(conn, meta, output);
   } else {
     // If the size of the output is 0, then constructed an empty string, Because the Response function is a synchronous,
     // the res variable  will be automatically recycled after calling the Response function
@@ -535,7 +599,13 @@ void ParameterServer::ServerHandler::HandlePushReq(DataPtr data, size_t size, Ve
   Values values = {input.values().begin(), input.values().end()};
   Lengths lens = {input.len().begin(), input.len().end()};
   MS_LOG(DEBUG) << "The keys:" << keys << " the values:" << values << " the len:" << lens;
-  ps_->AccumGrad(keys, values, lens);
+  if (input.compression() != 0) {
+    CompressedGrad grad = {static_cast<CompressionType>(input.compression()), IntToSize(input.compressed_index()),
+                           IntToSize(input.compressed_len()), &input.compressed_values()};
+    ps_->AccumGrad(keys, values, lens, &grad);
+  } else {
+    ps_->AccumGrad(keys, values, lens);
+  }
 }
 
 void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, VectorPtr res) {
@@ -546,7 +616,14 @@ void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, Ve
   *res_data.mutable_keys() = input.keys();
   Key key = input.keys()[0];
   auto weight = ps_->weight(key);
-  *res_data.mutable_values() = {weight->begin(), weight->end()};
+  auto compression = static_cast<CompressionType>(input.compression());
+  if (compression == CompressionType::kFp16 || compression == CompressionType::kBf16) {
+    res_data.set_compression(input.compression());
+    res_data.set_compressed_len(SizeToInt(weight->size()));
+    GradientCompressor::Encode(compression, weight->data(), weight->size(), res_data.mutable_compressed_values());
+  } else {
+    *res_data.mutable_values() = {weight->begin(), weight->end()};
+  }
   res->resize(res_data.ByteSizeLong());
   size_t dest_size = res_data.ByteSizeLong();
   size_t src_size = res_data.ByteSizeLong();
@@ -557,7 +634,7 @@ void ParameterServer::ServerHandler::HandlePullReq(DataPtr data, size_t size, Ve
 }
 
 void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -582,7 +659,7 @@ void ParameterServer::ServerHandler::HandleInitWeights(DataPtr data, size_t size
 }
 
 void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -600,7 +677,7 @@ void ParameterServer::ServerHandler::HandleInitWeightToOptimId(DataPtr data, siz
 }
 
 void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
@@ -617,7 +694,7 @@ void ParameterServer::ServerHandler::HandleInitInputsShape(DataPtr data, size_t
 }
 
 void ParameterServer::ServerHandler::HandleInitEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
+  std::unique_lock<std::shared_mutex> lock(ps_->mutex());
   EmbeddingTableMeta embedding_table_meta;
   embedding_table_meta.ParseFromArray(data.get(), size);
   const Key &key = embedding_table_meta.key();
@@ -711,7 +788,6 @@ void ParameterServer::ServerHandler::HandleEmbeddingLookup(DataPtr data, size_t
 }
 
 void ParameterServer::ServerHandler::HandleUpdateEmbeddings(DataPtr data, size_t size, VectorPtr res) {
-  std::unique_lock<std::mutex> lock(ps_->mutex());
   MS_EXCEPTION_IF_NULL(res);
   KVMessage input;
   input.ParseFromArray(data.get(), size);
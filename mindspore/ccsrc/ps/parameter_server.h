@@ -24,6 +24,8 @@
 #include <memory>
 #include <vector>
 #include <mutex>
+#include <shared_mutex>
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 #include <cmath>
@@ -37,6 +39,7 @@
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/session/session_factory.h"
 #include "ps/optimizer_info.h"
+#include "ps/gradient_compression.h"
 #include "ps/optimizer_info_builder.h"
 #include "ps/ps_context.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
@@ -55,11 +58,13 @@
 #include "ps/constants.h"
 #include "ps/util.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/striped_lock.h"
 #include "utils/log_adapter.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/core/server_node.h"
 #include "ps/core/node.h"
+#include "ps/core/communicator/task_executor.h"
 
 namespace mindspore {
 namespace ps {
@@ -81,6 +86,9 @@ class ParameterServer {
         func_graph_(nullptr),
         sess_(nullptr),
         running_(true),
+        key_locks_(kKeyLockStripes),
+        request_executor_(nullptr),
+        optimizer_executor_(nullptr),
         thread_(nullptr),
         server_node_(nullptr) {}
   ~ParameterServer() = default;
@@ -94,6 +102,8 @@ class ParameterServer {
     void Init();
     void operator()(std::shared_ptr<core::TcpConnection> conn, std::shared_ptr<core::MessageMeta> meta, DataPtr data,
                     size_t size);
+    void HandleRequest(std::shared_ptr<core::TcpConnection> conn, std::shared_ptr<core::MessageMeta> meta,
+                       DataPtr data, size_t size);
     void HandlePushReq(DataPtr data, size_t size, VectorPtr res);
     void HandlePullReq(DataPtr data, size_t size, VectorPtr res);
     void HandleInitWeights(DataPtr data, size_t size, VectorPtr res);
@@ -128,7 +138,9 @@ class ParameterServer {
   bool HasWeight(const Key &key);
   void Finalize();
   void UpdateWeights();
-  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths);
+  void UpdateWeight(const Key &key);
+  void AccumGrad(const Keys &key, const Values &values, const Lengths &lengths,
+                 const CompressedGrad *compressed_grad = nullptr);
   WeightPtr weight(const Key &key);
   void DoEmbeddingLookup(Key key, const LookupIds &lookup_ids, KVMessage *res);
   void UpdateEmbeddings(const Key &key, const LookupIds &lookup_ids, const Values &vals);
@@ -137,17 +149,17 @@ class ParameterServer {
   bool ReadyForPull(const Key &key);
   void ResetGradAccumCount();
   const CNodePtr GetCNode(const std::string &name) const;
-  std::mutex &mutex();
+  std::shared_mutex &mutex();
   void GetEmbeddingTableParamPtr();
   void SyncEmbeddingTables();
 
   size_t pserver_num_;
   size_t worker_num_;
-  size_t grad_accum_count_;
+  std::atomic<size_t> grad_accum_count_;
   std::unique_ptr<ServerHandler> handler_;
   FuncGraphPtr func_graph_;
   std::shared_ptr<session::SessionBasic> sess_;
-  bool running_;
+  std::atomic_bool running_;
 
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> optimizers_;
   std::unordered_map<Key, InputsShapePtr> optim_inputs_shape_;
@@ -163,9 +175,20 @@ class ParameterServer {
   std::unordered_map<Key, std::shared_ptr<PServerKernel>> embedding_lookup_ops_;
   std::unordered_map<Key, uint64_t> tokens_;
 
-  std::mutex mutex_;
+  // Guards the layout of the maps above, which only the init requests change. The other requests hold it shared,
+  // and change the state of a key under the lock of the key, so requests on different keys run at the same time.
+  std::shared_mutex mutex_;
+  StripedLock key_locks_;
+  // The rows of each embedding table, locked by ranges. Lookups of a table only wait for writes to the same rows.
+  std::unordered_map<Key, std::shared_ptr<StripedLock>> embedding_row_locks_;
+
+  std::mutex apply_grads_mutex_;
   std::condition_variable apply_grads_cv_;
 
+  // Handles the requests off the thread of the tcp server, and runs the optimizers of the keys in parallel.
+  std::shared_ptr<core::TaskExecutor> request_executor_;
+  std::shared_ptr<core::TaskExecutor> optimizer_executor_;
+
   std::unique_ptr<std::thread> thread_;
   std::shared_ptr<core::ServerNode> server_node_;
   std::map<Key, ParameterPtr> embedding_tables_;
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "ps/ps_cache/embedding_hash_map.h"
+#include "utils/log_adapter.h"
+
+namespace ps = mindspore::ps;
+
+namespace {
+constexpr size_t kVocabSize = 4 << 20;
+constexpr size_t kCacheSize = kVocabSize / 10;
+constexpr size_t kBatchIds = 16000 * 39;
+constexpr size_t kSteps = 20;
+constexpr size_t kWarmupSteps = 5;
+constexpr double kZipfExponent = 1.05;
+constexpr double kNanoSecond = 1e9;
+
+// Draw ids in [0, vocab_size) with P(id = k) proportional to 1 / (k + 1)^exponent, the ids are shuffled so the
+// frequent ones are spread over the vocab.
+class ZipfIds {
+ public:
+  ZipfIds(size_t vocab_size, double exponent, uint32_t seed) : gen_(seed), uniform_(0, 1), cdf_(vocab_size) {
+    double sum = 0;
+    for (size_t k = 0; k < vocab_size; k++) {
+      sum += 1 / std::pow(k + 1, exponent);
+      cdf_[k] = sum;
+    }
+    for (auto &value : cdf_) {
+      value /= sum;
+    }
+    ids_.resize(vocab_size);
+    for (size_t k = 0; k < vocab_size; k++) {
+      ids_[k] = static_cast<int>(k);
+    }
+    std::shuffle(ids_.begin(), ids_.end(), gen_);
+  }
+
+  void Fill(std::vector<int> *batch) {
+    for (auto &id : *batch) {
+      size_t rank = std::lower_bound(cdf_.begin(), cdf_.end(), uniform_(gen_)) - cdf_.begin();
+      id = ids_[std::min(rank, ids_.size() - 1)];
+    }
+  }
+
+ private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<double> uniform_;
+  std::vector<double> cdf_;
+  std::vector<int> ids_;
+};
+}  // namespace
+
+// The device cache of a Wide&Deep like model: a 4M vocab with Zipf ids, a cache of a tenth of it, and batches of
+// 16000 samples with 39 ids each. Every step looks up the batch, then inserts the misses, swapping out the rows of
+// the older steps, as PsCacheManager::ParseData does. The lookups are compared with the std::unordered_map it used.
+int main(int argc, char **argv) {
+#ifdef USE_GLOG
+#define google mindspore_private
+  FLAGS_logtostderr = false;
+  FLAGS_log_dir = "/tmp";
+  google::InitGoogleLogging(argv[0]);
+#undef google
+#endif
+  ZipfIds zipf(kVocabSize, kZipfExponent, 2);
+  ps::EmbeddingHashMap hash_map(0, kCacheSize);
+  std::unordered_map<int, int> reference;
+  std::vector<size_t> reference_steps(kCacheSize, 0);
+  std::vector<int> swap_out_index(kBatchIds);
+  std::vector<int> swap_out_ids(kBatchIds);
+  std::vector<int> batch(kBatchIds);
+  std::vector<int> hash_index(kBatchIds);
+
+  double lookup_seconds = 0;
+  double reference_seconds = 0;
+  double insert_seconds = 0;
+  size_t lookups = 0;
+  size_t hits = 0;
+  size_t unique_hits = 0;
+  for (size_t step = 1; step <= kSteps; step++) {
+    zipf.Fill(&batch);
+    hash_map.Reset();
+
+    auto start = std::chrono::steady_clock::now();
+    size_t marked = hash_map.FindAndMarkStep(batch.data(), batch.size(), step, hash_index.data());
+    auto lookup_end = std::chrono::steady_clock::now();
+    size_t reference_marked = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto iter = reference.find(batch[i]);
+      if (iter != reference.end() && reference_steps[iter->second] != step) {
+        reference_steps[iter->second] = step;
+        reference_marked++;
+      }
+    }
+    auto reference_end = std::chrono::steady_clock::now();
+    if (marked != reference_marked) {
+      std::cerr << "Step " << step << " marked " << marked << " ids, the reference marked " << reference_marked
+                << "." << std::endl;
+      return 1;
+    }
+
+    size_t step_hits = 0;
+    size_t swap_out_size = 0;
+    bool need_wait_graph = false;
+    for (size_t i = 0; i < batch.size(); i++) {
+      if (hash_index[i] != ps::INVALID_INDEX_VALUE) {
+        step_hits++;
+        continue;
+      }
+      // An id missing twice in the batch is inserted by its first occurrence
+      if (hash_map.FindHashIndex(batch[i]) != ps::INVALID_INDEX_VALUE) {
+        continue;
+      }
+      size_t swapped = swap_out_size;
+      int index = hash_map.ParseData(batch[i], swap_out_index.data(), swap_out_ids.data(), step, step - 1,
+                                     &swap_out_size, &need_wait_graph);
+      if (index == ps::INVALID_INDEX_VALUE) {
+        std::cerr << "Step " << step << " found no room for id " << batch[i] << "." << std::endl;
+        return 1;
+      }
+      if (swap_out_size > swapped) {
+        reference.erase(swap_out_ids[swapped]);
+      }
+      reference[batch[i]] = index;
+      reference_steps[index] = step;
+    }
+    auto insert_end = std::chrono::steady_clock::now();
+    if (hash_map.hash_id_count() != reference.size()) {
+      std::cerr << "Step " << step << " left " << hash_map.hash_id_count() << " ids in the hash map, the reference has "
+                << reference.size() << "." << std::endl;
+      return 1;
+    }
+
+    if (step > kWarmupSteps) {
+      lookup_seconds += std::chrono::duration<double>(lookup_end - start).count();
+      reference_seconds += std::chrono::duration<double>(reference_end - lookup_end).count();
+      insert_seconds += std::chrono::duration<double>(insert_end - reference_end).count();
+      lookups += batch.size();
+      hits += step_hits;
+      unique_hits += marked;
+    }
+  }
+  std::cout << "Hash map lookup " << lookup_seconds * kNanoSecond / lookups << " ns/id, std::unordered_map "
+            << reference_seconds * kNanoSecond / lookups << " ns/id, insert and swap "
+            << insert_seconds * kNanoSecond / lookups << " ns/id, hit rate " << static_cast<double>(hits) / lookups
+            << ", unique hits per step " << unique_hits / (kSteps - kWarmupSteps) << "." << std::endl;
+  return 0;
+}
@@ -0,0 +1,203 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "proto/ps.pb.h"
+#include "ps/constants.h"
+#include "ps/core/communicator/task_executor.h"
+#include "ps/core/communicator/tcp_client.h"
+#include "ps/core/communicator/tcp_server.h"
+#include "ps/striped_lock.h"
+#include "utils/log_adapter.h"
+
+namespace ms = mindspore;
+namespace ps = mindspore::ps;
+namespace core = mindspore::ps::core;
+
+namespace {
+constexpr size_t kKeys = 64;
+constexpr size_t kDim = 1024;
+constexpr size_t kDefaultMaxWorkers = 32;
+constexpr size_t kDefaultRequests = 200;
+
+struct Worker {
+  std::unique_ptr<core::TcpClient> client;
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t responses = 0;
+};
+
+void Usage(const char *name) {
+  std::cerr << "Usage: " << name << " [max_workers] [requests_per_worker]" << std::endl;
+  std::cerr << "  max_workers: the workers double from 1 up to this number, " << kDefaultMaxWorkers << " by default."
+            << std::endl;
+  std::cerr << "  requests_per_worker: half pushes and half pulls, " << kDefaultRequests << " by default." << std::endl;
+}
+
+// Each worker sends its requests one at a time and waits for the reply before the next one.
+void RunWorkers(const std::vector<std::unique_ptr<Worker>> &workers, size_t num_workers, size_t num_requests) {
+  std::vector<std::thread> threads;
+  for (size_t w = 0; w < num_workers; w++) {
+    threads.emplace_back([&workers, w, num_requests]() {
+      Worker *worker = workers[w].get();
+      {
+        std::unique_lock<std::mutex> lock(worker->mtx);
+        worker->responses = 0;
+      }
+      ps::Values grad(kDim, 1);
+      for (size_t r = 0; r < num_requests; r++) {
+        ps::KVMessage request;
+        request.add_keys((w + r) % kKeys);
+        auto meta = std::make_shared<core::MessageMeta>();
+        meta->set_cmd(core::NodeCommand::SEND_DATA);
+        meta->set_user_cmd(r % 2 == 0 ? ps::kPushCmd : ps::kPullCmd);
+        if (r % 2 == 0) {
+          *request.mutable_values() = {grad.begin(), grad.end()};
+        }
+        std::string data = request.SerializeAsString();
+        worker->client->SendMessage(meta, core::Protos::RAW, data.data(), data.size());
+        std::unique_lock<std::mutex> lock(worker->mtx);
+        worker->cv.wait(lock, [worker, r]() { return worker->responses > r; });
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+}  // namespace
+
+// Push and pull dense weights over loopback the way the parameter server handles them: the requests run on a
+// TaskExecutor and lock their key. One stripe stands for the single lock the server used to take for every request.
+int main(int argc, char **argv) {
+#ifdef USE_GLOG
+#define google mindspore_private
+  FLAGS_logtostderr = false;
+  FLAGS_log_dir = "/tmp";
+  google::InitGoogleLogging(argv[0]);
+#undef google
+#endif
+  if (argc > 3) {
+    Usage(argv[0]);
+    return 1;
+  }
+  size_t max_workers = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : kDefaultMaxWorkers;
+  size_t num_requests = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : kDefaultRequests;
+  if (max_workers == 0 || num_requests == 0) {
+    Usage(argv[0]);
+    return 1;
+  }
+
+  std::vector<ps::Weight> weights(kKeys, ps::Weight(kDim, 0));
+  std::unique_ptr<ps::StripedLock> locks;
+  core::TaskExecutor executor(ps::kThreadNum);
+  auto server = std::make_unique<core::TcpServer>("127.0.0.1", 0);
+  server->SetMessageCallback([&](std::shared_ptr<core::TcpConnection> conn, std::shared_ptr<core::MessageMeta> meta,
+                                 const core::Protos &, const void *data, size_t size) {
+    ps::KVMessage input;
+    input.ParseFromArray(data, size);
+    executor.Submit([&, conn, meta, input]() {
+      ps::Key key = input.keys()[0];
+      ps::KVMessage output;
+      if (meta->user_cmd() == ps::kPushCmd) {
+        std::unique_lock<std::shared_mutex> lock(locks->Get(key));
+        for (int i = 0; i < input.values_size(); i++) {
+          weights[key][i] += input.values(i);
+        }
+      } else {
+        std::shared_lock<std::shared_mutex> lock(locks->Get(key));
+        *output.mutable_values() = {weights[key].begin(), weights[key].end()};
+      }
+      output.add_keys(key);
+      std::string res = output.SerializeAsString();
+      server->SendMessage(conn, meta, core::Protos::RAW, res.data(), res.size());
+    });
+  });
+  server->Init();
+  std::thread server_thread([&server]() { server->Start(); });
+
+  std::vector<std::unique_ptr<Worker>> workers(max_workers);
+  for (auto &worker : workers) {
+    worker = std::make_unique<Worker>();
+    worker->client = std::make_unique<core::TcpClient>("127.0.0.1", server->BoundPort());
+    Worker *w = worker.get();
+    worker->client->SetMessageCallback([w](std::shared_ptr<core::MessageMeta>, const core::Protos &, const void *,
+                                           size_t) {
+      std::unique_lock<std::mutex> lock(w->mtx);
+      w->responses++;
+      w->cv.notify_one();
+    });
+    worker->client->Init();
+  }
+  // The clients share one event base, which one thread dispatches
+  std::thread client_thread([&workers]() { workers[0]->client->Start(); });
+  int rc = 0;
+  for (auto &worker : workers) {
+    if (!worker->client->WaitConnected(10)) {
+      std::cerr << "The worker failed to connect to the server." << std::endl;
+      rc = 1;
+      break;
+    }
+  }
+
+  size_t pushes = 0;
+  for (size_t num_stripes : {static_cast<size_t>(1), ps::kKeyLockStripes}) {
+    if (rc != 0) {
+      break;
+    }
+    locks = std::make_unique<ps::StripedLock>(num_stripes);
+    for (size_t num_workers = 1; num_workers <= max_workers; num_workers *= 2) {
+      auto start = std::chrono::steady_clock::now();
+      RunWorkers(workers, num_workers, num_requests);
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      pushes += num_workers * ((num_requests + 1) / 2);
+      std::cout << num_stripes << " lock stripes, " << num_workers
+                << " workers: " << num_workers * num_requests / elapsed << " requests/s." << std::endl;
+    }
+  }
+
+  // Every push added one to each value of a key
+  if (rc == 0) {
+    float sum = 0;
+    for (const auto &weight : weights) {
+      if (weight[0] != weight[kDim - 1]) {
+        std::cerr << "A push was applied to part of a weight." << std::endl;
+        rc = 1;
+      }
+      sum += weight[0];
+    }
+    if (sum != static_cast<float>(pushes)) {
+      std::cerr << "The weights hold " << sum << " pushes, " << pushes << " were sent." << std::endl;
+      rc = 1;
+    }
+  }
+
+  workers[0]->client->Stop();
+  client_thread.join();
+  server->Stop();
+  server_thread.join();
+  return rc;
+}
@@ -0,0 +1,110 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/ps_cache/cpu/cpu_ps_cache.h"
+#include "ps/ps_cache/ps_cache_factory.h"
+#include "utils/convert_utils_base.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace ps {
+namespace cpu {
+MS_REG_PS_CACHE(kCPUDevice, CPUPsCache);
+bool CPUPsCache::InitDevice(uint32_t, const void *) { return true; }
+
+void *CPUPsCache::MallocMemory(size_t size) {
+  std::lock_guard<std::mutex> locker(memory_mutex_);
+  memory_.emplace_back(std::make_unique<unsigned char[]>(size));
+  return memory_.back().get();
+}
+
+bool CPUPsCache::RecordEvent() { return true; }
+
+bool CPUPsCache::SynchronizeEvent() { return true; }
+
+bool CPUPsCache::SynchronizeStream() { return true; }
+
+bool CPUPsCache::CopyHostMemToDevice(void *dst, const void *src, size_t size) {
+  MS_ERROR_IF_NULL(dst);
+  MS_ERROR_IF_NULL(src);
+  if (memcpy_s(dst, size, src, size) != EOK) {
+    MS_LOG(ERROR) << "Copy host memory to device failed, size:" << size;
+    return false;
+  }
+  return true;
+}
+
+bool CPUPsCache::CopyDeviceMemToHost(void *dst, const void *src, size_t size) {
+  MS_ERROR_IF_NULL(dst);
+  MS_ERROR_IF_NULL(src);
+  if (memcpy_s(dst, size, src, size) != EOK) {
+    MS_LOG(ERROR) << "Copy device memory to host failed, size:" << size;
+    return false;
+  }
+  return true;
+}
+
+bool CPUPsCache::HashSwapOut(void *hash_table_addr, void *swap_out_value_addr, void *swap_out_index_addr,
+                             size_t cache_vocab_size, size_t embedding_size, size_t swap_out_size) {
+  MS_ERROR_IF_NULL(hash_table_addr);
+  MS_ERROR_IF_NULL(swap_out_value_addr);
+  MS_ERROR_IF_NULL(swap_out_index_addr);
+  auto hash_table = reinterpret_cast<float *>(hash_table_addr);
+  auto swap_out_value = reinterpret_cast<float *>(swap_out_value_addr);
+  auto swap_out_index = reinterpret_cast<int *>(swap_out_index_addr);
+  size_t copy_len = embedding_size * sizeof(float);
+  for (size_t i = 0; i < swap_out_size; ++i) {
+    int index = swap_out_index[i];
+    if (index < 0 || IntToSize(index) >= cache_vocab_size) {
+      MS_LOG(ERROR) << "The swap out index " << index << " is out of the cache size " << cache_vocab_size;
+      return false;
+    }
+    if (memcpy_s(swap_out_value + i * embedding_size, copy_len, hash_table + IntToSize(index) * embedding_size,
+                 copy_len) != EOK) {
+      MS_LOG(ERROR) << "Hash swap out memcpy failed.";
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CPUPsCache::HashSwapIn(void *hash_table_addr, void *swap_in_value_addr, void *swap_in_index_addr,
+                            size_t cache_vocab_size, size_t embedding_size, size_t swap_in_size) {
+  MS_ERROR_IF_NULL(hash_table_addr);
+  MS_ERROR_IF_NULL(swap_in_value_addr);
+  MS_ERROR_IF_NULL(swap_in_index_addr);
+  auto hash_table = reinterpret_cast<float *>(hash_table_addr);
+  auto swap_in_value = reinterpret_cast<float *>(swap_in_value_addr);
+  auto swap_in_index = reinterpret_cast<int *>(swap_in_index_addr);
+  size_t copy_len = embedding_size * sizeof(float);
+  for (size_t i = 0; i < swap_in_size; ++i) {
+    int index = swap_in_index[i];
+    if (index < 0 || IntToSize(index) >= cache_vocab_size) {
+      MS_LOG(ERROR) << "The swap in index " << index << " is out of the cache size " << cache_vocab_size;
+      return false;
+    }
+    if (memcpy_s(hash_table + IntToSize(index) * embedding_size, copy_len, swap_in_value + i * embedding_size,
+                 copy_len) != EOK) {
+      MS_LOG(ERROR) << "Hash swap in memcpy failed.";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace cpu
+}  // namespace ps
+}  // namespace mindspore
@@ -16,8 +16,162 @@
 
 #include "ps/ps_cache/embedding_hash_map.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace mindspore {
 namespace ps {
+namespace {
+constexpr uint64_t kHashMultiplier = 0x9E3779B97F4A7C15ULL;
+constexpr size_t kMinGroupBits = 1;
+constexpr size_t kPrefetchDistance = 8;
+// The keys are rehashed when the used and the erased slots take more than 7/8 of them.
+constexpr size_t kMaxLoadNumerator = 7;
+constexpr size_t kMaxLoadDenominator = 8;
+
+// Bit i of match is set when the key i of the group is id, bit i of empty when it is empty.
+inline void MatchGroup(const int *group, int id, uint32_t *match, uint32_t *empty) {
+#if defined(__SSE2__)
+  __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i *>(group));
+  *match = static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, _mm_set1_epi32(id)))));
+  *empty = static_cast<uint32_t>(
+    _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(keys, _mm_set1_epi32(HashIdIndexMap::kEmptyKey)))));
+#elif defined(__aarch64__) || defined(_M_ARM64)
+  const uint32_t lane_bits[HashIdIndexMap::kIdGroupWidth] = {1, 2, 4, 8};
+  uint32x4_t bits = vld1q_u32(lane_bits);
+  int32x4_t keys = vld1q_s32(group);
+  *match = vaddvq_u32(vandq_u32(vceqq_s32(keys, vdupq_n_s32(id)), bits));
+  *empty = vaddvq_u32(vandq_u32(vceqq_s32(keys, vdupq_n_s32(HashIdIndexMap::kEmptyKey)), bits));
+#else
+  *match = 0;
+  *empty = 0;
+  for (size_t i = 0; i < HashIdIndexMap::kIdGroupWidth; ++i) {
+    *match |= static_cast<uint32_t>(group[i] == id) << i;
+    *empty |= static_cast<uint32_t>(group[i] == HashIdIndexMap::kEmptyKey) << i;
+  }
+#endif
+}
+
+inline size_t LowestBit(uint32_t mask) { return static_cast<size_t>(__builtin_ctz(mask)); }
+}  // namespace
+
+HashIdIndexMap::HashIdIndexMap(size_t capacity) : group_bits_(kMinGroupBits), size_(0), erased_(0) {
+  while ((kIdGroupWidth << group_bits_) < 2 * capacity) {
+    ++group_bits_;
+  }
+  keys_.assign(kIdGroupWidth << group_bits_, kEmptyKey);
+  values_.assign(keys_.size(), INVALID_INDEX_VALUE);
+}
+
+size_t HashIdIndexMap::HomeGroup(int id) const {
+  return static_cast<size_t>((static_cast<uint64_t>(static_cast<uint32_t>(id)) * kHashMultiplier) >>
+                             (sizeof(uint64_t) * CHAR_BIT - group_bits_));
+}
+
+size_t HashIdIndexMap::FindPos(int id) const {
+  if (id <= kErasedKey) {
+    return keys_.size();
+  }
+  size_t group_mask = (static_cast<size_t>(1) << group_bits_) - 1;
+  // There is always an empty slot, as the keys are rehashed before they fill up
+  for (size_t group = HomeGroup(id);; group = (group + 1) & group_mask) {
+    size_t base = group * kIdGroupWidth;
+    uint32_t match;
+    uint32_t empty;
+    MatchGroup(keys_.data() + base, id, &match, &empty);
+    if (match != 0) {
+      return base + LowestBit(match);
+    }
+    if (empty != 0) {
+      return keys_.size();
+    }
+  }
+}
+
+int HashIdIndexMap::Find(int id) const {
+  size_t pos = FindPos(id);
+  return pos == keys_.size() ? INVALID_INDEX_VALUE : values_[pos];
+}
+
+void HashIdIndexMap::Find(const int *ids, size_t ids_size, int *indices) const {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  for (size_t i = 0; i < ids_size; ++i) {
+#if defined(__GNUC__)
+    if (i + kPrefetchDistance < ids_size) {
+      size_t base = HomeGroup(ids[i + kPrefetchDistance]) * kIdGroupWidth;
+      __builtin_prefetch(keys_.data() + base);
+      __builtin_prefetch(values_.data() + base);
+    }
+#endif
+    indices[i] = Find(ids[i]);
+  }
+}
+
+void HashIdIndexMap::Insert(int id, int index) {
+  if (id <= kErasedKey) {
+    MS_LOG(EXCEPTION) << "The id " << id << " is reserved by the hash map.";
+  }
+  if ((size_ + erased_ + 1) * kMaxLoadDenominator > keys_.size() * kMaxLoadNumerator) {
+    bool full = (size_ + 1) * kMaxLoadDenominator > keys_.size() * kMaxLoadNumerator / 2;
+    Rebuild((keys_.size() / kIdGroupWidth) << (full ? 1 : 0));
+  }
+  size_t group_mask = (static_cast<size_t>(1) << group_bits_) - 1;
+  for (size_t group = HomeGroup(id);; group = (group + 1) & group_mask) {
+    size_t base = group * kIdGroupWidth;
+    for (size_t i = base; i < base + kIdGroupWidth; ++i) {
+      if (keys_[i] == kEmptyKey || keys_[i] == kErasedKey) {
+        erased_ -= keys_[i] == kErasedKey ? 1 : 0;
+        keys_[i] = id;
+        values_[i] = index;
+        ++size_;
+        return;
+      }
+    }
+  }
+}
+
+void HashIdIndexMap::Erase(int id) {
+  size_t pos = FindPos(id);
+  if (pos == keys_.size()) {
+    return;
+  }
+  // A probe never passes a group with an empty slot, so in such a group the key can be emptied rather than erased
+  size_t base = pos - pos % kIdGroupWidth;
+  uint32_t match;
+  uint32_t empty;
+  MatchGroup(keys_.data() + base, id, &match, &empty);
+  if (empty != 0) {
+    keys_[pos] = kEmptyKey;
+  } else {
+    keys_[pos] = kErasedKey;
+    ++erased_;
+  }
+  values_[pos] = INVALID_INDEX_VALUE;
+  --size_;
+}
+
+void HashIdIndexMap::Rebuild(size_t group_count) {
+  std::vector<int> keys(group_count * kIdGroupWidth, kEmptyKey);
+  std::vector<int> values(keys.size(), INVALID_INDEX_VALUE);
+  keys_.swap(keys);
+  values_.swap(values);
+  group_bits_ = kMinGroupBits;
+  while ((static_cast<size_t>(1) << group_bits_) < group_count) {
+    ++group_bits_;
+  }
+  size_ = 0;
+  erased_ = 0;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i] > kErasedKey) {
+      Insert(keys[i], values[i]);
+    }
+  }
+}
+
 int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *const swap_out_ids,
                                 const size_t data_step, const size_t graph_running_step, size_t *const swap_out_size,
                                 bool *const need_wait_graph) {
@@ -32,35 +186,65 @@ int EmbeddingHashMap::ParseData(const int id, int *const swap_out_index, int *co
 
   if (!need_swap) {
     hash_count_++;
-    (void)hash_id_to_index_.emplace(id, hash_index);
-    hash_map_elements_[hash_index].set_id(id);
-    hash_map_elements_[hash_index].set_step(data_step);
+    hash_id_to_index_.Insert(id, hash_index);
+    hash_ids_[hash_index] = id;
+    set_hash_step(hash_index, data_step);
     return hash_index;
   }
 
   swap_out_index[*swap_out_size] = hash_index;
-  swap_out_ids[*swap_out_size] = hash_map_elements_[hash_index].id_;
+  swap_out_ids[*swap_out_size] = hash_ids_[hash_index];
   (*swap_out_size)++;
-  (void)hash_id_to_index_.erase(hash_map_elements_[hash_index].id_);
-  (void)hash_id_to_index_.emplace(id, hash_index);
-  hash_map_elements_[hash_index].set_id(id);
-  hash_map_elements_[hash_index].set_step(data_step);
+  hash_id_to_index_.Erase(hash_ids_[hash_index]);
+  hash_id_to_index_.Insert(id, hash_index);
+  hash_ids_[hash_index] = id;
+  set_hash_step(hash_index, data_step);
   return hash_index;
 }
 
+size_t EmbeddingHashMap::FindAndMarkStep(const int *ids, size_t ids_size, size_t data_step, int *hash_index) {
+  hash_id_to_index_.Find(ids, ids_size, hash_index);
+  size_t marked_count = 0;
+  for (size_t i = 0; i < ids_size; ++i) {
+    if (hash_index[i] == INVALID_INDEX_VALUE) {
+      continue;
+    }
+    // The thread which moves the step of an index is the one which counts it
+    auto &step = hash_steps_[hash_index[i]];
+    if (step.load(std::memory_order_relaxed) != data_step &&
+        step.exchange(data_step, std::memory_order_relaxed) != data_step) {
+      ++marked_count;
+    }
+  }
+  return marked_count;
+}
+
+void EmbeddingHashMap::GetHashIdsAndIndices(std::vector<int> *ids, std::vector<int> *indices) const {
+  MS_EXCEPTION_IF_NULL(ids);
+  MS_EXCEPTION_IF_NULL(indices);
+  ids->clear();
+  indices->clear();
+  ids->reserve(hash_id_to_index_.size());
+  indices->reserve(hash_id_to_index_.size());
+  hash_id_to_index_.ForEach([ids, indices](int id, int index) {
+    ids->push_back(id);
+    indices->push_back(index);
+  });
+}
+
 int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_step, bool *const need_swap,
                                        bool *const need_wait_graph) {
   MS_EXCEPTION_IF_NULL(need_swap);
   MS_EXCEPTION_IF_NULL(need_wait_graph);
   int hash_index = INVALID_INDEX_VALUE;
   while (!expired_element_full_) {
-    if (hash_map_elements_[current_pos_].IsEmpty()) {
+    size_t step = hash_step(current_pos_);
+    if (step == INVALID_STEP_VALUE) {
       hash_index = current_pos_;
-      hash_count_++;
-    } else if (hash_map_elements_[current_pos_].IsExpired(graph_running_step)) {
+    } else if (graph_running_step > step) {
       hash_index = current_pos_;
       *need_swap = true;
-    } else if (hash_map_elements_[current_pos_].IsStep(graph_running_step)) {
+    } else if (step == graph_running_step) {
       graph_running_index_[graph_running_index_num_++] = current_pos_;
     }
     current_pos_ = (current_pos_ + 1) % hash_capacity_;
@@ -85,14 +269,11 @@ int EmbeddingHashMap::FindInsertionPos(const size_t, const size_t graph_running_
 void EmbeddingHashMap::DumpHashMap() {
   MS_LOG(INFO) << "Dump hash map info begin, hash_capacity: " << hash_capacity_ << " hash_count: " << hash_count_;
   MS_LOG(INFO) << "Dump hash_id_to_index: ";
-  for (auto iter = hash_id_to_index_.begin(); iter != hash_id_to_index_.end(); ++iter) {
-    MS_LOG(INFO) << "  id: " << iter->first << " index: " << iter->second;
-  }
+  hash_id_to_index_.ForEach([](int id, int index) { MS_LOG(INFO) << "  id: " << id << " index: " << index; });
   MS_LOG(INFO) << "Dump hash_map_unit: ";
-  for (size_t i = 0; i < hash_map_elements_.size(); i++) {
-    if (!hash_map_elements_[i].IsEmpty()) {
-      MS_LOG(INFO) << "  index: " << i << " id: " << hash_map_elements_[i].id_
-                   << " step: " << hash_map_elements_[i].step_;
+  for (size_t i = 0; i < hash_capacity_; i++) {
+    if (hash_step(i) != INVALID_STEP_VALUE) {
+      MS_LOG(INFO) << "  index: " << i << " id: " << hash_ids_[i] << " step: " << hash_step(i);
     }
   }
   MS_LOG(INFO) << "Dump hash map info end.";
@@ -18,10 +18,11 @@
 #define MINDSPORE_CCSRC_PS_PS_CACHE_EMBEDDING_HASH_MAP_H_
 
 #include <math.h>
+#include <atomic>
+#include <climits>
 #include <utility>
 #include <memory>
 #include <vector>
-#include <unordered_map>
 #include "utils/convert_utils_base.h"
 
 namespace mindspore {
@@ -29,41 +30,91 @@ namespace ps {
 static const size_t INVALID_STEP_VALUE = 0;
 static const int INVALID_INDEX_VALUE = -1;
 
-struct HashMapElement {
-  int id_{INVALID_INDEX_VALUE};
-  size_t step_{INVALID_STEP_VALUE};
-  bool IsEmpty() const { return step_ == INVALID_STEP_VALUE; }
-  bool IsExpired(size_t graph_running_step) const { return graph_running_step > step_; }
-  bool IsStep(size_t step) const { return step_ == step; }
-  void set_id(int id) { id_ = id; }
-  void set_step(size_t step) { step_ = step; }
+// Open addressing map from the ids to their index in the hash table. The keys and the values are kept in separate
+// arrays, the keys are probed by groups of kIdGroupWidth which are compared at once.
+class HashIdIndexMap {
+ public:
+  // The two smallest ints mark the empty and the erased keys, they can not be inserted.
+  static constexpr int kEmptyKey = INT_MIN;
+  static constexpr int kErasedKey = INT_MIN + 1;
+  static constexpr size_t kIdGroupWidth = 4;
+
+  // Sized for capacity ids at a load of at most a half.
+  explicit HashIdIndexMap(size_t capacity);
+  ~HashIdIndexMap() = default;
+
+  // Return INVALID_INDEX_VALUE if the id is not in the map.
+  int Find(int id) const;
+  // Find a batch of ids, the groups of the ids ahead are prefetched while the current one is probed.
+  void Find(const int *ids, size_t ids_size, int *indices) const;
+  // The id should not be in the map.
+  void Insert(int id, int index);
+  void Erase(int id);
+  size_t size() const { return size_; }
+
+  template <typename Func>
+  void ForEach(Func func) const {
+    for (size_t i = 0; i < keys_.size(); ++i) {
+      if (keys_[i] > kErasedKey) {
+        func(keys_[i], values_[i]);
+      }
+    }
+  }
+
+ private:
+  size_t HomeGroup(int id) const;
+  // Position of the id in keys_, or keys_.size() if it is not in the map
+  size_t FindPos(int id) const;
+  // Rehash into group_count groups, which drops the erased keys.
+  void Rebuild(size_t group_count);
+
+  size_t group_bits_;
+  std::vector<int> keys_;
+  std::vector<int> values_;
+  size_t size_;
+  size_t erased_;
 };
 
 // Hash table is held in device, HashMap is used to manage hash table in host.
+// The id and the step of each index of the hash table are kept in separate arrays, so the eviction scans only read
+// the steps. The steps are atomic: FindAndMarkStep may run in several threads at once while nothing is inserted.
 class EmbeddingHashMap {
  public:
   EmbeddingHashMap(size_t hash_count, size_t hash_capacity)
       : hash_count_(hash_count),
         hash_capacity_(hash_capacity),
+        hash_ids_(hash_capacity, INVALID_INDEX_VALUE),
+        hash_steps_(std::make_unique<std::atomic<size_t>[]>(hash_capacity)),
+        hash_id_to_index_(hash_capacity),
         current_pos_(0),
         current_batch_start_pos_(0),
         graph_running_index_num_(0),
         graph_running_index_pos_(0),
         expired_element_full_(false) {
-    hash_map_elements_.resize(hash_capacity);
+    for (size_t i = 0; i < hash_capacity; ++i) {
+      hash_steps_[i].store(INVALID_STEP_VALUE, std::memory_order_relaxed);
+    }
     // In multi-device mode, embedding table are distributed on different devices by ID interval,
     // and IDs outside the range of local device will use the front and back positions of the table,
     // the positions are reserved for this.
-    hash_map_elements_.front().set_step(SIZE_MAX);
-    hash_map_elements_.back().set_step(SIZE_MAX);
+    hash_steps_[0].store(SIZE_MAX, std::memory_order_relaxed);
+    hash_steps_[hash_capacity - 1].store(SIZE_MAX, std::memory_order_relaxed);
     graph_running_index_ = std::make_unique<int[]>(hash_capacity);
   }
   virtual ~EmbeddingHashMap() = default;
   int ParseData(const int id, int *const swap_out_index, int *const swap_out_ids, const size_t data_step,
                 const size_t graph_running_step, size_t *const swap_out_size, bool *const need_wait_graph);
-  size_t hash_step(const int hash_index) const { return hash_map_elements_[hash_index].step_; }
-  void set_hash_step(const int hash_index, const size_t step) { hash_map_elements_[hash_index].set_step(step); }
-  const std::unordered_map<int, int> &hash_id_to_index() const { return hash_id_to_index_; }
+  // Find the hash indices of a batch of ids, INVALID_INDEX_VALUE for the ids not in the map, and mark the indices
+  // found as used by data_step. Return how many indices were marked, each is counted once however often its id comes.
+  size_t FindAndMarkStep(const int *ids, size_t ids_size, size_t data_step, int *hash_index);
+  int FindHashIndex(const int id) const { return hash_id_to_index_.Find(id); }
+  size_t hash_step(const int hash_index) const { return hash_steps_[hash_index].load(std::memory_order_relaxed); }
+  void set_hash_step(const int hash_index, const size_t step) {
+    hash_steps_[hash_index].store(step, std::memory_order_relaxed);
+  }
+  // The number of ids in the hash table.
+  size_t hash_id_count() const { return hash_id_to_index_.size(); }
+  void GetHashIdsAndIndices(std::vector<int> *ids, std::vector<int> *indices) const;
   size_t hash_capacity() const { return hash_capacity_; }
   void DumpHashMap();
   void Reset();
@@ -71,10 +122,12 @@ class EmbeddingHashMap {
  private:
   int FindInsertionPos(const size_t data_step, const size_t graph_running_step, bool *const need_swap,
                        bool *const need_wait_graph);
+  // The number of indices taken by an id, counted by ParseData when it fills an empty index.
   size_t hash_count_;
   size_t hash_capacity_;
-  std::vector<HashMapElement> hash_map_elements_;
-  std::unordered_map<int, int> hash_id_to_index_;
+  std::vector<int> hash_ids_;
+  std::unique_ptr<std::atomic<size_t>[]> hash_steps_;
+  HashIdIndexMap hash_id_to_index_;
   size_t current_pos_;
   size_t current_batch_start_pos_;
   size_t graph_running_index_num_;
@@ -15,6 +15,8 @@
  */
 
 #include <algorithm>
+#include <chrono>
+#include <future>
 #include "ps/ps_cache/ps_cache_manager.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
@@ -149,6 +151,9 @@ void PsCacheManager::Initialize() {
   }
   embedding_device_cache_ = std::make_shared<EmbeddingDeviceCache>(batch_elements_, vocab_cache_size_);
   embedding_host_cache_ = std::make_shared<EmbeddingHostCache>(batch_elements_, host_vocab_cache_size_);
+  cache_prefetch_depth_ = PSContext::instance()->cache_prefetch_depth();
+  MS_LOG(INFO) << "PS cache prefetch depth:" << cache_prefetch_depth_;
+  server_pull_executor_ = std::make_shared<core::TaskExecutor>(1);
   AddEmbeddingTable();
   AllocMemForHashTable();
   SetLocalIdRank();
@@ -301,12 +306,31 @@ void PsCacheManager::IncreaseGraphStep(const std::string &channel_name) {
     }
     MS_LOG(INFO) << "Graph running waiting embedding table init end.";
   }
-  graph_step_++;
+  // The graph takes one batch per step from the device queue, in the order the batches are parsed, so graph step N
+  // runs on the batch of data step N. PushSwapTask checks that the data steps are pushed in that order.
+  size_t data_step = 0;
+  {
+    std::lock_guard<std::mutex> locker(data_mutex_);
+    graph_step_++;
+    data_step = graph_step_;
+  }
   set_channel_name(channel_name);
   if (!PsDataPrefetch::GetInstance().TryWakeChannel(channel_name)) {
     MS_LOG(EXCEPTION) << "TryWakeChannel failed, channel name: " << channel_name;
   }
-  data_prase_.notify_one();
+  // Both the parse and the swaps of the data may wait for the graph step.
+  data_prase_.notify_all();
+  // The batch of this step may be sent on before the rows it misses are swapped in.
+  auto start_time = std::chrono::steady_clock::now();
+  bool stalled = false;
+  if (!WaitSwapTaskFinish(data_step, &stalled)) {
+    MS_LOG(EXCEPTION) << "PS embedding cache data processing thread isn't running.";
+  }
+  if (stalled) {
+    prefetch_stall_count_++;
+    prefetch_stall_time_us_ += static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start_time).count());
+  }
 }
 
 void PsCacheManager::DoProcessData(uint32_t device_id, const void *context) {
@@ -324,25 +348,50 @@ void PsCacheManager::ProcessDataTask(uint32_t device_id, const void *context) {
   embedding_device_cache_->cache_->InitDevice(device_id, context);
   InitParameterServer();
   InitDataChannel();
+  // The device is set for this thread, so it does the swaps while another thread parses the batches ahead.
+  parse_data_thread_ = std::thread(&PsCacheManager::ParseDataTask, this);
   while (running_) {
-    if (!ProcessData()) {
-      running_ = false;
+    if (!ProcessSwapTask()) {
+      StopSwapTasks();
     }
   }
   MS_LOG(INFO) << "PS embedding cache process data task end.";
 }
 
+void PsCacheManager::ParseDataTask() {
+  MS_LOG(INFO) << "PS embedding cache parse data task begin.";
+  while (running_) {
+    if (!ProcessData()) {
+      StopSwapTasks();
+    }
+  }
+  MS_LOG(INFO) << "PS embedding cache parse data task end.";
+}
+
 void PsCacheManager::Finalize() {
   if (running_) {
     SyncEmbeddingTable();
   }
-  running_ = false;
+  StopSwapTasks();
   PsDataPrefetch::GetInstance().NotifyFinalize();
   insert_init_info_.notify_all();
   data_prase_.notify_all();
   if (process_data_thread_.joinable()) {
     process_data_thread_.join();
   }
+  if (parse_data_thread_.joinable()) {
+    parse_data_thread_.join();
+  }
+  server_pull_executor_ = nullptr;
+}
+
+void PsCacheManager::StopSwapTasks() {
+  {
+    std::lock_guard<std::mutex> locker(swap_mutex_);
+    running_ = false;
+  }
+  swap_task_cond_.notify_all();
+  swap_finish_cond_.notify_all();
 }
 
 bool PsCacheManager::ProcessData() {
@@ -376,25 +425,16 @@ bool PsCacheManager::ProcessData() {
   // Get hash swap in/out index and ids.
   RETURN_IF_FALSE(ParseData(batch_ids, batch_ids_len, hash_index.get()));
   DumpStatisticsInfo();
-  if ((device_need_wait_graph_ || host_need_wait_graph_) && (!WaitGraphRun())) {
-    MS_LOG(ERROR) << "Ps cache wait graph finish failed.";
-    return false;
-  }
-  for (const auto &item : hash_tables_) {
-    auto key = Worker::GetInstance().GetParamKey(item.first);
-    auto hash_info = item.second;
-    RETURN_IF_FALSE(HashSwapHostToServer(key, hash_info));
-    RETURN_IF_FALSE(HashSwapDeviceToHost(hash_info));
-    RETURN_IF_FALSE(HashSwapServerToHost(key, hash_info));
-    RETURN_IF_FALSE(HashSwapHostToDevice(hash_info));
-  }
+  auto swap_task = std::make_shared<PsCacheSwapTask>();
+  RETURN_IF_FALSE(CreateSwapTask(swap_task.get()));
+  // The graph step of this batch waits for the swaps, the batch goes on to the device queue now.
+  RETURN_IF_FALSE(PushSwapTask(swap_task));
   size_t dest_len = data_size;
   // Replace the batch_ids by hash index for getNext-op getting hash index as input.
   if (memcpy_s(data, dest_len, hash_index.get(), data_size) != EOK) {
     MS_LOG(ERROR) << "Process data memcpy failed.";
     return false;
   }
-  RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeStream());
   // Finish the data process and notify data prefetch.
   RETURN_IF_FALSE(PsDataPrefetch::GetInstance().FinalizeData(channel_name_));
   (void)gettimeofday(&end_time, nullptr);
@@ -407,6 +447,122 @@ bool PsCacheManager::ProcessData() {
   return true;
 }
 
+bool PsCacheManager::CreateSwapTask(PsCacheSwapTask *swap_task) {
+  MS_ERROR_IF_NULL(swap_task);
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  MS_ERROR_IF_NULL(embedding_host_cache_);
+  swap_task->data_step = data_step_;
+  swap_task->need_wait_graph = device_need_wait_graph_ || host_need_wait_graph_;
+  swap_task->graph_running_step = graph_running_step_;
+  auto copy_swap_indices = [](const std::unique_ptr<int[]> &indices, size_t size, std::vector<int> *task_indices) {
+    task_indices->assign(indices.get(), indices.get() + size);
+  };
+  const auto &device_cache = *embedding_device_cache_;
+  const auto &host_cache = *embedding_host_cache_;
+  copy_swap_indices(device_cache.device_to_host_index, statistics_info_.device_to_host_size_,
+                    &swap_task->device_cache_device_to_host_index);
+  copy_swap_indices(host_cache.device_to_host_index, statistics_info_.device_to_host_size_,
+                    &swap_task->host_cache_device_to_host_index);
+  copy_swap_indices(host_cache.host_to_device_index, statistics_info_.host_to_device_size_,
+                    &swap_task->host_cache_host_to_device_index);
+  copy_swap_indices(device_cache.host_to_device_index, statistics_info_.host_to_device_size_,
+                    &swap_task->device_cache_host_to_device_index);
+  copy_swap_indices(host_cache.host_to_server_index, statistics_info_.host_to_server_size_,
+                    &swap_task->host_to_server_index);
+  copy_swap_indices(host_cache.host_to_server_ids, statistics_info_.host_to_server_size_,
+                    &swap_task->host_to_server_ids);
+  copy_swap_indices(host_cache.server_to_host_index, statistics_info_.server_to_host_size_,
+                    &swap_task->server_to_host_index);
+  copy_swap_indices(host_cache.server_to_host_ids, statistics_info_.server_to_host_size_,
+                    &swap_task->server_to_host_ids);
+  return true;
+}
+
+bool PsCacheManager::PushSwapTask(const std::shared_ptr<PsCacheSwapTask> &swap_task) {
+  MS_ERROR_IF_NULL(swap_task);
+  {
+    std::unique_lock<std::mutex> locker(swap_mutex_);
+    swap_task_cond_.wait(locker, [this] { return swap_tasks_.size() < cache_prefetch_depth_ || !running_; });
+    if (!running_) {
+      return false;
+    }
+    if (swap_task->data_step != swap_task_step_ + 1) {
+      MS_LOG(ERROR) << "The swap task of data step " << swap_task->data_step << " does not follow the one of data step "
+                    << swap_task_step_ << ".";
+      return false;
+    }
+    swap_tasks_.push(swap_task);
+    swap_task_step_ = swap_task->data_step;
+  }
+  swap_task_cond_.notify_all();
+  return true;
+}
+
+bool PsCacheManager::ProcessSwapTask() {
+  std::shared_ptr<PsCacheSwapTask> swap_task;
+  {
+    std::unique_lock<std::mutex> locker(swap_mutex_);
+    swap_task_cond_.wait(locker, [this] { return !swap_tasks_.empty() || !running_; });
+    if (!running_) {
+      return true;
+    }
+    swap_task = swap_tasks_.front();
+  }
+  RETURN_IF_FALSE(SwapData(*swap_task));
+  // The task leaves the queue once finished, so the queue holds the batches parsed ahead of their swaps.
+  {
+    std::lock_guard<std::mutex> locker(swap_mutex_);
+    swap_tasks_.pop();
+    finish_swap_step_ = swap_task->data_step;
+  }
+  swap_task_cond_.notify_all();
+  swap_finish_cond_.notify_all();
+  return true;
+}
+
+bool PsCacheManager::WaitSwapTaskFinish(size_t data_step, bool *stalled) {
+  MS_ERROR_IF_NULL(stalled);
+  std::unique_lock<std::mutex> locker(swap_mutex_);
+  *stalled = finish_swap_step_ < data_step;
+  swap_finish_cond_.wait(locker, [this, data_step] { return finish_swap_step_ >= data_step || !running_; });
+  return finish_swap_step_ >= data_step;
+}
+
+bool PsCacheManager::SwapData(const PsCacheSwapTask &swap_task) {
+  MS_ERROR_IF_NULL(embedding_device_cache_);
+  MS_ERROR_IF_NULL(embedding_device_cache_->cache_);
+  MS_ERROR_IF_NULL(server_pull_executor_);
+  if (swap_task.need_wait_graph) {
+    MS_LOG(INFO) << "The swaps of data step " << swap_task.data_step << " wait until the graph runs past step "
+                 << swap_task.graph_running_step << ".";
+    if (!WaitGraphStep(swap_task.graph_running_step)) {
+      MS_LOG(ERROR) << "Ps cache wait graph finish failed.";
+      return false;
+    }
+  }
+  for (const auto &item : hash_tables_) {
+    auto key = Worker::GetInstance().GetParamKey(item.first);
+    const auto &hash_info = item.second;
+    RETURN_IF_FALSE(HashSwapHostToServer(key, hash_info, swap_task));
+    // The rows pulled from the server and the rows swapped out of the device go to different rows of the host
+    // cache, so the pull runs on the executor while this thread, which the device is set for, swaps out.
+    auto server_to_host_ret = std::make_shared<std::promise<bool>>();
+    auto server_to_host_future = server_to_host_ret->get_future();
+    if (!server_pull_executor_->Submit([this, key, &hash_info, &swap_task, server_to_host_ret]() {
+          server_to_host_ret->set_value(HashSwapServerToHost(key, hash_info, swap_task));
+        })) {
+      MS_LOG(ERROR) << "Submit the swap from the server to the host failed.";
+      return false;
+    }
+    bool device_to_host_ret = HashSwapDeviceToHost(hash_info, swap_task);
+    bool server_to_host_finished = server_to_host_future.get();
+    RETURN_IF_FALSE(device_to_host_ret && server_to_host_finished);
+    RETURN_IF_FALSE(HashSwapHostToDevice(hash_info, swap_task));
+  }
+  RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeStream());
+  return true;
+}
+
 bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const size_t batch_ids_len, int *hash_index,
                                                  bool *in_device, bool *out_range, size_t *hash_hit_count) {
   MS_ERROR_IF_NULL(batch_ids);
@@ -416,8 +572,9 @@ bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const siz
   MS_ERROR_IF_NULL(embedding_device_cache_);
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
 
+  // The ids out of the range of the local device are never in the hash map, they are not found
+  *hash_hit_count += device_hash_map->FindAndMarkStep(batch_ids, batch_ids_len, data_step_, hash_index);
   for (size_t i = 0; i < batch_ids_len; ++i) {
     if (batch_ids[i] < emb_table_slice_bounds_.first) {
       hash_index[i] = batch_ids[i] - vocab_cache_size_diff_;
@@ -429,13 +586,8 @@ bool PsCacheManager::CheckCacheHitOrOutRangeTask(const int *batch_ids, const siz
       out_range[i] = true;
       continue;
     }
-    auto iter = hash_id_to_index.find(batch_ids[i]);
-    if (iter != hash_id_to_index.end()) {
-      hash_index[i] = iter->second + cache_indices_bounds_.first;
-      if (device_hash_map->hash_step(iter->second) != data_step_) {
-        ++(*hash_hit_count);
-        device_hash_map->set_hash_step(iter->second, data_step_);
-      }
+    if (hash_index[i] != INVALID_INDEX_VALUE) {
+      hash_index[i] += cache_indices_bounds_.first;
       in_device[i] = true;
     }
   }
@@ -528,16 +680,21 @@ bool PsCacheManager::ParseData(const int *batch_ids, const size_t batch_ids_len,
 
 bool PsCacheManager::WaitGraphRun() {
   MS_LOG(INFO) << "Hash table has no space to insert new data and retries within 2 minutes.";
+  RETURN_IF_FALSE(WaitGraphStep(graph_running_step_));
+  set_current_graph_step();
+  return true;
+}
+
+bool PsCacheManager::WaitGraphStep(size_t graph_step) {
   std::unique_lock<std::mutex> locker(data_mutex_);
   const int64_t longest_time_to_wait = 120;
   if (!data_prase_.wait_for(locker, std::chrono::seconds(longest_time_to_wait),
-                            [this] { return graph_step_ > graph_running_step_; })) {
+                            [this, graph_step] { return graph_step_ > graph_step || running_ == false; })) {
     MS_LOG(ERROR) << "Ps cache data parse timeout, suggest to enlarge the cache size(graph step:" << graph_step_
-                  << ", graph running step:" << graph_running_step_ << ").";
+                  << ", graph running step:" << graph_step << ").";
     return false;
   }
-  set_current_graph_step();
-  return true;
+  return running_;
 }
 
 bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host, bool *need_swap_host_to_device,
@@ -549,13 +706,10 @@ bool PsCacheManager::ParseDeviceData(size_t id, bool *need_swap_device_to_host,
   auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
 
-  int index = INVALID_INDEX_VALUE;
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
+  int index = device_hash_map->FindHashIndex(SizeToInt(id));
+  if (index != INVALID_INDEX_VALUE) {
     *need_swap_device_to_host = false;
     *need_swap_host_to_device = false;
-    index = iter->second;
     if (device_hash_map->hash_step(index) != data_step_) {
       statistics_info_.hash_hit_count_++;
       device_hash_map->set_hash_step(index, data_step_);
@@ -595,10 +749,8 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
 
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->FindHashIndex(SizeToInt(id));
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
@@ -611,9 +763,8 @@ bool PsCacheManager::ParseHostDataHostToDevice(size_t id) {
     MS_ERROR_IF_NULL(server_to_host_index);
     MS_ERROR_IF_NULL(server_to_host_ids);
     while (true) {
-      auto index =
-        host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
-                                 &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(id, host_to_server_index, host_to_server_ids, data_step_, graph_running_step_,
+                                       &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -637,10 +788,8 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
   auto &host_hash_map = embedding_host_cache_->host_hash_map_;
   MS_ERROR_IF_NULL(host_hash_map);
   int swap_device_to_host_id = device_to_host_ids[statistics_info_.device_to_host_size_ - 1];
-  const auto &hash_id_to_index = host_hash_map->hash_id_to_index();
-  const auto &iter = hash_id_to_index.find(swap_device_to_host_id);
-  if (iter != hash_id_to_index.end()) {
-    auto index = iter->second;
+  auto index = host_hash_map->FindHashIndex(swap_device_to_host_id);
+  if (index != INVALID_INDEX_VALUE) {
     if (host_hash_map->hash_step(index) != data_step_) {
       host_hash_map->set_hash_step(index, data_step_);
     }
@@ -649,9 +798,9 @@ bool PsCacheManager::ParseHostDataDeviceToHost() {
     int *host_to_server_index = embedding_host_cache_->host_to_server_index.get();
     int *host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
     while (true) {
-      auto index =
-        host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
-                                 graph_running_step_, &statistics_info_.host_to_server_size_, &host_need_wait_graph_);
+      index = host_hash_map->ParseData(swap_device_to_host_id, host_to_server_index, host_to_server_ids, data_step_,
+                                       graph_running_step_, &statistics_info_.host_to_server_size_,
+                                       &host_need_wait_graph_);
       if (index == INVALID_INDEX_VALUE) {
         RETURN_IF_FALSE(WaitGraphRun());
         continue;
@@ -767,13 +916,12 @@ bool PsCacheManager::InsertHostHashTable(size_t embedding_size, size_t insert_in
   return running_;
 }
 
-bool PsCacheManager::HashSwapHostToDevice(const HashTableInfo &hash_info) {
+bool PsCacheManager::HashSwapHostToDevice(const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task) {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   MS_ERROR_IF_NULL(embedding_device_cache_->cache_);
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto host_cache_host_to_device_index = embedding_host_cache_->host_to_device_index.get();
-  auto device_cache_host_to_device_index = embedding_device_cache_->host_to_device_index.get();
-  auto swap_indices_size = statistics_info_.host_to_device_size_;
+  auto host_cache_host_to_device_index = swap_task.host_cache_host_to_device_index.data();
+  auto device_cache_host_to_device_index = swap_task.device_cache_host_to_device_index.data();
+  auto swap_indices_size = swap_task.host_cache_host_to_device_index.size();
   if (swap_indices_size == 0) {
     return true;
   }
@@ -797,13 +945,12 @@ bool PsCacheManager::HashSwapHostToDevice(const HashTableInfo &hash_info) {
   return true;
 }
 
-bool PsCacheManager::HashSwapDeviceToHost(const HashTableInfo &hash_info) {
+bool PsCacheManager::HashSwapDeviceToHost(const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task) {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   MS_ERROR_IF_NULL(embedding_device_cache_->cache_);
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto swap_indices_size = statistics_info_.device_to_host_size_;
-  auto device_cache_device_to_host_index = embedding_device_cache_->device_to_host_index.get();
-  auto host_cache_device_to_host_index = embedding_host_cache_->device_to_host_index.get();
+  auto swap_indices_size = swap_task.device_cache_device_to_host_index.size();
+  auto device_cache_device_to_host_index = swap_task.device_cache_device_to_host_index.data();
+  auto host_cache_device_to_host_index = swap_task.host_cache_device_to_host_index.data();
   if (swap_indices_size == 0) {
     return true;
   }
@@ -822,16 +969,16 @@ bool PsCacheManager::HashSwapDeviceToHost(const HashTableInfo &hash_info) {
     swap_out_data.get(), embedding_device_cache_->hash_swap_value_addr_,
     swap_indices_size * embedding_size * sizeof(float)));
   RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeStream());
-  RETURN_IF_FALSE(InsertHostHashTable(embedding_size, IntToSize(swap_indices_size), host_cache_device_to_host_index,
+  RETURN_IF_FALSE(InsertHostHashTable(embedding_size, swap_indices_size, host_cache_device_to_host_index,
                                       swap_out_data.get(), host_hash_table_addr));
   return true;
 }
 
-bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_info) {
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto host_to_server_ids = embedding_host_cache_->host_to_server_ids.get();
-  auto host_to_server_index = embedding_host_cache_->host_to_server_index.get();
-  auto swap_indices_size = statistics_info_.host_to_server_size_;
+bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_info,
+                                          const PsCacheSwapTask &swap_task) {
+  auto host_to_server_ids = swap_task.host_to_server_ids.data();
+  auto host_to_server_index = swap_task.host_to_server_index.data();
+  auto swap_indices_size = swap_task.host_to_server_ids.size();
   if (swap_indices_size == 0) {
     return true;
   }
@@ -854,11 +1001,11 @@ bool PsCacheManager::HashSwapHostToServer(size_t key, const HashTableInfo &hash_
   return true;
 }
 
-bool PsCacheManager::HashSwapServerToHost(size_t key, const HashTableInfo &hash_info) {
-  MS_ERROR_IF_NULL(embedding_host_cache_);
-  auto swap_indices_size = statistics_info_.server_to_host_size_;
-  auto server_to_host_ids = embedding_host_cache_->server_to_host_ids.get();
-  auto server_to_host_index = embedding_host_cache_->server_to_host_index.get();
+bool PsCacheManager::HashSwapServerToHost(size_t key, const HashTableInfo &hash_info,
+                                          const PsCacheSwapTask &swap_task) {
+  auto swap_indices_size = swap_task.server_to_host_ids.size();
+  auto server_to_host_ids = swap_task.server_to_host_ids.data();
+  auto server_to_host_index = swap_task.server_to_host_index.data();
   if (swap_indices_size == 0) {
     return true;
   }
@@ -874,7 +1021,7 @@ bool PsCacheManager::HashSwapServerToHost(size_t key, const HashTableInfo &hash_
     return false;
   }
   Worker::GetInstance().DoPSEmbeddingLookup(key, lookup_ids, &lookup_result, mindspore::ps::kEmbeddingLookupCmd);
-  RETURN_IF_FALSE(InsertHostHashTable(embedding_size, IntToSize(swap_indices_size), server_to_host_index,
+  RETURN_IF_FALSE(InsertHostHashTable(embedding_size, swap_indices_size, server_to_host_index,
                                       lookup_result.data(), host_hash_table_addr));
   return true;
 }
@@ -971,6 +1118,16 @@ void PsCacheManager::SyncEmbeddingTable() {
   if (!initialized_ps_cache_) {
     return;
   }
+  // The hash maps are ahead of the tables until the swaps parsed are finished.
+  size_t swap_task_step = 0;
+  {
+    std::lock_guard<std::mutex> locker(swap_mutex_);
+    swap_task_step = swap_task_step_;
+  }
+  bool stalled = false;
+  if (!WaitSwapTaskFinish(swap_task_step, &stalled)) {
+    MS_LOG(WARNING) << "The swaps until data step " << swap_task_step << " are not finished.";
+  }
   if (!SyncHostEmbeddingTable()) {
     MS_LOG(ERROR) << "SyncHostEmbeddingTable failed.";
   }
@@ -983,20 +1140,13 @@ void PsCacheManager::SyncEmbeddingTable() {
 bool PsCacheManager::SyncHostEmbeddingTable() {
   MS_ERROR_IF_NULL(embedding_host_cache_);
   MS_ERROR_IF_NULL(embedding_host_cache_->host_hash_map_);
-  const auto &hash_id_to_index = embedding_host_cache_->host_hash_map_->hash_id_to_index();
-  size_t swap_indices_lens = hash_id_to_index.size();
+  std::vector<int> host_to_server_ids;
+  std::vector<int> host_to_server_indices;
+  embedding_host_cache_->host_hash_map_->GetHashIdsAndIndices(&host_to_server_ids, &host_to_server_indices);
+  size_t swap_indices_lens = host_to_server_ids.size();
   if (swap_indices_lens == 0) {
     return true;
   }
-  std::unique_ptr<int[]> host_to_server_ids_ptr = std::make_unique<int[]>(swap_indices_lens);
-  MS_ERROR_IF_NULL(host_to_server_ids_ptr);
-  std::unique_ptr<int[]> host_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
-  MS_ERROR_IF_NULL(host_to_server_indices_ptr);
-  size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    host_to_server_ids_ptr[idx] = item.first;
-    host_to_server_indices_ptr[idx++] = item.second;
-  }
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1010,11 +1160,11 @@ bool PsCacheManager::SyncHostEmbeddingTable() {
     auto host_hash_table_addr = hash_info.host_address.get();
     MS_ERROR_IF_NULL(host_hash_table_addr);
     RETURN_IF_FALSE(LookUpHostHashTable(embedding_size, swap_indices_lens, host_hash_table_addr,
-                                        host_to_server_indices_ptr.get(), swap_out_data.data()));
+                                        host_to_server_indices.data(), swap_out_data.data()));
 
     size_t copy_len = swap_indices_lens * sizeof(int);
     size_t dest_len = copy_len;
-    auto ret = memcpy_s(lookup_ids.data(), dest_len, host_to_server_ids_ptr.get(), copy_len);
+    auto ret = memcpy_s(lookup_ids.data(), dest_len, host_to_server_ids.data(), copy_len);
     if (ret != EOK) {
       MS_LOG(ERROR) << "Lookup id memcpy failed.";
       return false;
@@ -1028,20 +1178,13 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
   MS_ERROR_IF_NULL(embedding_device_cache_);
   const auto &device_hash_map = embedding_device_cache_->device_hash_map_;
   MS_ERROR_IF_NULL(device_hash_map);
-  const auto &hash_id_to_index = device_hash_map->hash_id_to_index();
-  size_t swap_indices_lens = hash_id_to_index.size();
+  std::vector<int> device_to_server_ids;
+  std::vector<int> device_to_server_indices;
+  device_hash_map->GetHashIdsAndIndices(&device_to_server_ids, &device_to_server_indices);
+  size_t swap_indices_lens = device_to_server_ids.size();
   if (swap_indices_lens == 0) {
     return true;
   }
-  std::unique_ptr<int[]> device_to_server_ids_ptr = std::make_unique<int[]>(swap_indices_lens);
-  MS_ERROR_IF_NULL(device_to_server_ids_ptr);
-  std::unique_ptr<int[]> device_to_server_indices_ptr = std::make_unique<int[]>(swap_indices_lens);
-  MS_ERROR_IF_NULL(device_to_server_indices_ptr);
-  size_t idx = 0;
-  for (const auto &item : hash_id_to_index) {
-    device_to_server_ids_ptr[idx] = item.first;
-    device_to_server_indices_ptr[idx++] = item.second;
-  }
   for (const auto &item : hash_tables_) {
     const auto &hash_info = item.second;
     if (hash_info.param_init_info_.param_type_ != kWeight) {
@@ -1063,11 +1206,11 @@ bool PsCacheManager::SyncDeviceEmbeddingTable() {
                                                                          hash_table_addr, hash_table_size));
     RETURN_IF_FALSE(embedding_device_cache_->cache_->SynchronizeStream());
     RETURN_IF_FALSE(LookUpHostHashTable(embedding_size, swap_indices_lens, device_hash_table_addr_tmp.get(),
-                                        device_to_server_indices_ptr.get(), swap_out_data.data()));
+                                        device_to_server_indices.data(), swap_out_data.data()));
 
     size_t copy_len = swap_indices_lens * sizeof(int);
     size_t dest_len = copy_len;
-    auto ret = memcpy_s(lookup_ids.data(), dest_len, device_to_server_ids_ptr.get(), copy_len);
+    auto ret = memcpy_s(lookup_ids.data(), dest_len, device_to_server_ids.data(), copy_len);
     if (ret != EOK) {
       MS_LOG(ERROR) << "Lookup id memcpy failed.";
       return false;
@@ -1109,6 +1252,7 @@ void PsCacheManager::DumpHashTables(bool dump_device_tables) const {
 void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
   // Default each 1000 step prints ps cache hit rate.
   const size_t kFloatToPercentSign = 100;
+  const uint64_t kUSecondInMSecond = 1000;
   if (data_step_ % each_print_step == 0) {
     statistics_info_.batch_id_unique_count_ = statistics_info_.hash_hit_count_ + statistics_info_.host_to_device_size_;
     auto repeat_rate = SizeToFloat(statistics_info_.batch_id_count_ - statistics_info_.batch_id_unique_count_) /
@@ -1124,7 +1268,9 @@ void PsCacheManager::DumpStatisticsInfo(size_t each_print_step) {
                  << ", server swap to host num:" << statistics_info_.server_to_host_size_
                  << ", data repeat rate:" << (repeat_rate * kFloatToPercentSign)
                  << "%, device cache hit rate:" << (device_hit_rate * kFloatToPercentSign)
-                 << "%, host cache hit rate:" << (host_hit_rate * kFloatToPercentSign) << ").";
+                 << "%, host cache hit rate:" << (host_hit_rate * kFloatToPercentSign)
+                 << "%, prefetch stall num:" << prefetch_stall_count_
+                 << ", prefetch stall time:" << (prefetch_stall_time_us_ / kUSecondInMSecond) << "ms).";
   }
 }
 }  // namespace ps
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_PS_PS_CACHE_PS_CACHE_MANAGER_H_
 
 #include <map>
+#include <queue>
 #include <string>
 #include <vector>
 #include <thread>
@@ -32,6 +33,7 @@
 #include "ps/constants.h"
 #include "ps/worker.h"
 #include "ps/ps_context.h"
+#include "ps/core/communicator/task_executor.h"
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/ps_cache/embedding_hash_map.h"
 #include "ps/ps_cache/ps_cache_factory.h"
@@ -108,6 +110,23 @@ struct PsCacheStatisticsInfo {
   size_t mem_cache_hit_count_{0};
 };
 
+// The swaps ParseData plans for one batch. With cache prefetch the process data thread does them while the batch
+// waits in the data queue, and the graph step of the batch waits until they are finished.
+struct PsCacheSwapTask {
+  size_t data_step{0};
+  // The rows of graph_running_step are swapped out, so the swaps wait until the graph runs past it.
+  bool need_wait_graph{false};
+  size_t graph_running_step{0};
+  std::vector<int> device_cache_device_to_host_index;
+  std::vector<int> host_cache_device_to_host_index;
+  std::vector<int> host_cache_host_to_device_index;
+  std::vector<int> device_cache_host_to_device_index;
+  std::vector<int> host_to_server_index;
+  std::vector<int> host_to_server_ids;
+  std::vector<int> server_to_host_index;
+  std::vector<int> server_to_host_ids;
+};
+
 class PsCacheManager {
  public:
   static PsCacheManager &GetInstance() {
@@ -150,18 +169,26 @@ class PsCacheManager {
   void AllocMemForHashTable();
   void SetLocalIdRank();
   void ProcessDataTask(uint32_t device_id, const void *context);
+  void ParseDataTask();
   bool ProcessData();
   bool ParseData(const int *batch_ids, const size_t batch_ids_len, int *hash_index);
   bool WaitGraphRun();
+  bool WaitGraphStep(size_t graph_step);
+  bool CreateSwapTask(PsCacheSwapTask *swap_task);
+  bool PushSwapTask(const std::shared_ptr<PsCacheSwapTask> &swap_task);
+  bool ProcessSwapTask();
+  bool SwapData(const PsCacheSwapTask &swap_task);
+  bool WaitSwapTaskFinish(size_t data_step, bool *stalled);
+  void StopSwapTasks();
   bool ParseDeviceData(size_t id, bool *need_swap_device_to_host, bool *need_swap_host_to_device, int *hash_index);
   bool ParseHostDataHostToDevice(size_t id);
   bool ParseHostDataDeviceToHost();
   bool HashSwapDeviceOut(int *swap_out_index, std::vector<float> *swap_out_data, const HashTableInfo &hash_info);
   bool HashSwapDeviceIn(const int *swap_in_ids, const int *swap_in_index, const HashTableInfo &hash_info, size_t key);
-  bool HashSwapHostToDevice(const HashTableInfo &hash_info);
-  bool HashSwapDeviceToHost(const HashTableInfo &hash_info);
-  bool HashSwapHostToServer(size_t key, const HashTableInfo &hash_info);
-  bool HashSwapServerToHost(size_t key, const HashTableInfo &hash_info);
+  bool HashSwapHostToDevice(const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task);
+  bool HashSwapDeviceToHost(const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task);
+  bool HashSwapHostToServer(size_t key, const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task);
+  bool HashSwapServerToHost(size_t key, const HashTableInfo &hash_info, const PsCacheSwapTask &swap_task);
   bool InsertHostHashTable(size_t embedding_size, size_t insert_indices_size, const int *insert_indices,
                            const float *insert_data, float *hash_table_addr);
   bool LookUpHostHashTable(size_t embedding_size, size_t indices_lens, const float *hash_table_addr,
@@ -190,6 +217,22 @@ class PsCacheManager {
   std::condition_variable data_prase_;
   std::condition_variable insert_init_info_;
   std::thread process_data_thread_;
+  std::thread parse_data_thread_;
+
+  // The swap tasks parsed ahead, at most cache_prefetch_depth_ of them, and the data step of the last one pushed
+  // and of the last one finished.
+  size_t cache_prefetch_depth_{0};
+  std::mutex swap_mutex_;
+  std::condition_variable swap_task_cond_;
+  std::condition_variable swap_finish_cond_;
+  std::queue<std::shared_ptr<PsCacheSwapTask>> swap_tasks_;
+  size_t swap_task_step_{0};
+  size_t finish_swap_step_{0};
+  // Pulls the rows from the server while the swap thread swaps the rows out of the device.
+  std::shared_ptr<core::TaskExecutor> server_pull_executor_;
+  // The graph steps which waited for the swaps of their batch, and how long they waited in total.
+  std::atomic_ulong prefetch_stall_count_{0};
+  std::atomic_ulong prefetch_stall_time_us_{0};
 
   std::map<std::string, HashTableInfo> hash_tables_;
   std::shared_ptr<EmbeddingDeviceCache> embedding_device_cache_;
@@ -15,6 +15,7 @@
  */
 
 #include "ps/ps_context.h"
+#include "ps/gradient_compression.h"
 #include "utils/log_adapter.h"
 #include "utils/ms_utils.h"
 #include "backend/kernel_compiler/kernel.h"
@@ -317,5 +318,31 @@ core::ClusterConfig &PSContext::cluster_config() {
 void PSContext::set_scheduler_manage_port(uint16_t sched_port) { scheduler_manage_port_ = sched_port; }
 
 uint16_t PSContext::scheduler_manage_port() const { return scheduler_manage_port_; }
+
+void PSContext::set_gradient_compression(const std::string &gradient_compression) {
+  (void)StringToCompressionType(gradient_compression);
+  gradient_compression_ = gradient_compression;
+}
+
+const std::string &PSContext::gradient_compression() const { return gradient_compression_; }
+
+void PSContext::set_gradient_topk_ratio(float gradient_topk_ratio) {
+  if (gradient_topk_ratio <= 0 || gradient_topk_ratio > 1) {
+    MS_LOG(EXCEPTION) << "The gradient top-k ratio should be in (0, 1], but got " << gradient_topk_ratio;
+  }
+  gradient_topk_ratio_ = gradient_topk_ratio;
+}
+
+float PSContext::gradient_topk_ratio() const { return gradient_topk_ratio_; }
+
+void PSContext::set_cache_prefetch_depth(size_t cache_prefetch_depth) {
+  if (cache_prefetch_depth == 0 || cache_prefetch_depth > kMaxCachePrefetchDepth) {
+    MS_LOG(EXCEPTION) << "The cache prefetch depth should be in [1, " << kMaxCachePrefetchDepth << "], but got "
+                      << cache_prefetch_depth;
+  }
+  cache_prefetch_depth_ = cache_prefetch_depth;
+}
+
+size_t PSContext::cache_prefetch_depth() const { return cache_prefetch_depth_; }
 }  // namespace ps
 }  // namespace mindspore
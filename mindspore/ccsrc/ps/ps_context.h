@@ -148,6 +148,18 @@ class PSContext {
   void set_scheduler_manage_port(uint16_t sched_port);
   uint16_t scheduler_manage_port() const;
 
+  // How the workers compress the dense gradients they push and the weights they pull: none, fp16, bf16 or topk.
+  void set_gradient_compression(const std::string &gradient_compression);
+  const std::string &gradient_compression() const;
+
+  // The ratio of the values top-k compression sends.
+  void set_gradient_topk_ratio(float gradient_topk_ratio);
+  float gradient_topk_ratio() const;
+
+  // How many batches the embedding cache parses ahead of the swaps of their rows.
+  void set_cache_prefetch_depth(size_t cache_prefetch_depth);
+  size_t cache_prefetch_depth() const;
+
  private:
   PSContext()
       : ps_enabled_(false),
@@ -176,7 +188,10 @@ class PSContext {
         client_learning_rate_(0.001),
         secure_aggregation_(false),
         cluster_config_(nullptr),
-        scheduler_manage_port_(0) {}
+        scheduler_manage_port_(0),
+        gradient_compression_("none"),
+        gradient_topk_ratio_(kDefaultTopKRatio),
+        cache_prefetch_depth_(kDefaultCachePrefetchDepth) {}
   bool ps_enabled_;
   bool is_worker_;
   bool is_pserver_;
@@ -238,6 +253,15 @@ class PSContext {
 
   // The port used by scheduler to receive http requests for scale out or scale in.
   uint16_t scheduler_manage_port_;
+
+  // The compression of the dense gradients pushed and the weights pulled by the workers.
+  std::string gradient_compression_;
+
+  // The ratio of the values sent by top-k gradient compression.
+  float gradient_topk_ratio_;
+
+  // The number of batches the embedding cache parses ahead of the swaps of their rows.
+  size_t cache_prefetch_depth_;
 };
 }  // namespace ps
 }  // namespace mindspore
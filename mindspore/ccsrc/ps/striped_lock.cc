@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ps/striped_lock.h"
+
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+MultiStripeLock::MultiStripeLock(StripedLock *locks, const uint64_t *ids, size_t ids_size, bool exclusive)
+    : locks_(locks), exclusive_(exclusive) {
+  MS_EXCEPTION_IF_NULL(locks_);
+  std::vector<bool> used(locks_->num_stripes(), false);
+  for (size_t i = 0; i < ids_size; i++) {
+    used[locks_->Stripe(ids[i])] = true;
+  }
+  for (size_t stripe = 0; stripe < used.size(); stripe++) {
+    if (used[stripe]) {
+      stripes_.push_back(stripe);
+    }
+  }
+  Lock();
+}
+
+MultiStripeLock::MultiStripeLock(StripedLock *locks, bool exclusive) : locks_(locks), exclusive_(exclusive) {
+  MS_EXCEPTION_IF_NULL(locks_);
+  stripes_.resize(locks_->num_stripes());
+  for (size_t stripe = 0; stripe < stripes_.size(); stripe++) {
+    stripes_[stripe] = stripe;
+  }
+  Lock();
+}
+
+void MultiStripeLock::Lock() {
+  for (size_t stripe : stripes_) {
+    if (exclusive_) {
+      locks_->GetStripe(stripe).lock();
+    } else {
+      locks_->GetStripe(stripe).lock_shared();
+    }
+  }
+}
+
+MultiStripeLock::~MultiStripeLock() {
+  for (auto iter = stripes_.rbegin(); iter != stripes_.rend(); iter++) {
+    if (exclusive_) {
+      locks_->GetStripe(*iter).unlock();
+    } else {
+      locks_->GetStripe(*iter).unlock_shared();
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
+#define MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
+
+#include <shared_mutex>
+#include <vector>
+
+#include "ps/constants.h"
+
+namespace mindspore {
+namespace ps {
+// A fixed number of reader-writer locks shared by many ids. Ids are grouped into ranges of ids_per_stripe, and the
+// ranges are spread over the locks. An id holds the lock of its stripe, so ids in different stripes never wait for
+// each other, and the locks take no memory per id.
+class StripedLock {
+ public:
+  explicit StripedLock(size_t num_stripes, size_t ids_per_stripe = 1)
+      : locks_(num_stripes), ids_per_stripe_(ids_per_stripe) {}
+  ~StripedLock() = default;
+  StripedLock(const StripedLock &) = delete;
+  StripedLock &operator=(const StripedLock &) = delete;
+
+  size_t num_stripes() const { return locks_.size(); }
+  size_t Stripe(uint64_t id) const { return (id / ids_per_stripe_) % locks_.size(); }
+  std::shared_mutex &Get(uint64_t id) { return locks_[Stripe(id)]; }
+  std::shared_mutex &GetStripe(size_t stripe) { return locks_[stripe]; }
+
+ private:
+  std::vector<std::shared_mutex> locks_;
+  size_t ids_per_stripe_;
+};
+
+// Holds the stripes of a StripedLock which a set of ids fall in, such as the rows of an embedding table read by a
+// lookup. The stripes are locked in increasing order, so two holders never wait for each other in a cycle.
+class MultiStripeLock {
+ public:
+  // Lock the stripes of the given ids.
+  MultiStripeLock(StripedLock *locks, const uint64_t *ids, size_t ids_size, bool exclusive);
+  // Lock all the stripes.
+  MultiStripeLock(StripedLock *locks, bool exclusive);
+  ~MultiStripeLock();
+  MultiStripeLock(const MultiStripeLock &) = delete;
+  MultiStripeLock &operator=(const MultiStripeLock &) = delete;
+
+ private:
+  void Lock();
+
+  StripedLock *locks_;
+  std::vector<size_t> stripes_;
+  bool exclusive_;
+};
+}  // namespace ps
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PS_STRIPED_LOCK_H_
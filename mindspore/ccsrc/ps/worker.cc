@@ -32,6 +32,8 @@ void Worker::Run() {
   }
 
   Initialize();
+  compressor_.Init(StringToCompressionType(PSContext::instance()->gradient_compression()),
+                   PSContext::instance()->gradient_topk_ratio());
   worker_node_.set_event_callback([&](const core::ClusterEvent &event) {
     if ((event == core::ClusterEvent::CLUSTER_TIMEOUT) ||
         (event == core::ClusterEvent::SCHEDULER_TIMEOUT || (event == core::ClusterEvent::NODE_TIMEOUT))) {
@@ -101,7 +103,9 @@ void Worker::Push(const std::vector<size_t> &keys, std::vector<uintptr_t> addrs,
   std::vector<int> sizes_int;
   (void)std::transform(sizes.begin(), sizes.end(), std::back_inserter(sizes_int),
                        [](const int64_t &value) { return static_cast<int>(value); });
-  if (!is_sparse) {
+  if (!is_sparse && compressor_.type() != CompressionType::kNone) {
+    PushCompressedData(std::vector<Key>(keys), total_buffer, std::vector<int>(sizes_int), optim_id);
+  } else if (!is_sparse) {
     PushData(std::vector<Key>(keys), total_buffer, std::vector<int>(sizes_int), kPushCmd);
   } else {
     std::vector<int64_t> &var_shape = key_to_optim_shapes_[key][0];
@@ -651,6 +655,38 @@ void Worker::PushData(const std::vector<Key> &keys, const std::vector<float> &va
   }
 }
 
+void Worker::PushCompressedData(const std::vector<Key> &keys, const std::vector<float> &vals,
+                                const std::vector<int> &lens, int64_t optim_id) {
+  auto send_index = kOptimToPSSendIdx.find(Util::optimizer_name(optim_id));
+  if (send_index == kOptimToPSSendIdx.end() || send_index->second.count("grad") == 0 ||
+      embedding_table_ranges_.count(keys[0])) {
+    PushData(keys, vals, lens, kPushCmd);
+    return;
+  }
+  size_t grad_index = send_index->second.at("grad");
+  EXC_IF_VEC_IDX_OOB(lens, grad_index);
+  size_t grad_size = IntToSize(lens[grad_index]);
+  if (grad_size < kCompressMinSize) {
+    PushData(keys, vals, lens, kPushCmd);
+    return;
+  }
+  size_t grad_offset = IntToSize(std::accumulate(lens.begin(), lens.begin() + grad_index, 0));
+
+  // The other inputs such as the learning rate are sent as they are, the gradient takes no room in values
+  KVMessage kvs;
+  *kvs.mutable_keys() = {keys.begin(), keys.end()};
+  *kvs.mutable_len() = {lens.begin(), lens.end()};
+  kvs.set_len(grad_index, 0);
+  std::vector<float> other_vals(vals.begin(), vals.begin() + grad_offset);
+  other_vals.insert(other_vals.end(), vals.begin() + grad_offset + grad_size, vals.end());
+  *kvs.mutable_values() = {other_vals.begin(), other_vals.end()};
+  kvs.set_compression(static_cast<int32_t>(compressor_.type()));
+  kvs.set_compressed_index(SizeToInt(grad_index));
+  kvs.set_compressed_len(SizeToInt(grad_size));
+  compressor_.Compress(keys[0], vals.data() + grad_offset, grad_size, kvs.mutable_compressed_values());
+  SendForPush(kPushCmd, kvs, round_robin_partitioner_, {});
+}
+
 void Worker::PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                             size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size) {
   KVMessage kvs;
@@ -670,6 +706,11 @@ void Worker::PullData(const std::vector<Key> &keys, std::vector<float> *const va
   MS_EXCEPTION_IF_NULL(vals);
   KVMessage kvs;
   *kvs.mutable_keys() = {keys.begin(), keys.end()};
+  // Top-k does not suit weights, they are pulled whole
+  CompressionType compression = compressor_.type();
+  if (cmd == kPullCmd && (compression == CompressionType::kFp16 || compression == CompressionType::kBf16)) {
+    kvs.set_compression(static_cast<int32_t>(compression));
+  }
   if (embedding_table_ranges_.count(keys[0])) {
     SendForPull(cmd, kvs, broadcast_partitioner_, {}, vals, lens);
   } else {
@@ -857,6 +898,14 @@ void Worker::RoundRobinPartitioner(const KVMessage &send, PartitionKVMessages *p
     }
     server_kv_pairs.add_len(len);
   }
+  // A compressed message carries one parameter, which lives on one server
+  if (send.compression() != 0) {
+    KVMessage &server_kv_pairs = partition->at(key_to_server_id_[keys[0]]).second;
+    server_kv_pairs.set_compression(send.compression());
+    server_kv_pairs.set_compressed_index(send.compressed_index());
+    server_kv_pairs.set_compressed_len(send.compressed_len());
+    server_kv_pairs.set_compressed_values(send.compressed_values());
+  }
 }
 
 void Worker::WorkerInitEmbeddingPartitioner(const KVMessage &send, std::vector<std::pair<bool, KVMessage>> *partition,
@@ -983,7 +1032,17 @@ void Worker::SendForPull(int cmd, const KVMessage &send, const KVPartitioner &pa
   for (size_t i = 0; i < resp.size(); ++i) {
     KVMessage message;
     message.ParseFromArray(resp.at(i)->data(), resp.at(i)->size());
-    std::copy(message.values().begin(), message.values().end(), std::back_inserter(*vals));
+    if (message.compression() != 0) {
+      size_t offset = vals->size();
+      vals->resize(offset + IntToSize(message.compressed_len()));
+      if (!GradientCompressor::Decode(static_cast<CompressionType>(message.compression()),
+                                      message.compressed_values(), vals->data() + offset,
+                                      IntToSize(message.compressed_len()))) {
+        MS_LOG(EXCEPTION) << "The pulled values of compression " << message.compression() << " are malformed.";
+      }
+    } else {
+      std::copy(message.values().begin(), message.values().end(), std::back_inserter(*vals));
+    }
 
     if (lens) {
       lens->clear();
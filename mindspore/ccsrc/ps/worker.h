@@ -37,6 +37,7 @@
 #include "ps/ps_cache/ps_data/ps_data_prefetch.h"
 #include "ps/core/worker_node.h"
 #include "ps/embedding_table_shard_metadata.h"
+#include "ps/gradient_compression.h"
 #include "proto/comm.pb.h"
 #include "proto/ps.pb.h"
 #include "ps/ps_context.h"
@@ -103,6 +104,8 @@ class Worker {
 
   void PushData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens = {},
                 int command = 0, int64_t priority = 0);
+  void PushCompressedData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
+                          int64_t optim_id);
   void PushSparseData(const std::vector<Key> &keys, const std::vector<float> &vals, const std::vector<int> &lens,
                       size_t grad_index, size_t indice_index, size_t first_dim_size, size_t outer_dim_size);
   void PullData(const std::vector<Key> &keys, std::vector<float> *const vals, std::vector<int> *lens = nullptr,
@@ -147,6 +150,7 @@ class Worker {
   std::unordered_map<Key, size_t> embedding_row_cnt_;
 
   std::unordered_map<Key, std::shared_ptr<std::vector<EmbeddingTableShardMetadata>>> embedding_table_ranges_;
+  GradientCompressor compressor_;
 };
 }  // namespace ps
 }  // namespace mindspore
@@ -35,7 +35,7 @@ class CPUMemoryManager : public MemoryManager {
   virtual ~CPUMemoryManager();
 
   void MallocDeviceMemory() override {}
-  void FreeDeviceMemory() override { CPUMemoryPool::GetInstance().ReleaseDeviceRes(); }
+  void FreeDeviceMemory() override { CPUMemoryPool::ReleaseAllDeviceRes(); }
   void ResetDynamicMemory() override;
 
   void AssignMemory(const session::KernelGraph *graph);
@@ -47,7 +47,9 @@ class CPUMemoryManager : public MemoryManager {
   void DecreaseSummaryRefCount(const session::NamedSummaryOutputs &summary_outputs);
 
   void *MallocMemFromMemPool(size_t size) override { return CPUMemoryPool::GetInstance().AllocTensorMem(size); }
-  void FreeMemFromMemPool(void *device_ptr) override { CPUMemoryPool::GetInstance().FreeTensorMem(device_ptr); }
+  void FreeMemFromMemPool(void *device_ptr) override {
+    CPUMemoryPool::GetInstance(device_ptr).FreeTensorMem(device_ptr);
+  }
   std::vector<void *> MallocContinuousMemFromMemPool(size_t total_size, std::vector<size_t> size_list) override {
     return CPUMemoryPool::GetInstance().AllocContinuousTensorMem(total_size, size_list);
   }
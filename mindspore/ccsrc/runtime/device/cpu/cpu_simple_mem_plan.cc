@@ -14,11 +14,22 @@
  * limitations under the License.
  */
 #include "runtime/device/cpu/cpu_simple_mem_plan.h"
+#include <algorithm>
+#include <unordered_map>
 #include "backend/session/anf_runtime_algorithm.h"
 
 namespace mindspore {
 namespace device {
 namespace cpu {
+namespace {
+constexpr size_t kMemReuseAlignSize = 64;
+constexpr size_t kBitsOfWord = 64;
+
+size_t AlignMemorySize(size_t size) {
+  return (size + kMemReuseAlignSize - 1) / kMemReuseAlignSize * kMemReuseAlignSize;
+}
+}  // namespace
+
 size_t CPUSimpleMemPlan::MemPlan(const session::KernelGraph *graph) {
   MS_EXCEPTION_IF_NULL(graph);
   size_t total_mem_size = 32;
@@ -106,6 +117,159 @@ void CPUSimpleMemPlan::MemAssign(const session::KernelGraph *graph, uint8_t *bas
     }
   }
 }
+
+void CPUSimpleMemPlan::CollectUnplannedAddress(const session::KernelGraph *graph,
+                                               std::unordered_set<const DeviceAddress *> *unplanned_addresses) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(unplanned_addresses);
+  // The graph outputs are handed over to the host tensors and the internal outputs are used by the other graphs, so
+  // their lifetimes are beyond the graph.
+  const auto &outputs = AnfAlgo::GetAllOutput(graph->output(), {prim::kPrimTupleGetItem});
+  for (const auto &output : outputs) {
+    const auto &output_with_index = AnfAlgo::VisitKernelWithReturnType(output, 0, false);
+    MS_EXCEPTION_IF_NULL(output_with_index.first);
+    if (AnfAlgo::OutputAddrExist(output_with_index.first, output_with_index.second)) {
+      (void)unplanned_addresses->insert(
+        AnfAlgo::GetMutableOutputAddr(output_with_index.first, output_with_index.second, true).get());
+    }
+  }
+  for (const auto &kernel : graph->execution_order()) {
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      if (graph->IsInternalOutput(kernel, i)) {
+        (void)unplanned_addresses->insert(AnfAlgo::GetMutableOutputAddr(kernel, i, true).get());
+      }
+    }
+  }
+  // The device tensors of parameters are persistent.
+  for (const auto &input : graph->inputs()) {
+    MS_EXCEPTION_IF_NULL(input);
+    size_t output_num = AnfAlgo::GetOutputTensorNum(input);
+    for (size_t i = 0; i < output_num; ++i) {
+      if (AnfAlgo::OutputAddrExist(input, i)) {
+        (void)unplanned_addresses->insert(AnfAlgo::GetMutableOutputAddr(input, i, false).get());
+      }
+    }
+  }
+}
+
+size_t CPUSimpleMemPlan::MemReusePlan(const session::KernelGraph *graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  plan_tensors_.clear();
+  kernel_ancestors_.clear();
+  std::unordered_set<const DeviceAddress *> unplanned_addresses;
+  CollectUnplannedAddress(graph, &unplanned_addresses);
+
+  const auto &kernels = graph->execution_order();
+  size_t word_num = (kernels.size() + kBitsOfWord - 1) / kBitsOfWord;
+  kernel_ancestors_.resize(kernels.size(), std::vector<uint64_t>(word_num, 0));
+  std::unordered_map<const DeviceAddress *, size_t> address_to_producer;
+  std::unordered_map<const DeviceAddress *, size_t> address_to_tensor;
+  auto add_tensor = [this, &address_to_tensor, &unplanned_addresses](DeviceAddress *address, size_t kernel_index) {
+    MS_EXCEPTION_IF_NULL(address);
+    if ((address->ptr_ != nullptr) || (address->size_ == 0) || (unplanned_addresses.count(address) > 0)) {
+      return;
+    }
+    if (address_to_tensor.count(address) > 0) {
+      // The in-place kernels share the device tensor, which lives until the last one.
+      plan_tensors_[address_to_tensor[address]].users.emplace_back(kernel_index);
+      return;
+    }
+    address_to_tensor[address] = plan_tensors_.size();
+    plan_tensors_.push_back({address, AlignMemorySize(address->size_), 0, kernel_index, {kernel_index}});
+  };
+
+  for (size_t kernel_index = 0; kernel_index < kernels.size(); ++kernel_index) {
+    const auto &kernel = kernels[kernel_index];
+    MS_EXCEPTION_IF_NULL(kernel);
+    auto &ancestors = kernel_ancestors_[kernel_index];
+    size_t input_num = AnfAlgo::GetInputTensorNum(kernel);
+    for (size_t i = 0; i < input_num; ++i) {
+      auto kernel_with_index = AnfAlgo::GetPrevNodeOutput(kernel, i);
+      MS_EXCEPTION_IF_NULL(kernel_with_index.first);
+      if (!kernel_with_index.first->isa<CNode>() ||
+          !AnfAlgo::OutputAddrExist(kernel_with_index.first, kernel_with_index.second)) {
+        continue;
+      }
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel_with_index.first, kernel_with_index.second, true).get();
+      auto producer_iter = address_to_producer.find(address);
+      if (producer_iter == address_to_producer.end()) {
+        continue;
+      }
+      // The kernel can't launch before the producer of its input finishes.
+      auto producer = producer_iter->second;
+      const auto &producer_ancestors = kernel_ancestors_[producer];
+      for (size_t word = 0; word < word_num; ++word) {
+        ancestors[word] |= producer_ancestors[word];
+      }
+      ancestors[producer / kBitsOfWord] |= (1ULL << (producer % kBitsOfWord));
+      auto tensor_iter = address_to_tensor.find(address);
+      if (tensor_iter != address_to_tensor.end()) {
+        plan_tensors_[tensor_iter->second].users.emplace_back(kernel_index);
+      }
+    }
+
+    size_t output_num = AnfAlgo::GetOutputTensorNum(kernel);
+    for (size_t i = 0; i < output_num; ++i) {
+      auto address = AnfAlgo::GetMutableOutputAddr(kernel, i, false).get();
+      (void)address_to_producer.emplace(address, kernel_index);
+      add_tensor(address, kernel_index);
+    }
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    for (size_t i = 0; i < kernel_mod->GetWorkspaceSizeList().size(); ++i) {
+      add_tensor(AnfAlgo::GetWorkspaceAddr(kernel, i), kernel_index);
+    }
+  }
+
+  // Place the larger device tensor first, at the lowest offset which doesn't overlap the conflicting device tensors.
+  std::vector<size_t> order(plan_tensors_.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t a, size_t b) { return plan_tensors_[a].size > plan_tensors_[b].size; });
+  size_t total_size = 0;
+  std::vector<const PlanTensor *> placed_tensors;
+  for (auto index : order) {
+    auto &plan_tensor = plan_tensors_[index];
+    std::vector<const PlanTensor *> conflict_tensors;
+    for (const auto &placed_tensor : placed_tensors) {
+      if (!IsReleasedBefore(*placed_tensor, plan_tensor) && !IsReleasedBefore(plan_tensor, *placed_tensor)) {
+        conflict_tensors.emplace_back(placed_tensor);
+      }
+    }
+    std::sort(conflict_tensors.begin(), conflict_tensors.end(),
+              [](const PlanTensor *a, const PlanTensor *b) { return a->offset < b->offset; });
+    size_t offset = 0;
+    for (const auto &conflict_tensor : conflict_tensors) {
+      if (offset + plan_tensor.size <= conflict_tensor->offset) {
+        break;
+      }
+      offset = std::max(offset, conflict_tensor->offset + conflict_tensor->size);
+    }
+    plan_tensor.offset = offset;
+    total_size = std::max(total_size, offset + plan_tensor.size);
+    placed_tensors.emplace_back(&plan_tensor);
+  }
+  return total_size;
+}
+
+bool CPUSimpleMemPlan::IsReleasedBefore(const PlanTensor &from, const PlanTensor &to) const {
+  const auto &ancestors = kernel_ancestors_[to.producer];
+  return std::all_of(from.users.begin(), from.users.end(), [&ancestors](size_t user) {
+    return (ancestors[user / kBitsOfWord] & (1ULL << (user % kBitsOfWord))) != 0;
+  });
+}
+
+void CPUSimpleMemPlan::MemReuseAssign(uint8_t *base_ptr) {
+  MS_EXCEPTION_IF_NULL(base_ptr);
+  for (auto &plan_tensor : plan_tensors_) {
+    MS_EXCEPTION_IF_NULL(plan_tensor.address);
+    plan_tensor.address->ptr_ = base_ptr + plan_tensor.offset;
+    plan_tensor.address->is_static_mem_ = true;
+  }
+}
 }  // namespace cpu
 }  // namespace device
 }  // namespace mindspore
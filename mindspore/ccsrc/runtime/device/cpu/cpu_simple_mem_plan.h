@@ -17,6 +17,7 @@
 #define MINDSPORE_CCSRC_RUNTIME_DEVICE_CPU_CPU_SIMPLE_MEM_PLAN_H_
 
 #include <vector>
+#include <unordered_set>
 #include "backend/session/kernel_graph.h"
 #include "runtime/device/device_address.h"
 
@@ -30,6 +31,32 @@ class CPUSimpleMemPlan {
 
   size_t MemPlan(const session::KernelGraph *graph);
   void MemAssign(const session::KernelGraph *graph, uint8_t *base_ptr);
+
+  // Plan the offsets of the kernel outputs and workspaces which live in the graph only, the device tensors can share
+  // the memory when one of them is released before the other one is produced in the dependency order of kernels, so
+  // the plan stays valid when the independent kernels run concurrently. Return the total memory size of the plan.
+  size_t MemReusePlan(const session::KernelGraph *graph);
+  // Assign the planned device tensors with the memory from base_ptr, they are kept in all the steps.
+  void MemReuseAssign(uint8_t *base_ptr);
+
+ private:
+  struct PlanTensor {
+    DeviceAddress *address;
+    size_t size;
+    size_t offset;
+    // The index of kernel which produces the device tensor.
+    size_t producer;
+    // The indexes of kernels which produce or consume the device tensor.
+    std::vector<size_t> users;
+  };
+  // Whether the device tensor from is released before the device tensor to is produced.
+  bool IsReleasedBefore(const PlanTensor &from, const PlanTensor &to) const;
+  void CollectUnplannedAddress(const session::KernelGraph *graph,
+                               std::unordered_set<const DeviceAddress *> *unplanned_addresses) const;
+
+  std::vector<PlanTensor> plan_tensors_;
+  // The ancestors of each kernel in the execution order, stored as the bitmap.
+  std::vector<std::vector<uint64_t>> kernel_ancestors_;
 };
 }  // namespace cpu
 }  // namespace device
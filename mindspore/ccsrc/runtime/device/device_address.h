@@ -83,6 +83,8 @@ class DeviceAddress : public mindspore::DeviceSync {
   void IncreaseOriginalRefCount() { original_ref_count_++; }
   void DecreaseRefCount() { ref_count_--; }
   void ResetRefCount() { ref_count_ = original_ref_count_; }
+  // The memory of static plan is assigned before running and kept in all the steps, so it isn't freed in the running.
+  bool is_static_mem() const { return is_static_mem_; }
 
   virtual bool DumpMemToFile(const std::string &filepath, const std::string &host_fmt, const ShapeVector &host_shape,
                              TypeId host_type, bool trans_flag) const {
@@ -107,6 +109,7 @@ class DeviceAddress : public mindspore::DeviceSync {
   string format_{"DefaultFormat"};
   TypeId type_id_{kNumberTypeFloat16};
   bool from_mem_pool_{false};
+  bool is_static_mem_{false};
   uint8_t *communication_ptr_{nullptr};
   ShapeVector host_shape_{};
   friend class KernelRuntime;
@@ -106,12 +106,37 @@ void KernelActor::RunOpControlWithInputTensor(AID *input_control, OpContext<Devi
 }
 
 void KernelActor::SendMemoryAllocReq(OpContext<DeviceTensor> *context) {
-  Async(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_, device_context_, context,
+  if (fused_actors_.empty()) {
+    Async(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &memory_alloc_list_, device_context_, context,
+          GetAID());
+    return;
+  }
+
+  // Allocate the memory of all the fused kernels by one request.
+  fused_memory_alloc_list_.assign(memory_alloc_list_.begin(), memory_alloc_list_.end());
+  for (auto &fused_actor : fused_actors_) {
+    fused_actor->FetchOutputDeviceTensor();
+    fused_memory_alloc_list_.insert(fused_memory_alloc_list_.end(), fused_actor->memory_alloc_list_.begin(),
+                                    fused_actor->memory_alloc_list_.end());
+  }
+  Async(memory_manager_aid_, &MemoryManagerActor::AllocateMemory, &fused_memory_alloc_list_, device_context_, context,
         GetAID());
 }
 
 void KernelActor::SendMemoryFreeReq(OpContext<DeviceTensor> *context) {
-  Async(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_, device_context_, context);
+  if (fused_actors_.empty()) {
+    Async(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &memory_free_list_, device_context_, context);
+    return;
+  }
+
+  // Free the memory of all the fused kernels by one request, the intermediate device tensors of the chain appear in
+  // both the output of the previous kernel and the input of the next kernel, so the reference count works as before.
+  fused_memory_free_list_.assign(memory_free_list_.begin(), memory_free_list_.end());
+  for (auto &fused_actor : fused_actors_) {
+    fused_memory_free_list_.insert(fused_memory_free_list_.end(), fused_actor->memory_free_list_.begin(),
+                                   fused_actor->memory_free_list_.end());
+  }
+  Async(memory_manager_aid_, &MemoryManagerActor::FreeMemory, &fused_memory_free_list_, device_context_, context);
 }
 
 void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *context) {
@@ -128,6 +153,10 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *context) {
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
   }
 
+  if ((!fused_actors_.empty()) && (!LaunchFusedKernels(context))) {
+    return;
+  }
+
   // Debug actor is blocked, must wait debug actor callback message to process continue.
   if (debug_aid_ != nullptr) {
     SendDebugReq(context);
@@ -137,6 +166,32 @@ void KernelActor::OnMemoryAllocFinish(OpContext<DeviceTensor> *context) {
   PostLaunchKernel(context);
 }
 
+bool KernelActor::LaunchFusedKernels(OpContext<DeviceTensor> *context) {
+  MS_EXCEPTION_IF_NULL(context);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  const KernelActor *pre_actor = this;
+  for (auto &fused_actor : fused_actors_) {
+    MS_EXCEPTION_IF_NULL(fused_actor);
+    // All the outputs of the previous kernel are consumed by the fused kernel, so pass them directly.
+    auto &input_datas = fused_actor->input_op_datas_[context->sequential_num_];
+    input_datas.insert(input_datas.end(), pre_actor->output_data_.begin(), pre_actor->output_data_.end());
+    fused_actor->FetchInputDeviceTensor(context);
+    (void)fused_actor->input_op_datas_.erase(context->sequential_num_);
+
+    fused_actor->PreLaunchKernel(context);
+    const auto &launch_info = fused_actor->launch_info_;
+    auto ret = device_context_->LaunchKernel(fused_actor->kernel_, launch_info.inputs_, launch_info.workspaces_,
+                                             launch_info.outputs_);
+    if (!ret) {
+      MS_LOG(ERROR) << "Launch kernel failed: " << fused_actor->kernel_->ToString();
+      context->SetFailed(kFailure);
+      return false;
+    }
+    pre_actor = fused_actor.get();
+  }
+  return true;
+}
+
 void KernelActor::SendDebugReq(OpContext<DeviceTensor> *context) {
   Async(*debug_aid_, &DebugActor::Debug, kernel_, device_context_, context, &GetAID());
 }
@@ -266,7 +321,17 @@ void KernelActor::PostLaunchKernel(OpContext<DeviceTensor> *context) {
   // current actor is in front of SendMemoryAllocReq of the next actor.  One is to reuse the memory more fully, the
   // other is to ensure the execution order and avoid the illegal memory timing problem.
   SendMemoryFreeReq(context);
-  SendOutput(context);
+  if (fused_actors_.empty()) {
+    SendOutput(context);
+    return;
+  }
+
+  // The outputs of the fused kernels except the last one are consumed in this actor.
+  SendRecorderInfo(context);
+  for (size_t i = 0; i < fused_actors_.size() - 1; ++i) {
+    fused_actors_[i]->SendRecorderInfo(context);
+  }
+  fused_actors_.back()->SendOutput(context);
 }
 
 void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
@@ -292,10 +357,7 @@ void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
           result_arrow->to_input_index_, context);
   }
 
-  // Send recorder info.
-  if (recorder_aid_ != nullptr) {
-    Async(*recorder_aid_, &RecorderActor::RecordMemAddressInfo, kernel_.get(), &launch_info_, device_context_, context);
-  }
+  SendRecorderInfo(context);
 
   // No output.
   if ((output_data_arrows_.size() == 0) && (output_control_arrows_.size() == 0) &&
@@ -304,6 +366,12 @@ void KernelActor::SendOutput(OpContext<DeviceTensor> *context) const {
   }
 }
 
+void KernelActor::SendRecorderInfo(OpContext<DeviceTensor> *context) const {
+  if (recorder_aid_ != nullptr) {
+    Async(*recorder_aid_, &RecorderActor::RecordMemAddressInfo, kernel_.get(), &launch_info_, device_context_, context);
+  }
+}
+
 void KernelActor::EraseInput(OpContext<DeviceTensor> *context) {
   MS_EXCEPTION_IF_NULL(context);
   if (input_datas_num_ != 0) {
@@ -94,8 +94,12 @@ class KernelActor : public DebugAwareActor {
   // The processing after kernel launch: 1.erase input, 2.free memory, 3.send output.
   void PostLaunchKernel(OpContext<DeviceTensor> *context);
 
+  // Launch the fused kernels in order after the kernel of this actor, return false if launch failed.
+  bool LaunchFusedKernels(OpContext<DeviceTensor> *context);
+
   // Send output data and output controls when finish kernel launch.
   void SendOutput(OpContext<DeviceTensor> *context) const;
+  void SendRecorderInfo(OpContext<DeviceTensor> *context) const;
   // Erase input data and input controls when finish kernel launch.
   void EraseInput(OpContext<DeviceTensor> *context);
 
@@ -148,6 +152,13 @@ class KernelActor : public DebugAwareActor {
   std::vector<std::vector<OpDataUniquePtr<DeviceTensor>>> output_data_by_output_index_;
   //  The output_data_ corresponds to the output_data_arrows_ one by one.
   std::vector<OpData<DeviceTensor> *> output_data_;
+
+  // The kernel actors of the linear chain which are fused into this actor, the kernels are launched in this actor one
+  // by one without message passing, and only the last one sends the output to the other actors.
+  std::vector<std::shared_ptr<KernelActor>> fused_actors_;
+  // The device tensors for memory alloc and free of this actor and all the fused actors.
+  std::vector<DeviceTensor *> fused_memory_alloc_list_;
+  std::vector<DeviceTensor *> fused_memory_free_list_;
 };
 
 using KernelActorPtr = std::shared_ptr<KernelActor>;
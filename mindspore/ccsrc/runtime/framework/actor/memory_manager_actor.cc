@@ -18,6 +18,8 @@
 #include "runtime/framework/actor/data_source_actor.h"
 #include "runtime/framework/actor/kernel_actor.h"
 #include "mindrt/include/async/async.h"
+#include "mindrt/src/actor/actormgr.h"
+#include "thread/numa_affinity.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -27,6 +29,8 @@ void MemoryManagerActor::AllocateMemory(std::vector<DeviceTensor *> *alloc_list,
   MS_EXCEPTION_IF_NULL(alloc_list);
   MS_EXCEPTION_IF_NULL(device_context);
   MS_EXCEPTION_IF_NULL(op_context);
+  // The node is restored when the allocation is done, the other actors running on this thread are not affected.
+  PreferredNodeGuard numa_guard(PreferredNumaNode(from_aid));
 
   for (auto &device_tensor : *alloc_list) {
     MS_EXCEPTION_IF_NULL(device_tensor);
@@ -34,6 +38,7 @@ void MemoryManagerActor::AllocateMemory(std::vector<DeviceTensor *> *alloc_list,
       continue;
     }
     // Allocate memory through the device context.
+    memory_alloc_count_++;
     if (!device_context->AllocateMemory(device_tensor, device_tensor->GetSize())) {
       std::string error_info = "Device memory isn't enough and alloc failed, actor name: " + from_aid.Name() +
                                ", alloc size: " + std::to_string(device_tensor->GetSize());
@@ -55,6 +60,8 @@ void MemoryManagerActor::AllocateBatchMemory(std::vector<DeviceTensor *> *alloc_
     SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*op_context),
                                       "The size of alloc list is not equal to the size of device contexts.");
   }
+  // The node is restored when the allocation is done, the other actors running on this thread are not affected.
+  PreferredNodeGuard numa_guard(PreferredNumaNode(from_aid));
 
   for (size_t i = 0; i < (*alloc_list).size(); ++i) {
     auto &device_tensor = (*alloc_list)[i];
@@ -66,6 +73,7 @@ void MemoryManagerActor::AllocateBatchMemory(std::vector<DeviceTensor *> *alloc_
     }
 
     // Allocate memory through the device context.
+    memory_alloc_count_++;
     if (!device_context->AllocateMemory(device_tensor, device_tensor->GetSize())) {
       std::string error_info = "Device memory isn't enough and alloc failed, actor name: " + from_aid.Name() +
                                ", alloc size: " + std::to_string(device_tensor->GetSize());
@@ -87,8 +95,9 @@ void MemoryManagerActor::FreeMemory(std::vector<DeviceTensor *> *free_list, cons
     device_tensor->DecreaseRefCount();
     if (device_tensor->ref_count() == 0) {
       // Free memory through the device context.
-      if (device_tensor->GetPtr() != nullptr) {
+      if ((device_tensor->GetPtr() != nullptr) && (!device_tensor->is_static_mem())) {
         device_context->FreeMemory(device_tensor);
+        memory_free_count_++;
       }
       device_tensor->ResetRefCount();
     }
@@ -115,12 +124,26 @@ void MemoryManagerActor::FreeBatchMemory(std::vector<DeviceTensor *> *free_list,
     device_tensor->DecreaseRefCount();
     if (device_tensor->ref_count() == 0) {
       // Free memory through the device context.
-      if (device_tensor->GetPtr() != nullptr) {
+      if ((device_tensor->GetPtr() != nullptr) && (!device_tensor->is_static_mem())) {
         device_context->FreeMemory(device_tensor);
+        memory_free_count_++;
       }
       device_tensor->ResetRefCount();
     }
   }
 }
+
+int MemoryManagerActor::PreferredNumaNode(const AID &from_aid) const {
+  if (NumaAffinity::GetInstance()->node_num() <= 1) {
+    return -1;
+  }
+  auto actor_mgr = ActorMgr::GetActorMgrRef();
+  MS_EXCEPTION_IF_NULL(actor_mgr);
+  auto from_actor = actor_mgr->GetActor(from_aid);
+  if ((from_actor == nullptr) || (from_actor->thread_pool() == nullptr)) {
+    return -1;
+  }
+  return from_actor->thread_pool()->numa_node();
+}
 }  // namespace runtime
 }  // namespace mindspore
@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_ACTOR_MEMORY_MANAGER_ACTOR_H_
 
 #include <vector>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -48,6 +49,18 @@ class MemoryManagerActor : public ActorBase {
   // device_contexts is from different device, the size of device_contexts must be equal to the free_list.
   void FreeBatchMemory(std::vector<DeviceTensor *> *free_list, std::vector<const DeviceContext *> *device_contexts,
                        OpContext<DeviceTensor> *op_context);
+
+  // The number of allocator calls, the device tensors with static memory don't call the allocator.
+  size_t memory_alloc_count() const { return memory_alloc_count_; }
+  size_t memory_free_count() const { return memory_free_count_; }
+
+ private:
+  // The numa node which the thread pool of the from actor is bound to, the memory of the actor is placed on it.
+  // Return -1 if the host has one node or the pool is not bound.
+  int PreferredNumaNode(const AID &from_aid) const;
+
+  std::atomic<size_t> memory_alloc_count_{0};
+  std::atomic<size_t> memory_free_count_{0};
 };
 }  // namespace runtime
 }  // namespace mindspore
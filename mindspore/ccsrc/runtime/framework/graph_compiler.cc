@@ -267,6 +267,9 @@ GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph) const {
   // Create device address for all anf nodes of graph.
   CreateDeviceAddress(graph);
 
+  // Assign the static memory plan of graph, after the device addresses are created.
+  device_context_->AssignStaticMemory(graph);
+
   graph->set_is_all_nop_node(opt::IsAllNopNode(graph.get()));
 
   MS_EXCEPTION_IF_NULL(session_);
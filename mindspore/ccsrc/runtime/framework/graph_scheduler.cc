@@ -21,6 +21,7 @@
 #include "runtime/hardware/device_context_manager.h"
 #include "mindrt/src/actor/actormgr.h"
 #include "mindrt/include/async/async.h"
+#include "thread/numa_affinity.h"
 #include "backend/session/anf_runtime_algorithm.h"
 #include "backend/optimizer/common/helper.h"
 #include "utils/config_manager.h"
@@ -331,7 +332,13 @@ GraphScheduler::~GraphScheduler() {
   // Local maps clear.
   actor_name_to_actor_.clear();
   graph_output_to_actor_.clear();
-  delete thread_pool_;
+  if (numa_thread_pools_.empty()) {
+    delete thread_pool_;
+  }
+  for (auto &numa_thread_pool : numa_thread_pools_) {
+    delete numa_thread_pool;
+  }
+  numa_thread_pools_.clear();
   thread_pool_ = nullptr;
 }
 
@@ -352,13 +359,19 @@ void GraphScheduler::Initialize() {
   // Create the thread pool of actor runtime.
   auto max_thread_num = GetMaxThreadNum();
   MS_LOG(INFO) << "Max available thread number: " << max_thread_num;
-  thread_pool_ = InterThreadPool::CreateThreadPool(max_thread_num);
+  CreateNumaThreadPools(max_thread_num);
+  if (numa_thread_pools_.empty()) {
+    thread_pool_ = InterThreadPool::CreateThreadPool(max_thread_num);
+  } else {
+    thread_pool_ = numa_thread_pools_[0];
+  }
   MS_EXCEPTION_IF_NULL(thread_pool_);
 
   // Create and schedule memory manager actor.
   auto memory_manager_actor = std::make_shared<MemoryManagerActor>();
   MS_EXCEPTION_IF_NULL(memory_manager_actor);
   memory_manager_aid_ = memory_manager_actor->GetAID();
+  memory_manager_actor_ = memory_manager_actor.get();
   auto base_actor = static_cast<ActorReference>(memory_manager_actor);
   base_actor->set_thread_pool(thread_pool_);
   // Bind single thread to response to memory alloc and free quickly.
@@ -393,6 +406,7 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
   Link(actor_set.get(), graph_compiler_info, strategy);
   // The copy actors are built in the link, so need push into the actor set after link.
   actor_set->copy_actors_ = copy_actors_;
+  FuseKernelActors(actor_set.get(), strategy);
 
   actors_.emplace(actor_set->name_, actor_set);
 
@@ -436,15 +450,44 @@ void GraphScheduler::Schedule(const ActorSet *actor_set) {
     actors.emplace_back(static_cast<ActorReference>(actor_set->output_actor_));
   }
 
-  // Schedule actors.
+  // Schedule actors. The actors are collected in the topological order roughly, so the contiguous chunks of actors are
+  // assigned to the same numa node pool to keep the producer and consumer of the device tensors on the same node.
   auto actorMgr = ActorMgr::GetActorMgrRef();
   MS_EXCEPTION_IF_NULL(actorMgr);
-  for (auto actor : actors) {
-    actor->set_thread_pool(thread_pool_);
+  size_t pool_num = numa_thread_pools_.empty() ? 1 : numa_thread_pools_.size();
+  size_t chunk_size = (actors.size() + pool_num - 1) / pool_num;
+  for (size_t i = 0; i < actors.size(); ++i) {
+    auto &actor = actors[i];
+    if (numa_thread_pools_.empty()) {
+      actor->set_thread_pool(thread_pool_);
+    } else {
+      actor->set_thread_pool(numa_thread_pools_[i / chunk_size]);
+    }
     (void)actorMgr->Spawn(actor);
   }
 }
 
+void GraphScheduler::CreateNumaThreadPools(size_t max_thread_num) {
+  auto numa_affinity = NumaAffinity::GetInstance();
+  MS_EXCEPTION_IF_NULL(numa_affinity);
+  size_t node_num = numa_affinity->node_num();
+  if (node_num <= 1) {
+    return;
+  }
+
+  for (size_t node = 0; node < node_num; ++node) {
+    // The threads of each pool are limited to the cores of the node.
+    size_t thread_num = std::min(numa_affinity->NodeCores(SizeToInt(node)).size(), max_thread_num);
+    auto numa_thread_pool = InterThreadPool::CreateThreadPool(std::max(thread_num, static_cast<size_t>(1)));
+    MS_EXCEPTION_IF_NULL(numa_thread_pool);
+    if (numa_thread_pool->SetNumaAffinity(SizeToInt(node)) != THREAD_OK) {
+      MS_LOG(WARNING) << "Bind the thread pool to numa node " << node << " failed.";
+    }
+    (void)numa_thread_pools_.emplace_back(numa_thread_pool);
+  }
+  MS_LOG(INFO) << "Create the thread pools of actor runtime for " << node_num << " numa nodes.";
+}
+
 void GraphScheduler::PrepareRun(const ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info,
                                 const std::vector<std::vector<TensorPtr>> &input_tensors) {
   MS_EXCEPTION_IF_NULL(actor_set);
@@ -528,6 +571,9 @@ bool GraphScheduler::Run(const ActorSet *actor_set, GraphExecutionStrategy strat
   // Step mode does not need sequential number.
   op_context.sequential_num_ = (strategy == GraphExecutionStrategy::kPipeline) ? &sequential_num : nullptr;
   op_context.results_ = &result;
+  MS_EXCEPTION_IF_NULL(memory_manager_actor_);
+  size_t memory_alloc_count = memory_manager_actor_->memory_alloc_count();
+  size_t memory_free_count = memory_manager_actor_->memory_free_count();
 
   // Trigger no input kernel actor running.
   for (auto &no_input_kernel_actor : actor_set->no_input_kernel_actors_) {
@@ -556,6 +602,10 @@ bool GraphScheduler::Run(const ActorSet *actor_set, GraphExecutionStrategy strat
   if (!result_future.IsOK()) {
     return false;
   }
+  // The allocator calls of the step, which are zero for the graph running with the static memory entirely.
+  MS_LOG(INFO) << "Actor set: " << actor_set->name_ << ", allocator calls of step, alloc: "
+               << (memory_manager_actor_->memory_alloc_count() - memory_alloc_count)
+               << ", free: " << (memory_manager_actor_->memory_free_count() - memory_free_count);
 
   return true;
 }
@@ -683,6 +733,90 @@ void GraphScheduler::Link(ActorSet *actor_set, const GraphCompilerInfo &graph_co
   LinkOutputResultArrowForOutputActor(actor_set->output_actor_.get(), graph_compiler_info);
 }
 
+void GraphScheduler::FuseKernelActors(ActorSet *actor_set, GraphExecutionStrategy strategy) const {
+  MS_EXCEPTION_IF_NULL(actor_set);
+  // The step mode triggers every kernel actor with the input tensors and the debug actor needs the callback of every
+  // kernel, so both of them don't support the fusion.
+  if ((strategy == GraphExecutionStrategy::kStep) || (debug_aid_ != nullptr)) {
+    return;
+  }
+
+  std::unordered_map<std::string, KernelActor *> name_to_kernel_actor;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    MS_EXCEPTION_IF_NULL(kernel_actor);
+    name_to_kernel_actor[kernel_actor->GetAID().Name()] = kernel_actor.get();
+  }
+
+  // The successor can be fused when all the outputs of the actor are sent to it and all the inputs of it come from the
+  // actor, except the inputs from the device tensor store.
+  auto fetch_fusible_successor = [&name_to_kernel_actor](const KernelActor *actor) -> KernelActor * {
+    if ((actor->output_result_arrows_.size() > 0) ||
+        (actor->output_data_arrows_.size() + actor->output_control_arrows_.size() == 0)) {
+      return nullptr;
+    }
+    const auto &successor_name = (actor->output_data_arrows_.size() > 0)
+                                   ? actor->output_data_arrows_[0]->to_op_id_.Name()
+                                   : actor->output_control_arrows_[0].Name();
+    for (const auto &data_arrow : actor->output_data_arrows_) {
+      MS_EXCEPTION_IF_NULL(data_arrow);
+      if (data_arrow->to_op_id_.Name() != successor_name) {
+        return nullptr;
+      }
+    }
+    for (const auto &control_arrow : actor->output_control_arrows_) {
+      if (control_arrow.Name() != successor_name) {
+        return nullptr;
+      }
+    }
+    const auto &iter = name_to_kernel_actor.find(successor_name);
+    if (iter == name_to_kernel_actor.end()) {
+      return nullptr;
+    }
+    auto successor = iter->second;
+    if ((successor->input_datas_num_ != actor->output_data_arrows_.size()) ||
+        (successor->input_controls_num_ != actor->output_control_arrows_.size()) ||
+        (successor->device_context_ != actor->device_context_)) {
+      return nullptr;
+    }
+    return successor;
+  };
+
+  std::unordered_map<KernelActor *, KernelActor *> actor_to_successor;
+  std::unordered_set<KernelActor *> fused_actors;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    auto successor = fetch_fusible_successor(kernel_actor.get());
+    if (successor != nullptr) {
+      actor_to_successor[kernel_actor.get()] = successor;
+      (void)fused_actors.insert(successor);
+    }
+  }
+  if (fused_actors.empty()) {
+    return;
+  }
+
+  // Every actor which isn't fused into the predecessor is the head of chain and fuses the successors in order.
+  std::unordered_map<KernelActor *, KernelActorPtr> actor_to_ptr;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    actor_to_ptr[kernel_actor.get()] = kernel_actor;
+  }
+  std::vector<KernelActorPtr> kernel_actors;
+  for (auto &kernel_actor : actor_set->kernel_actors_) {
+    if (fused_actors.count(kernel_actor.get()) > 0) {
+      continue;
+    }
+    auto iter = actor_to_successor.find(kernel_actor.get());
+    while (iter != actor_to_successor.end()) {
+      kernel_actor->fused_actors_.emplace_back(actor_to_ptr[iter->second]);
+      iter = actor_to_successor.find(iter->second);
+    }
+    kernel_actors.emplace_back(kernel_actor);
+  }
+  MS_LOG(INFO) << "Fuse kernel actors of actor set: " << actor_set->name_
+               << ", kernel actor number before fusion: " << actor_set->kernel_actors_.size()
+               << ", after fusion: " << kernel_actors.size();
+  actor_set->kernel_actors_.swap(kernel_actors);
+}
+
 std::vector<DataSourceActorPtr> GraphScheduler::BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
                                                                      const HostTensorQueuePtr &host_queue) {
   std::vector<DataSourceActorPtr> data_source_actors;
@@ -1955,6 +2089,13 @@ void GraphScheduler::DumpKernelActor(const KernelActor *actor, std::ofstream &of
 
   DumpBaseActor(actor, ofs);
 
+  ofs << "\t\tfused_actors:" << actor->fused_actors_.size() << "\n ";
+  for (const auto &fused_actor : actor->fused_actors_) {
+    MS_EXCEPTION_IF_NULL(fused_actor);
+    ofs << "\t\t\tactor_name:" << fused_actor->GetAID().Name()
+        << "\tkernel_name:" << fused_actor->kernel_->fullname_with_scope() << "\n";
+  }
+
   ofs << "\t\toutput_result_arrows:" << actor->output_result_arrows_.size() << "\n ";
   for (const auto &result_arrow : actor->output_result_arrows_) {
     MS_EXCEPTION_IF_NULL(result_arrow);
@@ -33,6 +33,7 @@
 #include "runtime/framework/actor/switch_actor.h"
 #include "runtime/framework/actor/gather_actor.h"
 #include "runtime/framework/actor/copy_actor.h"
+#include "runtime/framework/actor/memory_manager_actor.h"
 #include "runtime/hardware/device_context.h"
 #include "backend/session/kernel_graph.h"
 #include "thread/inter_threadpool.h"
@@ -163,10 +164,15 @@ class GraphScheduler {
   ~GraphScheduler();
   DISABLE_COPY_AND_ASSIGN(GraphScheduler);
 
+  // Create one thread pool bound to each numa node when the host has multiple numa nodes.
+  void CreateNumaThreadPools(size_t max_thread_num);
+
   // Transform the nodes of graph to actors.
   ActorSetPtr Build(const GraphCompilerInfo &graph_compiler_info, GraphExecutionStrategy strategy);
   // Link actors to DAG through the edge connection of graph and graph execution strategy.
   void Link(ActorSet *actor_set, const GraphCompilerInfo &graph_compiler_info, GraphExecutionStrategy strategy);
+  // Fuse the kernel actors of the linear chain into the head actor of chain to cut the message passing between them.
+  void FuseKernelActors(ActorSet *actor_set, GraphExecutionStrategy strategy) const;
 
   // The processing of actors build.
   std::vector<DataSourceActorPtr> BuildDataSourceActor(const GraphCompilerInfo &graph_compiler_info,
@@ -281,10 +287,13 @@ class GraphScheduler {
 
   // The id of global actor.
   AID memory_manager_aid_;
+  const MemoryManagerActor *memory_manager_actor_{nullptr};
   const AID *recorder_aid_{nullptr};
   const AID *debug_aid_{nullptr};
 
   InterThreadPool *thread_pool_{nullptr};
+  // One thread pool per numa node on the multi-node host, the thread_pool_ is the pool of the first node.
+  std::vector<InterThreadPool *> numa_thread_pools_;
 
   bool init_{false};
 };
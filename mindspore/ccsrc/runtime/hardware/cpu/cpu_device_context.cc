@@ -18,6 +18,7 @@
 #include <string>
 #include "runtime/device/cpu/cpu_device_address.h"
 #include "runtime/device/cpu/cpu_memory_manager.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
 #include "backend/kernel_compiler/cpu/cpu_kernel_factory.h"
 #include "runtime/device/cpu/kernel_select_cpu.h"
 #include "utils/trace_base.h"
@@ -58,6 +59,9 @@ bool CPUDeviceContext::AllocateMemory(DeviceAddress *const &address, size_t size
 void CPUDeviceContext::FreeMemory(DeviceAddress *const &address) const {
   MS_EXCEPTION_IF_NULL(address);
   MS_EXCEPTION_IF_NULL(address->ptr_);
+  if (address->is_static_mem_) {
+    return;
+  }
   MS_EXCEPTION_IF_NULL(mem_manager_);
   mem_manager_->FreeMemFromMemPool(address->ptr_);
   address->ptr_ = nullptr;
@@ -128,6 +132,32 @@ void CPUDeviceContext::CreateKernel(const std::vector<CNodePtr> &nodes) const {
   }
 }
 
+void CPUDeviceContext::AssignStaticMemory(const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(mem_manager_);
+  // The sizes of device tensors are changed in the running of dynamic shape graph.
+  if (graph->is_dynamic_shape()) {
+    return;
+  }
+
+  CPUSimpleMemPlan mem_plan;
+  size_t total_size = mem_plan.MemReusePlan(graph.get());
+  if (total_size == 0) {
+    return;
+  }
+  auto base_ptr = static_cast<uint8_t *>(mem_manager_->MallocMemFromMemPool(total_size));
+  if (base_ptr == nullptr) {
+    MS_LOG(WARNING) << "Malloc static memory failed, graph " << graph->graph_id() << " allocates memory dynamically.";
+    return;
+  }
+  // The static memory is owned by the graph and returned to the memory pool when the graph is destroyed.
+  auto mem_manager = mem_manager_;
+  graph->set_static_memory(
+    std::shared_ptr<void>(base_ptr, [mem_manager](void *ptr) { mem_manager->FreeMemFromMemPool(ptr); }));
+  mem_plan.MemReuseAssign(base_ptr);
+  MS_LOG(INFO) << "Graph " << graph->graph_id() << " assigns static memory, size: " << total_size;
+}
+
 bool CPUDeviceContext::LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                                     const std::vector<AddressPtr> &workspace,
                                     const std::vector<AddressPtr> &outputs) const {
@@ -15,7 +15,15 @@
  */
 
 #include "runtime/hardware/cpu/cpu_memory_pool.h"
+#include <sys/mman.h>
+#include <algorithm>
+#include <atomic>
+#include <map>
+#include <mutex>
 #include <string>
+#include "thread/numa_affinity.h"
+#include "thread/threadpool.h"
+#include "utils/convert_utils_base.h"
 #include "utils/log_adapter.h"
 
 namespace mindspore {
@@ -54,17 +62,114 @@ size_t GetSystemMemorySize(const std::string &key) {
   fclose(file);
   return mem_size * kKBToByte;
 }
+
+// The memory blocks of the numa node pools, used to find the pool which the address is allocated from.
+struct NumaMemBlock {
+  const void *addr;
+  size_t size;
+  int numa_node;
+};
+using NumaMemBlockTable = std::vector<NumaMemBlock>;
+std::mutex numa_mem_block_mutex;
+std::map<const void *, NumaMemBlock> numa_mem_blocks;
+// The blocks sorted by address are copied to a new table on each device alloc and free, so that the free of a tensor
+// searches the current table without the lock. A table is never changed once published, and the old ones are kept
+// until the pools are released, since a free may still be searching them.
+std::atomic<const NumaMemBlockTable *> numa_mem_block_table{nullptr};
+std::vector<std::unique_ptr<NumaMemBlockTable>> numa_mem_block_tables;
+
+// The caller holds numa_mem_block_mutex.
+void PublishNumaMemBlocks() {
+  auto table = std::make_unique<NumaMemBlockTable>();
+  table->reserve(numa_mem_blocks.size());
+  for (const auto &item : numa_mem_blocks) {
+    table->push_back(item.second);
+  }
+  numa_mem_block_table.store(table.get(), std::memory_order_release);
+  numa_mem_block_tables.push_back(std::move(table));
+}
+
+bool IsMultiNumaNode() { return NumaAffinity::GetInstance()->node_num() > 1; }
 }  // namespace
 
+std::vector<std::unique_ptr<CPUMemoryPool>> &CPUMemoryPool::pools() {
+  static std::vector<std::unique_ptr<CPUMemoryPool>> instances = []() {
+    std::vector<std::unique_ptr<CPUMemoryPool>> numa_pools;
+    if (!IsMultiNumaNode()) {
+      numa_pools.emplace_back(new CPUMemoryPool(-1));
+      return numa_pools;
+    }
+    for (size_t node = 0; node < NumaAffinity::GetInstance()->node_num(); ++node) {
+      numa_pools.emplace_back(new CPUMemoryPool(SizeToInt(node)));
+    }
+    return numa_pools;
+  }();
+  return instances;
+}
+
+CPUMemoryPool &CPUMemoryPool::GetInstance() {
+  auto &instances = pools();
+  if (instances.size() == 1) {
+    return *instances[0];
+  }
+  auto node = NumaAffinity::GetInstance()->PreferredNode();
+  return *instances[IntToSize(node)];
+}
+
+CPUMemoryPool &CPUMemoryPool::GetInstance(const DeviceMemPtr &addr) {
+  auto &instances = pools();
+  if (instances.size() == 1) {
+    return *instances[0];
+  }
+  auto table = numa_mem_block_table.load(std::memory_order_acquire);
+  if (table != nullptr) {
+    auto iter = std::upper_bound(table->begin(), table->end(), addr,
+                                 [](const void *ptr, const NumaMemBlock &block) { return ptr < block.addr; });
+    if (iter != table->begin()) {
+      --iter;
+      if (static_cast<const uint8_t *>(addr) < static_cast<const uint8_t *>(iter->addr) + iter->size) {
+        return *instances[IntToSize(iter->numa_node)];
+      }
+    }
+  }
+  MS_LOG(EXCEPTION) << "Can't find the memory pool of the address: " << addr;
+}
+
+void CPUMemoryPool::ReleaseAllDeviceRes() {
+  for (auto &instance : pools()) {
+    instance->ReleaseDeviceRes();
+  }
+  std::lock_guard<std::mutex> locker(numa_mem_block_mutex);
+  if (numa_mem_block_tables.size() > 1) {
+    (void)numa_mem_block_tables.erase(numa_mem_block_tables.begin(), numa_mem_block_tables.end() - 1);
+  }
+}
+
 size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
   if (alloc_size == 0) {
     MS_LOG(EXCEPTION) << "The memory alloc size is 0.";
   }
 
-  *addr = malloc(alloc_size);
-  if (*addr == nullptr) {
-    MS_LOG(ERROR) << "malloc memory failed.";
-    return 0;
+  if (numa_node_ < 0) {
+    *addr = malloc(alloc_size);
+    if (*addr == nullptr) {
+      MS_LOG(ERROR) << "malloc memory failed.";
+      return 0;
+    }
+  } else {
+    // The pages are placed on the numa node before they are touched, so map them directly instead of malloc.
+    *addr = mmap(nullptr, alloc_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (*addr == MAP_FAILED) {
+      *addr = nullptr;
+      MS_LOG(ERROR) << "mmap memory failed.";
+      return 0;
+    }
+    if (NumaAffinity::GetInstance()->BindMemory(*addr, alloc_size, numa_node_) != THREAD_OK) {
+      MS_LOG(WARNING) << "Bind memory to numa node " << numa_node_ << " failed.";
+    }
+    std::lock_guard<std::mutex> locker(numa_mem_block_mutex);
+    numa_mem_blocks[*addr] = {*addr, alloc_size, numa_node_};
+    PublishNumaMemBlocks();
   }
 
   total_used_memory_ += alloc_size;
@@ -74,8 +179,23 @@ size_t CPUMemoryPool::AllocDeviceMem(size_t alloc_size, DeviceMemPtr *addr) {
 }
 
 bool CPUMemoryPool::FreeDeviceMem(const DeviceMemPtr &addr) {
-  free(addr);
-  return true;
+  if (numa_node_ < 0) {
+    free(addr);
+    return true;
+  }
+  size_t size = 0;
+  {
+    std::lock_guard<std::mutex> locker(numa_mem_block_mutex);
+    auto iter = numa_mem_blocks.find(addr);
+    if (iter == numa_mem_blocks.end()) {
+      MS_LOG(ERROR) << "Can't find the memory block of the address: " << addr;
+      return false;
+    }
+    size = iter->second.size;
+    (void)numa_mem_blocks.erase(iter);
+    PublishNumaMemBlocks();
+  }
+  return munmap(addr, size) == 0;
 }
 
 size_t CPUMemoryPool::free_mem_size() { return GetSystemMemorySize("MemAvailable"); }
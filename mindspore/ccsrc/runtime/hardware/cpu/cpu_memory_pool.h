@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_RUNTIME_HARDWARE_CPU_CPU_MEMORY_POOL_H_
 
 #include <memory>
+#include <vector>
 #include "utils/ms_utils.h"
 #include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
 
@@ -28,21 +29,30 @@ class CPUMemoryPool : public DynamicMemPoolBestFit {
  public:
   ~CPUMemoryPool() override = default;
 
-  static CPUMemoryPool &GetInstance() {
-    static CPUMemoryPool instance;
-    return instance;
-  }
+  // On the multi numa node host, there is one pool for each node and the pool of the preferred node of the calling
+  // thread is returned.
+  static CPUMemoryPool &GetInstance();
+  // Return the pool which the addr is allocated from.
+  static CPUMemoryPool &GetInstance(const DeviceMemPtr &addr);
+  static void ReleaseAllDeviceRes();
 
   size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override;
   bool FreeDeviceMem(const DeviceMemPtr &addr) override;
   size_t free_mem_size() override;
   size_t total_mem_size() override;
 
+ protected:
+  // The small tensors of the CPU kernels are allocated from the slabs of size class.
+  bool IsSlabEnabled() const override { return true; }
+
  private:
-  CPUMemoryPool() = default;
+  explicit CPUMemoryPool(int numa_node) : numa_node_(numa_node) {}
   DISABLE_COPY_AND_ASSIGN(CPUMemoryPool);
+  static std::vector<std::unique_ptr<CPUMemoryPool>> &pools();
 
   size_t total_used_memory_{0};
+  // The numa node which the memory of this pool is placed on, -1 means not bound.
+  int numa_node_{-1};
 };
 }  // namespace cpu
 }  // namespace device
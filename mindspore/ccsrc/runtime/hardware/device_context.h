@@ -86,6 +86,10 @@ class DeviceContext {
   // 'KernelMod' is real executive object of kernel.
   virtual void CreateKernel(const std::vector<CNodePtr> &nodes) const = 0;
 
+  // Assign the memory of the static graph ahead of time, then the device tensors with static memory are not allocated
+  // and freed in every step. Devices that do not support it could ignore the implementation of this function.
+  virtual void AssignStaticMemory(const KernelGraphPtr &graph) const {}
+
   // Launch a kernel via 'KernelMod' of the kernel.
   virtual bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
                             const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs) const = 0;
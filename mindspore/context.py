@@ -761,6 +761,16 @@ def set_ps_context(**kwargs):
         enable_ps (bool): Whether to enable parameter server training mode.
                           Only after enable_ps is set True, the environment variables will be effective.
                           Default: False.
+        gradient_compression (str): How workers compress the dense gradients they push and the weights they pull,
+                          one of "none", "fp16", "bf16" and "topk". "topk" pushes the largest values of each
+                          gradient and keeps the rest for the next step, and pulls the weights uncompressed.
+                          Default: "none".
+        gradient_topk_ratio (float): The ratio of the values of a gradient which "topk" pushes, in (0, 1].
+                          Default: 0.01.
+        cache_prefetch_depth (int): With the embedding cache, how many batches have their ids replaced by cache
+                          indices while the rows they miss are still being swapped in from the host cache and the
+                          server, in [1, 8]. A step waits only for the swaps of its own batch. 1 swaps the rows
+                          of each batch before the next one is parsed. Default: 2.
 
     Raises:
         ValueError: If input key is not the attribute in parameter server training mode context.
@@ -779,6 +789,8 @@ def get_ps_context(attr_key):
         attr_key (str): The key of the attribute.
 
         - "enable_ps": Whether to enable parameter server training mode.
+        - "gradient_compression": How workers compress the dense gradients they push and the weights they pull.
+        - "gradient_topk_ratio": The ratio of the values of a gradient which "topk" pushes.
 
     Returns:
         Returns attribute value according to the key.
@@ -80,6 +80,7 @@ class ActorBase {
   void DelRuleUdp(const std::string &peer, bool outputLog);
 
   void set_thread_pool(InterThreadPool *pool) { pool_ = pool; }
+  InterThreadPool *thread_pool() const { return pool_; }
 
  protected:
   using ActorFunction = std::function<void(const std::unique_ptr<MessageBase> &msg)>;
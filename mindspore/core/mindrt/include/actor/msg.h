@@ -17,6 +17,8 @@
 #ifndef MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 #define MINDSPORE_CORE_MINDRT_INCLUDE_ACTOR_MSG_H
 
+#include <atomic>
+#include <new>
 #include <utility>
 #include <string>
 
@@ -52,6 +54,12 @@ class MessageBase {
 
   virtual ~MessageBase() {}
 
+  // messages are allocated from a pool of size classes instead of the global heap
+  static void *operator new(size_t size);
+  static void *operator new(size_t size, const std::nothrow_t &) noexcept;
+  static void operator delete(void *ptr) noexcept;
+  static void operator delete(void *ptr, const std::nothrow_t &) noexcept;
+
   inline std::string &Name() { return name; }
 
   inline void SetName(const std::string &aName) { this->name = aName; }
@@ -79,6 +87,8 @@ class MessageBase {
   std::string name;
   std::string body;
   Type type;
+  // link of the intrusive mailbox, owned by the actor policy
+  std::atomic<MessageBase *> next{nullptr};
 };
 
 }  // namespace mindspore
@@ -70,16 +70,13 @@ void ActorBase::Quit() {
 
 void ActorBase::Run() {
   for (;;) {
-    auto msgs = actorPolicy->GetMsgs();
+    MessageBase *msgs = actorPolicy->GetMsgs();
     if (msgs == nullptr) {
       return;
     }
-    for (auto it = msgs->begin(); it != msgs->end(); ++it) {
-      std::unique_ptr<MessageBase> &msg = *it;
-      if (msg == nullptr) {
-        continue;
-      }
-      //            std::cout << "dequeue message]actor=" << id.Name() << ",msg=" << msg->Name() << std::endl;
+    while (msgs != nullptr) {
+      std::unique_ptr<MessageBase> msg(msgs);
+      msgs = msgs->next.load(std::memory_order_relaxed);
       AddMsgRecord(msg->Name());
       switch (msg->GetType()) {
         case MessageBase::Type::KMSG:
@@ -103,6 +100,7 @@ void ActorBase::Run() {
           break;
         }
         case MessageBase::Type::KTERMINATE: {
+          ActorPolicy::DeleteMsgs(msgs);
           this->Quit();
           return;
         }
@@ -112,7 +110,6 @@ void ActorBase::Run() {
         }
       }
     }
-    msgs->clear();
   }
 }
 
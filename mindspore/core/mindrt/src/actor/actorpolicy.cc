@@ -37,15 +37,12 @@ void SingleThread::Terminate(const ActorBase *actor) {
 }
 
 int SingleThread::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
-  int result;
-  {
-    std::lock_guard<std::mutex> lock(mailboxLock);
-    enqueMailbox->push_back(std::move(msg));
-    result = ++msgCount;
-  }
+  mailbox.Enqueue(msg.release());
+  int result = ++msgCount;
 
   // Notify when the count of message  is from  empty to one.
   if (start && result == 1) {
+    std::lock_guard<std::mutex> lock(mailboxLock);
     conditionVar.notify_one();
   }
 
@@ -57,16 +54,12 @@ void SingleThread::Notify() {
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *SingleThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
-  std::unique_lock<std::mutex> lock(mailboxLock);
-  conditionVar.wait(lock, [this] { return (!this->enqueMailbox->empty()); });
-  SwapMailbox();
-
-  // REF_PRIVATE_MEMBER
-  result = dequeMailbox;
-
-  return result;
+MessageBase *SingleThread::GetMsgs() {
+  {
+    std::unique_lock<std::mutex> lock(mailboxLock);
+    conditionVar.wait(lock, [this] { return !this->mailbox.Empty(); });
+  }
+  return DequeMsgs();
 }
 
 ShardedThread::ShardedThread(const std::shared_ptr<ActorBase> &aActor)
@@ -79,49 +72,40 @@ void ShardedThread::Terminate(const ActorBase *aActor) {
   // remove actor from actorMgr
   ActorMgr::GetActorMgrRef()->RemoveActor(actorName);
 
-  mailboxLock.lock();
+  // the actor is running, ready stays true so that the senders never touch the actor again.
   terminated = true;
+  std::lock_guard<std::mutex> lock(mailboxLock);
   this->actor = nullptr;
-  mailboxLock.unlock();
 }
 
 int ShardedThread::EnqueMessage(std::unique_ptr<MessageBase> &&msg) {
-  int result;
-  mailboxLock.lock();
-  enqueMailbox->push_back(std::move(msg));
+  mailbox.Enqueue(msg.release());
+  int result = ++msgCount;
   // true : The actor is running. else  the actor will  be  ready to run.
-  if (start && ready == false && terminated == false) {
+  if (start && !terminated && !ready.exchange(true)) {
     ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
   }
-  result = ++msgCount;
-  mailboxLock.unlock();
   return result;
 }
 
 void ShardedThread::Notify() {
-  if (start && ready == false && terminated == false && msgCount > 0) {
+  if (start && !terminated && msgCount > 0 && !ready.exchange(true)) {
     ActorMgr::GetActorMgrRef()->SetActorReady(actor);
-    ready = true;
   }
 }
 
-std::list<std::unique_ptr<MessageBase>> *ShardedThread::GetMsgs() {
-  std::list<std::unique_ptr<MessageBase>> *result;
-  mailboxLock.lock();
-
-  if (enqueMailbox->empty()) {
-    ready = false;
-    result = nullptr;
-  } else {
-    ready = true;
-    SwapMailbox();
-    result = dequeMailbox;
+MessageBase *ShardedThread::GetMsgs() {
+  MessageBase *result = DequeMsgs();
+  if (result != nullptr) {
+    return result;
   }
 
-  mailboxLock.unlock();
-
-  return result;
+  ready = false;
+  // a message may arrive before ready is cleared, then its sender did not schedule the actor
+  if (mailbox.Empty() || ready.exchange(true)) {
+    return nullptr;
+  }
+  return DequeMsgs();
 }
 
 };  // end of namespace mindspore
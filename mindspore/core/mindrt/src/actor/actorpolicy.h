@@ -16,7 +16,8 @@
 
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICY_H
-#include <list>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
 #include <string>
 #include <utility>
@@ -33,12 +34,13 @@ class ShardedThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual MessageBase *GetMsgs();
   virtual void Notify();
 
  private:
-  bool ready;
-  bool terminated;
+  // true: the actor is running or waiting in the ready queue of the thread pool
+  std::atomic_bool ready;
+  std::atomic_bool terminated;
   std::shared_ptr<ActorBase> actor;
 };
 
@@ -50,7 +52,7 @@ class SingleThread : public ActorPolicy {
  protected:
   virtual void Terminate(const ActorBase *actor);
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg);
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs();
+  virtual MessageBase *GetMsgs();
   virtual void Notify();
 
  private:
@@ -17,47 +17,59 @@
 #ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 #define MINDSPORE_CORE_MINDRT_SRC_ACTOR_ACTORPOLICYINTERFACE_H
 
-#include <list>
+#include <atomic>
 #include <memory>
+#include <mutex>
+
+#include "thread/hqueue.h"
 
 namespace mindspore {
 
 class ActorPolicy {
  public:
-  ActorPolicy() : mailbox1(), mailbox2() {
-    enqueMailbox = &mailbox1;
-    dequeMailbox = &mailbox2;
-    msgCount = 0;
-    start = false;
-  }
-  virtual ~ActorPolicy() {}
-  inline void SwapMailbox() {
-    std::list<std::unique_ptr<MessageBase>> *temp;
-    temp = enqueMailbox;
-    enqueMailbox = dequeMailbox;
-    dequeMailbox = temp;
-    msgCount = 0;
+  ActorPolicy() : msgCount(0), start(false) {}
+  virtual ~ActorPolicy() { DeleteMsgs(DequeMsgs()); }
+
+  // release a chain of messages returned by GetMsgs
+  static void DeleteMsgs(MessageBase *msgs) {
+    while (msgs != nullptr) {
+      MessageBase *next = msgs->next.load(std::memory_order_relaxed);
+      delete msgs;
+      msgs = next;
+    }
   }
 
  protected:
   void SetRunningStatus(bool startRun);
   virtual void Terminate(const ActorBase *actor) = 0;
   virtual int EnqueMessage(std::unique_ptr<MessageBase> &&msg) = 0;
-  virtual std::list<std::unique_ptr<MessageBase>> *GetMsgs() = 0;
+  // returns the received messages in the arrival order, chained by MessageBase::next
+  virtual MessageBase *GetMsgs() = 0;
   virtual void Notify() = 0;
 
-  std::list<std::unique_ptr<MessageBase>> *enqueMailbox;
-  std::list<std::unique_ptr<MessageBase>> *dequeMailbox;
+  // take all the messages out of the mailbox, called by the consumer only
+  inline MessageBase *DequeMsgs() {
+    MessageBase *head = mailbox.Dequeue();
+    MessageBase *tail = head;
+    int count = 0;
+    while (tail != nullptr) {
+      ++count;
+      MessageBase *msg = mailbox.Dequeue();
+      tail->next.store(msg, std::memory_order_relaxed);
+      tail = msg;
+    }
+    msgCount -= count;
+    return head;
+  }
 
-  int msgCount;
-  bool start;
+  // the senders enqueue without lock, the lock only guards the running status
+  MpscQueue<MessageBase> mailbox;
+  std::atomic_int msgCount;
+  std::atomic_bool start;
   std::mutex mailboxLock;
 
  private:
   friend class ActorBase;
-
-  std::list<std::unique_ptr<MessageBase>> mailbox1;
-  std::list<std::unique_ptr<MessageBase>> mailbox2;
 };
 
 };  // end of namespace mindspore
@@ -0,0 +1,204 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "actor/msgpool.h"
+#include <stdlib.h>
+#include <new>
+#include "actor/msg.h"
+#include "async/spinlock.h"
+
+namespace mindspore {
+namespace {
+constexpr size_t kSizeClassNum = 4;  // 64, 128, 256, 512
+constexpr size_t kMinClassShift = 6;
+constexpr size_t kLargeClass = kSizeClassNum;
+constexpr size_t kThreadCacheSize = 256;
+constexpr size_t kTransferBatch = kThreadCacheSize / 2;
+
+// every block is prefixed with its size class, keep the payload aligned
+struct alignas(alignof(std::max_align_t)) BlockHeader {
+  size_t size_class;
+};
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct FreeList {
+  FreeBlock *head{nullptr};
+  size_t count{0};
+
+  void Push(FreeBlock *block) {
+    block->next = head;
+    head = block;
+    ++count;
+  }
+
+  FreeBlock *Pop() {
+    FreeBlock *block = head;
+    if (block != nullptr) {
+      head = block->next;
+      --count;
+    }
+    return block;
+  }
+};
+
+class CentralCache {
+ public:
+  // move at most kTransferBatch blocks to the thread cache
+  void Fetch(size_t size_class, FreeList *list) {
+    locks_[size_class].Lock();
+    FreeList &central = lists_[size_class];
+    for (size_t i = 0; i < kTransferBatch && central.head != nullptr; ++i) {
+      list->Push(central.Pop());
+    }
+    locks_[size_class].Unlock();
+  }
+
+  void Push(size_t size_class, FreeBlock *block) {
+    locks_[size_class].Lock();
+    lists_[size_class].Push(block);
+    locks_[size_class].Unlock();
+  }
+
+  // take count blocks back from the thread cache
+  void Release(size_t size_class, FreeList *list, size_t count) {
+    locks_[size_class].Lock();
+    FreeList &central = lists_[size_class];
+    for (size_t i = 0; i < count && list->head != nullptr; ++i) {
+      central.Push(list->Pop());
+    }
+    locks_[size_class].Unlock();
+  }
+
+ private:
+  SpinLock locks_[kSizeClassNum];
+  FreeList lists_[kSizeClassNum];
+};
+
+CentralCache *GetCentralCache() {
+  // never destroyed, the thread caches may be released after the static objects at exit
+  static CentralCache *central = new CentralCache();
+  return central;
+}
+
+thread_local bool thread_cache_released = false;
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    for (size_t i = 0; i < kSizeClassNum; ++i) {
+      GetCentralCache()->Release(i, &lists_[i], lists_[i].count);
+    }
+    thread_cache_released = true;
+  }
+
+  void *Alloc(size_t size_class) {
+    FreeList &list = lists_[size_class];
+    if (list.head == nullptr) {
+      GetCentralCache()->Fetch(size_class, &list);
+    }
+    FreeBlock *block = list.Pop();
+    if (block != nullptr) {
+      return block;
+    }
+    return NewBlock(size_class);
+  }
+
+  static void *NewBlock(size_t size_class) {
+    return malloc(sizeof(BlockHeader) + (static_cast<size_t>(1) << (size_class + kMinClassShift)));
+  }
+
+  void Free(size_t size_class, void *block) {
+    FreeList &list = lists_[size_class];
+    list.Push(static_cast<FreeBlock *>(block));
+    // the consumer thread frees what the producers allocate, hand the surplus back
+    if (list.count > kThreadCacheSize) {
+      GetCentralCache()->Release(size_class, &list, kTransferBatch);
+    }
+  }
+
+ private:
+  FreeList lists_[kSizeClassNum];
+};
+
+// returns nullptr once the cache of this thread is destroyed at the thread exit
+ThreadCache *GetThreadCache() {
+  if (thread_cache_released) {
+    return nullptr;
+  }
+  static thread_local ThreadCache cache;
+  return &cache;
+}
+
+size_t GetSizeClass(size_t size) {
+  size_t size_class = 0;
+  while ((static_cast<size_t>(1) << (size_class + kMinClassShift)) < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+}  // namespace
+
+void *MsgPool::Alloc(size_t size) noexcept {
+  size_t size_class = size > kMaxPooledSize ? kLargeClass : GetSizeClass(size);
+  void *block = nullptr;
+  if (size_class == kLargeClass) {
+    block = malloc(sizeof(BlockHeader) + size);
+  } else {
+    ThreadCache *cache = GetThreadCache();
+    block = cache != nullptr ? cache->Alloc(size_class) : ThreadCache::NewBlock(size_class);
+  }
+  if (block == nullptr) {
+    return nullptr;
+  }
+  auto header = static_cast<BlockHeader *>(block);
+  header->size_class = size_class;
+  return header + 1;
+}
+
+void MsgPool::Free(void *ptr) noexcept {
+  if (ptr == nullptr) {
+    return;
+  }
+  auto header = static_cast<BlockHeader *>(ptr) - 1;
+  if (header->size_class == kLargeClass) {
+    free(header);
+    return;
+  }
+  ThreadCache *cache = GetThreadCache();
+  if (cache != nullptr) {
+    cache->Free(header->size_class, header);
+  } else {
+    GetCentralCache()->Push(header->size_class, reinterpret_cast<FreeBlock *>(header));
+  }
+}
+
+void *MessageBase::operator new(size_t size) {
+  void *ptr = MsgPool::Alloc(size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void *MessageBase::operator new(size_t size, const std::nothrow_t &) noexcept { return MsgPool::Alloc(size); }
+
+void MessageBase::operator delete(void *ptr) noexcept { MsgPool::Free(ptr); }
+
+void MessageBase::operator delete(void *ptr, const std::nothrow_t &) noexcept { MsgPool::Free(ptr); }
+}  // namespace mindspore
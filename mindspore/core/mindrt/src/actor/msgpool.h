@@ -0,0 +1,38 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_SRC_ACTOR_MSGPOOL_H
+#define MINDSPORE_CORE_MINDRT_SRC_ACTOR_MSGPOOL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace mindspore {
+
+// MsgPool recycles the memory of the messages. The blocks are grouped in size classes, each thread keeps a small
+// cache of free blocks per class and exchanges batches with a global list when its cache runs empty or full, so that
+// the producer and the consumer of a message need not to take a lock on every allocation.
+class MsgPool {
+ public:
+  static void *Alloc(size_t size) noexcept;
+  static void Free(void *ptr) noexcept;
+
+  // blocks larger than this are allocated from the global heap
+  static constexpr size_t kMaxPooledSize = 512;
+};
+
+};  // end of namespace mindspore
+#endif
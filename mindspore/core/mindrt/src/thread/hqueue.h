@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CORE_MINDRT_RUNTIME_HQUEUE_H_
 #define MINDSPORE_CORE_MINDRT_RUNTIME_HQUEUE_H_
 #include <atomic>
+#include <thread>
 #include <vector>
 
 namespace mindspore {
@@ -74,6 +75,74 @@ class HQueue {
   std::atomic<size_t> usedHead;
 };
 
+// implement an intrusive lock-free multi-producer single-consumer queue,
+// T must have a member `std::atomic<T *> next` and be default constructible (used as the stub node)
+template <class T>
+class MpscQueue {
+ public:
+  MpscQueue(const MpscQueue &) = delete;
+  MpscQueue &operator=(const MpscQueue &) = delete;
+  MpscQueue() : head(&stub), tail(&stub) { stub.next.store(nullptr, std::memory_order_relaxed); }
+  virtual ~MpscQueue() = default;
+
+  // called by any thread, never blocks and never allocates
+  void Enqueue(T *t) {
+    t->next.store(nullptr, std::memory_order_relaxed);
+    T *prev = head.exchange(t, std::memory_order_acq_rel);
+    // between the exchange and the store the queue is inconsistent, the consumer waits it out in Dequeue
+    prev->next.store(t, std::memory_order_release);
+  }
+
+  // called by the consumer thread only, returns nullptr when empty
+  T *Dequeue() {
+    for (;;) {
+      T *cur = tail;
+      T *next = cur->next.load(std::memory_order_acquire);
+      if (cur == &stub) {
+        if (next == nullptr) {
+          if (head.load(std::memory_order_acquire) == &stub) {
+            return nullptr;
+          }
+          // a producer is linking the first node
+          std::this_thread::yield();
+          continue;
+        }
+        tail = next;
+        cur = next;
+        next = next->next.load(std::memory_order_acquire);
+      }
+      if (next != nullptr) {
+        tail = next;
+        return cur;
+      }
+      if (cur != head.load(std::memory_order_acquire)) {
+        // a producer is linking behind cur
+        std::this_thread::yield();
+        continue;
+      }
+      // cur is the last node, put the stub behind it so that it can be taken out
+      Enqueue(&stub);
+      next = cur->next.load(std::memory_order_acquire);
+      if (next != nullptr) {
+        tail = next;
+        return cur;
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  // the stub is the last node and nothing is linked behind it, only the atomics are read so it does not depend on
+  // which thread consumed last
+  bool Empty() const {
+    return head.load(std::memory_order_acquire) == &stub && stub.next.load(std::memory_order_acquire) == nullptr;
+  }
+
+ private:
+  std::atomic<T *> head;  // the producers' end
+  T *tail;                // the consumer's end
+  T stub;
+};
+
 }  // namespace mindspore
 
 #endif  // MINDSPORE_CORE_MINDRT_RUNTIME_HQUEUE_H_
@@ -67,11 +67,13 @@ void InterThreadPool::EnqueReadyActor(const ActorReference &actor) {
   THREAD_INFO("actor enqueue success");
 }
 
-InterThreadPool *InterThreadPool::CreateThreadPool(size_t inter_thread_num, size_t intra_thread_num) {
+InterThreadPool *InterThreadPool::CreateThreadPool(size_t inter_thread_num, size_t intra_thread_num,
+                                                   TaskPolicy policy) {
   InterThreadPool *pool = new (std::nothrow) InterThreadPool(inter_thread_num);
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->task_policy_ = policy;
   size_t thread_num = inter_thread_num * intra_thread_num;
   int ret = pool->CreateThreads(thread_num);
   if (ret != THREAD_OK) {
@@ -29,7 +29,8 @@ namespace mindspore {
 class InterThreadPool : public ThreadPool {
  public:
   // create ThreadPool that contains inter thread and intra thread
-  static InterThreadPool *CreateThreadPool(size_t inter_thread_num, size_t intra_thread_num);
+  static InterThreadPool *CreateThreadPool(size_t inter_thread_num, size_t intra_thread_num,
+                                           TaskPolicy policy = kSemaphoreDispatch);
   // create ThreadPool that contains only actor thread
   static InterThreadPool *CreateThreadPool(size_t thread_num);
   ~InterThreadPool() override;
@@ -0,0 +1,223 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "thread/numa_affinity.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+#ifdef BIND_NUMA
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif  // BIND_NUMA
+#include "thread/threadpool.h"
+
+namespace mindspore {
+namespace {
+constexpr int kMaxNumaNodes = 1024;
+constexpr int kMpolPreferred = 1;  // MPOL_PREFERRED of linux/mempolicy.h
+constexpr size_t kMaxListSize = 4096;
+constexpr size_t kMaxPathSize = 256;
+const char kNodeOnlinePath[] = "/sys/devices/system/node/online";
+const char kNodeCpuListPath[] = "/sys/devices/system/node/node%d/cpulist";
+
+thread_local int preferred_node = -1;
+
+std::string ReadListFile(const char *path) {
+  FILE *fp = fopen(path, "r");
+  if (fp == nullptr) {
+    return "";
+  }
+  char buf[kMaxListSize] = {0};
+  std::string content;
+  if (fgets(buf, kMaxListSize, fp) != nullptr) {
+    content = buf;
+  }
+  fclose(fp);
+  return content;
+}
+}  // namespace
+
+NumaAffinity *NumaAffinity::GetInstance() {
+  static NumaAffinity *instance = []() {
+    auto affinity = new NumaAffinity();
+    (void)affinity->InitNumaInfo();
+    return affinity;
+  }();
+  return instance;
+}
+
+std::vector<int> NumaAffinity::ParseList(const std::string &list) {
+  std::vector<int> ids;
+  size_t pos = 0;
+  while (pos < list.size()) {
+    char *end = nullptr;
+    long begin = strtol(list.c_str() + pos, &end, 10);
+    if (end == list.c_str() + pos) {
+      break;
+    }
+    long last = begin;
+    pos = end - list.c_str();
+    if (pos < list.size() && list[pos] == '-') {
+      last = strtol(list.c_str() + pos + 1, &end, 10);
+      pos = end - list.c_str();
+    }
+    for (long id = begin; id <= last; ++id) {
+      ids.push_back(static_cast<int>(id));
+    }
+    if (pos < list.size() && list[pos] == ',') {
+      ++pos;
+      continue;
+    }
+    break;
+  }
+  return ids;
+}
+
+int NumaAffinity::InitNumaInfo() {
+  int core_num = static_cast<int>(std::thread::hardware_concurrency());
+  node_cores_.clear();
+  node_ids_.clear();
+  core_node_.assign(core_num, 0);
+  std::vector<int> online_nodes = ParseList(ReadListFile(kNodeOnlinePath));
+  for (int node_id : online_nodes) {
+    if (node_id < 0 || node_id >= kMaxNumaNodes) {
+      continue;
+    }
+    char path[kMaxPathSize] = {0};
+    (void)snprintf(path, kMaxPathSize, kNodeCpuListPath, node_id);
+    std::vector<int> cores = ParseList(ReadListFile(path));
+    // skip the memory only node
+    if (cores.empty()) {
+      continue;
+    }
+    for (int core : cores) {
+      if (core >= 0 && core < core_num) {
+        core_node_[core] = static_cast<int>(node_cores_.size());
+      }
+    }
+    node_ids_.push_back(node_id);
+    node_cores_.push_back(cores);
+  }
+  if (node_cores_.empty()) {
+    THREAD_INFO("no numa info found, treat the host as a single node");
+    std::vector<int> cores;
+    for (int i = 0; i < core_num; ++i) {
+      cores.push_back(i);
+    }
+    node_ids_.push_back(0);
+    node_cores_.push_back(cores);
+    return THREAD_ERROR;
+  }
+  THREAD_INFO("numa node num: %zu", node_cores_.size());
+  return THREAD_OK;
+}
+
+int NumaAffinity::NodeOfCore(int core) const {
+  if (core < 0 || core >= static_cast<int>(core_node_.size())) {
+    return 0;
+  }
+  return core_node_[core];
+}
+
+int NumaAffinity::CurrentNode() const {
+#ifdef BIND_NUMA
+  if (node_num() > 1) {
+    return NodeOfCore(sched_getcpu());
+  }
+#endif  // BIND_NUMA
+  return 0;
+}
+
+int NumaAffinity::SetPreferredNode(int node) {
+  int prev_node = preferred_node;
+  preferred_node = node;
+  return prev_node;
+}
+
+int NumaAffinity::PreferredNode() const {
+  if (preferred_node >= 0 && preferred_node < static_cast<int>(node_num())) {
+    return preferred_node;
+  }
+  return CurrentNode();
+}
+
+int NumaAffinity::BindThreads(const std::vector<Worker *> &workers, int node) const {
+  if (node < 0 || node >= static_cast<int>(node_num())) {
+    THREAD_ERROR("invalid numa node: %d", node);
+    return THREAD_ERROR;
+  }
+#ifdef BIND_NUMA
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int core : node_cores_[node]) {
+    CPU_SET(core, &mask);
+  }
+  // the threads are free to move between the cores of the node
+  for (auto worker : workers) {
+    int ret = pthread_setaffinity_np(worker->thread.native_handle(), sizeof(cpu_set_t), &mask);
+    if (ret != THREAD_OK) {
+      THREAD_ERROR("bind thread to numa node %d failed", node);
+      return THREAD_ERROR;
+    }
+  }
+#endif  // BIND_NUMA
+  return THREAD_OK;
+}
+
+int NumaAffinity::BindCurrentThread(int node) const {
+  if (node < 0 || node >= static_cast<int>(node_num())) {
+    THREAD_ERROR("invalid numa node: %d", node);
+    return THREAD_ERROR;
+  }
+#ifdef BIND_NUMA
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  for (int core : node_cores_[node]) {
+    CPU_SET(core, &mask);
+  }
+  if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &mask) != THREAD_OK) {
+    THREAD_ERROR("bind current thread to numa node %d failed", node);
+    return THREAD_ERROR;
+  }
+#endif  // BIND_NUMA
+  return THREAD_OK;
+}
+
+int NumaAffinity::BindMemory(void *addr, size_t size, int node) const {
+  if (node < 0 || node >= static_cast<int>(node_num())) {
+    THREAD_ERROR("invalid numa node: %d", node);
+    return THREAD_ERROR;
+  }
+#if defined(BIND_NUMA) && defined(SYS_mbind)
+  if (node_num() <= 1) {
+    return THREAD_OK;
+  }
+  constexpr size_t kBitsPerLong = sizeof(unsigned long) * 8;
+  unsigned long node_mask[kMaxNumaNodes / kBitsPerLong] = {0};
+  int node_id = node_ids_[node];
+  node_mask[node_id / kBitsPerLong] |= 1UL << (node_id % kBitsPerLong);
+  // the kernel takes maxnode as the bit count plus one
+  long ret = syscall(SYS_mbind, addr, size, kMpolPreferred, node_mask, kMaxNumaNodes + 1, 0);
+  if (ret != 0) {
+    THREAD_ERROR("bind memory to numa node %d failed", node);
+    return THREAD_ERROR;
+  }
+#endif
+  return THREAD_OK;
+}
+}  // namespace mindspore
@@ -0,0 +1,83 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_NUMA_AFFINITY_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_NUMA_AFFINITY_H_
+
+#include <stddef.h>
+#include <string>
+#include <vector>
+
+#if defined(__linux__) && !defined(__ANDROID__)
+#define BIND_NUMA
+#endif
+
+namespace mindspore {
+
+struct Worker;
+
+// NumaAffinity discovers the NUMA nodes from sysfs (no libnuma dependency) and binds threads and memory to them.
+// A host without NUMA information is treated as a single node which contains all the cores.
+class NumaAffinity {
+ public:
+  static NumaAffinity *GetInstance();
+  ~NumaAffinity() = default;
+
+  size_t node_num() const { return node_cores_.size(); }
+  const std::vector<int> &NodeCores(int node) const { return node_cores_[node]; }
+  // returns the index of the node which the core belongs to, 0 for the unknown core
+  int NodeOfCore(int core) const;
+  // returns the index of the node which the calling thread is running on
+  int CurrentNode() const;
+
+  // the node on which the memory allocated by the calling thread should be placed,
+  // the node of the running core is used if not set, returns the node set before
+  static int SetPreferredNode(int node);
+  int PreferredNode() const;
+
+  int BindThreads(const std::vector<Worker *> &workers, int node) const;
+  int BindCurrentThread(int node) const;
+  // the pages of [addr, addr + size) are preferably placed on the node, addr must be page aligned
+  int BindMemory(void *addr, size_t size, int node) const;
+
+  // parse the list format of sysfs, such as "0-3,8,10-11"
+  static std::vector<int> ParseList(const std::string &list);
+
+ private:
+  NumaAffinity() = default;
+  int InitNumaInfo();
+
+  // node_cores_ contains the cores of each node, the index of node_cores_ is the index of node
+  std::vector<std::vector<int>> node_cores_;
+  // node_ids_ contains the id of each node used by the operating system
+  std::vector<int> node_ids_;
+  std::vector<int> core_node_;
+};
+
+// sets the preferred node of the calling thread for the scope, and restores the one set before when leaving it
+class PreferredNodeGuard {
+ public:
+  explicit PreferredNodeGuard(int node) : prev_node_(NumaAffinity::SetPreferredNode(node)) {}
+  ~PreferredNodeGuard() { (void)NumaAffinity::SetPreferredNode(prev_node_); }
+  PreferredNodeGuard(const PreferredNodeGuard &) = delete;
+  PreferredNodeGuard &operator=(const PreferredNodeGuard &) = delete;
+
+ private:
+  int prev_node_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_NUMA_AFFINITY_H_
@@ -18,6 +18,7 @@
 #include <unistd.h>
 #include <algorithm>
 #include "thread/core_affinity.h"
+#include "thread/numa_affinity.h"
 
 namespace mindspore {
 
@@ -77,8 +78,12 @@ void ThreadPool::KernelThreadRun(Worker *worker) {
     if (task == nullptr) {
       return;
     }
-    task->status |= task->func(task->content, ++task->task_id);
-    ++task->finished;
+    if (task_policy_ == kWorkStealing) {
+      StealingKernelRun(worker);
+    } else {
+      task->status |= task->func(task->content, ++task->task_id);
+      ++task->finished;
+    }
     worker->task = nullptr;
     {
       std::lock_guard<std::mutex> _l(pool_mutex_);
@@ -105,6 +110,9 @@ void ThreadPool::ThreadAsyncRun(Worker *worker) {
 
 int ThreadPool::ParallelLaunch(const Func &func, Contend contend, int task_num) {
   THREAD_INFO("parallel launch, task num: %d", task_num);
+  if (task_policy_ == kWorkStealing) {
+    return StealingParallelLaunch(func, contend, task_num);
+  }
   // distribute task to the KernelThread and the free ActorThread,
   // if the task num is greater than the KernelThread num
   Task task = Task(func, contend);
@@ -138,6 +146,89 @@ void ThreadPool::DistributeTask(Task *task, int task_num) {
   }
 }
 
+int ThreadPool::StealingParallelLaunch(const Func &func, Contend contend, int task_num) {
+  Task task = Task(func, contend);
+  task.task_num = task_num;
+  // take the free KernelThreads without waiting, the busy ones are replaced by stealing
+  std::vector<Worker *> assigned;
+  if (task_num > 1) {
+    std::lock_guard<std::mutex> _l(pool_mutex_);
+    size_t num = std::min(freelist_.size(), static_cast<size_t>(task_num - 1));
+    assigned.assign(freelist_.end() - num, freelist_.end());
+    freelist_.resize(freelist_.size() - num);
+  }
+  // split the task ids into contiguous blocks, the launcher takes the first one
+  int thread_num = static_cast<int>(assigned.size()) + 1;
+  int block = task_num / thread_num;
+  int remain = task_num % thread_num;
+  int launcher_end = block + (remain > 0 ? 1 : 0);
+  task.queues.reserve(thread_num);
+  for (int i = 0; i < thread_num; ++i) {
+    task.queues.emplace_back(new WorkStealingQueue<int>(launcher_end));
+  }
+  int begin = launcher_end;
+  for (int i = 1; i < thread_num; ++i) {
+    Worker *worker = assigned[i - 1];
+    worker->queue_index = static_cast<size_t>(i);
+    worker->task_begin = begin;
+    worker->task_end = begin + block + (i < remain ? 1 : 0);
+    begin = worker->task_end;
+  }
+  task.attached = static_cast<int>(assigned.size());
+  for (auto &worker : assigned) {
+    worker->task = &task;
+    sem_post(&worker->sem);
+  }
+  WorkStealingQueue<int> *launcher_queue = task.queues.front().get();
+  for (int i = 0; i < launcher_end; ++i) {
+    launcher_queue->Push(i);
+  }
+  RunStealingTask(&task, launcher_queue);
+  // synchronization
+  // the task and its deques live in this stack frame, wait until no worker holds it
+  while (task.attached != 0) {
+    std::this_thread::yield();
+  }
+  if (task.status != THREAD_OK) {
+    return THREAD_ERROR;
+  }
+  return THREAD_OK;
+}
+
+void ThreadPool::StealingKernelRun(Worker *worker) {
+  Task *task = worker->task;
+  WorkStealingQueue<int> *queue = task->queues[worker->queue_index].get();
+  for (int i = worker->task_begin; i < worker->task_end; ++i) {
+    queue->Push(i);
+  }
+  RunStealingTask(task, queue);
+  // the task must not be touched after detached
+  --task->attached;
+}
+
+void ThreadPool::RunStealingTask(Task *task, WorkStealingQueue<int> *queue) const {
+  size_t queue_num = task->queues.size();
+  size_t victim = 0;
+  int task_id = 0;
+  while (task->finished < task->task_num) {
+    bool found = queue->Pop(&task_id);
+    // the own deque is drained, steal from the others
+    for (size_t i = 0; !found && i < queue_num; ++i) {
+      WorkStealingQueue<int> *victim_queue = task->queues[(victim + i) % queue_num].get();
+      if (victim_queue != queue && victim_queue->Steal(&task_id)) {
+        victim = (victim + i) % queue_num;
+        found = true;
+      }
+    }
+    if (!found) {
+      std::this_thread::yield();
+      continue;
+    }
+    task->status |= task->func(task->content, task_id);
+    ++task->finished;
+  }
+}
+
 int ThreadPool::InitAffinityInfo() {
   affinity_ = new (std::nothrow) CoreAffinity();
   THREAD_ERROR_IF_NULL(affinity_);
@@ -183,11 +274,24 @@ int ThreadPool::SetProcessAffinity(BindMode bind_mode) const {
 #endif  // BIND_CORE
 }
 
-ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num) {
+int ThreadPool::SetNumaAffinity(int node) {
+  if (workers_.empty()) {
+    return THREAD_ERROR;
+  }
+  int ret = NumaAffinity::GetInstance()->BindThreads(workers_, node);
+  if (ret != THREAD_OK) {
+    return THREAD_ERROR;
+  }
+  numa_node_ = node;
+  return THREAD_OK;
+}
+
+ThreadPool *ThreadPool::CreateThreadPool(size_t thread_num, TaskPolicy policy) {
   ThreadPool *pool = new (std::nothrow) ThreadPool();
   if (pool == nullptr) {
     return nullptr;
   }
+  pool->task_policy_ = policy;
   int ret = pool->CreateThreads(thread_num);
   if (ret != THREAD_OK) {
     delete pool;
@@ -26,6 +26,7 @@
 #include <mutex>
 #include <new>
 #include "thread/core_affinity.h"
+#include "thread/work_stealing_queue.h"
 
 namespace mindspore {
 
@@ -56,6 +57,9 @@ namespace mindspore {
 
 enum ThreadRet { THREAD_OK = 0, THREAD_ERROR = 1 };
 enum ThreadType { kActorThread = 0, kKernelThread = 1 };
+// kSemaphoreDispatch: each task id is posted to one free worker, the launcher waits for the slowest one
+// kWorkStealing: task ids are split over the per-thread deques, idle threads steal from the busy ones
+enum TaskPolicy { kSemaphoreDispatch = 0, kWorkStealing = 1 };
 
 using Func = int (*)(void *arg, int);
 using Contend = void *;
@@ -67,12 +71,22 @@ typedef struct Task {
   std::atomic_int task_id{0};
   std::atomic_int finished{0};
   std::atomic_int status{THREAD_OK};  // return status, RET_OK
+  // used by kWorkStealing only
+  int task_num{0};
+  // deques of all the threads taking part in the task, the first one is the launcher's. They live with the task,
+  // so a thread still stealing from a finished task never takes the ids of a later one.
+  std::vector<std::unique_ptr<WorkStealingQueue<int>>> queues;
+  std::atomic_int attached{0};  // workers which still hold the task
 } Task;
 
 typedef struct Worker {
   std::thread thread;
   std::atomic_int type{kActorThread};
   Task *task{nullptr};
+  // used by kWorkStealing only
+  size_t queue_index{0};
+  int task_begin{0};
+  int task_end{0};
   sem_t sem;
   sem_t init;
   int spin{0};
@@ -80,15 +94,19 @@ typedef struct Worker {
 
 class ThreadPool {
  public:
-  static ThreadPool *CreateThreadPool(size_t thread_num);
+  static ThreadPool *CreateThreadPool(size_t thread_num, TaskPolicy policy = kSemaphoreDispatch);
   virtual ~ThreadPool();
 
   size_t thread_num() const { return thread_num_; }
+  TaskPolicy task_policy() const { return task_policy_; }
 
   int SetCpuAffinity(const std::vector<int> &core_list);
   int SetCpuAffinity(BindMode bind_mode);
 
   int SetProcessAffinity(BindMode bind_mode) const;
+  // bind all the threads to the cores of one numa node
+  int SetNumaAffinity(int node);
+  int numa_node() const { return numa_node_; }
 
   int ParallelLaunch(const Func &func, Contend contend, int task_num);
 
@@ -105,6 +123,10 @@ class ThreadPool {
 
   void DistributeTask(Task *task, int task_num);
 
+  int StealingParallelLaunch(const Func &func, Contend contend, int task_num);
+  void StealingKernelRun(Worker *worker);
+  void RunStealingTask(Task *task, WorkStealingQueue<int> *queue) const;
+
   std::mutex pool_mutex_;
 
   std::vector<Worker *> workers_;
@@ -113,6 +135,8 @@ class ThreadPool {
 
   size_t inter_thread_num_{0};
   size_t thread_num_{1};
+  TaskPolicy task_policy_{kSemaphoreDispatch};
+  int numa_node_{-1};
 
   CoreAffinity *affinity_{nullptr};
 };
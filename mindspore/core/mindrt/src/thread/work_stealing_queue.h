@@ -0,0 +1,129 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
+#define MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace mindspore {
+// implement a Chase-Lev work stealing deque,
+// only the owner thread can Push and Pop at the bottom, any thread can Steal at the top
+template <class T>
+class WorkStealingQueue {
+ public:
+  WorkStealingQueue(const WorkStealingQueue &) = delete;
+  WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+  explicit WorkStealingQueue(int64_t queue_size = kDefaultQueueSize) : top_(0), bottom_(0) {
+    int64_t capacity = 1;
+    while (capacity < queue_size) {
+      capacity <<= 1;
+    }
+    buffers_.emplace_back(new Buffer(capacity));
+    buffer_.store(buffers_.back().get(), std::memory_order_relaxed);
+  }
+  virtual ~WorkStealingQueue() = default;
+
+  bool Empty() const {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    return b <= t;
+  }
+
+  // called by the owner thread only
+  void Push(T item) {
+    int64_t b = bottom_.load(std::memory_order_relaxed);
+    int64_t t = top_.load(std::memory_order_acquire);
+    Buffer *buf = buffer_.load(std::memory_order_relaxed);
+    if (b - t > buf->capacity - 1) {
+      buf = Grow(buf, t, b);
+    }
+    buf->Put(b, item);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom_.store(b + 1, std::memory_order_relaxed);
+  }
+
+  // called by the owner thread only, take the latest pushed item
+  bool Pop(T *item) {
+    int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+    Buffer *buf = buffer_.load(std::memory_order_relaxed);
+    bottom_.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t t = top_.load(std::memory_order_relaxed);
+    if (t > b) {  // empty
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    *item = buf->Get(b);
+    if (t == b) {
+      // the last item, race against the thieves
+      bool success = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+      bottom_.store(b + 1, std::memory_order_relaxed);
+      return success;
+    }
+    return true;
+  }
+
+  // called by any thread, take the earliest pushed item
+  bool Steal(T *item) {
+    int64_t t = top_.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    int64_t b = bottom_.load(std::memory_order_acquire);
+    if (t >= b) {  // empty
+      return false;
+    }
+    Buffer *buf = buffer_.load(std::memory_order_acquire);
+    T ret = buf->Get(t);
+    if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      // lost the race against the owner or another thief
+      return false;
+    }
+    *item = ret;
+    return true;
+  }
+
+ private:
+  static constexpr int64_t kDefaultQueueSize = 64;
+
+  struct Buffer {
+    explicit Buffer(int64_t size) : capacity(size), mask(size - 1), items(new std::atomic<T>[size]) {}
+    T Get(int64_t index) const { return items[index & mask].load(std::memory_order_relaxed); }
+    void Put(int64_t index, T item) { items[index & mask].store(item, std::memory_order_relaxed); }
+    int64_t capacity;
+    int64_t mask;
+    std::unique_ptr<std::atomic<T>[]> items;
+  };
+
+  Buffer *Grow(Buffer *buf, int64_t t, int64_t b) {
+    Buffer *new_buf = new Buffer(buf->capacity << 1);
+    for (int64_t i = t; i < b; ++i) {
+      new_buf->Put(i, buf->Get(i));
+    }
+    // the old buffers may still be read by the thieves, release them with the queue
+    buffers_.emplace_back(new_buf);
+    buffer_.store(new_buf, std::memory_order_release);
+    return new_buf;
+  }
+
+  std::atomic<int64_t> top_;
+  std::atomic<int64_t> bottom_;
+  std::atomic<Buffer *> buffer_{nullptr};
+  std::vector<std::unique_ptr<Buffer>> buffers_;
+};
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CORE_MINDRT_RUNTIME_WORK_STEALING_QUEUE_H_
@@ -26,10 +26,13 @@ from mindspore import log as logger
 __all__ = ['set_seed', 'get_seed', 'set_prefetch_size', 'get_prefetch_size', 'set_num_parallel_workers',
            'get_num_parallel_workers', 'set_numa_enable', 'get_numa_enable', 'set_monitor_sampling_interval',
            'get_monitor_sampling_interval', 'load', 'get_callback_timeout', 'set_auto_num_workers',
-           'get_auto_num_workers', '_init_device_info', 'set_enable_shared_mem', 'get_enable_shared_mem']
+           'get_auto_num_workers', '_init_device_info', 'set_enable_shared_mem', 'get_enable_shared_mem',
+           'set_enable_autotune', 'get_enable_autotune', 'set_autotune_interval', 'get_autotune_interval',
+           'set_enable_tensor_pool', 'get_enable_tensor_pool', 'set_file_split_size', 'get_file_split_size']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
+INT64_MAX = 9223372036854775807
 
 _config = cde.GlobalContext.config_manager()
 _dynamic_columns = dict()
@@ -412,3 +415,137 @@ def set_enable_shared_mem(enable):
         >>> ds.config.set_enable_shared_mem(True)
     """
     _config.set_enable_shared_mem(enable)
+
+
+def set_enable_autotune(enable):
+    """
+    Set whether the number of workers of map and batch operations and the connector sizes are tuned
+    while the pipeline runs. (This feature is turned off by default)
+    If turned on, the pipeline is watched periodically and workers are added to the operation that keeps
+    the device queue waiting, as long as CPU is available. Each decision is logged at INFO level.
+
+    Args:
+        enable (bool): Whether to enable the pipeline autotuner or not.
+
+    Raises:
+        TypeError: If enable is not of boolean type.
+
+    Examples:
+        >>> ds.config.set_enable_autotune(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable isn't of type bool.")
+    _config.set_enable_autotune(enable)
+
+
+def get_enable_autotune():
+    """
+    Get whether the pipeline autotuner is turned on.
+
+    Returns:
+        bool, whether the pipeline autotuner is turned on.
+
+    Examples:
+        >>> enabled = ds.config.get_enable_autotune()
+    """
+    return _config.get_enable_autotune()
+
+
+def set_autotune_interval(interval):
+    """
+    Set the interval (in milliseconds) between two decisions of the pipeline autotuner.
+
+    Args:
+        interval (int): Interval (in milliseconds) to be used by the pipeline autotuner.
+
+    Raises:
+        ValueError: If interval is invalid (<= 0 or > UINT32_MAX).
+
+    Examples:
+        >>> ds.config.set_autotune_interval(200)
+    """
+    if interval <= 0 or interval > UINT32_MAX:
+        raise ValueError("Interval given is not within the required range.")
+    _config.set_autotune_interval(interval)
+
+
+def get_autotune_interval():
+    """
+    Get the interval (in milliseconds) between two decisions of the pipeline autotuner.
+
+    Returns:
+        int, interval (in milliseconds) of the pipeline autotuner.
+    """
+    return _config.get_autotune_interval()
+
+
+def set_enable_tensor_pool(enable):
+    """
+    Set whether each pipeline recycles the memory of the tensors it releases. (This feature is turned off by default)
+    If turned on, the memory of a row is reused for the next rows of the same shape, and the operations whose
+    output has the shape and type of their input, such as random flips, write it in place.
+
+    Args:
+        enable (bool): Whether to enable the tensor pool or not.
+
+    Raises:
+        TypeError: If enable is not of boolean type.
+
+    Examples:
+        >>> ds.config.set_enable_tensor_pool(True)
+    """
+    if not isinstance(enable, bool):
+        raise TypeError("enable isn't of type bool.")
+    _config.set_enable_tensor_pool(enable)
+
+
+def get_enable_tensor_pool():
+    """
+    Get whether the tensor pool of the pipelines is turned on.
+
+    Returns:
+        bool, whether the tensor pool is turned on.
+
+    Examples:
+        >>> enabled = ds.config.get_enable_tensor_pool()
+    """
+    return _config.get_enable_tensor_pool()
+
+
+def set_file_split_size(size):
+    """
+    Set the number of bytes of a file that CSVDataset and TFRecordDataset give to one parallel worker.
+    (This feature is turned off by default)
+    If set, a file larger than the size is read by several workers at once, each of them starting at the first
+    record after the beginning of its part of the file. Otherwise each worker reads whole files.
+    TFRecordDataset with shard_equal_rows=True reads whole files only, and fails if the size is set.
+
+    Args:
+        size (int): Number of bytes of a file read by one worker, 0 to read whole files.
+
+    Raises:
+        TypeError: If size is not of type int.
+        ValueError: If size is invalid (< 0 or > INT64_MAX).
+
+    Examples:
+        >>> # Let the workers read a large file in parts of 64MB.
+        >>> ds.config.set_file_split_size(64 * 1024 * 1024)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > INT64_MAX:
+        raise ValueError("File split size given is not within the required range.")
+    _config.set_file_split_size(size)
+
+
+def get_file_split_size():
+    """
+    Get the number of bytes of a file read by one worker of CSVDataset and TFRecordDataset.
+
+    Returns:
+        int, number of bytes of a file read by one worker, 0 if workers read whole files.
+
+    Examples:
+        >>> split_size = ds.config.get_file_split_size()
+    """
+    return _config.get_file_split_size()
@@ -76,11 +76,13 @@ class Shuffle(str, Enum):
     GLOBAL: str = "global"
     FILES: str = "files"
     INFILE: str = "infile"
+    BLOCK: str = "block"
 
 
 ShuffleToShuffleMode = {Shuffle.FILES: cde.ShuffleMode.FILES,
                         Shuffle.GLOBAL: cde.ShuffleMode.GLOBAL,
-                        Shuffle.INFILE: cde.ShuffleMode.INFILE}
+                        Shuffle.INFILE: cde.ShuffleMode.INFILE,
+                        Shuffle.BLOCK: cde.ShuffleMode.BLOCK}
 
 
 def shuffle_to_shuffle_mode(shuffle):
@@ -528,7 +530,7 @@ class Dataset:
         return SyncWaitDataset(self, condition_name, num_batch, callback)
 
     @check_shuffle
-    def shuffle(self, buffer_size):
+    def shuffle(self, buffer_size, exchange_group=None, num_ranks=None, rank=None, exchange_size=None):
         """
         Randomly shuffles the rows of this dataset using the following algorithm:
 
@@ -541,10 +543,25 @@ class Dataset:
         A seed can be provided to be used on the first epoch. In every subsequent
         epoch, the seed is changed to a new one, randomly generated value.
 
+        With data parallel training, each rank only shuffles the rows of its own shard. The shuffles of
+        the ranks can swap rows with each other through an exchange group: each time exchange_size new
+        rows have entered its buffer, a rank swaps that many random rows of its buffer with the other
+        ranks. Every rank still gets as many rows as its shard has.
+
         Args:
             buffer_size (int): The size of the buffer (must be larger than 1) for
                 shuffling. Setting buffer_size equal to the number of rows in the entire
                 dataset will result in a global shuffle.
+            exchange_group (str, optional): The group of ranks to swap rows with (default=None, rows
+                are not swapped). A group of the form "tcp://host:port" is for ranks in separate
+                processes, possibly on separate hosts, with rank 0 listening on that address. Any other
+                name is for ranks whose pipelines run in this process.
+            num_ranks (int, optional): The number of ranks in the exchange group (default=None). It is
+                required with exchange_group.
+            rank (int, optional): The rank of this pipeline in the exchange group (default=None). It is
+                required with exchange_group.
+            exchange_size (int, optional): The number of rows swapped in a round, in the range
+                [1, buffer_size] (default=None). It is required with exchange_group.
 
         Returns:
             ShuffleDataset, dataset shuffled.
@@ -558,8 +575,11 @@ class Dataset:
             >>> ds.config.set_seed(58)
             >>> # Create a shuffled dataset using a shuffle buffer of size 4
             >>> dataset = dataset.shuffle(4)
+            >>> # Swap 2 rows at a time with the other 7 ranks, rank 0 listening on port 8200 of host1
+            >>> dataset = dataset.shuffle(4, exchange_group="tcp://host1:8200", num_ranks=8, rank=0,
+            ...                           exchange_size=2)
         """
-        return ShuffleDataset(self, buffer_size)
+        return ShuffleDataset(self, buffer_size, exchange_group, num_ranks, rank, exchange_size)
 
     def flat_map(self, func):
         """
@@ -1792,6 +1812,8 @@ class SourceDataset(Dataset):
                 self.shuffle_flag = 1  # Files shuffle
             elif shuffle == Shuffle.INFILE:
                 self.shuffle_flag = 3  # Infile shuffle
+            elif shuffle == Shuffle.BLOCK:
+                raise ValueError("Shuffle.BLOCK is only supported by MindDataset.")
 
     def parse(self, children=None):
         raise NotImplementedError("Dataset has to implement parse method.")
@@ -2330,21 +2352,33 @@ class ShuffleDataset(Dataset):
     Args:
         input_dataset (Dataset): Input Dataset to be shuffled.
         buffer_size (int): Size of the buffer.
+        exchange_group (str, optional): Group of ranks to swap rows with (default=None).
+        num_ranks (int, optional): Number of ranks in the exchange group (default=None).
+        rank (int, optional): Rank of this pipeline in the exchange group (default=None).
+        exchange_size (int, optional): Number of rows swapped in a round (default=None).
 
     Raises:
         RuntimeError: If exist sync operators before shuffle.
     """
 
-    def __init__(self, input_dataset, buffer_size):
+    def __init__(self, input_dataset, buffer_size, exchange_group=None, num_ranks=None, rank=None,
+                 exchange_size=None):
         super().__init__(children=input_dataset)
         self.buffer_size = buffer_size
         self.reshuffle_each_epoch = True
+        self.exchange_group = exchange_group
+        self.num_ranks = num_ranks
+        self.rank = rank
+        self.exchange_size = exchange_size
 
         if self.is_sync():
             raise RuntimeError("No shuffle after sync operators.")
 
     def parse(self, children=None):
-        return cde.ShuffleNode(children[0], self.buffer_size, self.reshuffle_each_epoch)
+        if self.exchange_group is None:
+            return cde.ShuffleNode(children[0], self.buffer_size, self.reshuffle_each_epoch, "", 1, 0, 0)
+        return cde.ShuffleNode(children[0], self.buffer_size, self.reshuffle_each_epoch, self.exchange_group,
+                               self.num_ranks, self.rank, self.exchange_size)
 
     def is_shuffled(self):
         return True
@@ -3263,7 +3297,7 @@ class MindDataset(MappableDataset):
             (default=None, performs global shuffle).
             If shuffle is False, no shuffling will be performed;
             If shuffle is True, the behavior is the same as setting shuffle to be Shuffle.GLOBAL
-            Otherwise, there are three levels of shuffling:
+            Otherwise, there are four levels of shuffling:
 
             - Shuffle.GLOBAL: Global shuffle of all rows of data in dataset.
 
@@ -3271,6 +3305,9 @@ class MindDataset(MappableDataset):
 
             - Shuffle.INFILE: Keep the file sequence the same but shuffle the data within each file.
 
+            - Shuffle.BLOCK: Shuffle the blob pages, then shuffle the data within each window of pages,
+              so that the blobs are read page by page.
+
         num_shards (int, optional): Number of shards that the dataset will be divided into (default=None).
             When this argument is specified, 'num_samples' reflects the max sample number of per shard.
         shard_id (int, optional): The shard ID within num_shards (default=None). This
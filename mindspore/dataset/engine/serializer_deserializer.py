@@ -294,7 +294,8 @@ def create_dataset_operation_node(node, dataset_op):
         pyobj = de.Dataset().repeat(node.get('count'))
 
     elif dataset_op == 'Shuffle':
-        pyobj = de.Dataset().shuffle(node.get('buffer_size'))
+        pyobj = de.Dataset().shuffle(node.get('buffer_size'), node.get('exchange_group'), node.get('num_ranks'),
+                                     node.get('rank'), node.get('exchange_size'))
 
     elif dataset_op == 'Skip':
         pyobj = de.Dataset().skip(node.get('count'))
@@ -603,12 +603,27 @@ def check_shuffle(method):
 
     @wraps(method)
     def new_method(self, *args, **kwargs):
-        [buffer_size], _ = parse_user_args(method, *args, **kwargs)
+        [buffer_size, exchange_group, num_ranks, rank, exchange_size], _ = parse_user_args(method, *args, **kwargs)
 
         type_check(buffer_size, (int,), "buffer_size")
 
         check_value(buffer_size, [2, INT32_MAX], "buffer_size")
 
+        if exchange_group is None:
+            if num_ranks is not None or rank is not None or exchange_size is not None:
+                raise ValueError("num_ranks, rank and exchange_size are only used with exchange_group.")
+        else:
+            type_check(exchange_group, (str,), "exchange_group")
+            if not exchange_group:
+                raise ValueError("exchange_group should not be empty.")
+            for param, param_name in ((num_ranks, "num_ranks"), (rank, "rank"), (exchange_size, "exchange_size")):
+                if param is None:
+                    raise ValueError("{} is required with exchange_group.".format(param_name))
+                type_check(param, (int,), param_name)
+            check_value(num_ranks, [1, INT32_MAX], "num_ranks")
+            check_value(rank, [0, num_ranks - 1], "rank")
+            check_value(exchange_size, [1, buffer_size], "exchange_size")
+
         return method(self, *args, **kwargs)
 
     return new_method
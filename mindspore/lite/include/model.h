@@ -60,6 +60,10 @@ struct MS_API Model {
   /// \brief Static method to create a Model pointer.
   static Model *Import(const char *filename);
 
+  /// \brief Static method to create a Model pointer by mapping the model file into memory. The weights are kept in the
+  /// mapped pages without copy, which are shared by the sessions and the processes loading the same model file.
+  static Model *ImportMapped(const char *filename);
+
   /// \brief  method to export model to file.
   static int Export(Model *model, const char *filename);
 
@@ -138,6 +138,7 @@ set(LITE_SRC
         ${LITE_DIR}/src/registry/register_kernel.cc
         ${LITE_DIR}/src/registry/register_kernel_impl.cc
         ${LITE_DIR}/src/lite_model.cc
+        ${LITE_DIR}/src/pack_weight_manager.cc
         ${LITE_DIR}/src/tensorlist.cc
         ${LITE_DIR}/src/tensor.cc
         ${LITE_DIR}/src/weight_decoder.cc
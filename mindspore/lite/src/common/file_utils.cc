@@ -22,11 +22,13 @@
 #include <fcntl.h>
 #include <unistd.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
 #include <dirent.h>
 #endif
 
 #include <cstdlib>
 #include <climits>
+#include <cerrno>
 #include "securec/include/securec.h"
 
 #ifdef _WIN32
@@ -76,6 +78,71 @@ char *ReadFile(const char *file, size_t *size) {
   return buf.release();
 }
 
+MappedFile::~MappedFile() {
+  if (data_ == nullptr) {
+    return;
+  }
+#ifdef _WIN32
+  delete[](data_);
+#else
+  if (munmap(data_, size_) != 0) {
+    MS_LOG(ERROR) << "munmap failed, errno: " << errno;
+  }
+#endif
+  data_ = nullptr;
+}
+
+std::shared_ptr<MappedFile> MappedFile::Map(const char *file) {
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "file is nullptr";
+    return nullptr;
+  }
+#ifdef _WIN32
+  // mmap is not supported, fall back to read the whole file.
+  size_t size = 0;
+  auto data = ReadFile(file, &size);
+  if (data == nullptr) {
+    return nullptr;
+  }
+#else
+  std::string real_path = RealPath(file);
+  if (real_path.empty()) {
+    return nullptr;
+  }
+  int fd = open(real_path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    MS_LOG(ERROR) << "file: " << real_path << " open failed";
+    return nullptr;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+    MS_LOG(ERROR) << "file: " << real_path << " is empty or can't be stat";
+    close(fd);
+    return nullptr;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  // The writable private mapping keeps the pages read-only shared until some kernel writes them.
+  auto addr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (addr == MAP_FAILED) {
+    MS_LOG(ERROR) << "mmap file: " << real_path << " failed, errno: " << errno;
+    return nullptr;
+  }
+  auto data = reinterpret_cast<char *>(addr);
+#endif
+  auto mapped_file = new (std::nothrow) MappedFile(data, size);
+  if (mapped_file == nullptr) {
+    MS_LOG(ERROR) << "new mapped file failed";
+#ifdef _WIN32
+    delete[](data);
+#else
+    (void)munmap(data, size);
+#endif
+    return nullptr;
+  }
+  return std::shared_ptr<MappedFile>(mapped_file);
+}
+
 std::string RealPath(const char *path) {
   if (path == nullptr) {
     MS_LOG(ERROR) << "path is nullptr";
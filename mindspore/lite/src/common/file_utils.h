@@ -31,6 +31,22 @@ namespace mindspore {
 namespace lite {
 char *ReadFile(const char *file, size_t *size);
 
+// The file mapped into memory with the copy-on-write pages. The clean pages are backed by the page cache and shared by
+// all the mappings of the file in the processes, only the written pages are copied.
+class MappedFile {
+ public:
+  ~MappedFile();
+  char *data() const { return data_; }
+  size_t size() const { return size_; }
+
+  static std::shared_ptr<MappedFile> Map(const char *file);
+
+ private:
+  MappedFile(char *data, size_t size) : data_(data), size_(size) {}
+  char *data_ = nullptr;
+  size_t size_ = 0;
+};
+
 std::string RealPath(const char *path);
 
 int CreateOutputDir(std::string *dir);
@@ -24,6 +24,7 @@
 #include <memory>
 #include "src/common/prim_util.h"
 #include "src/common/graph_util.h"
+#include "src/pack_weight_manager.h"
 #ifdef ENABLE_V0
 #include "src/ops/compat/compat_register.h"
 #endif
@@ -95,6 +96,14 @@ int LiteModel::ConvertAttrToTensors() {
 #endif
 
 void LiteModel::Free() {
+  if (this->buf != nullptr) {
+    PackWeightManager::GetInstance()->DeleteModelBuf(this->buf);
+  }
+  if (this->mapped_file_ != nullptr) {
+    // The mapped pages are released when the sessions referring to the weights in them are released too.
+    this->buf = nullptr;
+    this->mapped_file_ = nullptr;
+  }
   if (this->buf != nullptr) {
     free(this->buf);
     this->buf = nullptr;
@@ -416,6 +425,33 @@ Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf) {
   return model;
 }
 
+Model *ImportFromMappedFile(const char *filename) {
+  auto mapped_file = MappedFile::Map(filename);
+  if (mapped_file == nullptr) {
+    MS_LOG(ERROR) << "Map model file failed";
+    return nullptr;
+  }
+  if (mapped_file->size() > kMaxModelBufferSize) {
+    MS_LOG(ERROR) << "Input model file size invalid, require (0, 2GB].";
+    return nullptr;
+  }
+  auto *model = new (std::nothrow) LiteModel();
+  if (model == nullptr) {
+    MS_LOG(ERROR) << "new model fail!";
+    return nullptr;
+  }
+  model->buf = mapped_file->data();
+  model->buf_size_ = mapped_file->size();
+  model->mapped_file_ = mapped_file;
+  auto status = model->ConstructModel();
+  if (status != RET_OK) {
+    MS_LOG(ERROR) << "construct model failed.";
+    delete model;
+    return nullptr;
+  }
+  return model;
+}
+
 std::unique_ptr<char[]> ReadFileToBuf(const std::string &filename, size_t *size) {
   std::ifstream ifs(filename, std::ifstream::in | std::ifstream::binary);
   if (!ifs.good()) {
@@ -468,6 +504,8 @@ Model *Model::Import(const char *filename) {
   return ImportFromBuffer(buf.get(), size, false);
 }
 
+Model *Model::ImportMapped(const char *filename) { return ImportFromMappedFile(filename); }
+
 int Model::Export(Model *model, char *buffer, size_t *len) {
   if (len == nullptr) {
     MS_LOG(ERROR) << "len is nullptr";
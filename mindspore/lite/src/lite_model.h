@@ -19,12 +19,14 @@
 
 #include <string>
 #include <vector>
+#include <memory>
 #include "include/errorcode.h"
 #include "include/model.h"
 #include "include/version.h"
 #include "schema/model_generated.h"
 #include "src/common/common.h"
 #include "src/common/log_adapter.h"
+#include "src/common/file_utils.h"
 #include "src/common/version_manager.h"
 #ifdef ENABLE_V0
 #include "schema/model_v0_generated.h"
@@ -47,6 +49,9 @@ class LiteModel : public Model {
 
   ~LiteModel() override { Destroy(); }
 
+  // The mapped model file which the buf points to, nullptr if the model is imported from the buffer.
+  const std::shared_ptr<MappedFile> &mapped_file() const { return mapped_file_; }
+
  private:
 #ifdef ENABLE_V0
   int ConvertAttrs(Model::Node *node, std::vector<schema::Tensor *> *dst_tensor);
@@ -234,9 +239,15 @@ class LiteModel : public Model {
 
  protected:
   std::vector<char *> attr_tensor_bufs_;
+
+ private:
+  std::shared_ptr<MappedFile> mapped_file_ = nullptr;
+
+  friend Model *ImportFromMappedFile(const char *filename);
 };
 
 Model *ImportFromBuffer(const char *model_buf, size_t size, bool take_buf);
+Model *ImportFromMappedFile(const char *filename);
 }  // namespace lite
 }  // namespace mindspore
 
@@ -28,6 +28,7 @@
 #include "src/common/graph_util.h"
 #include "src/kernel_registry.h"
 #include "src/lite_model.h"
+#include "src/pack_weight_manager.h"
 #include "src/weight_decoder.h"
 #ifdef ENABLE_MINDRT
 #include "src/mindrt_executor.h"
@@ -413,6 +414,12 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
+  // The const tensors refer to the mapped pages of model file, keep them alive even if the model is freed.
+  model_mapped_file_ = reinterpret_cast<LiteModel *>(model)->mapped_file();
+  if (!is_train_session_) {
+    // The packed weights of the kernels are shared by the inference sessions created from the same model.
+    PackWeightManager::GetInstance()->InitByBuf(model->buf, reinterpret_cast<LiteModel *>(model)->buf_size_);
+  }
   // scheduler kernels
 #if SUPPORT_NPU
   Scheduler scheduler(context_, model, &tensors_, is_train_session_, npu_manager_, npu_pass_manager_);
@@ -844,6 +851,8 @@ session::LiteSession *session::LiteSession::CreateSession(const char *model_buf,
     MS_LOG(ERROR) << "Compile model failed";
     return nullptr;
   }
+  // The model buffer is owned by the caller, which may free it at any time.
+  lite::PackWeightManager::GetInstance()->DeleteModelBuf(model->buf);
   model->buf = nullptr;
   (reinterpret_cast<lite::LiteSession *>(session))->set_model(model);
   return session;
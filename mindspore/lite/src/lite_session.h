@@ -31,6 +31,7 @@
 #include "src/executor.h"
 #include "src/tensor.h"
 #include "src/tensorlist.h"
+#include "src/common/file_utils.h"
 #if SUPPORT_NPU
 #include "src/runtime/agent/npu/npu_manager.h"
 #include "src/runtime/agent/npu/optimizer/npu_pass_manager.h"
@@ -133,6 +134,7 @@ class LiteSession : public session::LiteSession {
   std::unordered_map<std::string, mindspore::tensor::MSTensor *> output_tensor_map_;
   Executor *executor_ = nullptr;
   Model *model_ = nullptr;
+  std::shared_ptr<MappedFile> model_mapped_file_ = nullptr;
   std::atomic<bool> is_running_ = false;
   bool is_train_session_ = false;
   friend class TransferSession;
@@ -0,0 +1,143 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/pack_weight_manager.h"
+#include <cstdlib>
+#include <cstring>
+#include "include/errorcode.h"
+#include "src/common/log_adapter.h"
+
+namespace mindspore::lite {
+PackWeightManager *PackWeightManager::GetInstance() {
+  static PackWeightManager instance;
+  return &instance;
+}
+
+void PackWeightManager::InitByBuf(const char *model_buf, size_t size) {
+  if (model_buf == nullptr || size == 0) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  model_bufs_[model_buf] = size;
+}
+
+void PackWeightManager::DeleteModelBuf(const char *model_buf) {
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto buf_iter = model_bufs_.find(model_buf);
+  if (buf_iter == model_bufs_.end()) {
+    return;
+  }
+  auto buf_end = model_buf + buf_iter->second;
+  model_bufs_.erase(buf_iter);
+  for (auto iter = shared_weights_.begin(); iter != shared_weights_.end();) {
+    auto origin_weight = static_cast<const char *>(std::get<0>(iter->first));
+    if (origin_weight >= model_buf && origin_weight < buf_end) {
+      iter->second->shared_ = false;
+      iter = shared_weights_.erase(iter);
+    } else {
+      ++iter;
+    }
+  }
+}
+
+bool PackWeightManager::IsInModelBuf(const void *origin_weight) const {
+  auto weight = static_cast<const char *>(origin_weight);
+  auto iter = model_bufs_.upper_bound(weight);
+  if (iter == model_bufs_.begin()) {
+    return false;
+  }
+  --iter;
+  return weight < iter->first + iter->second;
+}
+
+void *PackWeightManager::GetPackedWeight(const void *origin_weight, size_t packed_size, int pack_layout,
+                                         const std::function<int(void *)> &pack_func) {
+  if (origin_weight == nullptr || packed_size == 0) {
+    MS_LOG(ERROR) << "The origin weight is nullptr or the packed size is 0.";
+    return nullptr;
+  }
+  PackedWeight *packed_weight = nullptr;
+  {
+    std::lock_guard<std::mutex> locker(mutex_);
+    auto key = std::make_tuple(origin_weight, packed_size, pack_layout);
+    bool shared = IsInModelBuf(origin_weight);
+    if (shared) {
+      auto iter = shared_weights_.find(key);
+      if (iter != shared_weights_.end()) {
+        packed_weight = iter->second;
+      }
+    }
+    if (packed_weight == nullptr) {
+      packed_weight = new (std::nothrow) PackedWeight();
+      if (packed_weight == nullptr) {
+        MS_LOG(ERROR) << "new packed weight failed.";
+        return nullptr;
+      }
+      packed_weight->data_ = malloc(packed_size);
+      if (packed_weight->data_ == nullptr) {
+        MS_LOG(ERROR) << "malloc packed weight failed, size: " << packed_size;
+        delete packed_weight;
+        return nullptr;
+      }
+      packed_weight->key_ = key;
+      packed_weight->shared_ = shared;
+      packed_weights_[packed_weight->data_] = packed_weight;
+      if (shared) {
+        shared_weights_[key] = packed_weight;
+      }
+    }
+    packed_weight->ref_count_++;
+  }
+  bool pack_failed = false;
+  {
+    // The kernels sharing the packed weight wait for the first one packing it.
+    std::lock_guard<std::mutex> locker(packed_weight->mutex_);
+    if (!packed_weight->packed_) {
+      memset(packed_weight->data_, 0, packed_size);
+      pack_failed = (pack_func(packed_weight->data_) != RET_OK);
+      packed_weight->packed_ = !pack_failed;
+    }
+  }
+  if (pack_failed) {
+    MS_LOG(ERROR) << "pack weight failed.";
+    FreePackedWeight(packed_weight->data_);
+    return nullptr;
+  }
+  return packed_weight->data_;
+}
+
+void PackWeightManager::FreePackedWeight(void *packed_weight) {
+  if (packed_weight == nullptr) {
+    return;
+  }
+  std::lock_guard<std::mutex> locker(mutex_);
+  auto iter = packed_weights_.find(packed_weight);
+  if (iter == packed_weights_.end()) {
+    MS_LOG(ERROR) << "The packed weight is not allocated by the pack weight manager.";
+    return;
+  }
+  auto weight = iter->second;
+  if (--weight->ref_count_ > 0) {
+    return;
+  }
+  packed_weights_.erase(iter);
+  if (weight->shared_) {
+    (void)shared_weights_.erase(weight->key_);
+  }
+  free(weight->data_);
+  delete weight;
+}
+}  // namespace mindspore::lite
@@ -0,0 +1,78 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_PACK_WEIGHT_MANAGER_H_
+#define MINDSPORE_LITE_SRC_PACK_WEIGHT_MANAGER_H_
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <functional>
+#include <unordered_map>
+
+namespace mindspore::lite {
+// The pack layouts of the kernels, the packed weights of the same origin weight are shared only in the same layout.
+enum PackLayout : int {
+  kConvIm2ColLayout = 0,
+  kConv1x1Layout,
+  kAdderLayout,
+  kMatmulBLayout,
+  kMatmulBTransposeLayout,
+  kVecMatmulBLayout,
+  kVecMatmulBTransposeLayout,
+};
+
+// The process-wide cache of the packed const weights. The kernels of the sessions created from the same model share
+// the packed weight, which is keyed by the origin weight in the model buffer, the packed size and the pack layout.
+class PackWeightManager {
+ public:
+  static PackWeightManager *GetInstance();
+  virtual ~PackWeightManager() = default;
+
+  // Enable sharing the packed weights whose origin weights are in the model buffer.
+  void InitByBuf(const char *model_buf, size_t size);
+  // Stop sharing the packed weights of the model buffer, because the buffer may be reused by another model after freed.
+  // The packed weights are still used by the kernels referring to them.
+  void DeleteModelBuf(const char *model_buf);
+
+  // Get the packed weight of origin weight filled with zero and packed by the pack function. The pack function is
+  // called only once for the shared packed weight. Return nullptr if failed.
+  void *GetPackedWeight(const void *origin_weight, size_t packed_size, int pack_layout,
+                        const std::function<int(void *)> &pack_func);
+  // Release the reference of the packed weight, it's freed if no kernel refers to it.
+  void FreePackedWeight(void *packed_weight);
+
+ private:
+  PackWeightManager() = default;
+  using PackedWeightKey = std::tuple<const void *, size_t, int>;
+  struct PackedWeight {
+    std::mutex mutex_;
+    bool packed_ = false;
+    bool shared_ = false;
+    PackedWeightKey key_;
+    void *data_ = nullptr;
+    size_t ref_count_ = 0;
+  };
+  bool IsInModelBuf(const void *origin_weight) const;
+
+  std::mutex mutex_;
+  // The model buffers enabled to share the packed weights, map of the buffer address to the buffer size.
+  std::map<const char *, size_t> model_bufs_;
+  std::map<PackedWeightKey, PackedWeight *> shared_weights_;
+  // All the packed weights including the unshared ones, map of the packed weight data to the packed weight.
+  std::unordered_map<void *, PackedWeight *> packed_weights_;
+};
+}  // namespace mindspore::lite
+#endif  // MINDSPORE_LITE_SRC_PACK_WEIGHT_MANAGER_H_
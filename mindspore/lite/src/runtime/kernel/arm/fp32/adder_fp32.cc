@@ -72,13 +72,16 @@ int AdderCPUKernel::InitWeightBias() {
   int pack_weight_size = oc_block_num * oc_block * in_channel * kernel_plane;
 
   auto origin_weight = reinterpret_cast<float *>(filter_tensor->MutableData());
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
+  auto pack_func = [origin_weight, out_channel, in_channel, kernel_plane](void *packed_weight) {
+    RowMajor2Col4Major(origin_weight, reinterpret_cast<float *>(packed_weight), out_channel, in_channel * kernel_plane);
+    return RET_OK;
+  };
+  packed_weight_ = reinterpret_cast<float *>(lite::PackWeightManager::GetInstance()->GetPackedWeight(
+    origin_weight, pack_weight_size * sizeof(float), lite::kAdderLayout, pack_func));
   if (packed_weight_ == nullptr) {
     MS_LOG(ERROR) << "malloc packed weight failed.";
     return RET_ERROR;
   }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
-  RowMajor2Col4Major(origin_weight, packed_weight_, out_channel, in_channel * kernel_plane);
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * oc_block * sizeof(float)));
   if (bias_data_ == nullptr) {
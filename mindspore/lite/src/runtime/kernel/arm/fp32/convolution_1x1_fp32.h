@@ -23,6 +23,7 @@
 #include "include/errorcode.h"
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
+#include "src/pack_weight_manager.h"
 #include "src/runtime/kernel/arm/base/layout_transform.h"
 #include "nnacl/base/conv1x1_base.h"
 #include "nnacl/fp32/common_func_fp32.h"
@@ -46,19 +46,24 @@ int ConvolutionCPUKernel::InitWeightBias() {
   size_t oc_block_num = UP_ROUND(out_channel, OC_BLOCK);
   size_t pack_weight_size = oc_block_num * in_channel * kernel_plane;
 
-  packed_weight_ = reinterpret_cast<float *>(malloc(pack_weight_size * sizeof(float)));
-  if (packed_weight_ == nullptr) {
-    MS_LOG(ERROR) << "malloc packed weight failed.";
-    return RET_ERROR;
-  }
-  memset(packed_weight_, 0, pack_weight_size * sizeof(float));
+  // The packed weight is shared by the sessions created from the same model.
+  auto pack_func = [this, out_channel, in_channel, kernel_plane](void *packed_weight) {
+    auto dst = reinterpret_cast<float *>(packed_weight);
 #ifdef ENABLE_AVX
-  RowMajor2Col16Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col16Major(origin_weight_, dst, out_channel, in_channel * kernel_plane);
 #elif ENABLE_ARM32
-  RowMajor2Col4Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col4Major(origin_weight_, dst, out_channel, in_channel * kernel_plane);
 #else
-  RowMajor2Col8Major(origin_weight_, packed_weight_, out_channel, in_channel * kernel_plane);
+    RowMajor2Col8Major(origin_weight_, dst, out_channel, in_channel * kernel_plane);
 #endif
+    return RET_OK;
+  };
+  packed_weight_ = reinterpret_cast<float *>(lite::PackWeightManager::GetInstance()->GetPackedWeight(
+    origin_weight_, pack_weight_size * sizeof(float), lite::kConvIm2ColLayout, pack_func));
+  if (packed_weight_ == nullptr) {
+    MS_LOG(ERROR) << "malloc packed weight failed.";
+    return RET_ERROR;
+  }
 
   bias_data_ = reinterpret_cast<float *>(malloc(oc_block_num * sizeof(float)));
   if (bias_data_ == nullptr) {
@@ -21,6 +21,7 @@
 #include "src/inner_kernel.h"
 #include "nnacl/op_base.h"
 #include "src/runtime/kernel/arm/base/convolution_base.h"
+#include "src/pack_weight_manager.h"
 
 namespace mindspore::kernel {
 class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
@@ -33,7 +34,7 @@ class ConvolutionCPUKernel : public ConvolutionBaseCPUKernel {
         origin_bias_(origin_bias) {}
   ~ConvolutionCPUKernel() override {
     if (packed_weight_ != nullptr) {
-      free(packed_weight_);
+      lite::PackWeightManager::GetInstance()->FreePackedWeight(packed_weight_);
       packed_weight_ = nullptr;
     }
   }
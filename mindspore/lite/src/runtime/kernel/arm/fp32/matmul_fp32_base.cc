@@ -251,6 +251,12 @@ void MatmulFp32BaseCPUKernel::FreeResizeBufA() {
 }
 
 void MatmulFp32BaseCPUKernel::FreeResizeBufB() {
+  // The packed const matrix b is got from the pack weight manager, release it before dropping the pointer.
+  if (b_pack_ptr_ != nullptr && params_->b_const_) {
+    lite::PackWeightManager::GetInstance()->FreePackedWeight(b_pack_ptr_);
+    b_pack_ptr_ = nullptr;
+    return;
+  }
   if (!op_parameter_->is_train_session_) {
     if (b_pack_ptr_ != nullptr) {
       context_->allocator->Free(b_pack_ptr_);
@@ -333,10 +339,24 @@ int MatmulFp32BaseCPUKernel::ReSize() {
 #endif
 
   if (params_->b_const_ == true && src_b_ != nullptr) {
-    if (RET_OK != InitBufferB()) {
+    // The packed const matrix b is shared by the sessions created from the same model, the layout of it depends on
+    // whether it's vector matmul and whether it's transposed.
+    auto pack_func = [this](void *packed_weight) {
+      b_pack_ptr_ = reinterpret_cast<float *>(packed_weight);
+      return InitMatrixB(src_b_);
+    };
+    lite::PackLayout layout;
+    if (vec_matmul_) {
+      layout = params_->b_transpose_ ? lite::kVecMatmulBTransposeLayout : lite::kVecMatmulBLayout;
+    } else {
+      layout = params_->b_transpose_ ? lite::kMatmulBTransposeLayout : lite::kMatmulBLayout;
+    }
+    b_pack_ptr_ = reinterpret_cast<float *>(lite::PackWeightManager::GetInstance()->GetPackedWeight(
+      in_tensors_[1]->data_c(), matrix_b_pack_size_ * sizeof(float), layout, pack_func));
+    if (b_pack_ptr_ == nullptr) {
+      MS_LOG(ERROR) << "malloc b_pack_ptr_ failed";
       return RET_ERROR;
     }
-    InitMatrixB(src_b_);
     free(src_b_);
     src_b_ = nullptr;
   }
@@ -19,6 +19,7 @@
 
 #include <vector>
 #include "src/inner_kernel.h"
+#include "src/pack_weight_manager.h"
 #include "nnacl/matmul_parameter.h"
 #include "include/errorcode.h"
 
@@ -25,6 +25,7 @@
 #include "src/common/graph_util.h"
 #include "src/common/utils.h"
 #include "src/kernel_registry.h"
+#include "src/lite_model.h"
 #include "include/registry/register_kernel.h"
 #include "src/lite_kernel_util.h"
 #include "src/sub_graph_kernel.h"
@@ -362,11 +363,14 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
       MS_LOG(DEBUG) << "CastConstTensorsData failed: " << ret;
       return RET_NOT_SUPPORT;
     }
-    // we don't need to restore tensor for copy data
-    ret = CopyConstTensorData(in_tensors, op_type);
-    if (ret != RET_OK) {
-      MS_LOG(DEBUG) << "CopyConstTensorsData failed: " << ret;
-      return RET_NOT_SUPPORT;
+    // we don't need to restore tensor for copy data, and the const data of mapped model is kept in the mapped pages
+    // which live as long as the session
+    if (reinterpret_cast<LiteModel *>(src_model_)->mapped_file() == nullptr) {
+      ret = CopyConstTensorData(in_tensors, op_type);
+      if (ret != RET_OK) {
+        MS_LOG(DEBUG) << "CopyConstTensorsData failed: " << ret;
+        return RET_NOT_SUPPORT;
+      }
     }
   }
   ret = KernelRegistry::GetInstance()->GetKernel(in_tensors, out_tensors, context_, cpu_desc, op_parameter, kernel);
@@ -16,6 +16,7 @@
 
 #include <cmath>
 #include <memory>
+#include <fstream>
 #include "schema/inner/model_generated.h"
 #include "mindspore/lite/include/model.h"
 #include "common/common_test.h"
@@ -233,6 +234,92 @@ TEST_F(InferTest, TestAddNode) {
   MS_LOG(INFO) << "Passed";
 }
 
+TEST_F(InferTest, TestMappedModel) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_AddFusion;
+  auto primitive = new schema::AddFusionT;
+  node->primitive->value.value = primitive;
+  node->name = "Add";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input0 = std::make_unique<schema::TensorT>();
+  input0->nodeType = lite::NodeType_ValueNode;
+  input0->format = schema::Format_NHWC;
+  input0->dataType = TypeId::kNumberTypeFloat32;
+  input0->dims = {1, 28, 28, 3};
+  input0->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input0));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_NHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {1, 28, 28, 3};
+  std::vector<float> weight_data(28 * 28 * 3, 1.0f);
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  std::string model_path = "./mapped_model.ms";
+  {
+    std::ofstream ofs(model_path, std::ios::binary);
+    ASSERT_TRUE(ofs.good());
+    ofs.write(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  }
+
+  auto model = lite::Model::ImportMapped(model_path.c_str());
+  ASSERT_NE(nullptr, model);
+  auto context = new lite::InnerContext;
+  context->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context->thread_num_ = 2;
+  ASSERT_EQ(lite::RET_OK, context->Init());
+  auto session = session::LiteSession::CreateSession(context);
+  ASSERT_NE(nullptr, session);
+  auto ret = session->CompileGraph(model);
+  ASSERT_EQ(lite::RET_OK, ret);
+  // The weights in the mapped pages are kept alive by the session.
+  model->Free();
+  auto inputs = session->GetInputs();
+  ASSERT_EQ(inputs.size(), 1);
+  auto *in_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  ASSERT_NE(nullptr, in_data);
+  for (int i = 0; i < 28 * 28 * 3; i++) {
+    in_data[i] = i;
+  }
+  ret = session->RunGraph();
+  ASSERT_EQ(lite::RET_OK, ret);
+  auto outputs = session->GetOutputs();
+  ASSERT_EQ(outputs.size(), 1);
+  auto *out_data = reinterpret_cast<float *>(outputs.begin()->second->MutableData());
+  ASSERT_NE(nullptr, out_data);
+  for (int i = 0; i < 28 * 28 * 3; i++) {
+    ASSERT_EQ(i + 1.0f, out_data[i]);
+  }
+  delete session;
+  delete model;
+  delete context;
+  (void)remove(model_path.c_str());
+}
+
 class SessionWithParallelExecutor : public lite::LiteSession {
  public:
   int Init(lite::InnerContext *context) {
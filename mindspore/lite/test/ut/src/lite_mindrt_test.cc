@@ -13,12 +13,19 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <sys/mman.h>
 #include "actor/actor.h"
 #include "actor/op_actor.h"
 #include "async/uuid_base.h"
 #include "async/future.h"
+#include "async/async.h"
+#include "mindrt/include/mindrt.hpp"
 #include "src/lite_mindrt.h"
 #include "thread/hqueue.h"
+#include "thread/inter_threadpool.h"
+#include "thread/numa_affinity.h"
+#include "thread/threadpool.h"
+#include "thread/work_stealing_queue.h"
 #include "common/common_test.h"
 
 namespace mindspore {
@@ -89,4 +96,358 @@ TEST_F(LiteMindRtTest, HQueueTest) {
     delete v2[s];
   }
 }
+
+TEST_F(LiteMindRtTest, MpscQueueTest) {
+  MpscQueue<MessageBase> mq;
+  ASSERT_EQ(mq.Empty(), true);
+  ASSERT_EQ(mq.Dequeue(), nullptr);
+  const int producer_num = 8;
+  const int msg_num = 2000;
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_num; p++) {
+    producers.emplace_back([&mq, p]() {
+      for (int i = 0; i < msg_num; i++) {
+        mq.Enqueue(new MessageBase(std::to_string(p) + ":" + std::to_string(i)));
+      }
+    });
+  }
+
+  // messages from the same producer keep their order
+  std::vector<int> counts(producer_num, 0);
+  int received = 0;
+  while (received < producer_num * msg_num) {
+    MessageBase *msg = mq.Dequeue();
+    if (msg == nullptr) {
+      continue;
+    }
+    std::string name = msg->Name();
+    size_t pos = name.find(':');
+    ASSERT_NE(pos, std::string::npos);
+    int p = std::stoi(name.substr(0, pos));
+    ASSERT_EQ(std::stoi(name.substr(pos + 1)), counts[p]);
+    counts[p]++;
+    received++;
+    delete msg;
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  for (int p = 0; p < producer_num; p++) {
+    ASSERT_EQ(counts[p], msg_num);
+  }
+  ASSERT_EQ(mq.Empty(), true);
+  ASSERT_EQ(mq.Dequeue(), nullptr);
+}
+
+namespace {
+class MsgOrderActor : public ActorBase {
+ public:
+  MsgOrderActor(const std::string &name, int producer_num) : ActorBase(name), next_(producer_num, 0) {}
+  ~MsgOrderActor() override = default;
+  // runs in the actor, one message at a time
+  void Record(int producer, int seq) {
+    if (seq != next_[producer]) {
+      out_of_order_++;
+    }
+    next_[producer] = seq + 1;
+    received_++;
+  }
+  int received() const { return received_; }
+  int out_of_order() const { return out_of_order_; }
+  const std::vector<int> &next() const { return next_; }
+
+ private:
+  std::vector<int> next_;
+  int out_of_order_{0};
+  std::atomic_int received_{0};
+};
+}  // namespace
+
+// messages from many producers to one actor all arrive, and the messages of each producer keep their order
+TEST_F(LiteMindRtTest, ActorMailboxTest) {
+  const int producer_num = 4;
+  const int msg_num = 1000;
+  InterThreadPool *pool = InterThreadPool::CreateThreadPool(2);
+  ASSERT_NE(pool, nullptr);
+  auto actor = std::make_shared<MsgOrderActor>("MsgOrderActor", producer_num);
+  actor->set_thread_pool(pool);
+  auto aid = Spawn(actor);
+  std::vector<std::thread> producers;
+  for (int p = 0; p < producer_num; p++) {
+    producers.emplace_back([&aid, p]() {
+      for (int i = 0; i < msg_num; i++) {
+        Async(aid, &MsgOrderActor::Record, p, i);
+      }
+    });
+  }
+  for (auto &producer : producers) {
+    producer.join();
+  }
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (actor->received() < producer_num * msg_num && std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::yield();
+  }
+  ASSERT_EQ(actor->received(), producer_num * msg_num);
+  ASSERT_EQ(actor->out_of_order(), 0);
+  for (int p = 0; p < producer_num; p++) {
+    ASSERT_EQ(actor->next()[p], msg_num);
+  }
+  Terminate(aid);
+  Await(aid);
+  delete pool;
+}
+
+TEST_F(LiteMindRtTest, WorkStealingQueueTest) {
+  WorkStealingQueue<int> wsq(4);
+  const int item_num = 20000;
+  std::atomic_int owner_sum{0};
+  std::atomic_int thief_sum{0};
+  std::atomic_int taken{0};
+
+  std::thread owner([&]() {
+    int item = 0;
+    for (int i = 1; i <= item_num; i++) {
+      wsq.Push(i);
+      if (i % 3 == 0 && wsq.Pop(&item)) {
+        owner_sum += item;
+        taken++;
+      }
+    }
+    while (wsq.Pop(&item)) {
+      owner_sum += item;
+      taken++;
+    }
+  });
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; t++) {
+    thieves.emplace_back([&]() {
+      int item = 0;
+      while (taken < item_num) {
+        if (wsq.Steal(&item)) {
+          thief_sum += item;
+          taken++;
+        }
+      }
+    });
+  }
+  owner.join();
+  for (auto &thief : thieves) {
+    thief.join();
+  }
+  ASSERT_EQ(taken, item_num);
+  ASSERT_EQ(owner_sum + thief_sum, item_num * (item_num + 1) / 2);
+  ASSERT_EQ(wsq.Empty(), true);
+}
+
+namespace {
+struct ImbalancedTask {
+  std::vector<std::atomic_int> *hits;
+  int heavy_stride;
+};
+
+int RunImbalancedTask(void *content, int task_id) {
+  auto task = reinterpret_cast<ImbalancedTask *>(content);
+  (*task->hits)[task_id]++;
+  // every heavy_stride-th shard is 100x more expensive, like a ragged batch
+  int loop = task_id % task->heavy_stride == 0 ? 100000 : 1000;
+  volatile float sum = 0;
+  for (int i = 0; i < loop; i++) {
+    sum = sum + i * 0.5f;
+  }
+  return THREAD_OK;
+}
+}  // namespace
+
+TEST_F(LiteMindRtTest, WorkStealingThreadPoolTest) {
+  const int task_nums[] = {1, 4, 64, 1000};
+  for (auto policy : {kSemaphoreDispatch, kWorkStealing}) {
+    ThreadPool *pool = ThreadPool::CreateThreadPool(4, policy);
+    ASSERT_NE(pool, nullptr);
+    ASSERT_EQ(pool->task_policy(), policy);
+    for (int task_num : task_nums) {
+      std::vector<std::atomic_int> hits(task_num);
+      ImbalancedTask task = {&hits, 8};
+      ASSERT_EQ(pool->ParallelLaunch(RunImbalancedTask, &task, task_num), THREAD_OK);
+      for (int i = 0; i < task_num; i++) {
+        ASSERT_EQ(hits[i], 1);
+      }
+    }
+    delete pool;
+  }
+}
+
+namespace {
+struct ScaledTask {
+  std::vector<int> *out;
+  int scale;
+};
+
+int RunScaledTask(void *content, int task_id) {
+  auto task = reinterpret_cast<ScaledTask *>(content);
+  (*task->out)[task_id] += task_id * task->scale;
+  return THREAD_OK;
+}
+
+struct NestedTask {
+  ThreadPool *pool;
+  std::vector<std::vector<int>> *outs;
+};
+
+int RunNestedTask(void *content, int task_id) {
+  auto task = reinterpret_cast<NestedTask *>(content);
+  ScaledTask inner = {&(*task->outs)[task_id], task_id + 1};
+  return task->pool->ParallelLaunch(RunScaledTask, &inner, static_cast<int>(inner.out->size()));
+}
+}  // namespace
+
+// Launches of different funcs follow each other while the workers of the previous one may still be stealing, and
+// tasks launch again from inside the pool, every id must run once with the func of its own launch.
+TEST_F(LiteMindRtTest, WorkStealingRelaunchTest) {
+  ThreadPool *pool = ThreadPool::CreateThreadPool(4, kWorkStealing);
+  ASSERT_NE(pool, nullptr);
+  const int task_num = 37;
+  for (int loop = 0; loop < 200; loop++) {
+    for (int scale = 1; scale <= 2; scale++) {
+      std::vector<int> out(task_num, 0);
+      ScaledTask task = {&out, scale};
+      ASSERT_EQ(pool->ParallelLaunch(RunScaledTask, &task, task_num), THREAD_OK);
+      for (int i = 0; i < task_num; i++) {
+        ASSERT_EQ(out[i], i * scale);
+      }
+    }
+  }
+  for (int loop = 0; loop < 50; loop++) {
+    std::vector<std::vector<int>> outs(8, std::vector<int>(task_num, 0));
+    NestedTask task = {pool, &outs};
+    ASSERT_EQ(pool->ParallelLaunch(RunNestedTask, &task, static_cast<int>(outs.size())), THREAD_OK);
+    for (size_t j = 0; j < outs.size(); j++) {
+      for (int i = 0; i < task_num; i++) {
+        ASSERT_EQ(outs[j][i], i * static_cast<int>(j + 1));
+      }
+    }
+  }
+  delete pool;
+}
+
+namespace {
+struct BlockingTask {
+  std::atomic_int *first;
+  std::atomic_int *finished;
+  std::atomic_bool *timeout;
+  int task_num;
+};
+
+// the first id to run waits until all the others are finished, which needs the other threads to steal the ids
+// queued behind it
+int RunBlockingTask(void *content, int task_id) {
+  auto task = reinterpret_cast<BlockingTask *>(content);
+  int expected = -1;
+  if (task->first->compare_exchange_strong(expected, task_id)) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (*task->finished < task->task_num - 1) {
+      if (std::chrono::steady_clock::now() > deadline) {
+        *task->timeout = true;
+        break;
+      }
+      std::this_thread::yield();
+    }
+    return THREAD_OK;
+  }
+  (*task->finished)++;
+  return THREAD_OK;
+}
+}  // namespace
+
+TEST_F(LiteMindRtTest, WorkStealingStealTest) {
+  const int task_nums[] = {2, 8, 64};
+  for (int task_num : task_nums) {
+    // a new pool has all its workers free, the launcher is never left alone with the blocking id
+    ThreadPool *pool = ThreadPool::CreateThreadPool(4, kWorkStealing);
+    ASSERT_NE(pool, nullptr);
+    std::atomic_int first{-1};
+    std::atomic_int finished{0};
+    std::atomic_bool timeout{false};
+    BlockingTask task = {&first, &finished, &timeout, task_num};
+    ASSERT_EQ(pool->ParallelLaunch(RunBlockingTask, &task, task_num), THREAD_OK);
+    ASSERT_FALSE(timeout) << "task num: " << task_num;
+    ASSERT_EQ(finished, task_num - 1);
+    delete pool;
+  }
+}
+
+TEST_F(LiteMindRtTest, NumaAffinityTest) {
+  ASSERT_EQ(NumaAffinity::ParseList("0-3,8,10-11\n"), std::vector<int>({0, 1, 2, 3, 8, 10, 11}));
+  ASSERT_EQ(NumaAffinity::ParseList("5"), std::vector<int>({5}));
+  ASSERT_TRUE(NumaAffinity::ParseList("").empty());
+
+  auto numa_affinity = NumaAffinity::GetInstance();
+  ASSERT_NE(numa_affinity, nullptr);
+  ASSERT_GE(numa_affinity->node_num(), 1u);
+  for (size_t node = 0; node < numa_affinity->node_num(); ++node) {
+    for (int core : numa_affinity->NodeCores(node)) {
+      ASSERT_EQ(numa_affinity->NodeOfCore(core), static_cast<int>(node));
+    }
+  }
+  ASSERT_EQ(NumaAffinity::SetPreferredNode(0), -1);
+  ASSERT_EQ(numa_affinity->PreferredNode(), 0);
+  ASSERT_EQ(NumaAffinity::SetPreferredNode(-1), 0);
+  // the guard restores the node set before, not the node of the running core
+  int last_node = static_cast<int>(numa_affinity->node_num()) - 1;
+  (void)NumaAffinity::SetPreferredNode(last_node);
+  {
+    PreferredNodeGuard guard(0);
+    ASSERT_EQ(numa_affinity->PreferredNode(), 0);
+  }
+  ASSERT_EQ(numa_affinity->PreferredNode(), last_node);
+  ASSERT_EQ(NumaAffinity::SetPreferredNode(-1), last_node);
+}
+
+namespace {
+struct StreamTask {
+  float *data;
+  size_t size;
+};
+
+int RunStreamTask(void *content, int task_id) {
+  auto task = reinterpret_cast<StreamTask *>(content);
+  const int task_num = 4;
+  size_t stride = task->size / task_num;
+  float *data = task->data + stride * task_id;
+  for (size_t i = 0; i < stride; i++) {
+    data[i] = data[i] * 0.5f + 1.0f;
+  }
+  return THREAD_OK;
+}
+}  // namespace
+
+// the pool bound to a node still sees the whole buffer, wherever its pages are placed
+TEST_F(LiteMindRtTest, NumaThreadPoolTest) {
+  const int task_num = 4;
+  const size_t data_size = 64 * 1024;
+  auto numa_affinity = NumaAffinity::GetInstance();
+  // on the host without numa, the remote node falls back to the local node
+  int local_node = 0;
+  int remote_node = static_cast<int>(numa_affinity->node_num()) - 1;
+  ThreadPool *pool = ThreadPool::CreateThreadPool(task_num);
+  ASSERT_NE(pool, nullptr);
+  ASSERT_EQ(pool->SetNumaAffinity(local_node), THREAD_OK);
+  ASSERT_EQ(pool->numa_node(), local_node);
+  for (int node : {local_node, remote_node}) {
+    size_t bytes = data_size * sizeof(float);
+    void *addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    ASSERT_NE(addr, MAP_FAILED);
+    (void)numa_affinity->BindMemory(addr, bytes, node);
+    auto data = reinterpret_cast<float *>(addr);
+    for (size_t i = 0; i < data_size; i++) {
+      data[i] = static_cast<float>(i % 1024);
+    }
+    StreamTask task = {data, data_size};
+    ASSERT_EQ(pool->ParallelLaunch(RunStreamTask, &task, task_num), THREAD_OK);
+    for (size_t i = 0; i < data_size; i++) {
+      ASSERT_EQ(data[i], static_cast<float>(i % 1024) * 0.5f + 1.0f) << "memory node: " << node << ", index: " << i;
+    }
+    munmap(addr, bytes);
+  }
+  delete pool;
+}
 }  // namespace mindspore
@@ -25,6 +25,7 @@
 #include "src/common/log_adapter.h"
 #include "mindspore/lite/src/lite_kernel.h"
 #include "mindspore/lite/src/lite_kernel_util.h"
+#include "mindspore/lite/src/pack_weight_manager.h"
 
 namespace mindspore {
 class UtilsTest : public mindspore::CommonTest {
@@ -66,4 +67,39 @@ TEST_F(UtilsTest, TestSubgraph) {
   auto output_tensors = kernel::LiteKernelUtil::SubgraphOutputTensors(kernels);
   ASSERT_EQ(output_tensors.size(), 1);
 }
+
+TEST_F(UtilsTest, TestPackWeightManager) {
+  auto manager = lite::PackWeightManager::GetInstance();
+  std::vector<float> model_buf(64, 1.0f);
+  std::vector<float> private_weight(16, 1.0f);
+  int pack_count = 0;
+  auto pack_func = [&pack_count](void *packed_weight) {
+    reinterpret_cast<float *>(packed_weight)[0] = 2.0f;
+    pack_count++;
+    return lite::RET_OK;
+  };
+  manager->InitByBuf(reinterpret_cast<const char *>(model_buf.data()), model_buf.size() * sizeof(float));
+  // The packed weight of the origin weight in the model buffer is shared.
+  auto packed0 = manager->GetPackedWeight(model_buf.data() + 16, 64, lite::kConvIm2ColLayout, pack_func);
+  auto packed1 = manager->GetPackedWeight(model_buf.data() + 16, 64, lite::kConvIm2ColLayout, pack_func);
+  ASSERT_NE(packed0, nullptr);
+  ASSERT_EQ(packed0, packed1);
+  ASSERT_EQ(pack_count, 1);
+  ASSERT_EQ(reinterpret_cast<float *>(packed1)[0], 2.0f);
+  // The different layout and the origin weight out of the model buffer are not shared.
+  auto packed2 = manager->GetPackedWeight(model_buf.data() + 16, 64, lite::kAdderLayout, pack_func);
+  auto packed3 = manager->GetPackedWeight(private_weight.data(), 64, lite::kConvIm2ColLayout, pack_func);
+  auto packed4 = manager->GetPackedWeight(private_weight.data(), 64, lite::kConvIm2ColLayout, pack_func);
+  ASSERT_NE(packed2, packed0);
+  ASSERT_NE(packed3, packed4);
+  ASSERT_EQ(pack_count, 4);
+  // The packed weight is not shared after the model buffer is deleted, but still valid for the kernels using it.
+  manager->DeleteModelBuf(reinterpret_cast<const char *>(model_buf.data()));
+  auto packed5 = manager->GetPackedWeight(model_buf.data() + 16, 64, lite::kConvIm2ColLayout, pack_func);
+  ASSERT_NE(packed5, packed0);
+  ASSERT_EQ(reinterpret_cast<float *>(packed0)[0], 2.0f);
+  for (auto packed : {packed0, packed1, packed2, packed3, packed4, packed5}) {
+    manager->FreePackedWeight(packed);
+  }
+}
 }  // namespace mindspore
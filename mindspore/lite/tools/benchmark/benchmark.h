@@ -81,6 +81,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
     AddFlag(&BenchmarkFlags::loop_count_, "loopCount", "Run loop count", 10);
     AddFlag(&BenchmarkFlags::num_threads_, "numThreads", "Run threads number", 2);
     AddFlag(&BenchmarkFlags::enable_fp16_, "enableFp16", "Enable float16", false);
+    AddFlag(&BenchmarkFlags::use_mmap_, "useMmap", "Load model by mapping the model file into memory", false);
+    AddFlag(&BenchmarkFlags::num_sessions_, "numSessions", "Number of sessions compiled from the same model", 1);
     AddFlag(&BenchmarkFlags::warm_up_loop_count_, "warmUpLoopCount", "Run warm up loop", 3);
     AddFlag(&BenchmarkFlags::time_profiling_, "timeProfiling", "Run time profiling", false);
     AddFlag(&BenchmarkFlags::perf_profiling_, "perfProfiling",
@@ -113,6 +115,8 @@ class MS_API BenchmarkFlags : public virtual FlagParser {
   int loop_count_ = 10;
   int num_threads_ = 2;
   bool enable_fp16_ = false;
+  bool use_mmap_ = false;
+  int num_sessions_ = 1;
   int warm_up_loop_count_ = 3;
   // MarkAccuracy
   std::string benchmark_data_file_;
@@ -277,6 +281,9 @@ class MS_API Benchmark {
 
   int MarkAccuracy();
 
+  // Print the resident memory of the process, to compare the memory usage of the model loading modes.
+  void PrintMemoryUsage();
+
  private:
   BenchmarkFlags *flags_;
   session::LiteSession *session_{nullptr};
@@ -53,11 +53,16 @@ _set_ps_context_func_map = {
     "client_batch_size": ps_context().set_client_batch_size,
     "client_learning_rate": ps_context().set_client_learning_rate,
     "enable_ps_ssl": ps_context().set_enable_ssl,
-    "scheduler_manage_port": ps_context().set_scheduler_manage_port
+    "scheduler_manage_port": ps_context().set_scheduler_manage_port,
+    "gradient_compression": ps_context().set_gradient_compression,
+    "gradient_topk_ratio": ps_context().set_gradient_topk_ratio,
+    "cache_prefetch_depth": ps_context().set_cache_prefetch_depth
 }
 
 _get_ps_context_func_map = {
-    "enable_ps": ps_context().is_ps_mode
+    "enable_ps": ps_context().is_ps_mode,
+    "gradient_compression": ps_context().gradient_compression,
+    "gradient_topk_ratio": ps_context().gradient_topk_ratio
 }
 
 
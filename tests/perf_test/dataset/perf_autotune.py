@@ -0,0 +1,51 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the throughput of a decode heavy pipeline with and without the autotuner"""
+import time
+
+import mindspore.dataset as ds
+import mindspore.dataset.vision.c_transforms as vision
+
+DATA_DIR = "../../ut/data/dataset/testPK/data"
+NUM_REPEAT = 20
+AUTOTUNE_INTERVAL = 20
+
+
+def run_decode_pipeline(name):
+    """the map op starts with a single worker, which the autotuner can grow"""
+    start = time.time()
+    data_set = ds.ImageFolderDataset(DATA_DIR, shuffle=False)
+    data_set = data_set.repeat(NUM_REPEAT)
+    transforms = [vision.Decode(), vision.Resize((256, 256)), vision.CenterCrop((224, 224))]
+    data_set = data_set.map(operations=transforms, input_columns=["image"], num_parallel_workers=1)
+    data_set = data_set.batch(8)
+    num_rows = 0
+    for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+        num_rows += item["image"].shape[0]
+    cost = time.time() - start
+    print("Decode pipeline {} - total rows: {}, cost time: {}s, throughput: {} rows/s".format(
+        name, num_rows, cost, num_rows / cost))
+
+
+if __name__ == '__main__':
+    original_enable = ds.config.get_enable_autotune()
+    original_interval = ds.config.get_autotune_interval()
+    ds.config.set_enable_autotune(False)
+    run_decode_pipeline("with 1 map worker")
+    ds.config.set_enable_autotune(True)
+    ds.config.set_autotune_interval(AUTOTUNE_INTERVAL)
+    run_decode_pipeline("with autotune")
+    ds.config.set_enable_autotune(original_enable)
+    ds.config.set_autotune_interval(original_interval)
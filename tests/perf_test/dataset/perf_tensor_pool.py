@@ -0,0 +1,49 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the throughput of a pipeline of flips and rescales with and without the tensor pool"""
+import time
+
+import mindspore.dataset as ds
+import mindspore.dataset.vision.c_transforms as vision
+
+DATA_DIR = "../../ut/data/dataset/testPK/data"
+NUM_REPEAT = 10
+NUM_PARALLEL_WORKERS = 4
+
+
+def run_pipeline(name):
+    """each op of the map can write its output over its input when the tensor pool is enabled"""
+    start = time.time()
+    data_set = ds.ImageFolderDataset(DATA_DIR, shuffle=False, decode=True)
+    data_set = data_set.repeat(NUM_REPEAT)
+    transforms = [vision.RandomHorizontalFlip(1.0), vision.Rescale(1.0 / 255, 0.0),
+                  vision.RandomVerticalFlip(1.0), vision.Rescale(2.0, -1.0)]
+    data_set = data_set.map(operations=transforms, input_columns=["image"],
+                            num_parallel_workers=NUM_PARALLEL_WORKERS)
+    num_rows = 0
+    for _ in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+        num_rows += 1
+    cost = time.time() - start
+    print("Decode+Flip+Rescale+Flip+Rescale pipeline {} - total rows: {}, cost time: {}s, throughput: {} rows/s".format(
+        name, num_rows, cost, num_rows / cost))
+
+
+if __name__ == '__main__':
+    original_enable = ds.config.get_enable_tensor_pool()
+    ds.config.set_enable_tensor_pool(False)
+    run_pipeline("without the tensor pool")
+    ds.config.set_enable_tensor_pool(True)
+    run_pipeline("with the tensor pool")
+    ds.config.set_enable_tensor_pool(original_enable)
@@ -0,0 +1,79 @@
+# Copyright 2021 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+"""test the blob read throughput of mindspore.mindrecord.FileReader and mindspore.MindDataset"""
+import os
+import time
+
+import mindspore.dataset as ds
+from mindspore.mindrecord import FileReader, FileWriter
+
+MINDRECORD_FILE = "./blob.mindrecord"
+ROW_COUNT = 2048
+BLOB_SIZE = 64 << 10
+NUM_CONSUMER = 4
+
+
+def generate_mindrecord(mindrecord):
+    """each row has the label i and a blob filled with i % 251"""
+    for name in [mindrecord, mindrecord + ".db"]:
+        if os.path.exists(name):
+            os.remove(name)
+    writer = FileWriter(mindrecord, 1)
+    schema = {"file_name": {"type": "string"},
+              "label": {"type": "int32"},
+              "data": {"type": "bytes"}}
+    writer.add_schema(schema, "blob schema")
+    writer.add_index(["label"])
+    rows = [{"file_name": "{}.jpg".format(i), "label": i, "data": bytes([i % 251]) * BLOB_SIZE}
+            for i in range(ROW_COUNT)]
+    writer.write_raw_data(rows)
+    writer.commit()
+
+
+def print_throughput(name, rows, data_bytes, cost):
+    print("Read by {} - total rows: {}, bytes: {}, cost time: {}s, throughput: {} MB/s".format(
+        name, rows, data_bytes, cost, data_bytes / cost / (1 << 20)))
+
+
+def use_filereader(mindrecord):
+    start = time.time()
+    reader = FileReader(file_name=mindrecord, num_consumer=NUM_CONSUMER, columns=["data", "label"])
+    num_iter = 0
+    data_bytes = 0
+    for _, item in enumerate(reader.get_next()):
+        num_iter += 1
+        data_bytes += len(item["data"])
+    reader.close()
+    print_throughput("FileReader", num_iter, data_bytes, time.time() - start)
+
+
+def use_minddataset(mindrecord):
+    start = time.time()
+    data_set = ds.MindDataset(dataset_file=mindrecord,
+                              columns_list=["data", "label"],
+                              num_parallel_workers=NUM_CONSUMER,
+                              shuffle=False)
+    num_iter = 0
+    data_bytes = 0
+    for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+        num_iter += 1
+        data_bytes += item["data"].nbytes
+    print_throughput("MindDataset", num_iter, data_bytes, time.time() - start)
+
+
+if __name__ == '__main__':
+    generate_mindrecord(MINDRECORD_FILE)
+    use_filereader(MINDRECORD_FILE)
+    use_minddataset(MINDRECORD_FILE)
@@ -0,0 +1,144 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
+#include "minddata/dataset/kernels/tensor_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::MsLogLevel::INFO;
+
+std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                           bool shuf = false, std::shared_ptr<SamplerRT> sampler = nullptr,
+                                           std::map<std::string, int32_t> map = {}, bool decode = false);
+
+std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+
+namespace {
+constexpr int32_t kSlowOpDelayMs = 10;
+
+// Stands in for a decode heavy op. The time is spent waiting rather than on the cpu, so the cpu utilization
+// limit of the autotuner does not stop it from adding workers on a small host.
+class SlowOp : public TensorOp {
+ public:
+  explicit SlowOp(int32_t delay_ms) : delay_ms_(delay_ms) {}
+
+  ~SlowOp() override = default;
+
+  Status Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms_));
+    *output = input;
+    return Status::OK();
+  }
+
+  void Print(std::ostream &out) const override { out << "SlowOp"; }
+
+  std::string Name() const override { return "SlowOp"; }
+
+ private:
+  int32_t delay_ms_;
+};
+}  // namespace
+
+class MindDataTestAutoTune : public UT::DatasetOpTesting {
+ protected:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+    original_enable_ = cfg->enable_autotune();
+    original_interval_ = cfg->autotune_interval();
+  }
+
+  void TearDown() override {
+    std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+    cfg->set_enable_autotune(original_enable_);
+    cfg->set_autotune_interval(original_interval_);
+  }
+
+  // Run the 44 images of testPK through a map op that starts with a single worker, and return the largest
+  // number of workers the map op was asked to run while the rows were consumed
+  void RunMapBoundPipeline(int32_t *max_workers) {
+    std::string folder_path = datasets_root_path_ + "/testPK/data";
+    std::shared_ptr<MapOp> map_op;
+    MapOp::Builder builder;
+    builder.SetInColNames({"image"})
+      .SetOutColNames({})
+      .SetTensorFuncs({std::make_shared<SlowOp>(kSlowOpDelayMs)})
+      .SetNumWorkers(1);
+    ASSERT_OK(builder.Build(&map_op));
+    auto tree = Build({ImageFolder(2, 2, 32, folder_path, false), map_op});
+    ASSERT_OK(tree->Prepare());
+    ASSERT_OK(tree->Launch());
+
+    DatasetIterator di(tree);
+    TensorMap tensor_map;
+    ASSERT_OK(di.GetNextAsMap(&tensor_map));
+    uint64_t i = 0;
+    int32_t label = 0;
+    int32_t img_class[] = {0, 1, 2, 3};
+    *max_workers = map_op->target_num_workers();
+    while (tensor_map.size() != 0) {
+      tensor_map["label"]->GetItemAt<int32_t>(&label, {});
+      // Changing the number of workers must neither drop, duplicate nor reorder any row
+      EXPECT_EQ(img_class[i / 11], label) << "row " << i;
+      *max_workers = std::max(*max_workers, map_op->target_num_workers());
+      ASSERT_OK(di.GetNextAsMap(&tensor_map));
+      i++;
+    }
+    EXPECT_EQ(i, 44);
+  }
+
+ private:
+  bool original_enable_;
+  uint32_t original_interval_;
+};
+
+// Without the autotuner the map op keeps its single worker
+TEST_F(MindDataTestAutoTune, TestFixedWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestFixedWorkers.";
+  GlobalContext::config_manager()->set_enable_autotune(false);
+  int32_t max_workers = 0;
+  RunMapBoundPipeline(&max_workers);
+  EXPECT_EQ(max_workers, 1);
+}
+
+// The consumer is starved by the map op, so the autotuner adds workers to it
+TEST_F(MindDataTestAutoTune, TestGrowMapBoundPipeline) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTune-TestGrowMapBoundPipeline.";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  // The map op can grow up to the number of cpu threads
+  if (cfg->num_cpu_threads() < 2) {
+    MS_LOG(INFO) << "Only one cpu thread, the map op has no worker to grow.";
+    return;
+  }
+  cfg->set_enable_autotune(true);
+  cfg->set_autotune_interval(20);
+  int32_t max_workers = 0;
+  RunMapBoundPipeline(&max_workers);
+  EXPECT_GT(max_workers, 1);
+}
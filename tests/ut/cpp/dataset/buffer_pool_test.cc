@@ -0,0 +1,262 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/cv_tensor.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/engine/datasetops/source/image_folder_op.h"
+#include "minddata/dataset/kernels/image/random_horizontal_flip_op.h"
+#include "minddata/dataset/kernels/image/random_vertical_flip_op.h"
+#include "minddata/dataset/kernels/image/rescale_op.h"
+#include "minddata/dataset/util/buffer_pool.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+std::shared_ptr<ImageFolderOp> ImageFolder(int64_t num_works, int64_t rows, int64_t conns, std::string path,
+                                           bool shuf = false, std::shared_ptr<SamplerRT> sampler = nullptr,
+                                           std::map<std::string, int32_t> map = {}, bool decode = false);
+
+std::shared_ptr<ExecutionTree> Build(std::vector<std::shared_ptr<DatasetOp>> ops);
+
+class MindDataTestBufferPool : public UT::Common {
+ public:
+  MindDataTestBufferPool() = default;
+};
+
+TEST_F(MindDataTestBufferPool, TestReuse) {
+  MS_LOG(INFO) << "Doing MindDataTestBufferPool-TestReuse.";
+  std::shared_ptr<BufferPool> pool;
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 1, 1));
+
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(1000, &p));
+  pool->Deallocate(p);
+  // Same size class, the block comes back from the free list
+  void *q = nullptr;
+  ASSERT_OK(pool->Allocate(1010, &q));
+  EXPECT_EQ(q, p);
+  // Another size class needs a new block
+  void *r = nullptr;
+  ASSERT_OK(pool->Allocate(5000, &r));
+  EXPECT_NE(r, q);
+  BufferPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(stats.num_allocations, 3);
+  EXPECT_EQ(stats.num_reuses, 1);
+  EXPECT_EQ(stats.num_upstream_allocations, 2);
+  EXPECT_EQ(stats.cached_bytes, 0);
+
+  // Reallocating into a larger size class keeps the content
+  (void)memset_s(q, 1010, 7, 1010);
+  ASSERT_OK(pool->Reallocate(&q, 1010, 3000));
+  EXPECT_EQ(static_cast<uint8_t *>(q)[1009], 7);
+  pool->Deallocate(q);
+  pool->Deallocate(r);
+  EXPECT_GT(pool->GetStats().cached_bytes, 0);
+}
+
+TEST_F(MindDataTestBufferPool, TestLimits) {
+  MS_LOG(INFO) << "Doing MindDataTestBufferPool-TestLimits.";
+  // Nothing is cached, every block goes back on release
+  std::shared_ptr<BufferPool> pool;
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 0, 1));
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(100, &p));
+  pool->Deallocate(p);
+  ASSERT_OK(pool->Allocate(100, &p));
+  pool->Deallocate(p);
+  BufferPool::Stats stats = pool->GetStats();
+  EXPECT_EQ(stats.num_reuses, 0);
+  EXPECT_EQ(stats.num_upstream_allocations, 2);
+  EXPECT_EQ(stats.cached_bytes, 0);
+
+  // A block larger than an arena comes from malloc, and is recycled like the others
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 8, 1));
+  const size_t large = 3 * 1024 * 1024;
+  ASSERT_OK(pool->Allocate(large, &p));
+  (void)memset_s(p, large, 1, large);
+  pool->Deallocate(p);
+  void *q = nullptr;
+  ASSERT_OK(pool->Allocate(large, &q));
+  EXPECT_EQ(q, p);
+  pool->Deallocate(q);
+}
+
+class MindDataTestInPlaceOps : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestInPlaceOps() : CVOpCommon() {}
+
+ protected:
+  // Run the ops one after the other on copies of the test image
+  // @param hold - Keep a reference to the intermediate tensors of the row, so that no op can write in place
+  void RunRows(const std::vector<std::shared_ptr<TensorOp>> &ops, int32_t num_rows, bool hold) {
+    for (int32_t i = 0; i < num_rows; i++) {
+      std::vector<std::shared_ptr<Tensor>> held;
+      std::shared_ptr<Tensor> current;
+      EXPECT_OK(Tensor::CreateFromTensor(input_tensor_, &current));
+      for (const auto &op : ops) {
+        if (hold) {
+          held.push_back(current);
+        }
+        std::shared_ptr<Tensor> next;
+        EXPECT_OK(op->Compute(current, &next));
+        current = std::move(next);
+      }
+    }
+  }
+};
+
+TEST_F(MindDataTestInPlaceOps, TestInPlace) {
+  MS_LOG(INFO) << "Doing MindDataTestInPlaceOps-TestInPlace.";
+  auto flip = std::make_shared<RandomHorizontalFlipOp>(1.0);
+  auto rescale = std::make_shared<RescaleOp>(0.5, 1.0);
+  std::shared_ptr<Tensor> input;
+  std::shared_ptr<Tensor> output;
+
+  // Outside of a pipeline the input is left alone
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<float>{1, 2, 3, 4, 5, 6}, TensorShape({2, 3, 1}), &input));
+  input = CVTensor::AsCVTensor(input);
+  ASSERT_OK(flip->Compute(input, &output));
+  EXPECT_NE(output->GetBuffer(), input->GetBuffer());
+  float value = 0;
+  ASSERT_OK(input->GetItemAt<float>(&value, {0, 0, 0}));
+  EXPECT_EQ(value, 1);
+
+  std::shared_ptr<BufferPool> pool;
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 1, 1));
+  GlobalContext::set_thread_mem_pool(pool);
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<float>{1, 2, 3, 4, 5, 6}, TensorShape({2, 3, 1}), &input));
+  input = CVTensor::AsCVTensor(input);
+  const uchar *buffer = input->GetBuffer();
+  // The input is owned by the caller alone, the ops overwrite it
+  ASSERT_OK(flip->Compute(input, &output));
+  EXPECT_EQ(output->GetBuffer(), buffer);
+  input = std::move(output);
+  ASSERT_OK(rescale->Compute(input, &output));
+  EXPECT_EQ(output->GetBuffer(), buffer);
+  ASSERT_OK(output->GetItemAt<float>(&value, {0, 0, 0}));
+  EXPECT_EQ(value, 2.5);
+  ASSERT_OK(output->GetItemAt<float>(&value, {1, 2, 0}));
+  EXPECT_EQ(value, 3);
+
+  // Someone else still looks at the input
+  input = output;
+  ASSERT_OK(flip->Compute(input, &output));
+  EXPECT_NE(output->GetBuffer(), input->GetBuffer());
+  GlobalContext::set_thread_mem_pool(nullptr);
+}
+
+// Count the allocations per row of a chain of ops without and with the tensor pool
+TEST_F(MindDataTestInPlaceOps, TestRowAllocations) {
+  MS_LOG(INFO) << "Doing MindDataTestInPlaceOps-TestRowAllocations.";
+  const int32_t num_rows = 20;
+  std::vector<std::shared_ptr<TensorOp>> ops = {
+    std::make_shared<RandomHorizontalFlipOp>(1.0), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+    std::make_shared<RandomVerticalFlipOp>(1.0), std::make_shared<RescaleOp>(2.0, -1.0)};
+
+  // Every row allocates its tensors anew and no op writes in place
+  std::shared_ptr<BufferPool> pool;
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 0, 64));
+  GlobalContext::set_thread_mem_pool(pool);
+  RunRows(ops, num_rows, true);
+  BufferPool::Stats before = pool->GetStats();
+
+  ASSERT_OK(BufferPool::CreateBufferPool(&pool, 512, 64));
+  GlobalContext::set_thread_mem_pool(pool);
+  RunRows(ops, num_rows, false);
+  BufferPool::Stats after = pool->GetStats();
+  GlobalContext::set_thread_mem_pool(nullptr);
+
+  // The copy of the image, then one output per op
+  EXPECT_EQ(before.num_upstream_allocations, num_rows * 5);
+  // The copy of the image and the float image are asked for once per row, and only allocated for the first row
+  EXPECT_EQ(after.num_allocations, num_rows * 2);
+  EXPECT_EQ(after.num_upstream_allocations, 2);
+}
+
+class MindDataTestTensorPoolPipeline : public UT::DatasetOpTesting {
+ protected:
+  // Run ImageFolder and a map of flips and rescales, and return the rows seen by the consumer
+  void RunPipeline(uint64_t *num_rows, BufferPool::Stats *stats) {
+    const int32_t num_repeats = 10;
+    std::string folder_path = datasets_root_path_ + "/testPK/data";
+    auto image_folder_op = ImageFolder(4, 2, 16, folder_path, false, nullptr, {}, true);
+    image_folder_op->set_total_repeats(num_repeats);
+    image_folder_op->set_num_repeats_per_epoch(num_repeats);
+
+    std::shared_ptr<RepeatOp> repeat_op;
+    ASSERT_OK(RepeatOp::Builder(num_repeats).Build(&repeat_op));
+
+    std::vector<std::shared_ptr<TensorOp>> func_list = {
+      std::make_shared<RandomHorizontalFlipOp>(1.0), std::make_shared<RescaleOp>(1.0 / 255, 0.0),
+      std::make_shared<RandomVerticalFlipOp>(1.0), std::make_shared<RescaleOp>(2.0, -1.0)};
+    std::shared_ptr<MapOp> map_op;
+    MapOp::Builder map_builder;
+    map_builder.SetInColNames({"image"}).SetOutColNames({}).SetTensorFuncs(func_list).SetNumWorkers(4);
+    ASSERT_OK(map_builder.Build(&map_op));
+
+    std::shared_ptr<ExecutionTree> tree = Build({image_folder_op, repeat_op, map_op});
+    ASSERT_OK(tree->Prepare());
+    ASSERT_OK(tree->Launch());
+    DatasetIterator di(tree);
+    TensorRow row;
+    ASSERT_OK(di.FetchNextTensorRow(&row));
+    uint64_t i = 0;
+    while (!row.empty()) {
+      EXPECT_EQ(row[0]->type(), DataType::DE_FLOAT32);
+      i++;
+      ASSERT_OK(di.FetchNextTensorRow(&row));
+    }
+    *num_rows = i;
+    if (tree->tensor_pool() != nullptr) {
+      *stats = tree->tensor_pool()->GetStats();
+    }
+  }
+};
+
+// The rows of a pipeline are the same without and with the tensor pool, and the pool gives buffers back to the rows
+TEST_F(MindDataTestTensorPoolPipeline, TestPipelineReuse) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorPoolPipeline-TestPipelineReuse.";
+  std::shared_ptr<ConfigManager> cfg = GlobalContext::config_manager();
+  bool original_enable = cfg->enable_tensor_pool();
+
+  uint64_t rows_before = 0;
+  BufferPool::Stats stats_before;
+  cfg->set_enable_tensor_pool(false);
+  RunPipeline(&rows_before, &stats_before);
+
+  uint64_t rows_after = 0;
+  BufferPool::Stats stats;
+  cfg->set_enable_tensor_pool(true);
+  RunPipeline(&rows_after, &stats);
+  cfg->set_enable_tensor_pool(original_enable);
+
+  // 44 images repeated 10 times
+  EXPECT_EQ(rows_before, 440);
+  EXPECT_EQ(rows_after, rows_before);
+  EXPECT_EQ(stats_before.num_allocations, 0);
+  EXPECT_GT(stats.num_reuses, 0);
+  EXPECT_LT(stats.num_upstream_allocations, stats.num_allocations);
+}
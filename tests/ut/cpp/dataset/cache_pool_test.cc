@@ -0,0 +1,159 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common.h"
+#include "minddata/dataset/engine/cache/cache_numa.h"
+#include "minddata/dataset/engine/cache/cache_pool.h"
+#include "minddata/dataset/engine/cache/cache_server.h"
+#include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/slice.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+namespace {
+const char kPersistName[] = "persist_test";
+const char kMeta[] = "schema of the persisted rows";
+constexpr int64_t kNumRows = 10;
+
+std::string RowData(int64_t key) { return "row " + std::to_string(key) + " of the persistent cache pool"; }
+}  // namespace
+
+class MindDataTestCachePool : public UT::DatasetOpTesting {
+ protected:
+  void SetUp() override {
+    DatasetOpTesting::SetUp();
+    // The pool only needs the server for its configuration, it is never started.
+    CacheServer::Builder builder;
+    builder.SetNumWorkers(1).SetSharedMemorySizeInGB(1).SetMemoryCapRatio(0.5);
+    ASSERT_OK(builder.Build());
+    mp_ = std::make_shared<NumaMemoryPool>(CacheServer::GetInstance().GetHWControl(), 0.5);
+    // Each test spills to its own folder
+    std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    root_ = datasets_root_path_ + "/cache_pool_" + test_name;
+    Path root(root_);
+    ASSERT_OK(root.CreateDirectories());
+  }
+
+  void TearDown() override {
+    Path root(root_);
+    if (root.Exists()) {
+      EXPECT_OK(root.Remove());
+    }
+  }
+
+  // Insert kNumRows rows into a persistent pool and persist it
+  void BuildPersistedPool(uint32_t source_id = 0) {
+    CachePool pool(mp_, root_, kPersistName, source_id);
+    ASSERT_OK(pool.ServiceStart());
+    EXPECT_TRUE(pool.IsPersistent());
+    EXPECT_FALSE(pool.IsReadOnly());
+    for (int64_t key = 0; key < kNumRows; ++key) {
+      std::string data = RowData(key);
+      ASSERT_OK(pool.Insert(key, {ReadableSlice(data.data(), data.size())}));
+    }
+    ASSERT_OK(pool.Persist(kMeta));
+    ASSERT_OK(pool.ServiceStop());
+  }
+
+  std::shared_ptr<NumaMemoryPool> mp_;
+  std::string root_;
+};
+
+TEST_F(MindDataTestCachePool, TestPersistAndReopen) {
+  MS_LOG(INFO) << "Doing MindDataTestCachePool-TestPersistAndReopen.";
+  BuildPersistedPool();
+  // The folder and its index outlive the pool
+  Path index = Path(root_) / kPersistName / "index";
+  ASSERT_TRUE(index.Exists());
+
+  // A later pool of the same name reopens the folder through its index
+  CachePool pool(mp_, root_, kPersistName);
+  ASSERT_OK(pool.ServiceStart());
+  EXPECT_TRUE(pool.IsReadOnly());
+  EXPECT_EQ(pool.GetPersistedMeta(), kMeta);
+  auto stat = pool.GetStat();
+  EXPECT_EQ(stat.min_key, 0);
+  EXPECT_EQ(stat.max_key, kNumRows - 1);
+  EXPECT_EQ(stat.num_mem_cached, 0);
+  EXPECT_EQ(stat.num_disk_cached, kNumRows);
+
+  // Read every row twice, the first read is from the disk and brings the row into memory
+  for (int i = 0; i < 2; ++i) {
+    for (int64_t key = 0; key < kNumRows; ++key) {
+      std::string expected = RowData(key);
+      std::vector<char> buf(expected.size());
+      WritableSlice dest(buf.data(), buf.size());
+      size_t bytes_read = 0;
+      ASSERT_OK(pool.Read(key, &dest, &bytes_read));
+      ASSERT_EQ(bytes_read, expected.size());
+      EXPECT_EQ(std::string(buf.begin(), buf.end()), expected);
+    }
+  }
+  stat = pool.GetStat();
+  EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, kNumRows);
+
+  // No row can be added to a reopened pool
+  std::string data = RowData(kNumRows);
+  EXPECT_ERROR(pool.Insert(kNumRows, {ReadableSlice(data.data(), data.size())}));
+  ASSERT_OK(pool.ServiceStop());
+  // Stopping a reopened pool keeps the folder for the next one
+  EXPECT_TRUE(index.Exists());
+
+  // Clean up the persisted folder through a pool that does not find the index
+  ASSERT_OK(index.Remove());
+  CachePool cleanup(mp_, root_, kPersistName);
+  ASSERT_OK(cleanup.ServiceStart());
+  ASSERT_OK(cleanup.ServiceStop());
+}
+
+TEST_F(MindDataTestCachePool, TestRebuildWithoutIndex) {
+  MS_LOG(INFO) << "Doing MindDataTestCachePool-TestRebuildWithoutIndex.";
+  BuildPersistedPool();
+  // A folder without an index is not complete, it is wiped and rebuilt
+  Path index = Path(root_) / kPersistName / "index";
+  ASSERT_OK(index.Remove());
+
+  CachePool pool(mp_, root_, kPersistName);
+  ASSERT_OK(pool.ServiceStart());
+  EXPECT_FALSE(pool.IsReadOnly());
+  auto stat = pool.GetStat();
+  EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, 0);
+  std::string data = RowData(0);
+  ASSERT_OK(pool.Insert(0, {ReadableSlice(data.data(), data.size())}));
+  // The pool is never persisted, so its folder is removed when it stops
+  ASSERT_OK(pool.ServiceStop());
+  EXPECT_FALSE((Path(root_) / kPersistName).Exists());
+}
+
+TEST_F(MindDataTestCachePool, TestRebuildWhenSourceChanged) {
+  MS_LOG(INFO) << "Doing MindDataTestCachePool-TestRebuildWhenSourceChanged.";
+  BuildPersistedPool(1);
+  Path index = Path(root_) / kPersistName / "index";
+  ASSERT_TRUE(index.Exists());
+
+  // The index was written for other source files, so the rows are stale and the folder is rebuilt
+  CachePool pool(mp_, root_, kPersistName, 2);
+  ASSERT_OK(pool.ServiceStart());
+  EXPECT_FALSE(pool.IsReadOnly());
+  auto stat = pool.GetStat();
+  EXPECT_EQ(stat.num_mem_cached + stat.num_disk_cached, 0);
+  ASSERT_OK(pool.ServiceStop());
+  EXPECT_FALSE((Path(root_) / kPersistName).Exists());
+}
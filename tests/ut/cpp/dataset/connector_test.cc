@@ -23,7 +23,9 @@
 
 
 #include "common/common.h"
+#include "minddata/dataset/core/tensor_row.h"
 #include "minddata/dataset/engine/connector.h"
+#include "minddata/dataset/engine/jagged_connector.h"
 #include "minddata/dataset/util/task_manager.h"
 #include "utils/log_adapter.h"
 
@@ -123,6 +125,60 @@ TEST_F(MindDataTestConnector, Test2) {
 }
 
 
+// Test3 : the number of active producers changes at the end of a roundrobin and the order is preserved
+TEST_F(MindDataTestConnector, Test3) {
+  MS_LOG(INFO) << "MindDataTestConnector Test3: change the number of active producers.";
+  const int32_t max_producers = 4;
+  const int32_t queue_capacity = 16;
+  Connector<uint32_t> my_conn(max_producers, 1, queue_capacity);
+  // (first element pushed, number of active producers from there on)
+  std::vector<std::pair<uint32_t, int32_t>> schedule = {{0, 2}, {6, 3}, {12, 1}, {15, 4}};
+  const uint32_t num_elements = 23;
+  Status rc;
+  for (size_t k = 0; k < schedule.size(); k++) {
+    uint32_t begin = schedule[k].first;
+    uint32_t end = (k + 1 < schedule.size()) ? schedule[k + 1].first : num_elements;
+    int32_t active = schedule[k].second;
+    rc = my_conn.SetActiveProducers(active, begin);
+    ASSERT_TRUE(rc.IsOk());
+    for (uint32_t i = begin; i < end; i++) {
+      rc = my_conn.Push((i - begin) % active, i);
+      ASSERT_TRUE(rc.IsOk());
+    }
+  }
+  ASSERT_EQ(my_conn.capacity(), max_producers * queue_capacity);
+  for (uint32_t i = 0; i < num_elements; i++) {
+    uint32_t v = 0;
+    rc = my_conn.Pop(0, &v);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(v, i);
+  }
+  rc = my_conn.SetActiveProducers(max_producers + 1, num_elements);
+  ASSERT_FALSE(rc.IsOk());
+}
+
+// Test4 : a JaggedConnector created for more producers than the initial ones only pops from the active queues
+TEST_F(MindDataTestConnector, Test4) {
+  MS_LOG(INFO) << "MindDataTestConnector Test4: JaggedConnector with fewer active producers.";
+  const int32_t max_producers = 4;
+  const int32_t active = 2;
+  JaggedConnector my_conn(max_producers, 1, 8);
+  Status rc = my_conn.SetActiveProducers(active, 0);
+  ASSERT_TRUE(rc.IsOk());
+  const int64_t num_rows = 6;
+  for (int64_t i = 0; i < num_rows; i++) {
+    TensorRow row;
+    row.setId(i);
+    rc = my_conn.Add(static_cast<int32_t>(i % active), std::move(row));
+    ASSERT_TRUE(rc.IsOk());
+  }
+  for (int64_t i = 0; i < num_rows; i++) {
+    TensorRow row;
+    rc = my_conn.Pop(0, &row);
+    ASSERT_TRUE(rc.IsOk());
+    ASSERT_EQ(row.getId(), i);
+  }
+}
 
 // Implementation of MindDataTestConnector class and the helper functions.
 MindDataTestConnector::MindDataTestConnector() : tg_(new TaskGroup()) {
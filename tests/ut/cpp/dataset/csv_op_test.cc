@@ -13,11 +13,15 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/util/path.h"
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
@@ -37,6 +41,44 @@ class MindDataTestCSVOp : public UT::DatasetOpTesting {
 
 };
 
+namespace {
+// Read a csv file of 4 string columns to the end, counting the rows whose third column is the given one
+void ReadCSVFile(const std::string &file, int32_t num_devices, int32_t device_id, const std::string &third,
+                 int64_t *num_rows, int64_t *num_matches) {
+  auto tree = std::make_shared<ExecutionTree>();
+  std::vector<std::shared_ptr<CsvOp::BaseRecord>> column_default_list;
+  for (int32_t i = 0; i < 4; ++i) {
+    column_default_list.push_back(std::make_shared<CsvOp::Record<std::string>>(CsvOp::STRING, ""));
+  }
+  std::shared_ptr<CsvOp> op;
+  CsvOp::Builder builder;
+  builder.SetCsvFilesList({file})
+    .SetNumWorkers(8)
+    .SetNumDevices(num_devices)
+    .SetDeviceId(device_id)
+    .SetFieldDelim(',')
+    .SetColumDefault(column_default_list)
+    .SetColumName({"col1", "col2", "col3", "col4"});
+  ASSERT_OK(builder.Build(&op));
+  ASSERT_OK(tree->AssociateNode(op));
+  ASSERT_OK(tree->AssignRoot(op));
+  ASSERT_OK(tree->Prepare());
+  ASSERT_OK(tree->Launch());
+  DatasetIterator di(tree);
+  TensorRow tensor_list;
+  ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  *num_rows = 0;
+  *num_matches = 0;
+  while (!tensor_list.empty()) {
+    std::string_view value;
+    ASSERT_OK(tensor_list[2]->GetItemAt(&value, {}));
+    *num_matches += (value == third) ? 1 : 0;
+    ++(*num_rows);
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  }
+}
+}  // namespace
+
 TEST_F(MindDataTestCSVOp, TestCSVBasic) {
   // Start with an empty execution tree
   auto tree = std::make_shared<ExecutionTree>();
@@ -119,3 +161,48 @@ TEST_F(MindDataTestCSVOp, TestTotalRows) {
   ASSERT_EQ(total_rows, 8);
   files.clear();
 }
+
+TEST_F(MindDataTestCSVOp, TestCSVSplitFile) {
+  // Each row has a line break inside a quoted field, which must not be taken for the start of a row
+  const int32_t kRepeats = 20000;
+  std::string src = datasets_root_path_ + "/testCSV/embedded.csv";
+  std::ifstream in(src, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  // Write to a folder of this test under the test data, so concurrent runs do not share it
+  std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  Path dir(datasets_root_path_ + "/csv_split_" + test_name);
+  ASSERT_OK(dir.CreateDirectories());
+  std::string file = (dir / "embedded_large.csv").toString();
+  {
+    std::ofstream out(file, std::ios::binary | std::ios::trunc);
+    for (int32_t i = 0; i < kRepeats; ++i) {
+      out.write(content.data(), content.size());
+    }
+  }
+
+  auto config = GlobalContext::config_manager();
+  int64_t saved_split_size = config->file_split_size();
+  int64_t rows = 0;
+  int64_t matches = 0;
+
+  config->set_file_split_size(0);
+  ReadCSVFile(file, 1, 0, "e\nf", &rows, &matches);
+  EXPECT_EQ(rows, kRepeats);
+  EXPECT_EQ(matches, kRepeats);
+
+  config->set_file_split_size(1000);
+  ReadCSVFile(file, 1, 0, "e\nf", &rows, &matches);
+  EXPECT_EQ(rows, kRepeats);
+  EXPECT_EQ(matches, kRepeats);
+
+  // The rows of a shard begin and end in the middle of ranges. Shards get equal rows, the last one wraps around.
+  for (int32_t device_id = 0; device_id < 3; ++device_id) {
+    ReadCSVFile(file, 3, device_id, "e\nf", &rows, &matches);
+    EXPECT_EQ(rows, kRepeats / 3 + 1);
+    EXPECT_EQ(matches, rows);
+  }
+
+  config->set_file_split_size(saved_split_size);
+  ASSERT_OK(Path(file).Remove());
+  ASSERT_OK(dir.Remove());
+}
@@ -0,0 +1,109 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/cv_tensor.h"
+#include "minddata/dataset/kernels/image/decode_op.h"
+#include "minddata/dataset/kernels/image/decode_resize_op.h"
+#include "minddata/dataset/kernels/image/image_utils.h"
+#include "minddata/dataset/kernels/image/resize_op.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+// A DCT scaled decode filters the image differently than a full size decode followed by a resize
+constexpr double kMseThreshold = 5.0;
+
+class MindDataTestDecodeResizeOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestDecodeResizeOp() : CVOpCommon() {}
+};
+
+TEST_F(MindDataTestDecodeResizeOp, TestScaleDenom) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestScaleDenom.";
+  EXPECT_EQ(GetJpegScaleDenom(4032, 2268, 398, 224), 8);
+  EXPECT_EQ(GetJpegScaleDenom(4032, 2268, 1000, 500), 4);
+  EXPECT_EQ(GetJpegScaleDenom(1000, 1000, 500, 500), 2);
+  EXPECT_EQ(GetJpegScaleDenom(1000, 1000, 501, 500), 1);
+  EXPECT_EQ(GetJpegScaleDenom(100, 100, 224, 224), 1);
+}
+
+TEST_F(MindDataTestDecodeResizeOp, TestScaledCropDecode) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestScaledCropDecode.";
+  int width = 0;
+  int height = 0;
+  ASSERT_OK(GetJpegImageInfo(raw_input_tensor_, &width, &height));
+
+  std::shared_ptr<Tensor> decoded;
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &decoded, 0, 0, 0, 0, 4));
+  EXPECT_EQ(decoded->shape(), TensorShape({(height + 3) / 4, (width + 3) / 4, 3}));
+
+  // The crop is given in the full size image, and covers at least the same area once scaled
+  ASSERT_OK(JpegCropAndDecode(raw_input_tensor_, &decoded, 10, 20, 801, 400, 8));
+  EXPECT_EQ(decoded->shape(), TensorShape({51, 101, 3}));
+
+  EXPECT_ERROR(JpegCropAndDecode(raw_input_tensor_, &decoded, 0, 0, 0, 0, 3));
+}
+
+TEST_F(MindDataTestDecodeResizeOp, TestOp) {
+  MS_LOG(INFO) << "Doing MindDataTestDecodeResizeOp-TestOp.";
+  constexpr int32_t size = 224;
+  DecodeOp decode_op(true);
+  ResizeOp resize_op(size, 0, InterpolationMode::kArea);
+  DecodeResizeOp decode_resize_op(size, 0, InterpolationMode::kArea);
+
+  const int32_t num_iterations = 10;
+  std::shared_ptr<Tensor> decoded;
+  std::shared_ptr<Tensor> expect;
+  auto start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_iterations; i++) {
+    ASSERT_OK(decode_op.Compute(raw_input_tensor_, &decoded));
+    ASSERT_OK(resize_op.Compute(decoded, &expect));
+  }
+  double sequential = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  std::shared_ptr<Tensor> actual;
+  start = std::chrono::steady_clock::now();
+  for (int32_t i = 0; i < num_iterations; i++) {
+    ASSERT_OK(decode_resize_op.Compute(raw_input_tensor_, &actual));
+  }
+  double fused = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Decode and Resize to " << expect->shape() << ": " << num_iterations / sequential
+               << " images/s, DecodeResize: " << num_iterations / fused << " images/s.";
+
+  ASSERT_EQ(actual->shape(), expect->shape());
+  cv::Mat output1 = CVTensor::AsCVTensor(actual)->mat().clone();
+  cv::Mat output2 = CVTensor::AsCVTensor(expect)->mat().clone();
+  long int mse_sum = 0;
+  long int count = 0;
+  int a, b;
+  for (int i = 0; i < output1.rows; i++) {
+    for (int j = 0; j < output1.cols; j++) {
+      a = static_cast<int>(output1.at<cv::Vec3b>(i, j)[1]);
+      b = static_cast<int>(output2.at<cv::Vec3b>(i, j)[1]);
+      mse_sum += sqrt((a - b) * (a - b));
+      if (a != b) {
+        count++;
+      }
+    }
+  }
+  double mse = count > 0 ? static_cast<double>(mse_sum) / count : mse_sum;
+  MS_LOG(INFO) << "mse: " << mse << std::endl;
+  EXPECT_LT(mse, kMseThreshold);
+}
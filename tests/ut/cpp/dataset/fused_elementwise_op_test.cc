@@ -0,0 +1,183 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include "common/common.h"
+#include "common/cvop_common.h"
+#include "minddata/dataset/core/data_type.h"
+#include "minddata/dataset/kernels/image/fused_elementwise_op.h"
+#include "minddata/dataset/kernels/ir/data/transforms_ir.h"
+#include "minddata/dataset/kernels/ir/vision/fused_elementwise_ir.h"
+#include "minddata/dataset/kernels/ir/vision/hwc_to_chw_ir.h"
+#include "minddata/dataset/kernels/ir/vision/normalize_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_horizontal_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/random_vertical_flip_ir.h"
+#include "minddata/dataset/kernels/ir/vision/rescale_ir.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+class MindDataTestFusedElementwiseOp : public UT::CVOP::CVOpCommon {
+ public:
+  MindDataTestFusedElementwiseOp() : CVOpCommon() {}
+
+ protected:
+  using Chain = std::vector<std::shared_ptr<TensorOperation>>;
+
+  std::shared_ptr<TensorOp> BuildFused(const Chain &chain) {
+    auto fused_ir = std::make_shared<vision::FusedElementwiseOperation>(chain);
+    EXPECT_OK(fused_ir->ValidateParams());
+    return fused_ir->Build();
+  }
+
+  Status RunSequential(const Chain &chain, const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
+    std::shared_ptr<Tensor> current = input;
+    for (const auto &op : chain) {
+      std::shared_ptr<Tensor> next;
+      RETURN_IF_NOT_OK(op->Build()->Compute(current, &next));
+      current = next;
+    }
+    *output = current;
+    return Status::OK();
+  }
+
+  template <typename T>
+  void ExpectNear(const std::shared_ptr<Tensor> &actual, const std::shared_ptr<Tensor> &expect) {
+    auto itr_actual = actual->begin<T>();
+    auto itr_expect = expect->begin<T>();
+    for (; itr_expect != expect->end<T>(); ++itr_actual, ++itr_expect) {
+      // opencv may contract the multiply and add of Rescale
+      double expect = static_cast<double>(static_cast<float>(*itr_expect));
+      ASSERT_NEAR(static_cast<float>(*itr_actual), expect, 1e-5 * std::max(1.0, std::fabs(expect)));
+    }
+  }
+
+  // Check that the fused op gives the same tensor as the original ops one after the other
+  void CheckChain(const Chain &chain, const std::shared_ptr<Tensor> &input) {
+    std::shared_ptr<Tensor> expect;
+    ASSERT_OK(RunSequential(chain, input, &expect));
+    std::shared_ptr<Tensor> actual;
+    ASSERT_OK(BuildFused(chain)->Compute(input, &actual));
+    ASSERT_EQ(actual->shape(), expect->shape());
+    ASSERT_EQ(actual->type(), expect->type());
+    if (expect->type() == DataType::DE_FLOAT32) {
+      ExpectNear<float>(actual, expect);
+    } else {
+      ASSERT_EQ(expect->type(), DataType::DE_UINT8);
+      ExpectNear<uint8_t>(actual, expect);
+    }
+  }
+
+  // Check that the batch of the fused op is the batch of the images given by the original ops
+  void CheckBatch(const Chain &chain, const std::vector<std::shared_ptr<Tensor>> &inputs) {
+    std::shared_ptr<Tensor> actual;
+    ASSERT_OK(BuildFused(chain)->ComputeBatch(inputs, &actual));
+    ASSERT_EQ(actual->shape()[0], static_cast<dsize_t>(inputs.size()));
+    for (size_t i = 0; i < inputs.size(); i++) {
+      std::shared_ptr<Tensor> expect;
+      ASSERT_OK(RunSequential(chain, inputs[i], &expect));
+      ASSERT_EQ(actual->shape(), expect->shape().PrependDim(static_cast<int64_t>(inputs.size())));
+      ASSERT_EQ(actual->type(), expect->type());
+      std::shared_ptr<Tensor> image;
+      ASSERT_OK(Tensor::CreateFromMemory(expect->shape(), expect->type(),
+                                         actual->GetBuffer() + i * expect->SizeInBytes(), &image));
+      if (expect->type() == DataType::DE_FLOAT32) {
+        ExpectNear<float>(image, expect);
+      } else if (expect->type() == DataType::DE_FLOAT16) {
+        ExpectNear<float16>(image, expect);
+      } else {
+        ASSERT_EQ(expect->type(), DataType::DE_UINT8);
+        ExpectNear<uint8_t>(image, expect);
+      }
+    }
+  }
+
+  std::vector<float> mean_ = {121.0, 115.0, 100.0};
+  std::vector<float> std_ = {70.0, 68.0, 71.0};
+};
+
+TEST_F(MindDataTestFusedElementwiseOp, TestMatchesSequential) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedElementwiseOp-TestMatchesSequential.";
+  auto rescale = std::make_shared<vision::RescaleOperation>(1.0 / 255, -0.5);
+  auto normalize = std::make_shared<vision::NormalizeOperation>(mean_, std_);
+  auto hwc2chw = std::make_shared<vision::HwcToChwOperation>();
+  auto to_float = std::make_shared<transforms::TypeCastOperation>(DataType(DataType::DE_FLOAT32));
+  auto to_uint8 = std::make_shared<transforms::TypeCastOperation>(DataType(DataType::DE_UINT8));
+  auto flip_h = std::make_shared<vision::RandomHorizontalFlipOperation>(1.0);
+  auto flip_v = std::make_shared<vision::RandomVerticalFlipOperation>(1.0);
+
+  CheckChain({rescale, hwc2chw}, input_tensor_);
+  CheckChain({normalize, hwc2chw}, input_tensor_);
+  CheckChain({hwc2chw, rescale}, input_tensor_);
+  CheckChain({rescale, to_uint8}, input_tensor_);
+  CheckChain({flip_h, normalize, hwc2chw}, input_tensor_);
+  CheckChain({flip_v, flip_h, rescale, normalize}, input_tensor_);
+  CheckChain({flip_h, flip_h, to_float, normalize, hwc2chw}, input_tensor_);
+
+  // A float input is not tabulated
+  std::shared_ptr<Tensor> float_input;
+  ASSERT_OK(RunSequential({to_float}, input_tensor_, &float_input));
+  CheckChain({rescale, normalize, hwc2chw}, float_input);
+  CheckChain({flip_v, to_uint8}, float_input);
+}
+
+TEST_F(MindDataTestFusedElementwiseOp, TestFallback) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedElementwiseOp-TestFallback.";
+  auto rescale = std::make_shared<vision::RescaleOperation>(1.0 / 255, 0.0);
+  auto hwc2chw = std::make_shared<vision::HwcToChwOperation>();
+  auto normalize = std::make_shared<vision::NormalizeOperation>(std::vector<float>{0.5}, std::vector<float>{0.25});
+
+  // A <H,W> image, and a Normalize after HWC2CHW, are run by the original ops
+  std::shared_ptr<Tensor> gray_input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{1, 2, 3, 4, 5, 6}, TensorShape({2, 3}), &gray_input));
+  CheckChain({rescale, hwc2chw}, gray_input);
+  CheckChain({hwc2chw, rescale, normalize}, input_tensor_);
+}
+
+TEST_F(MindDataTestFusedElementwiseOp, TestComputeBatch) {
+  MS_LOG(INFO) << "Doing MindDataTestFusedElementwiseOp-TestComputeBatch.";
+  auto rescale = std::make_shared<vision::RescaleOperation>(1.0 / 255, -0.5);
+  auto normalize = std::make_shared<vision::NormalizeOperation>(mean_, std_);
+  auto hwc2chw = std::make_shared<vision::HwcToChwOperation>();
+  auto to_float = std::make_shared<transforms::TypeCastOperation>(DataType(DataType::DE_FLOAT32));
+  auto to_float16 = std::make_shared<transforms::TypeCastOperation>(DataType(DataType::DE_FLOAT16));
+
+  std::shared_ptr<Tensor> float_input;
+  ASSERT_OK(RunSequential({to_float}, input_tensor_, &float_input));
+  std::vector<std::shared_ptr<Tensor>> batch = {input_tensor_, input_tensor_, input_tensor_};
+  std::vector<std::shared_ptr<Tensor>> float_batch = {float_input, float_input};
+
+  CheckBatch({normalize, hwc2chw}, batch);
+  CheckBatch({rescale, normalize}, {input_tensor_});
+  CheckBatch({normalize, hwc2chw, to_float16}, batch);
+  // A float batch is rescaled and normalized plane by plane
+  CheckBatch({rescale, normalize, hwc2chw}, float_batch);
+  CheckBatch({rescale, hwc2chw}, float_batch);
+  CheckBatch({rescale}, float_batch);
+  CheckBatch({normalize}, float_batch);
+
+  // Images of different shapes are given to the original ops, then copied into the batch
+  std::shared_ptr<Tensor> gray_input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint8_t>{1, 2, 3, 4, 5, 6}, TensorShape({2, 3}), &gray_input));
+  CheckBatch({rescale, hwc2chw}, {gray_input, gray_input});
+  std::shared_ptr<Tensor> output;
+  EXPECT_ERROR(BuildFused({rescale})->ComputeBatch({gray_input, input_tensor_}, &output));
+}
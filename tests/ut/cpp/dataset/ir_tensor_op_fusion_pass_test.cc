@@ -14,8 +14,11 @@
  * limitations under the License.
  */
 
+#include <cstdlib>
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "common/common.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
@@ -97,3 +100,178 @@ TEST_F(MindDataTestTensorOpFusionPass, RandomCropDecodeResizeEnabled) {
   // EXPECT_EQ(++func_it, tfuncs.end());
 }
 
+
+TEST_F(MindDataTestTensorOpFusionPass, FusedElementwiseEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-FusedElementwiseEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops, all but Decode are element-wise
+  std::shared_ptr<TensorTransform> decode(new vision::Decode());
+  std::shared_ptr<TensorTransform> rescale(new vision::Rescale(1.0 / 255.0, 0.0));
+  std::shared_ptr<TensorTransform> normalize(new vision::Normalize({0.485, 0.456, 0.406}, {0.229, 0.224, 0.225}));
+  std::shared_ptr<TensorTransform> hwc2chw(new vision::HWC2CHW());
+  ds = ds->Map({decode, rescale, normalize, hwc2chw}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kFusedElementwiseOp);
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, DecodeResizeEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-DecodeResizeEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops
+  std::shared_ptr<TensorTransform> decode(new vision::Decode());
+  std::shared_ptr<TensorTransform> resize(new vision::Resize({64}));
+  ds = ds->Map({decode, resize}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 1);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeResizeOp);
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, DecodeResizeBgrNotFused) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-DecodeResizeBgrNotFused";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops, the fused op only decodes to RGB
+  std::shared_ptr<TensorTransform> decode(new vision::Decode(false));
+  std::shared_ptr<TensorTransform> resize(new vision::Resize({64}));
+  ds = ds->Map({decode, resize}, {"image"});
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeOp);
+  EXPECT_EQ(tfuncs[1]->Name(), kResizeOp);
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, PostBatchOpEnabled) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-PostBatchOpEnabled";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // Create objects for the tensor ops, the last three run on whole batches
+  std::shared_ptr<TensorTransform> decode(new vision::Decode());
+  std::shared_ptr<TensorTransform> resize(new vision::Resize({32, 32}));
+  std::shared_ptr<TensorTransform> normalize(new vision::Normalize({121.0, 115.0, 100.0}, {70.0, 68.0, 71.0}));
+  std::shared_ptr<TensorTransform> hwc2chw(new vision::HWC2CHW());
+  std::shared_ptr<TensorTransform> type_cast(new transforms::TypeCast(mindspore::DataType::kNumberTypeFloat16));
+  ds = ds->Map({decode, resize, normalize, hwc2chw, type_cast}, {"image"});
+  ds = ds->Batch(4);
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 1);
+  EXPECT_EQ(tfuncs[0]->Name(), kDecodeResizeOp);
+  ++it;
+  EXPECT_EQ((*it).Name(), kBatchOp);
+
+  // The batches hold the images as the map would have given them, the iterator optimizes its tree when asked to
+  ASSERT_EQ(setenv("OPTIMIZE", "true", 1), 0);
+  std::shared_ptr<Iterator> iter = ds->CreateIterator();
+  ASSERT_EQ(unsetenv("OPTIMIZE"), 0);
+  ASSERT_NE(iter, nullptr);
+  std::unordered_map<std::string, mindspore::MSTensor> row;
+  ASSERT_OK(iter->GetNextRow(&row));
+  uint64_t i = 0;
+  while (row.size() != 0) {
+    auto image = row["image"];
+    EXPECT_EQ(image.DataType(), mindspore::DataType::kNumberTypeFloat16);
+    std::vector<int64_t> expect_shape = {i < 2 ? 4 : 3, 3, 32, 32};
+    EXPECT_EQ(image.Shape(), expect_shape);
+    ASSERT_OK(iter->GetNextRow(&row));
+    i++;
+  }
+  EXPECT_EQ(i, 3);
+  iter->Stop();
+}
+
+TEST_F(MindDataTestTensorOpFusionPass, PostBatchOpDisabledNewColumn) {
+  MS_LOG(INFO) << "Doing MindDataTestTensorOpFusionPass-PostBatchOpDisabledNewColumn";
+
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 11));
+
+  // The map writes a new column, so its ops stay in the map
+  std::shared_ptr<TensorTransform> decode(new vision::Decode());
+  std::shared_ptr<TensorTransform> hwc2chw(new vision::HWC2CHW());
+  ds = ds->Map({decode, hwc2chw}, {"image"}, {"chw_image"}, {"chw_image", "label"});
+  ds = ds->Batch(1);
+
+  std::shared_ptr<DatasetNode> node = ds->IRNode();
+  auto ir_tree = std::make_shared<TreeAdapter>();
+  // Enable IR optimization pass
+  ir_tree->SetOptimize(true);
+  Status rc;
+  rc = ir_tree->Compile(node);
+  EXPECT_TRUE(rc);
+  auto root_op = ir_tree->GetRoot();
+
+  auto tree = std::make_shared<ExecutionTree>();
+  auto it = tree->begin(static_cast<std::shared_ptr<DatasetOp>>(root_op));
+  ++it;
+  auto *map_op = &(*it);
+  auto tfuncs = static_cast<MapOp *>(map_op)->TFuncs();
+  ASSERT_EQ(tfuncs.size(), 2);
+  EXPECT_EQ(tfuncs[1]->Name(), kHwcToChwOp);
+}
@@ -177,3 +177,52 @@ TEST_F(MindDataTestQueue, Test6) {
   MS_LOG(INFO) << "Popped value " << *pepped_value << " from queue index " << chosen_queue_index;
   ASSERT_EQ(*pepped_value, 99);
 }
+
+TEST_F(MindDataTestQueue, TestResize) {
+  Queue<int> que(3);
+  for (int i = 0; i < 3; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  ASSERT_EQ(que.size(), que.capacity());
+  // Grow the full queue, elements already in it are kept in order
+  Status rc = que.Resize(5);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 5);
+  for (int i = 3; i < 5; i++) {
+    ASSERT_TRUE(que.Add(i).IsOk());
+  }
+  int v = -1;
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_EQ(v, 0);
+  // Shrink below the current size, nothing is dropped
+  rc = que.Resize(2);
+  ASSERT_TRUE(rc.IsOk());
+  ASSERT_EQ(que.capacity(), 2);
+  ASSERT_EQ(que.size(), 4);
+  for (int i = 1; i < 5; i++) {
+    ASSERT_TRUE(que.PopFront(&v).IsOk());
+    ASSERT_EQ(v, i);
+  }
+  ASSERT_TRUE(que.empty());
+  rc = que.Resize(0);
+  ASSERT_FALSE(rc.IsOk());
+}
+
+TEST_F(MindDataTestQueue, TestTryPopFront) {
+  Queue<int> que(2);
+  int v = -1;
+  ASSERT_FALSE(que.TryPopFront(&v));
+  ASSERT_EQ(v, -1);
+  ASSERT_TRUE(que.Add(1).IsOk());
+  ASSERT_TRUE(que.Add(2).IsOk());
+  ASSERT_TRUE(que.TryPopFront(&v));
+  ASSERT_EQ(v, 1);
+  // the room made by TryPopFront is usable by the producer
+  ASSERT_TRUE(que.Add(3).IsOk());
+  ASSERT_TRUE(que.TryPopFront(&v));
+  ASSERT_EQ(v, 2);
+  ASSERT_TRUE(que.PopFront(&v).IsOk());
+  ASSERT_EQ(v, 3);
+  ASSERT_FALSE(que.TryPopFront(&v));
+  ASSERT_TRUE(que.empty());
+}
@@ -13,12 +13,18 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
 #include "minddata/dataset/core/client.h"
 #include "common/common.h"
 #include "utils/ms_utils.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 #include <memory>
+#include <set>
+#include <string>
+#include <thread>
 #include <vector>
 #include <iostream>
 
@@ -29,8 +35,85 @@ using mindspore::MsLogLevel::INFO;
 using mindspore::ExceptionType::NoExceptionType;
 using mindspore::LogStream;
 
+namespace {
+// A port of the loopback which is free for now
+int32_t FreePort() {
+  int fd = socket(AF_INET, SOCK_STREAM, 0);
+  struct sockaddr_in addr {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t len = sizeof(addr);
+  int32_t port = 0;
+  if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), len) == 0 &&
+      getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) == 0) {
+    port = ntohs(addr.sin_port);
+  }
+  close(fd);
+  return port;
+}
+}  // namespace
+
 class MindDataTestShuffleOp : public UT::DatasetOpTesting {
+ protected:
+  // Two ranks each read an equal shard of the 10 rows of testDataset1, and swap rows through their exchanges.
+  // Each rank gets as many rows as it read, and together they get every row exactly once.
+  void RunShuffleExchange(const std::vector<std::shared_ptr<ShuffleExchange>> &exchanges) {
+    const int32_t num_ranks = exchanges.size();
+    std::string dataset_path = datasets_root_path_ + "/testDataset1/testDataset1.data";
+    std::vector<std::shared_ptr<ExecutionTree>> trees;
+    for (int32_t rank = 0; rank < num_ranks; ++rank) {
+      auto my_tree = std::make_shared<ExecutionTree>();
+      std::shared_ptr<TFReaderOp> my_tfreader_op;
+      ASSERT_OK(TFReaderOp::Builder()
+                  .SetDatasetFilesList({dataset_path})
+                  .SetNumDevices(num_ranks)
+                  .SetDeviceId(rank)
+                  .SetShardEqualRows(true)
+                  .SetWorkerConnectorSize(16)
+                  .SetNumWorkers(1)
+                  .Build(&my_tfreader_op));
+      ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+      std::shared_ptr<ShuffleOp> my_shuffle_op;
+      ASSERT_OK(
+        ShuffleOp::Builder().SetShuffleSize(3).SetShuffleExchange(exchanges[rank], rank, 1).Build(&my_shuffle_op));
+      ASSERT_OK(my_tree->AssociateNode(my_shuffle_op));
+      ASSERT_OK(my_shuffle_op->AddChild(my_tfreader_op));
+      ASSERT_OK(my_tree->AssignRoot(my_shuffle_op));
+      ASSERT_OK(my_tree->Prepare());
+      ASSERT_OK(my_tree->Launch());
+      trees.push_back(my_tree);
+    }
+
+    // A rank blocks in the exchange until the other one joins the round, so each rank is consumed by its own thread
+    std::vector<std::vector<std::string>> rows(num_ranks);
+    auto consume = [&trees, &rows](int32_t rank) {
+      DatasetIterator di(trees[rank]);
+      TensorRow tensor_list;
+      EXPECT_OK(di.FetchNextTensorRow(&tensor_list));
+      while (!tensor_list.empty()) {
+        std::ostringstream ss;
+        for (auto &t : tensor_list) {
+          ss << *t;
+        }
+        rows[rank].push_back(ss.str());
+        EXPECT_OK(di.FetchNextTensorRow(&tensor_list));
+      }
+    };
+    std::vector<std::thread> consumers;
+    for (int32_t rank = 0; rank < num_ranks; ++rank) {
+      consumers.emplace_back(consume, rank);
+    }
+    for (auto &t : consumers) {
+      t.join();
+    }
 
+    std::set<std::string> all_rows;
+    for (int32_t rank = 0; rank < num_ranks; ++rank) {
+      EXPECT_EQ(rows[rank].size(), 5);
+      all_rows.insert(rows[rank].begin(), rows[rank].end());
+    }
+    EXPECT_EQ(all_rows.size(), 10);
+  }
 };
 
 
@@ -333,3 +416,72 @@ TEST_F(MindDataTestShuffleOp, TestRepeatShuffle) {
   }
   ASSERT_EQ(row_count, 20);
 }
+
+// Test info:
+// - Dataset from testDataset1 has 10 rows, 2 columns.
+// - Two ranks each read an equal shard of 5 rows, and swap rows through a shuffle exchange.
+// - Each rank gets as many rows as it read, and together they get every row exactly once.
+//
+// Tree (one per rank): shuffle over TFReader
+//
+//    ShuffleOp  <-- exchange -->  ShuffleOp
+//       |                            |
+//    TFReaderOp                   TFReaderOp
+//
+TEST_F(MindDataTestShuffleOp, TestShuffleExchange) {
+  MS_LOG(INFO) << "UT test TestShuffleExchange.";
+  std::shared_ptr<ShuffleExchange> exchange;
+  ASSERT_OK(LocalShuffleExchange::GetOrCreate("TestShuffleExchange", 2, 1, &exchange));
+  RunShuffleExchange({exchange, exchange});
+}
+
+// Test info:
+// - Same as TestShuffleExchange, but each rank has its own exchange and they meet over tcp on the loopback.
+TEST_F(MindDataTestShuffleOp, TestTcpShuffleExchange) {
+  MS_LOG(INFO) << "UT test TestTcpShuffleExchange.";
+  int32_t free_port = FreePort();
+  ASSERT_GT(free_port, 0);
+  std::string host;
+  int32_t port = 0;
+  EXPECT_FALSE(TcpShuffleExchange::ParseGroup("TestShuffleExchange", &host, &port));
+  EXPECT_FALSE(TcpShuffleExchange::ParseGroup("tcp://127.0.0.1", &host, &port));
+  ASSERT_TRUE(TcpShuffleExchange::ParseGroup("tcp://127.0.0.1:" + std::to_string(free_port), &host, &port));
+  EXPECT_EQ(host, "127.0.0.1");
+  EXPECT_EQ(port, free_port);
+  std::vector<std::shared_ptr<ShuffleExchange>> exchanges;
+  for (int32_t rank = 0; rank < 2; ++rank) {
+    exchanges.push_back(std::make_shared<TcpShuffleExchange>(host, port, 2, rank, 1));
+  }
+  RunShuffleExchange(exchanges);
+  // Rank 0 serves the other rank until it closes the exchange, so it goes last
+  exchanges.pop_back();
+  exchanges.pop_back();
+}
+
+// Test info:
+// - A rank waiting in an exchange whose other rank never shows up gives up with an error after the timeout.
+// - A rank aborting the exchange wakes up the rank waiting in it with the error, and fails later calls.
+TEST_F(MindDataTestShuffleOp, TestShuffleExchangeAbort) {
+  MS_LOG(INFO) << "UT test TestShuffleExchangeAbort.";
+  const int32_t num_ranks = 2;
+  TensorTable rows(1);
+  LocalShuffleExchange timed_exchange(num_ranks, 1, std::chrono::milliseconds(100));
+  EXPECT_ERROR(timed_exchange.Exchange(0, 0, &rows));
+
+  LocalShuffleExchange exchange(num_ranks, 1);
+  Status rc;
+  TaskGroup vg;
+  ASSERT_OK(vg.CreateAsyncTask("Rank 0", [&exchange, &rc]() -> Status {
+    TaskManager::FindMe()->Post();
+    TensorTable batch(1);
+    rc = exchange.Exchange(0, 0, &batch);
+    return Status::OK();
+  }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  exchange.Abort(1, Status(StatusCode::kMDUnexpectedError, "Rank 1 failed"));
+  ASSERT_OK(vg.join_all());
+  EXPECT_TRUE(rc.IsError());
+  EXPECT_NE(rc.ToString().find("Rank 1 failed"), std::string::npos);
+  EXPECT_ERROR(exchange.Exchange(1, 0, &rows));
+  EXPECT_ERROR(exchange.Leave(1, 0));
+}
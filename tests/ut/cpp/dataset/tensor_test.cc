@@ -577,3 +577,50 @@ TEST_F(MindDataTestTensorDE, TestTensorJson) {
 
   ASSERT_TRUE(input_data == data);
 }
+
+namespace {
+// A pool which owns a block of memory it does not hand out, and counts what is given back to it
+class ExternalBlock : public MemoryPool {
+ public:
+  Status Allocate(size_t n, void **p) override { return Status(StatusCode::kMDNotImplementedYet); }
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override {
+    return Status(StatusCode::kMDNotImplementedYet);
+  }
+  void Deallocate(void *p) override { num_deallocate_++; }
+  uint64_t get_max_size() const override { return 0; }
+  int PercentFree() const override { return 0; }
+  int32_t num_deallocate_ = 0;
+};
+}  // namespace
+
+TEST_F(MindDataTestTensorDE, TensorExternalMemory) {
+  std::vector<float> block = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+  auto owner = std::make_shared<ExternalBlock>();
+  auto *data = reinterpret_cast<uchar *>(block.data());
+  std::shared_ptr<Tensor> t;
+  Status rc = Tensor::CreateFromExternalMemory(TensorShape({2, 3}), DataType(DataType::DE_FLOAT32), data,
+                                               block.size() * sizeof(float), owner, &t);
+  ASSERT_TRUE(rc.IsOk());
+  // No copy is made
+  ASSERT_EQ(t->GetBuffer(), data);
+  float f;
+  ASSERT_TRUE(t->GetItemAt<float>(&f, {1, 2}).IsOk());
+  ASSERT_EQ(f, 6.0);
+  block[5] = 7.0;
+  ASSERT_TRUE(t->GetItemAt<float>(&f, {1, 2}).IsOk());
+  ASSERT_EQ(f, 7.0);
+  // The owner is kept alive by the tensor, and gets the memory back when the tensor is gone
+  ASSERT_EQ(owner.use_count(), 2);
+  t.reset();
+  ASSERT_EQ(owner.use_count(), 1);
+  ASSERT_EQ(owner->num_deallocate_, 1);
+
+  // The length must match the shape
+  rc = Tensor::CreateFromExternalMemory(TensorShape({2, 2}), DataType(DataType::DE_FLOAT32), data,
+                                        block.size() * sizeof(float), owner, &t);
+  ASSERT_FALSE(rc.IsOk());
+  // Misaligned memory is rejected
+  rc = Tensor::CreateFromExternalMemory(TensorShape({2}), DataType(DataType::DE_FLOAT32), data + 1, 2 * sizeof(float),
+                                        owner, &t);
+  ASSERT_FALSE(rc.IsOk());
+}
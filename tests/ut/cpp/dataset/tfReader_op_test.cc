@@ -13,12 +13,16 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <fstream>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <vector>
 
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/data_schema.h"
+#include "minddata/dataset/util/path.h"
 #include "common/common.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
@@ -34,6 +38,48 @@ class MindDataTestTFReaderOp : public UT::DatasetOpTesting {
 
 };
 
+namespace {
+// Write a file made of the content of another file repeated a number of times. A tfrecord file repeated is
+// a valid tfrecord file, as each record carries its own framing.
+void WriteRepeatedFile(const std::string &src, const std::string &dst, int32_t times) {
+  std::ifstream in(src, std::ios::binary);
+  std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+  std::ofstream out(dst, std::ios::binary | std::ios::trunc);
+  for (int32_t i = 0; i < times; ++i) {
+    out.write(content.data(), content.size());
+  }
+}
+
+// Read a list of tfrecord files to the end, counting the rows and summing their col_sint64
+void ReadTFFiles(const std::vector<std::string> &files, const std::string &schema_file, int32_t num_workers,
+                 int64_t *num_rows, int64_t *sum) {
+  auto my_tree = std::make_shared<ExecutionTree>();
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder builder;
+  builder.SetDatasetFilesList(files).SetNumWorkers(num_workers);
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  ASSERT_OK(schema->LoadSchemaFile(schema_file, {"col_sint64"}));
+  builder.SetDataSchema(std::move(schema));
+  ASSERT_OK(builder.Build(&my_tfreader_op));
+  ASSERT_OK(my_tree->AssociateNode(my_tfreader_op));
+  ASSERT_OK(my_tree->AssignRoot(my_tfreader_op));
+  ASSERT_OK(my_tree->Prepare());
+  ASSERT_OK(my_tree->Launch());
+  DatasetIterator di(my_tree);
+  TensorRow tensor_list;
+  ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  *num_rows = 0;
+  *sum = 0;
+  while (!tensor_list.empty()) {
+    int64_t value = 0;
+    ASSERT_OK(tensor_list[0]->GetItemAt(&value, {0}));
+    *sum += value;
+    ++(*num_rows);
+    ASSERT_OK(di.FetchNextTensorRow(&tensor_list));
+  }
+}
+}  // namespace
+
 TEST_F(MindDataTestTFReaderOp, TestTFReaderBasic1) {
   // Start with an empty execution tree
   auto my_tree = std::make_shared<ExecutionTree>();
@@ -716,3 +762,77 @@ TEST_F(MindDataTestTFReaderOp, TestTFReaderInvalidFiles) {
   rc = builder.Build(&my_tfreader_op);
   ASSERT_TRUE(!rc.IsOk());
 }
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderSplitFile) {
+  // The same rows, in one large file or in 64 files
+  const int32_t kNumFiles = 64;
+  const int32_t kRepeatsPerFile = 125;
+  const int32_t kNumWorkers = 8;
+  std::string src = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::string schema_file = datasets_root_path_ + "/testTFTestAllTypes/datasetSchemaNoRow.json";
+  // Write to a folder of this test under the test data, so concurrent runs do not share it
+  std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+  Path dir(datasets_root_path_ + "/tf_reader_split_" + test_name);
+  ASSERT_OK(dir.CreateDirectories());
+  std::string large_file = (dir / "large.data").toString();
+  WriteRepeatedFile(src, large_file, kNumFiles * kRepeatsPerFile);
+  std::vector<std::string> small_files;
+  for (int32_t i = 0; i < kNumFiles; ++i) {
+    small_files.push_back((dir / ("small_" + std::to_string(i) + ".data")).toString());
+    WriteRepeatedFile(src, small_files.back(), kRepeatsPerFile);
+  }
+  const int64_t kExpectedRows = 12 * kNumFiles * kRepeatsPerFile;
+
+  auto config = GlobalContext::config_manager();
+  int64_t saved_split_size = config->file_split_size();
+  int64_t rows = 0;
+  int64_t sum = 0;
+  int64_t expected_sum = 0;
+
+  config->set_file_split_size(0);
+  ReadTFFiles(small_files, schema_file, kNumWorkers, &rows, &expected_sum);
+  EXPECT_EQ(rows, kExpectedRows);
+
+  ReadTFFiles({large_file}, schema_file, kNumWorkers, &rows, &sum);
+  EXPECT_EQ(rows, kExpectedRows);
+  EXPECT_EQ(sum, expected_sum);
+
+  // Ranges of the large file start in the middle of records, the readers must find where the next one begins
+  int64_t large_size = std::ifstream(large_file, std::ios::binary | std::ios::ate).tellg();
+  config->set_file_split_size(large_size / kNumFiles + 1);
+  ReadTFFiles({large_file}, schema_file, kNumWorkers, &rows, &sum);
+  EXPECT_EQ(rows, kExpectedRows);
+  EXPECT_EQ(sum, expected_sum);
+
+  // A range smaller than a record holds no start of record for some of them
+  config->set_file_split_size(100);
+  ReadTFFiles({small_files[0]}, schema_file, kNumWorkers, &rows, &sum);
+  EXPECT_EQ(rows, 12 * kRepeatsPerFile);
+
+  config->set_file_split_size(saved_split_size);
+  for (const auto &file : small_files) {
+    ASSERT_OK(Path(file).Remove());
+  }
+  ASSERT_OK(Path(large_file).Remove());
+  ASSERT_OK(dir.Remove());
+}
+
+TEST_F(MindDataTestTFReaderOp, TestTFReaderSplitFileEqualRows) {
+  std::string tf_file = datasets_root_path_ + "/testTFTestAllTypes/test.data";
+  std::string schema_file = datasets_root_path_ + "/testTFTestAllTypes/datasetSchema.json";
+  auto config = GlobalContext::config_manager();
+  int64_t saved_split_size = config->file_split_size();
+
+  // The equal rows of the shards are counted from whole files, which the ranges of a file do not give
+  config->set_file_split_size(100);
+  std::shared_ptr<TFReaderOp> my_tfreader_op;
+  TFReaderOp::Builder builder;
+  builder.SetDatasetFilesList({tf_file}).SetShardEqualRows(true);
+  std::unique_ptr<DataSchema> schema = std::make_unique<DataSchema>();
+  schema->LoadSchemaFile(schema_file, {});
+  builder.SetDataSchema(std::move(schema));
+  Status rc = builder.Build(&my_tfreader_op);
+  EXPECT_TRUE(!rc.IsOk());
+
+  config->set_file_split_size(saved_split_size);
+}
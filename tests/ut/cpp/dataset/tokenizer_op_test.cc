@@ -16,9 +16,12 @@
 #include <memory>
 #include <string>
 #include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "common/common.h"
 #include "minddata/dataset/text/kernels/basic_tokenizer_op.h"
+#include "minddata/dataset/text/kernels/bert_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/case_fold_op.h"
 #include "minddata/dataset/text/kernels/normalize_utf8_op.h"
 #include "minddata/dataset/text/kernels/regex_replace_op.h"
@@ -26,6 +29,7 @@
 #include "minddata/dataset/text/kernels/unicode_char_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/unicode_script_tokenizer_op.h"
 #include "minddata/dataset/text/kernels/whitespace_tokenizer_op.h"
+#include "minddata/dataset/text/vocab.h"
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 
@@ -41,6 +45,24 @@ class MindDataTestTokenizerOp : public UT::Common {
     EXPECT_TRUE(s.IsOk());
     EXPECT_EQ(str, expect);
   }
+
+  // Check that the first tokens and offsets of two outputs of a tokenizer are the same
+  void CheckSameTokens(const TensorRow &out, const TensorRow &expect, dsize_t num_tokens) {
+    ASSERT_EQ(out.size(), 3);
+    ASSERT_EQ(out[0]->Size(), num_tokens);
+    for (dsize_t i = 0; i < num_tokens; ++i) {
+      std::string_view token;
+      ASSERT_TRUE(expect[0]->GetItemAt(&token, {i}).IsOk());
+      CheckEqual(out[0], {i}, std::string(token));
+      for (size_t col = 1; col < out.size(); ++col) {
+        uint32_t offset = 0;
+        uint32_t expect_offset = 0;
+        ASSERT_TRUE(out[col]->GetItemAt(&offset, {i}).IsOk());
+        ASSERT_TRUE(expect[col]->GetItemAt(&expect_offset, {i}).IsOk());
+        EXPECT_EQ(offset, expect_offset);
+      }
+    }
+  }
 };
 
 TEST_F(MindDataTestTokenizerOp, TestUnicodeCharTokenizerOp) {
@@ -358,4 +380,62 @@ std::shared_ptr<Tensor> input;
   TensorRow output;
   Status s = basic_tokenizer->Compute(TensorRow(0, {input}), &output);
   EXPECT_TRUE(s.IsOk());
-}
\ No newline at end of file
+}
+TEST_F(MindDataTestTokenizerOp, TestBasicTokenizerAscii) {
+  MS_LOG(INFO) << "Doing TestBasicTokenizerAscii.";
+  // ASCII text is tokenized without ICU. A non-ASCII word at the end sends the text through ICU, which must give
+  // the same tokens before that word.
+  std::vector<std::string> texts = {"Welcome to Beijing!",
+                                    "Hello\tWorld,  [CLS] hi[SEP]x [unused12] [Mask] [unused] [x [UNK]",
+                                    "a\x01b\x7f" "c 3.14 e-mail@x.com [[PAD] ([MASK])  ~"};
+  for (int flags = 0; flags < 8; ++flags) {
+    bool lower_case = (flags & 1) != 0;
+    bool keep_whitespace = (flags & 2) != 0;
+    bool preserve_unused_token = (flags & 4) != 0;
+    BasicTokenizerOp op(lower_case, keep_whitespace, NormalizeForm::kNone, preserve_unused_token, true);
+    for (const auto &text : texts) {
+      std::shared_ptr<Tensor> ascii, mixed;
+      Tensor::CreateScalar<std::string>(text, &ascii);
+      Tensor::CreateScalar<std::string>(text + " \xC3\xA9", &mixed);
+      TensorRow fast, slow;
+      ASSERT_TRUE(op.Compute(TensorRow(0, {ascii}), &fast).IsOk());
+      ASSERT_TRUE(op.Compute(TensorRow(0, {mixed}), &slow).IsOk());
+      CheckSameTokens(fast, slow, slow[0]->Size() - (keep_whitespace ? 2 : 1));
+    }
+  }
+}
+
+TEST_F(MindDataTestTokenizerOp, TestBertTokenizerAscii) {
+  MS_LOG(INFO) << "Doing TestBertTokenizerAscii.";
+  std::unordered_map<WordType, WordIdType> words = {{"[UNK]", 0}, {"want", 1}, {"##want", 2}, {"##ed", 3}, {"wa", 4},
+                                                    {"un", 5},    {"runn", 6}, {"##ing", 7},  {",", 8}};
+  std::shared_ptr<Vocab> vocab = std::make_shared<Vocab>();
+  ASSERT_TRUE(Vocab::BuildFromUnorderedMap(words, &vocab).IsOk());
+  BertTokenizerOp op(vocab, "##", 100, "[UNK]", true, false, NormalizeForm::kNone, true, true);
+  std::string text = "UNwanted running, xyz wantx";
+  std::shared_ptr<Tensor> input;
+  Tensor::CreateScalar<std::string>(text, &input);
+  TensorRow output;
+  ASSERT_TRUE(op.Compute(TensorRow(0, {input}), &output).IsOk());
+  std::vector<std::string> tokens = {"un", "##want", "##ed", "runn", "##ing", ",", "[UNK]", "[UNK]"};
+  std::vector<uint32_t> starts = {0, 2, 6, 9, 13, 16, 18, 22};
+  std::vector<uint32_t> limits = {2, 6, 8, 13, 16, 17, 21, 27};
+  ASSERT_EQ(output.size(), 3);
+  ASSERT_EQ(output[0]->Size(), tokens.size());
+  for (dsize_t i = 0; i < tokens.size(); ++i) {
+    CheckEqual(output[0], {i}, tokens[i]);
+    uint32_t offset = 0;
+    ASSERT_TRUE(output[1]->GetItemAt(&offset, {i}).IsOk());
+    EXPECT_EQ(offset, starts[i]);
+    ASSERT_TRUE(output[2]->GetItemAt(&offset, {i}).IsOk());
+    EXPECT_EQ(offset, limits[i]);
+  }
+
+  // The same text through ICU, with one more unknown word
+  std::shared_ptr<Tensor> mixed;
+  Tensor::CreateScalar<std::string>(text + " \xC3\xA9", &mixed);
+  TensorRow slow;
+  ASSERT_TRUE(op.Compute(TensorRow(0, {mixed}), &slow).IsOk());
+  ASSERT_EQ(slow[0]->Size(), tokens.size() + 1);
+  CheckSameTokens(output, slow, tokens.size());
+}
@@ -0,0 +1,184 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "frontend/operator/ops.h"
+#include "backend/session/kernel_graph.h"
+#include "backend/session/anf_runtime_algorithm.h"
+#include "runtime/device/kernel_info.h"
+#include "runtime/device/cpu/cpu_simple_mem_plan.h"
+
+namespace mindspore {
+namespace device {
+namespace cpu {
+using session::KernelGraph;
+
+class TestCPUSimpleMemPlan : public UT::Common {
+ public:
+  TestCPUSimpleMemPlan() = default;
+};
+
+namespace {
+class TestDeviceAddress : public DeviceAddress {
+ public:
+  explicit TestDeviceAddress(size_t size) : DeviceAddress(nullptr, size) {}
+  TestDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~TestDeviceAddress() override = default;
+  bool SyncDeviceToHost(const ShapeVector &shape, size_t size, TypeId type, void *host_ptr) const override {
+    return true;
+  }
+  bool SyncHostToDevice(const ShapeVector &shape, size_t size, TypeId type, const void *host_ptr,
+                        const std::string &format) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+};
+
+class TestKernelMod : public kernel::KernelMod {
+ public:
+  explicit TestKernelMod(const std::vector<size_t> &workspace_size_list) : workspace_size_list_(workspace_size_list) {}
+  ~TestKernelMod() override = default;
+  const std::vector<size_t> &GetInputSizeList() const override { return input_size_list_; }
+  const std::vector<size_t> &GetOutputSizeList() const override { return output_size_list_; }
+  const std::vector<size_t> &GetWorkspaceSizeList() const override { return workspace_size_list_; }
+  bool Launch(const std::vector<kernel::AddressPtr> &inputs, const std::vector<kernel::AddressPtr> &workspace,
+              const std::vector<kernel::AddressPtr> &outputs, void *stream_ptr) override {
+    return true;
+  }
+
+ private:
+  std::vector<size_t> input_size_list_;
+  std::vector<size_t> output_size_list_;
+  std::vector<size_t> workspace_size_list_;
+};
+
+// A kernel with one output of output_size bytes and the workspaces of workspace_sizes.
+CNodePtr NewKernel(const std::shared_ptr<KernelGraph> &graph, const std::vector<AnfNodePtr> &input_nodes,
+                   size_t output_size, const std::vector<size_t> &workspace_sizes = {}) {
+  std::vector<AnfNodePtr> inputs = {NewValueNode(prim::kPrimAdd)};
+  inputs.insert(inputs.end(), input_nodes.begin(), input_nodes.end());
+  auto kernel = graph->NewCNode(inputs);
+  MS_EXCEPTION_IF_NULL(kernel);
+  std::vector<int64_t> shape = {1};
+  kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shape));
+  kernel->set_kernel_info(std::make_shared<KernelInfo>());
+  auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+  MS_EXCEPTION_IF_NULL(kernel_info);
+  kernel_info->set_kernel_mod(std::make_shared<TestKernelMod>(workspace_sizes));
+  kernel_info->SetOutputAddr(std::make_shared<TestDeviceAddress>(output_size), 0);
+  for (size_t i = 0; i < workspace_sizes.size(); ++i) {
+    kernel_info->SetWorkspaceAddr(std::make_shared<TestDeviceAddress>(workspace_sizes[i]), i);
+  }
+  return kernel;
+}
+
+const uint8_t *OutputPtr(const CNodePtr &kernel) {
+  return static_cast<const uint8_t *>(AnfAlgo::GetOutputAddr(kernel, 0)->GetPtr());
+}
+
+bool IsOverlapped(const uint8_t *a, size_t a_size, const uint8_t *b, size_t b_size) {
+  return a < b + b_size && b < a + a_size;
+}
+}  // namespace
+
+// a -> b -> c -> d: the output of a is released after b, so c reuses it, the output of d is the graph output.
+TEST_F(TestCPUSimpleMemPlan, ReuseInChain) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto a = NewKernel(graph, {}, 1000);
+  auto b = NewKernel(graph, {a}, 1000, {100});
+  auto c = NewKernel(graph, {b}, 1000);
+  auto d = NewKernel(graph, {c}, 1000);
+  graph->set_output(d);
+  graph->set_execution_order({a, b, c, d});
+
+  CPUSimpleMemPlan mem_plan;
+  // The sizes are aligned to 64 bytes: a and c share 1024 bytes, b takes 1024 bytes and its workspace 128 bytes.
+  size_t total_size = mem_plan.MemReusePlan(graph.get());
+  EXPECT_EQ(total_size, 2 * 1024 + 128);
+  std::vector<uint8_t> memory(total_size);
+  mem_plan.MemReuseAssign(memory.data());
+
+  EXPECT_EQ(OutputPtr(a), OutputPtr(c));
+  auto workspace = static_cast<const uint8_t *>(AnfAlgo::GetWorkspaceAddr(b, 0)->GetPtr());
+  EXPECT_FALSE(IsOverlapped(OutputPtr(a), 1000, OutputPtr(b), 1000));
+  EXPECT_FALSE(IsOverlapped(OutputPtr(a), 1000, workspace, 100));
+  EXPECT_FALSE(IsOverlapped(OutputPtr(b), 1000, workspace, 100));
+  for (const auto &kernel : {a, b, c}) {
+    EXPECT_TRUE(AnfAlgo::GetOutputAddr(kernel, 0)->is_static_mem());
+    EXPECT_GE(OutputPtr(kernel), memory.data());
+    EXPECT_LE(OutputPtr(kernel) + 1000, memory.data() + total_size);
+  }
+  // The graph output is handed over to the host tensor, so it is not planned.
+  EXPECT_EQ(OutputPtr(d), nullptr);
+  EXPECT_FALSE(AnfAlgo::GetOutputAddr(d, 0)->is_static_mem());
+}
+
+// b1 and b2 may run concurrently after a, so none of a, b1 and b2 share memory even though a is used up by both.
+TEST_F(TestCPUSimpleMemPlan, NoReuseInParallelBranches) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto a = NewKernel(graph, {}, 512);
+  auto b1 = NewKernel(graph, {a}, 512);
+  auto b2 = NewKernel(graph, {a}, 512);
+  auto c = NewKernel(graph, {b1, b2}, 512);
+  auto d = NewKernel(graph, {c}, 512);
+  graph->set_output(d);
+  graph->set_execution_order({a, b1, b2, c, d});
+
+  CPUSimpleMemPlan mem_plan;
+  size_t total_size = mem_plan.MemReusePlan(graph.get());
+  // c is produced after a, b1 and b2 are all released, so it reuses one of them.
+  EXPECT_EQ(total_size, 3 * 512);
+  std::vector<uint8_t> memory(total_size);
+  mem_plan.MemReuseAssign(memory.data());
+
+  std::vector<CNodePtr> branches = {a, b1, b2};
+  for (size_t i = 0; i < branches.size(); ++i) {
+    for (size_t j = i + 1; j < branches.size(); ++j) {
+      EXPECT_FALSE(IsOverlapped(OutputPtr(branches[i]), 512, OutputPtr(branches[j]), 512));
+    }
+  }
+  EXPECT_FALSE(IsOverlapped(OutputPtr(c), 512, OutputPtr(b1), 512));
+  EXPECT_FALSE(IsOverlapped(OutputPtr(c), 512, OutputPtr(b2), 512));
+  EXPECT_EQ(OutputPtr(c), OutputPtr(a));
+}
+
+// The device tensors which already have memory keep it.
+TEST_F(TestCPUSimpleMemPlan, SkipAllocatedAddress) {
+  auto graph = std::make_shared<KernelGraph>();
+  auto a = NewKernel(graph, {}, 256);
+  auto b = NewKernel(graph, {a}, 256);
+  auto c = NewKernel(graph, {b}, 256);
+  graph->set_output(c);
+  graph->set_execution_order({a, b, c});
+  // Replace the output of a with an address which has memory.
+  std::vector<uint8_t> allocated(256);
+  auto kernel_info = dynamic_cast<KernelInfo *>(a->kernel_info());
+  MS_EXCEPTION_IF_NULL(kernel_info);
+  kernel_info->SetOutputAddr(std::make_shared<TestDeviceAddress>(allocated.data(), 256), 0);
+
+  CPUSimpleMemPlan mem_plan;
+  EXPECT_EQ(mem_plan.MemReusePlan(graph.get()), 256);
+  std::vector<uint8_t> memory(256);
+  mem_plan.MemReuseAssign(memory.data());
+  EXPECT_EQ(OutputPtr(a), allocated.data());
+  EXPECT_FALSE(AnfAlgo::GetOutputAddr(a, 0)->is_static_mem());
+  EXPECT_EQ(OutputPtr(b), memory.data());
+}
+}  // namespace cpu
+}  // namespace device
+}  // namespace mindspore
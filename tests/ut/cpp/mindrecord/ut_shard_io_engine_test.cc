@@ -0,0 +1,240 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "utils/ms_utils.h"
+#include "gtest/gtest.h"
+#include "utils/log_adapter.h"
+#include "minddata/mindrecord/include/shard_io_engine.h"
+#include "minddata/mindrecord/include/shard_reader.h"
+#include "minddata/mindrecord/include/shard_shuffle.h"
+#include "ut_common.h"
+
+using mindspore::LogStream;
+using mindspore::ExceptionType::NoExceptionType;
+using mindspore::MsLogLevel::INFO;
+
+namespace mindspore {
+namespace mindrecord {
+namespace {
+const uint64_t kEngineFileSize = 1 << 20;
+
+uint8_t ExpectedByte(int file_id, uint64_t offset) { return static_cast<uint8_t>((offset * 31 + file_id * 7) % 251); }
+
+// each row has the label i and a blob filled with i % 251, the default page size is kept when page_size is 0
+void WriteBlobRows(const std::string &file_name, int row_count, int blob_size, uint64_t page_size = 0) {
+  ShardHeader header_data;
+  json anno_schema_json = R"({"file_name": {"type": "string"}, "label": {"type": "int32"}})"_json;
+  std::shared_ptr<Schema> anno_schema = Schema::Build("annotation", anno_schema_json);
+  ASSERT_TRUE(anno_schema != nullptr);
+  int anno_schema_id = header_data.AddSchema(anno_schema);
+  header_data.AddIndexFields({{anno_schema_id, "label"}});
+
+  std::vector<json> annotations;
+  std::vector<std::vector<uint8_t>> bin_data;
+  for (int i = 0; i < row_count; i++) {
+    annotations.push_back(json{{"file_name", std::to_string(i) + ".jpg"}, {"label", i}});
+    bin_data.emplace_back(blob_size, static_cast<uint8_t>(i % 251));
+  }
+  std::map<std::uint64_t, std::vector<json>> rawdatas = {{anno_schema_id, annotations}};
+
+  ShardWriter fw;
+  ASSERT_EQ(fw.Open({file_name}), SUCCESS);
+  if (page_size > 0) {
+    ASSERT_EQ(fw.SetPageSize(page_size), SUCCESS);
+  }
+  fw.SetShardHeader(std::make_shared<ShardHeader>(header_data));
+  ASSERT_EQ(fw.WriteRawData(rawdatas, bin_data), SUCCESS);
+  ASSERT_EQ(fw.Commit(), SUCCESS);
+  ShardIndexGenerator sg{file_name};
+  sg.Build();
+  sg.WriteToDatabase();
+}
+}  // namespace
+
+class TestShardIOEngine : public UT::Common {
+ public:
+  TestShardIOEngine() {}
+  void SetUp() override {
+    for (int i = 0; i < 2; i++) {
+      std::ofstream out(FileName(i), std::ios::out | std::ios::binary);
+      for (uint64_t offset = 0; offset < kEngineFileSize; offset++) {
+        out.put(static_cast<char>(ExpectedByte(i, offset)));
+      }
+    }
+  }
+
+  void TearDown() override {
+    for (int i = 0; i < 2; i++) {
+      remove(common::SafeCStr(FileName(i)));
+    }
+    for (const auto &name : {"./get_next.mindrecord", "./get_next.mindrecord.db", "./by_ids.mindrecord",
+                             "./by_ids.mindrecord.db", "./prefetch.mindrecord", "./prefetch.mindrecord.db"}) {
+      remove(name);
+    }
+  }
+
+  static std::string FileName(int i) { return std::string("./io_engine.data") + std::to_string(i); }
+};
+
+TEST_F(TestShardIOEngine, TestShardIOEngineCoalescedRead) {
+  MS_LOG(INFO) << FormatInfo("Test read engine with coalesced and scattered requests");
+  ShardIOEngine engine({FileName(0), FileName(1)});
+  ASSERT_EQ(engine.Open(), SUCCESS);
+  MS_LOG(INFO) << "Read by io_uring: " << engine.UseIoRing();
+
+  // adjacent, small hole, overlapped, duplicated, cross shard and more scattered reads than the ring entries
+  std::vector<std::pair<uint32_t, std::pair<uint64_t, uint64_t>>> ranges = {
+    {0, {0, 100}},   {0, {100, 28}},   {0, {228, 1000}}, {0, {500, 300}},     {0, {500, 300}},
+    {1, {0, 4096}},  {1, {4096, 1}},   {0, {9000, 0}},   {1, {kEngineFileSize - 10, 10}}};
+  for (uint64_t i = 0; i < 200; i++) {
+    ranges.push_back({static_cast<uint32_t>(i % 2), {16384 + i * 5000, 1000 + i}});
+  }
+
+  std::vector<std::vector<uint8_t>> buffers;
+  std::vector<ShardReadRequest> requests;
+  for (const auto &range : ranges) {
+    buffers.emplace_back(range.second.second);
+  }
+  for (size_t i = 0; i < ranges.size(); i++) {
+    requests.push_back({ranges[i].first, ranges[i].second.first, ranges[i].second.second, buffers[i].data()});
+  }
+  ASSERT_EQ(engine.Read(requests), SUCCESS);
+
+  for (size_t i = 0; i < ranges.size(); i++) {
+    for (uint64_t j = 0; j < buffers[i].size(); j++) {
+      ASSERT_EQ(buffers[i][j], ExpectedByte(ranges[i].first, ranges[i].second.first + j));
+    }
+  }
+
+  // read beyond the end of file
+  std::vector<uint8_t> tail(20);
+  ASSERT_EQ(engine.Read({{0, kEngineFileSize - 10, 20, tail.data()}}), FAILED);
+  engine.Close();
+}
+
+// the consumers read the rows in batches, every row is read once with its own blob
+TEST_F(TestShardIOEngine, TestShardReaderGetNext) {
+  MS_LOG(INFO) << FormatInfo("Test read all the rows of generated mindrecord");
+  const int row_count = 300;
+  const int blob_size = 4096;
+  std::string file_name = "./get_next.mindrecord";
+  WriteBlobRows(file_name, row_count, blob_size);
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_name}, true, 4, {"label"}), SUCCESS);
+  dataset.Launch();
+  std::vector<int> label_counts(row_count, 0);
+  int rows = 0;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    for (auto &j : x) {
+      auto &blob = std::get<0>(j);
+      int label = std::get<1>(j)["label"].get<int>();
+      ASSERT_GE(label, 0);
+      ASSERT_LT(label, row_count);
+      label_counts[label]++;
+      ASSERT_EQ(blob.size(), blob_size);
+      ASSERT_EQ(blob.front(), static_cast<uint8_t>(label % 251));
+      ASSERT_EQ(blob.back(), static_cast<uint8_t>(label % 251));
+      rows++;
+    }
+  }
+  dataset.Close();
+  ASSERT_EQ(rows, row_count);
+  for (int i = 0; i < row_count; i++) {
+    ASSERT_EQ(label_counts[i], 1) << "label " << i;
+  }
+}
+
+// the rows read in a batch are the same as the rows read one by one, the ids after the last row are dropped
+TEST_F(TestShardIOEngine, TestShardReaderGetNextByIds) {
+  MS_LOG(INFO) << FormatInfo("Test read rows by ids in batch");
+  const int row_count = 100;
+  const int blob_size = 1000;
+  std::string file_name = "./by_ids.mindrecord";
+  WriteBlobRows(file_name, row_count, blob_size);
+
+  ShardReader dataset;
+  ASSERT_EQ(dataset.Open({file_name}, true, 1, {"label"}), SUCCESS);
+  dataset.Launch(true);
+  std::vector<int64_t> ids = {5, 6, 7, 42, 3, 99, 0, 7};
+  auto rows = dataset.GetNextByIds(ids, 0);
+  ASSERT_EQ(rows.size(), ids.size());
+  for (size_t i = 0; i < ids.size(); i++) {
+    auto row = dataset.GetNextById(ids[i], 0);
+    ASSERT_EQ(rows[i].first, TaskType::kCommonTask);
+    ASSERT_EQ(rows[i].second.size(), 1);
+    ASSERT_EQ(row.second.size(), 1);
+    auto &blob = std::get<0>(rows[i].second[0]);
+    ASSERT_EQ(blob, std::get<0>(row.second[0]));
+    ASSERT_EQ(blob.size(), blob_size);
+    int label = std::get<1>(rows[i].second[0])["label"].get<int>();
+    ASSERT_EQ(label, std::get<1>(row.second[0])["label"].get<int>());
+    ASSERT_EQ(blob.back(), static_cast<uint8_t>(label % 251));
+  }
+  rows = dataset.GetNextByIds({row_count - 2, row_count - 1, row_count, 0}, 0);
+  ASSERT_EQ(rows.size(), 2);
+  ASSERT_TRUE(dataset.GetNextByIds({row_count}, 0).empty());
+  dataset.Close();
+}
+
+// the pages of the rows after each batch are loaded by the prefetch thread, so only the pages of the first batch miss
+TEST_F(TestShardIOEngine, TestShardReaderPrefetchByIds) {
+  MS_LOG(INFO) << FormatInfo("Test prefetch the pages of the rows read by ids");
+  const int row_count = 300;
+  const int blob_size = 1024;
+  const uint32_t window_pages = 4;
+  std::string file_name = "./prefetch.mindrecord";
+  WriteBlobRows(file_name, row_count, blob_size, kMinPageSize);
+
+  ShardReader dataset;
+  std::vector<std::shared_ptr<ShardOperator>> ops = {std::make_shared<ShardShuffle>(1, kShuffleBlock, window_pages)};
+  ASSERT_EQ(dataset.Open({file_name}, true, 1, {"label"}, ops), SUCCESS);
+  dataset.Launch(true);
+  std::vector<int> label_counts(row_count, 0);
+  for (int64_t start = 0; start < row_count; start += kNumRowsInRead) {
+    std::vector<int64_t> ids;
+    for (int64_t id = start; id < std::min<int64_t>(start + kNumRowsInRead, row_count); id++) {
+      ids.push_back(id);
+    }
+    auto rows = dataset.GetNextByIds(ids, 0);
+    ASSERT_EQ(rows.size(), ids.size());
+    for (const auto &row : rows) {
+      ASSERT_EQ(row.second.size(), 1);
+      auto &blob = std::get<0>(row.second[0]);
+      int label = std::get<1>(row.second[0])["label"].get<int>();
+      ASSERT_EQ(blob, std::vector<uint8_t>(blob_size, static_cast<uint8_t>(label % 251)));
+      label_counts[label]++;
+    }
+  }
+  for (int i = 0; i < row_count; i++) {
+    ASSERT_EQ(label_counts[i], 1) << "label " << i;
+  }
+  // the first batch is in the first window, every other row is copied from a page loaded ahead of its batch
+  EXPECT_GE(dataset.GetPageCacheHitRate(), static_cast<double>(row_count - window_pages) / row_count);
+  dataset.Close();
+}
+}  // namespace mindrecord
+}  // namespace mindspore
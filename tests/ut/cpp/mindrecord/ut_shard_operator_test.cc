@@ -17,6 +17,7 @@
 #include <cstring>
 #include <functional>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -378,6 +379,75 @@ TEST_F(TestShardOperator, TestShardShuffleCompare) {
   ASSERT_TRUE(different);
 }
 
+TEST_F(TestShardOperator, TestShardBlockShuffle) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet by block shuffle"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  std::vector<std::shared_ptr<ShardOperator>> ops;
+  ops.push_back(std::make_shared<ShardShuffle>(1, kShuffleBlock, 2));
+
+  ShardReader dataset;
+  dataset.Open({file_name}, true, 4, column_list, ops);
+  dataset.Launch();
+
+  ShardReader compare_dataset;
+  compare_dataset.Open({file_name}, true, 4, column_list);
+  compare_dataset.Launch();
+
+  // the blobs copied from the cached pages are the same as the ones read directly
+  std::map<std::string, std::vector<uint8_t>> blobs;
+  std::map<std::string, std::vector<uint8_t>> compare_blobs;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    blobs[(std::get<1>(x[0]))["file_name"].get<std::string>()] = std::get<0>(x[0]);
+    auto y = compare_dataset.GetNext();
+    compare_blobs[(std::get<1>(y[0]))["file_name"].get<std::string>()] = std::get<0>(y[0]);
+  }
+  MS_LOG(INFO) << "Page cache hit rate: " << dataset.GetPageCacheHitRate()
+               << ", bytes read: " << dataset.GetBytesRead();
+  ASSERT_GT(dataset.GetPageCacheHitRate(), 0);
+  ASSERT_GT(dataset.GetBytesRead(), 0);
+  dataset.Close();
+  compare_dataset.Close();
+  ASSERT_TRUE(blobs == compare_blobs);
+}
+
+TEST_F(TestShardOperator, TestShardBlockShuffleMode) {
+  MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet by the block shuffle mode of dataset"));
+  std::string file_name = "./imagenet.shard01";
+  auto column_list = std::vector<std::string>{"file_name", "label"};
+
+  // the dataset selects the block shuffle through the shuffle mode of the sampler
+  std::vector<std::shared_ptr<ShardOperator>> ops;
+  auto shuffle_op = std::make_shared<ShardShuffle>(1, 0, false, true);
+  shuffle_op->UpdateShuffleMode(dataset::ShuffleMode::kBlock);
+  ops.push_back(shuffle_op);
+
+  ShardReader dataset;
+  dataset.Open({file_name}, true, 4, column_list, ops);
+  dataset.Launch();
+
+  ShardReader compare_dataset;
+  compare_dataset.Open({file_name}, true, 4, column_list);
+  compare_dataset.Launch();
+
+  std::map<std::string, std::vector<uint8_t>> blobs;
+  std::map<std::string, std::vector<uint8_t>> compare_blobs;
+  while (true) {
+    auto x = dataset.GetNext();
+    if (x.empty()) break;
+    blobs[(std::get<1>(x[0]))["file_name"].get<std::string>()] = std::get<0>(x[0]);
+    auto y = compare_dataset.GetNext();
+    compare_blobs[(std::get<1>(y[0]))["file_name"].get<std::string>()] = std::get<0>(y[0]);
+  }
+  ASSERT_GT(dataset.GetPageCacheHitRate(), 0);
+  dataset.Close();
+  compare_dataset.Close();
+  ASSERT_TRUE(blobs == compare_blobs);
+}
+
 TEST_F(TestShardOperator, TestShardCategoryShuffle1) {
   MS_LOG(INFO) << common::SafeCStr(FormatInfo("Test read imageNet"));
 
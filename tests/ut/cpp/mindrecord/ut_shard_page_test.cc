@@ -22,6 +22,7 @@
 #include "gtest/gtest.h"
 #include "utils/log_adapter.h"
 #include "minddata/mindrecord/include/shard_page.h"
+#include "minddata/mindrecord/include/shard_page_cache.h"
 #include "ut_common.h"
 
 using json = nlohmann::json;
@@ -157,5 +158,36 @@ TEST_F(TestShardPage, TestJson) {
     ++i;
   }
 }
+
+TEST_F(TestShardPage, TestPageCache) {
+  MS_LOG(INFO) << FormatInfo("Test ShardPageCache LRU");
+  ShardPageCache cache(200);
+  ShardPageCache::PageData data;
+
+  // the first lookup claims the page, the second one waits for it
+  ASSERT_TRUE(cache.TryGet({0, 1}, &data));
+  ASSERT_FALSE(cache.TryGet({0, 1}, &data));
+  ASSERT_TRUE(data == nullptr);
+  cache.Fill({0, 1}, std::make_shared<std::vector<uint8_t>>(100, 1));
+  ASSERT_TRUE(cache.Wait({0, 1}) != nullptr);
+
+  ASSERT_TRUE(cache.TryGet({0, 2}, &data));
+  cache.Fill({0, 2}, std::make_shared<std::vector<uint8_t>>(100, 2));
+  ASSERT_FALSE(cache.TryGet({0, 1}, &data));
+  ASSERT_EQ((*data)[0], 1);
+
+  // page 2 is the least recently used one
+  ASSERT_TRUE(cache.TryGet({1, 1}, &data));
+  cache.Fill({1, 1}, std::make_shared<std::vector<uint8_t>>(100, 3));
+  ASSERT_FALSE(cache.TryGet({0, 1}, &data));
+  ASSERT_TRUE(cache.TryGet({0, 2}, &data));
+  cache.Abandon({0, 2});
+  ASSERT_TRUE(cache.Wait({0, 2}) == nullptr);
+
+  cache.AddLookups(3, 1);
+  EXPECT_EQ(cache.GetHitCount(), 3);
+  EXPECT_EQ(cache.GetMissCount(), 1);
+  EXPECT_DOUBLE_EQ(cache.GetHitRate(), 0.75);
+}
 }  // namespace mindrecord
 }  // namespace mindspore
@@ -0,0 +1,206 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "backend/optimizer/mem_reuse/mem_dynamic_allocator.h"
+
+namespace mindspore {
+namespace device {
+class TestDynamicMemPool : public UT::Common {
+ public:
+  TestDynamicMemPool() = default;
+};
+
+namespace {
+// The size of memory block allocated from the host, to keep the test small.
+constexpr size_t kTestBlockSize = 64 << 20;
+
+// The memory pool backed by the host memory.
+class HostMemPool : public DynamicMemPoolBestFit {
+ public:
+  explicit HostMemPool(bool slab_enabled) : slab_enabled_(slab_enabled) {}
+  ~HostMemPool() override {
+    for (auto addr : blocks_) {
+      free(addr);
+    }
+  }
+  size_t AllocDeviceMem(size_t size, DeviceMemPtr *addr) override {
+    *addr = malloc(size);
+    if (*addr == nullptr) {
+      return 0;
+    }
+    (void)blocks_.insert(*addr);
+    return size;
+  }
+  bool FreeDeviceMem(const DeviceMemPtr &addr) override {
+    if (blocks_.erase(addr) == 0) {
+      return false;
+    }
+    free(addr);
+    return true;
+  }
+  size_t free_mem_size() override { return SIZE_MAX; }
+  size_t total_mem_size() override { return SIZE_MAX; }
+  size_t block_num() const { return blocks_.size(); }
+
+ protected:
+  size_t CalMemBlockAllocSize(size_t size) override { return std::max(size, kTestBlockSize); }
+  bool IsSlabEnabled() const override { return slab_enabled_; }
+
+ private:
+  bool slab_enabled_;
+  std::set<DeviceMemPtr> blocks_;
+};
+
+uintptr_t SlabOffset(const DeviceMemPtr &addr) { return reinterpret_cast<uintptr_t>(addr) % SLAB_SIZE; }
+}  // namespace
+
+// The small memory is carved from a chunk of slabs, and the freed memory is reused by the same size class.
+TEST_F(TestDynamicMemPool, SlabAllocAndFree) {
+  HostMemPool pool(true);
+  auto addr1 = pool.AllocTensorMem(100);
+  ASSERT_NE(addr1, nullptr);
+  // The slab chunk is the only memory taken from the best fit pool.
+  auto chunk_size = pool.used_mem_statistics();
+  EXPECT_GE(chunk_size, (SLAB_SIZE + 1) * 16);
+  auto addr2 = pool.AllocTensorMem(512);
+  ASSERT_NE(addr2, nullptr);
+  EXPECT_NE(addr1, addr2);
+  EXPECT_EQ(pool.used_mem_statistics(), chunk_size);
+  memset(addr1, 1, 100);
+  memset(addr2, 2, 512);
+
+  pool.FreeTensorMem(addr1);
+  EXPECT_EQ(pool.AllocTensorMem(512), addr1);
+  pool.FreeTensorMem(addr1);
+  pool.FreeTensorMem(addr2);
+  EXPECT_EQ(pool.used_mem_statistics(), chunk_size);
+}
+
+// The aligned size is rounded up to the power of two size class from 512 bytes to 32K.
+TEST_F(TestDynamicMemPool, SlabSizeClass) {
+  HostMemPool pool(true);
+  for (size_t class_size = SLAB_MIN_CLASS_SIZE; class_size <= (SLAB_MIN_CLASS_SIZE << (SLAB_CLASS_NUM - 1));
+       class_size <<= 1) {
+    auto addr = pool.AllocTensorMem(class_size / 2 + 1);
+    ASSERT_NE(addr, nullptr);
+    EXPECT_EQ(SlabOffset(addr) % class_size, 0);
+    // The memory is reused by the request of the same size class.
+    pool.FreeTensorMem(addr);
+    EXPECT_EQ(pool.AllocTensorMem(class_size), addr);
+    pool.FreeTensorMem(addr);
+  }
+  // 600 bytes are aligned to 1024 bytes, which is not in the size class of 1536 bytes.
+  auto addr1 = pool.AllocTensorMem(600);
+  pool.FreeTensorMem(addr1);
+  auto addr2 = pool.AllocTensorMem(1536);
+  EXPECT_NE(addr2, addr1);
+  EXPECT_EQ(SlabOffset(addr2) % 2048, 0);
+  pool.FreeTensorMem(addr2);
+}
+
+// The memory larger than the biggest size class is allocated from the best fit pool.
+TEST_F(TestDynamicMemPool, LargeMemFallback) {
+  HostMemPool pool(true);
+  auto small_addr = pool.AllocTensorMem(SLAB_MIN_CLASS_SIZE);
+  ASSERT_NE(small_addr, nullptr);
+  auto chunk_size = pool.used_mem_statistics();
+  size_t large_size = (SLAB_MIN_CLASS_SIZE << (SLAB_CLASS_NUM - 1)) + 1;
+  auto large_addr = pool.AllocTensorMem(large_size);
+  ASSERT_NE(large_addr, nullptr);
+  size_t align_size = (large_size + DYNAMIC_MEM_ALIGN_SIZE - 1) / DYNAMIC_MEM_ALIGN_SIZE * DYNAMIC_MEM_ALIGN_SIZE;
+  EXPECT_EQ(pool.used_mem_statistics(), chunk_size + align_size);
+  pool.FreeTensorMem(large_addr);
+  EXPECT_EQ(pool.used_mem_statistics(), chunk_size);
+  pool.FreeTensorMem(small_addr);
+}
+
+// The pool which does not enable the slabs allocates all the memory from the best fit pool.
+TEST_F(TestDynamicMemPool, SlabDisabled) {
+  HostMemPool pool(false);
+  auto addr = pool.AllocTensorMem(100);
+  ASSERT_NE(addr, nullptr);
+  EXPECT_EQ(pool.used_mem_statistics(), DYNAMIC_MEM_ALIGN_SIZE);
+  pool.FreeTensorMem(addr);
+  EXPECT_EQ(pool.used_mem_statistics(), 0);
+}
+
+// The memory allocated by the threads concurrently never overlaps.
+TEST_F(TestDynamicMemPool, SlabMultiThread) {
+  constexpr size_t kThreadNum = 4;
+  constexpr size_t kAllocNum = 1000;
+  HostMemPool pool(true);
+  std::vector<std::thread> threads;
+  std::vector<int> results(kThreadNum, 0);
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    threads.emplace_back([&pool, &results, i]() {
+      std::vector<std::pair<DeviceMemPtr, size_t>> allocated;
+      bool success = true;
+      for (size_t j = 0; j < kAllocNum; ++j) {
+        size_t size = (j * 97 + i * 31) % (SLAB_MIN_CLASS_SIZE << (SLAB_CLASS_NUM - 1)) + 1;
+        auto addr = pool.AllocTensorMem(size);
+        if (addr == nullptr) {
+          success = false;
+          break;
+        }
+        memset(addr, static_cast<int>(i + 1), size);
+        allocated.emplace_back(addr, size);
+        // Free half of the memory to move the memory between the thread caches.
+        if (j % 2 == 1) {
+          auto &front = allocated[allocated.size() / 2];
+          pool.FreeTensorMem(front.first);
+          allocated.erase(allocated.begin() + allocated.size() / 2);
+        }
+      }
+      for (auto &item : allocated) {
+        auto data = static_cast<const uint8_t *>(item.first);
+        for (size_t k = 0; k < item.second; ++k) {
+          success = success && (data[k] == i + 1);
+        }
+        pool.FreeTensorMem(item.first);
+      }
+      results[i] = success ? 1 : 0;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (size_t i = 0; i < kThreadNum; ++i) {
+    EXPECT_EQ(results[i], 1);
+  }
+}
+
+// The memory cached by the threads is invalid after the device memory is released.
+TEST_F(TestDynamicMemPool, SlabReleaseDeviceRes) {
+  HostMemPool pool(true);
+  auto addr = pool.AllocTensorMem(100);
+  ASSERT_NE(addr, nullptr);
+  pool.FreeTensorMem(addr);
+  EXPECT_EQ(pool.slab_generation(), 0);
+  pool.ReleaseDeviceRes();
+  EXPECT_EQ(pool.slab_generation(), 1);
+  EXPECT_EQ(pool.block_num(), 0);
+}
+}  // namespace device
+}  // namespace mindspore
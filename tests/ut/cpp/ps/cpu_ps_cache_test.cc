@@ -0,0 +1,79 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/ps_cache_factory.h"
+#include "utils/ms_context.h"
+
+namespace mindspore {
+namespace ps {
+class TestCPUPsCache : public UT::Common {
+ public:
+  TestCPUPsCache() = default;
+};
+
+// Rows swapped in at some indices of the device table come back unchanged when they are swapped out.
+TEST_F(TestCPUPsCache, SwapInAndOut) {
+  constexpr size_t kVocabSize = 8;
+  constexpr size_t kEmbeddingSize = 3;
+  auto ps_cache = PsCacheFactory::Get().ps_cache(kCPUDevice);
+  ASSERT_NE(ps_cache, nullptr);
+  ASSERT_TRUE(ps_cache->InitDevice(0, nullptr));
+
+  auto table = reinterpret_cast<float *>(ps_cache->MallocMemory(kVocabSize * kEmbeddingSize * sizeof(float)));
+  auto device_value = reinterpret_cast<float *>(ps_cache->MallocMemory(kVocabSize * kEmbeddingSize * sizeof(float)));
+  auto device_index = reinterpret_cast<int *>(ps_cache->MallocMemory(kVocabSize * sizeof(int)));
+  ASSERT_NE(table, nullptr);
+  ASSERT_NE(device_value, nullptr);
+  ASSERT_NE(device_index, nullptr);
+
+  std::vector<int> index = {5, 0, 7};
+  std::vector<float> value(index.size() * kEmbeddingSize);
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i] = static_cast<float>(i);
+  }
+  ASSERT_TRUE(ps_cache->CopyHostMemToDevice(device_index, index.data(), index.size() * sizeof(int)));
+  ASSERT_TRUE(ps_cache->CopyHostMemToDevice(device_value, value.data(), value.size() * sizeof(float)));
+  ASSERT_TRUE(ps_cache->HashSwapIn(table, device_value, device_index, kVocabSize, kEmbeddingSize, index.size()));
+  for (size_t i = 0; i < index.size(); ++i) {
+    for (size_t j = 0; j < kEmbeddingSize; ++j) {
+      EXPECT_EQ(table[index[i] * kEmbeddingSize + j], value[i * kEmbeddingSize + j]);
+    }
+  }
+
+  // Swap the rows out in the reverse order
+  std::vector<int> out_index(index.rbegin(), index.rend());
+  ASSERT_TRUE(ps_cache->CopyHostMemToDevice(device_index, out_index.data(), out_index.size() * sizeof(int)));
+  ASSERT_TRUE(ps_cache->HashSwapOut(table, device_value, device_index, kVocabSize, kEmbeddingSize, out_index.size()));
+  ASSERT_TRUE(ps_cache->SynchronizeStream());
+  std::vector<float> out_value(value.size());
+  ASSERT_TRUE(ps_cache->CopyDeviceMemToHost(out_value.data(), device_value, out_value.size() * sizeof(float)));
+  for (size_t i = 0; i < out_index.size(); ++i) {
+    for (size_t j = 0; j < kEmbeddingSize; ++j) {
+      EXPECT_EQ(out_value[i * kEmbeddingSize + j], value[(index.size() - 1 - i) * kEmbeddingSize + j]);
+    }
+  }
+
+  // An index out of the table is refused
+  std::vector<int> bad_index = {static_cast<int>(kVocabSize)};
+  ASSERT_TRUE(ps_cache->CopyHostMemToDevice(device_index, bad_index.data(), sizeof(int)));
+  EXPECT_FALSE(ps_cache->HashSwapOut(table, device_value, device_index, kVocabSize, kEmbeddingSize, 1));
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,249 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/ps_cache/embedding_hash_map.h"
+
+namespace mindspore {
+namespace ps {
+class TestEmbeddingHashMap : public UT::Common {
+ public:
+  TestEmbeddingHashMap() = default;
+};
+
+namespace {
+// Draw ids in [0, vocab_size) with P(id = k) proportional to 1 / (k + 1)^exponent, the ids are shuffled so the
+// frequent ones are spread over the vocab.
+class ZipfIds {
+ public:
+  ZipfIds(size_t vocab_size, double exponent, uint32_t seed) : gen_(seed), uniform_(0, 1), cdf_(vocab_size) {
+    double sum = 0;
+    for (size_t k = 0; k < vocab_size; k++) {
+      sum += 1 / std::pow(k + 1, exponent);
+      cdf_[k] = sum;
+    }
+    for (auto &value : cdf_) {
+      value /= sum;
+    }
+    ids_.resize(vocab_size);
+    for (size_t k = 0; k < vocab_size; k++) {
+      ids_[k] = static_cast<int>(k);
+    }
+    std::shuffle(ids_.begin(), ids_.end(), gen_);
+  }
+
+  void Fill(std::vector<int> *batch) {
+    for (auto &id : *batch) {
+      size_t rank = std::lower_bound(cdf_.begin(), cdf_.end(), uniform_(gen_)) - cdf_.begin();
+      id = ids_[std::min(rank, ids_.size() - 1)];
+    }
+  }
+
+ private:
+  std::mt19937 gen_;
+  std::uniform_real_distribution<double> uniform_;
+  std::vector<double> cdf_;
+  std::vector<int> ids_;
+};
+}  // namespace
+
+TEST_F(TestEmbeddingHashMap, IndexMapMatchesReference) {
+  constexpr size_t kCapacity = 1000;
+  HashIdIndexMap index_map(kCapacity);
+  std::unordered_map<int, int> reference;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> ids(-3000, 3000);
+  for (size_t step = 0; step < 200000; step++) {
+    int id = ids(gen);
+    auto iter = reference.find(id);
+    ASSERT_EQ(index_map.Find(id), iter == reference.end() ? INVALID_INDEX_VALUE : iter->second);
+    if (iter != reference.end()) {
+      index_map.Erase(id);
+      reference.erase(iter);
+    } else if (reference.size() < kCapacity) {
+      index_map.Insert(id, static_cast<int>(step));
+      reference[id] = static_cast<int>(step);
+    }
+    ASSERT_EQ(index_map.size(), reference.size());
+  }
+
+  std::vector<int> batch(5000);
+  for (auto &id : batch) {
+    id = ids(gen);
+  }
+  batch.push_back(HashIdIndexMap::kEmptyKey);
+  batch.push_back(HashIdIndexMap::kErasedKey);
+  std::vector<int> indices(batch.size());
+  index_map.Find(batch.data(), batch.size(), indices.data());
+  for (size_t i = 0; i < batch.size(); i++) {
+    auto iter = reference.find(batch[i]);
+    EXPECT_EQ(indices[i], iter == reference.end() ? INVALID_INDEX_VALUE : iter->second);
+  }
+  size_t visited = 0;
+  index_map.ForEach([&](int id, int index) {
+    EXPECT_EQ(reference[id], index);
+    visited++;
+  });
+  EXPECT_EQ(visited, reference.size());
+}
+
+TEST_F(TestEmbeddingHashMap, ParseDataSwapsExpired) {
+  // Indices 0 and 9 are reserved for the ids of the other devices
+  constexpr size_t kCapacity = 10;
+  EmbeddingHashMap hash_map(0, kCapacity);
+  std::vector<int> swap_out_index(kCapacity);
+  std::vector<int> swap_out_ids(kCapacity);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  for (int id = 0; id < 8; id++) {
+    int index = hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 0, &swap_out_size,
+                                   &need_wait_graph);
+    EXPECT_EQ(index, id + 1);
+  }
+  EXPECT_EQ(swap_out_size, 0);
+  EXPECT_EQ(hash_map.hash_id_count(), 8);
+
+  // At step 2 the rows of step 1 have been used, ids 0 and 1 are looked up again and stay
+  hash_map.Reset();
+  std::vector<int> batch = {0, 1, 1, 0, 100};
+  std::vector<int> hash_index(batch.size());
+  EXPECT_EQ(hash_map.FindAndMarkStep(batch.data(), batch.size(), 2, hash_index.data()), 2);
+  EXPECT_EQ(hash_index, std::vector<int>({1, 2, 2, 1, INVALID_INDEX_VALUE}));
+  int index = hash_map.ParseData(100, swap_out_index.data(), swap_out_ids.data(), 2, 2, &swap_out_size,
+                                 &need_wait_graph);
+  EXPECT_EQ(index, 3);
+  ASSERT_EQ(swap_out_size, 1);
+  EXPECT_EQ(swap_out_ids[0], 2);
+  EXPECT_EQ(hash_map.FindHashIndex(2), INVALID_INDEX_VALUE);
+  EXPECT_EQ(hash_map.FindHashIndex(100), 3);
+  EXPECT_FALSE(need_wait_graph);
+
+  std::vector<int> ids;
+  std::vector<int> indices;
+  hash_map.GetHashIdsAndIndices(&ids, &indices);
+  ASSERT_EQ(ids.size(), 8);
+  for (size_t i = 0; i < ids.size(); i++) {
+    EXPECT_EQ(hash_map.FindHashIndex(ids[i]), indices[i]);
+  }
+}
+
+// Several threads look up batches sharing ids, every index found is counted once.
+TEST_F(TestEmbeddingHashMap, FindAndMarkStepInThreads) {
+  constexpr size_t kCapacity = 100000;
+  constexpr size_t kThreads = 4;
+  EmbeddingHashMap hash_map(0, kCapacity);
+  std::vector<int> swap_out_index(kCapacity);
+  std::vector<int> swap_out_ids(kCapacity);
+  size_t swap_out_size = 0;
+  bool need_wait_graph = false;
+  for (int id = 0; id < 50000; id++) {
+    (void)hash_map.ParseData(id, swap_out_index.data(), swap_out_ids.data(), 1, 0, &swap_out_size, &need_wait_graph);
+  }
+
+  ZipfIds zipf(100000, 1.05, 1);
+  std::vector<int> batch(200000);
+  zipf.Fill(&batch);
+  std::vector<int> hash_index(batch.size());
+  size_t counts[kThreads] = {0};
+  std::vector<std::thread> threads;
+  size_t task_lens = batch.size() / kThreads;
+  for (size_t t = 0; t < kThreads; t++) {
+    threads.emplace_back([&, t]() {
+      counts[t] =
+        hash_map.FindAndMarkStep(batch.data() + t * task_lens, task_lens, 2, hash_index.data() + t * task_lens);
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  std::vector<int> found;
+  for (size_t i = 0; i < batch.size(); i++) {
+    EXPECT_EQ(hash_index[i], batch[i] < 50000 ? batch[i] + 1 : INVALID_INDEX_VALUE);
+    if (hash_index[i] != INVALID_INDEX_VALUE) {
+      found.push_back(hash_index[i]);
+    }
+  }
+  std::sort(found.begin(), found.end());
+  size_t unique_found = std::unique(found.begin(), found.end()) - found.begin();
+  size_t counted = 0;
+  for (size_t t = 0; t < kThreads; t++) {
+    counted += counts[t];
+  }
+  EXPECT_EQ(counted, unique_found);
+}
+
+// Every step looks up a batch of Zipf ids, then inserts the misses, swapping out the rows of the older steps, as
+// PsCacheManager::ParseData does. The lookups and the swaps are checked against a std::unordered_map.
+TEST_F(TestEmbeddingHashMap, ZipfMatchesReference) {
+  constexpr size_t kVocabSize = 64 << 10;
+  constexpr size_t kCacheSize = kVocabSize / 10;
+  constexpr size_t kBatchIds = 2000;
+  constexpr size_t kSteps = 10;
+
+  ZipfIds zipf(kVocabSize, 1.05, 2);
+  EmbeddingHashMap hash_map(0, kCacheSize);
+  std::unordered_map<int, int> reference;
+  std::vector<size_t> reference_steps(kCacheSize, 0);
+  std::vector<int> swap_out_index(kBatchIds);
+  std::vector<int> swap_out_ids(kBatchIds);
+  std::vector<int> batch(kBatchIds);
+  std::vector<int> hash_index(kBatchIds);
+  for (size_t step = 1; step <= kSteps; step++) {
+    zipf.Fill(&batch);
+    hash_map.Reset();
+
+    size_t marked = hash_map.FindAndMarkStep(batch.data(), batch.size(), step, hash_index.data());
+    size_t reference_marked = 0;
+    for (size_t i = 0; i < batch.size(); i++) {
+      auto iter = reference.find(batch[i]);
+      EXPECT_EQ(hash_index[i], iter == reference.end() ? INVALID_INDEX_VALUE : iter->second);
+      if (iter != reference.end() && reference_steps[iter->second] != step) {
+        reference_steps[iter->second] = step;
+        reference_marked++;
+      }
+    }
+    EXPECT_EQ(marked, reference_marked);
+
+    size_t swap_out_size = 0;
+    bool need_wait_graph = false;
+    for (size_t i = 0; i < batch.size(); i++) {
+      // An id missing twice in the batch is inserted by its first occurrence
+      if (hash_index[i] != INVALID_INDEX_VALUE || hash_map.FindHashIndex(batch[i]) != INVALID_INDEX_VALUE) {
+        continue;
+      }
+      size_t swapped = swap_out_size;
+      int index = hash_map.ParseData(batch[i], swap_out_index.data(), swap_out_ids.data(), step, step - 1,
+                                     &swap_out_size, &need_wait_graph);
+      ASSERT_NE(index, INVALID_INDEX_VALUE);
+      if (swap_out_size > swapped) {
+        reference.erase(swap_out_ids[swapped]);
+      }
+      reference[batch[i]] = index;
+      reference_steps[index] = step;
+    }
+    ASSERT_EQ(hash_map.hash_id_count(), reference.size());
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
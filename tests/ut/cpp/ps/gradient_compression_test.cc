@@ -0,0 +1,218 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "proto/ps.pb.h"
+#include "ps/constants.h"
+#include "ps/core/communicator/tcp_client.h"
+#include "ps/core/communicator/tcp_server.h"
+#include "ps/gradient_compression.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+class TestGradientCompression : public UT::Common {
+ public:
+  TestGradientCompression() = default;
+};
+
+namespace {
+std::vector<float> RandomGrad(size_t size, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::normal_distribution<float> dist(0, 1);
+  std::vector<float> grad(size);
+  for (auto &value : grad) {
+    value = dist(gen);
+  }
+  return grad;
+}
+}  // namespace
+
+TEST_F(TestGradientCompression, CastRoundTrip) {
+  std::vector<float> grad = RandomGrad(4096, 0);
+  grad[0] = 1e6;
+  grad[1] = std::nanf("");
+  for (auto type : {CompressionType::kNone, CompressionType::kFp16, CompressionType::kBf16}) {
+    GradientCompressor compressor;
+    compressor.Init(type, kDefaultTopKRatio);
+    std::string data;
+    compressor.Compress(0, grad.data(), grad.size(), &data);
+    EXPECT_EQ(data.size(), grad.size() * (type == CompressionType::kNone ? sizeof(float) : 2));
+
+    std::vector<float> decoded(grad.size(), 1);
+    ASSERT_TRUE(GradientCompressor::DecodeAdd(type, data, decoded.data(), decoded.size()));
+    float tolerance = type == CompressionType::kNone ? 0 : (type == CompressionType::kFp16 ? 1e-3 : 1e-2);
+    for (size_t i = 2; i < grad.size(); i++) {
+      EXPECT_NEAR(decoded[i] - 1, grad[i], std::fabs(grad[i]) * tolerance + 1e-6);
+    }
+    // fp16 saturates rather than overflows
+    EXPECT_TRUE(std::isfinite(decoded[0]));
+    // NaN is passed on, not clamped
+    EXPECT_TRUE(std::isnan(decoded[1]));
+    // A truncated message is refused
+    EXPECT_FALSE(GradientCompressor::Decode(type, data.substr(1), decoded.data(), decoded.size()));
+  }
+}
+
+TEST_F(TestGradientCompression, TopKErrorFeedback) {
+  constexpr size_t kSize = 10000;
+  constexpr float kRatio = 0.1;
+  std::vector<float> grad = RandomGrad(kSize, 1);
+  std::vector<float> zeros(kSize, 0);
+  GradientCompressor compressor;
+  compressor.Init(CompressionType::kTopK, kRatio);
+
+  // The first push sends a tenth of the values, the following pushes of zeros send what was left
+  std::vector<float> received(kSize, 0);
+  std::string data;
+  compressor.Compress(0, grad.data(), kSize, &data);
+  EXPECT_LT(data.size(), kSize * kRatio * 4);
+  ASSERT_TRUE(GradientCompressor::DecodeAdd(CompressionType::kTopK, data, received.data(), kSize));
+  size_t sent = kSize - static_cast<size_t>(std::count(received.begin(), received.end(), 0.0f));
+  EXPECT_NEAR(sent, kSize * kRatio, 1);
+  for (size_t step = 1; step < 1 / kRatio; step++) {
+    compressor.Compress(0, zeros.data(), kSize, &data);
+    ASSERT_TRUE(GradientCompressor::DecodeAdd(CompressionType::kTopK, data, received.data(), kSize));
+  }
+  // The rounding of the values sent first is left over, which can hold back the smallest values
+  for (size_t i = 0; i < kSize; i++) {
+    EXPECT_NEAR(received[i], grad[i], 2e-2);
+  }
+  // The keys keep their own residuals
+  compressor.Compress(1, zeros.data(), kSize, &data);
+  std::vector<float> other(kSize, 0);
+  ASSERT_TRUE(GradientCompressor::Decode(CompressionType::kTopK, data, other.data(), kSize));
+  EXPECT_EQ(static_cast<size_t>(std::count(other.begin(), other.end(), 0.0f)), kSize);
+}
+
+TEST_F(TestGradientCompression, DecompressGrad) {
+  // The inputs of momentum: the learning rate, the gradient and the momentum
+  std::vector<float> grad = RandomGrad(kCompressMinSize, 2);
+  std::string data;
+  GradientCompressor::Encode(CompressionType::kBf16, grad.data(), grad.size(), &data);
+  CompressedGrad compressed = {CompressionType::kBf16, 1, grad.size(), &data};
+  Values dense_values;
+  Lengths dense_lengths;
+  DecompressGrad(compressed, {0.01, 0.9}, {1, 0, 1}, &dense_values, &dense_lengths);
+  EXPECT_EQ(dense_lengths, Lengths({1, static_cast<int>(grad.size()), 1}));
+  ASSERT_EQ(dense_values.size(), grad.size() + 2);
+  EXPECT_FLOAT_EQ(dense_values.front(), 0.01);
+  EXPECT_FLOAT_EQ(dense_values.back(), 0.9);
+  EXPECT_NEAR(dense_values[1], grad[0], std::fabs(grad[0]) * 1e-2);
+}
+
+// Push a gradient over loopback with the link throttled to 1 Gbit/s. The server decodes each push into its
+// accumulation buffer, as the parameter server does.
+TEST_F(TestGradientCompression, PushThroughput) {
+  constexpr size_t kSize = 1 << 20;
+  constexpr size_t kPushes = 10;
+  constexpr double kBytesPerSecond = 125e6;
+
+  std::vector<float> accum(kSize, 0);
+  auto server = std::make_unique<core::TcpServer>("127.0.0.1", 0);
+  server->SetMessageCallback([&](std::shared_ptr<core::TcpConnection> conn, std::shared_ptr<core::MessageMeta> meta,
+                                 const core::Protos &, const void *data, size_t size) {
+    KVMessage input;
+    input.ParseFromArray(data, size);
+    auto type = static_cast<CompressionType>(input.compression());
+    if (type == CompressionType::kNone) {
+      for (int i = 0; i < input.values_size(); i++) {
+        accum[i] += input.values(i);
+      }
+    } else {
+      EXPECT_TRUE(GradientCompressor::DecodeAdd(type, input.compressed_values(), accum.data(), accum.size()));
+    }
+    KVMessage output;
+    output.add_keys(input.keys(0));
+    std::string res = output.SerializeAsString();
+    server->SendMessage(conn, meta, core::Protos::RAW, res.data(), res.size());
+  });
+  server->Init();
+  std::thread server_thread([&server]() { server->Start(); });
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t responses = 0;
+  auto client = std::make_unique<core::TcpClient>("127.0.0.1", server->BoundPort());
+  client->SetMessageCallback([&](std::shared_ptr<core::MessageMeta>, const core::Protos &, const void *, size_t) {
+    std::unique_lock<std::mutex> lock(mtx);
+    responses++;
+    cv.notify_one();
+  });
+  client->Init();
+  std::thread client_thread([&client]() { client->Start(); });
+  ASSERT_TRUE(client->WaitConnected(10));
+
+  std::vector<float> grad = RandomGrad(kSize, 3);
+  for (auto type : {CompressionType::kNone, CompressionType::kFp16, CompressionType::kBf16, CompressionType::kTopK}) {
+    GradientCompressor compressor;
+    compressor.Init(type, kDefaultTopKRatio);
+    std::fill(accum.begin(), accum.end(), 0);
+    size_t bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t r = 0; r < kPushes; r++) {
+      KVMessage request;
+      request.add_keys(0);
+      if (type == CompressionType::kNone) {
+        *request.mutable_values() = {grad.begin(), grad.end()};
+      } else {
+        request.set_compression(static_cast<int32_t>(type));
+        request.set_compressed_len(kSize);
+        compressor.Compress(0, grad.data(), kSize, request.mutable_compressed_values());
+      }
+      std::string data = request.SerializeAsString();
+      bytes += data.size();
+      std::this_thread::sleep_for(std::chrono::duration<double>(data.size() / kBytesPerSecond));
+      auto meta = std::make_shared<core::MessageMeta>();
+      meta->set_cmd(core::NodeCommand::SEND_DATA);
+      meta->set_user_cmd(kPushCmd);
+      client->SendMessage(meta, core::Protos::RAW, data.data(), data.size());
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [&responses]() { return responses > 0; });
+      responses = 0;
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    MS_LOG(INFO) << "Compression " << static_cast<int32_t>(type) << ": " << bytes / kPushes << " bytes per push, "
+                 << kPushes / elapsed << " pushes/s.";
+
+    // Top-k keeps back most of the gradient, the casts only round it
+    double error = 0;
+    double norm = 0;
+    for (size_t i = 0; i < kSize; i++) {
+      error += std::fabs(accum[i] - grad[i] * kPushes);
+      norm += std::fabs(grad[i] * kPushes);
+    }
+    EXPECT_LT(error / norm, type == CompressionType::kTopK ? 1.0 : 1e-2);
+  }
+
+  client->Stop();
+  client_thread.join();
+  server->Stop();
+  server_thread.join();
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,219 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common_test.h"
+#include "utils/ms_context.h"
+#include "ps/worker.h"
+#include "ps/ps_context.h"
+#define private public
+#include "ps/ps_cache/ps_cache_manager.h"
+#undef private
+
+namespace mindspore {
+namespace ps {
+class TestPsCacheManager : public UT::Common {
+ public:
+  TestPsCacheManager() = default;
+};
+
+namespace {
+// The device cache holds 100 rows and the host cache 1000 rows, so the rows move between the device, the host and
+// the server as the batches go by. The device cache still holds the rows of all the batches parsed ahead of the graph.
+constexpr size_t kVocabSize = 5000;
+constexpr size_t kCacheSize = 100;
+constexpr size_t kEmbeddingSize = 4;
+constexpr size_t kBatchSize = 16;
+constexpr size_t kBatchNum = 200;
+constexpr size_t kHotIdNum = 50;
+constexpr size_t kPrefetchDepth = 3;
+// The batches parsed and not yet taken by the graph, like the device queue of the dataset.
+constexpr size_t kDeviceQueueSize = 2;
+const char kChannelName[] = "ps_cache_test";
+const std::vector<std::string> kTables = {"weight", "moment"};
+
+struct Batch {
+  std::vector<int> ids;
+  // Replaced by the indices of the device table once the batch is parsed.
+  std::vector<int> indices;
+};
+
+// Half of the ids are from a few hot ids, the others from the whole vocabulary.
+std::vector<int> RandomIds(std::mt19937 *gen) {
+  std::uniform_int_distribution<int> hot(0, kHotIdNum - 1);
+  std::uniform_int_distribution<int> all(0, kVocabSize - 1);
+  std::vector<int> ids(kBatchSize);
+  for (size_t i = 0; i < kBatchSize; ++i) {
+    ids[i] = i % 2 == 0 ? hot(*gen) : all(*gen);
+  }
+  return ids;
+}
+}  // namespace
+
+// The batches are parsed up to kPrefetchDepth steps ahead of their swaps. Each graph step finds the rows of its batch
+// in the device table, and updates them. The rows swapped out keep the updates in the host cache and on the server.
+TEST_F(TestPsCacheManager, ProcessDataWithPrefetch) {
+  EXPECT_THROW(PSContext::instance()->set_cache_prefetch_depth(0), std::runtime_error);
+  EXPECT_THROW(PSContext::instance()->set_cache_prefetch_depth(kMaxCachePrefetchDepth + 1), std::runtime_error);
+  PSContext::instance()->set_cache_prefetch_depth(kPrefetchDepth);
+  MsContext::GetInstance()->set_param<std::string>(MS_CTX_DEVICE_TARGET, kCPUDevice);
+  PsDataPrefetch::GetInstance().set_cache_enable(true);
+  PsDataPrefetch::GetInstance().CreateDataChannel(kChannelName, kBatchNum);
+
+  auto &manager = PsCacheManager::GetInstance();
+  for (const auto &table : kTables) {
+    manager.InsertHashTableSize(table, kCacheSize, kEmbeddingSize, kVocabSize);
+  }
+  manager.set_batch_elements(kBatchSize);
+  manager.set_rank_id(0);
+  manager.Initialize();
+  ASSERT_EQ(manager.cache_prefetch_depth_, kPrefetchDepth);
+  std::map<std::string, float *> device_tables;
+  std::map<std::string, float *> host_tables;
+  for (const auto &table : kTables) {
+    device_tables[table] = reinterpret_cast<float *>(manager.QueryHashTableAddr(table).addr);
+    host_tables[table] = manager.hash_tables_[table].host_address.get();
+    ASSERT_NE(device_tables[table], nullptr);
+    ASSERT_NE(host_tables[table], nullptr);
+  }
+  manager.DoProcessData(0, nullptr);
+  // The graph steps need the thread of the cache to be running.
+  while (!manager.running_) {
+    std::this_thread::yield();
+  }
+  manager.InsertWeightInitInfo(kTables[0], 0, 0);
+  manager.InsertAccumuInitInfo(kTables[1], 0);
+
+  // The dataset sends the batches, each one waits until the previous one is parsed and there is room in the queue.
+  std::mutex batch_mutex;
+  std::condition_variable batch_cond;
+  std::deque<Batch> batches;
+  std::thread dataset([&]() {
+    std::mt19937 gen(1);
+    for (size_t step = 0; step < kBatchNum; ++step) {
+      Batch batch;
+      batch.ids = RandomIds(&gen);
+      batch.indices = batch.ids;
+      if (!PsDataPrefetch::GetInstance().PrefetchData(kChannelName, batch.indices.data(), kBatchSize * sizeof(int),
+                                                      "int32")) {
+        return;
+      }
+      std::unique_lock<std::mutex> locker(batch_mutex);
+      batch_cond.wait(locker, [&batches] { return batches.size() < kDeviceQueueSize; });
+      batches.push_back(std::move(batch));
+      batch_cond.notify_all();
+    }
+  });
+
+  // The expected rows of each table, a row is added the first time its id is seen.
+  std::map<std::string, std::unordered_map<int, std::vector<float>>> expected;
+  for (size_t step = 1; step <= kBatchNum; ++step) {
+    manager.IncreaseGraphStep(kChannelName);
+    Batch batch;
+    {
+      std::unique_lock<std::mutex> locker(batch_mutex);
+      batch_cond.wait(locker, [&batches] { return !batches.empty(); });
+      batch = std::move(batches.front());
+      batches.pop_front();
+      batch_cond.notify_all();
+    }
+    for (const auto &table : kTables) {
+      auto key = Worker::GetInstance().GetParamKey(table);
+      auto device_table = device_tables[table];
+      std::set<int> updated;
+      for (size_t i = 0; i < kBatchSize; ++i) {
+        int id = batch.ids[i];
+        int index = batch.indices[i];
+        // The threads of the dataset and the cache are running until the end, so nothing returns early.
+        if (index < 0 || index >= static_cast<int>(kCacheSize)) {
+          ADD_FAILURE() << "step " << step << ", id " << id << ", index " << index;
+          continue;
+        }
+        auto &row = expected[table][id];
+        if (row.empty()) {
+          Worker::GetInstance().DoPSEmbeddingLookup(key, {id}, &row, kEmbeddingLookupCmd);
+        }
+        for (size_t j = 0; j < kEmbeddingSize; ++j) {
+          EXPECT_EQ(device_table[index * kEmbeddingSize + j], row[j]) << "step " << step << ", id " << id;
+        }
+        // The graph updates each row of the batch once.
+        if (updated.insert(id).second) {
+          for (size_t j = 0; j < kEmbeddingSize; ++j) {
+            device_table[index * kEmbeddingSize + j] += 1;
+            row[j] += 1;
+          }
+        }
+      }
+    }
+  }
+  dataset.join();
+
+  // The swaps of the last step are finished, the rows in the host cache which are not on the device are up to date.
+  std::vector<int> device_ids;
+  std::vector<int> device_indices;
+  manager.embedding_device_cache_->device_hash_map_->GetHashIdsAndIndices(&device_ids, &device_indices);
+  std::set<int> on_device(device_ids.begin(), device_ids.end());
+  std::vector<int> host_ids;
+  std::vector<int> host_indices;
+  manager.embedding_host_cache_->host_hash_map_->GetHashIdsAndIndices(&host_ids, &host_indices);
+  EXPECT_GT(host_ids.size(), on_device.size());
+  for (const auto &table : kTables) {
+    auto host_table = host_tables[table];
+    for (size_t i = 0; i < host_ids.size(); ++i) {
+      if (on_device.count(host_ids[i]) != 0) {
+        continue;
+      }
+      const auto &row = expected[table][host_ids[i]];
+      if (row.size() != kEmbeddingSize) {
+        ADD_FAILURE() << "id " << host_ids[i] << " is never in a batch";
+        continue;
+      }
+      for (size_t j = 0; j < kEmbeddingSize; ++j) {
+        EXPECT_EQ(host_table[host_indices[i] * kEmbeddingSize + j], row[j]) << "id " << host_ids[i];
+      }
+    }
+  }
+
+  // Finalize syncs the weights in the caches to the server, so the server has every row of the weight.
+  manager.Finalize();
+  auto key = Worker::GetInstance().GetParamKey(kTables[0]);
+  std::vector<int> ids;
+  for (const auto &item : expected[kTables[0]]) {
+    ids.push_back(item.first);
+  }
+  EXPECT_GT(ids.size(), kCacheSize * kHostCacheScaleFactor);
+  std::vector<float> values;
+  Worker::GetInstance().DoPSEmbeddingLookup(key, ids, &values, kEmbeddingLookupCmd);
+  ASSERT_EQ(values.size(), ids.size() * kEmbeddingSize);
+  for (size_t i = 0; i < ids.size(); ++i) {
+    const auto &row = expected[kTables[0]][ids[i]];
+    for (size_t j = 0; j < kEmbeddingSize; ++j) {
+      EXPECT_EQ(values[i * kEmbeddingSize + j], row[j]) << "id " << ids[i];
+    }
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
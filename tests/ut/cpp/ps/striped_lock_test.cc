@@ -0,0 +1,79 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include "common/common_test.h"
+#include "ps/core/communicator/task_executor.h"
+#include "ps/striped_lock.h"
+
+namespace mindspore {
+namespace ps {
+class TestStripedLock : public UT::Common {
+ public:
+  TestStripedLock() = default;
+};
+
+TEST_F(TestStripedLock, MultiStripeLock) {
+  // Writers add one to a pair of rows in different stripes, readers check that the two rows are equal
+  constexpr size_t kPairs = 32;
+  // The stripes repeat every 32 rows, so the offset must not be a multiple of 32
+  constexpr size_t kOffset = 36;
+  constexpr size_t kIterations = 10000;
+  StripedLock locks(8, 4);
+  for (uint64_t row = 0; row < kPairs; row++) {
+    ASSERT_NE(locks.Stripe(row), locks.Stripe(row + kOffset));
+  }
+  std::vector<uint64_t> rows(kPairs + kOffset, 0);
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < 8; t++) {
+    bool writer = t % 2 == 0;
+    threads.emplace_back([&, t, writer]() {
+      for (size_t i = 0; i < kIterations; i++) {
+        uint64_t row = (t + i) % kPairs;
+        uint64_t ids[] = {row, row + kOffset};
+        MultiStripeLock lock(&locks, ids, 2, writer);
+        if (writer) {
+          rows[ids[0]]++;
+          rows[ids[1]]++;
+        } else {
+          EXPECT_EQ(rows[ids[0]], rows[ids[1]]);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  uint64_t sum = 0;
+  for (auto row : rows) {
+    sum += row;
+  }
+  EXPECT_EQ(sum, 4 * kIterations * 2);
+}
+
+TEST_F(TestStripedLock, TaskExecutorRun) {
+  core::TaskExecutor executor(4);
+  std::atomic<size_t> count(0);
+  std::vector<std::function<void()>> tasks(100, [&count]() { count++; });
+  EXPECT_TRUE(executor.Run(tasks));
+  EXPECT_EQ(count, tasks.size());
+}
+}  // namespace ps
+}  // namespace mindspore
@@ -0,0 +1,168 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <event2/buffer.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "common/common_test.h"
+#include "ps/constants.h"
+#include "ps/core/communicator/message_buffer.h"
+#include "ps/core/communicator/tcp_client.h"
+#include "ps/core/communicator/tcp_message_handler.h"
+#include "ps/core/communicator/tcp_server.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace ps {
+namespace core {
+class TestTcpThroughput : public UT::Common {
+ public:
+  TestTcpThroughput() = default;
+};
+
+namespace {
+DataPtr MakeData(size_t size) {
+  DataPtr data(new unsigned char[size]);
+  for (size_t i = 0; i < size; i++) {
+    data[i] = static_cast<unsigned char>(i * 7);
+  }
+  return data;
+}
+}  // namespace
+
+// A message written by reference arrives in pieces and is handed over in its receive buffer.
+TEST_F(TestTcpThroughput, WriteAndReceiveBuffer) {
+  constexpr size_t kSize = 100000;
+  DataPtr data = MakeData(kSize);
+  MessageMeta meta;
+  meta.set_request_id(7);
+
+  struct evbuffer *output = evbuffer_new();
+  ASSERT_TRUE(TcpMessageHandler::WriteMessage(output, meta, Protos::RAW, data.get(), kSize, data));
+  // The output buffer holds the data until it is drained
+  EXPECT_EQ(data.use_count(), 2);
+  ASSERT_TRUE(TcpMessageHandler::WriteMessage(output, meta, Protos::PROTOBUF, data.get(), 10, data));
+  EXPECT_EQ(data.use_count(), 2);
+
+  size_t received = 0;
+  DataPtr kept;
+  TcpMessageHandler handler;
+  handler.SetBufferCallback([&](std::shared_ptr<MessageMeta> message_meta, const Protos &protos, DataPtr message,
+                                size_t size) {
+    EXPECT_EQ(message_meta->request_id(), 7);
+    EXPECT_EQ(protos, received == 0 ? Protos::RAW : Protos::PROTOBUF);
+    EXPECT_EQ(size, received == 0 ? kSize : 10);
+    EXPECT_TRUE(std::equal(message.get(), message.get() + size, data.get()));
+    received++;
+    kept = message;
+  });
+
+  // Feed the input buffer as the socket would, in uneven pieces
+  struct evbuffer *input = evbuffer_new();
+  size_t piece = 5;
+  while (evbuffer_get_length(output) > 0) {
+    ASSERT_GE(evbuffer_remove_buffer(output, input, piece), 0);
+    handler.ReceiveMessage(input);
+    piece = piece * 3 + 1;
+  }
+  EXPECT_EQ(received, 2);
+  EXPECT_EQ(evbuffer_get_length(input), 0);
+  EXPECT_EQ(data.use_count(), 1);
+  evbuffer_free(input);
+  evbuffer_free(output);
+
+  // The receive buffer goes back to the pool once the handler lets go of it
+  size_t pooled = MessageBufferPool::GetInstance().pooled_bytes();
+  kept = nullptr;
+  EXPECT_GT(MessageBufferPool::GetInstance().pooled_bytes(), pooled);
+  EXPECT_NE(MessageBufferPool::GetInstance().Allocate(100), nullptr);
+}
+
+// Send 4KB to 1MB messages over loopback, by copy into the output buffer and by reference.
+TEST_F(TestTcpThroughput, Loopback) {
+  constexpr size_t kMinSize = 4 << 10;
+  constexpr size_t kMaxSize = 1 << 20;
+  constexpr size_t kBytesPerRound = 4 << 20;
+  constexpr size_t kWindow = 64;
+
+  auto server = std::make_unique<TcpServer>("127.0.0.1", 0);
+  std::string ack = "ack";
+  server->SetBufferCallback([&](std::shared_ptr<TcpConnection> conn, std::shared_ptr<MessageMeta> meta,
+                                const Protos &, DataPtr data, size_t size) {
+    EXPECT_EQ(data[size - 1], static_cast<unsigned char>((size - 1) * 7));
+    server->SendMessage(conn, meta, Protos::RAW, ack.data(), ack.size());
+  });
+  server->Init();
+  std::thread server_thread([&server]() { server->Start(); });
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  size_t acks = 0;
+  auto client = std::make_unique<TcpClient>("127.0.0.1", server->BoundPort());
+  client->SetMessageCallback([&](std::shared_ptr<MessageMeta>, const Protos &, const void *, size_t) {
+    std::unique_lock<std::mutex> lock(mtx);
+    acks++;
+    cv.notify_one();
+  });
+  client->Init();
+  std::thread client_thread([&client]() { client->Start(); });
+  ASSERT_TRUE(client->WaitConnected(10));
+
+  DataPtr data = MakeData(kMaxSize);
+  for (size_t size = kMinSize; size <= kMaxSize; size *= 4) {
+    size_t count = std::max<size_t>(kBytesPerRound / size, 4);
+    for (bool by_reference : {false, true}) {
+      {
+        std::lock_guard<std::mutex> lock(mtx);
+        acks = 0;
+      }
+      auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < count; i++) {
+        auto meta = std::make_shared<MessageMeta>();
+        meta->set_cmd(NodeCommand::SEND_DATA);
+        meta->set_request_id(i);
+        if (by_reference) {
+          EXPECT_TRUE(client->SendMessage(meta, Protos::RAW, data, size));
+        } else {
+          EXPECT_TRUE(client->SendMessage(meta, Protos::RAW, data.get(), size));
+        }
+        // Keep a bounded number of messages in flight
+        std::unique_lock<std::mutex> lock(mtx);
+        cv.wait(lock, [&]() { return acks + kWindow > i; });
+      }
+      std::unique_lock<std::mutex> lock(mtx);
+      cv.wait(lock, [&]() { return acks == count; });
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      MS_LOG(INFO) << "Message of " << size << " bytes " << (by_reference ? "by reference" : "by copy") << ": "
+                   << count * size / elapsed / (1 << 20) << " MB/s.";
+    }
+  }
+
+  client->Stop();
+  client_thread.join();
+  server->Stop();
+  server_thread.join();
+}
+}  // namespace core
+}  // namespace ps
+}  // namespace mindspore
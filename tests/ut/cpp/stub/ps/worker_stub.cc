@@ -0,0 +1,76 @@
+/**
+ * Copyright 2021 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "ps/worker.h"
+
+namespace mindspore {
+namespace ps {
+namespace {
+// The embedding tables of the server are kept in memory. A row which is never updated has the value id * 10 + j.
+std::mutex stub_mutex;
+std::map<std::string, size_t> stub_param_keys;
+std::map<Key, size_t> stub_embedding_sizes;
+std::map<Key, std::unordered_map<int, std::vector<float>>> stub_embedding_tables;
+}  // namespace
+
+void Worker::Run() { running_ = true; }
+
+size_t Worker::SetParamKey(const std::string &param_name) {
+  std::lock_guard<std::mutex> locker(stub_mutex);
+  return stub_param_keys.emplace(param_name, stub_param_keys.size()).first->second;
+}
+
+size_t Worker::GetParamKey(const std::string &param_name) { return SetParamKey(param_name); }
+
+void Worker::AddEmbeddingTable(const Key &key, const size_t &row_count) {}
+
+void Worker::InitPSEmbeddingTable(const size_t &key, const std::vector<size_t> &input_shape,
+                                  const std::vector<size_t> &indices_shape, const std::vector<size_t> &output_shape,
+                                  const ParamInitInfoMessage &info) {
+  std::lock_guard<std::mutex> locker(stub_mutex);
+  stub_embedding_sizes[key] = input_shape.back();
+}
+
+void Worker::DoPSEmbeddingLookup(const Key &key, const std::vector<int> &lookup_ids,
+                                 std::vector<float> *lookup_result, int64_t cmd) {
+  std::lock_guard<std::mutex> locker(stub_mutex);
+  size_t embedding_size = stub_embedding_sizes[key];
+  const auto &table = stub_embedding_tables[key];
+  lookup_result->resize(lookup_ids.size() * embedding_size);
+  for (size_t i = 0; i < lookup_ids.size(); ++i) {
+    auto iter = table.find(lookup_ids[i]);
+    for (size_t j = 0; j < embedding_size; ++j) {
+      (*lookup_result)[i * embedding_size + j] =
+        iter == table.end() ? static_cast<float>(lookup_ids[i] * 10 + j) : iter->second[j];
+    }
+  }
+}
+
+void Worker::UpdateEmbeddingTable(const std::vector<Key> &keys, const std::vector<int> &lookup_ids,
+                                  const std::vector<float> &vals) {
+  std::lock_guard<std::mutex> locker(stub_mutex);
+  size_t embedding_size = stub_embedding_sizes[keys[0]];
+  auto &table = stub_embedding_tables[keys[0]];
+  for (size_t i = 0; i < lookup_ids.size(); ++i) {
+    table[lookup_ids[i]].assign(vals.begin() + i * embedding_size, vals.begin() + (i + 1) * embedding_size);
+  }
+}
+}  // namespace ps
+}  // namespace mindspore
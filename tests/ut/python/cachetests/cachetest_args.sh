@@ -55,6 +55,11 @@ cmd="${CACHE_ADMIN} --start --spilldir /path_that_does_not_exist"
 CacheAdminCmd "${cmd}" 1
 HandleRcExit $? 0 0
 
+# persistent cache without a spill directory
+cmd="${CACHE_ADMIN} --start --persistent"
+CacheAdminCmd "${cmd}" 1
+HandleRcExit $? 0 0
+
 # clean up cache server first to test start
 ServerCleanup
 # start cache server
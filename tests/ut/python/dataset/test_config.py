@@ -19,6 +19,7 @@ import os
 import filecmp
 import glob
 import numpy as np
+import pytest
 
 import mindspore.dataset as ds
 import mindspore.dataset.transforms.py_transforms
@@ -383,6 +384,57 @@ def test_auto_num_workers():
     assert saved_config == ds.config.get_auto_num_workers()
 
 
+def test_file_split_size_error():
+    """
+    Test file_split_size errors
+    """
+    with pytest.raises(TypeError) as info:
+        ds.config.set_file_split_size("1024")
+    assert "isn't of type int" in str(info.value)
+
+    with pytest.raises(ValueError) as info:
+        ds.config.set_file_split_size(-1)
+    assert "not within the required range" in str(info.value)
+
+
+def test_file_split_size():
+    """
+    Test the files read in parts of file_split_size bytes give the same rows as the whole files
+    """
+    logger.info("test_file_split_size")
+    saved_split_size = ds.config.get_file_split_size()
+
+    def get_tf_labels(shard_equal_rows=False):
+        data = ds.TFRecordDataset(DATA_DIR, SCHEMA_DIR, columns_list=["label"], shuffle=False,
+                                  num_parallel_workers=4, shard_equal_rows=shard_equal_rows)
+        return sorted(d["label"].item() for d in data.create_dict_iterator(num_epochs=1, output_numpy=True))
+
+    def get_csv_rows():
+        data = ds.CSVDataset('../data/dataset/testCSV/1.csv', column_defaults=["", "", "", ""],
+                             column_names=['col1', 'col2', 'col3', 'col4'], shuffle=False, num_parallel_workers=4)
+        return [d["col1"].item().decode("utf8") for d in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+
+    ds.config.set_file_split_size(0)
+    assert ds.config.get_file_split_size() == 0
+    tf_labels = get_tf_labels()
+    csv_rows = get_csv_rows()
+    assert len(tf_labels) == 3
+    assert csv_rows == ['1', '5', '9']
+
+    # The files are read in several parts, each holding the start of at most one row
+    ds.config.set_file_split_size(8)
+    assert ds.config.get_file_split_size() == 8
+    assert get_tf_labels() == tf_labels
+    assert get_csv_rows() == csv_rows
+
+    # The equal rows of the shards are counted from whole files
+    with pytest.raises(RuntimeError) as info:
+        get_tf_labels(shard_equal_rows=True)
+    assert "shard_equal_rows" in str(info.value)
+
+    ds.config.set_file_split_size(saved_split_size)
+
+
 if __name__ == '__main__':
     test_basic()
     test_get_seed()
@@ -395,3 +447,5 @@ if __name__ == '__main__':
     test_deterministic_python_seed_multi_thread()
     test_auto_num_workers_error()
     test_auto_num_workers()
+    test_file_split_size_error()
+    test_file_split_size()
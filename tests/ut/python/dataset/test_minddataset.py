@@ -2568,6 +2568,24 @@ def test_distributed_shuffle_with_multi_epochs(create_multi_mindrecord_files):
     assert datas_epoch2 not in (datas_epoch1, datas_epoch3)
     assert datas_epoch3 not in (datas_epoch2, datas_epoch1)
 
+def test_cv_minddataset_block_shuffle(add_and_remove_cv_file):
+    """read all the rows with the block shuffle, which is only supported by MindDataset."""
+    columns_list = ["data", "file_name", "label"]
+    num_readers = 4
+    data_set = ds.MindDataset(CV_FILE_NAME + "0", columns_list, num_readers, shuffle=ds.Shuffle.BLOCK)
+    assert data_set.get_dataset_size() == 10
+    data_set = data_set.repeat(2)
+    file_names = []
+    for item in data_set.create_dict_iterator(num_epochs=1, output_numpy=True):
+        file_names.append(item["file_name"].item())
+    assert len(file_names) == 20
+    assert sorted(file_names[:10]) == sorted(file_names[10:])
+    assert len(set(file_names[:10])) == 10
+
+    with pytest.raises(ValueError, match="Shuffle.BLOCK is only supported by MindDataset"):
+        ds.TextFileDataset(NLP_FILE_VOCAB, shuffle=ds.Shuffle.BLOCK)
+
+
 if __name__ == '__main__':
     test_nlp_compress_data(add_and_remove_nlp_compress_file)
     test_nlp_compress_data_old_version(add_and_remove_nlp_compress_file)
@@ -2603,3 +2621,4 @@ if __name__ == '__main__':
     test_shuffle_with_global_infile_files(create_multi_mindrecord_files)
     test_distributed_shuffle_with_global_infile_files(create_multi_mindrecord_files)
     test_distributed_shuffle_with_multi_epochs(create_multi_mindrecord_files)
+    test_cv_minddataset_block_shuffle(add_and_remove_cv_file)
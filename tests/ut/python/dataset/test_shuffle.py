@@ -12,7 +12,11 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 # ==============================================================================
+import multiprocessing
+import socket
+
 import numpy as np
+import pytest
 import mindspore.dataset as ds
 from mindspore import log as logger
 from util import save_and_check_dict
@@ -242,6 +246,67 @@ def test_shuffle_exception_07():
         assert "buffer_size" in str(e)
 
 
+def _shuffle_exchange_rank(group, rank, num_rows, result):
+    """
+    Run the pipeline of one rank of test_shuffle_exchange_two_processes
+    """
+    ds.config.set_seed(1)
+    data = ds.NumpySlicesDataset(list(range(rank * num_rows, (rank + 1) * num_rows)), column_names=["col"],
+                                 shuffle=False)
+    data = data.shuffle(4, exchange_group=group, num_ranks=2, rank=rank, exchange_size=2)
+    rows = [int(item["col"]) for item in data.create_dict_iterator(num_epochs=1, output_numpy=True)]
+    result.put((rank, rows))
+
+
+def test_shuffle_exchange_two_processes():
+    """
+    Test shuffle: two ranks in separate processes swap rows through a tcp exchange group
+    """
+    logger.info("test_shuffle_exchange_two_processes")
+    num_rows = 20
+    with socket.socket() as s:
+        s.bind(("127.0.0.1", 0))
+        port = s.getsockname()[1]
+    group = "tcp://127.0.0.1:{}".format(port)
+
+    ctx = multiprocessing.get_context("spawn")
+    result = ctx.Queue()
+    procs = [ctx.Process(target=_shuffle_exchange_rank, args=(group, rank, num_rows, result)) for rank in range(2)]
+    for p in procs:
+        p.start()
+    rows = dict(result.get(timeout=120) for _ in procs)
+    for p in procs:
+        p.join(timeout=120)
+        assert p.exitcode == 0
+
+    # Each rank gets as many rows as its shard has, and together they get every row once
+    assert len(rows[0]) == num_rows
+    assert len(rows[1]) == num_rows
+    assert sorted(rows[0] + rows[1]) == list(range(2 * num_rows))
+    # Some rows of each rank went to the other one
+    assert any(row >= num_rows for row in rows[0])
+    assert any(row < num_rows for row in rows[1])
+
+
+def test_shuffle_exchange_exception():
+    """
+    Test shuffle exception: the arguments of an exchange group
+    """
+    logger.info("test_shuffle_exchange_exception")
+    data1 = ds.TFRecordDataset(DATA_DIR)
+    with pytest.raises(ValueError, match="rank is required"):
+        data1.shuffle(4, exchange_group="tcp://127.0.0.1:8200", num_ranks=2, exchange_size=2)
+    with pytest.raises(ValueError, match="exchange_size"):
+        data1.shuffle(4, exchange_group="tcp://127.0.0.1:8200", num_ranks=2, rank=0, exchange_size=5)
+    with pytest.raises(ValueError, match="rank"):
+        data1.shuffle(4, exchange_group="tcp://127.0.0.1:8200", num_ranks=2, rank=2, exchange_size=2)
+    with pytest.raises(ValueError, match="only used with exchange_group"):
+        data1.shuffle(4, num_ranks=2)
+    with pytest.raises(RuntimeError, match="tcp://host:port"):
+        data2 = data1.shuffle(4, exchange_group="tcp://127.0.0.1", num_ranks=2, rank=0, exchange_size=2)
+        sum([1 for _ in data2])
+
+
 if __name__ == '__main__':
     test_shuffle_01()
     test_shuffle_02()
@@ -255,4 +320,6 @@ if __name__ == '__main__':
     test_shuffle_exception_05()
     test_shuffle_exception_06()
     test_shuffle_exception_07()
+    test_shuffle_exchange_two_processes()
+    test_shuffle_exchange_exception()
     logger.info('\n')